@@ -159,6 +159,11 @@ function(ez_set_build_flags_clang TARGET_NAME)
 	# Disable warning: multi-character character constant
 	target_compile_options(${TARGET_NAME} PRIVATE -Wno-multichar)
 	
+	if(EZ_ENABLE_FRAME_POINTERS)
+		# the sampling profiler follows the frame pointer chain to record call stacks
+		target_compile_options(${TARGET_NAME} PRIVATE -fno-omit-frame-pointer)
+	endif()
+	
 	if(EZ_CMAKE_PLATFORM_WINDOWS)
 		# Disable the warning that clang doesn't support pragma optimize.
 		target_compile_options(${TARGET_NAME} PRIVATE -Wno-ignored-pragma-optimize -Wno-pragma-pack)
@@ -204,6 +209,11 @@ function(ez_set_build_flags_gcc TARGET_NAME)
 	# Disable warning: multi-character character constant
 	target_compile_options(${TARGET_NAME} PRIVATE -Wno-multichar)
 
+	if(EZ_ENABLE_FRAME_POINTERS)
+		# the sampling profiler follows the frame pointer chain to record call stacks
+		target_compile_options(${TARGET_NAME} PRIVATE -fno-omit-frame-pointer)
+	endif()
+
 endfunction()
 
 ######################################
@@ -239,4 +249,10 @@ function(ez_set_build_flags TARGET_NAME)
 
 	endif()
 
+	if (EZ_ENABLE_FRAME_POINTERS)
+
+		target_compile_definitions(${TARGET_NAME} PRIVATE BUILDSYSTEM_ENABLE_FRAME_POINTERS)
+
+	endif()
+
 endfunction()
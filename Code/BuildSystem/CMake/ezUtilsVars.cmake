@@ -50,6 +50,13 @@ set (EZ_ENABLE_COMPILER_STATIC_ANALYSIS OFF CACHE BOOL "Enables static analysis
 
 mark_as_advanced(FORCE EZ_ENABLE_COMPILER_STATIC_ANALYSIS)
 
+######################################
+### Frame pointers
+######################################
+set (EZ_ENABLE_FRAME_POINTERS OFF CACHE BOOL "Keeps the frame pointers in all functions (GCC and Clang), the sampling profiler requires this to record call stacks")
+
+mark_as_advanced(FORCE EZ_ENABLE_FRAME_POINTERS)
+
 
 ######################################
 ### vcpkg
@@ -347,6 +347,11 @@ private:
   void UpdateSubAssets(ezAssetInfo& assetInfo);
   /// \brief Computes the hash of the given file. Optionally passes the data stream through into another stream writer.
   static ezUInt64 HashFile(ezStreamReader& InputStream, ezStreamWriter* pPassThroughStream);
+  /// \brief Whether HashFile uses XXH3 instead of xxHash64. Opt-in via the '-AssetHashXXH3' command line option.
+  ///
+  /// XXH3 is much faster on large files, but produces different hashes. Toggling the option therefore invalidates the curator cache and
+  /// causes all assets to be transformed once more.
+  static bool IsUsingXxHash3FileHashes();
 
   void RemoveAssetTransformState(const ezUuid& assetGuid);
   void InvalidateAssetTransformState(const ezUuid& assetGuid);
@@ -21,6 +21,8 @@
 
 #define EZ_CURATOR_CACHE_VERSION 2
 #define EZ_CURATOR_CACHE_FILE_VERSION 6
+// Added to the file version when file hashes are computed with XXH3, so that toggling the option discards the cached file hashes.
+#define EZ_CURATOR_CACHE_FILE_VERSION_XXH3_FLAG 0x10000
 
 EZ_IMPLEMENT_SINGLETON(ezAssetCurator);
 
@@ -1726,7 +1728,7 @@ void ezAssetCurator::LoadCaches()
         continue;
       }
 
-      if (uiFileVersion != EZ_CURATOR_CACHE_FILE_VERSION)
+      if (uiFileVersion != (EZ_CURATOR_CACHE_FILE_VERSION | (IsUsingXxHash3FileHashes() ? EZ_CURATOR_CACHE_FILE_VERSION_XXH3_FLAG : 0)))
         continue;
 
       const ezRTTI* pFileStatusType = ezGetStaticRTTI<ezFileStatus>();
@@ -1786,7 +1788,7 @@ void ezAssetCurator::SaveCaches()
     ezStringBuilder sCacheFile = sDataDir;
     sCacheFile.AppendPath("AssetCache", "AssetCurator.ezCache");
 
-    const ezUInt32 uiFileVersion = EZ_CURATOR_CACHE_FILE_VERSION;
+    const ezUInt32 uiFileVersion = EZ_CURATOR_CACHE_FILE_VERSION | (IsUsingXxHash3FileHashes() ? EZ_CURATOR_CACHE_FILE_VERSION_XXH3_FLAG : 0);
     ezUInt32 uiAssetCount = 0;
     ezUInt32 uiFileCount = 0;
 
@@ -6,6 +6,7 @@
 #include <Foundation/Algorithm/HashStream.h>
 #include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/OSFile.h>
+#include <Foundation/Utilities/CommandLineUtils.h>
 #include <GuiFoundation/UIServices/ImageCache.moc.h>
 
 ////////////////////////////////////////////////////////////////////////
@@ -591,27 +592,46 @@ void ezAssetCurator::UpdateSubAssets(ezAssetInfo& assetInfo)
   }
 }
 
-ezUInt64 ezAssetCurator::HashFile(ezStreamReader& InputStream, ezStreamWriter* pPassThroughStream)
+bool ezAssetCurator::IsUsingXxHash3FileHashes()
 {
-  ezHashStreamWriter64 hsw;
-
-  CURATOR_PROFILE("HashFile");
-  ezUInt8 cachedBytes[1024 * 10];
+  static const bool s_bUseXxHash3 = ezCommandLineUtils::GetGlobalInstance()->GetBoolOption("-AssetHashXXH3");
+  return s_bUseXxHash3;
+}
 
-  while (true)
+namespace
+{
+  template <typename HashStreamWriter>
+  ezUInt64 HashFileWith(ezStreamReader& InputStream, ezStreamWriter* pPassThroughStream)
   {
-    const ezUInt64 uiRead = InputStream.ReadBytes(cachedBytes, EZ_ARRAY_SIZE(cachedBytes));
+    HashStreamWriter hsw;
+
+    ezUInt8 cachedBytes[1024 * 10];
+
+    while (true)
+    {
+      const ezUInt64 uiRead = InputStream.ReadBytes(cachedBytes, EZ_ARRAY_SIZE(cachedBytes));
 
-    if (uiRead == 0)
-      break;
+      if (uiRead == 0)
+        break;
+
+      hsw.WriteBytes(cachedBytes, uiRead).IgnoreResult();
 
-    hsw.WriteBytes(cachedBytes, uiRead).IgnoreResult();
+      if (pPassThroughStream != nullptr)
+        pPassThroughStream->WriteBytes(cachedBytes, uiRead).IgnoreResult();
+    }
 
-    if (pPassThroughStream != nullptr)
-      pPassThroughStream->WriteBytes(cachedBytes, uiRead).IgnoreResult();
+    return hsw.GetHashValue();
   }
+} // namespace
+
+ezUInt64 ezAssetCurator::HashFile(ezStreamReader& InputStream, ezStreamWriter* pPassThroughStream)
+{
+  CURATOR_PROFILE("HashFile");
+
+  if (IsUsingXxHash3FileHashes())
+    return HashFileWith<ezHashStreamWriterXxHash3_64>(InputStream, pPassThroughStream);
 
-  return hsw.GetHashValue();
+  return HashFileWith<ezHashStreamWriter64>(InputStream, pPassThroughStream);
 }
 
 void ezAssetCurator::RemoveAssetTransformState(const ezUuid& assetGuid)
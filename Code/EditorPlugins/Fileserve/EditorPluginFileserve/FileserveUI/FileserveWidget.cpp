@@ -355,6 +355,9 @@ void ezQtFileserveWidget::FileserverEventHandler(const ezFileserverEvent& e)
       if (e.m_FileState == ezFileserveFileState::NonExistantEither)
         LogActivity(ezFmt("[N/A] {0}", e.m_szPath), ezFileserveActivityType::ReadFile);
 
+      if (e.m_FileState == ezFileserveFileState::CachedContent)
+        LogActivity(ezFmt("[CACHE] {0}", e.m_szPath), ezFileserveActivityType::ReadFile);
+
       if (e.m_FileState == ezFileserveFileState::Different)
         LogActivity(ezFmt("({1} KB) {0}", e.m_szPath, ezArgF(e.m_uiSizeTotal / 1024.0f, 1)), ezFileserveActivityType::ReadFile);
     }
@@ -496,6 +496,8 @@ void ezResourceManager::PerFrameUpdate()
     }
 
     s_State->s_ResourcesToUnloadOnMainThread.Clear();
+
+    EZ_PROFILE_COUNTER("ResourceLoadingQueue", s_State->s_LoadingQueue.GetCount());
   }
 
   if (s_State->m_AutoFreeUnusedTimeout.IsPositive())
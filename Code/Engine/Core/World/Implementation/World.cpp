@@ -364,19 +364,7 @@ void ezWorld::PostMessage(
   metaData.m_uiReceiverIsComponent = false;
   metaData.m_uiRecursive = bRecursive;
 
-  ezRTTIAllocator* pMsgRTTIAllocator = msg.GetDynamicRTTI()->GetAllocator();
-  if (delay.GetSeconds() > 0.0)
-  {
-    ezMessage* pMsgCopy = pMsgRTTIAllocator->Clone<ezMessage>(&msg, &m_Data.m_Allocator);
-
-    metaData.m_Due = m_Data.m_Clock.GetAccumulatedTime() + delay;
-    m_Data.m_TimedMessageQueues[queueType].Enqueue(pMsgCopy, metaData);
-  }
-  else
-  {
-    ezMessage* pMsgCopy = pMsgRTTIAllocator->Clone<ezMessage>(&msg, m_Data.m_StackAllocator.GetCurrentAllocator());
-    m_Data.m_MessageQueues[queueType].Enqueue(pMsgCopy, metaData);
-  }
+  PostMessageInternal(msg, metaData, queueType, delay);
 }
 
 void ezWorld::PostMessage(const ezComponentHandle& receiverComponent, const ezMessage& msg, ezTime delay, ezObjectMsgQueueType::Enum queueType) const
@@ -390,18 +378,33 @@ void ezWorld::PostMessage(const ezComponentHandle& receiverComponent, const ezMe
   metaData.m_uiReceiverIsComponent = true;
   metaData.m_uiRecursive = false;
 
+  PostMessageInternal(msg, metaData, queueType, delay);
+}
+
+void ezWorld::PostMessageInternal(
+  const ezMessage& msg, const QueuedMsgMetaData& metaData, ezObjectMsgQueueType::Enum queueType, ezTime delay) const
+{
+  // Every thread writes to its own segment, which is moved to the message queues before they are processed.
+  // The lock is only contended while the main thread moves the segment or swaps its allocators.
+  ezInternal::WorldData::PostedMessages& postedMessages = m_Data.GetPostedMessages();
+  EZ_LOCK(postedMessages.m_Mutex);
+
+  ezInternal::WorldData::MessageQueue::Entry entry;
+  entry.m_MetaData = metaData;
+
   ezRTTIAllocator* pMsgRTTIAllocator = msg.GetDynamicRTTI()->GetAllocator();
   if (delay.GetSeconds() > 0.0)
   {
-    ezMessage* pMsgCopy = pMsgRTTIAllocator->Clone<ezMessage>(&msg, &m_Data.m_Allocator);
+    entry.m_pMessage = pMsgRTTIAllocator->Clone<ezMessage>(&msg, &m_Data.m_Allocator);
+    entry.m_MetaData.m_Due = m_Data.m_Clock.GetAccumulatedTime() + delay;
 
-    metaData.m_Due = m_Data.m_Clock.GetAccumulatedTime() + delay;
-    m_Data.m_TimedMessageQueues[queueType].Enqueue(pMsgCopy, metaData);
+    postedMessages.m_TimedMessages[queueType].PushBack(entry);
   }
   else
   {
-    ezMessage* pMsgCopy = pMsgRTTIAllocator->Clone<ezMessage>(&msg, m_Data.m_StackAllocator.GetCurrentAllocator());
-    m_Data.m_MessageQueues[queueType].Enqueue(pMsgCopy, metaData);
+    entry.m_pMessage = pMsgRTTIAllocator->Clone<ezMessage>(&msg, postedMessages.m_StackAllocator.GetCurrentAllocator());
+
+    postedMessages.m_Messages[queueType].PushBack(entry);
   }
 }
 
@@ -540,8 +543,9 @@ void ezWorld::Update()
     ProcessQueuedMessages(ezObjectMsgQueueType::AfterInitialized);
   }
 
-  // Swap our double buffered stack allocator
+  // Swap our double buffered stack allocators
   m_Data.m_StackAllocator.Swap();
+  m_Data.SwapPostedMessagesAllocators();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -849,7 +853,8 @@ void ezWorld::ProcessQueuedMessages(ezObjectMsgQueueType::Enum queueType)
     }
   };
 
-  // regular messages
+  // regular messages, messages that are posted while processing are handled in the next pass
+  while (m_Data.MovePostedMessages(queueType))
   {
     ezInternal::WorldData::MessageQueue& queue = m_Data.m_MessageQueues[queueType];
     queue.Sort(MessageComparer());
@@ -36,6 +36,28 @@ namespace ezInternal
 
   ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+  namespace
+  {
+    ezAtomicInteger64 s_iNextWorldInstanceId;
+
+    // caches the segment that the calling thread has used last, the instance id guards against reused world addresses
+    struct PostedMessagesCache
+    {
+      ezUInt64 m_uiWorldInstanceId = 0;
+      void* m_pPostedMessages = nullptr;
+    };
+
+    thread_local PostedMessagesCache tl_PostedMessagesCache;
+  } // namespace
+
+  WorldData::PostedMessages::PostedMessages(const char* szName)
+    : m_ThreadID(ezThreadUtils::GetCurrentThreadID())
+    , m_StackAllocator(szName, ezFoundation::GetAlignedAllocator())
+  {
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////////////////////////
+
   WorldData::WorldData(ezWorldDesc& desc)
     : m_sName(desc.m_sName)
     , m_Allocator(desc.m_sName, ezFoundation::GetDefaultAllocator())
@@ -55,6 +77,8 @@ namespace ezInternal
   {
     m_AllocatorWrapper.Reset();
 
+    m_uiInstanceId = static_cast<ezUInt64>(s_iNextWorldInstanceId.Increment());
+
     if (desc.m_uiRandomNumberGeneratorSeed == 0)
     {
       m_Random.InitializeFromCurrentTime();
@@ -150,6 +174,118 @@ namespace ezInternal
         }
       }
     }
+
+    // delete posted messages that have not been moved to the queues yet
+    while (m_pPostedMessages != nullptr)
+    {
+      PostedMessages* pPostedMessages = m_pPostedMessages;
+      m_pPostedMessages = pPostedMessages->m_pNext;
+
+      for (ezUInt32 i = 0; i < ezObjectMsgQueueType::COUNT; ++i)
+      {
+        for (auto& entry : pPostedMessages->m_TimedMessages[i])
+        {
+          EZ_DELETE(&m_Allocator, entry.m_pMessage);
+        }
+      }
+
+      EZ_DELETE(&m_Allocator, pPostedMessages);
+    }
+  }
+
+  WorldData::PostedMessages& WorldData::GetPostedMessages() const
+  {
+    PostedMessagesCache& cache = tl_PostedMessagesCache;
+    if (cache.m_uiWorldInstanceId == m_uiInstanceId)
+    {
+      return *static_cast<PostedMessages*>(cache.m_pPostedMessages);
+    }
+
+    const ezThreadID currentThreadID = ezThreadUtils::GetCurrentThreadID();
+
+    // segments are only ever prepended, so the list can be walked without a lock
+    PostedMessages* pPostedMessages = GetFirstPostedMessages();
+    while (pPostedMessages != nullptr && pPostedMessages->m_ThreadID != currentThreadID)
+    {
+      pPostedMessages = pPostedMessages->m_pNext;
+    }
+
+    if (pPostedMessages == nullptr)
+    {
+      ezStringBuilder sName;
+      sName.Format("{0} Messages", m_sName);
+
+      pPostedMessages = EZ_NEW(&m_Allocator, PostedMessages, sName);
+
+      void* pHead = nullptr;
+      do
+      {
+        pHead = ezAtomicUtils::Read(reinterpret_cast<void**>(&m_pPostedMessages));
+        pPostedMessages->m_pNext = static_cast<PostedMessages*>(pHead);
+      } while (!ezAtomicUtils::TestAndSet(reinterpret_cast<void**>(&m_pPostedMessages), pHead, pPostedMessages));
+    }
+
+    cache.m_uiWorldInstanceId = m_uiInstanceId;
+    cache.m_pPostedMessages = pPostedMessages;
+
+    return *pPostedMessages;
+  }
+
+  bool WorldData::MovePostedMessages(ezObjectMsgQueueType::Enum queueType)
+  {
+    bool bAnyMessages = false;
+
+    for (PostedMessages* pPostedMessages = GetFirstPostedMessages(); pPostedMessages != nullptr; pPostedMessages = pPostedMessages->m_pNext)
+    {
+      EZ_LOCK(pPostedMessages->m_Mutex);
+
+      ezDynamicArray<MessageQueue::Entry>& messages = pPostedMessages->m_Messages[queueType];
+      if (!messages.IsEmpty())
+      {
+        MessageQueue& queue = m_MessageQueues[queueType];
+        queue.Reserve(queue.GetCount() + messages.GetCount());
+
+        for (const auto& entry : messages)
+        {
+          queue.Enqueue(entry.m_pMessage, entry.m_MetaData);
+        }
+
+        messages.Clear();
+        bAnyMessages = true;
+      }
+
+      ezDynamicArray<MessageQueue::Entry>& timedMessages = pPostedMessages->m_TimedMessages[queueType];
+      if (!timedMessages.IsEmpty())
+      {
+        MessageQueue& queue = m_TimedMessageQueues[queueType];
+        queue.Reserve(queue.GetCount() + timedMessages.GetCount());
+
+        for (const auto& entry : timedMessages)
+        {
+          queue.Enqueue(entry.m_pMessage, entry.m_MetaData);
+        }
+
+        timedMessages.Clear();
+      }
+    }
+
+    return bAnyMessages;
+  }
+
+  void WorldData::SwapPostedMessagesAllocators()
+  {
+    for (PostedMessages* pPostedMessages = GetFirstPostedMessages(); pPostedMessages != nullptr; pPostedMessages = pPostedMessages->m_pNext)
+    {
+      EZ_LOCK(pPostedMessages->m_Mutex);
+
+      pPostedMessages->m_StackAllocator.Swap();
+    }
+  }
+
+  WorldData::PostedMessages* WorldData::GetFirstPostedMessages() const
+  {
+    // the compare-and-swap that publishes a segment and this read are full barriers, m_pNext is immutable once published
+    return static_cast<PostedMessages*>(ezAtomicUtils::Read(reinterpret_cast<void**>(&m_pPostedMessages)));
   }
 
   ezGameObject::TransformationData* WorldData::CreateTransformationData(bool bDynamic, ezUInt32 uiHierarchyLevel)
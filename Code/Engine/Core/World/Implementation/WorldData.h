@@ -5,6 +5,7 @@
 #include <Foundation/Math/Random.h>
 #include <Foundation/Memory/FrameAllocator.h>
 #include <Foundation/Threading/DelegateTask.h>
+#include <Foundation/Threading/Mutex.h>
 #include <Foundation/Time/Clock.h>
 
 #include <Core/World/GameObject.h>
@@ -232,6 +233,42 @@ namespace ezInternal
     mutable MessageQueue m_MessageQueues[ezObjectMsgQueueType::COUNT];
     mutable MessageQueue m_TimedMessageQueues[ezObjectMsgQueueType::COUNT];
 
+    /// \brief Messages that have been posted by one thread and not been moved to the message queues yet.
+    ///
+    /// Every thread that posts messages gets its own segment, so posting threads never contend with each other. Regular messages are
+    /// allocated from the stack allocator of the segment. The segments are moved to the message queues by the thread that processes the
+    /// queued messages. The mutex of a segment is only contended while its messages are moved or its allocators are swapped.
+    struct PostedMessages
+    {
+      PostedMessages(const char* szName);
+
+      ezThreadID m_ThreadID;
+      PostedMessages* m_pNext = nullptr; ///< Set once before the segment is published, never changed afterwards.
+      ezMutex m_Mutex;
+      ezDoubleBufferedStackAllocator m_StackAllocator;
+      ezDynamicArray<MessageQueue::Entry> m_Messages[ezObjectMsgQueueType::COUNT];
+      ezDynamicArray<MessageQueue::Entry> m_TimedMessages[ezObjectMsgQueueType::COUNT];
+    };
+
+    /// \brief Returns the segment of the calling thread, creates it on first use. This method is thread safe and does not lock.
+    ///
+    /// The segment has to be locked while messages are added to it.
+    PostedMessages& GetPostedMessages() const;
+
+    /// \brief Moves all posted messages of the given queue type to the message queues. Returns true if any regular message was moved.
+    ///
+    /// Other threads may post messages concurrently, each segment is locked while its messages are moved.
+    bool MovePostedMessages(ezObjectMsgQueueType::Enum queueType);
+
+    /// \brief Swaps the stack allocators of all segments, done once per frame. Each segment is locked while its allocator is swapped.
+    void SwapPostedMessagesAllocators();
+
+    /// \brief Returns the first segment, the load synchronizes with the publication of the segment.
+    PostedMessages* GetFirstPostedMessages() const;
+
+    mutable PostedMessages* m_pPostedMessages = nullptr;
+    ezUInt64 m_uiInstanceId;
+
     ezThreadID m_WriteThreadID;
     ezInt32 m_iWriteCounter;
     mutable ezAtomicInteger32 m_iReadCounter;
@@ -356,6 +356,8 @@ private:
   const char* GetObjectGlobalKey(const ezGameObject* pObject) const;
 
   void PostMessage(const ezGameObjectHandle& receiverObject, const ezMessage& msg, ezObjectMsgQueueType::Enum queueType, ezTime delay, bool bRecursive) const;
+  void PostMessageInternal(
+    const ezMessage& msg, const ezInternal::WorldData::QueuedMsgMetaData& metaData, ezObjectMsgQueueType::Enum queueType, ezTime delay) const;
   void ProcessQueuedMessage(const ezInternal::WorldData::MessageQueue::Entry& entry);
   void ProcessQueuedMessages(ezObjectMsgQueueType::Enum queueType);
 
@@ -1,11 +1,17 @@
 #pragma once
 
+#include <Foundation/Algorithm/HashingUtils.h>
 #include <Foundation/Basics.h>
 #include <Foundation/IO/Stream.h>
 
 typedef struct XXH32_state_s XXH32_state_t;
 typedef struct XXH64_state_s XXH64_state_t;
 
+namespace ezInternal
+{
+  struct XxH3StreamState;
+}
+
 /// \brief A stream writer that hashes the data written to it.
 ///
 /// This stream writer allows to conveniently generate a 32 bit hash value for any kind of data.
@@ -48,3 +54,49 @@ public:
 private:
   XXH64_state_t* m_state;
 };
+
+
+/// \brief A stream writer that hashes the data written to it using XXH3.
+///
+/// This stream writer allows to conveniently generate a 64 bit hash value for any kind of data. It is considerably faster than
+/// ezHashStreamWriter64 for large amounts of data, but produces different values, so hashes that are stored on disk need to be
+/// invalidated when switching between the two. The result is identical to ezHashingUtils::xxHash3_64 over the same data.
+class EZ_FOUNDATION_DLL ezHashStreamWriterXxHash3_64 : public ezStreamWriter
+{
+public:
+  /// \brief Pass an initial seed for the hash calculation.
+  ezHashStreamWriterXxHash3_64(ezUInt64 seed = 0);
+  ~ezHashStreamWriterXxHash3_64();
+
+  /// \brief Writes bytes directly to the stream.
+  virtual ezResult WriteBytes(const void* pWriteBuffer, ezUInt64 uiBytesToWrite) override; // [tested]
+
+  /// \brief Returns the current hash value. You can read this at any time between write operations, or after writing is done to get the final hash
+  /// value.
+  ezUInt64 GetHashValue() const; // [tested]
+
+private:
+  ezInternal::XxH3StreamState* m_pState;
+};
+
+
+/// \brief A stream writer that hashes the data written to it using the 128 bit variant of XXH3.
+///
+/// The result is identical to ezHashingUtils::xxHash3_128 over the same data.
+class EZ_FOUNDATION_DLL ezHashStreamWriterXxHash3_128 : public ezStreamWriter
+{
+public:
+  /// \brief Pass an initial seed for the hash calculation.
+  ezHashStreamWriterXxHash3_128(ezUInt64 seed = 0);
+  ~ezHashStreamWriterXxHash3_128();
+
+  /// \brief Writes bytes directly to the stream.
+  virtual ezResult WriteBytes(const void* pWriteBuffer, ezUInt64 uiBytesToWrite) override; // [tested]
+
+  /// \brief Returns the current hash value. You can read this at any time between write operations, or after writing is done to get the final hash
+  /// value.
+  ezHash128 GetHashValue() const; // [tested]
+
+private:
+  ezInternal::XxH3StreamState* m_pState;
+};
@@ -3,6 +3,15 @@
 
 #include <Foundation/Basics.h>
 
+/// \brief A 128 bit hash value, as returned by ezHashingUtils::xxHash3_128.
+struct ezHash128
+{
+  ezUInt64 m_uiLow = 0;
+  ezUInt64 m_uiHigh = 0;
+
+  constexpr bool operator==(const ezHash128& rhs) const { return m_uiLow == rhs.m_uiLow && m_uiHigh == rhs.m_uiHigh; }
+  constexpr bool operator!=(const ezHash128& rhs) const { return !(*this == rhs); }
+};
 
 /// \brief This class provides implementations of different hashing algorithms.
 class EZ_FOUNDATION_DLL ezHashingUtils
@@ -49,6 +58,24 @@ public:
   ///
   /// We cannot pass a string pointer directly since a string constant would be treated as pointer as well.
   static ezUInt64 xxHash64String(ezStringView str, ezUInt64 uiSeed = 0);
+
+  /// \brief Calculates the 64bit XXH3 hash of the given key.
+  ///
+  /// XXH3 is considerably faster than xxHash64 for both very small and very large inputs and should be preferred for new code.
+  /// Note that the results differ from xxHash64, so it must not be used as a drop-in replacement for hashes that are stored on disk.
+  static ezUInt64 xxHash3_64(const void* pKey, size_t uiSizeInByte, ezUInt64 uiSeed = 0); // [tested]
+
+  /// \brief Calculates the 128bit XXH3 hash of the given key.
+  static ezHash128 xxHash3_128(const void* pKey, size_t uiSizeInByte, ezUInt64 uiSeed = 0); // [tested]
+
+  /// \brief Calculates the 64bit XXH3 hash of the given string literal at compile time.
+  template <size_t N>
+  constexpr static ezUInt64 xxHash3_64String(const char (&str)[N], ezUInt64 uiSeed = 0); // [tested]
+
+  /// \brief Calculates the 64bit XXH3 hash of a string pointer during runtime.
+  ///
+  /// We cannot pass a string pointer directly since a string constant would be treated as pointer as well.
+  static ezUInt64 xxHash3_64String(ezStringView str, ezUInt64 uiSeed = 0); // [tested]
 };
 
 /// \brief Helper struct to calculate the Hash of different types.
@@ -64,3 +91,4 @@ struct ezHashHelper
 #include <Foundation/Algorithm/Implementation/HashingMurmur_inl.h>
 #include <Foundation/Algorithm/Implementation/HashingUtils_inl.h>
 #include <Foundation/Algorithm/Implementation/HashingXxHash_inl.h>
+#include <Foundation/Algorithm/Implementation/HashingXxHash3_inl.h>
@@ -60,4 +60,186 @@ ezUInt64 ezHashStreamWriter64::GetHashValue() const
   return XXH64_digest(m_state);
 }
 
+namespace ezInternal
+{
+  struct XxH3StreamState
+  {
+    static constexpr ezUInt32 BufferSize = 256;
+    static constexpr ezUInt32 BufferStripes = BufferSize / XXH3_STRIPE_LEN;
+
+    ezUInt64 m_Acc[8];
+    ezUInt8 m_CustomSecret[XXH3_SECRET_SIZE];
+    ezUInt8 m_Buffer[BufferSize];
+    ezUInt32 m_uiBufferedSize = 0;
+    size_t m_uiStripesSoFar = 0;
+    ezUInt64 m_uiTotalLength = 0;
+    ezUInt64 m_uiSeed = 0;
+
+    XxH3StreamState(ezUInt64 uiSeed)
+      : m_uiSeed(uiSeed)
+    {
+      XxH3InitAccumulators(m_Acc);
+      XxH3InitCustomSecret(m_CustomSecret, uiSeed);
+    }
+
+    /// \brief Accumulates the given stripes, scrambling the accumulators whenever a block is completed.
+    static const ezUInt8* ConsumeStripes(ezUInt64* pAcc, size_t& inout_uiStripesSoFar, const ezUInt8* pInput, size_t uiNumStripes, const ezUInt8* pSecret)
+    {
+      if (uiNumStripes >= XXH3_STRIPES_PER_BLOCK - inout_uiStripesSoFar)
+      {
+        size_t uiStripesThisIter = XXH3_STRIPES_PER_BLOCK - inout_uiStripesSoFar;
+        const ezUInt8* pInitialSecret = pSecret + inout_uiStripesSoFar * XXH3_SECRET_CONSUME_RATE;
+
+        do
+        {
+          XxH3Accumulate(pAcc, pInput, pInitialSecret, uiStripesThisIter);
+          XxH3ScrambleAccumulators(pAcc, pSecret + XXH3_SECRET_SIZE - XXH3_STRIPE_LEN);
+          pInput += uiStripesThisIter * XXH3_STRIPE_LEN;
+          uiNumStripes -= uiStripesThisIter;
+          uiStripesThisIter = XXH3_STRIPES_PER_BLOCK;
+          pInitialSecret = pSecret;
+        } while (uiNumStripes >= XXH3_STRIPES_PER_BLOCK);
+
+        inout_uiStripesSoFar = 0;
+      }
+
+      if (uiNumStripes > 0)
+      {
+        XxH3Accumulate(pAcc, pInput, pSecret + inout_uiStripesSoFar * XXH3_SECRET_CONSUME_RATE, uiNumStripes);
+        pInput += uiNumStripes * XXH3_STRIPE_LEN;
+        inout_uiStripesSoFar += uiNumStripes;
+      }
+
+      return pInput;
+    }
+
+    void Update(const ezUInt8* pInput, size_t uiSize)
+    {
+      if (uiSize == 0)
+        return;
+
+      const ezUInt8* pEnd = pInput + uiSize;
+      m_uiTotalLength += uiSize;
+
+      if (uiSize <= BufferSize - m_uiBufferedSize)
+      {
+        ezMemoryUtils::Copy(m_Buffer + m_uiBufferedSize, pInput, uiSize);
+        m_uiBufferedSize += static_cast<ezUInt32>(uiSize);
+        return;
+      }
+
+      // the buffer is always flushed only once more data arrives, so that the last stripe is still available in the digest
+      if (m_uiBufferedSize > 0)
+      {
+        const ezUInt32 uiLoadSize = BufferSize - m_uiBufferedSize;
+        ezMemoryUtils::Copy(m_Buffer + m_uiBufferedSize, pInput, uiLoadSize);
+        pInput += uiLoadSize;
+        ConsumeStripes(m_Acc, m_uiStripesSoFar, m_Buffer, BufferStripes, m_CustomSecret);
+        m_uiBufferedSize = 0;
+      }
+
+      if (static_cast<size_t>(pEnd - pInput) > BufferSize)
+      {
+        const size_t uiNumStripes = static_cast<size_t>(pEnd - 1 - pInput) / XXH3_STRIPE_LEN;
+        pInput = ConsumeStripes(m_Acc, m_uiStripesSoFar, pInput, uiNumStripes, m_CustomSecret);
+
+        // keep the last consumed stripe around, the digest may need it if less than a full stripe remains
+        ezMemoryUtils::Copy(m_Buffer + BufferSize - XXH3_STRIPE_LEN, pInput - XXH3_STRIPE_LEN, XXH3_STRIPE_LEN);
+      }
+
+      ezMemoryUtils::Copy(m_Buffer, pInput, static_cast<size_t>(pEnd - pInput));
+      m_uiBufferedSize = static_cast<ezUInt32>(pEnd - pInput);
+    }
+
+    /// \brief Computes the accumulators for the final digest of inputs longer than XXH3_MIDSIZE_MAX without modifying the state.
+    void DigestLong(ezUInt64* pAcc) const
+    {
+      ezMemoryUtils::Copy(pAcc, m_Acc, 8);
+
+      const ezUInt8* pLastStripe = nullptr;
+      ezUInt8 lastStripe[XXH3_STRIPE_LEN];
+
+      if (m_uiBufferedSize >= XXH3_STRIPE_LEN)
+      {
+        const size_t uiNumStripes = (m_uiBufferedSize - 1) / XXH3_STRIPE_LEN;
+        size_t uiStripesSoFar = m_uiStripesSoFar;
+        ConsumeStripes(pAcc, uiStripesSoFar, m_Buffer, uiNumStripes, m_CustomSecret);
+        pLastStripe = m_Buffer + m_uiBufferedSize - XXH3_STRIPE_LEN;
+      }
+      else
+      {
+        const ezUInt32 uiCatchUpSize = XXH3_STRIPE_LEN - m_uiBufferedSize;
+        ezMemoryUtils::Copy(lastStripe, m_Buffer + BufferSize - uiCatchUpSize, uiCatchUpSize);
+        ezMemoryUtils::Copy(lastStripe + uiCatchUpSize, m_Buffer, m_uiBufferedSize);
+        pLastStripe = lastStripe;
+      }
+
+      XxH3Accumulate(pAcc, pLastStripe, m_CustomSecret + XXH3_SECRET_SIZE - XXH3_STRIPE_LEN - 7, 1);
+    }
+  };
+} // namespace ezInternal
+
+ezHashStreamWriterXxHash3_64::ezHashStreamWriterXxHash3_64(ezUInt64 seed)
+{
+  m_pState = EZ_DEFAULT_NEW(ezInternal::XxH3StreamState, seed);
+}
+
+ezHashStreamWriterXxHash3_64::~ezHashStreamWriterXxHash3_64()
+{
+  EZ_DEFAULT_DELETE(m_pState);
+}
+
+ezResult ezHashStreamWriterXxHash3_64::WriteBytes(const void* pWriteBuffer, ezUInt64 uiBytesToWrite)
+{
+  if (uiBytesToWrite > std::numeric_limits<size_t>::max())
+    return EZ_FAILURE;
+
+  m_pState->Update(static_cast<const ezUInt8*>(pWriteBuffer), static_cast<size_t>(uiBytesToWrite));
+  return EZ_SUCCESS;
+}
+
+ezUInt64 ezHashStreamWriterXxHash3_64::GetHashValue() const
+{
+  if (m_pState->m_uiTotalLength > ezInternal::XXH3_MIDSIZE_MAX)
+  {
+    ezUInt64 acc[8];
+    m_pState->DigestLong(acc);
+    return ezInternal::XxH3FinalizeLong64(acc, m_pState->m_CustomSecret, m_pState->m_uiTotalLength);
+  }
+
+  return ezHashingUtils::xxHash3_64(m_pState->m_Buffer, static_cast<size_t>(m_pState->m_uiTotalLength), m_pState->m_uiSeed);
+}
+
+
+ezHashStreamWriterXxHash3_128::ezHashStreamWriterXxHash3_128(ezUInt64 seed)
+{
+  m_pState = EZ_DEFAULT_NEW(ezInternal::XxH3StreamState, seed);
+}
+
+ezHashStreamWriterXxHash3_128::~ezHashStreamWriterXxHash3_128()
+{
+  EZ_DEFAULT_DELETE(m_pState);
+}
+
+ezResult ezHashStreamWriterXxHash3_128::WriteBytes(const void* pWriteBuffer, ezUInt64 uiBytesToWrite)
+{
+  if (uiBytesToWrite > std::numeric_limits<size_t>::max())
+    return EZ_FAILURE;
+
+  m_pState->Update(static_cast<const ezUInt8*>(pWriteBuffer), static_cast<size_t>(uiBytesToWrite));
+  return EZ_SUCCESS;
+}
+
+ezHash128 ezHashStreamWriterXxHash3_128::GetHashValue() const
+{
+  if (m_pState->m_uiTotalLength > ezInternal::XXH3_MIDSIZE_MAX)
+  {
+    ezUInt64 acc[8];
+    m_pState->DigestLong(acc);
+    return ezInternal::XxH3FinalizeLong128(acc, m_pState->m_CustomSecret, m_pState->m_uiTotalLength);
+  }
+
+  return ezHashingUtils::xxHash3_128(m_pState->m_Buffer, static_cast<size_t>(m_pState->m_uiTotalLength), m_pState->m_uiSeed);
+}
+
 EZ_STATICLINK_FILE(Foundation, Foundation_Algorithm_Implementation_HashStream);
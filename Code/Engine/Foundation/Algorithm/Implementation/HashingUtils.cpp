@@ -212,4 +212,145 @@ ezUInt64 ezHashingUtils::xxHash64(const void* pKey, size_t uiSizeInByte, ezUInt6
   return XXH64(pKey, uiSizeInByte, uiSeed);
 }
 
+#if EZ_ENABLED(EZ_PLATFORM_ARCH_X86) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#  define EZ_XXH3_SSE2 EZ_ON
+#  include <emmintrin.h>
+#else
+#  define EZ_XXH3_SSE2 EZ_OFF
+#endif
+
+void ezInternal::XxH3Accumulate(ezUInt64* pAcc, const ezUInt8* pInput, const ezUInt8* pSecret, size_t uiNumStripes)
+{
+#if EZ_ENABLED(EZ_XXH3_SSE2)
+  __m128i acc[4];
+  for (ezUInt32 i = 0; i < 4; ++i)
+    acc[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pAcc) + i);
+
+  for (size_t s = 0; s < uiNumStripes; ++s)
+  {
+    const __m128i* pData = reinterpret_cast<const __m128i*>(pInput + s * XXH3_STRIPE_LEN);
+    const __m128i* pKey = reinterpret_cast<const __m128i*>(pSecret + s * XXH3_SECRET_CONSUME_RATE);
+
+    for (ezUInt32 i = 0; i < 4; ++i)
+    {
+      const __m128i data = _mm_loadu_si128(pData + i);
+      const __m128i dataKey = _mm_xor_si128(data, _mm_loadu_si128(pKey + i));
+      const __m128i dataKeyLo = _mm_shuffle_epi32(dataKey, _MM_SHUFFLE(0, 3, 0, 1));
+      const __m128i product = _mm_mul_epu32(dataKey, dataKeyLo);
+      const __m128i dataSwap = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+      acc[i] = _mm_add_epi64(product, _mm_add_epi64(acc[i], dataSwap));
+    }
+  }
+
+  for (ezUInt32 i = 0; i < 4; ++i)
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(pAcc) + i, acc[i]);
+#else
+  for (size_t s = 0; s < uiNumStripes; ++s)
+  {
+    XxH3Accumulate512Scalar(pAcc, pInput + s * XXH3_STRIPE_LEN, pSecret + s * XXH3_SECRET_CONSUME_RATE);
+  }
+#endif
+}
+
+void ezInternal::XxH3ScrambleAccumulators(ezUInt64* pAcc, const ezUInt8* pSecret)
+{
+#if EZ_ENABLED(EZ_XXH3_SSE2)
+  const __m128i prime32 = _mm_set1_epi32(static_cast<int>(PRIME32_1));
+
+  for (ezUInt32 i = 0; i < 4; ++i)
+  {
+    __m128i acc = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pAcc) + i);
+    acc = _mm_xor_si128(acc, _mm_srli_epi64(acc, 47));
+
+    const __m128i dataKey = _mm_xor_si128(acc, _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSecret) + i));
+    const __m128i dataKeyHi = _mm_shuffle_epi32(dataKey, _MM_SHUFFLE(0, 3, 0, 1));
+    const __m128i productLo = _mm_mul_epu32(dataKey, prime32);
+    const __m128i productHi = _mm_mul_epu32(dataKeyHi, prime32);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(pAcc) + i, _mm_add_epi64(productLo, _mm_slli_epi64(productHi, 32)));
+  }
+#else
+  XxH3ScrambleScalar(pAcc, pSecret);
+#endif
+}
+
+namespace
+{
+  void XxH3HashLong(ezUInt64* pAcc, const ezUInt8* pInput, size_t uiSizeInByte, const ezUInt8* pSecret)
+  {
+    using namespace ezInternal;
+
+    XxH3InitAccumulators(pAcc);
+
+    const size_t uiNumBlocks = (uiSizeInByte - 1) / XXH3_BLOCK_LEN;
+    for (size_t b = 0; b < uiNumBlocks; ++b)
+    {
+      XxH3Accumulate(pAcc, pInput + b * XXH3_BLOCK_LEN, pSecret, XXH3_STRIPES_PER_BLOCK);
+      XxH3ScrambleAccumulators(pAcc, pSecret + XXH3_SECRET_SIZE - XXH3_STRIPE_LEN);
+    }
+
+    const size_t uiNumStripes = ((uiSizeInByte - 1) - (XXH3_BLOCK_LEN * uiNumBlocks)) / XXH3_STRIPE_LEN;
+    XxH3Accumulate(pAcc, pInput + uiNumBlocks * XXH3_BLOCK_LEN, pSecret, uiNumStripes);
+
+    // last stripe
+    XxH3Accumulate(pAcc, pInput + uiSizeInByte - XXH3_STRIPE_LEN, pSecret + XXH3_SECRET_SIZE - XXH3_STRIPE_LEN - 7, 1);
+  }
+
+  const ezUInt8* XxH3GetSecret(ezUInt8* pCustomSecret, ezUInt64 uiSeed)
+  {
+    if (uiSeed == 0)
+      return ezInternal::XXH3_kSecret;
+
+    ezInternal::XxH3InitCustomSecret(pCustomSecret, uiSeed);
+    return pCustomSecret;
+  }
+} // namespace
+
+// static
+ezUInt64 ezHashingUtils::xxHash3_64(const void* pKey, size_t uiSizeInByte, ezUInt64 uiSeed /*= 0*/)
+{
+  using namespace ezInternal;
+
+  const ezUInt8* pInput = static_cast<const ezUInt8*>(pKey);
+
+  if (uiSizeInByte <= 16)
+    return XxH3Len0To16_64(pInput, uiSizeInByte, XXH3_kSecret, uiSeed);
+
+  if (uiSizeInByte <= 128)
+    return XxH3Len17To128_64(pInput, uiSizeInByte, XXH3_kSecret, uiSeed);
+
+  if (uiSizeInByte <= XXH3_MIDSIZE_MAX)
+    return XxH3Len129To240_64(pInput, uiSizeInByte, XXH3_kSecret, uiSeed);
+
+  ezUInt8 customSecret[XXH3_SECRET_SIZE];
+  const ezUInt8* pSecret = XxH3GetSecret(customSecret, uiSeed);
+
+  ezUInt64 acc[8];
+  XxH3HashLong(acc, pInput, uiSizeInByte, pSecret);
+  return XxH3FinalizeLong64(acc, pSecret, uiSizeInByte);
+}
+
+// static
+ezHash128 ezHashingUtils::xxHash3_128(const void* pKey, size_t uiSizeInByte, ezUInt64 uiSeed /*= 0*/)
+{
+  using namespace ezInternal;
+
+  const ezUInt8* pInput = static_cast<const ezUInt8*>(pKey);
+
+  if (uiSizeInByte <= 16)
+    return XxH3Len0To16_128(pInput, uiSizeInByte, XXH3_kSecret, uiSeed);
+
+  if (uiSizeInByte <= 128)
+    return XxH3Len17To128_128(pInput, uiSizeInByte, XXH3_kSecret, uiSeed);
+
+  if (uiSizeInByte <= XXH3_MIDSIZE_MAX)
+    return XxH3Len129To240_128(pInput, uiSizeInByte, XXH3_kSecret, uiSeed);
+
+  ezUInt8 customSecret[XXH3_SECRET_SIZE];
+  const ezUInt8* pSecret = XxH3GetSecret(customSecret, uiSeed);
+
+  ezUInt64 acc[8];
+  XxH3HashLong(acc, pInput, uiSizeInByte, pSecret);
+  return XxH3FinalizeLong128(acc, pSecret, uiSizeInByte);
+}
+
 EZ_STATICLINK_FILE(Foundation, Foundation_Algorithm_Implementation_HashingUtils);
@@ -0,0 +1,462 @@
+#pragma once
+
+// Implementation of XXH3 (xxHash 0.8 final output), ported from the BSD licensed reference implementation by Yann Collet.
+// The scalar code in here is constexpr so that it can be used for compile time string hashing. The runtime versions in HashingUtils.cpp
+// share the short input paths and only use vectorized kernels for the stripe accumulation of long inputs.
+
+namespace ezInternal
+{
+  constexpr ezUInt64 XXH3_PRIME_MX1 = 0x165667919E3779F9ULL;
+  constexpr ezUInt64 XXH3_PRIME_MX2 = 0x9FB21C651E98DF25ULL;
+
+  constexpr ezUInt32 XXH3_SECRET_SIZE = 192;
+  constexpr ezUInt32 XXH3_STRIPE_LEN = 64;
+  constexpr ezUInt32 XXH3_SECRET_CONSUME_RATE = 8;
+  constexpr ezUInt32 XXH3_STRIPES_PER_BLOCK = (XXH3_SECRET_SIZE - XXH3_STRIPE_LEN) / XXH3_SECRET_CONSUME_RATE;
+  constexpr ezUInt32 XXH3_BLOCK_LEN = XXH3_STRIPE_LEN * XXH3_STRIPES_PER_BLOCK;
+  constexpr ezUInt32 XXH3_MIDSIZE_MAX = 240;
+
+  /// \brief The default secret of XXH3. Seeded hashes of long inputs derive a custom secret from it.
+  inline constexpr ezUInt8 XXH3_kSecret[XXH3_SECRET_SIZE] = {
+    0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c, //
+    0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f, //
+    0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21, //
+    0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c, //
+    0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3, //
+    0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8, //
+    0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d, //
+    0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64, //
+    0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb, //
+    0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e, //
+    0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce, //
+    0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e, //
+  };
+
+  template <typename T>
+  constexpr ezUInt32 XxH3ReadLE32(const T* p)
+  {
+    return (static_cast<ezUInt32>(static_cast<ezUInt8>(p[0])) << 0) | (static_cast<ezUInt32>(static_cast<ezUInt8>(p[1])) << 8) |
+           (static_cast<ezUInt32>(static_cast<ezUInt8>(p[2])) << 16) | (static_cast<ezUInt32>(static_cast<ezUInt8>(p[3])) << 24);
+  }
+
+  template <typename T>
+  constexpr ezUInt64 XxH3ReadLE64(const T* p)
+  {
+    return static_cast<ezUInt64>(XxH3ReadLE32(p)) | (static_cast<ezUInt64>(XxH3ReadLE32(p + 4)) << 32);
+  }
+
+  constexpr ezUInt32 XxH3Swap32(ezUInt32 x)
+  {
+    return ((x << 24) & 0xff000000) | ((x << 8) & 0x00ff0000) | ((x >> 8) & 0x0000ff00) | ((x >> 24) & 0x000000ff);
+  }
+
+  constexpr ezUInt64 XxH3Swap64(ezUInt64 x)
+  {
+    return (static_cast<ezUInt64>(XxH3Swap32(static_cast<ezUInt32>(x))) << 32) | XxH3Swap32(static_cast<ezUInt32>(x >> 32));
+  }
+
+  constexpr ezHash128 XxH3Mult64to128(ezUInt64 lhs, ezUInt64 rhs)
+  {
+#if defined(__SIZEOF_INT128__)
+    const unsigned __int128 product = static_cast<unsigned __int128>(lhs) * rhs;
+    return {static_cast<ezUInt64>(product), static_cast<ezUInt64>(product >> 64)};
+#else
+    const ezUInt64 lo_lo = (lhs & 0xFFFFFFFF) * (rhs & 0xFFFFFFFF);
+    const ezUInt64 hi_lo = (lhs >> 32) * (rhs & 0xFFFFFFFF);
+    const ezUInt64 lo_hi = (lhs & 0xFFFFFFFF) * (rhs >> 32);
+    const ezUInt64 hi_hi = (lhs >> 32) * (rhs >> 32);
+    const ezUInt64 cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+    const ezUInt64 upper = (hi_lo >> 32) + (cross >> 32) + hi_hi;
+    const ezUInt64 lower = (cross << 32) | (lo_lo & 0xFFFFFFFF);
+    return {lower, upper};
+#endif
+  }
+
+  constexpr ezUInt64 XxH3Mul128Fold64(ezUInt64 lhs, ezUInt64 rhs)
+  {
+    const ezHash128 product = XxH3Mult64to128(lhs, rhs);
+    return product.m_uiLow ^ product.m_uiHigh;
+  }
+
+  constexpr ezUInt64 XxH64Avalanche(ezUInt64 h)
+  {
+    h ^= h >> 33;
+    h *= PRIME64_2;
+    h ^= h >> 29;
+    h *= PRIME64_3;
+    h ^= h >> 32;
+    return h;
+  }
+
+  constexpr ezUInt64 XxH3Avalanche(ezUInt64 h)
+  {
+    h ^= h >> 37;
+    h *= XXH3_PRIME_MX1;
+    h ^= h >> 32;
+    return h;
+  }
+
+  constexpr ezUInt64 XxH3rrmxmx(ezUInt64 h, ezUInt64 len)
+  {
+    h ^= ezRotLeft(h, 49ULL) ^ ezRotLeft(h, 24ULL);
+    h *= XXH3_PRIME_MX2;
+    h ^= (h >> 35) + len;
+    h *= XXH3_PRIME_MX2;
+    h ^= h >> 28;
+    return h;
+  }
+
+  template <typename T>
+  constexpr ezUInt64 XxH3Mix16B(const T* pInput, const ezUInt8* pSecret, ezUInt64 seed)
+  {
+    return XxH3Mul128Fold64(XxH3ReadLE64(pInput) ^ (XxH3ReadLE64(pSecret) + seed), XxH3ReadLE64(pInput + 8) ^ (XxH3ReadLE64(pSecret + 8) - seed));
+  }
+
+  //////////////////////////////////////////////////////////////////////////
+  // 64 bit, up to 240 bytes
+
+  template <typename T>
+  constexpr ezUInt64 XxH3Len0To16_64(const T* pInput, size_t len, const ezUInt8* pSecret, ezUInt64 seed)
+  {
+    if (len > 8)
+    {
+      const ezUInt64 bitflip1 = (XxH3ReadLE64(pSecret + 24) ^ XxH3ReadLE64(pSecret + 32)) + seed;
+      const ezUInt64 bitflip2 = (XxH3ReadLE64(pSecret + 40) ^ XxH3ReadLE64(pSecret + 48)) - seed;
+      const ezUInt64 inputLo = XxH3ReadLE64(pInput) ^ bitflip1;
+      const ezUInt64 inputHi = XxH3ReadLE64(pInput + len - 8) ^ bitflip2;
+      const ezUInt64 acc = len + XxH3Swap64(inputLo) + inputHi + XxH3Mul128Fold64(inputLo, inputHi);
+      return XxH3Avalanche(acc);
+    }
+
+    if (len >= 4)
+    {
+      seed ^= static_cast<ezUInt64>(XxH3Swap32(static_cast<ezUInt32>(seed))) << 32;
+      const ezUInt64 input64 = XxH3ReadLE32(pInput + len - 4) + (static_cast<ezUInt64>(XxH3ReadLE32(pInput)) << 32);
+      const ezUInt64 bitflip = (XxH3ReadLE64(pSecret + 8) ^ XxH3ReadLE64(pSecret + 16)) - seed;
+      return XxH3rrmxmx(input64 ^ bitflip, len);
+    }
+
+    if (len > 0)
+    {
+      const ezUInt32 c1 = static_cast<ezUInt8>(pInput[0]);
+      const ezUInt32 c2 = static_cast<ezUInt8>(pInput[len >> 1]);
+      const ezUInt32 c3 = static_cast<ezUInt8>(pInput[len - 1]);
+      const ezUInt32 combined = (c1 << 16) | (c2 << 24) | c3 | (static_cast<ezUInt32>(len) << 8);
+      const ezUInt64 bitflip = (XxH3ReadLE32(pSecret) ^ XxH3ReadLE32(pSecret + 4)) + seed;
+      return XxH64Avalanche(combined ^ bitflip);
+    }
+
+    return XxH64Avalanche(seed ^ (XxH3ReadLE64(pSecret + 56) ^ XxH3ReadLE64(pSecret + 64)));
+  }
+
+  template <typename T>
+  constexpr ezUInt64 XxH3Len17To128_64(const T* pInput, size_t len, const ezUInt8* pSecret, ezUInt64 seed)
+  {
+    ezUInt64 acc = len * PRIME64_1;
+    if (len > 32)
+    {
+      if (len > 64)
+      {
+        if (len > 96)
+        {
+          acc += XxH3Mix16B(pInput + 48, pSecret + 96, seed);
+          acc += XxH3Mix16B(pInput + len - 64, pSecret + 112, seed);
+        }
+        acc += XxH3Mix16B(pInput + 32, pSecret + 64, seed);
+        acc += XxH3Mix16B(pInput + len - 48, pSecret + 80, seed);
+      }
+      acc += XxH3Mix16B(pInput + 16, pSecret + 32, seed);
+      acc += XxH3Mix16B(pInput + len - 32, pSecret + 48, seed);
+    }
+    acc += XxH3Mix16B(pInput + 0, pSecret + 0, seed);
+    acc += XxH3Mix16B(pInput + len - 16, pSecret + 16, seed);
+    return XxH3Avalanche(acc);
+  }
+
+  template <typename T>
+  constexpr ezUInt64 XxH3Len129To240_64(const T* pInput, size_t len, const ezUInt8* pSecret, ezUInt64 seed)
+  {
+    ezUInt64 acc = len * PRIME64_1;
+    for (size_t i = 0; i < 8; ++i)
+    {
+      acc += XxH3Mix16B(pInput + 16 * i, pSecret + 16 * i, seed);
+    }
+
+    // the last 16 bytes are mixed with an offset secret, see XXH3_MIDSIZE_LASTOFFSET in the reference implementation
+    ezUInt64 accEnd = XxH3Mix16B(pInput + len - 16, pSecret + 136 - 17, seed);
+    acc = XxH3Avalanche(acc);
+
+    const size_t uiNumRounds = len / 16;
+    for (size_t i = 8; i < uiNumRounds; ++i)
+    {
+      accEnd += XxH3Mix16B(pInput + 16 * i, pSecret + 16 * (i - 8) + 3, seed);
+    }
+
+    return XxH3Avalanche(acc + accEnd);
+  }
+
+  //////////////////////////////////////////////////////////////////////////
+  // 128 bit, up to 240 bytes
+
+  template <typename T>
+  constexpr ezHash128 XxH3Len0To16_128(const T* pInput, size_t len, const ezUInt8* pSecret, ezUInt64 seed)
+  {
+    if (len > 8)
+    {
+      const ezUInt64 bitflipLo = (XxH3ReadLE64(pSecret + 32) ^ XxH3ReadLE64(pSecret + 40)) - seed;
+      const ezUInt64 bitflipHi = (XxH3ReadLE64(pSecret + 48) ^ XxH3ReadLE64(pSecret + 56)) + seed;
+      const ezUInt64 inputLo = XxH3ReadLE64(pInput);
+      const ezUInt64 inputHi = XxH3ReadLE64(pInput + len - 8) ^ bitflipHi;
+
+      ezHash128 m128 = XxH3Mult64to128(inputLo ^ XxH3ReadLE64(pInput + len - 8) ^ bitflipLo, PRIME64_1);
+      m128.m_uiLow += static_cast<ezUInt64>(len - 1) << 54;
+      m128.m_uiHigh += inputHi + (inputHi & 0xFFFFFFFF) * (PRIME32_2 - 1);
+      m128.m_uiLow ^= XxH3Swap64(m128.m_uiHigh);
+
+      ezHash128 h128 = XxH3Mult64to128(m128.m_uiLow, PRIME64_2);
+      h128.m_uiHigh += m128.m_uiHigh * PRIME64_2;
+      h128.m_uiLow = XxH3Avalanche(h128.m_uiLow);
+      h128.m_uiHigh = XxH3Avalanche(h128.m_uiHigh);
+      return h128;
+    }
+
+    if (len >= 4)
+    {
+      seed ^= static_cast<ezUInt64>(XxH3Swap32(static_cast<ezUInt32>(seed))) << 32;
+      const ezUInt64 input64 = XxH3ReadLE32(pInput) + (static_cast<ezUInt64>(XxH3ReadLE32(pInput + len - 4)) << 32);
+      const ezUInt64 bitflip = (XxH3ReadLE64(pSecret + 16) ^ XxH3ReadLE64(pSecret + 24)) + seed;
+
+      ezHash128 m128 = XxH3Mult64to128(input64 ^ bitflip, PRIME64_1 + (len << 2));
+      m128.m_uiHigh += (m128.m_uiLow << 1);
+      m128.m_uiLow ^= (m128.m_uiHigh >> 3);
+      m128.m_uiLow ^= m128.m_uiLow >> 35;
+      m128.m_uiLow *= XXH3_PRIME_MX2;
+      m128.m_uiLow ^= m128.m_uiLow >> 28;
+      m128.m_uiHigh = XxH3Avalanche(m128.m_uiHigh);
+      return m128;
+    }
+
+    if (len > 0)
+    {
+      const ezUInt32 c1 = static_cast<ezUInt8>(pInput[0]);
+      const ezUInt32 c2 = static_cast<ezUInt8>(pInput[len >> 1]);
+      const ezUInt32 c3 = static_cast<ezUInt8>(pInput[len - 1]);
+      const ezUInt32 combinedLo = (c1 << 16) | (c2 << 24) | c3 | (static_cast<ezUInt32>(len) << 8);
+      const ezUInt32 combinedHi = ezRotLeft(XxH3Swap32(combinedLo), 13u);
+      const ezUInt64 bitflipLo = (XxH3ReadLE32(pSecret) ^ XxH3ReadLE32(pSecret + 4)) + seed;
+      const ezUInt64 bitflipHi = (XxH3ReadLE32(pSecret + 8) ^ XxH3ReadLE32(pSecret + 12)) - seed;
+      return {XxH64Avalanche(combinedLo ^ bitflipLo), XxH64Avalanche(combinedHi ^ bitflipHi)};
+    }
+
+    const ezUInt64 bitflipLo = XxH3ReadLE64(pSecret + 64) ^ XxH3ReadLE64(pSecret + 72);
+    const ezUInt64 bitflipHi = XxH3ReadLE64(pSecret + 80) ^ XxH3ReadLE64(pSecret + 88);
+    return {XxH64Avalanche(seed ^ bitflipLo), XxH64Avalanche(seed ^ bitflipHi)};
+  }
+
+  template <typename T>
+  constexpr void XxH3Mix32B(ezHash128& acc, const T* pInput1, const T* pInput2, const ezUInt8* pSecret, ezUInt64 seed)
+  {
+    acc.m_uiLow += XxH3Mix16B(pInput1, pSecret, seed);
+    acc.m_uiLow ^= XxH3ReadLE64(pInput2) + XxH3ReadLE64(pInput2 + 8);
+    acc.m_uiHigh += XxH3Mix16B(pInput2, pSecret + 16, seed);
+    acc.m_uiHigh ^= XxH3ReadLE64(pInput1) + XxH3ReadLE64(pInput1 + 8);
+  }
+
+  constexpr ezHash128 XxH3Finalize128(const ezHash128& acc, size_t len, ezUInt64 seed)
+  {
+    const ezUInt64 low = acc.m_uiLow + acc.m_uiHigh;
+    const ezUInt64 high = (acc.m_uiLow * PRIME64_1) + (acc.m_uiHigh * PRIME64_4) + ((len - seed) * PRIME64_2);
+    return {XxH3Avalanche(low), static_cast<ezUInt64>(0) - XxH3Avalanche(high)};
+  }
+
+  template <typename T>
+  constexpr ezHash128 XxH3Len17To128_128(const T* pInput, size_t len, const ezUInt8* pSecret, ezUInt64 seed)
+  {
+    ezHash128 acc = {len * PRIME64_1, 0};
+    if (len > 32)
+    {
+      if (len > 64)
+      {
+        if (len > 96)
+        {
+          XxH3Mix32B(acc, pInput + 48, pInput + len - 64, pSecret + 96, seed);
+        }
+        XxH3Mix32B(acc, pInput + 32, pInput + len - 48, pSecret + 64, seed);
+      }
+      XxH3Mix32B(acc, pInput + 16, pInput + len - 32, pSecret + 32, seed);
+    }
+    XxH3Mix32B(acc, pInput, pInput + len - 16, pSecret, seed);
+    return XxH3Finalize128(acc, len, seed);
+  }
+
+  template <typename T>
+  constexpr ezHash128 XxH3Len129To240_128(const T* pInput, size_t len, const ezUInt8* pSecret, ezUInt64 seed)
+  {
+    ezHash128 acc = {len * PRIME64_1, 0};
+    for (size_t i = 32; i < 160; i += 32)
+    {
+      XxH3Mix32B(acc, pInput + i - 32, pInput + i - 16, pSecret + i - 32, seed);
+    }
+
+    acc.m_uiLow = XxH3Avalanche(acc.m_uiLow);
+    acc.m_uiHigh = XxH3Avalanche(acc.m_uiHigh);
+
+    // Note: this duplicates the last 32 bytes if len is a multiple of 32, the reference implementation does the same.
+    for (size_t i = 160; i <= len; i += 32)
+    {
+      XxH3Mix32B(acc, pInput + i - 32, pInput + i - 16, pSecret + 3 + i - 160, seed);
+    }
+
+    XxH3Mix32B(acc, pInput + len - 16, pInput + len - 32, pSecret + 136 - 17 - 16, static_cast<ezUInt64>(0) - seed);
+    return XxH3Finalize128(acc, len, seed);
+  }
+
+  //////////////////////////////////////////////////////////////////////////
+  // Long inputs
+
+  constexpr void XxH3InitAccumulators(ezUInt64* pAcc)
+  {
+    pAcc[0] = PRIME32_3;
+    pAcc[1] = PRIME64_1;
+    pAcc[2] = PRIME64_2;
+    pAcc[3] = PRIME64_3;
+    pAcc[4] = PRIME64_4;
+    pAcc[5] = PRIME32_2;
+    pAcc[6] = PRIME64_5;
+    pAcc[7] = PRIME32_1;
+  }
+
+  /// \brief Derives the secret that is used for seeded hashes of long inputs.
+  constexpr void XxH3InitCustomSecret(ezUInt8* pCustomSecret, ezUInt64 seed)
+  {
+    for (ezUInt32 i = 0; i < XXH3_SECRET_SIZE / 16; ++i)
+    {
+      const ezUInt64 lo = XxH3ReadLE64(XXH3_kSecret + 16 * i) + seed;
+      const ezUInt64 hi = XxH3ReadLE64(XXH3_kSecret + 16 * i + 8) - seed;
+      for (ezUInt32 b = 0; b < 8; ++b)
+      {
+        pCustomSecret[16 * i + b] = static_cast<ezUInt8>(lo >> (8 * b));
+        pCustomSecret[16 * i + 8 + b] = static_cast<ezUInt8>(hi >> (8 * b));
+      }
+    }
+  }
+
+  template <typename T>
+  constexpr void XxH3Accumulate512Scalar(ezUInt64* pAcc, const T* pInput, const ezUInt8* pSecret)
+  {
+    for (ezUInt32 i = 0; i < 8; ++i)
+    {
+      const ezUInt64 dataVal = XxH3ReadLE64(pInput + 8 * i);
+      const ezUInt64 dataKey = dataVal ^ XxH3ReadLE64(pSecret + 8 * i);
+      pAcc[i ^ 1] += dataVal;
+      pAcc[i] += (dataKey & 0xFFFFFFFF) * (dataKey >> 32);
+    }
+  }
+
+  constexpr void XxH3ScrambleScalar(ezUInt64* pAcc, const ezUInt8* pSecret)
+  {
+    for (ezUInt32 i = 0; i < 8; ++i)
+    {
+      ezUInt64 acc = pAcc[i];
+      acc ^= acc >> 47;
+      acc ^= XxH3ReadLE64(pSecret + 8 * i);
+      acc *= PRIME32_1;
+      pAcc[i] = acc;
+    }
+  }
+
+  constexpr ezUInt64 XxH3MergeAccumulators(const ezUInt64* pAcc, const ezUInt8* pSecret, ezUInt64 start)
+  {
+    ezUInt64 result = start;
+    for (ezUInt32 i = 0; i < 4; ++i)
+    {
+      result += XxH3Mul128Fold64(pAcc[2 * i] ^ XxH3ReadLE64(pSecret + 16 * i), pAcc[2 * i + 1] ^ XxH3ReadLE64(pSecret + 16 * i + 8));
+    }
+    return XxH3Avalanche(result);
+  }
+
+  /// \brief Final conversion of the accumulators of a long input into a 64 or 128 bit hash.
+  constexpr ezUInt64 XxH3FinalizeLong64(const ezUInt64* pAcc, const ezUInt8* pSecret, ezUInt64 len)
+  {
+    return XxH3MergeAccumulators(pAcc, pSecret + 11, len * PRIME64_1);
+  }
+
+  constexpr ezHash128 XxH3FinalizeLong128(const ezUInt64* pAcc, const ezUInt8* pSecret, ezUInt64 len)
+  {
+    return {XxH3MergeAccumulators(pAcc, pSecret + 11, len * PRIME64_1),
+      XxH3MergeAccumulators(pAcc, pSecret + XXH3_SECRET_SIZE - 64 - 11, ~(len * PRIME64_2))};
+  }
+
+  /// \brief Scalar stripe loop over an input of more than XXH3_MIDSIZE_MAX bytes. Only used at compile time, the runtime version uses
+  /// XxH3Accumulate and XxH3ScrambleAccumulators.
+  template <typename T>
+  constexpr void XxH3HashLongScalar(ezUInt64* pAcc, const T* pInput, size_t len, const ezUInt8* pSecret)
+  {
+    XxH3InitAccumulators(pAcc);
+
+    const size_t uiNumBlocks = (len - 1) / XXH3_BLOCK_LEN;
+    for (size_t b = 0; b < uiNumBlocks; ++b)
+    {
+      for (size_t s = 0; s < XXH3_STRIPES_PER_BLOCK; ++s)
+      {
+        XxH3Accumulate512Scalar(pAcc, pInput + b * XXH3_BLOCK_LEN + s * XXH3_STRIPE_LEN, pSecret + s * XXH3_SECRET_CONSUME_RATE);
+      }
+      XxH3ScrambleScalar(pAcc, pSecret + XXH3_SECRET_SIZE - XXH3_STRIPE_LEN);
+    }
+
+    const size_t uiNumStripes = ((len - 1) - (XXH3_BLOCK_LEN * uiNumBlocks)) / XXH3_STRIPE_LEN;
+    for (size_t s = 0; s < uiNumStripes; ++s)
+    {
+      XxH3Accumulate512Scalar(pAcc, pInput + uiNumBlocks * XXH3_BLOCK_LEN + s * XXH3_STRIPE_LEN, pSecret + s * XXH3_SECRET_CONSUME_RATE);
+    }
+
+    // last stripe
+    XxH3Accumulate512Scalar(pAcc, pInput + len - XXH3_STRIPE_LEN, pSecret + XXH3_SECRET_SIZE - XXH3_STRIPE_LEN - 7);
+  }
+
+  /// \brief Runtime version of the stripe accumulation, vectorized where available. Also used by the XXH3 hash stream writers.
+  EZ_FOUNDATION_DLL void XxH3Accumulate(ezUInt64* pAcc, const ezUInt8* pInput, const ezUInt8* pSecret, size_t uiNumStripes);
+
+  /// \brief Runtime version of XxH3ScrambleScalar, vectorized where available.
+  EZ_FOUNDATION_DLL void XxH3ScrambleAccumulators(ezUInt64* pAcc, const ezUInt8* pSecret);
+
+  template <size_t N>
+  constexpr ezUInt64 CompileTimeXxHash3_64(const char (&str)[N], ezUInt64 uiSeed)
+  {
+    // Note: N will contain the trailing 0 of a string literal. This needs to be ignored.
+    constexpr size_t length = N - 1;
+
+    if constexpr (length <= 16)
+    {
+      return XxH3Len0To16_64(str, length, XXH3_kSecret, uiSeed);
+    }
+    else if constexpr (length <= 128)
+    {
+      return XxH3Len17To128_64(str, length, XXH3_kSecret, uiSeed);
+    }
+    else if constexpr (length <= XXH3_MIDSIZE_MAX)
+    {
+      return XxH3Len129To240_64(str, length, XXH3_kSecret, uiSeed);
+    }
+    else
+    {
+      ezUInt8 customSecret[XXH3_SECRET_SIZE] = {};
+      XxH3InitCustomSecret(customSecret, uiSeed);
+
+      ezUInt64 acc[8] = {};
+      XxH3HashLongScalar(acc, str, length, customSecret);
+      return XxH3FinalizeLong64(acc, customSecret, length);
+    }
+  }
+} // namespace ezInternal
+
+template <size_t N>
+constexpr EZ_ALWAYS_INLINE ezUInt64 ezHashingUtils::xxHash3_64String(const char (&str)[N], ezUInt64 uiSeed)
+{
+  return ezInternal::CompileTimeXxHash3_64(str, uiSeed);
+}
+
+EZ_ALWAYS_INLINE ezUInt64 ezHashingUtils::xxHash3_64String(ezStringView str, ezUInt64 uiSeed)
+{
+  return xxHash3_64(str.GetStartPointer(), str.GetElementCount(), uiSeed);
+}
@@ -2,6 +2,7 @@
 
 #include <Foundation/Containers/DynamicArray.h>
 #include <Foundation/Containers/HybridArray.h>
+#include <Foundation/Threading/AtomicInteger.h>
 #include <Foundation/Threading/Lock.h>
 #include <Foundation/Threading/Mutex.h>
 #include <Foundation/Types/Delegate.h>
@@ -12,10 +13,49 @@ typedef ezUInt32 ezEventSubscriptionID;
 /// \brief Specifies the type of ezEvent implementation to use
 enum class ezEventType
 {
-  Default,        /// Default implementation. Does not support modifying the event while broadcasting.
-  CopyOnBroadcast /// CopyOnBroadcast implementation. Supports modifying the event while broadcasting.
+  Default,         /// Default implementation. Does not support modifying the event while broadcasting.
+  CopyOnBroadcast, /// CopyOnBroadcast implementation. Supports modifying the event while broadcasting.
+  CopyOnWrite      /// CopyOnWrite implementation. Supports modifying the event while broadcasting and broadcasts never lock the mutex.
 };
 
+namespace ezInternal
+{
+  template <typename Handler>
+  struct EventHandlerData
+  {
+    Handler m_Handler;
+    ezEventSubscriptionID m_SubscriptionID;
+  };
+
+  /// \brief Used with ezEventType::CopyOnWrite. An immutable copy of the event handlers that broadcasts iterate over.
+  template <typename Handler>
+  struct EventHandlerSnapshot
+  {
+    EventHandlerSnapshot(ezAllocatorBase* pAllocator)
+      : m_Handlers(pAllocator)
+    {
+    }
+
+    ezDynamicArray<EventHandlerData<Handler>> m_Handlers;
+    ezAtomicInteger32 m_iNumBroadcasts;      ///< the broadcasts that currently use this snapshot
+    EventHandlerSnapshot* m_pNext = nullptr; ///< next snapshot in the list of retired or free snapshots
+  };
+
+  /// \brief The state that only ezEventType::CopyOnWrite needs. Empty for the other event types, so as a base class it takes no space.
+  template <typename Handler, bool CopyOnWrite>
+  struct EventCopyOnWriteState
+  {
+  };
+
+  template <typename Handler>
+  struct EventCopyOnWriteState<Handler, true>
+  {
+    mutable EventHandlerSnapshot<Handler>* m_pSnapshot = nullptr;
+    mutable EventHandlerSnapshot<Handler>* m_pRetiredSnapshots = nullptr; ///< replaced snapshots that running broadcasts may still use
+    mutable EventHandlerSnapshot<Handler>* m_pFreeSnapshots = nullptr;    ///< unused snapshots, they are only deleted together with the event
+  };
+} // namespace ezInternal
+
 /// \brief This class propagates event information to registered event handlers.
 ///
 /// An event can be anything that "happens" that might be of interest to other code, such
@@ -29,12 +69,19 @@ enum class ezEventType
 /// set EventType = ezEventType::CopyOnBroadcast. Each broadcast will then copy the event handler array before signaling them, allowing
 /// modifications during broadcasting.
 ///
+/// If an event is broadcast from many threads at the same time, set EventType = ezEventType::CopyOnWrite.
+/// Adding or removing an event handler then creates a new, immutable copy of the event handler array, which replaces the previous one.
+/// Broadcasts only read the current copy and never lock the mutex, so they neither wait for each other nor for (un)registering handlers.
+/// Each copy counts the broadcasts that use it. Once the broadcasts of a replaced copy are finished, the next change to the event handlers
+/// releases its handlers and reuses its memory for a later copy. As with ezEventType::CopyOnBroadcast, handlers may be called
+/// from several threads at the same time, and a handler may still be called by a broadcast that started before it was removed.
+///
 /// \note A class holding an ezEvent member needs to provide public access to the member for external code to
 /// be able to register as an event handler. To make it possible to prevent external code from also raising events,
 /// all functions that are needed for listening are const, and all others are non-const.
 /// Therefore, simply make event members private and provide const reference access through a public getter.
 template <typename EventData, typename MutexType, ezEventType EventType>
-class ezEventBase
+class ezEventBase : private ezInternal::EventCopyOnWriteState<ezDelegate<void(EventData)>, EventType == ezEventType::CopyOnWrite>
 {
 protected:
   /// \brief Constructor.
@@ -102,11 +149,12 @@ public:
   enum
   {
     /// If the uiMaxRecursionDepth parameter to Broadcast is supported in this implementation or not.
-    RecursionDepthSupported = (EventType == ezEventType::Default || ezConversionTest<MutexType, ezNoMutex>::sameType == 1) ? 1 : 0,
+    RecursionDepthSupported =
+      (EventType == ezEventType::Default || (EventType == ezEventType::CopyOnBroadcast && ezConversionTest<MutexType, ezNoMutex>::sameType == 1)) ? 1 : 0,
 
     /// Default value for the maximum recursion depth of Broadcast.
-    /// As limiting the recursion depth is not supported when EventType == ezEventType::CopyAndBroadcast and MutexType != ezNoMutex
-    /// the default value for that case is the maximum.
+    /// As limiting the recursion depth is not supported when EventType == ezEventType::CopyAndBroadcast and MutexType != ezNoMutex,
+    /// or when EventType == ezEventType::CopyOnWrite, the default value for these cases is the maximum.
     MaxRecursionDepthDefault = RecursionDepthSupported ? 0 : 255
   };
 
@@ -155,14 +203,17 @@ private:
   bool m_bCurrentlyBroadcasting = false;
 #endif
 
-  struct HandlerData
-  {
-    Handler m_Handler;
-    ezEventSubscriptionID m_SubscriptionID;
-  };
+  using HandlerData = ezInternal::EventHandlerData<Handler>;
+  using HandlerSnapshot = ezInternal::EventHandlerSnapshot<Handler>;
 
   /// \brief A dynamic array allows to have zero overhead as long as no event handlers are registered.
   mutable ezDynamicArray<HandlerData> m_EventHandlers;
+
+  /// \brief Replaces the snapshot with a copy of m_EventHandlers. Must be called with the mutex locked.
+  void PublishSnapshot() const;
+
+  /// \brief Moves the retired snapshots that no broadcast uses anymore to the free list. Must be called with the mutex locked.
+  void ReclaimRetiredSnapshots() const;
 };
 
 /// \brief Can be used when ezEvent is used without any additional data
@@ -182,4 +233,7 @@ public:
 template <typename EventData, typename MutexType = ezNoMutex, typename AllocatorWrapper = ezDefaultAllocatorWrapper>
 using ezCopyOnBroadcastEvent = ezEvent<EventData, MutexType, AllocatorWrapper, ezEventType::CopyOnBroadcast>;
 
+template <typename EventData, typename MutexType = ezNoMutex, typename AllocatorWrapper = ezDefaultAllocatorWrapper>
+using ezCopyOnWriteEvent = ezEvent<EventData, MutexType, AllocatorWrapper, ezEventType::CopyOnWrite>;
+
 #include <Foundation/Communication/Implementation/Event_inl.h>
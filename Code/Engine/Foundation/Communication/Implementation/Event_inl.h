@@ -19,6 +19,27 @@ ezEventBase<EventData, MutexType, EventType>::~ezEventBase()
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
   EZ_ASSERT_ALWAYS(m_pSelf == this, "The ezEvent was relocated in memory. This is not allowed, as it breaks the Unsubscribers.");
 #endif
+
+  if constexpr (EventType == ezEventType::CopyOnWrite)
+  {
+    HandlerSnapshot* pCurrentSnapshot = this->m_pSnapshot;
+    this->m_pSnapshot = nullptr;
+
+    for (HandlerSnapshot* pSnapshots : {pCurrentSnapshot, this->m_pRetiredSnapshots, this->m_pFreeSnapshots})
+    {
+      while (pSnapshots != nullptr)
+      {
+        HandlerSnapshot* pSnapshot = pSnapshots;
+        pSnapshots = pSnapshot->m_pNext;
+
+        EZ_ASSERT_DEV(pSnapshot->m_iNumBroadcasts == 0, "The ezEvent is destroyed while it is being broadcast.");
+        EZ_DELETE(m_EventHandlers.GetAllocator(), pSnapshot);
+      }
+    }
+
+    this->m_pRetiredSnapshots = nullptr;
+    this->m_pFreeSnapshots = nullptr;
+  }
 }
 
 /// A callback can be registered multiple times with different pass-through data (or even with the same,
@@ -44,6 +65,8 @@ ezEventSubscriptionID ezEventBase<EventData, MutexType, EventType>::AddEventHand
   item.m_Handler = std::move(handler);
   item.m_SubscriptionID = ++m_NextSubscriptionID;
 
+  PublishSnapshot();
+
   return item.m_SubscriptionID;
 }
 
@@ -92,6 +115,7 @@ void ezEventBase<EventData, MutexType, EventType>::RemoveEventHandler(const Hand
       }
 
       m_EventHandlers.RemoveAtAndCopy(idx);
+      PublishSnapshot();
       return;
     }
   }
@@ -122,6 +146,7 @@ void ezEventBase<EventData, MutexType, EventType>::RemoveEventHandler(ezEventSub
       }
 
       m_EventHandlers.RemoveAtAndCopy(idx);
+      PublishSnapshot();
       id = 0;
       return;
     }
@@ -149,7 +174,73 @@ bool ezEventBase<EventData, MutexType, EventType>::HasEventHandler(const Handler
 template <typename EventData, typename MutexType, ezEventType EventType>
 void ezEventBase<EventData, MutexType, EventType>::Clear()
 {
+  EZ_LOCK(m_Mutex);
+
   m_EventHandlers.Clear();
+  PublishSnapshot();
+}
+
+template <typename EventData, typename MutexType, ezEventType EventType>
+void ezEventBase<EventData, MutexType, EventType>::PublishSnapshot() const
+{
+  if constexpr (EventType == ezEventType::CopyOnWrite)
+  {
+    HandlerSnapshot* pNewSnapshot = nullptr;
+
+    if (!m_EventHandlers.IsEmpty())
+    {
+      if (this->m_pFreeSnapshots != nullptr)
+      {
+        pNewSnapshot = this->m_pFreeSnapshots;
+        this->m_pFreeSnapshots = pNewSnapshot->m_pNext;
+        pNewSnapshot->m_pNext = nullptr;
+      }
+      else
+      {
+        ezAllocatorBase* pAllocator = m_EventHandlers.GetAllocator();
+        pNewSnapshot = EZ_NEW(pAllocator, HandlerSnapshot, pAllocator);
+      }
+
+      // a broadcast may still count itself in a reused snapshot, but it won't read it, as it is not the current one anymore
+      pNewSnapshot->m_Handlers = m_EventHandlers;
+    }
+
+    HandlerSnapshot* pOldSnapshot = this->m_pSnapshot;
+    ezAtomicUtils::TestAndSet(reinterpret_cast<void**>(&this->m_pSnapshot), pOldSnapshot, pNewSnapshot);
+
+    if (pOldSnapshot != nullptr)
+    {
+      pOldSnapshot->m_pNext = this->m_pRetiredSnapshots;
+      this->m_pRetiredSnapshots = pOldSnapshot;
+    }
+
+    ReclaimRetiredSnapshots();
+  }
+}
+
+template <typename EventData, typename MutexType, ezEventType EventType>
+void ezEventBase<EventData, MutexType, EventType>::ReclaimRetiredSnapshots() const
+{
+  HandlerSnapshot** ppNext = &this->m_pRetiredSnapshots;
+
+  while (*ppNext != nullptr)
+  {
+    HandlerSnapshot* pSnapshot = *ppNext;
+
+    // a broadcast that counts itself after this check sees that the snapshot was replaced and does not use it
+    if (pSnapshot->m_iNumBroadcasts != 0)
+    {
+      ppNext = &pSnapshot->m_pNext;
+      continue;
+    }
+
+    *ppNext = pSnapshot->m_pNext;
+
+    // the handlers may hold resources, so release them now, but keep the memory, as broadcasts may still access the counter
+    pSnapshot->m_Handlers.Clear();
+    pSnapshot->m_pNext = this->m_pFreeSnapshots;
+    this->m_pFreeSnapshots = pSnapshot;
+  }
 }
 
 /// The notification is sent to all event handlers in the order that they were registered.
@@ -188,6 +279,40 @@ void ezEventBase<EventData, MutexType, EventType>::Broadcast(EventData eventData
     for (ezUInt32 ui = 0; ui < m_EventHandlers.GetCount(); ++ui)
       m_EventHandlers[ui].m_Handler(eventData);
   }
+  else if constexpr (EventType == ezEventType::CopyOnWrite)
+  {
+    EZ_ASSERT_DEV(uiMaxRecursionDepth == 255, "uiMaxRecursionDepth is not supported if ezEventType::CopyOnWrite is used.");
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+    EZ_ASSERT_ALWAYS(m_pSelf == this, "The ezEvent was relocated in memory. This is not allowed, as it breaks the Unsubscribers.");
+#endif
+
+    HandlerSnapshot* pSnapshot = static_cast<HandlerSnapshot*>(ezAtomicUtils::Read(reinterpret_cast<void**>(&this->m_pSnapshot)));
+
+    // the snapshot is not reused while it is counted, but it may have been replaced before it was counted
+    while (pSnapshot != nullptr)
+    {
+      pSnapshot->m_iNumBroadcasts.Increment();
+
+      HandlerSnapshot* pCurrentSnapshot = static_cast<HandlerSnapshot*>(ezAtomicUtils::Read(reinterpret_cast<void**>(&this->m_pSnapshot)));
+      if (pCurrentSnapshot == pSnapshot)
+        break;
+
+      pSnapshot->m_iNumBroadcasts.Decrement();
+      pSnapshot = pCurrentSnapshot;
+    }
+
+    if (pSnapshot != nullptr)
+    {
+      EZ_SCOPE_EXIT(pSnapshot->m_iNumBroadcasts.Decrement());
+
+      const ezUInt32 uiHandlerCount = pSnapshot->m_Handlers.GetCount();
+      for (ezUInt32 ui = 0; ui < uiHandlerCount; ++ui)
+      {
+        pSnapshot->m_Handlers[ui].m_Handler(eventData);
+      }
+    }
+  }
   else
   {
     ezHybridArray<HandlerData, 16> eventHandlers;
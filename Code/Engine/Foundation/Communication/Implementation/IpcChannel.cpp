@@ -1,6 +1,7 @@
 #include <FoundationPCH.h>
 
 #include <Foundation/Communication/Implementation/IpcChannelEnet.h>
+#include <Foundation/Communication/Implementation/Linux/PipeChannel_linux.h>
 #include <Foundation/Communication/Implementation/MessageLoop.h>
 #include <Foundation/Communication/Implementation/Win/PipeChannel_win.h>
 #include <Foundation/Communication/IpcChannel.h>
@@ -33,6 +34,8 @@ ezIpcChannel* ezIpcChannel::CreatePipeChannel(const char* szAddress, Mode::Enum
 
 #if EZ_ENABLED(EZ_PLATFORM_WINDOWS_DESKTOP)
   return EZ_DEFAULT_NEW(ezPipeChannel_win, szAddress, mode);
+#elif EZ_ENABLED(EZ_PLATFORM_LINUX)
+  return EZ_DEFAULT_NEW(ezPipeChannel_linux, szAddress, mode);
 #else
   EZ_ASSERT_NOT_IMPLEMENTED;
   return nullptr;
@@ -126,6 +129,21 @@ void ezIpcChannel::ReceiveMessageData(ezArrayPtr<const ezUInt8> data)
   ezArrayPtr<const ezUInt8> remainingData = data;
   while (true)
   {
+    if (m_MessageAccumulator.IsEmpty() && remainingData.GetCount() >= HEADER_SIZE)
+    {
+      ezUInt32 uiMessageSize = 0;
+      ezMemoryUtils::Copy(reinterpret_cast<ezUInt8*>(&uiMessageSize), remainingData.GetPtr() + 4, 4);
+      EZ_ASSERT_DEBUG(uiMessageSize >= HEADER_SIZE && uiMessageSize < MAX_MESSAGE_SIZE, "Invalid message size: {0}! Either the stream got corrupted or you need to increase MAX_MESSAGE_SIZE.", uiMessageSize);
+
+      if (uiMessageSize <= remainingData.GetCount())
+      {
+        // the entire message is available, no need to copy it into the accumulator
+        DeserializeMessage(remainingData.GetSubArray(HEADER_SIZE, uiMessageSize - HEADER_SIZE));
+        remainingData = remainingData.GetSubArray(uiMessageSize);
+        continue;
+      }
+    }
+
     if (m_MessageAccumulator.GetCount() < HEADER_SIZE)
     {
       if (remainingData.GetCount() + m_MessageAccumulator.GetCount() < HEADER_SIZE)
@@ -166,23 +184,26 @@ void ezIpcChannel::ReceiveMessageData(ezArrayPtr<const ezUInt8> data)
     EZ_ASSERT_DEBUG(m_MessageAccumulator.GetCount() == uiMessageSize, "");
     remainingData = remainingData.GetSubArray(remainingMessageData);
 
-    {
-      // Message complete, de-serialize
-      ezRawMemoryStreamReader reader(m_MessageAccumulator.GetData() + HEADER_SIZE, uiMessageSize - HEADER_SIZE);
-      const ezRTTI* pRtti = nullptr;
+    // Message complete, de-serialize
+    DeserializeMessage(m_MessageAccumulator.GetArrayPtr().GetSubArray(HEADER_SIZE, uiMessageSize - HEADER_SIZE));
+    m_MessageAccumulator.Clear();
+  }
+}
 
-      ezProcessMessage* pMsg = (ezProcessMessage*)ezReflectionSerializer::ReadObjectFromBinary(reader, pRtti);
-      ezUniquePtr<ezProcessMessage> msg(pMsg, ezFoundation::GetDefaultAllocator());
-      if (msg != nullptr)
-      {
-        EnqueueMessage(std::move(msg));
-      }
-      else
-      {
-        ezLog::Error("Channel received invalid Message!");
-      }
-      m_MessageAccumulator.Clear();
-    }
+void ezIpcChannel::DeserializeMessage(ezArrayPtr<const ezUInt8> messageData)
+{
+  ezRawMemoryStreamReader reader(messageData.GetPtr(), messageData.GetCount());
+  const ezRTTI* pRtti = nullptr;
+
+  ezProcessMessage* pMsg = (ezProcessMessage*)ezReflectionSerializer::ReadObjectFromBinary(reader, pRtti);
+  ezUniquePtr<ezProcessMessage> msg(pMsg, ezFoundation::GetDefaultAllocator());
+  if (msg != nullptr)
+  {
+    EnqueueMessage(std::move(msg));
+  }
+  else
+  {
+    ezLog::Error("Channel received invalid Message!");
   }
 }
 
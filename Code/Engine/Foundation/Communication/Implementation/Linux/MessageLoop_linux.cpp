@@ -0,0 +1,152 @@
+#include <FoundationPCH.h>
+
+#if EZ_ENABLED(EZ_PLATFORM_LINUX)
+
+#  include <Foundation/Communication/Implementation/Linux/MessageLoop_linux.h>
+#  include <Foundation/Communication/Implementation/Linux/PipeChannel_linux.h>
+#  include <Foundation/Communication/IpcChannel.h>
+#  include <Foundation/Logging/Log.h>
+
+#  include <errno.h>
+#  include <string.h>
+#  include <sys/eventfd.h>
+#  include <unistd.h>
+
+ezMessageLoop_linux::ezMessageLoop_linux()
+{
+  m_iWakeUpEvent = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  EZ_ASSERT_DEBUG(m_iWakeUpEvent >= 0, "Failed to create eventfd: {0}", strerror(errno));
+}
+
+ezMessageLoop_linux::~ezMessageLoop_linux()
+{
+  StopUpdateThread();
+
+  if (m_iWakeUpEvent >= 0)
+  {
+    close(m_iWakeUpEvent);
+  }
+}
+
+void ezMessageLoop_linux::RegisterChannel(ezPipeChannel_linux* pChannel)
+{
+  EZ_LOCK(m_ChannelsCondition);
+  m_Channels.PushBack(pChannel);
+}
+
+void ezMessageLoop_linux::UnregisterChannel(ezPipeChannel_linux* pChannel)
+{
+  EZ_LOCK(m_ChannelsCondition);
+  m_Channels.RemoveAndSwap(pChannel);
+
+  while (m_DispatchingChannels.Contains(pChannel))
+  {
+    m_ChannelsCondition.UnlockWaitForSignalAndLock();
+  }
+}
+
+void ezMessageLoop_linux::WakeUp()
+{
+  if (m_bHaveWork.Set(true))
+  {
+    // already running
+    return;
+  }
+
+  // wake up the loop
+  const ezUInt64 uiValue = 1;
+  if (write(m_iWakeUpEvent, &uiValue, sizeof(uiValue)) != sizeof(uiValue))
+  {
+    EZ_REPORT_FAILURE("Could not signal the message loop: {0}", strerror(errno));
+  }
+}
+
+bool ezMessageLoop_linux::WaitForMessages(ezInt32 iTimeout, ezIpcChannel* pFilter)
+{
+  ezHybridArray<pollfd, 16> fds;
+  ezHybridArray<ezPipeChannel_linux*, 16> fdOwners;
+
+  {
+    pollfd& wakeUp = fds.ExpandAndGetRef();
+    wakeUp.fd = m_iWakeUpEvent;
+    wakeUp.events = POLLIN;
+    wakeUp.revents = 0;
+    fdOwners.PushBack(nullptr);
+  }
+
+  {
+    EZ_LOCK(m_ChannelsCondition);
+
+    for (ezPipeChannel_linux* pChannel : m_Channels)
+    {
+      if (pFilter != nullptr && pChannel != pFilter)
+        continue;
+
+      pollfd channelFds[ezPipeChannel_linux::MaxPollFds];
+      const ezUInt32 uiNumFds = pChannel->GetPollFds(channelFds);
+
+      for (ezUInt32 i = 0; i < uiNumFds; ++i)
+      {
+        fds.PushBack(channelFds[i]);
+        fdOwners.PushBack(pChannel);
+      }
+    }
+  }
+
+  const int iResult = poll(fds.GetData(), fds.GetCount(), iTimeout < 0 ? -1 : iTimeout);
+  if (iResult <= 0)
+  {
+    // timeout or interrupted by a signal
+    return false;
+  }
+
+  if (fds[0].revents != 0)
+  {
+    // internal notification
+    ezUInt64 uiValue = 0;
+    EZ_IGNORE_UNUSED(read(m_iWakeUpEvent, &uiValue, sizeof(uiValue)));
+    m_bHaveWork = false;
+  }
+
+  // The events are dispatched without holding the lock, so that event handlers can create or destroy channels on any thread.
+  // Channels that are unregistered in the mean time are kept alive by UnregisterChannel() until the dispatch is done.
+  ezHybridArray<ezUInt32, 16> readyFds;
+
+  {
+    EZ_LOCK(m_ChannelsCondition);
+
+    for (ezUInt32 i = 1; i < fds.GetCount(); ++i)
+    {
+      if (fds[i].revents == 0)
+        continue;
+
+      // the channel may have been destroyed while we were waiting
+      if (!m_Channels.Contains(fdOwners[i]))
+        continue;
+
+      readyFds.PushBack(i);
+      if (!m_DispatchingChannels.Contains(fdOwners[i]))
+      {
+        m_DispatchingChannels.PushBack(fdOwners[i]);
+      }
+    }
+  }
+
+  for (ezUInt32 i : readyFds)
+  {
+    fdOwners[i]->OnPollEvents(fds[i].fd, fds[i].revents);
+  }
+
+  if (!readyFds.IsEmpty())
+  {
+    EZ_LOCK(m_ChannelsCondition);
+    m_DispatchingChannels.Clear();
+    m_ChannelsCondition.SignalAll();
+  }
+
+  return true;
+}
+
+#endif
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Communication_Implementation_Linux_MessageLoop_linux);
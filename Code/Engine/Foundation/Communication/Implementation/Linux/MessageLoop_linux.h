@@ -0,0 +1,44 @@
+#pragma once
+
+#include <Foundation/FoundationInternal.h>
+EZ_FOUNDATION_INTERNAL_HEADER
+
+#if EZ_ENABLED(EZ_PLATFORM_LINUX)
+
+#  include <Foundation/Basics.h>
+#  include <Foundation/Communication/Implementation/MessageLoop.h>
+#  include <Foundation/Containers/HybridArray.h>
+#  include <Foundation/Threading/AtomicInteger.h>
+#  include <Foundation/Threading/ConditionVariable.h>
+
+class ezPipeChannel_linux;
+
+/// \brief Message loop that waits for the file descriptors of all ezPipeChannel_linux instances with poll().
+///
+/// WakeUp() signals an eventfd, which is always part of the poll set, so the loop also wakes up for sends, connects and disconnects.
+class EZ_FOUNDATION_DLL ezMessageLoop_linux : public ezMessageLoop
+{
+public:
+  ezMessageLoop_linux();
+  ~ezMessageLoop_linux();
+
+  /// \brief Called by pipe channels to make their file descriptors part of the poll set.
+  void RegisterChannel(ezPipeChannel_linux* pChannel);
+
+  /// \brief Removes the channel from the poll set. Waits until the loop does not dispatch any events to the channel anymore.
+  void UnregisterChannel(ezPipeChannel_linux* pChannel);
+
+protected:
+  virtual void WakeUp() override;
+  virtual bool WaitForMessages(ezInt32 iTimeout, ezIpcChannel* pFilter) override;
+
+private:
+  ezConditionVariable m_ChannelsCondition; ///< Signaled once the events of m_DispatchingChannels have been dispatched.
+  ezDynamicArray<ezPipeChannel_linux*> m_Channels;
+  ezHybridArray<ezPipeChannel_linux*, 16> m_DispatchingChannels; ///< Channels that events are dispatched to without holding the lock.
+
+  ezAtomicBool m_bHaveWork;
+  int m_iWakeUpEvent = -1;
+};
+
+#endif
@@ -0,0 +1,764 @@
+#include <FoundationPCH.h>
+
+#if EZ_ENABLED(EZ_PLATFORM_LINUX)
+
+#  include <Foundation/Algorithm/HashingUtils.h>
+#  include <Foundation/Communication/Implementation/Linux/MessageLoop_linux.h>
+#  include <Foundation/Communication/Implementation/Linux/PipeChannel_linux.h>
+#  include <Foundation/Logging/Log.h>
+
+#  include <errno.h>
+#  include <fcntl.h>
+#  include <stddef.h>
+#  include <string.h>
+#  include <sys/eventfd.h>
+#  include <sys/mman.h>
+#  include <sys/socket.h>
+#  include <sys/stat.h>
+#  include <sys/un.h>
+#  include <unistd.h>
+
+namespace
+{
+  enum PipeChannelConstants : ezUInt32
+  {
+    PIPE_HANDSHAKE_MAGIC = 'EZPL',
+    PIPE_SHARED_HEADER_SIZE = 4096,
+    PIPE_RING_BUFFER_SIZE = 4 * 1024 * 1024, ///< Per direction, must be a power of two.
+    PIPE_SHARED_MEMORY_SIZE = PIPE_SHARED_HEADER_SIZE + 2 * PIPE_RING_BUFFER_SIZE,
+  };
+
+  /// \brief Sent by the server right after accepting a connection. If m_uiRingBufferSize is not zero, the message carries the shared memory and
+  /// the eventfds of the server and the client.
+  struct PipeHandshake
+  {
+    ezUInt32 m_uiMagic;
+    ezUInt32 m_uiRingBufferSize;
+  };
+
+  union PipeHandshakeControl
+  {
+    char m_Buffer[CMSG_SPACE(sizeof(int) * 3)];
+    cmsghdr m_Align;
+  };
+
+  void MakePipeAddress(const char* szAddress, sockaddr_un& out_Address, socklen_t& out_uiLength)
+  {
+    ezStringBuilder sName("ezPipe-", szAddress);
+
+    if (sName.GetElementCount() >= sizeof(out_Address.sun_path))
+    {
+      // socket names are limited in length, so long names are replaced by their hash
+      sName.Format("ezPipe-{0}", ezArgU(ezHashingUtils::xxHash64String(szAddress), 16, true, 16));
+    }
+
+    // the leading zero byte puts the name into the abstract namespace, so no socket file is left behind
+    memset(&out_Address, 0, sizeof(out_Address));
+    out_Address.sun_family = AF_UNIX;
+    memcpy(out_Address.sun_path + 1, sName.GetData(), sName.GetElementCount());
+    out_uiLength = static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + 1 + sName.GetElementCount());
+  }
+
+  void ClosePipeFd(int& iFd)
+  {
+    if (iFd >= 0)
+    {
+      close(iFd);
+      iFd = -1;
+    }
+  }
+
+  /// \brief Abstract socket names are visible to all users of the machine, so only processes of the same user may use a pipe.
+  bool IsPeerOfSameUser(int iSocket)
+  {
+    ucred peerCredentials;
+    socklen_t uiSize = sizeof(peerCredentials);
+    if (getsockopt(iSocket, SOL_SOCKET, SO_PEERCRED, &peerCredentials, &uiSize) != 0)
+      return false;
+
+    return peerCredentials.uid == getuid();
+  }
+} // namespace
+
+/// \brief Header of the shared memory block. The ring buffer written by the server follows at PIPE_SHARED_HEADER_SIZE, the one written by the
+/// client after that.
+struct ezPipeChannelSharedMemory_linux
+{
+  struct Ring
+  {
+    ezAtomicInteger64 m_iBytesWritten; ///< Only increased by the sending side.
+    ezAtomicInteger64 m_iBytesRead;    ///< Only increased by the receiving side.
+  };
+
+  Ring m_Rings[2];              ///< Indexed by the sending side, 0 is the server and 1 the client.
+  ezAtomicInteger32 m_iIdle[2]; ///< Set by a side before it waits for its eventfd, reset by the other side when it signals the eventfd.
+
+  ezUInt8* GetRingData(ezUInt32 uiSendingSide) { return reinterpret_cast<ezUInt8*>(this) + PIPE_SHARED_HEADER_SIZE + uiSendingSide * PIPE_RING_BUFFER_SIZE; }
+};
+
+ezPipeChannel_linux::ezPipeChannel_linux(const char* szAddress, Mode::Enum mode)
+  : ezIpcChannel(szAddress, mode)
+{
+  CreatePipe(szAddress);
+  m_pOwner->AddChannel(this);
+}
+
+ezPipeChannel_linux::~ezPipeChannel_linux()
+{
+  if (m_bOpen)
+  {
+    Disconnect();
+    m_Closed.WaitForSignal();
+  }
+
+  // also waits until the message loop does not dispatch any events to this channel anymore
+  static_cast<ezMessageLoop_linux*>(m_pOwner)->UnregisterChannel(this);
+  m_pOwner->RemoveChannel(this);
+}
+
+bool ezPipeChannel_linux::CreatePipe(const char* szAddress)
+{
+  sockaddr_un address;
+  socklen_t uiAddressLength = 0;
+  MakePipeAddress(szAddress, address, uiAddressLength);
+
+  const int iSocket = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (iSocket < 0)
+  {
+    ezLog::Error("Could not create named pipe: {0}", strerror(errno));
+    return false;
+  }
+
+  if (m_Mode == Mode::Server)
+  {
+    if (bind(iSocket, reinterpret_cast<sockaddr*>(&address), uiAddressLength) != 0 || listen(iSocket, 1) != 0)
+    {
+      ezLog::Error("Could not create named pipe '{0}': {1}", szAddress, strerror(errno));
+      close(iSocket);
+      return false;
+    }
+
+    m_iListenSocket = iSocket;
+  }
+  else
+  {
+    if (connect(iSocket, reinterpret_cast<sockaddr*>(&address), uiAddressLength) != 0)
+    {
+      ezLog::Error("Could not connect to named pipe '{0}': {1}", szAddress, strerror(errno));
+      close(iSocket);
+      return false;
+    }
+
+    if (!IsPeerOfSameUser(iSocket))
+    {
+      ezLog::Error("The named pipe '{0}' belongs to a different user.", szAddress);
+      close(iSocket);
+      return false;
+    }
+
+    m_iSocket = iSocket;
+  }
+
+  // all further I/O happens on the worker thread, which must never block
+  fcntl(iSocket, F_SETFL, fcntl(iSocket, F_GETFL) | O_NONBLOCK);
+
+  m_bOpen = true;
+  return true;
+}
+
+void ezPipeChannel_linux::AddToMessageLoop(ezMessageLoop* pMsgLoop)
+{
+  static_cast<ezMessageLoop_linux*>(pMsgLoop)->RegisterChannel(this);
+}
+
+void ezPipeChannel_linux::InternalConnect()
+{
+  if (!m_bOpen)
+    return;
+  if (m_Connected)
+    return;
+#  if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+  if (m_ThreadId == 0)
+    m_ThreadId = ezThreadUtils::GetCurrentThreadID();
+#  endif
+
+  // the message loop only waits for the sockets from now on, the server accepts the client and the client waits for the handshake
+  m_bConnectRequested = true;
+}
+
+void ezPipeChannel_linux::InternalDisconnect()
+{
+#  if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+  if (m_ThreadId != 0)
+    EZ_ASSERT_DEBUG(m_ThreadId == ezThreadUtils::GetCurrentThreadID(), "Function must be called from worker thread!");
+#  endif
+
+  const bool bWasConnected = m_Connected;
+
+  CloseAll();
+
+  {
+    EZ_LOCK(m_OutputQueueMutex);
+    m_OutputQueue.Clear();
+    m_uiOutputOffset = 0;
+    m_Connected = false;
+  }
+
+  if (bWasConnected)
+  {
+    m_Events.Broadcast(
+      ezIpcChannelEvent(m_Mode == Mode::Client ? ezIpcChannelEvent::DisconnectedFromServer : ezIpcChannelEvent::DisconnectedFromClient, this));
+  }
+
+  // Raise in case another thread is waiting for new messages (as we would sleep forever otherwise).
+  m_IncomingMessages.RaiseSignal();
+
+  // once this is reset, the destructor may continue on another thread
+  if (m_bOpen.Set(false))
+  {
+    m_Closed.RaiseSignal();
+  }
+}
+
+void ezPipeChannel_linux::InternalSend()
+{
+  if (!m_Connected)
+    return;
+
+  const bool bRes = (m_pSharedMemory != nullptr) ? UpdateSharedMemory() : ProcessSocketOutgoing();
+
+  if (!bRes)
+  {
+    InternalDisconnect();
+  }
+}
+
+bool ezPipeChannel_linux::NeedWakeup() const
+{
+  return !m_bOutputBlocked;
+}
+
+ezUInt32 ezPipeChannel_linux::GetPollFds(pollfd* pOutFds) const
+{
+  if (!m_bConnectRequested)
+    return 0;
+
+  ezUInt32 uiNumFds = 0;
+
+  if (m_iListenSocket >= 0)
+  {
+    pOutFds[uiNumFds].fd = m_iListenSocket;
+    pOutFds[uiNumFds].events = POLLIN;
+    pOutFds[uiNumFds].revents = 0;
+    ++uiNumFds;
+  }
+
+  if (m_iSocket >= 0)
+  {
+    const bool bSocketOutput = m_bHandshakeDone && m_pSharedMemory == nullptr && m_bOutputBlocked;
+
+    pOutFds[uiNumFds].fd = m_iSocket;
+    pOutFds[uiNumFds].events = POLLIN | (bSocketOutput ? POLLOUT : 0);
+    pOutFds[uiNumFds].revents = 0;
+    ++uiNumFds;
+  }
+
+  if (m_iOwnEvent >= 0)
+  {
+    pOutFds[uiNumFds].fd = m_iOwnEvent;
+    pOutFds[uiNumFds].events = POLLIN;
+    pOutFds[uiNumFds].revents = 0;
+    ++uiNumFds;
+  }
+
+  return uiNumFds;
+}
+
+void ezPipeChannel_linux::OnPollEvents(int iFd, short iEvents)
+{
+  EZ_ASSERT_DEBUG(m_ThreadId == ezThreadUtils::GetCurrentThreadID(), "Function must be called from worker thread!");
+
+  bool bRes = true;
+
+  if (iFd == m_iListenSocket)
+  {
+    bRes = AcceptConnection();
+  }
+  else if (iFd == m_iSocket)
+  {
+    if (!m_bHandshakeDone)
+    {
+      bRes = ReceiveHandshake();
+    }
+    else
+    {
+      if ((iEvents & POLLOUT) != 0)
+      {
+        bRes = ProcessSocketOutgoing();
+      }
+
+      if (bRes && (iEvents & (POLLIN | POLLHUP | POLLERR)) != 0)
+      {
+        bRes = ProcessSocketIncoming();
+      }
+    }
+  }
+  else if (iFd == m_iOwnEvent)
+  {
+    ezUInt64 uiValue = 0;
+    const ssize_t iRead = read(m_iOwnEvent, &uiValue, sizeof(uiValue));
+    EZ_IGNORE_UNUSED(iRead);
+
+    bRes = UpdateSharedMemory();
+  }
+
+  if (!bRes && m_bOpen)
+  {
+    InternalDisconnect();
+  }
+}
+
+bool ezPipeChannel_linux::AcceptConnection()
+{
+  const int iSocket = accept4(m_iListenSocket, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+  if (iSocket < 0)
+  {
+    // spurious wake-up or the client already gave up, keep listening
+    return errno == EAGAIN || errno == EWOULDBLOCK || errno == ECONNABORTED || errno == EINTR;
+  }
+
+  // the shared memory and the eventfds must never be handed to a process of another user
+  if (!IsPeerOfSameUser(iSocket))
+  {
+    ezLog::Warning("Rejected a connection to a named pipe from a process of a different user.");
+    close(iSocket);
+    return true;
+  }
+
+  // like a Windows pipe, a channel only ever serves a single client, which also frees the name for a new server
+  ClosePipeFd(m_iListenSocket);
+  m_iSocket = iSocket;
+
+  if (!SendHandshake())
+    return false;
+
+  return OnConnected();
+}
+
+bool ezPipeChannel_linux::SendHandshake()
+{
+  PipeHandshake handshake;
+  handshake.m_uiMagic = PIPE_HANDSHAKE_MAGIC;
+  handshake.m_uiRingBufferSize = 0;
+
+  int fds[3] = {-1, -1, -1};
+
+  fds[0] = memfd_create("ezPipeChannel", MFD_CLOEXEC);
+  if (fds[0] >= 0 && ftruncate(fds[0], PIPE_SHARED_MEMORY_SIZE) == 0 && SetupSharedMemory(fds[0]))
+  {
+    fds[1] = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    fds[2] = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+
+    if (fds[1] >= 0 && fds[2] >= 0)
+    {
+      m_iOwnEvent = fds[1];
+      m_iPeerEvent = fds[2];
+      handshake.m_uiRingBufferSize = PIPE_RING_BUFFER_SIZE;
+    }
+    else
+    {
+      ClosePipeFd(fds[1]);
+      ClosePipeFd(fds[2]);
+      munmap(m_pSharedMemory, PIPE_SHARED_MEMORY_SIZE);
+      m_pSharedMemory = nullptr;
+    }
+  }
+
+  if (handshake.m_uiRingBufferSize == 0)
+  {
+    ezLog::Dev("Could not set up shared memory for the pipe ({0}), messages are sent through the socket instead.", strerror(errno));
+  }
+
+  iovec data;
+  data.iov_base = &handshake;
+  data.iov_len = sizeof(handshake);
+
+  msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &data;
+  msg.msg_iovlen = 1;
+
+  PipeHandshakeControl control;
+  if (m_pSharedMemory != nullptr)
+  {
+    msg.msg_control = control.m_Buffer;
+    msg.msg_controllen = sizeof(control.m_Buffer);
+
+    cmsghdr* pControl = CMSG_FIRSTHDR(&msg);
+    pControl->cmsg_level = SOL_SOCKET;
+    pControl->cmsg_type = SCM_RIGHTS;
+    pControl->cmsg_len = CMSG_LEN(sizeof(fds));
+    memcpy(CMSG_DATA(pControl), fds, sizeof(fds));
+  }
+
+  const ssize_t iSent = sendmsg(m_iSocket, &msg, MSG_NOSIGNAL);
+
+  // the mapping and the descriptor that was passed to the client keep the shared memory alive
+  ClosePipeFd(fds[0]);
+
+  if (iSent != sizeof(handshake))
+  {
+    ezLog::Error("Could not send the pipe handshake: {0}", strerror(errno));
+    return false;
+  }
+
+  return true;
+}
+
+bool ezPipeChannel_linux::ReceiveHandshake()
+{
+  PipeHandshake handshake;
+  memset(&handshake, 0, sizeof(handshake));
+
+  iovec data;
+  data.iov_base = &handshake;
+  data.iov_len = sizeof(handshake);
+
+  PipeHandshakeControl control;
+  msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &data;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control.m_Buffer;
+  msg.msg_controllen = sizeof(control.m_Buffer);
+
+  const ssize_t iReceived = recvmsg(m_iSocket, &msg, MSG_CMSG_CLOEXEC);
+  if (iReceived < 0)
+  {
+    return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+  }
+
+  int fds[3] = {-1, -1, -1};
+  cmsghdr* pControl = CMSG_FIRSTHDR(&msg);
+  if (pControl != nullptr && pControl->cmsg_level == SOL_SOCKET && pControl->cmsg_type == SCM_RIGHTS && pControl->cmsg_len == CMSG_LEN(sizeof(fds)))
+  {
+    memcpy(fds, CMSG_DATA(pControl), sizeof(fds));
+  }
+
+  if (iReceived == 0)
+  {
+    // the server went away before the connection was established
+    return false;
+  }
+
+  bool bValid = iReceived == sizeof(handshake) && handshake.m_uiMagic == PIPE_HANDSHAKE_MAGIC;
+
+  if (bValid && handshake.m_uiRingBufferSize != 0)
+  {
+    struct stat memoryStat;
+    bValid = handshake.m_uiRingBufferSize == PIPE_RING_BUFFER_SIZE && fds[0] >= 0 && fds[1] >= 0 && fds[2] >= 0 && fstat(fds[0], &memoryStat) == 0 &&
+             memoryStat.st_size >= PIPE_SHARED_MEMORY_SIZE && SetupSharedMemory(fds[0]);
+
+    if (bValid)
+    {
+      m_iPeerEvent = fds[1];
+      m_iOwnEvent = fds[2];
+      fds[1] = -1;
+      fds[2] = -1;
+    }
+  }
+
+  for (int& fd : fds)
+  {
+    ClosePipeFd(fd);
+  }
+
+  if (!bValid)
+  {
+    ezLog::Error("Received an invalid handshake on the named pipe.");
+    return false;
+  }
+
+  return OnConnected();
+}
+
+bool ezPipeChannel_linux::SetupSharedMemory(int iMemoryFd)
+{
+  void* pMemory = mmap(nullptr, PIPE_SHARED_MEMORY_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, iMemoryFd, 0);
+  if (pMemory == MAP_FAILED)
+    return false;
+
+  m_pSharedMemory = static_cast<ezPipeChannelSharedMemory_linux*>(pMemory);
+  return true;
+}
+
+bool ezPipeChannel_linux::OnConnected()
+{
+  m_bHandshakeDone = true;
+  m_uiOwnSide = (m_Mode == Mode::Server) ? 0 : 1;
+  m_Connected = true;
+
+  // send everything that was queued before the connection was established
+  const bool bRes = (m_pSharedMemory != nullptr) ? UpdateSharedMemory() : ProcessSocketOutgoing();
+
+  m_Events.Broadcast(ezIpcChannelEvent(m_Mode == Mode::Client ? ezIpcChannelEvent::ConnectedToServer : ezIpcChannelEvent::ConnectedToClient, this));
+  return bRes;
+}
+
+bool ezPipeChannel_linux::UpdateSharedMemory()
+{
+  ezAtomicInteger32& iIdle = m_pSharedMemory->m_iIdle[m_uiOwnSide];
+
+  while (true)
+  {
+    // while we are busy anyway, the peer does not need to signal us
+    iIdle = 0;
+
+    if (!ProcessSharedMemoryIncoming())
+      return false;
+
+    ProcessSharedMemoryOutgoing();
+
+    // Ask to be signaled, then check once more, since the peer might have changed the rings before it saw the flag.
+    iIdle.TestAndSet(0, 1);
+
+    if (!HasSharedMemoryWork())
+      return true;
+  }
+}
+
+bool ezPipeChannel_linux::ProcessSharedMemoryIncoming()
+{
+  const ezUInt32 uiPeerSide = 1 - m_uiOwnSide;
+  ezPipeChannelSharedMemory_linux::Ring& ring = m_pSharedMemory->m_Rings[uiPeerSide];
+  const ezUInt8* pRingData = m_pSharedMemory->GetRingData(uiPeerSide);
+
+  const ezInt64 iBytesWritten = ring.m_iBytesWritten;
+  const ezInt64 iBytesRead = ring.m_iBytesRead;
+
+  if (iBytesWritten == iBytesRead)
+    return true;
+
+  if (iBytesWritten < iBytesRead || iBytesWritten - iBytesRead > PIPE_RING_BUFFER_SIZE)
+  {
+    ezLog::Error("The shared memory of the named pipe is corrupted.");
+    return false;
+  }
+
+  for (ezInt64 iPosition = iBytesRead; iPosition < iBytesWritten;)
+  {
+    const ezUInt32 uiOffset = static_cast<ezUInt32>(iPosition & (PIPE_RING_BUFFER_SIZE - 1));
+    const ezUInt32 uiCount = static_cast<ezUInt32>(ezMath::Min<ezInt64>(iBytesWritten - iPosition, PIPE_RING_BUFFER_SIZE - uiOffset));
+
+    // the data is deserialized straight out of the shared memory
+    ReceiveMessageData(ezArrayPtr<const ezUInt8>(pRingData + uiOffset, uiCount));
+    iPosition += uiCount;
+  }
+
+  ring.m_iBytesRead.Add(iBytesWritten - iBytesRead);
+
+  // the peer may be waiting for space in the ring
+  WakeUpPeer();
+  return true;
+}
+
+void ezPipeChannel_linux::ProcessSharedMemoryOutgoing()
+{
+  ezPipeChannelSharedMemory_linux::Ring& ring = m_pSharedMemory->m_Rings[m_uiOwnSide];
+  ezUInt8* pRingData = m_pSharedMemory->GetRingData(m_uiOwnSide);
+
+  const ezInt64 iBytesWritten = ring.m_iBytesWritten;
+  const ezInt64 iBytesRead = ring.m_iBytesRead;
+  ezInt64 iPosition = iBytesWritten;
+
+  while (true)
+  {
+    const ezMemoryStreamStorage* pStorage = nullptr;
+    {
+      EZ_LOCK(m_OutputQueueMutex);
+      if (m_OutputQueue.IsEmpty())
+      {
+        m_bOutputBlocked = false;
+        break;
+      }
+
+      pStorage = &m_OutputQueue.PeekFront();
+    }
+
+    const ezUInt32 uiFreeSpace = PIPE_RING_BUFFER_SIZE - static_cast<ezUInt32>(iPosition - iBytesRead);
+    if (uiFreeSpace == 0)
+    {
+      // continues once the peer has read some data and signals us
+      m_bOutputBlocked = true;
+      break;
+    }
+
+    const ezUInt8* pData = pStorage->GetData() + m_uiOutputOffset;
+    const ezUInt32 uiCount = ezMath::Min(pStorage->GetStorageSize() - m_uiOutputOffset, uiFreeSpace);
+    const ezUInt32 uiOffset = static_cast<ezUInt32>(iPosition & (PIPE_RING_BUFFER_SIZE - 1));
+    const ezUInt32 uiCountBeforeWrap = ezMath::Min(uiCount, PIPE_RING_BUFFER_SIZE - uiOffset);
+
+    memcpy(pRingData + uiOffset, pData, uiCountBeforeWrap);
+    memcpy(pRingData, pData + uiCountBeforeWrap, uiCount - uiCountBeforeWrap);
+
+    iPosition += uiCount;
+    m_uiOutputOffset += uiCount;
+
+    if (m_uiOutputOffset == pStorage->GetStorageSize())
+    {
+      EZ_LOCK(m_OutputQueueMutex);
+      m_OutputQueue.PopFront();
+      m_uiOutputOffset = 0;
+    }
+  }
+
+  if (iPosition != iBytesWritten)
+  {
+    // publish all messages at once, the full barrier makes sure the data is visible before the new position
+    ring.m_iBytesWritten.Add(iPosition - iBytesWritten);
+    WakeUpPeer();
+  }
+}
+
+bool ezPipeChannel_linux::HasSharedMemoryWork()
+{
+  const ezPipeChannelSharedMemory_linux::Ring& incoming = m_pSharedMemory->m_Rings[1 - m_uiOwnSide];
+  if (incoming.m_iBytesWritten != incoming.m_iBytesRead)
+    return true;
+
+  {
+    EZ_LOCK(m_OutputQueueMutex);
+    if (m_OutputQueue.IsEmpty())
+      return false;
+  }
+
+  const ezPipeChannelSharedMemory_linux::Ring& outgoing = m_pSharedMemory->m_Rings[m_uiOwnSide];
+  return outgoing.m_iBytesWritten - outgoing.m_iBytesRead < PIPE_RING_BUFFER_SIZE;
+}
+
+void ezPipeChannel_linux::WakeUpPeer()
+{
+  if (m_pSharedMemory->m_iIdle[1 - m_uiOwnSide].TestAndSet(1, 0))
+  {
+    const ezUInt64 uiValue = 1;
+    const ssize_t iWritten = write(m_iPeerEvent, &uiValue, sizeof(uiValue));
+    EZ_IGNORE_UNUSED(iWritten);
+  }
+}
+
+bool ezPipeChannel_linux::ProcessSocketIncoming()
+{
+  while (true)
+  {
+    const ssize_t iRead = recv(m_iSocket, m_InputBuffer, BUFFER_SIZE, 0);
+
+    if (iRead > 0)
+    {
+      // with shared memory the socket only serves to detect a disconnect, nothing is expected to arrive here
+      if (m_pSharedMemory == nullptr)
+      {
+        ReceiveMessageData(ezArrayPtr<const ezUInt8>(m_InputBuffer, static_cast<ezUInt32>(iRead)));
+      }
+      continue;
+    }
+
+    if (iRead == 0)
+    {
+      // the other side closed the connection
+      return false;
+    }
+
+    switch (errno)
+    {
+      case EINTR:
+        continue;
+      case EAGAIN:
+#  if EWOULDBLOCK != EAGAIN
+      case EWOULDBLOCK:
+#  endif
+        return true;
+      case ECONNRESET:
+        return false;
+      default:
+        if (m_Mode == Mode::Server)
+        {
+          // only log when in server mode, otherwise this can result in an endless recursion
+          ezLog::Error("Read from pipe failed: {0}", strerror(errno));
+        }
+        return false;
+    }
+  }
+}
+
+bool ezPipeChannel_linux::ProcessSocketOutgoing()
+{
+  while (true)
+  {
+    const ezMemoryStreamStorage* pStorage = nullptr;
+    {
+      EZ_LOCK(m_OutputQueueMutex);
+      if (m_OutputQueue.IsEmpty())
+      {
+        m_bOutputBlocked = false;
+        return true;
+      }
+
+      pStorage = &m_OutputQueue.PeekFront();
+    }
+
+    const ssize_t iSent = send(m_iSocket, pStorage->GetData() + m_uiOutputOffset, pStorage->GetStorageSize() - m_uiOutputOffset, MSG_NOSIGNAL);
+
+    if (iSent < 0)
+    {
+      switch (errno)
+      {
+        case EINTR:
+          continue;
+        case EAGAIN:
+#  if EWOULDBLOCK != EAGAIN
+        case EWOULDBLOCK:
+#  endif
+          // the message loop waits until the socket is writable again
+          m_bOutputBlocked = true;
+          return true;
+        case EPIPE:
+        case ECONNRESET:
+          return false;
+        default:
+          ezLog::Error("Write to pipe failed: {0}", strerror(errno));
+          return false;
+      }
+    }
+
+    m_uiOutputOffset += static_cast<ezUInt32>(iSent);
+
+    if (m_uiOutputOffset == pStorage->GetStorageSize())
+    {
+      EZ_LOCK(m_OutputQueueMutex);
+      m_OutputQueue.PopFront();
+      m_uiOutputOffset = 0;
+    }
+  }
+}
+
+void ezPipeChannel_linux::CloseAll()
+{
+  ClosePipeFd(m_iListenSocket);
+  ClosePipeFd(m_iSocket);
+  ClosePipeFd(m_iOwnEvent);
+  ClosePipeFd(m_iPeerEvent);
+
+  if (m_pSharedMemory != nullptr)
+  {
+    munmap(m_pSharedMemory, PIPE_SHARED_MEMORY_SIZE);
+    m_pSharedMemory = nullptr;
+  }
+
+  m_bConnectRequested = false;
+  m_bHandshakeDone = false;
+  m_bOutputBlocked = false;
+}
+
+#endif
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Communication_Implementation_Linux_PipeChannel_linux);
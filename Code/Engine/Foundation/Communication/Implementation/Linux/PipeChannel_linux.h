@@ -0,0 +1,99 @@
+#pragma once
+
+#include <Foundation/FoundationInternal.h>
+EZ_FOUNDATION_INTERNAL_HEADER
+
+#if EZ_ENABLED(EZ_PLATFORM_LINUX)
+
+#  include <Foundation/Basics.h>
+#  include <Foundation/Communication/IpcChannel.h>
+#  include <Foundation/Threading/ThreadSignal.h>
+
+#  include <poll.h>
+
+EZ_DEFINE_AS_POD_TYPE(pollfd);
+
+struct ezPipeChannelSharedMemory_linux;
+
+/// \brief IPC channel between two processes on the same machine.
+///
+/// The server listens on a Unix domain socket in the abstract namespace, named after the channel address. Once a client has connected, the
+/// server creates a shared memory block with one ring buffer per direction and passes it, together with two eventfds for wake-ups, over the
+/// socket. From then on messages are copied into the ring buffer by the sender and handed to ReceiveMessageData() straight out of the shared
+/// memory by the receiver, so message data never passes through the kernel. Only a message that wraps around the end of the ring is copied
+/// once more, to assemble it. A side is only notified through its eventfd when it went idle
+/// before, so a steady stream of messages does not need a system call per message. The socket stays open to detect a disconnect.
+///
+/// If the shared memory cannot be set up, both sides fall back to sending the messages over the socket.
+class EZ_FOUNDATION_DLL ezPipeChannel_linux : public ezIpcChannel
+{
+public:
+  ezPipeChannel_linux(const char* szAddress, Mode::Enum mode);
+  ~ezPipeChannel_linux();
+
+private:
+  friend class ezMessageLoop;
+  friend class ezMessageLoop_linux;
+
+  bool CreatePipe(const char* szAddress);
+
+  virtual void AddToMessageLoop(ezMessageLoop* pMsgLoop) override;
+
+  // All functions from here on down are run from worker thread only
+  virtual void InternalConnect() override;
+  virtual void InternalDisconnect() override;
+  virtual void InternalSend() override;
+  virtual bool NeedWakeup() const override;
+
+  /// \brief Upper bound for the number of file descriptors returned by GetPollFds().
+  static constexpr ezUInt32 MaxPollFds = 3;
+
+  /// \brief Writes the file descriptors that the message loop should wait for into pOutFds and returns their number (at most MaxPollFds).
+  ezUInt32 GetPollFds(pollfd* pOutFds) const;
+  void OnPollEvents(int iFd, short iEvents);
+
+  bool AcceptConnection();
+  bool SendHandshake();
+  bool ReceiveHandshake();
+  bool SetupSharedMemory(int iMemoryFd);
+  bool OnConnected();
+
+  bool UpdateSharedMemory();
+  bool ProcessSharedMemoryIncoming();
+  void ProcessSharedMemoryOutgoing();
+  bool HasSharedMemoryWork();
+  void WakeUpPeer();
+
+  bool ProcessSocketIncoming();
+  bool ProcessSocketOutgoing();
+
+  void CloseAll();
+
+private:
+  enum Constants : ezUInt32
+  {
+    BUFFER_SIZE = 4096,
+  };
+
+  // Setup in ctor
+  ezAtomicBool m_bOpen; ///< Whether any socket is still open. Only reset on the worker thread, once the channel is done with everything.
+  ezThreadSignal m_Closed; ///< Raised once m_bOpen has been reset, the destructor waits for it.
+
+  // Only accessed from worker thread
+  bool m_bConnectRequested = false;
+  int m_iListenSocket = -1;
+  int m_iSocket = -1;
+  bool m_bHandshakeDone = false;
+
+  int m_iOwnEvent = -1;  ///< Signaled by the peer, when it wrote data into our receive ring or freed space in our send ring.
+  int m_iPeerEvent = -1; ///< Signaled by us, if the peer went idle.
+  ezPipeChannelSharedMemory_linux* m_pSharedMemory = nullptr;
+  ezUInt32 m_uiOwnSide = 0;
+  ezUInt32 m_uiOutputOffset = 0; ///< How many bytes of the first message in m_OutputQueue have already been sent.
+
+  ezAtomicBool m_bOutputBlocked; ///< Set while the output waits for space in the ring buffer or the socket.
+
+  ezUInt8 m_InputBuffer[BUFFER_SIZE];
+};
+
+#endif
@@ -1,6 +1,6 @@
 #include <FoundationPCH.h>
 
-#if EZ_DISABLED(EZ_PLATFORM_WINDOWS_DESKTOP)
+#if EZ_DISABLED(EZ_PLATFORM_WINDOWS_DESKTOP) && EZ_DISABLED(EZ_PLATFORM_LINUX)
 
 #  include <Foundation/Communication/Implementation/Mobile/MessageLoop_mobile.h>
 #  include <Foundation/Communication/IpcChannel.h>
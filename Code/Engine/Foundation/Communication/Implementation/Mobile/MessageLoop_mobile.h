@@ -1,6 +1,6 @@
 #pragma once
 
-#if EZ_DISABLED(EZ_PLATFORM_WINDOWS_DESKTOP)
+#if EZ_DISABLED(EZ_PLATFORM_WINDOWS_DESKTOP) && EZ_DISABLED(EZ_PLATFORM_LINUX)
 
 #  include <Foundation/Basics.h>
 #  include <Foundation/Communication/Implementation/MessageLoop.h>
@@ -1,8 +1,45 @@
 #include <FoundationPCH.h>
 
 #include <Foundation/Communication/RemoteInterface.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Utilities/Compression.h>
 #include <Foundation/Utilities/ConversionUtils.h>
 
+// Every packet starts with the application ID of the sender, followed by one or more messages.
+// Each message consists of the system ID, the message ID and the data size, followed by the message data.
+// The highest bit of the data size is set, if the data is compressed.
+namespace
+{
+  constexpr ezUInt32 PACKET_HEADER_SIZE = 4;
+  constexpr ezUInt32 MESSAGE_HEADER_SIZE = 12;
+  constexpr ezUInt32 MESSAGE_COMPRESSED_FLAG = 0x80000000u;
+
+  // small messages are collected into packets of up to this size
+  constexpr ezUInt32 RELIABLE_BATCH_SIZE = 64 * 1024;
+  // if a fragment of an unreliable packet gets lost, the entire packet is dropped, so these are kept below the typical MTU
+  constexpr ezUInt32 UNRELIABLE_BATCH_SIZE = 1200;
+
+  static_assert(PACKET_HEADER_SIZE + MESSAGE_HEADER_SIZE == ezRemoteInterface::ExternalBufferHeaderSize, "Invalid external buffer header size");
+
+  EZ_ALWAYS_INLINE void WriteUInt32(ezUInt8* pDst, ezUInt32 uiValue) { ezMemoryUtils::Copy(pDst, reinterpret_cast<const ezUInt8*>(&uiValue), 4); }
+
+  EZ_ALWAYS_INLINE ezUInt32 ReadUInt32(const ezUInt8* pSrc)
+  {
+    ezUInt32 uiValue;
+    ezMemoryUtils::Copy(reinterpret_cast<ezUInt8*>(&uiValue), pSrc, 4);
+    return uiValue;
+  }
+
+  void WriteMessageHeader(ezUInt8* pDst, ezUInt32 uiSystemID, ezUInt32 uiMsgID, ezUInt32 uiDataBytes, bool bCompressed)
+  {
+    EZ_ASSERT_DEV(uiDataBytes < MESSAGE_COMPRESSED_FLAG, "Remote message is too large ({0} bytes)", uiDataBytes);
+
+    WriteUInt32(pDst + 0, uiSystemID);
+    WriteUInt32(pDst + 4, uiMsgID);
+    WriteUInt32(pDst + 8, bCompressed ? (uiDataBytes | MESSAGE_COMPRESSED_FLAG) : uiDataBytes);
+  }
+} // namespace
+
 ezRemoteInterface::~ezRemoteInterface()
 {
   // unfortunately we cannot do that ourselves here, because ShutdownConnection() calls virtual functions
@@ -87,12 +124,17 @@ void ezRemoteInterface::ShutdownConnection()
 
   if (m_RemoteMode != ezRemoteMode::None)
   {
+    // send everything that is still queued, before the connection is closed
+    TransmitQueuedPackets();
+
     InternalShutdownConnection();
 
     m_RemoteMode = ezRemoteMode::None;
     m_uiApplicationID = 0;
     m_uiConnectionToken = 0;
   }
+
+  DiscardQueuedPackets();
 }
 
 void ezRemoteInterface::UpdatePingToServer()
@@ -108,23 +150,96 @@ void ezRemoteInterface::UpdateRemoteInterface()
 {
   EZ_LOCK(GetMutex());
 
+  TransmitQueuedPackets();
   InternalUpdateRemoteInterface();
 }
 
-ezResult ezRemoteInterface::Transmit(ezRemoteTransmitMode tm, const ezArrayPtr<const ezUInt8>& data)
+ezResult ezRemoteInterface::InternalTransmitExternal(ezRemoteTransmitMode tm, ezArrayPtr<ezUInt8> data, ezRemoteBufferReleaseCallback onRelease)
 {
-  if (m_RemoteMode == ezRemoteMode::None)
-    return EZ_FAILURE;
+  const ezResult res = InternalTransmit(tm, data);
 
-  EZ_LOCK(GetMutex());
+  if (onRelease.IsValid())
+  {
+    onRelease(data);
+  }
 
-  if (InternalTransmit(tm, data).Failed())
-    return EZ_FAILURE;
+  return res;
+}
 
-  // make sure the message is processed immediately
-  UpdateRemoteInterface();
+ezUInt8* ezRemoteInterface::AllocateMessage(ezRemoteTransmitMode tm, ezUInt32 uiSystemID, ezUInt32 uiMsgID, ezUInt32 uiDataBytes, bool bCompressed)
+{
+  const ezUInt32 uiMessageSize = MESSAGE_HEADER_SIZE + uiDataBytes;
+  const ezUInt32 uiMaxBatchSize = (tm == ezRemoteTransmitMode::Reliable) ? RELIABLE_BATCH_SIZE : UNRELIABLE_BATCH_SIZE;
 
-  return EZ_SUCCESS;
+  ezDeque<OutgoingPacket>& queue = m_SendQueue[(ezUInt32)tm];
+
+  OutgoingPacket* pPacket = queue.IsEmpty() ? nullptr : &queue.PeekBack();
+
+  // start a new packet, if the message doesn't fit into the current one
+  // large messages always get a packet of their own
+  if (pPacket == nullptr || !pPacket->m_ExternalData.IsEmpty() || pPacket->m_Data.GetCount() + uiMessageSize > uiMaxBatchSize)
+  {
+    pPacket = &queue.ExpandAndGetRef();
+
+    if (PACKET_HEADER_SIZE + uiMessageSize > uiMaxBatchSize)
+    {
+      pPacket->m_Data.Reserve(PACKET_HEADER_SIZE + uiMessageSize);
+    }
+
+    pPacket->m_Data.SetCountUninitialized(PACKET_HEADER_SIZE);
+    WriteUInt32(pPacket->m_Data.GetData(), m_uiApplicationID);
+  }
+
+  const ezUInt32 uiOffset = pPacket->m_Data.GetCount();
+  pPacket->m_Data.SetCountUninitialized(uiOffset + uiMessageSize);
+
+  ezUInt8* pMessage = pPacket->m_Data.GetData() + uiOffset;
+  WriteMessageHeader(pMessage, uiSystemID, uiMsgID, uiDataBytes, bCompressed);
+
+  return pMessage + MESSAGE_HEADER_SIZE;
+}
+
+void ezRemoteInterface::TransmitQueuedPackets()
+{
+  for (ezUInt32 tm = 0; tm < EZ_ARRAY_SIZE(m_SendQueue); ++tm)
+  {
+    {
+      EZ_LOCK(m_SendQueueMutex);
+      m_TransmitQueue.Swap(m_SendQueue[tm]);
+    }
+
+    for (OutgoingPacket& packet : m_TransmitQueue)
+    {
+      if (!packet.m_ExternalData.IsEmpty())
+      {
+        InternalTransmitExternal((ezRemoteTransmitMode)tm, packet.m_ExternalData, packet.m_OnRelease).IgnoreResult();
+      }
+      else
+      {
+        InternalTransmit((ezRemoteTransmitMode)tm, packet.m_Data).IgnoreResult();
+      }
+    }
+
+    m_TransmitQueue.Clear();
+  }
+}
+
+void ezRemoteInterface::DiscardQueuedPackets()
+{
+  EZ_LOCK(m_SendQueueMutex);
+
+  for (ezDeque<OutgoingPacket>& queue : m_SendQueue)
+  {
+    for (OutgoingPacket& packet : queue)
+    {
+      if (packet.m_OnRelease.IsValid())
+      {
+        packet.m_OnRelease(packet.m_ExternalData);
+      }
+    }
+
+    queue.Clear();
+  }
 }
 
 
@@ -141,18 +256,27 @@ void ezRemoteInterface::Send(ezRemoteTransmitMode tm, ezUInt32 uiSystemID, ezUIn
   // if (!IsConnectedToOther())
   //  return;
 
-  m_TempSendBuffer.SetCountUninitialized(12 + data.GetCount());
-  *((ezUInt32*)&m_TempSendBuffer[0]) = m_uiApplicationID;
-  *((ezUInt32*)&m_TempSendBuffer[4]) = uiSystemID;
-  *((ezUInt32*)&m_TempSendBuffer[8]) = uiMsgID;
+  EZ_LOCK(m_SendQueueMutex);
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  if (m_uiCompressionThreshold > 0 && data.GetCount() >= m_uiCompressionThreshold)
+  {
+    if (ezCompressionUtils::Compress(data, ezCompressionMethod::ZStd, m_TempCompressionBuffer).Succeeded() &&
+        m_TempCompressionBuffer.GetCount() < data.GetCount())
+    {
+      ezUInt8* pCopyDst = AllocateMessage(tm, uiSystemID, uiMsgID, m_TempCompressionBuffer.GetCount(), true);
+      ezMemoryUtils::Copy(pCopyDst, m_TempCompressionBuffer.GetData(), m_TempCompressionBuffer.GetCount());
+      return;
+    }
+  }
+#endif
+
+  ezUInt8* pCopyDst = AllocateMessage(tm, uiSystemID, uiMsgID, data.GetCount(), false);
 
   if (!data.IsEmpty())
   {
-    ezUInt8* pCopyDst = &m_TempSendBuffer[12];
     ezMemoryUtils::Copy(pCopyDst, data.GetPtr(), data.GetCount());
   }
-
-  Transmit(tm, m_TempSendBuffer).IgnoreResult();
 }
 
 void ezRemoteInterface::Send(ezRemoteTransmitMode tm, ezUInt32 uiSystemID, ezUInt32 uiMsgID, const void* pData /*= nullptr*/, ezUInt32 uiDataBytes /*= 0*/)
@@ -165,6 +289,30 @@ void ezRemoteInterface::Send(ezRemoteTransmitMode tm, ezRemoteMessage& msg)
   Send(tm, msg.GetSystemID(), msg.GetMessageID(), ezArrayPtr<const ezUInt8>(msg.GetMessageData(), msg.GetMessageSize()));
 }
 
+void ezRemoteInterface::SendExternal(ezRemoteTransmitMode tm, ezUInt32 uiSystemID, ezUInt32 uiMsgID, ezArrayPtr<ezUInt8> buffer, ezRemoteBufferReleaseCallback onRelease)
+{
+  EZ_ASSERT_DEV(buffer.GetCount() >= ExternalBufferHeaderSize, "The buffer has to start with {0} bytes of space for the message header", ExternalBufferHeaderSize);
+
+  if (m_RemoteMode == ezRemoteMode::None)
+  {
+    if (onRelease.IsValid())
+    {
+      onRelease(buffer);
+    }
+
+    return;
+  }
+
+  WriteUInt32(buffer.GetPtr(), m_uiApplicationID);
+  WriteMessageHeader(buffer.GetPtr() + PACKET_HEADER_SIZE, uiSystemID, uiMsgID, buffer.GetCount() - ExternalBufferHeaderSize, false);
+
+  EZ_LOCK(m_SendQueueMutex);
+
+  OutgoingPacket& packet = m_SendQueue[(ezUInt32)tm].ExpandAndGetRef();
+  packet.m_ExternalData = buffer;
+  packet.m_OnRelease = onRelease;
+}
+
 
 void ezRemoteInterface::SetMessageHandler(ezUInt32 uiSystemID, ezRemoteMessageHandler messageHandler)
 {
@@ -299,6 +447,48 @@ void ezRemoteInterface::ReportMessage(ezUInt32 uiApplicationID, ezUInt32 uiSyste
   msg.GetWriter().WriteBytes(data.GetPtr(), data.GetCount()).IgnoreResult();
 }
 
+ezResult ezRemoteInterface::DecodePacket(const ezArrayPtr<const ezUInt8>& packet, DecodedMessageCallback callback)
+{
+  EZ_LOCK(m_Mutex);
+
+  if (packet.GetCount() < PACKET_HEADER_SIZE)
+    return EZ_FAILURE;
+
+  const ezUInt32 uiApplicationID = ReadUInt32(packet.GetPtr());
+  ezUInt32 uiOffset = PACKET_HEADER_SIZE;
+
+  while (uiOffset < packet.GetCount())
+  {
+    if (packet.GetCount() - uiOffset < MESSAGE_HEADER_SIZE)
+      return EZ_FAILURE;
+
+    const ezUInt8* pHeader = packet.GetPtr() + uiOffset;
+    const ezUInt32 uiSystemID = ReadUInt32(pHeader + 0);
+    const ezUInt32 uiMsgID = ReadUInt32(pHeader + 4);
+    const ezUInt32 uiSizeAndFlags = ReadUInt32(pHeader + 8);
+    const ezUInt32 uiDataBytes = uiSizeAndFlags & ~MESSAGE_COMPRESSED_FLAG;
+    uiOffset += MESSAGE_HEADER_SIZE;
+
+    if (uiDataBytes > packet.GetCount() - uiOffset)
+      return EZ_FAILURE;
+
+    ezArrayPtr<const ezUInt8> data = packet.GetSubArray(uiOffset, uiDataBytes);
+    uiOffset += uiDataBytes;
+
+    if ((uiSizeAndFlags & MESSAGE_COMPRESSED_FLAG) != 0)
+    {
+      if (ezCompressionUtils::Decompress(data, ezCompressionMethod::ZStd, m_TempDecompressionBuffer).Failed())
+        return EZ_FAILURE;
+
+      data = m_TempDecompressionBuffer;
+    }
+
+    callback(uiApplicationID, uiSystemID, uiMsgID, data);
+  }
+
+  return EZ_SUCCESS;
+}
+
 ezResult ezRemoteInterface::DetermineTargetAddress(const char* szConnectTo, ezUInt32& out_IP, ezUInt16& out_Port)
 {
   out_IP = 0;
@@ -18,8 +18,16 @@ protected:
   virtual void InternalShutdownConnection() override;
   virtual ezTime InternalGetPingToServer() override;
   virtual ezResult InternalTransmit(ezRemoteTransmitMode tm, const ezArrayPtr<const ezUInt8>& data) override;
+  virtual ezResult InternalTransmitExternal(ezRemoteTransmitMode tm, ezArrayPtr<ezUInt8> data, ezRemoteBufferReleaseCallback onRelease) override;
 
 private:
+  void HandleMessage(ENetPeer* pPeer, ezUInt32 uiApplicationID, ezUInt32 uiSystemID, ezUInt32 uiMsgID, const ezArrayPtr<const ezUInt8>& data);
+
+  /// \brief The data that a client sends along with its connection request, the connection token combined with the protocol version.
+  ///
+  /// For version 1 this is the plain connection token, which is what clients sent before there was a version.
+  static ezUInt32 ComputeConnectionData(ezUInt32 uiConnectionToken, ezUInt32 uiProtocolVersion) { return uiConnectionToken ^ ((uiProtocolVersion - 1) * 0x9E3779B9u); }
+
   ENetAddress m_EnetServerAddress;
   ENetHost* m_pEnetHost = nullptr;
   ENetPeer* m_pEnetConnectionToServer = nullptr;
@@ -29,6 +37,27 @@ private:
   static bool s_bEnetInitialized;
 };
 
+namespace
+{
+  struct ezEnetExternalPacketData
+  {
+    ezArrayPtr<ezUInt8> m_Data;
+    ezRemoteBufferReleaseCallback m_OnRelease;
+  };
+
+  void ENET_CALLBACK FreeExternalPacket(ENetPacket* pPacket)
+  {
+    ezEnetExternalPacketData* pExternal = static_cast<ezEnetExternalPacketData*>(pPacket->userData);
+
+    if (pExternal->m_OnRelease.IsValid())
+    {
+      pExternal->m_OnRelease(pExternal->m_Data);
+    }
+
+    EZ_DEFAULT_DELETE(pExternal);
+  }
+} // namespace
+
 ezInternal::NewInstance<ezRemoteInterfaceEnet> ezRemoteInterfaceEnet::Make(ezAllocatorBase* allocator /*= ezFoundation::GetDefaultAllocator()*/)
 {
   return EZ_NEW(allocator, ezRemoteInterfaceEnetImpl);
@@ -101,7 +130,7 @@ ezResult ezRemoteInterfaceEnetImpl::InternalCreateConnection(ezRemoteMode mode,
 
   if (mode == ezRemoteMode::Client)
   {
-    m_pEnetConnectionToServer = enet_host_connect(m_pEnetHost, &m_EnetServerAddress, maxChannels, GetConnectionToken());
+    m_pEnetConnectionToServer = enet_host_connect(m_pEnetHost, &m_EnetServerAddress, maxChannels, ComputeConnectionData(GetConnectionToken(), ProtocolVersion));
 
     if (m_pEnetConnectionToServer == nullptr)
       return EZ_FAILURE;
@@ -155,6 +184,34 @@ ezResult ezRemoteInterfaceEnetImpl::InternalTransmit(ezRemoteTransmitMode tm, co
   return EZ_SUCCESS;
 }
 
+ezResult ezRemoteInterfaceEnetImpl::InternalTransmitExternal(ezRemoteTransmitMode tm, ezArrayPtr<ezUInt8> data, ezRemoteBufferReleaseCallback onRelease)
+{
+  if (m_pEnetHost == nullptr)
+  {
+    if (onRelease.IsValid())
+    {
+      onRelease(data);
+    }
+
+    return EZ_FAILURE;
+  }
+
+  // the packet references the external data, the release callback is executed once enet destroys the packet
+  const enet_uint32 uiFlags = ENET_PACKET_FLAG_NO_ALLOCATE | ((tm == ezRemoteTransmitMode::Reliable) ? ENET_PACKET_FLAG_RELIABLE : 0);
+  ENetPacket* pPacket = enet_packet_create(data.GetPtr(), data.GetCount(), uiFlags);
+
+  ezEnetExternalPacketData* pExternal = EZ_DEFAULT_NEW(ezEnetExternalPacketData);
+  pExternal->m_Data = data;
+  pExternal->m_OnRelease = onRelease;
+
+  pPacket->userData = pExternal;
+  pPacket->freeCallback = &FreeExternalPacket;
+
+  enet_host_broadcast(m_pEnetHost, 0, pPacket);
+
+  return EZ_SUCCESS;
+}
+
 void ezRemoteInterfaceEnetImpl::InternalUpdateRemoteInterface()
 {
   if (!m_pEnetHost)
@@ -179,10 +236,20 @@ void ezRemoteInterfaceEnetImpl::InternalUpdateRemoteInterface()
     {
       case ENET_EVENT_TYPE_CONNECT:
       {
-        if ((GetRemoteMode() == ezRemoteMode::Server) && (NetworkEvent.peer->eventData != GetConnectionToken()))
+        if ((GetRemoteMode() == ezRemoteMode::Server) && (NetworkEvent.peer->eventData != ComputeConnectionData(GetConnectionToken(), ProtocolVersion)))
         {
-          // do not accept connections that don't have the correct password
-          enet_peer_disconnect(NetworkEvent.peer, 0);
+          for (ezUInt32 uiVersion = 1; uiVersion < ProtocolVersion; ++uiVersion)
+          {
+            if (NetworkEvent.peer->eventData == ComputeConnectionData(GetConnectionToken(), uiVersion))
+            {
+              ezLog::Error("Rejected a client that uses remote protocol version {0}, the server uses version {1}", uiVersion, ProtocolVersion);
+              break;
+            }
+          }
+
+          // do not accept connections that don't have the correct password or protocol version
+          // the server's version is passed along, so that newer clients can report the mismatch
+          enet_peer_disconnect(NetworkEvent.peer, ProtocolVersion);
           break;
         }
 
@@ -220,6 +287,11 @@ void ezRemoteInterfaceEnetImpl::InternalUpdateRemoteInterface()
       {
         if (GetRemoteMode() == ezRemoteMode::Client)
         {
+          if (!IsConnectedToServer() && NetworkEvent.data != 0 && NetworkEvent.data != ProtocolVersion)
+          {
+            ezLog::Error("The server refused the connection, it uses remote protocol version {0}, the client uses version {1}", NetworkEvent.data, ProtocolVersion);
+          }
+
           ReportDisconnectedFromServer();
         }
         else
@@ -236,42 +308,14 @@ void ezRemoteInterfaceEnetImpl::InternalUpdateRemoteInterface()
 
       case ENET_EVENT_TYPE_RECEIVE:
       {
-        const ezUInt32 uiApplicationID = *((ezUInt32*)&NetworkEvent.packet->data[0]);
-        const ezUInt32 uiSystemID = *((ezUInt32*)&NetworkEvent.packet->data[4]);
-        const ezUInt32 uiMsgID = *((ezUInt32*)&NetworkEvent.packet->data[8]);
-        const ezUInt8* pData = &NetworkEvent.packet->data[12];
-
-        if (uiSystemID == GetConnectionToken())
-        {
-          switch (uiMsgID)
-          {
-            case 'EZID':
-            {
-              // acknowledge that the ID has been received
-              Send(GetConnectionToken(), 'AKID');
-
-              // go tell the others about it
-              ezUInt32 uiServerID = *((ezUInt32*)pData);
-              ReportConnectionToServer(uiServerID);
-            }
-            break;
-
-            case 'AKID':
-            {
-              if (m_EnetPeerToClientID[NetworkEvent.peer] != uiApplicationID)
-              {
-                m_EnetPeerToClientID[NetworkEvent.peer] = uiApplicationID;
+        ENetPeer* pPeer = NetworkEvent.peer;
+        const ezArrayPtr<const ezUInt8> packet(NetworkEvent.packet->data, (ezUInt32)NetworkEvent.packet->dataLength);
 
-                // the client received the server ID -> the connection has been established properly
-                ReportConnectionToClient(uiApplicationID);
-              }
-            }
-            break;
-          }
-        }
-        else
+        if (DecodePacket(packet, [this, pPeer](ezUInt32 uiApplicationID, ezUInt32 uiSystemID, ezUInt32 uiMsgID, const ezArrayPtr<const ezUInt8>& data) {
+              HandleMessage(pPeer, uiApplicationID, uiSystemID, uiMsgID, data);
+            }).Failed())
         {
-          ReportMessage(uiApplicationID, uiSystemID, uiMsgID, ezArrayPtr<const ezUInt8>(pData, (ezUInt32)NetworkEvent.packet->dataLength - 12));
+          ezLog::Warning("Received a malformed packet ({0} bytes)", packet.GetCount());
         }
 
         enet_packet_destroy(NetworkEvent.packet);
@@ -284,6 +328,46 @@ void ezRemoteInterfaceEnetImpl::InternalUpdateRemoteInterface()
   }
 }
 
+void ezRemoteInterfaceEnetImpl::HandleMessage(ENetPeer* pPeer, ezUInt32 uiApplicationID, ezUInt32 uiSystemID, ezUInt32 uiMsgID, const ezArrayPtr<const ezUInt8>& data)
+{
+  if (uiSystemID == GetConnectionToken())
+  {
+    switch (uiMsgID)
+    {
+      case 'EZID':
+      {
+        if (data.GetCount() < sizeof(ezUInt32))
+          return;
+
+        // acknowledge that the ID has been received
+        Send(GetConnectionToken(), 'AKID');
+
+        // go tell the others about it
+        ezUInt32 uiServerID = 0;
+        ezMemoryUtils::Copy(reinterpret_cast<ezUInt8*>(&uiServerID), data.GetPtr(), sizeof(ezUInt32));
+        ReportConnectionToServer(uiServerID);
+      }
+      break;
+
+      case 'AKID':
+      {
+        if (m_EnetPeerToClientID[pPeer] != uiApplicationID)
+        {
+          m_EnetPeerToClientID[pPeer] = uiApplicationID;
+
+          // the client received the server ID -> the connection has been established properly
+          ReportConnectionToClient(uiApplicationID);
+        }
+      }
+      break;
+    }
+  }
+  else
+  {
+    ReportMessage(uiApplicationID, uiSystemID, uiMsgID, data);
+  }
+}
+
 #endif
 
 
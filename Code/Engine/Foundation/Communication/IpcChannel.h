@@ -92,11 +92,13 @@ protected:
   virtual bool NeedWakeup() const = 0;
 
   /// \brief Implementation needs to call this when new data has been received.
-  ///  data can be invalidated after the function.
+  ///  data can be invalidated after the function. Messages that are completely contained in data are deserialized from it directly,
+  ///  only messages that are split across several calls are assembled in a separate buffer.
   void ReceiveMessageData(ezArrayPtr<const ezUInt8> data);
   void FlushPendingOperations();
 
 private:
+  void DeserializeMessage(ezArrayPtr<const ezUInt8> messageData);
   void EnqueueMessage(ezUniquePtr<ezProcessMessage>&& msg);
   void SwapWorkQueue(ezDeque<ezUniquePtr<ezProcessMessage>>& messages);
 
@@ -45,6 +45,11 @@ struct EZ_FOUNDATION_DLL ezRemoteEvent
 
 typedef ezDelegate<void(ezRemoteMessage&)> ezRemoteMessageHandler;
 
+/// \brief Called once the remote interface does not need a buffer anymore, that was passed to ezRemoteInterface::SendExternal().
+///
+/// This may be called from any thread that updates the remote interface.
+typedef ezDelegate<void(ezArrayPtr<ezUInt8>)> ezRemoteBufferReleaseCallback;
+
 struct EZ_FOUNDATION_DLL ezRemoteMessageQueue
 {
   ezRemoteMessageHandler m_MessageHandler;
@@ -140,6 +145,8 @@ public:
   ///@{
 
   /// \brief If no update thread was spawned, this should be called to process messages
+  ///
+  /// Messages are not transmitted when Send() is called, but collected and sent in as few packets as possible during the next update.
   void UpdateRemoteInterface();
 
   /// \brief If no update thread was spawned, this should be called by clients to determine the ping
@@ -153,6 +160,9 @@ public:
   /// \brief Sends a reliable message without any data.
   /// If it is a server, the message is broadcast to all clients.
   /// If it is a client, the message is only sent to the server.
+  ///
+  /// None of the Send functions transmit anything right away. The message is queued and only goes out with the next
+  /// UpdateRemoteInterface(), which the update thread calls periodically, if one was started.
   void Send(ezUInt32 uiSystemID, ezUInt32 uiMsgID);
 
   /// \brief Sends a message, appends the given array of data
@@ -170,6 +180,25 @@ public:
   /// If it is a client, the message is only sent to the server.
   void Send(ezRemoteTransmitMode tm, ezRemoteMessage& msg);
 
+  /// \brief The number of bytes that have to be reserved at the start of every buffer that is passed to SendExternal().
+  static constexpr ezUInt32 ExternalBufferHeaderSize = 16;
+
+  /// \brief Sends the given buffer without copying it.
+  ///
+  /// The first ExternalBufferHeaderSize bytes of the buffer are reserved for the message header, the message data follows after that.
+  /// The buffer must stay valid and unmodified until onRelease is called, which happens once the data has been handed over to the network
+  /// or has been dropped. Such messages are never batched with others or compressed. Like Send(), this only queues the message, it is
+  /// transmitted during the next UpdateRemoteInterface().
+  void SendExternal(ezRemoteTransmitMode tm, ezUInt32 uiSystemID, ezUInt32 uiMsgID, ezArrayPtr<ezUInt8> buffer, ezRemoteBufferReleaseCallback onRelease);
+
+  /// \brief Messages with at least this many bytes of data are compressed before they are sent. Zero (the default) disables compression.
+  ///
+  /// Messages whose data does not get smaller are sent uncompressed. Only available when ZStd support is enabled in the build.
+  void SetCompressionThreshold(ezUInt32 uiMinBytes) { m_uiCompressionThreshold = uiMinBytes; }
+
+  /// \brief Returns the value set with SetCompressionThreshold().
+  ezUInt32 GetCompressionThreshold() const { return m_uiCompressionThreshold; }
+
   ///@}
 
   /// \name Message Handling
@@ -198,6 +227,11 @@ protected:
   /// \name Implementation Details
   ///@{
 
+  /// \brief Version of the packet layout. Has to be increased whenever the layout changes.
+  ///
+  /// Implementations exchange it when a connection is established and refuse peers that use a different version.
+  static constexpr ezUInt32 ProtocolVersion = 2;
+
   /// \brief Derived classes have to implement this to start a network connection
   virtual ezResult InternalCreateConnection(ezRemoteMode mode, const char* szServerAddress) = 0;
 
@@ -211,8 +245,16 @@ protected:
   virtual ezTime InternalGetPingToServer() = 0;
 
   /// \brief Derived classes have to implement this to deliver messages to the server or client
+  ///
+  /// The data is a packet that contains one or more messages. It has to be passed to DecodePacket() on the receiving side.
   virtual ezResult InternalTransmit(ezRemoteTransmitMode tm, const ezArrayPtr<const ezUInt8>& data) = 0;
 
+  /// \brief Derived classes can override this to deliver a packet without copying it. onRelease has to be called once the data is not needed
+  /// anymore, also when the transmission fails.
+  ///
+  /// The default implementation calls InternalTransmit() and releases the data right away.
+  virtual ezResult InternalTransmitExternal(ezRemoteTransmitMode tm, ezArrayPtr<ezUInt8> data, ezRemoteBufferReleaseCallback onRelease);
+
   /// \brief Derived classes can override this to interpret an address differently
   virtual ezResult DetermineTargetAddress(const char* szConnectTo, ezUInt32& out_IP, ezUInt16& out_Port);
 
@@ -232,13 +274,30 @@ protected:
   /// \brief Should be called by the implementation, when a message has arrived
   void ReportMessage(ezUInt32 uiApplicationID, ezUInt32 uiSystemID, ezUInt32 uiMsgID, const ezArrayPtr<const ezUInt8>& data);
 
+  typedef ezDelegate<void(ezUInt32 uiApplicationID, ezUInt32 uiSystemID, ezUInt32 uiMsgID, const ezArrayPtr<const ezUInt8>& data)> DecodedMessageCallback;
+
+  /// \brief Splits a packet that was given to InternalTransmit() or InternalTransmitExternal() on the other side into its messages.
+  ///
+  /// Compressed messages are decompressed before they are passed to the callback. Fails for malformed packets.
+  ezResult DecodePacket(const ezArrayPtr<const ezUInt8>& packet, DecodedMessageCallback callback);
+
   ///@}
 
 
 private:
+  /// \brief A packet that waits for the next update to be transmitted. Either m_Data or m_ExternalData is used.
+  struct OutgoingPacket
+  {
+    ezDynamicArray<ezUInt8> m_Data;
+    ezArrayPtr<ezUInt8> m_ExternalData;
+    ezRemoteBufferReleaseCallback m_OnRelease;
+  };
+
   void StartUpdateThread();
   void StopUpdateThread();
-  ezResult Transmit(ezRemoteTransmitMode tm, const ezArrayPtr<const ezUInt8>& data);
+  ezUInt8* AllocateMessage(ezRemoteTransmitMode tm, ezUInt32 uiSystemID, ezUInt32 uiMsgID, ezUInt32 uiDataBytes, bool bCompressed);
+  void TransmitQueuedPackets();
+  void DiscardQueuedPackets();
   ezResult CreateConnection(ezUInt32 uiConnectionToken, ezRemoteMode mode, const char* szServerAddress, bool bStartUpdateThread);
   ezUInt32 ExecuteMessageHandlersForQueue(ezRemoteMessageQueue& queue);
 
@@ -251,8 +310,17 @@ private:
   ezUInt32 m_uiConnectionToken = 0;
   ezUInt32 m_uiConnectedToServerWithID = 0;
   ezInt32 m_iConnectionsToClients = 0;
-  ezDynamicArray<ezUInt8> m_TempSendBuffer;
+  ezUInt32 m_uiCompressionThreshold = 0;
   ezHashTable<ezUInt32, ezRemoteMessageQueue> m_MessageQueues;
+
+  // Send() only locks this mutex, so that it does not have to wait for network updates
+  ezMutex m_SendQueueMutex;
+  ezDeque<OutgoingPacket> m_SendQueue[2]; ///< One queue per ezRemoteTransmitMode.
+  ezDynamicArray<ezUInt8> m_TempCompressionBuffer;
+
+  // only accessed while m_Mutex is locked
+  ezDeque<OutgoingPacket> m_TransmitQueue;
+  ezDynamicArray<ezUInt8> m_TempDecompressionBuffer;
 };
 
 /// \brief The remote interface thread updates in regular intervals to keep the connection alive.
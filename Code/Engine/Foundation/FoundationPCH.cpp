@@ -38,6 +38,8 @@ EZ_STATICLINK_LIBRARY(Foundation)
   EZ_STATICLINK_REFERENCE(Foundation_Communication_Implementation_GlobalEvent);
   EZ_STATICLINK_REFERENCE(Foundation_Communication_Implementation_IpcChannel);
   EZ_STATICLINK_REFERENCE(Foundation_Communication_Implementation_IpcChannelEnet);
+  EZ_STATICLINK_REFERENCE(Foundation_Communication_Implementation_Linux_MessageLoop_linux);
+  EZ_STATICLINK_REFERENCE(Foundation_Communication_Implementation_Linux_PipeChannel_linux);
   EZ_STATICLINK_REFERENCE(Foundation_Communication_Implementation_Message);
   EZ_STATICLINK_REFERENCE(Foundation_Communication_Implementation_MessageLoop);
   EZ_STATICLINK_REFERENCE(Foundation_Communication_Implementation_Mobile_MessageLoop_mobile);
@@ -76,6 +78,7 @@ EZ_STATICLINK_LIBRARY(Foundation)
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_DeduplicationContext);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_DependencyFile);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_DirectoryWatcher);
+  EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_JSONDocument);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_JSONParser);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_JSONReader);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_JSONWriter);
@@ -91,6 +94,7 @@ EZ_STATICLINK_LIBRARY(Foundation)
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_StreamOperations);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_StreamOperationsOther);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_StringDeduplicationContext);
+  EZ_STATICLINK_REFERENCE(Foundation_Logging_Implementation_AsyncLog);
   EZ_STATICLINK_REFERENCE(Foundation_Logging_Implementation_ConsoleWriter);
   EZ_STATICLINK_REFERENCE(Foundation_Logging_Implementation_ETWWriter);
   EZ_STATICLINK_REFERENCE(Foundation_Logging_Implementation_HTMLWriter);
@@ -113,8 +117,13 @@ EZ_STATICLINK_LIBRARY(Foundation)
   EZ_STATICLINK_REFERENCE(Foundation_Memory_Implementation_PageAllocator);
   EZ_STATICLINK_REFERENCE(Foundation_Memory_Policies_GuardedAllocation);
   EZ_STATICLINK_REFERENCE(Foundation_Profiling_Implementation_Profiling);
+  EZ_STATICLINK_REFERENCE(Foundation_Profiling_Implementation_ProfilingCapture);
+  EZ_STATICLINK_REFERENCE(Foundation_Profiling_Implementation_ProfilingSampler);
+  EZ_STATICLINK_REFERENCE(Foundation_Profiling_Implementation_ProfilingSpikeCapture);
+  EZ_STATICLINK_REFERENCE(Foundation_Profiling_Implementation_ProfilingTelemetry);
   EZ_STATICLINK_REFERENCE(Foundation_Reflection_Implementation_PropertyAttributes);
   EZ_STATICLINK_REFERENCE(Foundation_Reflection_Implementation_PropertyPath);
+  EZ_STATICLINK_REFERENCE(Foundation_Reflection_Implementation_PropertyTable);
   EZ_STATICLINK_REFERENCE(Foundation_Reflection_Implementation_RTTI);
   EZ_STATICLINK_REFERENCE(Foundation_Reflection_Implementation_ReflectionUtils);
   EZ_STATICLINK_REFERENCE(Foundation_Reflection_Implementation_StandardTypes);
@@ -12,6 +12,7 @@ enum class ezArchiveCompressionMode : ezUInt8
   Uncompressed,
   Compressed_zstd,
   Compressed_zip,
+  Compressed_zstd_dict, ///< zstd compressed with one of the dictionaries stored in the ezArchiveTOC, see ezArchiveEntry::m_uiDictionaryIndex
 };
 
 /// \brief Data for a single file entry in an ezArchive file
@@ -23,6 +24,20 @@ public:
   ezUInt64 m_uiStoredDataSize = 0;       ///< The amount of (compressed) bytes actually stored in the ezArchive.
   ezUInt32 m_uiPathStringOffset = 0;     ///< Byte offset into ezArchiveTOC::m_AllPathStrings where the path string for this entry resides.
   ezArchiveCompressionMode m_CompressionMode = ezArchiveCompressionMode::Uncompressed;
+  ezUInt16 m_uiDictionaryIndex = 0;          ///< Only used for ezArchiveCompressionMode::Compressed_zstd_dict. Index into ezArchiveTOC::m_Dictionaries.
+
+  ezResult Serialize(ezStreamWriter& stream) const;
+  ezResult Deserialize(ezStreamReader& stream);
+};
+
+/// \brief A compression dictionary that is shared by multiple file entries in an ezArchive file
+///
+/// Small files compress poorly on their own. Files of the same type (e.g. all materials) typically share a lot of content though,
+/// so a dictionary built from such files allows to compress each of them much better.
+class EZ_FOUNDATION_DLL ezArchiveDictionary
+{
+public:
+  ezDynamicArray<ezUInt8> m_Data;
 
   ezResult Serialize(ezStreamWriter& stream) const;
   ezResult Deserialize(ezStreamReader& stream);
@@ -106,6 +121,8 @@ public:
   ezHashTable<ezArchiveStoredString, ezUInt32> m_PathToEntryIndex;
   /// one large array holding all path strings for the file entries, to reduce allocations
   ezDynamicArray<ezUInt8> m_AllPathStrings;
+  /// the compression dictionaries used by file entries with ezArchiveCompressionMode::Compressed_zstd_dict
+  ezDynamicArray<ezArchiveDictionary> m_Dictionaries;
 
   /// \brief Returns the entry index for the given file or ezInvalidIndex, if not found.
   ezUInt32 FindEntry(const char* szFile) const;
@@ -4,6 +4,9 @@
 
 #include <Foundation/Containers/Deque.h>
 #include <Foundation/Types/Delegate.h>
+#include <Foundation/Types/UniquePtr.h>
+
+class ezCompressedStreamZstdDictionary;
 
 /// \brief Utility class to build an ezArchive file from files/folders on disk
 ///
@@ -21,6 +24,21 @@ public:
   // all the source files from disk that should be put into the ezArchive
   ezDeque<SourceEntry> m_Entries;
 
+  /// \brief If enabled, WriteArchive() trains a compression dictionary for every file type (extension) that has enough small zstd
+  /// compressed files, stores it in the archive and compresses those files with it.
+  ///
+  /// Small files like materials or prefabs compress poorly on their own, but share a lot of content with other files of the same type.
+  bool m_bTrainDictionaries = false;
+
+  /// Only files up to this size are compressed with a dictionary. Larger files compress well enough on their own.
+  ezUInt32 m_uiDictionaryMaxFileSize = 64 * 1024;
+
+  /// The maximum size of each trained dictionary.
+  ezUInt32 m_uiDictionarySize = 64 * 1024;
+
+  /// How many files of one type are needed, before a dictionary is trained for that type.
+  ezUInt32 m_uiDictionaryMinFiles = 8;
+
   enum class InclusionMode
   {
     Exclude,       ///< Do not add this file to the archive
@@ -49,4 +67,7 @@ protected:
   virtual bool WriteNextFileCallback(ezUInt32 uiCurEntry, ezUInt32 uiMaxEntries, const char* szSourceFile) const;
   /// Override this to get a progress report for writing a single file to the output
   virtual bool WriteFileProgressCallback(ezUInt64 bytesWritten, ezUInt64 bytesTotal) const;
+
+private:
+  ezResult TrainDictionaries(ezArchiveTOC& toc, ezDynamicArray<ezUniquePtr<ezCompressedStreamZstdDictionary>>& out_Dictionaries, ezDynamicArray<ezUInt32>& out_EntryDictionaries) const;
 };
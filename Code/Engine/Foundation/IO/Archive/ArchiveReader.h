@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Foundation/IO/Archive/Archive.h>
+#include <Foundation/IO/CompressedStreamZstd.h>
 #include <Foundation/IO/MemoryMappedFile.h>
 #include <Foundation/Types/UniquePtr.h>
 
@@ -33,6 +34,9 @@ public:
   /// \brief Creates a reader that will decompress the given file entry.
   ezUniquePtr<ezStreamReader> CreateEntryReader(ezUInt32 uiEntryIdx) const;
 
+  /// \brief Returns the prepared dictionary that is needed to decompress the given entry, or nullptr if the entry does not use one.
+  const ezCompressedStreamZstdDictionary* GetEntryDictionary(ezUInt32 uiEntryIdx) const;
+
 protected:
   /// \brief Called by ExtractAllFiles() for progress reporting. Return false to abort.
   virtual bool ExtractNextFileCallback(ezUInt32 uiCurEntry, ezUInt32 uiMaxEntries, const char* szSourceFile) const;
@@ -45,4 +49,8 @@ protected:
   ezUInt8 m_uiArchiveVersion = 0;
   const void* m_pDataStart = nullptr;
   ezUInt64 m_uiMemFileSize = 0;
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  ezDynamicArray<ezUniquePtr<ezCompressedStreamZstdDictionary>> m_Dictionaries;
+#endif
 };
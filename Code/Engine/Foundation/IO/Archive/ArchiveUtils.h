@@ -10,6 +10,7 @@ class ezMemoryMappedFile;
 class ezArchiveTOC;
 class ezArchiveEntry;
 class ezRawMemoryStreamReader;
+class ezCompressedStreamZstdDictionary;
 
 /// \brief Utilities for working with ezArchive files
 namespace ezArchiveUtils
@@ -41,15 +42,25 @@ namespace ezArchiveUtils
   ///
   /// Appends information to the TOC for finding the data in the stream. Reads and updates inout_uiCurrentStreamPosition with the data byte
   /// offset. The progress callback is executed for every couple of KB of data that were written.
+  ///
+  /// For ezArchiveCompressionMode::Compressed_zstd_dict the dictionary must be passed in and tocEntry.m_uiDictionaryIndex has to be set
+  /// by the caller to the index of that dictionary in the TOC.
   EZ_FOUNDATION_DLL ezResult WriteEntry(ezStreamWriter& stream, const char* szAbsSourcePath, ezUInt32 uiPathStringOffset,
     ezArchiveCompressionMode compression, ezArchiveEntry& tocEntry, ezUInt64& inout_uiCurrentStreamPosition,
-    FileWriteProgressCallback progress = FileWriteProgressCallback());
+    FileWriteProgressCallback progress = FileWriteProgressCallback(), const ezCompressedStreamZstdDictionary* pDictionary = nullptr);
 
   /// \brief Similar to WriteEntry, but if compression is enabled, checks that compression makes enough of a difference.
   /// If compression does not reduce file size enough, the file is stored uncompressed instead.
   EZ_FOUNDATION_DLL ezResult WriteEntryOptimal(ezStreamWriter& stream, const char* szAbsSourcePath, ezUInt32 uiPathStringOffset,
     ezArchiveCompressionMode compression, ezArchiveEntry& tocEntry, ezUInt64& inout_uiCurrentStreamPosition,
-    FileWriteProgressCallback progress = FileWriteProgressCallback());
+    FileWriteProgressCallback progress = FileWriteProgressCallback(), const ezCompressedStreamZstdDictionary* pDictionary = nullptr);
+
+  /// \brief Builds a compression dictionary from the given sample data (typically the content of many small files of the same type).
+  ///
+  /// The dictionary is made up of the byte sequences that occur in the most samples. It is used as raw content by zstd, ie. the compressor
+  /// can reference it like previously seen data. Sequences that are most valuable are placed at the end, as they are cheapest to reference.
+  /// Returns an empty dictionary, if the samples do not share enough data for a dictionary to be worth it.
+  EZ_FOUNDATION_DLL void TrainDictionary(ezArrayPtr<const ezArrayPtr<const ezUInt8>> samples, ezUInt32 uiMaxDictionarySize, ezDynamicArray<ezUInt8>& out_Dictionary);
 
   /// \brief Configures \a memReader as a view into the data stored for \a entry in the archive file.
   ///
@@ -60,7 +71,9 @@ namespace ezArchiveUtils
   /// \brief Creates a new stream reader which allows to read the uncompressed data for the given archive entry.
   ///
   /// Under the hood it may create different types of stream readers to uncompress or decode the data.
-  EZ_FOUNDATION_DLL ezUniquePtr<ezStreamReader> CreateEntryReader(const ezArchiveEntry& entry, const void* pStartOfArchiveData);
+  /// For entries that were compressed with a dictionary, the dictionary (prepared from ezArchiveTOC::m_Dictionaries) has to be passed in
+  /// and must stay alive as long as the reader is in use.
+  EZ_FOUNDATION_DLL ezUniquePtr<ezStreamReader> CreateEntryReader(const ezArchiveEntry& entry, const void* pStartOfArchiveData, const ezCompressedStreamZstdDictionary* pDictionary = nullptr);
 
   EZ_FOUNDATION_DLL ezResult ReadZipHeader(ezStreamReader& stream, ezUInt8& out_uiVersion);
   EZ_FOUNDATION_DLL ezResult ExtractZipTOC(ezMemoryMappedFile& memFile, ezArchiveTOC& toc);
@@ -97,6 +97,7 @@ namespace ezDataDirectory
     friend class ArchiveType;
 
     ezCompressedStreamReaderZstd m_CompressedStreamReader;
+    const ezCompressedStreamZstdDictionary* m_pDictionary = nullptr;
   };
 #endif
 
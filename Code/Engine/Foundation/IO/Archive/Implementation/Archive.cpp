@@ -50,12 +50,15 @@ ezResult ezArchiveTOC::Serialize(ezStreamWriter& stream) const
 
   EZ_SUCCEED_OR_RETURN(stream.WriteArray(m_AllPathStrings));
 
+  // added in archive version 5
+  EZ_SUCCEED_OR_RETURN(stream.WriteArray(m_Dictionaries));
+
   return EZ_SUCCESS;
 }
 
 ezResult ezArchiveTOC::Deserialize(ezStreamReader& stream, ezUInt8 uiArchiveVersion)
 {
-  EZ_ASSERT_ALWAYS(uiArchiveVersion <= 4, "Unsupported archive version {}", uiArchiveVersion);
+  EZ_ASSERT_ALWAYS(uiArchiveVersion <= 5, "Unsupported archive version {}", uiArchiveVersion);
 
   // we don't use the TOC version anymore, but the archive version instead
   const ezTypeVersion version = stream.ReadVersion(2);
@@ -89,6 +92,11 @@ ezResult ezArchiveTOC::Deserialize(ezStreamReader& stream, ezUInt8 uiArchiveVers
 
   EZ_SUCCEED_OR_RETURN(stream.ReadArray(m_AllPathStrings));
 
+  if (uiArchiveVersion >= 5)
+  {
+    EZ_SUCCEED_OR_RETURN(stream.ReadArray(m_Dictionaries));
+  }
+
   if (bRecreateStringHashes)
   {
     ezLog::Info("Archive uses older string hashing, recomputing hashes.");
@@ -143,6 +151,11 @@ ezResult ezArchiveEntry::Serialize(ezStreamWriter& stream) const
   stream << (ezUInt8)m_CompressionMode;
   stream << m_uiPathStringOffset;
 
+  if (m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd_dict)
+  {
+    stream << m_uiDictionaryIndex;
+  }
+
   return EZ_SUCCESS;
 }
 
@@ -156,8 +169,24 @@ ezResult ezArchiveEntry::Deserialize(ezStreamReader& stream)
   m_CompressionMode = (ezArchiveCompressionMode)uiCompressionMode;
   stream >> m_uiPathStringOffset;
 
+  // this compression mode only exists since archive version 5, so older archives never contain this data
+  if (m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd_dict)
+  {
+    stream >> m_uiDictionaryIndex;
+  }
+
   return EZ_SUCCESS;
 }
 
+ezResult ezArchiveDictionary::Serialize(ezStreamWriter& stream) const
+{
+  return stream.WriteArray(m_Data);
+}
+
+ezResult ezArchiveDictionary::Deserialize(ezStreamReader& stream)
+{
+  return stream.ReadArray(m_Data);
+}
+
 
 EZ_STATICLINK_FILE(Foundation, Foundation_IO_Archive_Implementation_Archive);
@@ -1,7 +1,10 @@
 #include <FoundationPCH.h>
 
+#include <Foundation/Containers/Map.h>
 #include <Foundation/IO/Archive/ArchiveBuilder.h>
 #include <Foundation/IO/Archive/ArchiveUtils.h>
+#include <Foundation/IO/CompressedStreamZstd.h>
+#include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
 #include <Foundation/IO/OSFile.h>
 #include <Foundation/Logging/Log.h>
@@ -77,6 +80,17 @@ ezResult ezArchiveBuilder::WriteArchive(ezStreamWriter& stream) const
 
   ezArchiveTOC toc;
 
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  // for every entry, the index of the dictionary to compress it with (or ezInvalidIndex)
+  ezDynamicArray<ezUInt32> entryDictionaries;
+  ezDynamicArray<ezUniquePtr<ezCompressedStreamZstdDictionary>> dictionaries;
+
+  if (m_bTrainDictionaries)
+  {
+    EZ_SUCCEED_OR_RETURN(TrainDictionaries(toc, dictionaries, entryDictionaries));
+  }
+#endif
+
   ezStringBuilder sHashablePath;
 
   ezUInt64 uiStreamSize = 0;
@@ -97,7 +111,20 @@ ezResult ezArchiveBuilder::WriteArchive(ezStreamWriter& stream) const
     if (!WriteNextFileCallback(i + 1, uiNumEntries, e.m_sAbsSourcePath))
       return EZ_FAILURE;
 
-    EZ_SUCCEED_OR_RETURN(ezArchiveUtils::WriteEntryOptimal(stream, e.m_sAbsSourcePath, uiPathStringOffset, e.m_CompressionMode, toc.m_Entries.ExpandAndGetRef(), uiStreamSize, ezMakeDelegate(&ezArchiveBuilder::WriteFileProgressCallback, this)));
+    ezArchiveCompressionMode compression = e.m_CompressionMode;
+    const ezCompressedStreamZstdDictionary* pDictionary = nullptr;
+    ezArchiveEntry& tocEntry = toc.m_Entries.ExpandAndGetRef();
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+    if (!entryDictionaries.IsEmpty() && entryDictionaries[i] != ezInvalidIndex)
+    {
+      compression = ezArchiveCompressionMode::Compressed_zstd_dict;
+      pDictionary = dictionaries[entryDictionaries[i]].Borrow();
+      tocEntry.m_uiDictionaryIndex = static_cast<ezUInt16>(entryDictionaries[i]);
+    }
+#endif
+
+    EZ_SUCCEED_OR_RETURN(ezArchiveUtils::WriteEntryOptimal(stream, e.m_sAbsSourcePath, uiPathStringOffset, compression, tocEntry, uiStreamSize, ezMakeDelegate(&ezArchiveBuilder::WriteFileProgressCallback, this), pDictionary));
   }
 
   EZ_SUCCEED_OR_RETURN(ezArchiveUtils::AppendTOC(stream, toc));
@@ -105,6 +132,105 @@ ezResult ezArchiveBuilder::WriteArchive(ezStreamWriter& stream) const
   return EZ_SUCCESS;
 }
 
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+
+ezResult ezArchiveBuilder::TrainDictionaries(ezArchiveTOC& toc, ezDynamicArray<ezUniquePtr<ezCompressedStreamZstdDictionary>>& out_Dictionaries, ezDynamicArray<ezUInt32>& out_EntryDictionaries) const
+{
+  EZ_LOG_BLOCK("TrainDictionaries");
+
+  // only use a limited amount of sample data per file type, training time grows with it and the benefit does not
+  const ezUInt64 uiMaxSampleDataSize = static_cast<ezUInt64>(m_uiDictionarySize) * 100;
+
+  struct FileType
+  {
+    ezDynamicArray<ezUInt32> m_Entries;
+    ezDynamicArray<ezDynamicArray<ezUInt8>> m_Samples;
+    ezUInt64 m_uiSampleDataSize = 0;
+  };
+
+  ezMap<ezString, FileType> fileTypes;
+  ezStringBuilder sExtension;
+
+  const ezUInt32 uiNumEntries = m_Entries.GetCount();
+  out_EntryDictionaries.SetCount(uiNumEntries, ezInvalidIndex);
+
+  for (ezUInt32 i = 0; i < uiNumEntries; ++i)
+  {
+    const SourceEntry& e = m_Entries[i];
+
+    if (e.m_CompressionMode != ezArchiveCompressionMode::Compressed_zstd)
+      continue;
+
+    ezFileReader file;
+    if (file.Open(e.m_sAbsSourcePath).Failed())
+    {
+      ezLog::Error("Could not open file '{}'", e.m_sAbsSourcePath);
+      return EZ_FAILURE;
+    }
+
+    const ezUInt64 uiFileSize = file.GetFileSize();
+    if (uiFileSize == 0 || uiFileSize > m_uiDictionaryMaxFileSize)
+      continue;
+
+    sExtension = ezPathUtils::GetFileExtension(e.m_sRelTargetPath);
+    sExtension.ToLower();
+
+    FileType& type = fileTypes[sExtension];
+    type.m_Entries.PushBack(i);
+
+    if (type.m_uiSampleDataSize < uiMaxSampleDataSize)
+    {
+      ezDynamicArray<ezUInt8>& sample = type.m_Samples.ExpandAndGetRef();
+      sample.SetCountUninitialized(static_cast<ezUInt32>(uiFileSize));
+      sample.SetCount(static_cast<ezUInt32>(file.ReadBytes(sample.GetData(), uiFileSize)));
+
+      type.m_uiSampleDataSize += sample.GetCount();
+    }
+  }
+
+  ezDynamicArray<ezArrayPtr<const ezUInt8>> samples;
+  ezDynamicArray<ezUInt8> dictionaryData;
+
+  for (auto it = fileTypes.GetIterator(); it.IsValid(); ++it)
+  {
+    const FileType& type = it.Value();
+
+    if (type.m_Entries.GetCount() < m_uiDictionaryMinFiles)
+      continue;
+
+    if (toc.m_Dictionaries.GetCount() >= 0xFFFF)
+      break;
+
+    samples.Clear();
+    for (const auto& sample : type.m_Samples)
+    {
+      samples.PushBack(sample);
+    }
+
+    ezArchiveUtils::TrainDictionary(samples, m_uiDictionarySize, dictionaryData);
+
+    if (dictionaryData.IsEmpty())
+      continue;
+
+    ezLog::Dev("Trained a {} dictionary for {} '{}' files.", ezArgFileSize(dictionaryData.GetCount()), type.m_Entries.GetCount(), it.Key());
+
+    toc.m_Dictionaries.ExpandAndGetRef().m_Data = dictionaryData;
+
+    ezUniquePtr<ezCompressedStreamZstdDictionary>& pDictionary = out_Dictionaries.ExpandAndGetRef();
+    pDictionary = EZ_DEFAULT_NEW(ezCompressedStreamZstdDictionary);
+    pDictionary->SetData(dictionaryData);
+
+    for (ezUInt32 uiEntry : type.m_Entries)
+    {
+      out_EntryDictionaries[uiEntry] = out_Dictionaries.GetCount() - 1;
+    }
+  }
+
+  return EZ_SUCCESS;
+}
+
+#endif
+
 bool ezArchiveBuilder::WriteNextFileCallback(ezUInt32 uiCurEntry, ezUInt32 uiMaxEntries, const char* szSourceFile) const
 {
   return true;
@@ -82,9 +82,30 @@ ezResult ezArchiveReader::OpenArchive(const char* szPath)
         ezLog::Error("Archive is corrupt. Invalid entry path-string offset.");
         return EZ_FAILURE;
       }
+
+      if (e.m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd_dict && e.m_uiDictionaryIndex >= m_ArchiveTOC.m_Dictionaries.GetCount())
+      {
+        ezLog::Error("Archive is corrupt. Invalid entry dictionary index.");
+        return EZ_FAILURE;
+      }
     }
   }
 
+#  ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  // prepare all dictionaries once, so that opening entries that use them is cheap
+  {
+    m_Dictionaries.Clear();
+    m_Dictionaries.Reserve(m_ArchiveTOC.m_Dictionaries.GetCount());
+
+    for (const auto& dict : m_ArchiveTOC.m_Dictionaries)
+    {
+      ezUniquePtr<ezCompressedStreamZstdDictionary>& pDictionary = m_Dictionaries.ExpandAndGetRef();
+      pDictionary = EZ_DEFAULT_NEW(ezCompressedStreamZstdDictionary);
+      pDictionary->SetData(dict.m_Data);
+    }
+  }
+#  endif
+
   return EZ_SUCCESS;
 #else
   EZ_REPORT_FAILURE("Memory mapped files are unsupported on this platform.");
@@ -123,7 +144,21 @@ void ezArchiveReader::ConfigureRawMemoryStreamReader(ezUInt32 uiEntryIdx, ezRawM
 
 ezUniquePtr<ezStreamReader> ezArchiveReader::CreateEntryReader(ezUInt32 uiEntryIdx) const
 {
-  return ezArchiveUtils::CreateEntryReader(m_ArchiveTOC.m_Entries[uiEntryIdx], m_pDataStart);
+  return ezArchiveUtils::CreateEntryReader(m_ArchiveTOC.m_Entries[uiEntryIdx], m_pDataStart, GetEntryDictionary(uiEntryIdx));
+}
+
+const ezCompressedStreamZstdDictionary* ezArchiveReader::GetEntryDictionary(ezUInt32 uiEntryIdx) const
+{
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  const ezArchiveEntry& entry = m_ArchiveTOC.m_Entries[uiEntryIdx];
+
+  if (entry.m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd_dict)
+  {
+    return m_Dictionaries[entry.m_uiDictionaryIndex].Borrow();
+  }
+#endif
+
+  return nullptr;
 }
 
 ezResult ezArchiveReader::ExtractFile(ezUInt32 uiEntryIdx, const char* szTargetFolder) const
@@ -37,11 +37,12 @@ ezResult ezArchiveUtils::WriteHeader(ezStreamWriter& stream)
   const char* szTag = "EZARCHIVE";
   EZ_SUCCEED_OR_RETURN(stream.WriteBytes(szTag, 10));
 
-  const ezUInt8 uiArchiveVersion = 4;
+  const ezUInt8 uiArchiveVersion = 5;
 
   // Version 2: Added end-of-file marker for file corruption (cutoff) detection
   // Version 3: HashedStrings changed from MurmurHash to xxHash
   // Version 4: use 64 Bit string hashes
+  // Version 5: compression dictionaries stored in the TOC
   stream << uiArchiveVersion;
 
   const ezUInt8 uiPadding[5] = {0, 0, 0, 0, 0};
@@ -62,7 +63,7 @@ ezResult ezArchiveUtils::ReadHeader(ezStreamReader& stream, ezUInt8& out_uiVersi
   out_uiVersion = 0;
   stream >> out_uiVersion;
 
-  if (out_uiVersion != 1 && out_uiVersion != 2 && out_uiVersion != 3 && out_uiVersion != 4)
+  if (out_uiVersion < 1 || out_uiVersion > 5)
   {
     ezLog::Error("Unsupported archive version '{}'.", out_uiVersion);
     return EZ_FAILURE;
@@ -86,7 +87,7 @@ ezResult ezArchiveUtils::ReadHeader(ezStreamReader& stream, ezUInt8& out_uiVersi
   return EZ_SUCCESS;
 }
 
-ezResult ezArchiveUtils::WriteEntry(ezStreamWriter& stream, const char* szAbsSourcePath, ezUInt32 uiPathStringOffset, ezArchiveCompressionMode compression, ezArchiveEntry& tocEntry, ezUInt64& inout_uiCurrentStreamPosition, FileWriteProgressCallback progress /*= FileWriteProgressCallback()*/)
+ezResult ezArchiveUtils::WriteEntry(ezStreamWriter& stream, const char* szAbsSourcePath, ezUInt32 uiPathStringOffset, ezArchiveCompressionMode compression, ezArchiveEntry& tocEntry, ezUInt64& inout_uiCurrentStreamPosition, FileWriteProgressCallback progress /*= FileWriteProgressCallback()*/, const ezCompressedStreamZstdDictionary* pDictionary /*= nullptr*/)
 {
   ezFileReader file;
   EZ_SUCCEED_OR_RETURN(file.Open(szAbsSourcePath, 1024 * 1024));
@@ -119,6 +120,16 @@ ezResult ezArchiveUtils::WriteEntry(ezStreamWriter& stream, const char* szAbsSou
 #endif
       break;
 
+    case ezArchiveCompressionMode::Compressed_zstd_dict:
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+      EZ_ASSERT_DEV(pDictionary != nullptr && !pDictionary->IsEmpty(), "Dictionary compression requires a dictionary.");
+      zstdWriter.SetOutputStream(&stream, ezCompressedStreamWriterZstd::Compression::Default, 4, pDictionary);
+      pWriter = &zstdWriter;
+#else
+      compression = ezArchiveCompressionMode::Uncompressed;
+#endif
+      break;
+
     default:
       EZ_ASSERT_NOT_IMPLEMENTED;
   }
@@ -149,6 +160,7 @@ ezResult ezArchiveUtils::WriteEntry(ezStreamWriter& stream, const char* szAbsSou
   {
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
     case ezArchiveCompressionMode::Compressed_zstd:
+    case ezArchiveCompressionMode::Compressed_zstd_dict:
       EZ_SUCCEED_OR_RETURN(zstdWriter.FinishCompressedStream());
       tocEntry.m_uiStoredDataSize = zstdWriter.GetWrittenBytes();
       break;
@@ -165,7 +177,7 @@ ezResult ezArchiveUtils::WriteEntry(ezStreamWriter& stream, const char* szAbsSou
   return EZ_SUCCESS;
 }
 
-ezResult ezArchiveUtils::WriteEntryOptimal(ezStreamWriter& stream, const char* szAbsSourcePath, ezUInt32 uiPathStringOffset, ezArchiveCompressionMode compression, ezArchiveEntry& tocEntry, ezUInt64& inout_uiCurrentStreamPosition, FileWriteProgressCallback progress /*= FileWriteProgressCallback()*/)
+ezResult ezArchiveUtils::WriteEntryOptimal(ezStreamWriter& stream, const char* szAbsSourcePath, ezUInt32 uiPathStringOffset, ezArchiveCompressionMode compression, ezArchiveEntry& tocEntry, ezUInt64& inout_uiCurrentStreamPosition, FileWriteProgressCallback progress /*= FileWriteProgressCallback()*/, const ezCompressedStreamZstdDictionary* pDictionary /*= nullptr*/)
 {
   if (compression == ezArchiveCompressionMode::Uncompressed)
   {
@@ -177,7 +189,7 @@ ezResult ezArchiveUtils::WriteEntryOptimal(ezStreamWriter& stream, const char* s
     ezMemoryStreamWriter writer(&storage);
 
     ezUInt64 streamPos = inout_uiCurrentStreamPosition;
-    EZ_SUCCEED_OR_RETURN(WriteEntry(writer, szAbsSourcePath, uiPathStringOffset, compression, tocEntry, streamPos, progress));
+    EZ_SUCCEED_OR_RETURN(WriteEntry(writer, szAbsSourcePath, uiPathStringOffset, compression, tocEntry, streamPos, progress, pDictionary));
 
     if (tocEntry.m_uiStoredDataSize * 12 >= tocEntry.m_uiUncompressedDataSize * 10)
     {
@@ -194,6 +206,164 @@ ezResult ezArchiveUtils::WriteEntryOptimal(ezStreamWriter& stream, const char* s
   }
 }
 
+void ezArchiveUtils::TrainDictionary(ezArrayPtr<const ezArrayPtr<const ezUInt8>> samples, ezUInt32 uiMaxDictionarySize, ezDynamicArray<ezUInt8>& out_Dictionary)
+{
+  // This is a simplified version of the 'cover' algorithm that zstd uses for dictionary training:
+  // Every sample is split into k-mers (short byte sequences). For every k-mer we count in how many samples it occurs.
+  // The data is then split into as many 'epochs' as the dictionary has segments. From every epoch the segment with the highest
+  // score (sum of the k-mer frequencies it contains) is chosen and its k-mers are removed from the frequency table,
+  // so that the following segments add new content.
+
+  constexpr ezUInt32 uiKmerSize = 8;
+  constexpr ezUInt32 uiSegmentSize = 64;
+  constexpr ezUInt32 uiTableBits = 20;
+  constexpr ezUInt32 uiMinDictionarySize = 1024;
+
+  out_Dictionary.Clear();
+
+  ezUInt64 uiTotalSize = 0;
+  for (const auto& sample : samples)
+  {
+    uiTotalSize += sample.GetCount();
+  }
+
+  const ezUInt32 uiNumSegments = uiMaxDictionarySize / uiSegmentSize;
+
+  if (samples.GetCount() < 2 || uiNumSegments == 0 || uiTotalSize < uiMinDictionarySize)
+    return;
+
+  auto HashKmer = [](const ezUInt8* pData) -> ezUInt32 {
+    ezUInt64 uiKmer;
+    ezMemoryUtils::Copy(reinterpret_cast<ezUInt8*>(&uiKmer), pData, uiKmerSize);
+    return static_cast<ezUInt32>((uiKmer * 0xCF1BBCDCB7A56463ull) >> (64 - uiTableBits));
+  };
+
+  // count in how many samples each k-mer occurs
+  ezDynamicArray<ezUInt16> kmerFrequency;
+  kmerFrequency.SetCount(1 << uiTableBits);
+
+  {
+    ezDynamicArray<ezUInt32> kmerLastSample;
+    kmerLastSample.SetCount(1 << uiTableBits, ezInvalidIndex);
+
+    for (ezUInt32 s = 0; s < samples.GetCount(); ++s)
+    {
+      const ezArrayPtr<const ezUInt8> sample = samples[s];
+
+      for (ezUInt32 pos = 0; pos + uiKmerSize <= sample.GetCount(); ++pos)
+      {
+        const ezUInt32 uiHash = HashKmer(sample.GetPtr() + pos);
+
+        if (kmerLastSample[uiHash] != s)
+        {
+          kmerLastSample[uiHash] = s;
+          kmerFrequency[uiHash] = ezMath::Min<ezUInt32>(kmerFrequency[uiHash] + 1, 0xFFFF);
+        }
+      }
+    }
+  }
+
+  struct Segment
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiSample;
+    ezUInt32 m_uiOffset;
+    ezUInt32 m_uiSize;
+    ezUInt64 m_uiScore;
+
+    bool operator<(const Segment& rhs) const { return m_uiScore < rhs.m_uiScore; }
+  };
+
+  ezDynamicArray<Segment> segments;
+
+  // a k-mer that occurs only in one sample has no value for the dictionary
+  auto GetKmerScore = [&](const ezUInt8* pData) -> ezUInt64 {
+    const ezUInt16 uiFreq = kmerFrequency[HashKmer(pData)];
+    return uiFreq > 1 ? uiFreq : 0;
+  };
+
+  const ezUInt64 uiEpochSize = ezMath::Max<ezUInt64>(uiTotalSize / uiNumSegments, uiSegmentSize);
+  const ezUInt32 uiKmersPerSegment = uiSegmentSize - uiKmerSize + 1;
+
+  ezUInt32 uiCurSample = 0;
+  ezUInt32 uiCurOffset = 0;
+
+  while (uiCurSample < samples.GetCount())
+  {
+    Segment best = {0, 0, 0, 0};
+
+    // find the best segment in this epoch, using a sliding window sum over the k-mer scores
+    ezUInt64 uiEpochRemaining = uiEpochSize;
+    while (uiEpochRemaining > 0 && uiCurSample < samples.GetCount())
+    {
+      const ezArrayPtr<const ezUInt8> sample = samples[uiCurSample];
+      const ezUInt32 uiSampleSize = sample.GetCount();
+      const ezUInt32 uiEnd = static_cast<ezUInt32>(ezMath::Min<ezUInt64>(uiSampleSize, uiCurOffset + uiEpochRemaining));
+
+      if (uiSampleSize >= uiSegmentSize)
+      {
+        ezUInt64 uiWindowScore = 0;
+
+        const ezUInt32 uiFirstSegment = ezMath::Min(uiCurOffset, uiSampleSize - uiSegmentSize);
+        for (ezUInt32 k = 0; k < uiKmersPerSegment; ++k)
+        {
+          uiWindowScore += GetKmerScore(sample.GetPtr() + uiFirstSegment + k);
+        }
+
+        for (ezUInt32 pos = uiFirstSegment; pos + uiSegmentSize <= uiSampleSize && pos < uiEnd; ++pos)
+        {
+          if (pos > uiFirstSegment)
+          {
+            uiWindowScore -= GetKmerScore(sample.GetPtr() + pos - 1);
+            uiWindowScore += GetKmerScore(sample.GetPtr() + pos + uiKmersPerSegment - 1);
+          }
+
+          if (uiWindowScore > best.m_uiScore)
+          {
+            best = {uiCurSample, pos, uiSegmentSize, uiWindowScore};
+          }
+        }
+      }
+
+      uiEpochRemaining -= uiEnd - uiCurOffset;
+      uiCurOffset = uiEnd;
+
+      if (uiCurOffset >= uiSampleSize)
+      {
+        ++uiCurSample;
+        uiCurOffset = 0;
+      }
+    }
+
+    if (best.m_uiScore == 0)
+      continue;
+
+    // remove the chosen k-mers, so that the following segments prefer content that is not yet in the dictionary
+    for (ezUInt32 k = 0; k < uiKmersPerSegment; ++k)
+    {
+      kmerFrequency[HashKmer(samples[best.m_uiSample].GetPtr() + best.m_uiOffset + k)] = 0;
+    }
+
+    segments.PushBack(best);
+
+    if (segments.GetCount() >= uiNumSegments)
+      break;
+  }
+
+  if (segments.GetCount() * uiSegmentSize < uiMinDictionarySize)
+    return;
+
+  // zstd can reference data at the end of the dictionary with smaller offsets, so put the best segments last
+  segments.Sort();
+
+  out_Dictionary.Reserve(segments.GetCount() * uiSegmentSize);
+  for (const Segment& seg : segments)
+  {
+    out_Dictionary.PushBackRange(samples[seg.m_uiSample].GetSubArray(seg.m_uiOffset, seg.m_uiSize));
+  }
+}
+
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
 
 class ezCompressedStreamReaderZstdWithSource : public ezCompressedStreamReaderZstd
@@ -214,7 +384,7 @@ public:
 
 #endif
 
-ezUniquePtr<ezStreamReader> ezArchiveUtils::CreateEntryReader(const ezArchiveEntry& entry, const void* pStartOfArchiveData)
+ezUniquePtr<ezStreamReader> ezArchiveUtils::CreateEntryReader(const ezArchiveEntry& entry, const void* pStartOfArchiveData, const ezCompressedStreamZstdDictionary* pDictionary /*= nullptr*/)
 {
   ezUniquePtr<ezStreamReader> reader;
 
@@ -237,6 +407,17 @@ ezUniquePtr<ezStreamReader> ezArchiveUtils::CreateEntryReader(const ezArchiveEnt
       pRawReader->SetInputStream(&pRawReader->m_Source);
       break;
     }
+
+    case ezArchiveCompressionMode::Compressed_zstd_dict:
+    {
+      EZ_ASSERT_DEV(pDictionary != nullptr, "Archive entry was compressed with a dictionary, but none was provided");
+
+      reader = EZ_DEFAULT_NEW(ezCompressedStreamReaderZstdWithSource);
+      ezCompressedStreamReaderZstdWithSource* pRawReader = static_cast<ezCompressedStreamReaderZstdWithSource*>(reader.Borrow());
+      ConfigureRawMemoryStreamReader(entry, pStartOfArchiveData, pRawReader->m_Source);
+      pRawReader->SetInputStream(&pRawReader->m_Source, pDictionary);
+      break;
+    }
 #endif
 #ifdef BUILDSYSTEM_ENABLE_ZLIB_SUPPORT
     case ezArchiveCompressionMode::Compressed_zip:
@@ -45,7 +45,12 @@ ezDataDirectoryReader* ezDataDirectory::ArchiveType::OpenFileToRead(const char*
   const ezUInt32 uiEntryIndex = toc.FindEntry(sArchivePath);
 
   if (uiEntryIndex == ezInvalidIndex)
+  {
+    ++m_LookupStats.m_uiNotFound;
     return nullptr;
+  }
+
+  ++m_LookupStats.m_uiFound;
 
   const ezArchiveEntry* pEntry = &toc.m_Entries[uiEntryIndex];
 
@@ -73,17 +78,23 @@ ezDataDirectoryReader* ezDataDirectory::ArchiveType::OpenFileToRead(const char*
 
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
       case ezArchiveCompressionMode::Compressed_zstd:
+      case ezArchiveCompressionMode::Compressed_zstd_dict:
       {
+        ArchiveReaderZstd* pReaderZstd = nullptr;
+
         if (!m_FreeReadersZstd.IsEmpty())
         {
-          pReader = m_FreeReadersZstd.PeekBack();
+          pReaderZstd = m_FreeReadersZstd.PeekBack();
           m_FreeReadersZstd.PopBack();
         }
         else
         {
           m_ReadersZstd.PushBack(EZ_DEFAULT_NEW(ArchiveReaderZstd, 1));
-          pReader = m_ReadersZstd.PeekBack().Borrow();
+          pReaderZstd = m_ReadersZstd.PeekBack().Borrow();
         }
+
+        pReaderZstd->m_pDictionary = m_ArchiveReader.GetEntryDictionary(uiEntryIndex);
+        pReader = pReaderZstd;
         break;
       }
 #endif
@@ -134,7 +145,15 @@ bool ezDataDirectory::ArchiveType::ExistsFile(const char* szFile, bool bOneSpeci
 {
   ezStringBuilder sArchivePath = m_sArchiveSubFolder;
   sArchivePath.AppendPath(szFile);
-  return m_ArchiveReader.GetArchiveTOC().FindEntry(sArchivePath) != ezInvalidIndex;
+
+  if (m_ArchiveReader.GetArchiveTOC().FindEntry(sArchivePath) == ezInvalidIndex)
+  {
+    ++m_LookupStats.m_uiNotFound;
+    return false;
+  }
+
+  ++m_LookupStats.m_uiFound;
+  return true;
 }
 
 ezResult ezDataDirectory::ArchiveType::GetFileStats(const char* szFileOrFolder, bool bOneSpecificDataDir, ezFileStats& out_Stats)
@@ -145,7 +164,12 @@ ezResult ezDataDirectory::ArchiveType::GetFileStats(const char* szFileOrFolder,
   const ezUInt32 uiEntryIndex = toc.FindEntry(sArchivePath);
 
   if (uiEntryIndex == ezInvalidIndex)
+  {
+    ++m_LookupStats.m_uiNotFound;
     return EZ_FAILURE;
+  }
+
+  ++m_LookupStats.m_uiFound;
 
   const ezArchiveEntry* pEntry = &toc.m_Entries[uiEntryIndex];
 
@@ -305,7 +329,7 @@ ezResult ezDataDirectory::ArchiveReaderZstd::InternalOpen(ezFileShareMode::Enum
 {
   EZ_ASSERT_DEBUG(FileShareMode != ezFileShareMode::Exclusive, "Archives only support shared reading of files. Exclusive access cannot be guaranteed.");
 
-  m_CompressedStreamReader.SetInputStream(&m_MemStreamReader);
+  m_CompressedStreamReader.SetInputStream(&m_MemStreamReader, m_pDictionary);
   return EZ_SUCCESS;
 }
 
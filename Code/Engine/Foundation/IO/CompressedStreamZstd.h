@@ -4,12 +4,64 @@
 #include <Foundation/Basics.h>
 #include <Foundation/Containers/DynamicArray.h>
 #include <Foundation/IO/Stream.h>
+#include <Foundation/Threading/Mutex.h>
+#include <Foundation/Types/UniquePtr.h>
 
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
 
+/// \brief A zstd dictionary that can be shared by many ezCompressedStreamWriterZstd and ezCompressedStreamReaderZstd instances.
+///
+/// Compressing many small pieces of similar data (e.g. small asset files) individually gives poor compression ratios, because the
+/// compressor has no history to find matches in. A dictionary provides that history up front. Any data can be used as a dictionary,
+/// but it works best when it contains byte sequences that are common in the data to compress (see ezArchiveUtils::TrainDictionary()).
+///
+/// Data that was compressed with a dictionary can only be decompressed with exactly the same dictionary.
+/// The dictionary is prepared for decompression only once, so that many streams can use it without additional setup costs.
+class EZ_FOUNDATION_DLL ezCompressedStreamZstdDictionary
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezCompressedStreamZstdDictionary);
+
+public:
+  ezCompressedStreamZstdDictionary();
+  ~ezCompressedStreamZstdDictionary();
+
+  /// \brief Copies the dictionary content. Must not be modified while any stream is still using this dictionary.
+  void SetData(ezArrayPtr<const ezUInt8> data);
+
+  /// \brief Returns the raw dictionary content.
+  ezArrayPtr<const ezUInt8> GetData() const { return m_Data; }
+
+  /// \brief Returns true, if no dictionary content was set.
+  bool IsEmpty() const { return m_Data.IsEmpty(); }
+
+private:
+  friend class ezCompressedStreamReaderZstd;
+  friend class ezCompressedStreamWriterZstd;
+
+  /// \brief Returns the digested compression dictionary for the given level. It is created on first use and shared by all writers.
+  /*ZSTD_CDict*/ const void* GetZstdCDict(int iCompressionLevel) const;
+
+  void FreeZstdDicts();
+
+  struct CDict
+  {
+    int m_iCompressionLevel = 0;
+    /*ZSTD_CDict*/ void* m_pZstdCDict = nullptr;
+  };
+
+  ezDynamicArray<ezUInt8> m_Data;
+  /*ZSTD_DDict*/ void* m_pZstdDDict = nullptr;
+
+  mutable ezMutex m_CDictMutex;
+  mutable ezDynamicArray<CDict> m_ZstdCDicts;
+};
+
 /// \brief A stream reader that will decompress data that was stored using the ezCompressedStreamWriterZstd.
 ///
 /// The reader takes another reader as its source for the compressed data (e.g. a file or a memory stream).
+///
+/// If the data was written in multithreaded block mode (see ezCompressedStreamWriterZstd::SetMultithreadedBlockSize()), this is
+/// detected automatically and the reader decompresses several blocks ahead in parallel using the ezTaskSystem.
 class EZ_FOUNDATION_DLL ezCompressedStreamReaderZstd : public ezStreamReader
 {
 public:
@@ -24,7 +76,10 @@ public:
   ///
   /// Calling this a second time on the same instance is valid and allows to reuse the decoder, which is more efficient than creating a new
   /// one.
-  void SetInputStream(ezStreamReader* pInputStream); // [tested]
+  ///
+  /// If the data was compressed with a dictionary, the same dictionary has to be passed in here. It must stay alive until the
+  /// reader is done with the stream.
+  void SetInputStream(ezStreamReader* pInputStream, const ezCompressedStreamZstdDictionary* pDictionary = nullptr); // [tested]
 
   /// \brief Reads either uiBytesToRead or the amount of remaining bytes in the stream into pReadBuffer.
   ///
@@ -33,7 +88,14 @@ public:
   virtual ezUInt64 ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead) override; // [tested]
 
 private:
+  struct Block;
+
   ezResult RefillReadCache();
+  ezUInt64 ReadCompressedBytes(void* pBuffer, ezUInt64 uiBytesToRead);
+  bool IsBlockStream();
+  ezUInt64 ReadBytesFromBlocks(void* pReadBuffer, ezUInt64 uiBytesToRead);
+  void StartDecompressingBlocks();
+  void WaitForAllBlocks();
 
   // local declaration to reduce #include dependencies
   struct InBufferImpl
@@ -48,6 +110,16 @@ private:
   ezStreamReader* m_pInputStream = nullptr;
   /*ZSTD_DStream*/ void* m_pZstdDStream = nullptr;
   /*ZSTD_inBuffer*/ InBufferImpl m_InBuffer;
+
+  // multithreaded block mode
+  bool m_bCheckedForBlocks = false;
+  bool m_bBlockMode = false;
+  bool m_bNoMoreBlocks = false;
+  const ezCompressedStreamZstdDictionary* m_pDictionary = nullptr;
+  ezDynamicArray<ezUniquePtr<Block>> m_Blocks; // ring buffer of blocks that are being decompressed
+  ezUInt32 m_uiOldestBlock = 0;
+  ezUInt32 m_uiBlocksInFlight = 0;
+  ezUInt32 m_uiBlockReadPos = 0;
 };
 
 /// \brief A stream writer that will compress all incoming data and then passes it on into another stream.
@@ -92,7 +164,27 @@ public:
   /// another stream. This can prevent internal allocations, if one wants to use compression on multiple streams consecutively. It also
   /// allows to create a compressor stream early, but decide at a later pointer whether or with which stream to use it, and it will only
   /// allocate internal structures once that final decision is made.
-  void SetOutputStream(ezStreamWriter* pOutputStream, Compression Ratio = Compression::Default, ezUInt32 uiCompressionCacheSizeKB = 4); // [tested]
+  ///
+  /// If a dictionary is given, the data is compressed using it. The same dictionary is then needed for decompression.
+  void SetOutputStream(ezStreamWriter* pOutputStream, Compression Ratio = Compression::Default, ezUInt32 uiCompressionCacheSizeKB = 4, const ezCompressedStreamZstdDictionary* pDictionary = nullptr); // [tested]
+
+  /// \brief Enables compressing the data in independent blocks on multiple threads.
+  ///
+  /// The incoming data is split into blocks of the given size (in KB), which are compressed in parallel by the ezTaskSystem.
+  /// Each block is stored as a separate zstd frame, preceded by a small skippable frame that tells the reader how large the block is.
+  /// Readers that do not know about blocks can still decompress the data, ezCompressedStreamReaderZstd additionally decompresses
+  /// such streams in parallel.
+  ///
+  /// Since blocks are compressed independently, the compression ratio is slightly worse than in the single-threaded mode, especially
+  /// for small blocks. Flush() finishes the current block, so it should be called rarely in this mode.
+  ///
+  /// Pass 0 to disable the block mode (the default). The block size must not exceed 64 MB, readers reject larger blocks as corrupt data.
+  /// The setting is kept when the writer is reused for another output stream.
+  /// This has to be called before writing any bytes to the stream.
+  void SetMultithreadedBlockSize(ezUInt32 uiBlockSizeKB = 1024); // [tested]
+
+  /// \brief Returns the block size in KB that was set through SetMultithreadedBlockSize(). Zero means the block mode is disabled.
+  ezUInt32 GetMultithreadedBlockSize() const { return m_uiBlockSize / 1024; }
 
   /// \brief Compresses \a uiBytesToWrite from \a pWriteBuffer.
   ///
@@ -133,7 +225,13 @@ public:
   virtual ezResult Flush() override; // [tested]
 
 private:
+  struct Block;
+
   ezResult FlushWriteCache();
+  ezResult WriteChunks(const ezUInt8* pData, ezUInt32 uiSize);
+  void StartCompressingBlock();
+  ezResult WriteOldestBlock();
+  void WaitForAllBlocks();
 
   ezUInt64 m_uiUncompressedSize = 0;
   ezUInt64 m_uiCompressedSize = 0;
@@ -152,6 +250,14 @@ private:
   /*ZSTD_outBuffer*/ OutBufferImpl m_OutBuffer;
 
   ezDynamicArray<ezUInt8> m_CompressedCache;
+
+  // multithreaded block mode
+  ezUInt32 m_uiBlockSize = 0;
+  int m_iCompressionLevel = Compression::Default;
+  const ezCompressedStreamZstdDictionary* m_pDictionary = nullptr;
+  ezDynamicArray<ezUniquePtr<Block>> m_Blocks; // ring buffer, the block after the ones in flight is the one that gets filled
+  ezUInt32 m_uiOldestBlock = 0;
+  ezUInt32 m_uiBlocksInFlight = 0;
 };
 
 #endif // BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
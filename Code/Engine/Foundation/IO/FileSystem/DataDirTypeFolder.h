@@ -1,10 +1,14 @@
 #pragma once
 
+#include <Foundation/Containers/HashSet.h>
 #include <Foundation/Containers/HybridArray.h>
 #include <Foundation/Containers/Map.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/IO/FileSystem/Implementation/DataDirType.h>
 #include <Foundation/IO/OSFile.h>
+#include <Foundation/Types/UniquePtr.h>
+
+class ezDirectoryWatcher;
 
 namespace ezDataDirectory
 {
@@ -17,6 +21,7 @@ namespace ezDataDirectory
   class EZ_FOUNDATION_DLL FolderType : public ezDataDirectoryType
   {
   public:
+    FolderType();
     ~FolderType();
 
     /// \brief The factory that can be registered at ezFileSystem to create data directories of this type.
@@ -34,9 +39,29 @@ namespace ezDataDirectory
     /// access.
     static ezString s_sRedirectionPrefix;
 
+    /// If enabled, folder data directories build an index of all the files they contain when they are mounted, and keep it up to date
+    /// with an ezDirectoryWatcher. Looking up files then only needs a hash lookup, which especially speeds up searches for files that
+    /// don't exist, since every mounted data directory is asked for them.
+    /// Files that are written or deleted through ezFileSystem are added to or removed from the index immediately. Changes done by
+    /// other means are only picked up once the directory watcher reports them, so this should only be enabled, if no one writes
+    /// files into a data directory and expects them to be readable right away.
+    /// Files that are written or deleted through any data directory that points to the same folder are handled as well.
+    /// On platforms that do not support file iteration and directory watching, only the files that were looked up and found to be
+    /// missing are remembered. This still answers repeated searches for files that don't exist without asking the OS.
+    /// This only has an effect for data directories that are added after the flag was set.
+    static bool s_bUseFileIndex;
+
     /// \brief When s_sRedirectionFile and s_sRedirectionPrefix are used to enable file redirection, this will reload those config files.
+    ///
+    /// If a file index is used, it is rebuilt as well.
     virtual void ReloadExternalConfigs() override;
 
+    /// \brief Returns whether this data directory currently uses a file index, see s_bUseFileIndex.
+    bool HasFileIndex() const { return m_pFileIndexWatcher != nullptr; }
+
+    /// \brief Returns whether this data directory remembers which files are missing, because no complete file index is available.
+    bool HasMissingFileCache() const { return m_bCacheMissingFiles; }
+
     virtual const ezString128& GetRedirectedDataDirectoryPath() const override { return m_sRedirectedDataDirPath; }
 
   protected:
@@ -61,6 +86,21 @@ namespace ezDataDirectory
 
     void LoadRedirectionFile();
 
+    enum class FileIndexResult
+    {
+      Unknown, ///< There is no file index, or the file cannot be in it.
+      Exists,
+      Missing,
+    };
+
+    void BuildFileIndex();
+    void UpdateFileIndex();
+    void AddToFileIndex(const char* szFile);
+    void RemoveFromFileIndex(const char* szFile);
+    FileIndexResult LookupFileIndex(const char* szFile);
+    void AddToMissingFiles(const char* szFile);
+    void FileSystemEventHandler(const ezFileSystem::FileEvent& e);
+
     mutable ezMutex m_ReaderWriterMutex; ///< Locks m_Readers / m_Writers as well as the m_bIsInUse flag of each reader / writer.
     ezHybridArray<ezDataDirectory::FolderReader*, 4> m_Readers;
     ezHybridArray<ezDataDirectory::FolderWriter*, 4> m_Writers;
@@ -68,6 +108,13 @@ namespace ezDataDirectory
     mutable ezMutex m_RedirectionMutex;
     ezMap<ezString, ezString> m_FileRedirection;
     ezString128 m_sRedirectedDataDirPath;
+
+    mutable ezMutex m_FileIndexMutex;
+    ezHashSet<ezString> m_FileIndex; ///< Clean relative paths of all files, lower case on platforms with case insensitive paths.
+    ezUniquePtr<ezDirectoryWatcher> m_pFileIndexWatcher;
+    bool m_bCacheMissingFiles = false;
+    ezHashSet<ezString> m_MissingFiles; ///< Keys of files that were looked up, but don't exist. Only used without a file index.
+    ezEventSubscriptionID m_FileEventSubscription = 0;
   };
 
 
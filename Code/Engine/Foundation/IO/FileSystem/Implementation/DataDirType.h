@@ -36,6 +36,23 @@ public:
   ///        reloading and reapplying of configurations, without dismounting and remounting the data directory.
   virtual void ReloadExternalConfigs(){};
 
+  /// \brief Counts how file lookups in this data directory were answered.
+  ///
+  /// Data directory types that can answer lookups from memory (e.g. from an archive's table of contents or from a file index) report
+  /// them as found or not found. Lookups that have to ask the OS are reported as uncached.
+  struct LookupStats
+  {
+    ezUInt64 m_uiFound = 0;    ///< The file was found in a lookup table.
+    ezUInt64 m_uiNotFound = 0; ///< The lookup table showed that the file does not exist, without asking the OS.
+    ezUInt64 m_uiUncached = 0; ///< No lookup table was available for the file, the OS had to be asked.
+  };
+
+  /// \brief Returns how many file lookups were answered from memory, see LookupStats.
+  const LookupStats& GetLookupStats() const { return m_LookupStats; }
+
+  /// \brief Resets all counters of GetLookupStats() to zero.
+  void ResetLookupStats() { m_LookupStats = LookupStats(); }
+
 protected:
   friend class ezFileSystem;
 
@@ -99,6 +116,9 @@ protected:
 
   /// \brief Derived classes can use 'GetDataDirectoryPath' to access this data.
   ezString128 m_sDataDirectoryPath;
+
+  /// \brief Derived classes should update these counters in their file lookups.
+  LookupStats m_LookupStats;
 };
 
 
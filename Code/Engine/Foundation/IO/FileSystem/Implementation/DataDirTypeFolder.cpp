@@ -1,9 +1,17 @@
 #include <FoundationPCH.h>
 
 #include <Foundation/Configuration/Startup.h>
+#include <Foundation/IO/DirectoryWatcher.h>
 #include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
 #include <Foundation/Logging/Log.h>
 
+// the file index needs to enumerate the folder content and to get notified about changes
+#if EZ_ENABLED(EZ_SUPPORTS_FILE_ITERATORS) && EZ_ENABLED(EZ_PLATFORM_WINDOWS_DESKTOP)
+#  define EZ_FOLDER_FILE_INDEX EZ_ON
+#else
+#  define EZ_FOLDER_FILE_INDEX EZ_OFF
+#endif
+
 // clang-format off
 EZ_BEGIN_SUBSYSTEM_DECLARATION(Foundation, FolderDataDirectory)
 
@@ -23,6 +31,45 @@ namespace ezDataDirectory
 {
   ezString FolderType::s_sRedirectionFile;
   ezString FolderType::s_sRedirectionPrefix;
+  bool FolderType::s_bUseFileIndex = false;
+
+  // when this many missing files are remembered, the cache is cleared, so that it can't grow without bounds
+  static constexpr ezUInt32 s_uiMaxMissingFiles = 16 * 1024;
+
+  static bool MakeFileIndexKey(const char* szFile, ezStringBuilder& out_sKey)
+  {
+    out_sKey = szFile;
+    out_sKey.MakeCleanPath();
+
+    // absolute paths and paths that leave the data directory are never in the index
+    if (out_sKey.IsEmpty() || ezPathUtils::IsAbsolutePath(out_sKey) || out_sKey.StartsWith(".."))
+      return false;
+
+#if EZ_ENABLED(EZ_SUPPORTS_CASE_INSENSITIVE_PATHS)
+    out_sKey.ToLower();
+#endif
+
+    return true;
+  }
+
+#if EZ_ENABLED(EZ_FOLDER_FILE_INDEX)
+  static void AddFolderToFileIndex(ezHashSet<ezString>& index, const char* szDataDirPath, const char* szFolder)
+  {
+    ezStringBuilder sFile, sKey;
+
+    ezFileSystemIterator it;
+    for (it.StartSearch(szFolder, ezFileSystemIteratorFlags::ReportFilesRecursive); it.IsValid(); it.Next())
+    {
+      sFile = it.GetCurrentPath();
+      sFile.AppendPath(it.GetStats().m_sName);
+
+      if (sFile.MakeRelativeTo(szDataDirPath).Succeeded() && MakeFileIndexKey(sFile, sKey))
+      {
+        index.Insert(sKey);
+      }
+    }
+  }
+#endif
 
   ezResult FolderReader::InternalOpen(ezFileShareMode::Enum FileShareMode)
   {
@@ -87,10 +134,21 @@ namespace ezDataDirectory
     sPath.AppendPath(szFile);
 
     ezOSFile::DeleteFile(sPath.GetData()).IgnoreResult();
+
+    EZ_LOCK(m_FileIndexMutex);
+    RemoveFromFileIndex(szFile);
   }
 
+  // defined here, because the file index watcher is only forward declared in the header
+  FolderType::FolderType() = default;
+
   FolderType::~FolderType()
   {
+    if (m_FileEventSubscription != 0)
+    {
+      ezFileSystem::UnregisterEventHandler(m_FileEventSubscription);
+    }
+
     EZ_LOCK(m_ReaderWriterMutex);
     for (ezUInt32 i = 0; i < m_Readers.GetCount(); ++i)
       EZ_DEFAULT_DELETE(m_Readers[i]);
@@ -99,7 +157,15 @@ namespace ezDataDirectory
       EZ_DEFAULT_DELETE(m_Writers[i]);
   }
 
-  void FolderType::ReloadExternalConfigs() { LoadRedirectionFile(); }
+  void FolderType::ReloadExternalConfigs()
+  {
+    LoadRedirectionFile();
+
+    if (HasFileIndex() || HasMissingFileCache())
+    {
+      BuildFileIndex();
+    }
+  }
 
   void FolderType::LoadRedirectionFile()
   {
@@ -164,9 +230,24 @@ namespace ezDataDirectory
     ezStringBuilder sRedirectedAsset;
     ResolveAssetRedirection(szFile, sRedirectedAsset);
 
+    switch (LookupFileIndex(sRedirectedAsset))
+    {
+      case FileIndexResult::Exists:
+        return true;
+      case FileIndexResult::Missing:
+        return false;
+      case FileIndexResult::Unknown:
+        break;
+    }
+
     ezStringBuilder sPath = GetRedirectedDataDirectoryPath();
     sPath.AppendPath(sRedirectedAsset);
-    return ezOSFile::ExistsFile(sPath);
+
+    if (ezOSFile::ExistsFile(sPath))
+      return true;
+
+    AddToMissingFiles(sRedirectedAsset);
+    return false;
   }
 
   ezResult FolderType::GetFileStats(const char* szFileOrFolder, bool bOneSpecificDataDir, ezFileStats& out_Stats)
@@ -213,6 +294,14 @@ namespace ezDataDirectory
 
     ReloadExternalConfigs();
 
+    if (s_bUseFileIndex)
+    {
+      BuildFileIndex();
+
+      // files may also be written through other data directories that point to the same folder
+      m_FileEventSubscription = ezFileSystem::RegisterEventHandler(ezMakeDelegate(&FolderType::FileSystemEventHandler, this));
+    }
+
     return EZ_SUCCESS;
   }
 
@@ -244,6 +333,9 @@ namespace ezDataDirectory
     if (ezConversionUtils::IsStringUuid(sFileToOpen))
       return nullptr;
 
+    if (LookupFileIndex(sFileToOpen) == FileIndexResult::Missing)
+      return nullptr;
+
     FolderReader* pReader = nullptr;
     {
       EZ_LOCK(m_ReaderWriterMutex);
@@ -264,8 +356,23 @@ namespace ezDataDirectory
     // if opening the file fails, the reader's m_bIsInUse needs to be reset.
     if (pReader->Open(sFileToOpen, this, FileShareMode) == EZ_FAILURE)
     {
-      EZ_LOCK(m_ReaderWriterMutex);
-      pReader->m_bIsInUse = false;
+      {
+        EZ_LOCK(m_ReaderWriterMutex);
+        pReader->m_bIsInUse = false;
+      }
+
+      // opening may also fail for existing files, e.g. due to sharing violations, so only remember files that are really missing
+      if (HasMissingFileCache())
+      {
+        ezStringBuilder sPath = GetRedirectedDataDirectoryPath();
+        sPath.AppendPath(sFileToOpen);
+
+        if (!ezOSFile::ExistsFile(sPath))
+        {
+          AddToMissingFiles(sFileToOpen);
+        }
+      }
+
       return nullptr;
     }
 
@@ -329,9 +436,206 @@ namespace ezDataDirectory
       return nullptr;
     }
 
+    {
+      EZ_LOCK(m_FileIndexMutex);
+      AddToFileIndex(szFile);
+    }
+
     // if it succeeds, we return the reader
     return pWriter;
   }
+
+  void FolderType::BuildFileIndex()
+  {
+    EZ_LOCK(m_FileIndexMutex);
+
+    m_FileIndex.Clear();
+    m_MissingFiles.Clear();
+    m_pFileIndexWatcher.Clear();
+    m_bCacheMissingFiles = false;
+
+    if (m_sRedirectedDataDirPath.IsEmpty())
+      return;
+
+#if EZ_ENABLED(EZ_FOLDER_FILE_INDEX)
+    // start watching before enumerating the files, so that no change in between is missed
+    ezUniquePtr<ezDirectoryWatcher> pWatcher = EZ_DEFAULT_NEW(ezDirectoryWatcher);
+    if (pWatcher->OpenDirectory(m_sRedirectedDataDirPath.GetData(), ezDirectoryWatcher::Watch::Creates | ezDirectoryWatcher::Watch::Renames | ezDirectoryWatcher::Watch::Subdirectories).Succeeded())
+    {
+      AddFolderToFileIndex(m_FileIndex, m_sRedirectedDataDirPath, m_sRedirectedDataDirPath);
+      m_pFileIndexWatcher = std::move(pWatcher);
+      return;
+    }
+
+    ezLog::Warning("Could not watch data directory '{0}', only missing files will be cached.", m_sRedirectedDataDirPath.GetData());
+#endif
+
+    // without a complete index, at least remember which files are known to be missing
+    m_bCacheMissingFiles = true;
+  }
+
+  void FolderType::UpdateFileIndex()
+  {
+    if (m_pFileIndexWatcher == nullptr)
+      return;
+
+    m_pFileIndexWatcher->EnumerateChanges([this](const char* szFile, ezDirectoryWatcherAction action) {
+      switch (action)
+      {
+        case ezDirectoryWatcherAction::Added:
+        case ezDirectoryWatcherAction::RenamedNewName:
+          AddToFileIndex(szFile);
+          break;
+
+        case ezDirectoryWatcherAction::Removed:
+        case ezDirectoryWatcherAction::RenamedOldName:
+          RemoveFromFileIndex(szFile);
+          break;
+
+        default:
+          break;
+      }
+    });
+  }
+
+  void FolderType::AddToFileIndex(const char* szFile)
+  {
+    if (m_pFileIndexWatcher == nullptr && !m_bCacheMissingFiles)
+      return;
+
+    ezStringBuilder sKey;
+    if (!MakeFileIndexKey(szFile, sKey))
+      return;
+
+    if (m_bCacheMissingFiles)
+    {
+      m_MissingFiles.Remove(sKey);
+      return;
+    }
+
+#if EZ_ENABLED(EZ_FOLDER_FILE_INDEX)
+    ezStringBuilder sPath = m_sRedirectedDataDirPath;
+    sPath.AppendPath(szFile);
+
+    // for new or renamed folders only the folder itself is reported, not the files inside it
+    if (ezOSFile::ExistsDirectory(sPath))
+    {
+      AddFolderToFileIndex(m_FileIndex, m_sRedirectedDataDirPath, sPath);
+      return;
+    }
+#endif
+
+    m_FileIndex.Insert(sKey);
+  }
+
+  void FolderType::RemoveFromFileIndex(const char* szFile)
+  {
+    if (m_pFileIndexWatcher == nullptr)
+      return;
+
+    ezStringBuilder sKey;
+    if (!MakeFileIndexKey(szFile, sKey))
+      return;
+
+    if (m_FileIndex.Remove(sKey))
+      return;
+
+    // not a known file, so it may have been a folder, remove everything that was inside it
+    sKey.Append("/");
+
+    for (auto it = m_FileIndex.GetIterator(); it.IsValid();)
+    {
+      if (it.Key().StartsWith(sKey))
+        it = m_FileIndex.Remove(it);
+      else
+        it.Next();
+    }
+  }
+
+  FolderType::FileIndexResult FolderType::LookupFileIndex(const char* szFile)
+  {
+    EZ_LOCK(m_FileIndexMutex);
+
+    ezStringBuilder sKey;
+    if ((m_pFileIndexWatcher == nullptr && !m_bCacheMissingFiles) || !MakeFileIndexKey(szFile, sKey))
+    {
+      ++m_LookupStats.m_uiUncached;
+      return FileIndexResult::Unknown;
+    }
+
+    if (m_bCacheMissingFiles)
+    {
+      if (m_MissingFiles.Contains(sKey))
+      {
+        ++m_LookupStats.m_uiNotFound;
+        return FileIndexResult::Missing;
+      }
+
+      // the caller has to ask the OS and reports missing files through AddToMissingFiles()
+      ++m_LookupStats.m_uiUncached;
+      return FileIndexResult::Unknown;
+    }
+
+    UpdateFileIndex();
+
+    if (m_FileIndex.Contains(sKey))
+    {
+      ++m_LookupStats.m_uiFound;
+      return FileIndexResult::Exists;
+    }
+
+    ++m_LookupStats.m_uiNotFound;
+    return FileIndexResult::Missing;
+  }
+
+  void FolderType::AddToMissingFiles(const char* szFile)
+  {
+    // BuildFileIndex() may switch the mode concurrently, so the flag is only valid while the index is locked
+    EZ_LOCK(m_FileIndexMutex);
+
+    if (!m_bCacheMissingFiles)
+      return;
+
+    ezStringBuilder sKey;
+    if (!MakeFileIndexKey(szFile, sKey))
+      return;
+
+    if (m_MissingFiles.GetCount() >= s_uiMaxMissingFiles)
+    {
+      m_MissingFiles.Clear();
+    }
+
+    m_MissingFiles.Insert(sKey);
+  }
+
+  void FolderType::FileSystemEventHandler(const ezFileSystem::FileEvent& e)
+  {
+    // changes through this data directory are already handled in OpenFileToWrite() and DeleteFile()
+    if (e.m_pDataDir == this || e.m_pDataDir == nullptr || e.m_szFileOrDirectory == nullptr)
+      return;
+
+    if (e.m_EventType != ezFileSystem::FileEventType::CreateFileSucceeded && e.m_EventType != ezFileSystem::FileEventType::DeleteFile)
+      return;
+
+    // the same folder may be mounted multiple times, or as a parent or sub-folder of this one
+    ezStringBuilder sFile = e.m_pDataDir->GetRedirectedDataDirectoryPath();
+    sFile.AppendPath(e.m_szFileOrDirectory);
+    sFile.MakeCleanPath();
+
+    if (sFile.MakeRelativeTo(m_sRedirectedDataDirPath).Failed() || sFile.StartsWith(".."))
+      return;
+
+    EZ_LOCK(m_FileIndexMutex);
+
+    if (e.m_EventType == ezFileSystem::FileEventType::CreateFileSucceeded)
+    {
+      AddToFileIndex(sFile);
+    }
+    else
+    {
+      RemoveFromFileIndex(sFile);
+    }
+  }
 } // namespace ezDataDirectory
 
 
@@ -4,8 +4,119 @@
 
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
 
+#  include <Foundation/Logging/Log.h>
+#  include <Foundation/Memory/EndianHelper.h>
+#  include <Foundation/Threading/DelegateTask.h>
+
+#  define ZSTD_STATIC_LINKING_ONLY // ZSTD_createCDict_byReference, ZSTD_createDDict_byReference, ZSTD_initDStream_usingDDict
 #  include <zstd/zstd.h>
 
+// In multithreaded block mode every block is an independent zstd frame, preceded by a skippable frame with this layout:
+// magic, size of the skippable frame content, tag, compressed size of the block, uncompressed size of the block.
+// Skippable frames are ignored by zstd, so streams in block mode can be decompressed like any other stream.
+static constexpr ezUInt32 s_uiBlockHeaderMagic = 0x184D2A5E; // ZSTD_MAGIC_SKIPPABLE_START + 14
+static constexpr ezUInt32 s_uiBlockHeaderTag = 0x4B425A45;   // 'EZBK'
+static constexpr ezUInt32 s_uiBlockHeaderElements = 5;
+static constexpr ezUInt32 s_uiBlockHeaderSize = s_uiBlockHeaderElements * sizeof(ezUInt32);
+static constexpr ezUInt32 s_uiMaxBlockSize = 64 * 1024 * 1024; // larger blocks in a stream are treated as corrupt data
+
+static ezUInt32 GetNumZstdBlocksInFlight()
+{
+  // enough blocks to keep all worker threads busy, while the oldest block is being consumed
+  return ezMath::Clamp(ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks) * 2, 2U, 16U);
+}
+
+ezCompressedStreamZstdDictionary::ezCompressedStreamZstdDictionary() = default;
+
+ezCompressedStreamZstdDictionary::~ezCompressedStreamZstdDictionary()
+{
+  FreeZstdDicts();
+}
+
+void ezCompressedStreamZstdDictionary::SetData(ezArrayPtr<const ezUInt8> data)
+{
+  FreeZstdDicts();
+
+  m_Data = data;
+
+  if (!m_Data.IsEmpty())
+  {
+    // the digested dictionary only references the data, m_Data owns it
+    m_pZstdDDict = ZSTD_createDDict_byReference(m_Data.GetData(), m_Data.GetCount());
+    EZ_ASSERT_DEV(m_pZstdDDict != nullptr, "Creating the zstd decompression dictionary failed.");
+  }
+}
+
+const void* ezCompressedStreamZstdDictionary::GetZstdCDict(int iCompressionLevel) const
+{
+  EZ_LOCK(m_CDictMutex);
+
+  for (const CDict& cdict : m_ZstdCDicts)
+  {
+    if (cdict.m_iCompressionLevel == iCompressionLevel)
+      return cdict.m_pZstdCDict;
+  }
+
+  // digesting the dictionary is expensive, so it is only done once per compression level and not for every stream or block
+  CDict& cdict = m_ZstdCDicts.ExpandAndGetRef();
+  cdict.m_iCompressionLevel = iCompressionLevel;
+  cdict.m_pZstdCDict = ZSTD_createCDict_byReference(m_Data.GetData(), m_Data.GetCount(), iCompressionLevel);
+  EZ_ASSERT_DEV(cdict.m_pZstdCDict != nullptr, "Creating the zstd compression dictionary failed.");
+
+  return cdict.m_pZstdCDict;
+}
+
+void ezCompressedStreamZstdDictionary::FreeZstdDicts()
+{
+  if (m_pZstdDDict != nullptr)
+  {
+    ZSTD_freeDDict(reinterpret_cast<ZSTD_DDict*>(m_pZstdDDict));
+    m_pZstdDDict = nullptr;
+  }
+
+  EZ_LOCK(m_CDictMutex);
+
+  for (CDict& cdict : m_ZstdCDicts)
+  {
+    ZSTD_freeCDict(reinterpret_cast<ZSTD_CDict*>(cdict.m_pZstdCDict));
+  }
+
+  m_ZstdCDicts.Clear();
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+struct ezCompressedStreamReaderZstd::Block
+{
+  Block()
+  {
+    m_pZstdDCtx = ZSTD_createDCtx();
+    m_pTask = EZ_DEFAULT_NEW(ezDelegateTask<void>, "ezCompressedStreamReaderZstd::Block", ezMakeDelegate(&Block::Decompress, this));
+  }
+
+  ~Block() { ZSTD_freeDCtx(m_pZstdDCtx); }
+
+  void Decompress()
+  {
+    size_t res;
+
+    if (m_pZstdDDict != nullptr)
+      res = ZSTD_decompress_usingDDict(m_pZstdDCtx, m_Uncompressed.GetData(), m_Uncompressed.GetCount(), m_Compressed.GetData(), m_Compressed.GetCount(), m_pZstdDDict);
+    else
+      res = ZSTD_decompressDCtx(m_pZstdDCtx, m_Uncompressed.GetData(), m_Uncompressed.GetCount(), m_Compressed.GetData(), m_Compressed.GetCount());
+
+    m_bSuccess = !ZSTD_isError(res) && res == m_Uncompressed.GetCount();
+  }
+
+  ezDynamicArray<ezUInt8> m_Compressed;
+  ezDynamicArray<ezUInt8> m_Uncompressed;
+  ZSTD_DCtx* m_pZstdDCtx = nullptr;
+  const ZSTD_DDict* m_pZstdDDict = nullptr;
+  ezSharedPtr<ezTask> m_pTask;
+  ezTaskGroupID m_TaskGroup;
+  bool m_bSuccess = false;
+};
+
 ezCompressedStreamReaderZstd::ezCompressedStreamReaderZstd() = default;
 
 ezCompressedStreamReaderZstd::ezCompressedStreamReaderZstd(ezStreamReader* pInputStream)
@@ -15,6 +126,8 @@ ezCompressedStreamReaderZstd::ezCompressedStreamReaderZstd(ezStreamReader* pInpu
 
 ezCompressedStreamReaderZstd::~ezCompressedStreamReaderZstd()
 {
+  WaitForAllBlocks();
+
   if (m_pZstdDStream != nullptr)
   {
     ZSTD_freeDStream(reinterpret_cast<ZSTD_DStream*>(m_pZstdDStream));
@@ -22,26 +135,46 @@ ezCompressedStreamReaderZstd::~ezCompressedStreamReaderZstd()
   }
 }
 
-void ezCompressedStreamReaderZstd::SetInputStream(ezStreamReader* pInputStream)
+void ezCompressedStreamReaderZstd::SetInputStream(ezStreamReader* pInputStream, const ezCompressedStreamZstdDictionary* pDictionary /*= nullptr*/)
 {
   m_InBuffer.pos = 0;
   m_InBuffer.size = 0;
   m_bReachedEnd = false;
   m_pInputStream = pInputStream;
 
+  WaitForAllBlocks();
+  m_bCheckedForBlocks = false;
+  m_bBlockMode = false;
+  m_bNoMoreBlocks = false;
+  m_pDictionary = pDictionary;
+
   if (m_pZstdDStream == nullptr)
   {
     m_pZstdDStream = ZSTD_createDStream();
   }
 
-  ZSTD_initDStream(reinterpret_cast<ZSTD_DStream*>(m_pZstdDStream));
+  const ZSTD_DDict* pDDict = pDictionary != nullptr ? reinterpret_cast<const ZSTD_DDict*>(pDictionary->m_pZstdDDict) : nullptr;
+  ZSTD_initDStream_usingDDict(reinterpret_cast<ZSTD_DStream*>(m_pZstdDStream), pDDict);
 }
 
 ezUInt64 ezCompressedStreamReaderZstd::ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead)
 {
   EZ_ASSERT_DEV(m_pInputStream != nullptr, "No input stream has been specified");
 
-  if (uiBytesToRead == 0 || m_bReachedEnd)
+  if (uiBytesToRead == 0)
+    return 0;
+
+  if (!m_bCheckedForBlocks)
+  {
+    m_bCheckedForBlocks = true;
+    m_bBlockMode = IsBlockStream();
+  }
+
+  // in block mode the end of the compressed input is reached long before all blocks are consumed
+  if (m_bBlockMode)
+    return ReadBytesFromBlocks(pReadBuffer, uiBytesToRead);
+
+  if (m_bReachedEnd)
     return 0;
 
   // Implement the 'skip n bytes' feature with a temp cache
@@ -77,7 +210,12 @@ ezUInt64 ezCompressedStreamReaderZstd::ReadBytes(void* pReadBuffer, ezUInt64 uiB
       return outBuffer.pos;
 
     const size_t res = ZSTD_decompressStream(reinterpret_cast<ZSTD_DStream*>(m_pZstdDStream), &outBuffer, reinterpret_cast<ZSTD_inBuffer*>(&m_InBuffer));
-    EZ_ASSERT_DEV(!ZSTD_isError(res), "Decompressing the stream failed: '{0}'", ZSTD_getErrorName(res));
+    if (ZSTD_isError(res))
+    {
+      ezLog::Error("Decompressing the stream failed: '{0}'", ZSTD_getErrorName(res));
+      m_bReachedEnd = true;
+      return outBuffer.pos;
+    }
   }
 
   if (m_InBuffer.pos == m_InBuffer.size)
@@ -96,11 +234,16 @@ ezResult ezCompressedStreamReaderZstd::RefillReadCache()
   // if our input buffer is empty, we need to read more into our cache
   if (m_InBuffer.pos == m_InBuffer.size)
   {
-    ezUInt16 uiCompressedSize = 0;
-    EZ_VERIFY(m_pInputStream->ReadBytes(&uiCompressedSize, sizeof(ezUInt16)) == sizeof(ezUInt16), "Reading the compressed chunk size from the input stream failed.");
-
     m_InBuffer.pos = 0;
-    m_InBuffer.size = uiCompressedSize;
+    m_InBuffer.size = 0;
+
+    ezUInt16 uiCompressedSize = 0;
+    if (m_pInputStream->ReadBytes(&uiCompressedSize, sizeof(ezUInt16)) != sizeof(ezUInt16))
+    {
+      ezLog::Error("Reading the compressed chunk size from the input stream failed.");
+      m_bReachedEnd = true;
+      return EZ_FAILURE;
+    }
 
     if (uiCompressedSize > 0)
     {
@@ -111,8 +254,15 @@ ezResult ezCompressedStreamReaderZstd::RefillReadCache()
         m_InBuffer.src = m_CompressedCache.GetData();
       }
 
-      EZ_VERIFY(m_pInputStream->ReadBytes(m_CompressedCache.GetData(), sizeof(ezUInt8) * uiCompressedSize) == sizeof(ezUInt8) * uiCompressedSize, "Reading the compressed chunk of size {0} from the input stream failed.", uiCompressedSize);
+      if (m_pInputStream->ReadBytes(m_CompressedCache.GetData(), sizeof(ezUInt8) * uiCompressedSize) != sizeof(ezUInt8) * uiCompressedSize)
+      {
+        ezLog::Error("Reading the compressed chunk of size {0} from the input stream failed.", uiCompressedSize);
+        m_bReachedEnd = true;
+        return EZ_FAILURE;
+      }
     }
+
+    m_InBuffer.size = uiCompressedSize;
   }
 
   // if the input buffer is still empty, there was no more data to read (we reached the zero-terminator)
@@ -126,12 +276,218 @@ ezResult ezCompressedStreamReaderZstd::RefillReadCache()
   return EZ_SUCCESS;
 }
 
+ezUInt64 ezCompressedStreamReaderZstd::ReadCompressedBytes(void* pBuffer, ezUInt64 uiBytesToRead)
+{
+  ezUInt8* pDst = static_cast<ezUInt8*>(pBuffer);
+  ezUInt64 uiBytesRead = 0;
+
+  while (uiBytesRead < uiBytesToRead && !m_bReachedEnd)
+  {
+    if (RefillReadCache().Failed())
+      break;
+
+    const size_t uiToCopy = static_cast<size_t>(ezMath::Min<ezUInt64>(m_InBuffer.size - m_InBuffer.pos, uiBytesToRead - uiBytesRead));
+    ezMemoryUtils::Copy(pDst + uiBytesRead, m_CompressedCache.GetData() + m_InBuffer.pos, uiToCopy);
+
+    m_InBuffer.pos += uiToCopy;
+    uiBytesRead += uiToCopy;
+  }
+
+  return uiBytesRead;
+}
+
+bool ezCompressedStreamReaderZstd::IsBlockStream()
+{
+  if (RefillReadCache().Failed())
+    return false;
+
+  // the writer always puts the entire block header into the first chunk
+  if (m_InBuffer.size - m_InBuffer.pos < s_uiBlockHeaderSize)
+    return false;
+
+  ezUInt32 header[3];
+  ezMemoryUtils::Copy(reinterpret_cast<ezUInt8*>(header), m_CompressedCache.GetData() + m_InBuffer.pos, sizeof(header));
+  ezEndianHelper::LittleEndianToNative(header, 3);
+
+  if (header[0] != s_uiBlockHeaderMagic || header[1] != s_uiBlockHeaderSize - 2 * sizeof(ezUInt32) || header[2] != s_uiBlockHeaderTag)
+    return false;
+
+  if (m_Blocks.IsEmpty())
+  {
+    m_Blocks.SetCount(GetNumZstdBlocksInFlight());
+
+    for (auto& pBlock : m_Blocks)
+    {
+      pBlock = EZ_DEFAULT_NEW(Block);
+    }
+  }
+
+  return true;
+}
+
+void ezCompressedStreamReaderZstd::StartDecompressingBlocks()
+{
+  const ezUInt32 uiNumBlocks = m_Blocks.GetCount();
+
+  while (!m_bNoMoreBlocks && m_uiBlocksInFlight < uiNumBlocks)
+  {
+    ezUInt32 header[s_uiBlockHeaderElements];
+    const ezUInt64 uiHeaderBytes = ReadCompressedBytes(header, s_uiBlockHeaderSize);
+
+    if (uiHeaderBytes == 0)
+    {
+      // reached the zero-terminator
+      m_bNoMoreBlocks = true;
+      return;
+    }
+
+    ezEndianHelper::LittleEndianToNative(header, s_uiBlockHeaderElements);
+
+    if (uiHeaderBytes != s_uiBlockHeaderSize || header[0] != s_uiBlockHeaderMagic || header[2] != s_uiBlockHeaderTag)
+    {
+      ezLog::Error("The compressed stream contains an invalid block header.");
+      m_bNoMoreBlocks = true;
+      return;
+    }
+
+    // the sizes are read from the stream, do not allocate more than any writer could have produced
+    if (header[4] > s_uiMaxBlockSize || header[3] > ZSTD_compressBound(header[4]))
+    {
+      ezLog::Error("The compressed stream contains a block that is too large ({0} bytes).", header[4]);
+      m_bNoMoreBlocks = true;
+      return;
+    }
+
+    Block& block = *m_Blocks[(m_uiOldestBlock + m_uiBlocksInFlight) % uiNumBlocks];
+    block.m_Compressed.SetCountUninitialized(header[3]);
+    block.m_Uncompressed.SetCountUninitialized(header[4]);
+    block.m_pZstdDDict = m_pDictionary != nullptr ? reinterpret_cast<const ZSTD_DDict*>(m_pDictionary->m_pZstdDDict) : nullptr;
+
+    if (ReadCompressedBytes(block.m_Compressed.GetData(), header[3]) != header[3])
+    {
+      ezLog::Error("The compressed stream ended in the middle of a block.");
+      m_bNoMoreBlocks = true;
+      return;
+    }
+
+    block.m_TaskGroup = ezTaskSystem::StartSingleTask(block.m_pTask, ezTaskPriority::ThisFrame);
+    ++m_uiBlocksInFlight;
+  }
+}
+
+ezUInt64 ezCompressedStreamReaderZstd::ReadBytesFromBlocks(void* pReadBuffer, ezUInt64 uiBytesToRead)
+{
+  ezUInt8* pDst = static_cast<ezUInt8*>(pReadBuffer);
+  ezUInt64 uiBytesRead = 0;
+
+  StartDecompressingBlocks();
+
+  while (uiBytesRead < uiBytesToRead && m_uiBlocksInFlight > 0)
+  {
+    Block& block = *m_Blocks[m_uiOldestBlock];
+    ezTaskSystem::WaitForGroup(block.m_TaskGroup);
+
+    if (!block.m_bSuccess)
+    {
+      ezLog::Error("Decompressing a block of the zstd stream failed.");
+      WaitForAllBlocks();
+      m_bNoMoreBlocks = true;
+      break;
+    }
+
+    const ezUInt32 uiToCopy = static_cast<ezUInt32>(ezMath::Min<ezUInt64>(block.m_Uncompressed.GetCount() - m_uiBlockReadPos, uiBytesToRead - uiBytesRead));
+
+    // nullptr means the bytes are only skipped
+    if (pDst != nullptr)
+    {
+      ezMemoryUtils::Copy(pDst + uiBytesRead, block.m_Uncompressed.GetData() + m_uiBlockReadPos, uiToCopy);
+    }
+
+    m_uiBlockReadPos += uiToCopy;
+    uiBytesRead += uiToCopy;
+
+    if (m_uiBlockReadPos == block.m_Uncompressed.GetCount())
+    {
+      m_uiBlockReadPos = 0;
+      m_uiOldestBlock = (m_uiOldestBlock + 1) % m_Blocks.GetCount();
+      --m_uiBlocksInFlight;
+
+      // keep the pipeline full, this also reads the zero-terminator after the last block,
+      // so that data that comes after the compressed stream can be read properly
+      StartDecompressingBlocks();
+    }
+  }
+
+  return uiBytesRead;
+}
+
+void ezCompressedStreamReaderZstd::WaitForAllBlocks()
+{
+  for (ezUInt32 i = 0; i < m_uiBlocksInFlight; ++i)
+  {
+    ezTaskSystem::WaitForGroup(m_Blocks[(m_uiOldestBlock + i) % m_Blocks.GetCount()]->m_TaskGroup);
+  }
+
+  m_uiOldestBlock = 0;
+  m_uiBlocksInFlight = 0;
+  m_uiBlockReadPos = 0;
+}
+
 //////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////
 
+struct ezCompressedStreamWriterZstd::Block
+{
+  Block()
+  {
+    m_pZstdCCtx = ZSTD_createCCtx();
+    m_pTask = EZ_DEFAULT_NEW(ezDelegateTask<void>, "ezCompressedStreamWriterZstd::Block", ezMakeDelegate(&Block::Compress, this));
+  }
+
+  ~Block() { ZSTD_freeCCtx(m_pZstdCCtx); }
+
+  void Compress()
+  {
+    m_bSuccess = false;
+
+    const size_t uiBound = ZSTD_compressBound(m_uiUsed);
+    m_Compressed.SetCountUninitialized(s_uiBlockHeaderSize + static_cast<ezUInt32>(uiBound));
+
+    ZSTD_CCtx_reset(m_pZstdCCtx, ZSTD_reset_session_and_parameters);
+    ZSTD_CCtx_setParameter(m_pZstdCCtx, ZSTD_c_compressionLevel, m_iCompressionLevel);
+
+    if (m_pZstdCDict != nullptr)
+    {
+      if (ZSTD_isError(ZSTD_CCtx_refCDict(m_pZstdCCtx, m_pZstdCDict)))
+        return;
+    }
+
+    const size_t res = ZSTD_compress2(m_pZstdCCtx, m_Compressed.GetData() + s_uiBlockHeaderSize, uiBound, m_Uncompressed.GetData(), m_uiUsed);
+    if (ZSTD_isError(res))
+      return;
+
+    ezUInt32 header[s_uiBlockHeaderElements] = {s_uiBlockHeaderMagic, s_uiBlockHeaderSize - 2 * sizeof(ezUInt32), s_uiBlockHeaderTag, static_cast<ezUInt32>(res), m_uiUsed};
+    ezEndianHelper::NativeToLittleEndian(header, s_uiBlockHeaderElements);
+    ezMemoryUtils::Copy(m_Compressed.GetData(), reinterpret_cast<const ezUInt8*>(header), s_uiBlockHeaderSize);
+
+    m_Compressed.SetCountUninitialized(s_uiBlockHeaderSize + static_cast<ezUInt32>(res));
+    m_bSuccess = true;
+  }
+
+  ezDynamicArray<ezUInt8> m_Uncompressed;
+  ezUInt32 m_uiUsed = 0;
+  ezDynamicArray<ezUInt8> m_Compressed; // block header + zstd frame
+  ZSTD_CCtx* m_pZstdCCtx = nullptr;
+  int m_iCompressionLevel = 0;
+  const ZSTD_CDict* m_pZstdCDict = nullptr;
+  ezSharedPtr<ezTask> m_pTask;
+  ezTaskGroupID m_TaskGroup;
+  bool m_bSuccess = false;
+};
+
 ezCompressedStreamWriterZstd::ezCompressedStreamWriterZstd() = default;
 
 ezCompressedStreamWriterZstd::ezCompressedStreamWriterZstd(ezStreamWriter* pOutputStream, Compression Ratio)
@@ -151,6 +507,8 @@ ezCompressedStreamWriterZstd::~ezCompressedStreamWriterZstd()
     FinishCompressedStream().IgnoreResult();
   }
 
+  WaitForAllBlocks();
+
   if (m_pZstdCStream)
   {
     ZSTD_freeCStream(reinterpret_cast<ZSTD_CStream*>(m_pZstdCStream));
@@ -158,14 +516,23 @@ ezCompressedStreamWriterZstd::~ezCompressedStreamWriterZstd()
   }
 }
 
-void ezCompressedStreamWriterZstd::SetOutputStream(ezStreamWriter* pOutputStream, Compression Ratio /*= Compression::Default*/, ezUInt32 uiCompressionCacheSizeKB /*= 4*/)
+void ezCompressedStreamWriterZstd::SetOutputStream(ezStreamWriter* pOutputStream, Compression Ratio /*= Compression::Default*/, ezUInt32 uiCompressionCacheSizeKB /*= 4*/, const ezCompressedStreamZstdDictionary* pDictionary /*= nullptr*/)
 {
-  if (m_pOutputStream == pOutputStream)
+  if (pDictionary != nullptr && pDictionary->IsEmpty())
+  {
+    pDictionary = nullptr;
+  }
+
+  // only skip the re-initialization, if the settings would not change anything
+  if (m_pOutputStream == pOutputStream && m_iCompressionLevel == (int)Ratio && m_pDictionary == pDictionary)
     return;
 
   // finish anything done on a previous output stream
   FinishCompressedStream().IgnoreResult();
 
+  // drop blocks that could not be written to the previous stream
+  WaitForAllBlocks();
+
   m_uiUncompressedSize = 0;
   m_uiCompressedSize = 0;
   m_uiWrittenBytes = 0;
@@ -173,6 +540,8 @@ void ezCompressedStreamWriterZstd::SetOutputStream(ezStreamWriter* pOutputStream
   if (pOutputStream != nullptr)
   {
     m_pOutputStream = pOutputStream;
+    m_iCompressionLevel = (int)Ratio;
+    m_pDictionary = pDictionary;
 
     if (m_pZstdCStream == nullptr)
     {
@@ -181,6 +550,12 @@ void ezCompressedStreamWriterZstd::SetOutputStream(ezStreamWriter* pOutputStream
 
     ZSTD_initCStream(reinterpret_cast<ZSTD_CStream*>(m_pZstdCStream), (int)Ratio);
 
+    if (pDictionary != nullptr)
+    {
+      const size_t res = ZSTD_CCtx_refCDict(reinterpret_cast<ZSTD_CStream*>(m_pZstdCStream), reinterpret_cast<const ZSTD_CDict*>(pDictionary->GetZstdCDict(m_iCompressionLevel)));
+      EZ_VERIFY(!ZSTD_isError(res), "Loading the zstd compression dictionary failed: '{0}'", ZSTD_getErrorName(res));
+    }
+
     m_CompressedCache.SetCountUninitialized(ezMath::Max(1U, uiCompressionCacheSizeKB) * 1024);
 
     m_OutBuffer.dst = m_CompressedCache.GetData();
@@ -197,12 +572,16 @@ ezResult ezCompressedStreamWriterZstd::FinishCompressedStream()
   if (Flush().Failed())
     return EZ_FAILURE;
 
-  const size_t res = ZSTD_endStream(reinterpret_cast<ZSTD_CStream*>(m_pZstdCStream), reinterpret_cast<ZSTD_outBuffer*>(&m_OutBuffer));
-  EZ_VERIFY(!ZSTD_isError(res), "Deinitializing the zstd compression stream failed: '{0}'", ZSTD_getErrorName(res));
+  // in block mode, Flush() already wrote all blocks as complete frames
+  if (m_uiBlockSize == 0)
+  {
+    const size_t res = ZSTD_endStream(reinterpret_cast<ZSTD_CStream*>(m_pZstdCStream), reinterpret_cast<ZSTD_outBuffer*>(&m_OutBuffer));
+    EZ_VERIFY(!ZSTD_isError(res), "Deinitializing the zstd compression stream failed: '{0}'", ZSTD_getErrorName(res));
 
-  // one more flush to write out the last chunk
-  if (FlushWriteCache() == EZ_FAILURE)
-    return EZ_FAILURE;
+    // one more flush to write out the last chunk
+    if (FlushWriteCache() == EZ_FAILURE)
+      return EZ_FAILURE;
+  }
 
   // write a zero-terminator
   const ezUInt16 uiTerminator = 0;
@@ -220,6 +599,22 @@ ezResult ezCompressedStreamWriterZstd::Flush()
   if (m_pOutputStream == nullptr)
     return EZ_SUCCESS;
 
+  if (m_uiBlockSize > 0)
+  {
+    // compress the partially filled block as well and write out everything in order
+    if (m_Blocks[(m_uiOldestBlock + m_uiBlocksInFlight) % m_Blocks.GetCount()]->m_uiUsed > 0)
+    {
+      StartCompressingBlock();
+    }
+
+    while (m_uiBlocksInFlight > 0)
+    {
+      EZ_SUCCEED_OR_RETURN(WriteOldestBlock());
+    }
+
+    return EZ_SUCCESS;
+  }
+
   while (ZSTD_flushStream(reinterpret_cast<ZSTD_CStream*>(m_pZstdCStream), reinterpret_cast<ZSTD_outBuffer*>(&m_OutBuffer)) > 0)
   {
     if (FlushWriteCache() == EZ_FAILURE)
@@ -263,6 +658,41 @@ ezResult ezCompressedStreamWriterZstd::WriteBytes(const void* pWriteBuffer, ezUI
 
   m_uiUncompressedSize += static_cast<ezUInt32>(uiBytesToWrite);
 
+  if (m_uiBlockSize > 0)
+  {
+    const ezUInt8* pSrc = static_cast<const ezUInt8*>(pWriteBuffer);
+
+    while (uiBytesToWrite > 0)
+    {
+      Block& block = *m_Blocks[(m_uiOldestBlock + m_uiBlocksInFlight) % m_Blocks.GetCount()];
+
+      if (block.m_Uncompressed.GetCount() != m_uiBlockSize)
+      {
+        block.m_Uncompressed.SetCountUninitialized(m_uiBlockSize);
+      }
+
+      const ezUInt32 uiToCopy = static_cast<ezUInt32>(ezMath::Min<ezUInt64>(m_uiBlockSize - block.m_uiUsed, uiBytesToWrite));
+      ezMemoryUtils::Copy(block.m_Uncompressed.GetData() + block.m_uiUsed, pSrc, uiToCopy);
+
+      block.m_uiUsed += uiToCopy;
+      pSrc += uiToCopy;
+      uiBytesToWrite -= uiToCopy;
+
+      if (block.m_uiUsed == m_uiBlockSize)
+      {
+        StartCompressingBlock();
+
+        // the next block to fill must not be in flight anymore
+        if (m_uiBlocksInFlight == m_Blocks.GetCount())
+        {
+          EZ_SUCCEED_OR_RETURN(WriteOldestBlock());
+        }
+      }
+    }
+
+    return EZ_SUCCESS;
+  }
+
   ZSTD_inBuffer inBuffer;
   inBuffer.pos = 0;
   inBuffer.src = pWriteBuffer;
@@ -284,6 +714,88 @@ ezResult ezCompressedStreamWriterZstd::WriteBytes(const void* pWriteBuffer, ezUI
   return EZ_SUCCESS;
 }
 
+void ezCompressedStreamWriterZstd::SetMultithreadedBlockSize(ezUInt32 uiBlockSizeKB /*= 1024*/)
+{
+  EZ_ASSERT_DEV(m_uiUncompressedSize == 0, "The block size has to be set before writing any data to the stream.");
+  EZ_ASSERT_DEV(uiBlockSizeKB * 1024 <= s_uiMaxBlockSize, "The block size must not be larger than {0} KB.", s_uiMaxBlockSize / 1024);
+
+  m_uiBlockSize = uiBlockSizeKB * 1024;
+
+  if (m_uiBlockSize > 0 && m_Blocks.IsEmpty())
+  {
+    // one additional block that is filled while the others are in flight
+    m_Blocks.SetCount(GetNumZstdBlocksInFlight() + 1);
+
+    for (auto& pBlock : m_Blocks)
+    {
+      pBlock = EZ_DEFAULT_NEW(Block);
+    }
+  }
+}
+
+void ezCompressedStreamWriterZstd::StartCompressingBlock()
+{
+  Block& block = *m_Blocks[(m_uiOldestBlock + m_uiBlocksInFlight) % m_Blocks.GetCount()];
+  block.m_iCompressionLevel = m_iCompressionLevel;
+  block.m_pZstdCDict = m_pDictionary != nullptr ? reinterpret_cast<const ZSTD_CDict*>(m_pDictionary->GetZstdCDict(m_iCompressionLevel)) : nullptr;
+  block.m_TaskGroup = ezTaskSystem::StartSingleTask(block.m_pTask, ezTaskPriority::ThisFrame);
+
+  ++m_uiBlocksInFlight;
+}
+
+ezResult ezCompressedStreamWriterZstd::WriteOldestBlock()
+{
+  Block& block = *m_Blocks[m_uiOldestBlock];
+  ezTaskSystem::WaitForGroup(block.m_TaskGroup);
+
+  block.m_uiUsed = 0;
+  m_uiOldestBlock = (m_uiOldestBlock + 1) % m_Blocks.GetCount();
+  --m_uiBlocksInFlight;
+
+  if (!block.m_bSuccess)
+    return EZ_FAILURE;
+
+  m_uiCompressedSize += block.m_Compressed.GetCount();
+  return WriteChunks(block.m_Compressed.GetData(), block.m_Compressed.GetCount());
+}
+
+ezResult ezCompressedStreamWriterZstd::WriteChunks(const ezUInt8* pData, ezUInt32 uiSize)
+{
+  // use the same chunk format as FlushWriteCache(), so that the data can also be read without knowing about blocks
+  while (uiSize > 0)
+  {
+    const ezUInt16 uiChunkSize = static_cast<ezUInt16>(ezMath::Min<ezUInt32>(uiSize, 0xFFFF));
+
+    if (m_pOutputStream->WriteBytes(&uiChunkSize, sizeof(ezUInt16)) == EZ_FAILURE)
+      return EZ_FAILURE;
+
+    if (m_pOutputStream->WriteBytes(pData, sizeof(ezUInt8) * uiChunkSize) == EZ_FAILURE)
+      return EZ_FAILURE;
+
+    m_uiWrittenBytes += sizeof(ezUInt16) + uiChunkSize;
+    pData += uiChunkSize;
+    uiSize -= uiChunkSize;
+  }
+
+  return EZ_SUCCESS;
+}
+
+void ezCompressedStreamWriterZstd::WaitForAllBlocks()
+{
+  for (ezUInt32 i = 0; i < m_uiBlocksInFlight; ++i)
+  {
+    ezTaskSystem::WaitForGroup(m_Blocks[(m_uiOldestBlock + i) % m_Blocks.GetCount()]->m_TaskGroup);
+  }
+
+  for (auto& pBlock : m_Blocks)
+  {
+    pBlock->m_uiUsed = 0;
+  }
+
+  m_uiOldestBlock = 0;
+  m_uiBlocksInFlight = 0;
+}
+
 #endif
 
 
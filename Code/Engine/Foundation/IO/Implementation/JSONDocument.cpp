@@ -0,0 +1,801 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/IO/JSONDocument.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Strings/UnicodeUtils.h>
+#include <Foundation/Utilities/ConversionUtils.h>
+
+namespace
+{
+  enum CharClass : ezUInt8
+  {
+    Scalar,     ///< Part of a number or a literal (or an invalid character)
+    Whitespace,
+    Structural, ///< One of {}[]:,
+    Quote,
+    Slash, ///< Potential start of a comment
+  };
+
+  struct CharClassTable
+  {
+    CharClassTable()
+    {
+      for (ezUInt32 i = 0; i < 256; ++i)
+        m_Class[i] = Scalar;
+
+      m_Class[(ezUInt8)' '] = Whitespace;
+      m_Class[(ezUInt8)'\t'] = Whitespace;
+      m_Class[(ezUInt8)'\n'] = Whitespace;
+      m_Class[(ezUInt8)'\r'] = Whitespace;
+
+      m_Class[(ezUInt8)'{'] = Structural;
+      m_Class[(ezUInt8)'}'] = Structural;
+      m_Class[(ezUInt8)'['] = Structural;
+      m_Class[(ezUInt8)']'] = Structural;
+      m_Class[(ezUInt8)':'] = Structural;
+      m_Class[(ezUInt8)','] = Structural;
+
+      m_Class[(ezUInt8)'\"'] = Quote;
+      m_Class[(ezUInt8)'/'] = Slash;
+    }
+
+    ezUInt8 m_Class[256];
+  };
+
+  static const CharClassTable s_CharClasses;
+
+  static constexpr ezUInt32 s_uiMaxNestingDepth = 512;
+
+  EZ_ALWAYS_INLINE bool IsNumberCharacter(char c)
+  {
+    return (c >= '0' && c <= '9') || c == '.' || c == 'e' || c == 'E' || c == '-' || c == '+';
+  }
+
+  static bool ReadHex4(const char* pText, const char* pEnd, ezUInt32& out_uiValue)
+  {
+    if (pEnd - pText < 4)
+      return false;
+
+    out_uiValue = 0;
+
+    for (ezUInt32 i = 0; i < 4; ++i)
+    {
+      const char c = pText[i];
+      ezUInt32 uiDigit;
+
+      if (c >= '0' && c <= '9')
+        uiDigit = c - '0';
+      else if (c >= 'a' && c <= 'f')
+        uiDigit = c - 'a' + 10;
+      else if (c >= 'A' && c <= 'F')
+        uiDigit = c - 'A' + 10;
+      else
+        return false;
+
+      out_uiValue = (out_uiValue << 4) | uiDigit;
+    }
+
+    return true;
+  }
+} // namespace
+
+/// \brief Walks the structural index of a JSON document and reports all values to the handler.
+///
+/// The handler is a template parameter, so that building the DOM does not need any virtual function calls.
+template <typename Handler>
+class ezJSONStructureWalker
+{
+public:
+  ezJSONStructureWalker(char* pText, ezUInt32 uiLength, ezArrayPtr<const ezUInt32> structure, Handler& handler)
+    : m_pText(pText)
+    , m_pTextEnd(pText + uiLength)
+    , m_Structure(structure)
+    , m_Handler(handler)
+  {
+  }
+
+  ezResult Walk()
+  {
+    // an empty document is valid
+    if (m_Structure.IsEmpty())
+      return EZ_SUCCESS;
+
+    EZ_SUCCEED_OR_RETURN(ParseValue(ezStringView(), 0));
+
+    if (m_uiCurrent != m_Structure.GetCount())
+      return Error("Unexpected content after the end of the document.");
+
+    return EZ_SUCCESS;
+  }
+
+  ezUInt32 GetErrorPosition() const { return m_uiErrorPosition; }
+  const char* GetErrorMessage() const { return m_szErrorMessage; }
+
+private:
+  char Peek() const { return m_uiCurrent < m_Structure.GetCount() ? m_pText[m_Structure[m_uiCurrent]] : '\0'; }
+
+  ezResult Error(const char* szMessage)
+  {
+    m_szErrorMessage = szMessage;
+    m_uiErrorPosition = m_uiCurrent < m_Structure.GetCount() ? m_Structure[m_uiCurrent] : static_cast<ezUInt32>(m_pTextEnd - m_pText);
+    return EZ_FAILURE;
+  }
+
+  ezResult ParseValue(const ezStringView& sName, ezUInt32 uiDepth)
+  {
+    if (m_uiCurrent >= m_Structure.GetCount())
+      return Error("Expected a value, but reached the end of the document.");
+
+    if (uiDepth > s_uiMaxNestingDepth)
+      return Error("The document is nested too deeply.");
+
+    char* pValue = m_pText + m_Structure[m_uiCurrent];
+
+    switch (*pValue)
+    {
+      case '{':
+        ++m_uiCurrent;
+        return ParseObject(sName, uiDepth);
+
+      case '[':
+        ++m_uiCurrent;
+        return ParseArray(sName, uiDepth);
+
+      case '\"':
+      {
+        ezStringView sValue;
+        EZ_SUCCEED_OR_RETURN(ReadString(pValue, sValue));
+        ++m_uiCurrent;
+        m_Handler.OnString(sName, sValue);
+        return EZ_SUCCESS;
+      }
+
+      case 't':
+        EZ_SUCCEED_OR_RETURN(ReadLiteral(pValue, "true"));
+        ++m_uiCurrent;
+        m_Handler.OnBool(sName, true);
+        return EZ_SUCCESS;
+
+      case 'f':
+        EZ_SUCCEED_OR_RETURN(ReadLiteral(pValue, "false"));
+        ++m_uiCurrent;
+        m_Handler.OnBool(sName, false);
+        return EZ_SUCCESS;
+
+      case 'n':
+        EZ_SUCCEED_OR_RETURN(ReadLiteral(pValue, "null"));
+        ++m_uiCurrent;
+        m_Handler.OnNull(sName);
+        return EZ_SUCCESS;
+
+      default:
+      {
+        if (!IsNumberCharacter(*pValue))
+          return Error("Expected a value.");
+
+        double fValue = 0.0;
+        EZ_SUCCEED_OR_RETURN(ReadNumber(pValue, fValue));
+        ++m_uiCurrent;
+        m_Handler.OnNumber(sName, fValue);
+        return EZ_SUCCESS;
+      }
+    }
+  }
+
+  ezResult ParseObject(const ezStringView& sName, ezUInt32 uiDepth)
+  {
+    m_Handler.OnBeginObject(sName);
+
+    ezUInt32 uiNumMembers = 0;
+
+    if (Peek() == '}')
+    {
+      ++m_uiCurrent;
+      m_Handler.OnEndObject(uiNumMembers);
+      return EZ_SUCCESS;
+    }
+
+    while (true)
+    {
+      if (Peek() != '\"')
+        return Error("Expected a member name.");
+
+      ezStringView sMemberName;
+      EZ_SUCCEED_OR_RETURN(ReadString(m_pText + m_Structure[m_uiCurrent], sMemberName));
+      ++m_uiCurrent;
+
+      if (Peek() != ':')
+        return Error("Expected ':' to separate the member name and value.");
+
+      ++m_uiCurrent;
+
+      EZ_SUCCEED_OR_RETURN(ParseValue(sMemberName, uiDepth + 1));
+      ++uiNumMembers;
+
+      const char c = Peek();
+
+      if (c == '}')
+        break;
+
+      if (c != ',')
+        return Error("Expected ',' or '}' after an object member.");
+
+      ++m_uiCurrent;
+    }
+
+    ++m_uiCurrent;
+    m_Handler.OnEndObject(uiNumMembers);
+    return EZ_SUCCESS;
+  }
+
+  ezResult ParseArray(const ezStringView& sName, ezUInt32 uiDepth)
+  {
+    m_Handler.OnBeginArray(sName);
+
+    ezUInt32 uiNumElements = 0;
+
+    if (Peek() == ']')
+    {
+      ++m_uiCurrent;
+      m_Handler.OnEndArray(uiNumElements);
+      return EZ_SUCCESS;
+    }
+
+    while (true)
+    {
+      EZ_SUCCEED_OR_RETURN(ParseValue(ezStringView(), uiDepth + 1));
+      ++uiNumElements;
+
+      const char c = Peek();
+
+      if (c == ']')
+        break;
+
+      if (c != ',')
+        return Error("Expected ',' or ']' after an array element.");
+
+      ++m_uiCurrent;
+    }
+
+    ++m_uiCurrent;
+    m_Handler.OnEndArray(uiNumElements);
+    return EZ_SUCCESS;
+  }
+
+  bool IsEndOfScalar(const char* pPos) const { return pPos == m_pTextEnd || s_CharClasses.m_Class[(ezUInt8)*pPos] != Scalar; }
+
+  ezResult ReadLiteral(const char* pValue, const char* szLiteral)
+  {
+    const ezUInt32 uiLength = ezStringUtils::GetStringElementCount(szLiteral);
+
+    if (static_cast<ezUInt32>(m_pTextEnd - pValue) < uiLength || !ezStringUtils::IsEqualN(pValue, szLiteral, uiLength, pValue + uiLength) ||
+        !IsEndOfScalar(pValue + uiLength))
+      return Error("Expected 'true', 'false' or 'null'.");
+
+    return EZ_SUCCESS;
+  }
+
+  ezResult ReadNumber(const char* pValue, double& out_fValue)
+  {
+    const char* pEnd = pValue;
+    while (pEnd < m_pTextEnd && IsNumberCharacter(*pEnd))
+      ++pEnd;
+
+    char szNumber[64];
+    const ezUInt32 uiLength = static_cast<ezUInt32>(pEnd - pValue);
+
+    if (uiLength >= EZ_ARRAY_SIZE(szNumber) || !IsEndOfScalar(pEnd))
+      return Error("Invalid number.");
+
+    ezMemoryUtils::Copy(szNumber, pValue, uiLength);
+    szNumber[uiLength] = '\0';
+
+    const char* szParseEnd = nullptr;
+    if (ezConversionUtils::StringToFloat(szNumber, out_fValue, &szParseEnd).Failed() || *szParseEnd != '\0')
+      return Error("Invalid number.");
+
+    return EZ_SUCCESS;
+  }
+
+  /// \brief Unescapes the string in place and zero-terminates it. The terminator at most overwrites the closing quote.
+  ezResult ReadString(char* pQuote, ezStringView& out_sValue)
+  {
+    char* pStart = pQuote + 1;
+    char* pRead = pStart;
+
+    // most strings don't contain escape sequences, those don't need to be moved
+    while (*pRead != '\"' && *pRead != '\\')
+      ++pRead;
+
+    char* pWrite = pRead;
+
+    while (*pRead != '\"')
+    {
+      if (*pRead != '\\')
+      {
+        *pWrite++ = *pRead++;
+        continue;
+      }
+
+      ++pRead;
+
+      switch (*pRead)
+      {
+        case '\"':
+        case '\\':
+        case '/':
+          *pWrite++ = *pRead;
+          break;
+        case 'b':
+          *pWrite++ = '\b';
+          break;
+        case 'f':
+          *pWrite++ = '\f';
+          break;
+        case 'n':
+          *pWrite++ = '\n';
+          break;
+        case 'r':
+          *pWrite++ = '\r';
+          break;
+        case 't':
+          *pWrite++ = '\t';
+          break;
+
+        case 'u':
+        {
+          ezUInt32 uiCodePoint = 0;
+          if (!ReadHex4(pRead + 1, m_pTextEnd, uiCodePoint))
+            return Error("Unicode literal must consist of 4 hex characters.");
+
+          pRead += 4;
+
+          if (uiCodePoint >= 0xD800 && uiCodePoint <= 0xDBFF)
+          {
+            ezUInt32 uiLowSurrogate = 0;
+            if (m_pTextEnd - pRead < 3 || pRead[1] != '\\' || pRead[2] != 'u' || !ReadHex4(pRead + 3, m_pTextEnd, uiLowSurrogate) ||
+                uiLowSurrogate < 0xDC00 || uiLowSurrogate > 0xDFFF)
+              return Error("Unicode surrogate must be followed by another unicode escape sequence.");
+
+            pRead += 6;
+            uiCodePoint = 0x10000 + ((uiCodePoint - 0xD800) << 10) + (uiLowSurrogate - 0xDC00);
+          }
+
+          // the UTF-8 encoding is never longer than the escape sequence
+          ezUnicodeUtils::EncodeUtf32ToUtf8(uiCodePoint, pWrite);
+        }
+        break;
+
+        default:
+          return Error("Unknown escape sequence.");
+      }
+
+      ++pRead;
+    }
+
+    *pWrite = '\0';
+    out_sValue = ezStringView(pStart, pWrite);
+    return EZ_SUCCESS;
+  }
+
+  char* m_pText = nullptr;
+  const char* m_pTextEnd = nullptr;
+  ezArrayPtr<const ezUInt32> m_Structure;
+  Handler& m_Handler;
+
+  ezUInt32 m_uiCurrent = 0;
+  ezUInt32 m_uiErrorPosition = 0;
+  const char* m_szErrorMessage = nullptr;
+};
+
+/// \brief Stores all values in the node array of an ezJSONDocument.
+class ezJSONDomBuilder
+{
+public:
+  ezJSONDomBuilder(ezDynamicArray<ezJSONDocument::Node>& nodes)
+    : m_Nodes(nodes)
+  {
+  }
+
+  void OnBeginObject(const ezStringView& sName) { m_OpenContainers.PushBack(AddNode(sName, ezJSONDocument::Type::Object)); }
+  void OnEndObject(ezUInt32 uiNumMembers) { CloseContainer(uiNumMembers); }
+  void OnBeginArray(const ezStringView& sName) { m_OpenContainers.PushBack(AddNode(sName, ezJSONDocument::Type::Array)); }
+  void OnEndArray(ezUInt32 uiNumElements) { CloseContainer(uiNumElements); }
+  void OnString(const ezStringView& sName, const ezStringView& sValue) { m_Nodes[AddNode(sName, ezJSONDocument::Type::String)].m_sString = sValue; }
+  void OnNumber(const ezStringView& sName, double fValue) { m_Nodes[AddNode(sName, ezJSONDocument::Type::Number)].m_fNumber = fValue; }
+  void OnBool(const ezStringView& sName, bool bValue) { m_Nodes[AddNode(sName, ezJSONDocument::Type::Bool)].m_fNumber = bValue ? 1.0 : 0.0; }
+  void OnNull(const ezStringView& sName) { AddNode(sName, ezJSONDocument::Type::Null); }
+
+private:
+  ezUInt32 AddNode(const ezStringView& sName, ezJSONDocument::Type type)
+  {
+    const ezUInt32 uiIndex = m_Nodes.GetCount();
+
+    ezJSONDocument::Node& node = m_Nodes.ExpandAndGetRef();
+    node.m_sName = sName;
+    node.m_sString = ezStringView();
+    node.m_fNumber = 0.0;
+    node.m_uiNumChildren = 0;
+    node.m_uiEndIndex = uiIndex + 1;
+    node.m_uiParent = m_OpenContainers.IsEmpty() ? ezInvalidIndex : m_OpenContainers.PeekBack();
+    node.m_Type = type;
+
+    return uiIndex;
+  }
+
+  void CloseContainer(ezUInt32 uiNumChildren)
+  {
+    ezJSONDocument::Node& node = m_Nodes[m_OpenContainers.PeekBack()];
+    node.m_uiNumChildren = uiNumChildren;
+    node.m_uiEndIndex = m_Nodes.GetCount();
+
+    m_OpenContainers.PopBack();
+  }
+
+  ezDynamicArray<ezJSONDocument::Node>& m_Nodes;
+  ezHybridArray<ezUInt32, 32> m_OpenContainers;
+};
+
+/// \brief Forwards the document structure to an ezJSONSaxHandler.
+class ezJSONSaxForwarder
+{
+public:
+  ezJSONSaxForwarder(ezJSONSaxHandler& handler)
+    : m_Handler(handler)
+  {
+  }
+
+  void OnBeginObject(const ezStringView& sName) { m_Handler.OnBeginObject(sName); }
+  void OnEndObject(ezUInt32 uiNumMembers) { m_Handler.OnEndObject(); }
+  void OnBeginArray(const ezStringView& sName) { m_Handler.OnBeginArray(sName); }
+  void OnEndArray(ezUInt32 uiNumElements) { m_Handler.OnEndArray(); }
+  void OnString(const ezStringView& sName, const ezStringView& sValue) { m_Handler.OnString(sName, sValue); }
+  void OnNumber(const ezStringView& sName, double fValue) { m_Handler.OnNumber(sName, fValue); }
+  void OnBool(const ezStringView& sName, bool bValue) { m_Handler.OnBool(sName, bValue); }
+  void OnNull(const ezStringView& sName) { m_Handler.OnNull(sName); }
+
+private:
+  ezJSONSaxHandler& m_Handler;
+};
+
+//////////////////////////////////////////////////////////////////////////
+
+ezJSONDocument::ezJSONDocument() = default;
+ezJSONDocument::~ezJSONDocument() = default;
+
+ezResult ezJSONDocument::Parse(ezStreamReader& stream, ezUInt32 uiFirstLineOffset /*= 0*/)
+{
+  m_Text.Clear();
+
+  ezUInt8 uiTemp[1024 * 4];
+
+  while (true)
+  {
+    const ezUInt64 uiRead = stream.ReadBytes(uiTemp, EZ_ARRAY_SIZE(uiTemp));
+
+    if (uiRead == 0)
+      break;
+
+    m_Text.PushBackRange(ezArrayPtr<const char>(reinterpret_cast<const char*>(uiTemp), static_cast<ezUInt32>(uiRead)));
+  }
+
+  return ParseInSitu(m_Text, uiFirstLineOffset);
+}
+
+ezResult ezJSONDocument::ParseInSitu(ezArrayPtr<char> text, ezUInt32 uiFirstLineOffset /*= 0*/)
+{
+  m_uiFirstLineOffset = uiFirstLineOffset;
+  m_Nodes.Clear();
+
+  EZ_SUCCEED_OR_RETURN(BuildStructuralIndex(text.GetPtr(), text.GetCount()));
+
+  // every value starts at an entry in the structural index, so this is enough to never reallocate
+  m_Nodes.Reserve(m_Structure.GetCount());
+
+  ezJSONDomBuilder builder(m_Nodes);
+  ezJSONStructureWalker<ezJSONDomBuilder> walker(text.GetPtr(), text.GetCount(), m_Structure, builder);
+
+  if (walker.Walk().Failed())
+  {
+    ReportError(text.GetPtr(), text.GetCount(), walker.GetErrorPosition(), walker.GetErrorMessage());
+    m_Nodes.Clear();
+    return EZ_FAILURE;
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezJSONDocument::ParseSax(ezArrayPtr<char> text, ezJSONSaxHandler& handler, ezUInt32 uiFirstLineOffset /*= 0*/)
+{
+  m_uiFirstLineOffset = uiFirstLineOffset;
+
+  EZ_SUCCEED_OR_RETURN(BuildStructuralIndex(text.GetPtr(), text.GetCount()));
+
+  ezJSONSaxForwarder forwarder(handler);
+  ezJSONStructureWalker<ezJSONSaxForwarder> walker(text.GetPtr(), text.GetCount(), m_Structure, forwarder);
+
+  if (walker.Walk().Failed())
+  {
+    ReportError(text.GetPtr(), text.GetCount(), walker.GetErrorPosition(), walker.GetErrorMessage());
+    return EZ_FAILURE;
+  }
+
+  return EZ_SUCCESS;
+}
+
+void ezJSONDocument::Clear()
+{
+  m_Text.Clear();
+  m_Text.Compact();
+  m_Structure.Clear();
+  m_Structure.Compact();
+  m_Nodes.Clear();
+  m_Nodes.Compact();
+}
+
+ezJSONDocument::Value ezJSONDocument::GetRoot() const
+{
+  if (m_Nodes.IsEmpty())
+    return Value();
+
+  return Value(this, 0);
+}
+
+ezResult ezJSONDocument::BuildStructuralIndex(const char* pText, ezUInt32 uiLength)
+{
+  m_Structure.Clear();
+
+  ezUInt32 i = 0;
+
+  while (i < uiLength)
+  {
+    switch (s_CharClasses.m_Class[(ezUInt8)pText[i]])
+    {
+      case Whitespace:
+        ++i;
+        break;
+
+      case Structural:
+        m_Structure.PushBack(i);
+        ++i;
+        break;
+
+      case Quote:
+      {
+        const ezUInt32 uiStringStart = i;
+        m_Structure.PushBack(i);
+        ++i;
+
+        while (true)
+        {
+          while (i < uiLength && pText[i] != '\"' && pText[i] != '\\')
+            ++i;
+
+          if (i >= uiLength)
+          {
+            ReportError(pText, uiLength, uiStringStart, "Reached the end of the document before the end of a string.");
+            return EZ_FAILURE;
+          }
+
+          if (pText[i] == '\"')
+          {
+            ++i;
+            break;
+          }
+
+          // skip the backslash and the escaped character
+          i += 2;
+        }
+      }
+      break;
+
+      case Slash:
+      {
+        if (i + 1 < uiLength && pText[i + 1] == '/')
+        {
+          while (i < uiLength && pText[i] != '\n')
+            ++i;
+
+          break;
+        }
+
+        if (i + 1 < uiLength && pText[i + 1] == '*')
+        {
+          const ezUInt32 uiCommentStart = i;
+          i += 2;
+
+          while (i + 1 < uiLength && (pText[i] != '*' || pText[i + 1] != '/'))
+            ++i;
+
+          if (i + 1 >= uiLength)
+          {
+            ReportError(pText, uiLength, uiCommentStart, "Reached the end of the document before the end of a comment.");
+            return EZ_FAILURE;
+          }
+
+          i += 2;
+          break;
+        }
+
+        ReportError(pText, uiLength, i, "Unexpected '/'.");
+        return EZ_FAILURE;
+      }
+
+      default:
+      {
+        // numbers and literals, they are validated when the structure is walked
+        m_Structure.PushBack(i);
+        ++i;
+
+        while (i < uiLength && s_CharClasses.m_Class[(ezUInt8)pText[i]] == Scalar)
+          ++i;
+      }
+      break;
+    }
+  }
+
+  return EZ_SUCCESS;
+}
+
+void ezJSONDocument::ReportError(const char* pText, ezUInt32 uiLength, ezUInt32 uiPosition, const char* szMessage) const
+{
+  ezUInt32 uiLine = 1 + m_uiFirstLineOffset;
+  ezUInt32 uiColumn = 0;
+
+  for (ezUInt32 i = 0; i < uiPosition && i < uiLength; ++i)
+  {
+    if (pText[i] == '\n')
+    {
+      ++uiLine;
+      uiColumn = 0;
+    }
+    else
+    {
+      ++uiColumn;
+    }
+  }
+
+  ezLog::Error(m_pLogInterface, "Line {0} ({1}): {2}", uiLine, uiColumn, szMessage);
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezJSONDocument::Type ezJSONDocument::Value::GetType() const
+{
+  return m_pDocument->m_Nodes[m_uiNode].m_Type;
+}
+
+ezStringView ezJSONDocument::Value::GetName() const
+{
+  return m_pDocument->m_Nodes[m_uiNode].m_sName;
+}
+
+bool ezJSONDocument::Value::GetBool() const
+{
+  EZ_ASSERT_DEBUG(GetType() == Type::Bool, "The value is not a bool.");
+  return m_pDocument->m_Nodes[m_uiNode].m_fNumber != 0.0;
+}
+
+double ezJSONDocument::Value::GetNumber() const
+{
+  EZ_ASSERT_DEBUG(GetType() == Type::Number, "The value is not a number.");
+  return m_pDocument->m_Nodes[m_uiNode].m_fNumber;
+}
+
+ezStringView ezJSONDocument::Value::GetString() const
+{
+  EZ_ASSERT_DEBUG(GetType() == Type::String, "The value is not a string.");
+  return m_pDocument->m_Nodes[m_uiNode].m_sString;
+}
+
+ezUInt32 ezJSONDocument::Value::GetCount() const
+{
+  return m_pDocument->m_Nodes[m_uiNode].m_uiNumChildren;
+}
+
+ezJSONDocument::Value ezJSONDocument::Value::GetFirstChild() const
+{
+  if (GetCount() == 0)
+    return Value();
+
+  // children directly follow their parent
+  return Value(m_pDocument, m_uiNode + 1);
+}
+
+ezJSONDocument::Value ezJSONDocument::Value::GetNextSibling() const
+{
+  const Node& node = m_pDocument->m_Nodes[m_uiNode];
+
+  // the root has no siblings
+  if (node.m_uiParent == ezInvalidIndex || node.m_uiEndIndex >= m_pDocument->m_Nodes[node.m_uiParent].m_uiEndIndex)
+    return Value();
+
+  const ezUInt32 uiNext = node.m_uiEndIndex;
+  return Value(m_pDocument, uiNext);
+}
+
+ezJSONDocument::Value ezJSONDocument::Value::FindMember(const ezStringView& sName) const
+{
+  if (GetType() != Type::Object)
+    return Value();
+
+  const ezUInt32 uiEnd = m_pDocument->m_Nodes[m_uiNode].m_uiEndIndex;
+
+  for (ezUInt32 uiChild = m_uiNode + 1; uiChild < uiEnd; uiChild = m_pDocument->m_Nodes[uiChild].m_uiEndIndex)
+  {
+    if (m_pDocument->m_Nodes[uiChild].m_sName.IsEqual(sName))
+      return Value(m_pDocument, uiChild);
+  }
+
+  return Value();
+}
+
+ezJSONDocument::Value ezJSONDocument::Value::operator[](ezUInt32 uiIndex) const
+{
+  EZ_ASSERT_DEBUG(uiIndex < GetCount(), "Index {0} is out of range, the value only has {1} children.", uiIndex, GetCount());
+
+  ezUInt32 uiChild = m_uiNode + 1;
+
+  for (ezUInt32 i = 0; i < uiIndex; ++i)
+  {
+    uiChild = m_pDocument->m_Nodes[uiChild].m_uiEndIndex;
+  }
+
+  return Value(m_pDocument, uiChild);
+}
+
+void ezJSONDocument::Value::ToVariant(ezVariant& out_Result) const
+{
+  const Node& node = m_pDocument->m_Nodes[m_uiNode];
+
+  switch (node.m_Type)
+  {
+    case Type::Null:
+      out_Result = ezVariant();
+      break;
+
+    case Type::Bool:
+      out_Result = node.m_fNumber != 0.0;
+      break;
+
+    case Type::Number:
+      out_Result = node.m_fNumber;
+      break;
+
+    case Type::String:
+      // the string is zero-terminated in the text buffer
+      out_Result = node.m_sString.GetStartPointer();
+      break;
+
+    case Type::Array:
+    {
+      ezVariantArray elements;
+      elements.Reserve(node.m_uiNumChildren);
+
+      for (ezUInt32 uiChild = m_uiNode + 1; uiChild < node.m_uiEndIndex; uiChild = m_pDocument->m_Nodes[uiChild].m_uiEndIndex)
+      {
+        Value(m_pDocument, uiChild).ToVariant(elements.ExpandAndGetRef());
+      }
+
+      out_Result = elements;
+    }
+    break;
+
+    case Type::Object:
+    {
+      ezVariantDictionary members;
+      members.Reserve(node.m_uiNumChildren);
+
+      for (ezUInt32 uiChild = m_uiNode + 1; uiChild < node.m_uiEndIndex; uiChild = m_pDocument->m_Nodes[uiChild].m_uiEndIndex)
+      {
+        const Node& child = m_pDocument->m_Nodes[uiChild];
+        Value(m_pDocument, uiChild).ToVariant(members[ezString(child.m_sName)]);
+      }
+
+      out_Result = members;
+    }
+    break;
+  }
+}
+
+EZ_STATICLINK_FILE(Foundation, Foundation_IO_Implementation_JSONDocument);
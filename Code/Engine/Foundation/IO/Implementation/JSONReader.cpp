@@ -1,6 +1,8 @@
 #include <FoundationPCH.h>
 
+#include <Foundation/IO/JSONDocument.h>
 #include <Foundation/IO/JSONReader.h>
+#include <Foundation/Logging/Log.h>
 
 
 ezJSONReader::ezJSONReader()
@@ -14,6 +16,9 @@ ezResult ezJSONReader::Parse(ezStreamReader& InputStream, ezUInt32 uiFirstLineOf
   m_Stack.Clear();
   m_sLastName.Clear();
 
+  if (m_bUseDocumentParser)
+    return ParseWithDocumentParser(InputStream, uiFirstLineOffset);
+
   SetInputStream(InputStream, uiFirstLineOffset);
 
   while (!m_bParsingError && ContinueParsing())
@@ -35,6 +40,44 @@ ezResult ezJSONReader::Parse(ezStreamReader& InputStream, ezUInt32 uiFirstLineOf
   return EZ_SUCCESS;
 }
 
+ezResult ezJSONReader::ParseWithDocumentParser(ezStreamReader& inputStream, ezUInt32 uiFirstLineOffset)
+{
+  ezJSONDocument doc;
+  doc.SetLogInterface(m_pLogInterface);
+
+  m_Stack.PushBack(Element());
+  m_Stack.PeekBack().m_Mode = ElementMode::Dictionary;
+
+  if (doc.Parse(inputStream, uiFirstLineOffset).Failed())
+  {
+    m_bParsingError = true;
+    return EZ_FAILURE;
+  }
+
+  const ezJSONDocument::Value root = doc.GetRoot();
+
+  // an empty document results in an empty top-level object
+  if (!root.IsValid())
+    return EZ_SUCCESS;
+
+  if (root.GetType() != ezJSONDocument::Type::Object)
+  {
+    ezLog::Error(m_pLogInterface, "Line {0} (0): The top-level value of the document must be an object.", uiFirstLineOffset + 1);
+    m_bParsingError = true;
+    return EZ_FAILURE;
+  }
+
+  ezVariantDictionary& result = m_Stack.PeekBack().m_Dictionary;
+  result.Reserve(root.GetCount());
+
+  for (ezJSONDocument::Value member = root.GetFirstChild(); member.IsValid(); member = member.GetNextSibling())
+  {
+    member.ToVariant(result[ezString(member.GetName())]);
+  }
+
+  return EZ_SUCCESS;
+}
+
 bool ezJSONReader::OnVariable(const char* szVarName)
 {
   m_sLastName = szVarName;
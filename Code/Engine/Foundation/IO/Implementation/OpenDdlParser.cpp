@@ -1,5 +1,6 @@
 #include <FoundationPCH.h>
 
+#include <Foundation/IO/MemoryStream.h>
 #include <Foundation/IO/OpenDdlParser.h>
 #include <Foundation/Logging/Log.h>
 #include <Foundation/Utilities/ConversionUtils.h>
@@ -42,6 +43,33 @@ void ezOpenDdlParser::SetInputStream(ezStreamReader& stream, ezUInt32 uiFirstLin
 
   m_pInput = &stream;
 
+  if (m_InputBuffer.IsEmpty())
+    m_InputBuffer.SetCountUninitialized(s_uiInputBufferSize);
+
+  FillInputBuffer();
+
+  // without read-ahead, only read as much of the binary header as matches, so that nothing after a short text document is lost
+  while (m_uiInputBufferSize > 0 && m_uiInputBufferSize < sizeof(ezOpenDdlBinary::s_Header) &&
+         ezMemoryUtils::IsEqual(m_InputBuffer.GetData(), ezOpenDdlBinary::s_Header, m_uiInputBufferSize))
+  {
+    if (m_pInput->ReadBytes(&m_InputBuffer[m_uiInputBufferSize], 1) == 0)
+      break;
+
+    ++m_uiInputBufferSize;
+  }
+
+  if (m_uiInputBufferSize >= sizeof(ezOpenDdlBinary::s_Header) &&
+      ezMemoryUtils::IsEqual(m_InputBuffer.GetData(), ezOpenDdlBinary::s_Header, sizeof(ezOpenDdlBinary::s_Header)))
+  {
+    m_bBinaryMode = true;
+    m_bSkippingMode = false;
+    m_uiInputBufferPos = sizeof(ezOpenDdlBinary::s_Header);
+
+    m_StateStack.PushBack(State::Finished);
+    m_StateStack.PushBack(State::Idle);
+    return;
+  }
+
   m_bSkippingMode = false;
   m_uiCurLine = 1 + uiFirstLineOffset;
   m_uiCurColumn = 0;
@@ -74,8 +102,29 @@ void ezOpenDdlParser::SetInputStream(ezStreamReader& stream, ezUInt32 uiFirstLin
   }
 }
 
+void ezOpenDdlParser::SetInputStream(ezMemoryStreamReader& stream, ezUInt32 uiFirstLineOffset /*= 0*/)
+{
+  m_pMemoryInput = &stream;
+  SetInputStream(static_cast<ezStreamReader&>(stream), uiFirstLineOffset);
+}
+
+void ezOpenDdlParser::SetInputStream(ezRawMemoryStreamReader& stream, ezUInt32 uiFirstLineOffset /*= 0*/)
+{
+  m_pRawMemoryInput = &stream;
+  SetInputStream(static_cast<ezStreamReader&>(stream), uiFirstLineOffset);
+}
+
 bool ezOpenDdlParser::ContinueParsing()
 {
+  if (m_bBinaryMode)
+  {
+    if (ContinueBinary())
+      return true;
+
+    ReturnUnusedInput();
+    return false;
+  }
+
   if (m_uiCurByte == '\0')
   {
     if (m_StateStack.GetCount() == 1)
@@ -90,6 +139,7 @@ bool ezOpenDdlParser::ContinueParsing()
     }
 
     m_StateStack.Clear();
+    ReturnUnusedInput();
 
     // nothing left to do
     return false;
@@ -183,9 +233,41 @@ void ezOpenDdlParser::ParsingError(const char* szMessage, bool bFatal)
 }
 
 
+void ezOpenDdlParser::FillInputBuffer()
+{
+  // reading ahead consumes data that may follow the document, so that is only done when the stream can be rewound afterwards
+  const bool bReadAhead = m_pMemoryInput != nullptr || m_pRawMemoryInput != nullptr;
+
+  m_uiInputBufferPos = 0;
+  m_uiInputBufferSize = static_cast<ezUInt32>(m_pInput->ReadBytes(m_InputBuffer.GetData(), bReadAhead ? m_InputBuffer.GetCount() : 1));
+}
+
+void ezOpenDdlParser::ReturnUnusedInput()
+{
+  const ezUInt32 uiUnused = m_uiInputBufferSize - m_uiInputBufferPos;
+  m_uiInputBufferSize = m_uiInputBufferPos;
+
+  if (uiUnused == 0)
+    return;
+
+  if (m_pMemoryInput != nullptr)
+  {
+    m_pMemoryInput->SetReadPosition(m_pMemoryInput->GetReadPosition() - uiUnused);
+  }
+  else if (m_pRawMemoryInput != nullptr)
+  {
+    m_pRawMemoryInput->SetReadPosition(m_pRawMemoryInput->GetReadPosition() - uiUnused);
+  }
+}
+
 void ezOpenDdlParser::ReadNextByte()
 {
-  m_pInput->ReadBytes(&m_uiNextByte, sizeof(ezUInt8));
+  // reading the stream byte by byte is very slow, so the input is read in larger blocks
+  if (m_uiInputBufferPos == m_uiInputBufferSize)
+    FillInputBuffer();
+
+  if (m_uiInputBufferPos < m_uiInputBufferSize)
+    m_uiNextByte = m_InputBuffer[m_uiInputBufferPos++];
 
   if (m_uiNextByte == '\n')
   {
@@ -201,7 +283,10 @@ bool ezOpenDdlParser::ReadCharacter()
   m_uiCurByte = m_uiNextByte;
 
   m_uiNextByte = '\0';
-  ReadNextByte();
+
+  // don't look beyond the end of the document
+  if (m_uiCurByte != '\0')
+    ReadNextByte();
 
   return m_uiCurByte != '\0';
 }
@@ -211,7 +296,10 @@ bool ezOpenDdlParser::ReadCharacterSkipComments()
   m_uiCurByte = m_uiNextByte;
 
   m_uiNextByte = '\0';
-  ReadNextByte();
+
+  // don't look beyond the end of the document
+  if (m_uiCurByte != '\0')
+    ReadNextByte();
 
   // skip comments
   if (m_uiCurByte == '/')
@@ -1223,4 +1311,298 @@ ezUInt64 ezOpenDdlParser::ReadDecimalLiteral()
 
 
 
+//////////////////////////////////////////////////////////////////////////
+
+ezResult ezOpenDdlParser::ReadBinary(void* pDst, ezUInt32 uiBytes)
+{
+  ezUInt8* pTarget = static_cast<ezUInt8*>(pDst);
+
+  while (uiBytes > 0)
+  {
+    if (m_uiInputBufferPos == m_uiInputBufferSize)
+    {
+      // large blocks of data are read directly, without going through the buffer
+      if (uiBytes >= m_InputBuffer.GetCount() || (m_pMemoryInput == nullptr && m_pRawMemoryInput == nullptr))
+      {
+        return m_pInput->ReadBytes(pTarget, uiBytes) == uiBytes ? EZ_SUCCESS : EZ_FAILURE;
+      }
+
+      FillInputBuffer();
+
+      if (m_uiInputBufferSize == 0)
+        return EZ_FAILURE;
+    }
+
+    const ezUInt32 uiCopy = ezMath::Min(uiBytes, m_uiInputBufferSize - m_uiInputBufferPos);
+    ezMemoryUtils::Copy(pTarget, &m_InputBuffer[m_uiInputBufferPos], uiCopy);
+
+    m_uiInputBufferPos += uiCopy;
+    pTarget += uiCopy;
+    uiBytes -= uiCopy;
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezOpenDdlParser::ReadBinaryIdentifier(ezUInt8* szString)
+{
+  ezUInt32 uiLength = 0;
+  EZ_SUCCEED_OR_RETURN(ReadBinary(&uiLength, sizeof(ezUInt32)));
+
+  const ezUInt32 uiStoredLength = ezMath::Min(uiLength, s_uiMaxIdentifierLength - 1);
+  EZ_SUCCEED_OR_RETURN(ReadBinary(szString, uiStoredLength));
+  szString[uiStoredLength] = '\0';
+
+  if (uiStoredLength < uiLength)
+  {
+    ParsingError("Identifier is longer than 63 characters", false);
+
+    // skip the rest
+    ezUInt8 temp[s_uiMaxIdentifierLength];
+    for (ezUInt32 uiSkip = uiLength - uiStoredLength; uiSkip > 0;)
+    {
+      const ezUInt32 uiRead = ezMath::Min(uiSkip, s_uiMaxIdentifierLength);
+      EZ_SUCCEED_OR_RETURN(ReadBinary(temp, uiRead));
+      uiSkip -= uiRead;
+    }
+  }
+
+  return EZ_SUCCESS;
+}
+
+bool ezOpenDdlParser::ContinueBinary()
+{
+  if (m_StateStack.IsEmpty())
+    return false;
+
+  ezUInt8 uiCommand = ezOpenDdlBinary::EndDocument;
+  if (ReadBinary(&uiCommand, sizeof(ezUInt8)).Failed() || uiCommand == ezOpenDdlBinary::EndDocument)
+  {
+    // there's always the main Idle state on the top of the stack when everything went fine
+    if (m_StateStack.GetCount() > 2)
+    {
+      ParsingError("End of the document reached without closing all objects.", true);
+    }
+
+    m_StateStack.Clear();
+    return false;
+  }
+
+  const State state = m_StateStack.PeekBack().m_State;
+  const bool bInPrimitiveList = state >= State::ReadingBool && state <= State::ReadingString;
+
+  switch (uiCommand)
+  {
+    case ezOpenDdlBinary::BeginObject:
+    case ezOpenDdlBinary::BeginPrimitiveList:
+    {
+      if (state != State::Idle)
+      {
+        ParsingError("Objects cannot be nested inside primitive lists", true);
+        return false;
+      }
+
+      ezUInt8 uiPrimitiveType = static_cast<ezUInt8>(ezOpenDdlPrimitiveType::Custom);
+      ezUInt8 uiGlobalName = ezOpenDdlBinary::LocalName;
+
+      if ((uiCommand == ezOpenDdlBinary::BeginPrimitiveList && ReadBinary(&uiPrimitiveType, sizeof(ezUInt8)).Failed()) ||
+          (uiCommand == ezOpenDdlBinary::BeginObject && ReadBinaryIdentifier(m_szIdentifierType).Failed()) ||
+          ReadBinaryIdentifier(m_szIdentifierName).Failed() || ReadBinary(&uiGlobalName, sizeof(ezUInt8)).Failed())
+      {
+        ParsingError("Reached end of file while reading an object header", true);
+        return false;
+      }
+
+      if (uiCommand == ezOpenDdlBinary::BeginObject)
+      {
+        m_StateStack.PushBack(State::Idle);
+
+        if (!m_bSkippingMode)
+        {
+          OnBeginObject((const char*)m_szIdentifierType, (const char*)m_szIdentifierName, uiGlobalName == ezOpenDdlBinary::GlobalName);
+        }
+      }
+      else
+      {
+        if (uiPrimitiveType > static_cast<ezUInt8>(ezOpenDdlPrimitiveType::String))
+        {
+          ParsingError("Invalid primitive type in binary document", true);
+          return false;
+        }
+
+        m_StateStack.PushBack(static_cast<State>(State::ReadingBool + uiPrimitiveType));
+
+        if (!m_bSkippingMode)
+        {
+          OnBeginPrimitiveList(static_cast<ezOpenDdlPrimitiveType>(uiPrimitiveType), (const char*)m_szIdentifierName, uiGlobalName == ezOpenDdlBinary::GlobalName);
+        }
+      }
+
+      return true;
+    }
+
+    case ezOpenDdlBinary::EndObject:
+    {
+      if (state != State::Idle || m_StateStack.GetCount() <= 2)
+      {
+        ParsingError("More objects were closed than opened.", true);
+        return false;
+      }
+
+      m_StateStack.PopBack();
+
+      if (!m_bSkippingMode)
+      {
+        OnEndObject();
+      }
+
+      return true;
+    }
+
+    case ezOpenDdlBinary::PrimitiveData:
+    {
+      if (!bInPrimitiveList)
+      {
+        ParsingError("Primitive data outside of a primitive list", true);
+        return false;
+      }
+
+      ContinueBinaryPrimitiveData();
+      return true;
+    }
+
+    case ezOpenDdlBinary::EndPrimitiveList:
+    {
+      if (!bInPrimitiveList)
+      {
+        ParsingError("More primitive lists were closed than opened.", true);
+        return false;
+      }
+
+      m_StateStack.PopBack();
+
+      if (!m_bSkippingMode)
+      {
+        OnEndPrimitiveList();
+      }
+
+      return true;
+    }
+
+    default:
+      ParsingError("Invalid command in binary document", true);
+      return false;
+  }
+}
+
+void ezOpenDdlParser::ContinueBinaryPrimitiveData()
+{
+  ezUInt32 uiCount = 0;
+  ezUInt32 uiNumBytes = 0;
+
+  if (ReadBinary(&uiCount, sizeof(ezUInt32)).Failed() || ReadBinary(&uiNumBytes, sizeof(ezUInt32)).Failed())
+  {
+    ParsingError("Reached end of file while reading primitive data", true);
+    return;
+  }
+
+  m_BinaryData.SetCountUninitialized(uiNumBytes);
+
+  if (ReadBinary(m_BinaryData.GetData(), uiNumBytes).Failed())
+  {
+    ParsingError("Reached end of file while reading primitive data", true);
+    return;
+  }
+
+  if (m_bSkippingMode || uiCount == 0)
+    return;
+
+  const State state = m_StateStack.PeekBack().m_State;
+
+  if (state == State::ReadingString)
+  {
+    m_BinaryStrings.SetCountUninitialized(uiCount);
+
+    ezUInt32 uiOffset = 0;
+    for (ezUInt32 i = 0; i < uiCount; ++i)
+    {
+      ezUInt32 uiLength = 0;
+
+      if (uiOffset + sizeof(ezUInt32) > uiNumBytes)
+      {
+        ParsingError("Invalid string data in binary document", true);
+        return;
+      }
+
+      ezMemoryUtils::Copy(reinterpret_cast<ezUInt8*>(&uiLength), &m_BinaryData[uiOffset], sizeof(ezUInt32));
+      uiOffset += sizeof(ezUInt32);
+
+      if (uiLength > uiNumBytes - uiOffset)
+      {
+        ParsingError("Invalid string data in binary document", true);
+        return;
+      }
+
+      const char* szString = reinterpret_cast<const char*>(m_BinaryData.GetData()) + uiOffset;
+      m_BinaryStrings[i] = ezStringView(szString, szString + uiLength);
+      uiOffset += uiLength;
+    }
+
+    OnPrimitiveString(uiCount, m_BinaryStrings.GetData(), true);
+    return;
+  }
+
+  static const ezUInt8 s_PrimitiveSizes[] = {sizeof(bool), sizeof(ezInt8), sizeof(ezInt16), sizeof(ezInt32), sizeof(ezInt64), sizeof(ezUInt8),
+    sizeof(ezUInt16), sizeof(ezUInt32), sizeof(ezUInt64), sizeof(float), sizeof(double)};
+
+  if (static_cast<ezUInt64>(uiCount) * s_PrimitiveSizes[state - State::ReadingBool] != uiNumBytes)
+  {
+    ParsingError("Primitive data size does not match the number of primitives", true);
+    return;
+  }
+
+  const void* pData = m_BinaryData.GetData();
+
+  switch (state)
+  {
+    case State::ReadingBool:
+      OnPrimitiveBool(uiCount, static_cast<const bool*>(pData), true);
+      break;
+    case State::ReadingInt8:
+      OnPrimitiveInt8(uiCount, static_cast<const ezInt8*>(pData), true);
+      break;
+    case State::ReadingInt16:
+      OnPrimitiveInt16(uiCount, static_cast<const ezInt16*>(pData), true);
+      break;
+    case State::ReadingInt32:
+      OnPrimitiveInt32(uiCount, static_cast<const ezInt32*>(pData), true);
+      break;
+    case State::ReadingInt64:
+      OnPrimitiveInt64(uiCount, static_cast<const ezInt64*>(pData), true);
+      break;
+    case State::ReadingUInt8:
+      OnPrimitiveUInt8(uiCount, static_cast<const ezUInt8*>(pData), true);
+      break;
+    case State::ReadingUInt16:
+      OnPrimitiveUInt16(uiCount, static_cast<const ezUInt16*>(pData), true);
+      break;
+    case State::ReadingUInt32:
+      OnPrimitiveUInt32(uiCount, static_cast<const ezUInt32*>(pData), true);
+      break;
+    case State::ReadingUInt64:
+      OnPrimitiveUInt64(uiCount, static_cast<const ezUInt64*>(pData), true);
+      break;
+    case State::ReadingFloat:
+      OnPrimitiveFloat(uiCount, static_cast<const float*>(pData), true);
+      break;
+    case State::ReadingDouble:
+      OnPrimitiveDouble(uiCount, static_cast<const double*>(pData), true);
+      break;
+
+    default:
+      EZ_ASSERT_NOT_IMPLEMENTED;
+      break;
+  }
+}
+
 EZ_STATICLINK_FILE(Foundation, Foundation_IO_Implementation_OpenDdlParser);
@@ -21,9 +21,25 @@ ezResult ezOpenDdlReader::ParseDocument(ezStreamReader& stream, ezUInt32 uiFirst
   SetCacheSize(uiCacheSizeInKB);
   SetInputStream(stream, uiFirstLineOffset);
 
+  return ParseRootElement();
+}
+
+ezResult ezOpenDdlReader::ParseDocument(ezMemoryStreamReader& stream, ezUInt32 uiFirstLineOffset, ezLogInterface* pLog, ezUInt32 uiCacheSizeInKB)
+{
+  EZ_ASSERT_DEBUG(m_ObjectStack.IsEmpty(), "A reader can only be used once.");
+
+  SetLogInterface(pLog);
+  SetCacheSize(uiCacheSizeInKB);
+  SetInputStream(stream, uiFirstLineOffset);
+
+  return ParseRootElement();
+}
+
+ezResult ezOpenDdlReader::ParseRootElement()
+{
   m_TempCache.Reserve(s_uiChunkSize);
 
-  ezOpenDdlReaderElement* pElement = &m_Elements.ExpandAndGetRef();
+  ezOpenDdlReaderElement* pElement = AllocateElement();
   pElement->m_pFirstChild = nullptr;
   pElement->m_pLastChild = nullptr;
   pElement->m_PrimitiveType = ezOpenDdlPrimitiveType::Custom;
@@ -55,14 +71,23 @@ const char* ezOpenDdlReader::CopyString(const ezStringView& string)
   if (string.IsEmpty())
     return nullptr;
 
-  // no idea how to make this more efficient without running into lots of other problems
-  m_Strings.PushBack(string);
-  return m_Strings.PeekBack().GetData();
+  const ezUInt32 uiLength = string.GetElementCount();
+
+  char* szCopy = reinterpret_cast<char*>(AllocateBytes(uiLength + 1));
+  ezMemoryUtils::Copy(szCopy, string.GetStartPointer(), uiLength);
+  szCopy[uiLength] = '\0';
+
+  return szCopy;
+}
+
+ezOpenDdlReaderElement* ezOpenDdlReader::AllocateElement()
+{
+  return reinterpret_cast<ezOpenDdlReaderElement*>(AllocateBytes(sizeof(ezOpenDdlReaderElement)));
 }
 
 ezOpenDdlReaderElement* ezOpenDdlReader::CreateElement(ezOpenDdlPrimitiveType type, const char* szType, const char* szName, bool bGlobalName)
 {
-  ezOpenDdlReaderElement* pElement = &m_Elements.ExpandAndGetRef();
+  ezOpenDdlReaderElement* pElement = AllocateElement();
   pElement->m_pFirstChild = nullptr;
   pElement->m_pLastChild = nullptr;
   pElement->m_PrimitiveType = type;
@@ -244,7 +269,6 @@ void ezOpenDdlReader::OnParsingError(const char* szMessage, bool bFatal, ezUInt3
   {
     m_ObjectStack.Clear();
     m_GlobalNames.Clear();
-    m_Elements.Clear();
 
     ClearDataChunks();
   }
@@ -260,6 +284,8 @@ void ezOpenDdlReader::ClearDataChunks()
   }
 
   m_DataChunks.Clear();
+  m_pCurrentChunk = nullptr;
+  m_uiBytesInChunkLeft = 0;
 }
 
 ezUInt8* ezOpenDdlReader::AllocateBytes(ezUInt32 uiNumBytes)
@@ -225,6 +225,18 @@ void ezOpenDdlWriter::BeginObject(const char* szType, const char* szName /*= nul
       "DDL Writer is in a state where no further objects may be created");
   }
 
+  if (m_bBinaryMode)
+  {
+    OutputBinaryHeader();
+    OutputBinaryCommand(ezOpenDdlBinary::BeginObject);
+    OutputBinaryString(szType);
+    OutputBinaryString(szName);
+    OutputBinaryNameFlag(bGlobalName);
+
+    m_StateStack.ExpandAndGetRef().m_State = State::ObjectMultiLine;
+    return;
+  }
+
   OutputObjectBeginning();
 
   {
@@ -337,6 +349,13 @@ void ezOpenDdlWriter::EndObject()
   const auto state = m_StateStack.PeekBack().m_State;
   EZ_ASSERT_DEBUG(state == State::ObjectSingleLine || state == State::ObjectMultiLine || state == State::ObjectStart, "No object is open");
 
+  if (m_bBinaryMode)
+  {
+    OutputBinaryCommand(ezOpenDdlBinary::EndObject);
+    m_StateStack.PopBack();
+    return;
+  }
+
   if (state == State::ObjectStart)
   {
     // object is empty
@@ -374,6 +393,25 @@ void ezOpenDdlWriter::EndObject()
 
 void ezOpenDdlWriter::BeginPrimitiveList(ezOpenDdlPrimitiveType type, const char* szName /*= nullptr*/, bool bGlobalName /*= false*/)
 {
+  if (m_bBinaryMode)
+  {
+    const auto state = m_StateStack.PeekBack().m_State;
+    EZ_IGNORE_UNUSED(state);
+    EZ_ASSERT_DEBUG(state == State::Empty || state == State::ObjectMultiLine, "DDL Writer is in a state where no primitive list may be created");
+
+    OutputBinaryHeader();
+    OutputBinaryCommand(ezOpenDdlBinary::BeginPrimitiveList);
+    OutputBinaryCommand(static_cast<ezUInt8>(type));
+    OutputBinaryString(szName);
+    OutputBinaryNameFlag(bGlobalName);
+
+    m_BinaryPrimitives.Clear();
+    m_uiNumBinaryPrimitives = 0;
+
+    m_StateStack.ExpandAndGetRef().m_State = static_cast<State>(type);
+    return;
+  }
+
   OutputObjectBeginning();
 
   const auto state = m_StateStack.PeekBack().m_State;
@@ -411,6 +449,22 @@ void ezOpenDdlWriter::EndPrimitiveList()
 
   m_StateStack.PopBack();
 
+  if (m_bBinaryMode)
+  {
+    if (m_uiNumBinaryPrimitives > 0)
+    {
+      const ezUInt32 uiNumBytes = m_BinaryPrimitives.GetCount();
+
+      OutputBinaryCommand(ezOpenDdlBinary::PrimitiveData);
+      m_pOutput->WriteBytes(&m_uiNumBinaryPrimitives, sizeof(ezUInt32)).IgnoreResult();
+      m_pOutput->WriteBytes(&uiNumBytes, sizeof(ezUInt32)).IgnoreResult();
+      m_pOutput->WriteBytes(m_BinaryPrimitives.GetData(), uiNumBytes).IgnoreResult();
+    }
+
+    OutputBinaryCommand(ezOpenDdlBinary::EndPrimitiveList);
+    return;
+  }
+
   if (m_bCompactMode)
     OutputString("}", 1);
   else
@@ -427,7 +481,7 @@ void ezOpenDdlWriter::WritePrimitiveType(ezOpenDdlWriter::State exp)
   auto& state = m_StateStack.PeekBack();
   EZ_ASSERT_DEBUG(state.m_State == exp, "Cannot write thie primitive type without have the correct primitive list open");
 
-  if (state.m_bPrimitivesWritten)
+  if (state.m_bPrimitivesWritten && !m_bBinaryMode)
   {
     // already wrote some primitives, so append a comma
     OutputString(",", 1);
@@ -459,6 +513,12 @@ void ezOpenDdlWriter::WriteBool(const bool* pValues, ezUInt32 count /*= 1*/)
 
   WritePrimitiveType(State::PrimitivesBool);
 
+  if (m_bBinaryMode)
+  {
+    StoreBinaryPrimitives(pValues, sizeof(bool) * count, count);
+    return;
+  }
+
   if (m_bCompactMode || m_TypeStringMode == TypeStringMode::Shortest)
   {
     // Extension to OpenDDL: We write only '1' or '0' in compact mode
@@ -500,6 +560,12 @@ void ezOpenDdlWriter::WriteInt8(const ezInt8* pValues, ezUInt32 count /*= 1*/)
 
   WritePrimitiveType(State::PrimitivesInt8);
 
+  if (m_bBinaryMode)
+  {
+    StoreBinaryPrimitives(pValues, sizeof(ezInt8) * count, count);
+    return;
+  }
+
   m_Temp.Format("{0}", pValues[0]);
   OutputString(m_Temp.GetData());
 
@@ -517,6 +583,12 @@ void ezOpenDdlWriter::WriteInt16(const ezInt16* pValues, ezUInt32 count /*= 1*/)
 
   WritePrimitiveType(State::PrimitivesInt16);
 
+  if (m_bBinaryMode)
+  {
+    StoreBinaryPrimitives(pValues, sizeof(ezInt16) * count, count);
+    return;
+  }
+
   m_Temp.Format("{0}", pValues[0]);
   OutputString(m_Temp.GetData());
 
@@ -534,6 +606,12 @@ void ezOpenDdlWriter::WriteInt32(const ezInt32* pValues, ezUInt32 count /*= 1*/)
 
   WritePrimitiveType(State::PrimitivesInt32);
 
+  if (m_bBinaryMode)
+  {
+    StoreBinaryPrimitives(pValues, sizeof(ezInt32) * count, count);
+    return;
+  }
+
   m_Temp.Format("{0}", pValues[0]);
   OutputString(m_Temp.GetData());
 
@@ -551,6 +629,12 @@ void ezOpenDdlWriter::WriteInt64(const ezInt64* pValues, ezUInt32 count /*= 1*/)
 
   WritePrimitiveType(State::PrimitivesInt64);
 
+  if (m_bBinaryMode)
+  {
+    StoreBinaryPrimitives(pValues, sizeof(ezInt64) * count, count);
+    return;
+  }
+
   m_Temp.Format("{0}", pValues[0]);
   OutputString(m_Temp.GetData());
 
@@ -569,6 +653,12 @@ void ezOpenDdlWriter::WriteUInt8(const ezUInt8* pValues, ezUInt32 count /*= 1*/)
 
   WritePrimitiveType(State::PrimitivesUInt8);
 
+  if (m_bBinaryMode)
+  {
+    StoreBinaryPrimitives(pValues, sizeof(ezUInt8) * count, count);
+    return;
+  }
+
   m_Temp.Format("{0}", pValues[0]);
   OutputString(m_Temp.GetData());
 
@@ -586,6 +676,12 @@ void ezOpenDdlWriter::WriteUInt16(const ezUInt16* pValues, ezUInt32 count /*= 1*
 
   WritePrimitiveType(State::PrimitivesUInt16);
 
+  if (m_bBinaryMode)
+  {
+    StoreBinaryPrimitives(pValues, sizeof(ezUInt16) * count, count);
+    return;
+  }
+
   m_Temp.Format("{0}", pValues[0]);
   OutputString(m_Temp.GetData());
 
@@ -603,6 +699,12 @@ void ezOpenDdlWriter::WriteUInt32(const ezUInt32* pValues, ezUInt32 count /*= 1*
 
   WritePrimitiveType(State::PrimitivesUInt32);
 
+  if (m_bBinaryMode)
+  {
+    StoreBinaryPrimitives(pValues, sizeof(ezUInt32) * count, count);
+    return;
+  }
+
   m_Temp.Format("{0}", pValues[0]);
   OutputString(m_Temp.GetData());
 
@@ -620,6 +722,12 @@ void ezOpenDdlWriter::WriteUInt64(const ezUInt64* pValues, ezUInt32 count /*= 1*
 
   WritePrimitiveType(State::PrimitivesUInt64);
 
+  if (m_bBinaryMode)
+  {
+    StoreBinaryPrimitives(pValues, sizeof(ezUInt64) * count, count);
+    return;
+  }
+
   m_Temp.Format("{0}", pValues[0]);
   OutputString(m_Temp.GetData());
 
@@ -637,6 +745,12 @@ void ezOpenDdlWriter::WriteFloat(const float* pValues, ezUInt32 count /*= 1*/)
 
   WritePrimitiveType(State::PrimitivesFloat);
 
+  if (m_bBinaryMode)
+  {
+    StoreBinaryPrimitives(pValues, sizeof(float) * count, count);
+    return;
+  }
+
   if (m_FloatPrecisionMode == FloatPrecisionMode::Readable)
   {
     m_Temp.Format("{0}", pValues[0]);
@@ -684,6 +798,12 @@ void ezOpenDdlWriter::WriteDouble(const double* pValues, ezUInt32 count /*= 1*/)
 
   WritePrimitiveType(State::PrimitivesDouble);
 
+  if (m_bBinaryMode)
+  {
+    StoreBinaryPrimitives(pValues, sizeof(double) * count, count);
+    return;
+  }
+
   if (m_FloatPrecisionMode == FloatPrecisionMode::Readable)
   {
     m_Temp.Format("{0}", pValues[0]);
@@ -728,6 +848,12 @@ void ezOpenDdlWriter::WriteString(const ezStringView& string)
 {
   WritePrimitiveType(State::PrimitivesString);
 
+  if (m_bBinaryMode)
+  {
+    StoreBinaryString(string);
+    return;
+  }
+
   OutputEscapedString(string);
 }
 
@@ -737,6 +863,22 @@ void ezOpenDdlWriter::WriteBinaryAsString(const void* pData, ezUInt32 uiBytes)
 
   WritePrimitiveType(State::PrimitivesString);
 
+  if (m_bBinaryMode)
+  {
+    char tmp[4];
+    const ezUInt8* pBytes = static_cast<const ezUInt8*>(pData);
+
+    m_Temp.Clear();
+    for (ezUInt32 i = 0; i < uiBytes; ++i)
+    {
+      ezStringUtils::snprintf(tmp, 4, "%02X", (ezUInt32)pBytes[i]);
+      m_Temp.Append(tmp);
+    }
+
+    StoreBinaryString(m_Temp);
+    return;
+  }
+
   OutputString("\"", 1);
   WriteBinaryAsHex(pData, uiBytes);
   OutputString("\"", 1);
@@ -744,4 +886,46 @@ void ezOpenDdlWriter::WriteBinaryAsString(const void* pData, ezUInt32 uiBytes)
 
 
 
+void ezOpenDdlWriter::OutputBinaryHeader()
+{
+  if (m_bBinaryHeaderWritten)
+    return;
+
+  m_bBinaryHeaderWritten = true;
+  m_pOutput->WriteBytes(ezOpenDdlBinary::s_Header, sizeof(ezOpenDdlBinary::s_Header)).IgnoreResult();
+}
+
+void ezOpenDdlWriter::OutputBinaryCommand(ezUInt8 uiCommand)
+{
+  m_pOutput->WriteBytes(&uiCommand, sizeof(ezUInt8)).IgnoreResult();
+}
+
+void ezOpenDdlWriter::OutputBinaryNameFlag(bool bGlobalName)
+{
+  const ezUInt8 uiFlag = bGlobalName ? ezOpenDdlBinary::GlobalName : ezOpenDdlBinary::LocalName;
+  m_pOutput->WriteBytes(&uiFlag, sizeof(ezUInt8)).IgnoreResult();
+}
+
+void ezOpenDdlWriter::OutputBinaryString(const char* szString)
+{
+  const ezUInt32 uiLength = ezStringUtils::GetStringElementCount(szString);
+
+  m_pOutput->WriteBytes(&uiLength, sizeof(ezUInt32)).IgnoreResult();
+  m_pOutput->WriteBytes(szString, uiLength).IgnoreResult();
+}
+
+void ezOpenDdlWriter::StoreBinaryPrimitives(const void* pData, ezUInt32 uiNumBytes, ezUInt32 uiCount)
+{
+  m_BinaryPrimitives.PushBackRange(ezArrayPtr<const ezUInt8>(static_cast<const ezUInt8*>(pData), uiNumBytes));
+  m_uiNumBinaryPrimitives += uiCount;
+}
+
+void ezOpenDdlWriter::StoreBinaryString(const ezStringView& string)
+{
+  const ezUInt32 uiLength = string.GetElementCount();
+
+  StoreBinaryPrimitives(&uiLength, sizeof(ezUInt32), 1);
+  StoreBinaryPrimitives(string.GetStartPointer(), uiLength, 0);
+}
+
 EZ_STATICLINK_FILE(Foundation, Foundation_IO_Implementation_OpenDdlWriter);
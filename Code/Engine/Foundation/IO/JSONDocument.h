@@ -0,0 +1,160 @@
+#pragma once
+
+#include <Foundation/Basics.h>
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/IO/Stream.h>
+#include <Foundation/Strings/StringView.h>
+#include <Foundation/Types/Variant.h>
+
+class ezLogInterface;
+
+/// \brief Callback interface for ezJSONDocument::ParseSax().
+///
+/// The name of a value is only set for members of an object, it is empty for array elements and the top-level value.
+/// All strings point into the parsed text and are zero-terminated.
+class EZ_FOUNDATION_DLL ezJSONSaxHandler
+{
+public:
+  virtual ~ezJSONSaxHandler() = default;
+
+  virtual void OnBeginObject(const ezStringView& sName) = 0;
+  virtual void OnEndObject() = 0;
+  virtual void OnBeginArray(const ezStringView& sName) = 0;
+  virtual void OnEndArray() = 0;
+  virtual void OnString(const ezStringView& sName, const ezStringView& sValue) = 0;
+  virtual void OnNumber(const ezStringView& sName, double fValue) = 0;
+  virtual void OnBool(const ezStringView& sName, bool bValue) = 0;
+  virtual void OnNull(const ezStringView& sName) = 0;
+};
+
+/// \brief A JSON parser for large documents, that parses an entire document in memory at once.
+///
+/// Parsing is done in two passes. The first pass builds an index of all structural characters and the start positions of all values,
+/// the second pass walks this index and either builds a DOM or reports the document structure to an ezJSONSaxHandler.
+/// Strings are unescaped in place and are zero-terminated inside the text buffer, so no string data is copied.
+/// The DOM is stored as one array of nodes in document order, which makes building it very cheap compared to ezJSONReader.
+///
+/// Compared to ezJSONParser, documents may have any value at the top level. Like ezJSONParser, C and C++ style comments are allowed,
+/// however only between tokens, not inside of numbers or literals.
+class EZ_FOUNDATION_DLL ezJSONDocument
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezJSONDocument);
+
+public:
+  enum class Type : ezUInt8
+  {
+    Null,
+    Bool,
+    Number,
+    String,
+    Array,
+    Object,
+  };
+
+  /// \brief A lightweight handle to a value in an ezJSONDocument. Only valid as long as the document is not modified.
+  class EZ_FOUNDATION_DLL Value
+  {
+  public:
+    Value() = default;
+
+    /// \brief Returns false for handles that don't point to a value, e.g. when FindMember() did not find anything.
+    bool IsValid() const { return m_pDocument != nullptr; }
+
+    Type GetType() const;
+
+    /// \brief Returns the member name of this value, if it is part of an object.
+    ezStringView GetName() const;
+
+    bool GetBool() const;
+    double GetNumber() const;
+
+    /// \brief Returns the string value. The string is zero-terminated, so GetStartPointer() can be used as a C string.
+    ezStringView GetString() const;
+
+    /// \brief Returns the number of elements or members for arrays and objects, zero for all other types.
+    ezUInt32 GetCount() const;
+
+    /// \brief Returns the first element or member of an array or object.
+    Value GetFirstChild() const;
+
+    /// \brief Returns the next element or member of the parent array or object.
+    Value GetNextSibling() const;
+
+    /// \brief Searches the members of an object for the given name. Does a linear search.
+    Value FindMember(const ezStringView& sName) const;
+
+    /// \brief Returns the element with the given index. Does a linear search.
+    Value operator[](ezUInt32 uiIndex) const;
+
+    /// \brief Converts this value and all its children into the same ezVariant structure that ezJSONReader creates.
+    void ToVariant(ezVariant& out_Result) const;
+
+  private:
+    friend class ezJSONDocument;
+
+    Value(const ezJSONDocument* pDocument, ezUInt32 uiNode)
+      : m_pDocument(pDocument)
+      , m_uiNode(uiNode)
+    {
+    }
+
+    const ezJSONDocument* m_pDocument = nullptr;
+    ezUInt32 m_uiNode = 0;
+  };
+
+  ezJSONDocument();
+  ~ezJSONDocument();
+
+  /// \brief Allows to specify an ezLogInterface through which errors are reported.
+  void SetLogInterface(ezLogInterface* pLog) { m_pLogInterface = pLog; }
+
+  /// \brief Reads the entire stream into an internal buffer and builds the DOM from it.
+  ///
+  /// uiFirstLineOffset is added to the line numbers in error messages.
+  ezResult Parse(ezStreamReader& stream, ezUInt32 uiFirstLineOffset = 0); // [tested]
+
+  /// \brief Builds the DOM directly from the given text. The text is modified and has to stay alive as long as the DOM is used.
+  ezResult ParseInSitu(ezArrayPtr<char> text, ezUInt32 uiFirstLineOffset = 0); // [tested]
+
+  /// \brief Reports the structure of the given text to the handler, without building a DOM.
+  ///
+  /// The text is modified, the strings that are passed to the handler point into it.
+  /// If an error is detected, the handler may have received only parts of the document.
+  ezResult ParseSax(ezArrayPtr<char> text, ezJSONSaxHandler& handler, ezUInt32 uiFirstLineOffset = 0); // [tested]
+
+  /// \brief Removes the DOM and frees the internal text buffer.
+  void Clear();
+
+  /// \brief Returns the top-level value. Not valid, if the document was empty or could not be parsed.
+  Value GetRoot() const; // [tested]
+
+  /// \brief Returns the total number of values in the DOM.
+  ezUInt32 GetNumValues() const { return m_Nodes.GetCount(); }
+
+private:
+  struct Node
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezStringView m_sName;
+    ezStringView m_sString;
+    double m_fNumber;
+    ezUInt32 m_uiNumChildren;
+    ezUInt32 m_uiEndIndex; ///< The index of the first node after this node and all its children.
+    ezUInt32 m_uiParent;   ///< The index of the parent node, or ezInvalidIndex for the root.
+    Type m_Type;
+  };
+
+  template <typename Handler>
+  friend class ezJSONStructureWalker;
+  friend class ezJSONDomBuilder;
+
+  ezResult BuildStructuralIndex(const char* pText, ezUInt32 uiLength);
+  void ReportError(const char* pText, ezUInt32 uiLength, ezUInt32 uiPosition, const char* szMessage) const;
+
+  ezLogInterface* m_pLogInterface = nullptr;
+  ezUInt32 m_uiFirstLineOffset = 0;
+  ezDynamicArray<char> m_Text;
+  ezDynamicArray<ezUInt32> m_Structure;
+  ezDynamicArray<Node> m_Nodes;
+};
@@ -19,6 +19,12 @@ public:
   /// error occurred.
   ezResult Parse(ezStreamReader& pInput, ezUInt32 uiFirstLineOffset = 0);
 
+  /// \brief Enables parsing through ezJSONDocument, which is considerably faster for large documents.
+  ///
+  /// The resulting data structure is identical, however OnVariable() is not called in this mode,
+  /// so derived classes that skip variables must not enable it.
+  void SetUseDocumentParser(bool bEnable) { m_bUseDocumentParser = bEnable; } // [tested]
+
   /// \brief Returns the top-level object of the JSON document.
   const ezVariantDictionary& GetTopLevelObject() const { return m_Stack.PeekBack().m_Dictionary; }
 
@@ -69,6 +75,9 @@ protected:
 
   ezHybridArray<Element, 32> m_Stack;
 
+  ezResult ParseWithDocumentParser(ezStreamReader& inputStream, ezUInt32 uiFirstLineOffset);
+
   bool m_bParsingError;
+  bool m_bUseDocumentParser = false;
   ezString m_sLastName;
 };
@@ -6,6 +6,8 @@
 #include <Foundation/IO/Stream.h>
 
 class ezLogInterface;
+class ezMemoryStreamReader;
+class ezRawMemoryStreamReader;
 
 /// \brief The primitive data types that OpenDDL supports
 enum class ezOpenDdlPrimitiveType
@@ -28,6 +30,34 @@ enum class ezOpenDdlPrimitiveType
   Custom
 };
 
+/// \brief Constants for the binary encoding of OpenDDL documents, see ezOpenDdlWriter::SetBinaryMode().
+///
+/// A binary document consists of the header, followed by a sequence of commands. Identifiers and strings are stored as their byte count
+/// followed by the (not zero-terminated) string data. All numbers are stored in the native byte order, which is little endian on all
+/// supported platforms.
+struct ezOpenDdlBinary
+{
+  /// \brief Binary documents start with these bytes. Text documents can never start with a zero byte, so both are told apart reliably.
+  static constexpr ezUInt8 s_Header[8] = {0, 'E', 'Z', 'D', 'D', 'L', 'B', 1};
+
+  enum Command : ezUInt8
+  {
+    EndDocument = 0,    ///< Optional. Like a zero byte in a text document, this ends the document before the end of the stream.
+    BeginObject = 1,    ///< Followed by the type name, the object name and one NameFlag byte.
+    EndObject,          ///< No data.
+    BeginPrimitiveList, ///< Followed by the ezOpenDdlPrimitiveType as one byte, the name and one NameFlag byte.
+    PrimitiveData,      ///< Followed by the number of primitives, the number of bytes and the data. Strings are stored as described above.
+    EndPrimitiveList,   ///< No data.
+  };
+
+  /// \brief The byte that follows the name of an object or primitive list.
+  enum NameFlag : ezUInt8
+  {
+    LocalName = 0,
+    GlobalName = 1,
+  };
+};
+
 /// \brief A low level parser for the OpenDDL format. It can incrementally parse the structure, individual blocks can be skipped.
 ///
 /// The document structure is returned through virtual functions that need to be overridden.
@@ -52,8 +82,22 @@ protected:
   void SetCacheSize(ezUInt32 uiSizeInKB);
 
   /// \brief Configures the parser to read from the given stream. This can only be called once on a parser instance.
+  ///
+  /// Documents in the binary encoding written by ezOpenDdlWriter::SetBinaryMode() are detected automatically
+  /// and result in exactly the same callbacks as the text representation.
+  ///
+  /// A document ends at the end of the stream or at a zero byte. The parser reads the stream byte by byte and does not consume
+  /// data beyond the end of the document, so a document can be embedded in a larger stream.
   void SetInputStream(ezStreamReader& stream, ezUInt32 uiFirstLineOffset = 0); // [tested]
 
+  /// \brief Same as above, but reads the input in larger blocks, which is a lot faster.
+  ///
+  /// Once parsing ends, the read position of the stream is moved back to right after the document.
+  void SetInputStream(ezMemoryStreamReader& stream, ezUInt32 uiFirstLineOffset = 0); // [tested]
+
+  /// \brief \copydoc ezOpenDdlParser::SetInputStream(ezMemoryStreamReader&, ezUInt32)
+  void SetInputStream(ezRawMemoryStreamReader& stream, ezUInt32 uiFirstLineOffset = 0);
+
   /// \brief Call this to parse the next piece of the document. This may trigger a callback through which data is returned.
   ///
   /// This function returns false when the end of the document has been reached, or a fatal parsing error has been reported.
@@ -180,8 +224,29 @@ private:
   void ReadDecimalFloat();
   void ReadHexString();
 
+  void FillInputBuffer();
+  void ReturnUnusedInput();
+  ezResult ReadBinary(void* pDst, ezUInt32 uiBytes);
+  ezResult ReadBinaryIdentifier(ezUInt8* szString);
+  bool ContinueBinary();
+  void ContinueBinaryPrimitiveData();
+
   ezHybridArray<DdlState, 32> m_StateStack;
   ezStreamReader* m_pInput;
+
+  // only when the input can be rewound, it is read ahead in blocks
+  ezMemoryStreamReader* m_pMemoryInput = nullptr;
+  ezRawMemoryStreamReader* m_pRawMemoryInput = nullptr;
+
+  static const ezUInt32 s_uiInputBufferSize = 1024 * 4;
+
+  ezDynamicArray<ezUInt8> m_InputBuffer;
+  ezUInt32 m_uiInputBufferPos = 0;
+  ezUInt32 m_uiInputBufferSize = 0;
+
+  bool m_bBinaryMode = false;
+  ezDynamicArray<ezUInt8> m_BinaryData;
+  ezDynamicArray<ezStringView> m_BinaryStrings;
   ezDynamicArray<ezUInt8> m_Cache;
 
   static const ezUInt32 s_uiMaxIdentifierLength = 64;
@@ -122,6 +122,8 @@ public:
 
   /// \brief Parses the given document, returns EZ_FAILURE if an unrecoverable parsing error was encountered.
   ///
+  /// Documents in the binary encoding (see ezOpenDdlWriter::SetBinaryMode()) are detected automatically.
+  ///
   /// \param stream is the input data.
   /// \param uiFirstLineOffset allows to adjust the reported line numbers in error messages, in case the given stream represents a sub-section of a
   /// larger file. \param pLog is used for outputting details about parsing errors. If nullptr is given, no details are logged. \param uiCacheSizeInKB
@@ -130,6 +132,10 @@ public:
   ezResult ParseDocument(ezStreamReader& stream, ezUInt32 uiFirstLineOffset = 0, ezLogInterface* pLog = ezLog::GetThreadLocalLogSystem(),
     ezUInt32 uiCacheSizeInKB = 4); // [tested]
 
+  /// \brief Same as above, but reads the input in larger blocks. See ezOpenDdlParser::SetInputStream(ezMemoryStreamReader&, ezUInt32).
+  ezResult ParseDocument(ezMemoryStreamReader& stream, ezUInt32 uiFirstLineOffset = 0, ezLogInterface* pLog = ezLog::GetThreadLocalLogSystem(),
+    ezUInt32 uiCacheSizeInKB = 4); // [tested]
+
   /// \brief Every document has exactly one root element.
   const ezOpenDdlReaderElement* GetRootElement() const; // [tested]
 
@@ -163,14 +169,17 @@ protected:
   virtual void OnParsingError(const char* szMessage, bool bFatal, ezUInt32 uiLine, ezUInt32 uiColumn) override;
 
 protected:
+  ezResult ParseRootElement();
   ezOpenDdlReaderElement* CreateElement(ezOpenDdlPrimitiveType type, const char* szType, const char* szName, bool bGlobalName);
   const char* CopyString(const ezStringView& string);
   void StorePrimitiveData(bool bThisIsAll, ezUInt32 bytecount, const ezUInt8* pData);
 
   void ClearDataChunks();
   ezUInt8* AllocateBytes(ezUInt32 uiNumBytes);
+  ezOpenDdlReaderElement* AllocateElement();
 
-  static const ezUInt32 s_uiChunkSize = 1000 * 4; // 4 KiB
+  // all elements, strings and primitive data are stored in these chunks
+  static const ezUInt32 s_uiChunkSize = 1024 * 16; // 16 KiB
 
   ezHybridArray<ezUInt8*, 16> m_DataChunks;
   ezUInt8* m_pCurrentChunk;
@@ -178,10 +187,7 @@ protected:
 
   ezDynamicArray<ezUInt8> m_TempCache;
 
-  ezDeque<ezOpenDdlReaderElement> m_Elements;
   ezHybridArray<ezOpenDdlReaderElement*, 16> m_ObjectStack;
 
-  ezDeque<ezString> m_Strings;
-
   ezMap<ezString, ezOpenDdlReaderElement*> m_GlobalNames;
 };
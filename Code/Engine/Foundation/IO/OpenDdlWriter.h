@@ -46,6 +46,16 @@ public:
   /// \brief Returns how float values are output.
   FloatPrecisionMode GetFloatPrecisionMode() const { return m_FloatPrecisionMode; }
 
+  /// \brief Configures whether the document is written in a binary encoding instead of text.
+  ///
+  /// Binary documents are much faster to read, since all primitive data is stored in its native representation and can be copied
+  /// directly. ezOpenDdlReader detects the encoding automatically. All options that only affect the formatting of the text are ignored.
+  /// Has to be set before anything is written.
+  void SetBinaryMode(bool bBinary) { m_bBinaryMode = bBinary; } // [tested]
+
+  /// \brief Returns whether the document is written in the binary encoding.
+  bool GetBinaryMode() const { return m_bBinaryMode; }
+
   /// \brief Allows to set the indentation. Negative values are possible.
   /// This makes it possible to set the indentation e.g. to -2, thus the output will only have indentation after a level of 3 has been reached.
   void SetIndentation(ezInt8 iIndentation) { m_iIndentation = iIndentation; }
@@ -148,6 +158,13 @@ protected:
   void WriteBinaryAsHex(const void* pData, ezUInt32 uiBytes);
   void OutputObjectBeginning();
 
+  void OutputBinaryHeader();
+  void OutputBinaryCommand(ezUInt8 uiCommand);
+  void OutputBinaryNameFlag(bool bGlobalName);
+  void OutputBinaryString(const char* szString);
+  void StoreBinaryPrimitives(const void* pData, ezUInt32 uiNumBytes, ezUInt32 uiCount);
+  void StoreBinaryString(const ezStringView& string);
+
   ezInt32 m_iIndentation;
   bool m_bCompactMode;
   TypeStringMode m_TypeStringMode;
@@ -155,5 +172,10 @@ protected:
   ezStreamWriter* m_pOutput;
   ezStringBuilder m_Temp;
 
+  bool m_bBinaryMode = false;
+  bool m_bBinaryHeaderWritten = false;
+  ezUInt32 m_uiNumBinaryPrimitives = 0;
+  ezDynamicArray<ezUInt8> m_BinaryPrimitives; ///< The binary data of the current primitive list, it is written as one block at the end.
+
   ezHybridArray<DdlState, 16> m_StateStack;
 };
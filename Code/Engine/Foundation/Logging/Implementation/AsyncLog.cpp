@@ -0,0 +1,349 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/Configuration/Startup.h>
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Containers/HybridArray.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Threading/ThreadSignal.h>
+
+// clang-format off
+EZ_BEGIN_SUBSYSTEM_DECLARATION(Foundation, AsyncLog)
+
+  BEGIN_SUBSYSTEM_DEPENDENCIES
+    "ThreadUtils"
+  END_SUBSYSTEM_DEPENDENCIES
+
+  ON_CORESYSTEMS_STARTUP
+  {
+  }
+
+  ON_CORESYSTEMS_SHUTDOWN
+  {
+    // guarantees that everything that was logged reaches the writers before they are shut down
+    ezGlobalLog::DisableAsyncMode();
+  }
+
+EZ_END_SUBSYSTEM_DECLARATION;
+// clang-format on
+
+/// \brief Set while a thread passes queued events to the log writers. Events that the log writers emit themselves are then broadcast
+/// directly instead of being queued, and flushing from within a log writer is skipped, since it would have to wait for itself.
+static thread_local bool tl_bIsDrainingAsyncLog = false;
+
+/// \brief Bounded multi-producer queue for log events with a dedicated writer thread that broadcasts them to the log writers.
+///
+/// Each slot carries a sequence number that tells producers and the consumer whether it is free or filled (see Dmitry Vyukov's bounded
+/// MPMC queue). Producers only contend on the enqueue position, the consumer side is serialized by m_ConsumerMutex.
+class ezAsyncLogQueue : public ezThread
+{
+public:
+  ezAsyncLogQueue(const ezAsyncLogSettings& settings)
+    : ezThread("ezAsyncLog")
+    , m_OverflowPolicy(settings.m_OverflowPolicy)
+  {
+    const ezUInt32 uiCapacity = ezMath::PowerOfTwo_Ceil(ezMath::Max(settings.m_uiQueueCapacity, 2u));
+    m_uiMask = uiCapacity - 1;
+
+    m_Slots.SetCount(uiCapacity);
+    for (ezUInt32 i = 0; i < uiCapacity; ++i)
+    {
+      m_Slots[i].m_iSequence = i;
+    }
+  }
+
+  void Enqueue(const ezLoggingEventData& le)
+  {
+    const bool bMayDrop = m_OverflowPolicy == ezAsyncLogOverflowPolicy::DropLowPriority && le.m_EventType >= ezLogMsgType::WarningMsg;
+
+    Slot* pSlot = nullptr;
+    ezInt64 iPos = m_iEnqueuePos;
+
+    while (true)
+    {
+      pSlot = &m_Slots[static_cast<ezUInt32>(iPos) & m_uiMask];
+      const ezInt64 iDiff = pSlot->m_iSequence - iPos;
+
+      if (iDiff == 0)
+      {
+        if (m_iEnqueuePos.TestAndSet(iPos, iPos + 1))
+          break;
+
+        iPos = m_iEnqueuePos;
+      }
+      else if (iDiff < 0)
+      {
+        // the queue is full
+        if (bMayDrop)
+        {
+          m_iDroppedMessages.Increment();
+          return;
+        }
+
+        m_WakeUpWriter.RaiseSignal();
+        ezThreadUtils::YieldTimeSlice();
+        iPos = m_iEnqueuePos;
+      }
+      else
+      {
+        iPos = m_iEnqueuePos;
+      }
+    }
+
+    pSlot->m_EventType = le.m_EventType;
+    pSlot->m_uiIndentation = le.m_uiIndentation;
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+    pSlot->m_fSeconds = le.m_fSeconds;
+#endif
+
+    // text and tag are stored back to back in the same buffer, the text may be nullptr for flush events
+    const ezUInt32 uiTextBytes = le.m_szText ? ezStringUtils::GetStringElementCount(le.m_szText) : 0;
+    const ezUInt32 uiTagBytes = le.m_szTag ? ezStringUtils::GetStringElementCount(le.m_szTag) : 0;
+    pSlot->m_Text.SetCountUninitialized(uiTextBytes + uiTagBytes + 2);
+    ezMemoryUtils::RawByteCopy(pSlot->m_Text.GetData(), le.m_szText, uiTextBytes);
+    pSlot->m_Text[uiTextBytes] = '\0';
+    ezMemoryUtils::RawByteCopy(pSlot->m_Text.GetData() + uiTextBytes + 1, le.m_szTag, uiTagBytes);
+    pSlot->m_Text[uiTextBytes + 1 + uiTagBytes] = '\0';
+    pSlot->m_uiTagOffset = uiTextBytes + 1;
+    pSlot->m_bHasText = le.m_szText != nullptr;
+
+    // publish the slot
+    pSlot->m_iSequence.Set(iPos + 1);
+
+    // only wake up the writer when it may have run out of work, or when the message is important
+    if (iPos == m_iDequeuePos || le.m_EventType == ezLogMsgType::ErrorMsg || le.m_EventType == ezLogMsgType::Flush)
+    {
+      m_WakeUpWriter.RaiseSignal();
+    }
+  }
+
+  /// \brief Broadcasts all events that are currently in the queue. Can be called from any thread.
+  void Drain()
+  {
+    EZ_LOCK(m_ConsumerMutex);
+
+    const bool bWasDraining = tl_bIsDrainingAsyncLog;
+    tl_bIsDrainingAsyncLog = true;
+
+    while (true)
+    {
+      const ezInt64 iPos = m_iDequeuePos;
+      Slot& slot = m_Slots[static_cast<ezUInt32>(iPos) & m_uiMask];
+
+      if (slot.m_iSequence != iPos + 1)
+        break;
+
+      ReportDroppedMessages();
+
+      ezLoggingEventData le;
+      le.m_EventType = slot.m_EventType;
+      le.m_uiIndentation = slot.m_uiIndentation;
+      le.m_szText = slot.m_bHasText ? slot.m_Text.GetData() : nullptr;
+      le.m_szTag = slot.m_Text.GetData() + slot.m_uiTagOffset;
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+      le.m_fSeconds = slot.m_fSeconds;
+#endif
+
+      ezGlobalLog::s_LoggingEvent.Broadcast(le);
+
+      // release the slot for the next round
+      slot.m_iSequence.Set(iPos + m_uiMask + 1);
+      m_iDequeuePos.Set(iPos + 1);
+    }
+
+    ReportDroppedMessages();
+
+    tl_bIsDrainingAsyncLog = bWasDraining;
+  }
+
+  bool Flush(ezTime timeout)
+  {
+    const ezInt64 iTarget = m_iEnqueuePos;
+    const ezTime tEnd = ezTime::Now() + timeout;
+
+    while (m_iDequeuePos < iTarget)
+    {
+      // drain on this thread, if the writer thread is busy, it is probably writing our events already
+      // a producer may have claimed a slot without publishing it yet, so the timeout has to be checked even after draining
+      if (m_ConsumerMutex.TryLock())
+      {
+        Drain();
+        m_ConsumerMutex.Unlock();
+      }
+
+      if (ezTime::Now() >= tEnd)
+        return false;
+
+      ezThreadUtils::YieldTimeSlice();
+    }
+
+    return true;
+  }
+
+  void Shutdown()
+  {
+    m_bShutdown = true;
+    m_WakeUpWriter.RaiseSignal();
+    Join();
+
+    // anything that was queued while the thread was shutting down
+    Drain();
+  }
+
+  ezUInt32 GetDroppedMessageCount() const { return static_cast<ezUInt32>(m_iDroppedMessages); }
+
+private:
+  virtual ezUInt32 Run() override
+  {
+    while (!m_bShutdown)
+    {
+      m_WakeUpWriter.WaitForSignal(ezTime::Milliseconds(50));
+      Drain();
+    }
+
+    Drain();
+    return 0;
+  }
+
+  void ReportDroppedMessages()
+  {
+    const ezInt32 iDropped = m_iDroppedMessages;
+    if (iDropped == m_iReportedDroppedMessages)
+      return;
+
+    ezStringBuilder sText;
+    sText.Format("{0} log messages were dropped, because the asynchronous log queue was full.", iDropped - m_iReportedDroppedMessages);
+    m_iReportedDroppedMessages = iDropped;
+
+    ezLoggingEventData le;
+    le.m_EventType = ezLogMsgType::WarningMsg;
+    le.m_szText = sText;
+    le.m_szTag = "AsyncLog";
+    ezGlobalLog::s_LoggingEvent.Broadcast(le);
+  }
+
+  struct Slot
+  {
+    ezAtomicInteger64 m_iSequence;
+    ezLogMsgType::Enum m_EventType = ezLogMsgType::None;
+    ezUInt8 m_uiIndentation = 0;
+    bool m_bHasText = true;
+    ezUInt32 m_uiTagOffset = 0;
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+    double m_fSeconds = 0;
+#endif
+    ezHybridArray<char, 224> m_Text;
+  };
+
+  const ezAsyncLogOverflowPolicy::Enum m_OverflowPolicy;
+  ezUInt32 m_uiMask = 0;
+  ezDynamicArray<Slot> m_Slots;
+
+  ezAtomicInteger64 m_iEnqueuePos;
+  ezAtomicInteger64 m_iDequeuePos;
+  ezAtomicInteger32 m_iDroppedMessages;
+  ezInt32 m_iReportedDroppedMessages = 0;
+
+  ezMutex m_ConsumerMutex;
+  ezThreadSignal m_WakeUpWriter;
+  volatile bool m_bShutdown = false;
+};
+
+// only written while holding s_AsyncLogModeMutex, but read without the lock by every thread that logs
+static ezAsyncLogQueue* s_pAsyncLogQueue = nullptr;
+static ezAtomicInteger32 s_iAsyncLogProducers;
+static ezMutex s_AsyncLogModeMutex;
+
+static EZ_ALWAYS_INLINE ezAsyncLogQueue* GetAsyncLogQueue()
+{
+  return static_cast<ezAsyncLogQueue*>(ezAtomicUtils::Read(reinterpret_cast<void**>(&s_pAsyncLogQueue)));
+}
+
+static void SetAsyncLogQueue(ezAsyncLogQueue* pQueue)
+{
+  ezAtomicUtils::TestAndSet(reinterpret_cast<void**>(&s_pAsyncLogQueue), GetAsyncLogQueue(), pQueue);
+}
+
+void ezGlobalLog::EnableAsyncMode(const ezAsyncLogSettings& settings)
+{
+  EZ_LOCK(s_AsyncLogModeMutex);
+
+  if (GetAsyncLogQueue() != nullptr)
+    return;
+
+  ezAsyncLogQueue* pQueue = EZ_DEFAULT_NEW(ezAsyncLogQueue, settings);
+  pQueue->Start();
+
+  SetAsyncLogQueue(pQueue);
+}
+
+void ezGlobalLog::DisableAsyncMode()
+{
+  EZ_LOCK(s_AsyncLogModeMutex);
+
+  ezAsyncLogQueue* pQueue = GetAsyncLogQueue();
+  if (pQueue == nullptr)
+    return;
+
+  // new events are broadcast directly from now on, wait for all threads that are currently queuing an event
+  // the compare-and-swap acts as a full memory barrier, so producers either see the nullptr or are already counted
+  SetAsyncLogQueue(nullptr);
+  while (s_iAsyncLogProducers.CompareAndSwap(0, 0) != 0)
+  {
+    ezThreadUtils::YieldTimeSlice();
+  }
+
+  pQueue->Shutdown();
+  EZ_DEFAULT_DELETE(pQueue);
+}
+
+bool ezGlobalLog::IsAsyncModeEnabled()
+{
+  return GetAsyncLogQueue() != nullptr;
+}
+
+bool ezGlobalLog::FlushAsyncQueue(ezTime timeout)
+{
+  // log writers may add or remove other writers while handling an event, they cannot wait for themselves
+  if (GetAsyncLogQueue() == nullptr || tl_bIsDrainingAsyncLog)
+    return true;
+
+  EZ_LOCK(s_AsyncLogModeMutex);
+
+  ezAsyncLogQueue* pQueue = GetAsyncLogQueue();
+  if (pQueue == nullptr)
+    return true;
+
+  return pQueue->Flush(timeout);
+}
+
+ezUInt32 ezGlobalLog::GetDroppedAsyncMessageCount()
+{
+  EZ_LOCK(s_AsyncLogModeMutex);
+
+  ezAsyncLogQueue* pQueue = GetAsyncLogQueue();
+  return pQueue ? pQueue->GetDroppedMessageCount() : 0;
+}
+
+bool ezGlobalLog::QueueAsyncEvent(const ezLoggingEventData& le)
+{
+  if (GetAsyncLogQueue() == nullptr || tl_bIsDrainingAsyncLog)
+    return false;
+
+  s_iAsyncLogProducers.Increment();
+
+  // re-check, DisableAsyncMode() may have been called in between
+  ezAsyncLogQueue* pQueue = GetAsyncLogQueue();
+  if (pQueue == nullptr)
+  {
+    s_iAsyncLogProducers.Decrement();
+    return false;
+  }
+
+  pQueue->Enqueue(le);
+
+  s_iAsyncLogProducers.Decrement();
+  return true;
+}
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Logging_Implementation_AsyncLog);
@@ -26,16 +26,24 @@ static thread_local ezLogInterface* s_DefaultLogSystem = nullptr;
 
 ezEventSubscriptionID ezGlobalLog::AddLogWriter(ezLoggingEvent::Handler handler)
 {
+  // in async mode, a new writer should not receive events that were logged before it was added
+  FlushAsyncQueue();
+
   return s_LoggingEvent.AddEventHandler(handler);
 }
 
 void ezGlobalLog::RemoveLogWriter(ezLoggingEvent::Handler handler)
 {
+  // in async mode, the writer should still receive everything that was logged up to now
+  FlushAsyncQueue();
+
   s_LoggingEvent.RemoveEventHandler(handler);
 }
 
 void ezGlobalLog::RemoveLogWriter(ezEventSubscriptionID subscriptionID)
 {
+  FlushAsyncQueue();
+
   s_LoggingEvent.RemoveEventHandler(subscriptionID);
 }
 
@@ -76,7 +84,10 @@ void ezGlobalLog::HandleLogMessage(const ezLoggingEventData& le)
     if ((ThisType > ezLogMsgType::None) && (ThisType < ezLogMsgType::All))
       s_uiMessageCount[ThisType].Increment();
 
-    s_LoggingEvent.Broadcast(le);
+    if (!QueueAsyncEvent(le))
+    {
+      s_LoggingEvent.Broadcast(le);
+    }
   }
 }
 
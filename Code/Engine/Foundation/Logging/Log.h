@@ -103,6 +103,29 @@ public:
 };
 
 
+/// \brief Describes what happens to messages that are logged while the queue of the asynchronous log mode is full.
+struct EZ_FOUNDATION_DLL ezAsyncLogOverflowPolicy
+{
+  using StorageType = ezUInt8;
+
+  enum Enum : ezUInt8
+  {
+    Block,           ///< The logging thread waits until the writer thread has made room in the queue. Nothing is lost.
+    DropLowPriority, ///< Warnings and less important messages are dropped and counted. Errors, serious warnings, groups and flushes always block.
+    Default = Block,
+  };
+};
+
+/// \brief Configuration for ezGlobalLog::EnableAsyncMode().
+struct ezAsyncLogSettings
+{
+  /// \brief How many log events can be queued before the overflow policy kicks in. Rounded up to the next power of two.
+  ezUInt32 m_uiQueueCapacity = 1024;
+
+  /// \brief What to do with messages when the queue is full.
+  ezAsyncLogOverflowPolicy::Enum m_OverflowPolicy = ezAsyncLogOverflowPolicy::Block;
+};
+
 /// \brief This is the standard log system that ezLog sends all messages to.
 ///
 /// It allows to register log writers, such that you can be informed of all log messages and write them
@@ -132,7 +155,35 @@ public:
   /// override is set at the moment.
   static void SetGlobalLogOverride(ezLogInterface* pInterface);
 
+  /// \brief Switches the log writers to asynchronous mode.
+  ///
+  /// In this mode log events are copied into a fixed size lock-free queue and a dedicated thread passes them on to the registered log
+  /// writers, so logging threads never wait for (file) I/O. The message text is formatted on the logging thread, since format arguments
+  /// may reference temporary data. Events are delivered in the order in which they were queued.
+  /// Message counts (GetMessageCount()) and the global log override stay synchronous.
+  ///
+  /// Adding or removing a log writer flushes the queue first, so a removed writer still receives everything that was logged before.
+  /// The queue is also flushed by ezCrashHandler_WriteMiniDump and when the core systems shut down.
+  static void EnableAsyncMode(const ezAsyncLogSettings& settings = ezAsyncLogSettings());
+
+  /// \brief Delivers all queued events, stops the writer thread and switches back to synchronous logging.
+  static void DisableAsyncMode();
+
+  /// \brief Returns whether EnableAsyncMode() is currently active.
+  static bool IsAsyncModeEnabled();
+
+  /// \brief Blocks until all events that were queued before this call have been passed to the log writers, or until the timeout is reached.
+  ///
+  /// Returns true if everything was written. Does nothing (and returns true) when not in async mode.
+  static bool FlushAsyncQueue(ezTime timeout = ezTime::Seconds(10));
+
+  /// \brief Returns how many messages were dropped due to ezAsyncLogOverflowPolicy::DropLowPriority since async mode was enabled.
+  static ezUInt32 GetDroppedAsyncMessageCount();
+
 private:
+  /// \brief Passes the event on to the asynchronous queue. Returns false if it has to be broadcast directly.
+  static bool QueueAsyncEvent(const ezLoggingEventData& le);
+
   /// \brief Counts the number of messages of each type.
   static ezAtomicInteger32 s_uiMessageCount[ezLogMsgType::ENUM_COUNT];
 
@@ -145,6 +196,7 @@ private:
   EZ_DISALLOW_COPY_AND_ASSIGN(ezGlobalLog);
 
   friend class ezLog; // only ezLog may create instances of this class
+  friend class ezAsyncLogQueue;
   ezGlobalLog() = default;
 };
 
@@ -34,6 +34,15 @@ public:
     ezTime m_PerFrameAllocationTime;         ///< time spend on allocations in this frame
   };
 
+  /// \brief Number and total size of the allocations that one thread made, see SetThreadAllocationCountingEnabled().
+  struct ThreadAllocationCounter
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt64 m_uiNumAllocations = 0; ///< total number of allocations
+    ezUInt64 m_uiAllocationSize = 0; ///< total allocation size in bytes
+  };
+
   ezAllocatorBase();
   virtual ~ezAllocatorBase();
 
@@ -46,6 +55,23 @@ public:
   virtual ezAllocatorId GetId() const = 0;
   virtual Stats GetStats() const = 0;
 
+  /// \brief Enables counting the allocations of each thread, which can then be queried with GetThreadAllocationCounter().
+  ///
+  /// Only allocators that take their memory from the system count allocations, allocators that forward to a parent allocator don't,
+  /// so every allocation is counted once. Disabled by default, since it adds a thread local access to every allocation.
+  static void SetThreadAllocationCountingEnabled(bool bEnable);
+
+  /// \brief Returns whether SetThreadAllocationCountingEnabled() has been enabled.
+  static bool IsThreadAllocationCountingEnabled() { return s_bCountThreadAllocations; }
+
+  /// \brief Returns the allocations that the calling thread made while allocation counting was enabled.
+  static ThreadAllocationCounter GetThreadAllocationCounter();
+
+protected:
+  static void CountThreadAllocation(size_t uiSize);
+
+  static bool s_bCountThreadAllocations;
+
 private:
   EZ_DISALLOW_COPY_AND_ASSIGN(ezAllocatorBase);
 };
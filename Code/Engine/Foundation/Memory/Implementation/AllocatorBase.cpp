@@ -1,5 +1,8 @@
 #include <FoundationPCH.h>
 
+bool ezAllocatorBase::s_bCountThreadAllocations = false;
+static thread_local ezAllocatorBase::ThreadAllocationCounter s_ThreadAllocationCounter;
+
 void* ezAllocatorBase::Reallocate(void* ptr, size_t uiCurrentSize, size_t uiNewSize, size_t uiAlign)
 {
   void* pNewMem = Allocate(uiNewSize, uiAlign);
@@ -8,6 +11,26 @@ void* ezAllocatorBase::Reallocate(void* ptr, size_t uiCurrentSize, size_t uiNewS
   return pNewMem;
 }
 
+// static
+void ezAllocatorBase::SetThreadAllocationCountingEnabled(bool bEnable)
+{
+  s_bCountThreadAllocations = bEnable;
+}
+
+// static
+ezAllocatorBase::ThreadAllocationCounter ezAllocatorBase::GetThreadAllocationCounter()
+{
+  return s_ThreadAllocationCounter;
+}
+
+// static
+void ezAllocatorBase::CountThreadAllocation(size_t uiSize)
+{
+  ezAllocatorBase::ThreadAllocationCounter& counter = s_ThreadAllocationCounter;
+  ++counter.m_uiNumAllocations;
+  counter.m_uiAllocationSize += uiSize;
+}
+
 
 
 EZ_STATICLINK_FILE(Foundation, Foundation_Memory_Implementation_AllocatorBase);
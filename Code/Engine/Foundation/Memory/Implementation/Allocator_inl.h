@@ -46,7 +46,7 @@ EZ_FORCE_INLINE ezInternal::ezAllocatorImpl<A, TrackingFlags>::ezAllocatorImpl(c
 {
   if ((TrackingFlags & ezMemoryTrackingFlags::RegisterAllocator) != 0)
   {
-    EZ_CHECK_AT_COMPILETIME_MSG((TrackingFlags & ~ezMemoryTrackingFlags::All) == 0, "Invalid tracking flags");
+    EZ_CHECK_AT_COMPILETIME_MSG((TrackingFlags & ~(ezMemoryTrackingFlags::All | ezMemoryTrackingFlags::DisableThreadAllocationCounting)) == 0, "Invalid tracking flags");
     const ezUInt32 uiTrackingFlags = TrackingFlags;
     ezBitflags<ezMemoryTrackingFlags> flags = *reinterpret_cast<const ezBitflags<ezMemoryTrackingFlags>*>(&uiTrackingFlags);
     this->m_Id = ezMemoryTracker::RegisterAllocator(szName, flags, pParent != nullptr ? pParent->GetId() : ezAllocatorId());
@@ -78,6 +78,12 @@ void* ezInternal::ezAllocatorImpl<A, TrackingFlags>::Allocate(size_t uiSize, siz
   void* ptr = m_allocator.Allocate(uiSize, uiAlign);
   EZ_ASSERT_DEV(ptr != nullptr, "Could not allocate {0} bytes. Out of memory?", uiSize);
 
+  // allocators with a parent forward to it, so only count where the memory is actually taken from
+  if ((TrackingFlags & ezMemoryTrackingFlags::DisableThreadAllocationCounting) == 0 && s_bCountThreadAllocations && m_allocator.GetParent() == nullptr)
+  {
+    CountThreadAllocation(uiSize);
+  }
+
   if ((TrackingFlags & ezMemoryTrackingFlags::EnableAllocationTracking) != 0)
   {
     ezBitflags<ezMemoryTrackingFlags> flags;
@@ -158,6 +164,11 @@ void* ezInternal::ezAllocatorMixinReallocate<A, TrackingFlags, true>::Reallocate
 
   void* pNewMem = this->m_allocator.Reallocate(ptr, uiCurrentSize, uiNewSize, uiAlign);
 
+  if ((TrackingFlags & ezMemoryTrackingFlags::DisableThreadAllocationCounting) == 0 && ezAllocatorBase::s_bCountThreadAllocations && this->m_allocator.GetParent() == nullptr)
+  {
+    ezAllocatorBase::CountThreadAllocation(uiNewSize);
+  }
+
   if ((TrackingFlags & ezMemoryTrackingFlags::EnableAllocationTracking) != 0)
   {
     ezBitflags<ezMemoryTrackingFlags> flags;
@@ -17,7 +17,7 @@
 namespace
 {
   // no tracking for the tracker data itself
-  typedef ezAllocator<ezMemoryPolicies::ezHeapAllocation, 0> TrackerDataAllocator;
+  typedef ezAllocator<ezMemoryPolicies::ezHeapAllocation, ezMemoryTrackingFlags::DisableThreadAllocationCounting> TrackerDataAllocator;
 
   static TrackerDataAllocator* s_pTrackerDataAllocator;
 
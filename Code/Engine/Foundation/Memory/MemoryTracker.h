@@ -15,6 +15,8 @@ struct ezMemoryTrackingFlags
                                    ///< allocator implementation whether it collects usable stats or not.
     EnableAllocationTracking = EZ_BIT(1), ///< Enable tracking of individual allocations
     EnableStackTrace = EZ_BIT(2),         ///< Enable stack traces for each allocation
+    DisableThreadAllocationCounting = EZ_BIT(3), ///< Exclude the allocations from ezAllocatorBase::GetThreadAllocationCounter(), e.g. for internal
+                                                 ///< allocations of the memory tracker
 
     All = RegisterAllocator | EnableAllocationTracking | EnableStackTrace,
 
@@ -32,6 +34,7 @@ struct ezMemoryTrackingFlags
     StorageType RegisterAllocator : 1;
     StorageType EnableAllocationTracking : 1;
     StorageType EnableStackTrace : 1;
+    StorageType DisableThreadAllocationCounting : 1;
   };
 };
 
@@ -0,0 +1,378 @@
+#ifdef EZ_PROFILINGSAMPLER_LINUX_INL_H_INCLUDED
+#  error "This file must not be included twice."
+#endif
+
+#define EZ_PROFILINGSAMPLER_LINUX_INL_H_INCLUDED
+
+#include <Foundation/FoundationInternal.h>
+EZ_FOUNDATION_INTERNAL_HEADER
+
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <Foundation/Threading/Lock.h>
+#include <Foundation/Threading/Mutex.h>
+#include <Foundation/Threading/ThreadUtils.h>
+
+#include <cerrno>
+#include <csignal>
+#include <ctime>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+// older glibc versions don't expose the name of this field
+#ifndef sigev_notify_thread_id
+#  define sigev_notify_thread_id _sigev_un._tid
+#endif
+
+namespace
+{
+  enum
+  {
+    BUFFER_SIZE_STACK_SAMPLES = 512 * 1024,
+    NUM_STACK_SAMPLES = BUFFER_SIZE_STACK_SAMPLES / sizeof(ezProfilingSystem::StackSample),
+  };
+
+  /// \brief The sampling state of one thread.
+  ///
+  /// The samples are only written by the signal handler, which always runs on the sampled thread itself, so the ring buffer has a single
+  /// producer and needs no lock. Readers validate the copied samples against m_iNumSamples afterwards.
+  struct SampledThread
+  {
+    ezUInt64 m_uiThreadId = 0;
+    pid_t m_iKernelThreadId = 0;
+
+    /// The address range of the stack of the thread, the frame pointer chain is only followed inside of it.
+    ezUInt64 m_uiStackBegin = 0;
+    ezUInt64 m_uiStackEnd = 0;
+    clockid_t m_CpuClock = 0;
+    timer_t m_Timer = {};
+    bool m_bHasTimer = false;
+
+    ezAtomicBool m_bRecording;
+    ezAtomicInteger32 m_iInSignalHandler;
+
+    /// Total number of recorded samples, sample i is stored at i % NUM_STACK_SAMPLES.
+    ezAtomicInteger64 m_iNumSamples;
+    ezInt64 m_iNumClearedSamples = 0;
+    ezProfilingSystem::StackSample* m_pSamples = nullptr;
+  };
+
+  // Read by the signal handler. The initial-exec model avoids __tls_get_addr, which may allocate on the first access of a thread. In addition
+  // AddSampledThread() writes the variable before the timer of the thread is armed, so the handler never performs the first access.
+  static thread_local SampledThread* t_pSampledThread __attribute__((tls_model("initial-exec"))) = nullptr;
+
+  static ezMutex s_SampledThreadsMutex;
+  static ezDynamicArray<SampledThread*> s_SampledThreads;
+  static bool s_bSamplingActive = false;
+  static bool s_bSignalHandlerInstalled = false;
+  static ezTime s_SamplingInterval;
+
+  /// \brief Follows the frame pointer chain of the interrupted code, starting at the registers in \a pContext.
+  ///
+  /// backtrace() is not async-signal-safe, this only reads registers and the stack memory of the thread, so it can be used in the signal
+  /// handler. Stacks of code that was compiled without frame pointers end early, the first frame is always the interrupted instruction.
+  ezUInt32 WalkFramePointers(const ucontext_t* pContext, const SampledThread& thread, ezUInt64* pFrames, ezUInt32 uiMaxFrames)
+  {
+#if EZ_ENABLED(EZ_PLATFORM_ARCH_X86) && EZ_ENABLED(EZ_PLATFORM_64BIT)
+    const ezUInt64 uiPC = static_cast<ezUInt64>(pContext->uc_mcontext.gregs[REG_RIP]);
+    const ezUInt64 uiSP = static_cast<ezUInt64>(pContext->uc_mcontext.gregs[REG_RSP]);
+    ezUInt64 uiFP = static_cast<ezUInt64>(pContext->uc_mcontext.gregs[REG_RBP]);
+#elif EZ_ENABLED(EZ_PLATFORM_ARCH_ARM) && EZ_ENABLED(EZ_PLATFORM_64BIT)
+    const ezUInt64 uiPC = pContext->uc_mcontext.pc;
+    const ezUInt64 uiSP = pContext->uc_mcontext.sp;
+    ezUInt64 uiFP = pContext->uc_mcontext.regs[29];
+#else
+    const ezUInt64 uiPC = 0;
+    const ezUInt64 uiSP = 0;
+    ezUInt64 uiFP = 0;
+    return 0;
+#endif
+
+    ezUInt32 uiNumFrames = 0;
+    pFrames[uiNumFrames++] = uiPC;
+
+    // each frame record consists of the frame pointer of the caller and the return address
+    const ezUInt64 uiRecordSize = 2 * sizeof(ezUInt64);
+    ezUInt64 uiLowerBound = ezMath::Max(uiSP, thread.m_uiStackBegin);
+
+    while (uiNumFrames < uiMaxFrames)
+    {
+      // the stack grows downwards, so the records of the callers are always above the current one
+      if (uiFP < uiLowerBound || uiFP + uiRecordSize > thread.m_uiStackEnd || (uiFP % sizeof(ezUInt64)) != 0)
+        break;
+
+      const ezUInt64* pRecord = reinterpret_cast<const ezUInt64*>(uiFP);
+      if (pRecord[1] == 0)
+        break;
+
+      pFrames[uiNumFrames++] = pRecord[1];
+
+      uiLowerBound = uiFP + uiRecordSize;
+      uiFP = pRecord[0];
+    }
+
+    return uiNumFrames;
+  }
+
+  void SamplingSignalHandler(int iSignal, siginfo_t* pInfo, void* pContext)
+  {
+    SampledThread* pThread = t_pSampledThread;
+    if (pThread == nullptr)
+      return;
+
+    const int iErrno = errno;
+    pThread->m_iInSignalHandler.Increment();
+
+    if (pThread->m_bRecording)
+    {
+      const ezInt64 iIndex = pThread->m_iNumSamples;
+      ezProfilingSystem::StackSample& sample = pThread->m_pSamples[iIndex % NUM_STACK_SAMPLES];
+
+      sample.m_Time = ezTime::Now();
+      sample.m_uiNumFrames = WalkFramePointers(static_cast<const ucontext_t*>(pContext), *pThread, sample.m_Frames, ezProfilingSystem::StackSample::MAX_FRAMES);
+      sample.m_uiReserved = 0;
+
+      pThread->m_iNumSamples.Increment();
+    }
+
+    pThread->m_iInSignalHandler.Decrement();
+    errno = iErrno;
+  }
+
+  void StartSamplingThread(SampledThread& thread)
+  {
+    thread.m_pSamples = EZ_DEFAULT_NEW_RAW_BUFFER(ezProfilingSystem::StackSample, NUM_STACK_SAMPLES);
+    thread.m_iNumSamples = 0;
+    thread.m_iNumClearedSamples = 0;
+    thread.m_bRecording = true;
+
+    // the timer measures the CPU time of the thread, so threads that are waiting are not sampled
+    sigevent timerEvent = {};
+    timerEvent.sigev_notify = SIGEV_THREAD_ID;
+    timerEvent.sigev_signo = SIGPROF;
+    timerEvent.sigev_notify_thread_id = thread.m_iKernelThreadId;
+
+    if (timer_create(thread.m_CpuClock, &timerEvent, &thread.m_Timer) != 0)
+    {
+      ezLog::Warning("Could not create the sampling timer for thread {0}: errno {1}", thread.m_iKernelThreadId, errno);
+      return;
+    }
+
+    thread.m_bHasTimer = true;
+
+    const ezInt64 iIntervalNs = ezMath::Max<ezInt64>(static_cast<ezInt64>(s_SamplingInterval.GetNanoseconds()), 1000);
+
+    itimerspec timerSpec = {};
+    timerSpec.it_interval.tv_sec = static_cast<time_t>(iIntervalNs / 1000000000);
+    timerSpec.it_interval.tv_nsec = static_cast<long>(iIntervalNs % 1000000000);
+    timerSpec.it_value = timerSpec.it_interval;
+
+    if (timer_settime(thread.m_Timer, 0, &timerSpec, nullptr) != 0)
+    {
+      ezLog::Warning("Could not start the sampling timer for thread {0}: errno {1}", thread.m_iKernelThreadId, errno);
+    }
+  }
+
+  void StopSamplingThread(SampledThread& thread)
+  {
+    if (thread.m_bHasTimer)
+    {
+      timer_delete(thread.m_Timer);
+      thread.m_bHasTimer = false;
+    }
+
+    if (thread.m_pSamples == nullptr)
+      return;
+
+    // a signal may still be pending, wait until no handler uses the buffer anymore
+    thread.m_bRecording = false;
+    while (thread.m_iInSignalHandler > 0)
+    {
+      ezThreadUtils::YieldTimeSlice();
+    }
+
+    EZ_DEFAULT_DELETE_RAW_BUFFER(thread.m_pSamples);
+    thread.m_iNumSamples = 0;
+    thread.m_iNumClearedSamples = 0;
+  }
+} // namespace
+
+// static
+bool ezProfilingSystem::IsSamplingSupported()
+{
+  return true;
+}
+
+// static
+ezResult ezProfilingSystem::StartSampling(ezTime samplingInterval)
+{
+  StopSampling();
+
+  EZ_LOCK(s_SampledThreadsMutex);
+
+  if (!s_bSignalHandlerInstalled)
+  {
+    // the handler is never removed again, since signals of deleted timers may still be pending, and SIGPROF terminates the process by default
+    struct sigaction action = {};
+    action.sa_sigaction = SamplingSignalHandler;
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&action.sa_mask);
+
+    if (sigaction(SIGPROF, &action, nullptr) != 0)
+    {
+      ezLog::Error("Could not install the SIGPROF handler for the sampling profiler: errno {0}", errno);
+      return EZ_FAILURE;
+    }
+
+    s_bSignalHandlerInstalled = true;
+  }
+
+  s_SamplingInterval = samplingInterval;
+  s_bSamplingActive = true;
+
+  for (SampledThread* pThread : s_SampledThreads)
+  {
+    StartSamplingThread(*pThread);
+  }
+
+  return EZ_SUCCESS;
+}
+
+// static
+void ezProfilingSystem::StopSampling()
+{
+  EZ_LOCK(s_SampledThreadsMutex);
+
+  if (!s_bSamplingActive)
+    return;
+
+  s_bSamplingActive = false;
+
+  for (SampledThread* pThread : s_SampledThreads)
+  {
+    StopSamplingThread(*pThread);
+  }
+}
+
+// static
+bool ezProfilingSystem::IsSamplingActive()
+{
+  return s_bSamplingActive;
+}
+
+// static
+void ezProfilingSystem::AddSampledThread()
+{
+  if (t_pSampledThread != nullptr)
+    return;
+
+  SampledThread* pThread = EZ_DEFAULT_NEW(SampledThread);
+  pThread->m_uiThreadId = (ezUInt64)ezThreadUtils::GetCurrentThreadID();
+  pThread->m_iKernelThreadId = static_cast<pid_t>(syscall(SYS_gettid));
+
+  if (pthread_getcpuclockid(pthread_self(), &pThread->m_CpuClock) != 0)
+  {
+    EZ_DEFAULT_DELETE(pThread);
+    return;
+  }
+
+  // without the stack bounds, only the interrupted instruction is recorded
+  pthread_attr_t attributes;
+  if (pthread_getattr_np(pthread_self(), &attributes) == 0)
+  {
+    void* pStackAddress = nullptr;
+    size_t uiStackSize = 0;
+    if (pthread_attr_getstack(&attributes, &pStackAddress, &uiStackSize) == 0)
+    {
+      pThread->m_uiStackBegin = reinterpret_cast<ezUInt64>(pStackAddress);
+      pThread->m_uiStackEnd = pThread->m_uiStackBegin + uiStackSize;
+    }
+
+    pthread_attr_destroy(&attributes);
+  }
+
+  EZ_LOCK(s_SampledThreadsMutex);
+
+  // the thread-local state has to be set up before the thread can receive any sampling signal
+  t_pSampledThread = pThread;
+  s_SampledThreads.PushBack(pThread);
+
+  if (s_bSamplingActive)
+  {
+    StartSamplingThread(*pThread);
+  }
+}
+
+// static
+void ezProfilingSystem::RemoveSampledThread()
+{
+  SampledThread* pThread = t_pSampledThread;
+  if (pThread == nullptr)
+    return;
+
+  EZ_LOCK(s_SampledThreadsMutex);
+
+  StopSamplingThread(*pThread);
+  t_pSampledThread = nullptr;
+
+  s_SampledThreads.RemoveAndCopy(pThread);
+  EZ_DEFAULT_DELETE(pThread);
+}
+
+// static
+void ezProfilingSystem::CaptureStackSamples(ProfilingData& out_Capture)
+{
+  EZ_LOCK(s_SampledThreadsMutex);
+
+  for (SampledThread* pThread : s_SampledThreads)
+  {
+    if (pThread->m_pSamples == nullptr)
+      continue;
+
+    const ezInt64 iNumSamples = pThread->m_iNumSamples;
+    const ezInt64 iFirstSample = ezMath::Max<ezInt64>(iNumSamples - NUM_STACK_SAMPLES, pThread->m_iNumClearedSamples);
+
+    if (iFirstSample >= iNumSamples)
+      continue;
+
+    CPUScopesBufferFlat* pEventBuffer = nullptr;
+    for (CPUScopesBufferFlat& eventBuffer : out_Capture.m_AllEventBuffers)
+    {
+      if (eventBuffer.m_uiThreadId == pThread->m_uiThreadId)
+        pEventBuffer = &eventBuffer;
+    }
+
+    if (pEventBuffer == nullptr)
+    {
+      pEventBuffer = &out_Capture.m_AllEventBuffers.ExpandAndGetRef();
+      pEventBuffer->m_uiThreadId = pThread->m_uiThreadId;
+    }
+
+    const ezUInt32 uiFirstCopiedSample = pEventBuffer->m_StackSamples.GetCount();
+    for (ezInt64 i = iFirstSample; i < iNumSamples; ++i)
+    {
+      pEventBuffer->m_StackSamples.PushBack(pThread->m_pSamples[i % NUM_STACK_SAMPLES]);
+    }
+
+    // the thread keeps recording while the samples are copied, the oldest ones may have been overwritten in the mean time
+    const ezInt64 iFirstValidSample = pThread->m_iNumSamples - NUM_STACK_SAMPLES + 1;
+    if (iFirstSample < iFirstValidSample)
+    {
+      const ezInt64 iNumOverwritten = ezMath::Min(iFirstValidSample, iNumSamples) - iFirstSample;
+      pEventBuffer->m_StackSamples.RemoveAtAndCopy(uiFirstCopiedSample, static_cast<ezUInt32>(iNumOverwritten));
+    }
+  }
+}
+
+// static
+void ezProfilingSystem::ClearStackSamples()
+{
+  EZ_LOCK(s_SampledThreadsMutex);
+
+  for (SampledThread* pThread : s_SampledThreads)
+  {
+    pThread->m_iNumClearedSamples = pThread->m_iNumSamples;
+  }
+}
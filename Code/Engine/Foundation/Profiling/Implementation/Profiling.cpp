@@ -5,11 +5,32 @@
 #include <Foundation/Configuration/Startup.h>
 #include <Foundation/Containers/IdTable.h>
 #include <Foundation/Containers/StaticRingBuffer.h>
+#include <Foundation/IO/CompressedStreamZstd.h>
+#include <Foundation/IO/FileSystem/FileWriter.h>
 #include <Foundation/IO/JSONWriter.h>
 #include <Foundation/Memory/CommonAllocators.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Profiling/ProfilingCapture.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Threading/ThreadSignal.h>
 #include <Foundation/Threading/ThreadUtils.h>
 
+// also needed without EZ_USE_PROFILING, for reading captures
+void ezProfilingSystem::ProfilingData::Clear()
+{
+  m_uiFramesThreadID = 0;
+  m_uiGPUThreadID = 0;
+  m_uiProcessID = 0;
+  m_uiFrameCount = 0;
+
+  m_AllEventBuffers.Clear();
+  m_FrameStartTimes.Clear();
+  m_GPUScopes.Clear();
+  m_ThreadInfos.Clear();
+  m_Strings.Clear();
+  m_StackFrameSymbols.Clear();
+}
+
 #if EZ_ENABLED(EZ_USE_PROFILING)
 
 class ezProfileCaptureDataTransfer : public ezDataTransfer
@@ -21,6 +42,7 @@ private:
 
     ezProfilingSystem::ProfilingData profilingData;
     ezProfilingSystem::Capture(profilingData);
+    profilingData.ResolveStackFrameSymbols();
     profilingData.Write(dto.GetWriter()).IgnoreResult();
 
     dto.Transmit();
@@ -45,6 +67,20 @@ EZ_BEGIN_SUBSYSTEM_DECLARATION(Foundation, ProfilingSystem)
     ezProfilingSystem::Reset();
   }
 
+EZ_END_SUBSYSTEM_DECLARATION;
+
+EZ_BEGIN_SUBSYSTEM_DECLARATION(Foundation, ProfilingCaptureStream)
+
+  BEGIN_SUBSYSTEM_DEPENDENCIES
+    "FileSystem"
+  END_SUBSYSTEM_DEPENDENCIES
+
+  ON_CORESYSTEMS_SHUTDOWN
+  {
+    // the capture stream may write into a file, so it has to be closed before the file system shuts down
+    ezProfilingSystem::StopCaptureStream();
+  }
+
 EZ_END_SUBSYSTEM_DECLARATION;
 // clang-format on
 
@@ -59,6 +95,19 @@ namespace
   enum
   {
     BUFFER_SIZE_FRAMES = 120 * 60,
+    BUFFER_SIZE_COUNTER_SAMPLES = 256 * 1024,
+    BUFFER_SIZE_MARKERS = 64 * 1024,
+    BUFFER_SIZE_SCOPE_ALLOCATIONS = 64 * 1024,
+  };
+
+  /// \brief Allocation stats of a scope in a CpuScopesBuffer, which is identified by the number of scopes that were added before it.
+  struct RecordedScopeAllocations
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt64 m_uiScopeSerial;
+    ezUInt64 m_uiAllocationSize;
+    ezUInt32 m_uiNumAllocations;
   };
 
   typedef ezStaticRingBuffer<ezProfilingSystem::GPUScope, BUFFER_SIZE_OTHER_THREAD / sizeof(ezProfilingSystem::GPUScope)> GPUScopesBuffer;
@@ -71,6 +120,17 @@ namespace
 
     ezUInt64 m_uiThreadId = 0;
     bool IsMainThread() const { return m_uiThreadId == s_MainThreadId; }
+
+    // stored separately from the scopes, since only few scopes allocate and only while allocation counting is enabled
+    ezUInt64 m_uiNumAddedScopes = 0;
+    ezStaticRingBuffer<RecordedScopeAllocations, BUFFER_SIZE_SCOPE_ALLOCATIONS / sizeof(RecordedScopeAllocations)> m_ScopeAllocations;
+
+    ezStaticRingBuffer<ezProfilingSystem::CounterSample, BUFFER_SIZE_COUNTER_SAMPLES / sizeof(ezProfilingSystem::CounterSample)> m_CounterSamples;
+    ezStaticRingBuffer<ezProfilingSystem::Marker, BUFFER_SIZE_MARKERS / sizeof(ezProfilingSystem::Marker)> m_Markers;
+
+    // events that have not been written to the capture stream yet, see AppendToCaptureStream()
+    ezMutex m_StreamMutex;
+    ezDynamicArray<ezUInt8> m_StreamData;
   };
 
   template <ezUInt32 SizeInBytes>
@@ -109,33 +169,429 @@ namespace
   static ezDynamicArray<CpuScopesBufferBase*> s_AllCpuScopes;
   static ezMutex s_AllCpuScopesMutex;
 
+  CpuScopesBufferBase* GetOrCreateCurrentThreadBuffer()
+  {
+    CpuScopesBufferBase* pScopes = s_CpuScopes;
+
+    if (pScopes == nullptr)
+    {
+      if (ezThreadUtils::IsMainThread())
+      {
+        pScopes = EZ_DEFAULT_NEW(CpuScopesBuffer<BUFFER_SIZE_MAIN_THREAD>);
+      }
+      else
+      {
+        pScopes = EZ_DEFAULT_NEW(CpuScopesBuffer<BUFFER_SIZE_OTHER_THREAD>);
+      }
+
+      pScopes->m_uiThreadId = (ezUInt64)ezThreadUtils::GetCurrentThreadID();
+      s_CpuScopes = pScopes;
+
+      {
+        EZ_LOCK(s_AllCpuScopesMutex);
+        s_AllCpuScopes.PushBack(pScopes);
+      }
+    }
+
+    return pScopes;
+  }
+
   static GPUScopesBuffer* s_GPUScopes;
 
+  enum class StreamedEventType : ezUInt8
+  {
+    Scope,
+    CounterSample,
+    Marker,
+  };
+
+  /// \brief Header of an event in CpuScopesBufferBase::m_StreamData, followed by the length of the name as a varint and the name
+  /// (without terminator).
+  ///
+  /// Scopes use begin and end time, counter samples and markers only the begin time. m_fValue is only used by counter samples,
+  /// the allocation stats only by scopes.
+  struct StreamedEventHeader
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezTime m_BeginTime;
+    ezTime m_EndTime;
+    double m_fValue = 0.0;
+    const char* m_szFunctionName = nullptr;
+    ezUInt64 m_uiAllocationSize = 0;
+    ezUInt32 m_uiNumAllocations = 0;
+    StreamedEventType m_Type = StreamedEventType::Scope;
+  };
+
+  /// \brief Reads one event that was written by AppendToCaptureStream() and returns the position of the next one.
+  const ezUInt8* ReadStreamedEvent(const ezUInt8* pData, StreamedEventHeader& out_header, ezStringView& out_sName)
+  {
+    ezMemoryUtils::RawByteCopy(&out_header, pData, sizeof(StreamedEventHeader));
+    pData += sizeof(StreamedEventHeader);
+
+    ezUInt32 uiNameLength = 0;
+    for (ezUInt32 uiShift = 0;; uiShift += 7)
+    {
+      const ezUInt8 uiByte = *pData++;
+      uiNameLength |= static_cast<ezUInt32>(uiByte & 0x7F) << uiShift;
+
+      if ((uiByte & 0x80) == 0)
+        break;
+    }
+
+    out_sName = ezStringView(reinterpret_cast<const char*>(pData), reinterpret_cast<const char*>(pData) + uiNameLength);
+    return pData + uiNameLength;
+  }
+
+  class CaptureStreamThread : public ezThread
+  {
+  public:
+    CaptureStreamThread()
+      : ezThread("Profiling Capture Stream")
+    {
+    }
+
+    ezTime m_FlushInterval;
+    ezThreadSignal m_WakeUp;
+    ezAtomicBool m_bStop;
+
+  private:
+    virtual ezUInt32 Run() override;
+  };
+
+  struct CaptureStreamState
+  {
+    ezStreamWriter* m_pOutputStream = nullptr;
+    ezFileWriter m_File;
+#  ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+    ezCompressedStreamWriterZstd m_Compressor;
+#  endif
+
+    CaptureStreamThread m_Thread;
+
+    ezMutex m_FlushMutex;
+    ezProfilingCaptureWriter m_Writer;
+    bool m_bWriteFailed = false;
+    bool m_bFlushAfterEachBatch = false;
+
+    // token bucket for the bandwidth limit, in bytes of the uncompressed capture format
+    ezUInt32 m_uiMaxBytesPerSecond = 0;
+    double m_fByteBudget = 0.0;
+    ezTime m_LastFlushTime;
+    ezUInt64 m_uiNumDroppedEvents = 0;
+    ezDynamicArray<ezProfilingSystem::ThreadInfo> m_WrittenThreadInfos;
+
+    struct ThreadScopes
+    {
+      ezUInt64 m_uiThreadId = 0;
+      ezDynamicArray<ezUInt8> m_Data;
+    };
+
+    ezDynamicArray<ThreadScopes> m_TempScopes;
+    ezDynamicArray<ezTime> m_TempFrameStartTimes;
+    ezDynamicArray<ezProfilingSystem::GPUScope> m_TempGPUScopes;
+    ezDynamicArray<ezProfilingSystem::CounterSample> m_TempCounterSamples;
+    ezDynamicArray<ezProfilingSystem::Marker> m_TempMarkers;
+  };
+
+  static ezAtomicBool s_bCaptureStreamActive;
+  static CaptureStreamState* s_pCaptureStream = nullptr;
+  static ezMutex s_CaptureStreamMutex;
+
+  // frames and GPU scopes that have not been written to the capture stream yet
+  static ezMutex s_CaptureStreamDataMutex;
+  static ezDynamicArray<ezTime> s_StreamedFrameStartTimes;
+  static ezDynamicArray<ezProfilingSystem::GPUScope> s_StreamedGPUScopes;
+  static ezUInt64 s_uiStreamedFrameCount = 0;
+
+  void AppendToCaptureStream(CpuScopesBufferBase* pScopes, const StreamedEventHeader& header, const char* szName)
+  {
+    const ezUInt32 uiNameLength = ezStringUtils::GetStringElementCount(szName);
+
+    ezUInt8 nameLength[5];
+    ezUInt32 uiNameLengthBytes = 0;
+    for (ezUInt32 uiValue = uiNameLength;; uiValue >>= 7)
+    {
+      nameLength[uiNameLengthBytes++] = static_cast<ezUInt8>(uiValue >= 0x80 ? (uiValue | 0x80) : uiValue);
+
+      if (uiValue < 0x80)
+        break;
+    }
+
+    EZ_LOCK(pScopes->m_StreamMutex);
+
+    const ezUInt32 uiOffset = pScopes->m_StreamData.GetCount();
+    pScopes->m_StreamData.SetCountUninitialized(uiOffset + sizeof(StreamedEventHeader) + uiNameLengthBytes + uiNameLength);
+
+    ezUInt8* pData = pScopes->m_StreamData.GetData() + uiOffset;
+    ezMemoryUtils::RawByteCopy(pData, &header, sizeof(StreamedEventHeader));
+    pData += sizeof(StreamedEventHeader);
+    ezMemoryUtils::RawByteCopy(pData, nameLength, uiNameLengthBytes);
+    ezMemoryUtils::RawByteCopy(pData + uiNameLengthBytes, szName, uiNameLength);
+  }
+
+  /// \brief Writes everything that was recorded since the last call into the capture stream.
+  void FlushCaptureStream(CaptureStreamState& state)
+  {
+    EZ_LOCK(state.m_FlushMutex);
+
+    // only swap the buffers while holding the locks, the data is encoded and written afterwards
+    {
+      EZ_LOCK(s_AllCpuScopesMutex);
+
+      state.m_TempScopes.SetCount(s_AllCpuScopes.GetCount());
+      for (ezUInt32 i = 0; i < s_AllCpuScopes.GetCount(); ++i)
+      {
+        CpuScopesBufferBase* pScopes = s_AllCpuScopes[i];
+        state.m_TempScopes[i].m_uiThreadId = pScopes->m_uiThreadId;
+        state.m_TempScopes[i].m_Data.Clear();
+
+        EZ_LOCK(pScopes->m_StreamMutex);
+        state.m_TempScopes[i].m_Data.Swap(pScopes->m_StreamData);
+      }
+    }
+
+    ezUInt64 uiFrameCount = 0;
+    {
+      EZ_LOCK(s_CaptureStreamDataMutex);
+
+      state.m_TempFrameStartTimes.Clear();
+      state.m_TempFrameStartTimes.Swap(s_StreamedFrameStartTimes);
+      state.m_TempGPUScopes.Clear();
+      state.m_TempGPUScopes.Swap(s_StreamedGPUScopes);
+      uiFrameCount = s_uiStreamedFrameCount;
+    }
+
+    ezHybridArray<ezProfilingSystem::ThreadInfo, 16> newThreadInfos;
+    {
+      EZ_LOCK(s_ThreadInfosMutex);
+
+      for (const ezProfilingSystem::ThreadInfo& info : s_ThreadInfos)
+      {
+        bool bWritten = false;
+        for (const ezProfilingSystem::ThreadInfo& writtenInfo : state.m_WrittenThreadInfos)
+        {
+          bWritten |= writtenInfo.m_uiThreadId == info.m_uiThreadId && writtenInfo.m_sName == info.m_sName;
+        }
+
+        if (!bWritten)
+        {
+          newThreadInfos.PushBack(info);
+          state.m_WrittenThreadInfos.PushBack(info);
+        }
+      }
+    }
+
+    if (state.m_bWriteFailed)
+      return;
+
+    if (state.m_uiMaxBytesPerSecond > 0)
+    {
+      const ezTime now = ezTime::Now();
+
+      // allows bursts of up to one second worth of data
+      state.m_fByteBudget = ezMath::Min(state.m_fByteBudget + (now - state.m_LastFlushTime).GetSeconds() * state.m_uiMaxBytesPerSecond, static_cast<double>(state.m_uiMaxBytesPerSecond));
+      state.m_LastFlushTime = now;
+
+      // only the parts of the batch that fit into the remaining budget are sent, the size of the buffered events is used as an estimate
+      // of their encoded size. The rest is dropped, frames are still written, so the gap is visible in the timeline.
+      double fRemainingBudget = state.m_fByteBudget;
+
+      for (CaptureStreamState::ThreadScopes& threadScopes : state.m_TempScopes)
+      {
+        const double fSize = static_cast<double>(threadScopes.m_Data.GetCount());
+        if (fSize <= fRemainingBudget)
+        {
+          fRemainingBudget -= fSize;
+          continue;
+        }
+
+        const ezUInt8* pData = threadScopes.m_Data.GetData();
+        const ezUInt8* pDataEnd = pData + threadScopes.m_Data.GetCount();
+        while (pData < pDataEnd)
+        {
+          StreamedEventHeader header;
+          ezStringView sName;
+          pData = ReadStreamedEvent(pData, header, sName);
+
+          ++state.m_uiNumDroppedEvents;
+        }
+
+        threadScopes.m_Data.Clear();
+      }
+
+      if (static_cast<double>(state.m_TempGPUScopes.GetCount() * sizeof(ezProfilingSystem::GPUScope)) > fRemainingBudget)
+      {
+        state.m_uiNumDroppedEvents += state.m_TempGPUScopes.GetCount();
+        state.m_TempGPUScopes.Clear();
+      }
+    }
+
+    ezProfilingCaptureWriter& writer = state.m_Writer;
+    const ezUInt64 uiWrittenBytesBefore = writer.GetWrittenBytes();
+    ezResult res = writer.WriteThreadInfos(newThreadInfos);
+
+    for (const CaptureStreamState::ThreadScopes& threadScopes : state.m_TempScopes)
+    {
+      if (threadScopes.m_Data.IsEmpty())
+        continue;
+
+      state.m_TempCounterSamples.Clear();
+      state.m_TempMarkers.Clear();
+
+      writer.BeginCPUScopes(threadScopes.m_uiThreadId);
+
+      const ezUInt8* pData = threadScopes.m_Data.GetData();
+      const ezUInt8* pDataEnd = pData + threadScopes.m_Data.GetCount();
+      while (pData < pDataEnd)
+      {
+        StreamedEventHeader header;
+        ezStringView sName;
+        pData = ReadStreamedEvent(pData, header, sName);
+
+        if (header.m_Type == StreamedEventType::Scope)
+        {
+          writer.AddCPUScope(sName, header.m_szFunctionName, header.m_BeginTime, header.m_EndTime, header.m_uiNumAllocations, header.m_uiAllocationSize);
+        }
+        else if (header.m_Type == StreamedEventType::CounterSample)
+        {
+          ezProfilingSystem::CounterSample& sample = state.m_TempCounterSamples.ExpandAndGetRef();
+          sample.m_Time = header.m_BeginTime;
+          sample.m_fValue = header.m_fValue;
+          ezStringUtils::Copy(sample.m_szName, ezProfilingSystem::CounterSample::NAME_SIZE, sName.GetStartPointer(), sName.GetEndPointer());
+        }
+        else
+        {
+          ezProfilingSystem::Marker& marker = state.m_TempMarkers.ExpandAndGetRef();
+          marker.m_Time = header.m_BeginTime;
+          marker.m_szFunctionName = header.m_szFunctionName;
+          ezStringUtils::Copy(marker.m_szName, ezProfilingSystem::Marker::NAME_SIZE, sName.GetStartPointer(), sName.GetEndPointer());
+        }
+      }
+
+      if (writer.EndCPUScopes().Failed())
+        res = EZ_FAILURE;
+
+      if (writer.WriteCounterSamples(threadScopes.m_uiThreadId, state.m_TempCounterSamples).Failed())
+        res = EZ_FAILURE;
+
+      if (writer.WriteMarkers(threadScopes.m_uiThreadId, state.m_TempMarkers).Failed())
+        res = EZ_FAILURE;
+    }
+
+    if (!state.m_TempFrameStartTimes.IsEmpty() && writer.WriteFrames(state.m_TempFrameStartTimes, uiFrameCount).Failed())
+      res = EZ_FAILURE;
+
+    if (writer.WriteGPUScopes(state.m_TempGPUScopes).Failed())
+      res = EZ_FAILURE;
+
+    state.m_fByteBudget -= static_cast<double>(writer.GetWrittenBytes() - uiWrittenBytesBefore);
+
+    if (res.Succeeded() && state.m_bFlushAfterEachBatch && state.m_pOutputStream->Flush().Failed())
+      res = EZ_FAILURE;
+
+    if (res.Failed())
+    {
+      state.m_bWriteFailed = true;
+      ezLog::Error("Writing the profiling capture stream failed, no further data is written.");
+    }
+  }
+
+  ezUInt32 CaptureStreamThread::Run()
+  {
+    while (!m_bStop)
+    {
+      m_WakeUp.WaitForSignal(m_FlushInterval);
+      FlushCaptureStream(*s_pCaptureStream);
+    }
+
+    return 0;
+  }
+
+  ezResult BeginCaptureStream(CaptureStreamState* pState, ezStreamWriter* pOutputStream, ezTime flushInterval, ezUInt32 uiMaxBytesPerSecond)
+  {
+    pState->m_pOutputStream = pOutputStream;
+    pState->m_uiMaxBytesPerSecond = uiMaxBytesPerSecond;
+    pState->m_fByteBudget = uiMaxBytesPerSecond;
+    pState->m_LastFlushTime = ezTime::Now();
+
+#  if EZ_ENABLED(EZ_SUPPORTS_PROCESSES)
+    const ezOsProcessID uiProcessID = ezProcess::GetCurrentProcessID();
+#  else
+    const ezOsProcessID uiProcessID = 0;
+#  endif
+
+    // same virtual thread IDs as in ezProfilingSystem::Capture()
+    if (pState->m_Writer.Begin(pOutputStream, uiProcessID, 1, 0).Failed())
+    {
+      ezLog::Error("Failed to write the header of the profiling capture stream.");
+      return EZ_FAILURE;
+    }
+
+    // discard anything that was left over from a previous capture stream
+    {
+      EZ_LOCK(s_AllCpuScopesMutex);
+      for (CpuScopesBufferBase* pScopes : s_AllCpuScopes)
+      {
+        EZ_LOCK(pScopes->m_StreamMutex);
+        pScopes->m_StreamData.Clear();
+      }
+    }
+
+    {
+      EZ_LOCK(s_CaptureStreamDataMutex);
+      s_StreamedFrameStartTimes.Clear();
+      s_StreamedGPUScopes.Clear();
+      s_uiStreamedFrameCount = s_uiFrameCount;
+    }
+
+    s_pCaptureStream = pState;
+    s_bCaptureStreamActive = true;
+
+    pState->m_Thread.m_FlushInterval = flushInterval;
+    pState->m_Thread.Start();
+
+    return EZ_SUCCESS;
+  }
+
   static ezEventSubscriptionID s_PluginEventSubscription = 0;
   void PluginEvent(const ezPluginEvent& e)
   {
+    if (e.m_EventType == ezPluginEvent::BeforeUnloading)
+    {
+      // write the streamed scopes while their function names are still valid
+      EZ_LOCK(s_CaptureStreamMutex);
+
+      if (s_pCaptureStream != nullptr)
+      {
+        FlushCaptureStream(*s_pCaptureStream);
+      }
+    }
+
     if (e.m_EventType == ezPluginEvent::AfterUnloading)
     {
       // When a plugin is unloaded we need to clear all profiling data
       // since they can contain pointers to function names that don't exist anymore.
       ezProfilingSystem::Clear();
+
+      EZ_LOCK(s_CaptureStreamMutex);
+
+      if (s_pCaptureStream != nullptr)
+      {
+        EZ_LOCK(s_pCaptureStream->m_FlushMutex);
+        s_pCaptureStream->m_Writer.ClearFunctionNameCache();
+
+        EZ_LOCK(s_AllCpuScopesMutex);
+        for (CpuScopesBufferBase* pScopes : s_AllCpuScopes)
+        {
+          EZ_LOCK(pScopes->m_StreamMutex);
+          pScopes->m_StreamData.Clear();
+        }
+      }
     }
   }
 } // namespace
 
-void ezProfilingSystem::ProfilingData::Clear()
-{
-  m_uiFramesThreadID = 0;
-  m_uiGPUThreadID = 0;
-  m_uiProcessID = 0;
-  m_uiFrameCount = 0;
-
-  m_AllEventBuffers.Clear();
-  m_FrameStartTimes.Clear();
-  m_GPUScopes.Clear();
-  m_ThreadInfos.Clear();
-}
-
 void ezProfilingSystem::ProfilingData::Merge(ProfilingData& out_Merged, ezArrayPtr<const ProfilingData*> inputs)
 {
   out_Merged.Clear();
@@ -199,6 +655,9 @@ void ezProfilingSystem::ProfilingData::Merge(ProfilingData& out_Merged, ezArrayP
     struct CountAndIndex
     {
       ezUInt32 m_uiCount = 0;
+      ezUInt32 m_uiCounterSampleCount = 0;
+      ezUInt32 m_uiMarkerCount = 0;
+      ezUInt32 m_uiStackSampleCount = 0;
       ezUInt32 m_uiIndex = 0xFFFFFFFF;
     };
 
@@ -213,6 +672,9 @@ void ezProfilingSystem::ProfilingData::Merge(ProfilingData& out_Merged, ezArrayP
 
         ebInfo.m_uiIndex = ezMath::Min(ebInfo.m_uiIndex, eventBufferInfos.GetCount() - 1);
         ebInfo.m_uiCount += eb.m_Data.GetCount();
+        ebInfo.m_uiCounterSampleCount += eb.m_CounterSamples.GetCount();
+        ebInfo.m_uiMarkerCount += eb.m_Markers.GetCount();
+        ebInfo.m_uiStackSampleCount += eb.m_StackSamples.GetCount();
       }
     }
 
@@ -225,6 +687,9 @@ void ezProfilingSystem::ProfilingData::Merge(ProfilingData& out_Merged, ezArrayP
         auto& neb = out_Merged.m_AllEventBuffers[ebinfoIt.Value().m_uiIndex];
         neb.m_uiThreadId = ebinfoIt.Key();
         neb.m_Data.Reserve(ebinfoIt.Value().m_uiCount);
+        neb.m_CounterSamples.Reserve(ebinfoIt.Value().m_uiCounterSampleCount);
+        neb.m_Markers.Reserve(ebinfoIt.Value().m_uiMarkerCount);
+        neb.m_StackSamples.Reserve(ebinfoIt.Value().m_uiStackSampleCount);
       }
     }
 
@@ -235,10 +700,32 @@ void ezProfilingSystem::ProfilingData::Merge(ProfilingData& out_Merged, ezArrayP
       {
         const auto& ebInfo = eventBufferInfos[eb.m_uiThreadId];
 
-        out_Merged.m_AllEventBuffers[ebInfo.m_uiIndex].m_Data.PushBackRange(eb.m_Data);
+        auto& neb = out_Merged.m_AllEventBuffers[ebInfo.m_uiIndex];
+
+        const ezUInt32 uiFirstScopeIndex = neb.m_Data.GetCount();
+        for (const ScopeAllocations& allocations : eb.m_ScopeAllocations)
+        {
+          ScopeAllocations& mergedAllocations = neb.m_ScopeAllocations.ExpandAndGetRef();
+          mergedAllocations = allocations;
+          mergedAllocations.m_uiScopeIndex += uiFirstScopeIndex;
+        }
+
+        neb.m_Data.PushBackRange(eb.m_Data);
+        neb.m_CounterSamples.PushBackRange(eb.m_CounterSamples);
+        neb.m_Markers.PushBackRange(eb.m_Markers);
+        neb.m_StackSamples.PushBackRange(eb.m_StackSamples);
       }
     }
   }
+
+  // merge m_StackFrameSymbols
+  for (const auto& pd : inputs)
+  {
+    for (auto it = pd->m_StackFrameSymbols.GetIterator(); it.IsValid(); ++it)
+    {
+      out_Merged.m_StackFrameSymbols.Insert(it.Key(), it.Value());
+    }
+  }
 }
 
 ezResult ezProfilingSystem::ProfilingData::Write(ezStreamWriter& outputStream) const
@@ -343,7 +830,8 @@ ezResult ezProfilingSystem::ProfilingData::Write(ezStreamWriter& outputStream) c
     }
 
     // scoped events
-    ezDynamicArray<CPUScope> sortedScopes;
+    ezDynamicArray<ezUInt32> sortedScopes;
+    ezDynamicArray<ezUInt32> scopeAllocationIndices;
     for (const auto& eventBuffer : m_AllEventBuffers)
     {
       const ezUInt64 uiThreadId = eventBuffer.m_uiThreadId + 2;
@@ -352,11 +840,42 @@ ezResult ezProfilingSystem::ProfilingData::Write(ezStreamWriter& outputStream) c
       // we actually write nested scopes before their corresponding parent scope to the file. If both start at the same quantized time stamp
       // chrome prints the nested scope first and then scrambles everything.
       // So we sort by duration to make sure that parent scopes are written first in the json file.
-      sortedScopes = eventBuffer.m_Data;
-      sortedScopes.Sort([](const CPUScope& a, const CPUScope& b) { return (a.m_EndTime - a.m_BeginTime) > (b.m_EndTime - b.m_BeginTime); });
+      // Indices are sorted instead of the scopes, to be able to look up their allocations.
+      sortedScopes.SetCountUninitialized(eventBuffer.m_Data.GetCount());
+      for (ezUInt32 i = 0; i < sortedScopes.GetCount(); ++i)
+      {
+        sortedScopes[i] = i;
+      }
+
+      sortedScopes.Sort([&](ezUInt32 a, ezUInt32 b) {
+        const CPUScope& scopeA = eventBuffer.m_Data[a];
+        const CPUScope& scopeB = eventBuffer.m_Data[b];
+        return (scopeA.m_EndTime - scopeA.m_BeginTime) > (scopeB.m_EndTime - scopeB.m_BeginTime);
+      });
+
+      scopeAllocationIndices.Clear();
+      if (!eventBuffer.m_ScopeAllocations.IsEmpty())
+      {
+        scopeAllocationIndices.SetCount(eventBuffer.m_Data.GetCount(), ezInvalidIndex);
+        for (ezUInt32 i = 0; i < eventBuffer.m_ScopeAllocations.GetCount(); ++i)
+        {
+          const ezUInt32 uiScopeIndex = eventBuffer.m_ScopeAllocations[i].m_uiScopeIndex;
+          if (uiScopeIndex < scopeAllocationIndices.GetCount())
+          {
+            scopeAllocationIndices[uiScopeIndex] = i;
+          }
+        }
+      }
 
-      for (const CPUScope& e : sortedScopes)
+      for (ezUInt32 uiScopeIndex : sortedScopes)
       {
+        const CPUScope& e = eventBuffer.m_Data[uiScopeIndex];
+        const ScopeAllocations* pAllocations = nullptr;
+        if (!scopeAllocationIndices.IsEmpty() && scopeAllocationIndices[uiScopeIndex] != ezInvalidIndex)
+        {
+          pAllocations = &eventBuffer.m_ScopeAllocations[scopeAllocationIndices[uiScopeIndex]];
+        }
+
         writer.BeginObject();
         writer.AddVariableString("name", e.m_szName);
         writer.AddVariableUInt32("pid", m_uiProcessID);
@@ -364,10 +883,21 @@ ezResult ezProfilingSystem::ProfilingData::Write(ezStreamWriter& outputStream) c
         writer.AddVariableUInt64("ts", static_cast<ezUInt64>(e.m_BeginTime.GetMicroseconds()));
         writer.AddVariableString("ph", "B");
 
-        if (e.m_szFunctionName != nullptr)
+        if (e.m_szFunctionName != nullptr || pAllocations != nullptr)
         {
           writer.BeginObject("args");
-          writer.AddVariableString("function", e.m_szFunctionName);
+
+          if (e.m_szFunctionName != nullptr)
+          {
+            writer.AddVariableString("function", e.m_szFunctionName);
+          }
+
+          if (pAllocations != nullptr)
+          {
+            writer.AddVariableUInt32("allocations", pAllocations->m_uiNumAllocations);
+            writer.AddVariableUInt64("allocatedBytes", pAllocations->m_uiAllocationSize);
+          }
+
           writer.EndObject();
         }
 
@@ -384,10 +914,58 @@ ezResult ezProfilingSystem::ProfilingData::Write(ezStreamWriter& outputStream) c
           writer.EndObject();
         }
 
-        if (writer.HadWriteError())
+        if (writer.HadWriteError())
+        {
+          return EZ_FAILURE;
+        }
+      }
+    }
+
+    // counter samples and markers
+    for (const auto& eventBuffer : m_AllEventBuffers)
+    {
+      const ezUInt64 uiThreadId = eventBuffer.m_uiThreadId + 2;
+
+      // counters are shown as one track per name on the process
+      for (const CounterSample& e : eventBuffer.m_CounterSamples)
+      {
+        writer.BeginObject();
+        writer.AddVariableString("name", e.m_szName);
+        writer.AddVariableUInt32("pid", m_uiProcessID);
+        writer.AddVariableUInt64("tid", uiThreadId);
+        writer.AddVariableUInt64("ts", static_cast<ezUInt64>(e.m_Time.GetMicroseconds()));
+        writer.AddVariableString("ph", "C");
+
+        writer.BeginObject("args");
+        writer.AddVariableDouble(e.m_szName, e.m_fValue);
+        writer.EndObject();
+
+        writer.EndObject();
+      }
+
+      for (const Marker& e : eventBuffer.m_Markers)
+      {
+        writer.BeginObject();
+        writer.AddVariableString("name", e.m_szName);
+        writer.AddVariableUInt32("pid", m_uiProcessID);
+        writer.AddVariableUInt64("tid", uiThreadId);
+        writer.AddVariableUInt64("ts", static_cast<ezUInt64>(e.m_Time.GetMicroseconds()));
+        writer.AddVariableString("ph", "i");
+        writer.AddVariableString("s", "t");
+
+        if (e.m_szFunctionName != nullptr)
         {
-          return EZ_FAILURE;
+          writer.BeginObject("args");
+          writer.AddVariableString("function", e.m_szFunctionName);
+          writer.EndObject();
         }
+
+        writer.EndObject();
+      }
+
+      if (writer.HadWriteError())
+      {
+        return EZ_FAILURE;
       }
     }
 
@@ -457,6 +1035,113 @@ ezResult ezProfilingSystem::ProfilingData::Write(ezStreamWriter& outputStream) c
     writer.EndArray();
   }
 
+  // stack samples, each distinct call stack is stored once as a path in a tree of stack frames, which the samples reference
+  {
+    struct StackFrameKey
+    {
+      EZ_DECLARE_POD_TYPE();
+
+      ezUInt64 m_uiAddress;
+      ezUInt64 m_uiParentId;
+    };
+
+    struct StackFrameKeyHashHelper
+    {
+      static ezUInt32 Hash(const StackFrameKey& key) { return ezHashingUtils::xxHash32(&key, sizeof(StackFrameKey)); }
+      static bool Equal(const StackFrameKey& a, const StackFrameKey& b) { return a.m_uiAddress == b.m_uiAddress && a.m_uiParentId == b.m_uiParentId; }
+    };
+
+    // frame IDs start at 1, zero is used for 'no parent'
+    ezHashTable<StackFrameKey, ezUInt64, StackFrameKeyHashHelper> stackFrameIds;
+    ezDynamicArray<StackFrameKey> stackFrames;
+
+    auto getStackFrameId = [&](const StackSample& sample) -> ezUInt64 {
+      ezUInt64 uiId = 0;
+      for (ezUInt32 i = sample.m_uiNumFrames; i > 0; --i)
+      {
+        const StackFrameKey key = {sample.m_Frames[i - 1], uiId};
+        if (!stackFrameIds.TryGetValue(key, uiId))
+        {
+          stackFrames.PushBack(key);
+          uiId = stackFrames.GetCount();
+          stackFrameIds.Insert(key, uiId);
+        }
+      }
+
+      return uiId;
+    };
+
+    bool bHasSamples = false;
+    for (const auto& eventBuffer : m_AllEventBuffers)
+    {
+      if (eventBuffer.m_StackSamples.IsEmpty())
+        continue;
+
+      if (!bHasSamples)
+      {
+        writer.BeginArray("samples");
+        bHasSamples = true;
+      }
+
+      const ezUInt64 uiThreadId = eventBuffer.m_uiThreadId + 2;
+
+      for (const StackSample& sample : eventBuffer.m_StackSamples)
+      {
+        writer.BeginObject();
+        writer.AddVariableString("name", "CPU Sample");
+        writer.AddVariableUInt64("tid", uiThreadId);
+        writer.AddVariableUInt64("ts", static_cast<ezUInt64>(sample.m_Time.GetMicroseconds()));
+        writer.AddVariableUInt64("sf", getStackFrameId(sample));
+        writer.AddVariableUInt32("weight", 1);
+        writer.EndObject();
+      }
+
+      if (writer.HadWriteError())
+      {
+        return EZ_FAILURE;
+      }
+    }
+
+    if (bHasSamples)
+    {
+      writer.EndArray();
+
+      ezStringBuilder sId;
+      ezStringBuilder sAddress;
+
+      writer.BeginObject("stackFrames");
+      for (ezUInt32 i = 0; i < stackFrames.GetCount(); ++i)
+      {
+        const StackFrameKey& frame = stackFrames[i];
+
+        sId.Format("{0}", i + 1);
+        writer.BeginObject(sId);
+
+        const ezString* pSymbol = m_StackFrameSymbols.GetValue(frame.m_uiAddress);
+        if (pSymbol != nullptr)
+        {
+          writer.AddVariableString("name", *pSymbol);
+        }
+        else
+        {
+          sAddress.Format("0x{0}", ezArgU(frame.m_uiAddress, 16, true, 16));
+          writer.AddVariableString("name", sAddress);
+        }
+
+        writer.AddVariableString("category", "CPU");
+
+        if (frame.m_uiParentId != 0)
+        {
+          sId.Format("{0}", frame.m_uiParentId);
+          writer.AddVariableString("parent", sId);
+        }
+
+        writer.EndObject();
+      }
+      writer.EndObject();
+    }
+  }
+
   writer.EndObject();
 
   return writer.HadWriteError() ? EZ_FAILURE : EZ_SUCCESS;
@@ -477,9 +1162,15 @@ void ezProfilingSystem::Clear()
       {
         CastToOtherThreadEventBuffer(pEventBuffer)->m_Data.Clear();
       }
+
+      pEventBuffer->m_CounterSamples.Clear();
+      pEventBuffer->m_Markers.Clear();
+      pEventBuffer->m_ScopeAllocations.Clear();
     }
   }
 
+  ClearStackSamples();
+
   s_FrameStartTimes.Clear();
 
   if (s_GPUScopes != nullptr)
@@ -537,9 +1228,37 @@ void ezProfilingSystem::Capture(ezProfilingSystem::ProfilingData& profilingData,
         copiedEvent.m_EndTime = sourceEvent.m_EndTime;
         ezStringUtils::Copy(copiedEvent.m_szName, CPUScope::NAME_SIZE, sourceEvent.m_szName);
       }
+
+      // scopes that were already removed from the ring buffer have a serial below the first copied scope
+      const ezUInt64 uiFirstScopeSerial = sourceEventBuffer->m_uiNumAddedScopes - uiSourceCount;
+      for (ezUInt32 j = 0; j < sourceEventBuffer->m_ScopeAllocations.GetCount(); ++j)
+      {
+        const RecordedScopeAllocations& sourceAllocations = sourceEventBuffer->m_ScopeAllocations[j];
+        if (sourceAllocations.m_uiScopeSerial < uiFirstScopeSerial || sourceAllocations.m_uiScopeSerial - uiFirstScopeSerial >= uiSourceCount)
+          continue;
+
+        ScopeAllocations& copiedAllocations = targetEventBuffer.m_ScopeAllocations.ExpandAndGetRef();
+        copiedAllocations.m_uiScopeIndex = static_cast<ezUInt32>(sourceAllocations.m_uiScopeSerial - uiFirstScopeSerial);
+        copiedAllocations.m_uiNumAllocations = sourceAllocations.m_uiNumAllocations;
+        copiedAllocations.m_uiAllocationSize = sourceAllocations.m_uiAllocationSize;
+      }
+
+      targetEventBuffer.m_CounterSamples.SetCountUninitialized(sourceEventBuffer->m_CounterSamples.GetCount());
+      for (ezUInt32 j = 0; j < sourceEventBuffer->m_CounterSamples.GetCount(); ++j)
+      {
+        targetEventBuffer.m_CounterSamples[j] = sourceEventBuffer->m_CounterSamples[j];
+      }
+
+      targetEventBuffer.m_Markers.SetCountUninitialized(sourceEventBuffer->m_Markers.GetCount());
+      for (ezUInt32 j = 0; j < sourceEventBuffer->m_Markers.GetCount(); ++j)
+      {
+        targetEventBuffer.m_Markers[j] = sourceEventBuffer->m_Markers[j];
+      }
     }
   }
 
+  CaptureStackSamples(profilingData);
+
   profilingData.m_uiFrameCount = s_uiFrameCount;
 
   profilingData.m_FrameStartTimes.SetCountUninitialized(s_FrameStartTimes.GetCount());
@@ -574,47 +1293,52 @@ void ezProfilingSystem::SetDiscardThreshold(ezTime threshold)
   CVarDiscardThresholdMs = static_cast<float>(threshold.GetMilliseconds());
 }
 
+// static
+void ezProfilingSystem::SetAllocationCountingEnabled(bool bEnable)
+{
+  ezAllocatorBase::SetThreadAllocationCountingEnabled(bEnable);
+}
+
+// static
+bool ezProfilingSystem::IsAllocationCountingEnabled()
+{
+  return ezAllocatorBase::IsThreadAllocationCountingEnabled();
+}
+
 // static
 void ezProfilingSystem::StartNewFrame()
 {
   ++s_uiFrameCount;
 
+  const ezTime now = ezTime::Now();
+  const ezTime lastFrameStartTime = s_FrameStartTimes.IsEmpty() ? now : s_FrameStartTimes.PeekBack();
+
   if (!s_FrameStartTimes.CanAppend())
   {
     s_FrameStartTimes.PopFront();
   }
 
-  s_FrameStartTimes.PushBack(ezTime::Now());
+  s_FrameStartTimes.PushBack(now);
+
+  UpdateSpikeCapture(lastFrameStartTime, now);
+  UpdateTelemetryStream();
+
+  if (s_bCaptureStreamActive)
+  {
+    EZ_LOCK(s_CaptureStreamDataMutex);
+    s_StreamedFrameStartTimes.PushBack(now);
+    s_uiStreamedFrameCount = s_uiFrameCount;
+  }
 }
 
 // static
-void ezProfilingSystem::AddCPUScope(const char* szName, const char* szFunctionName, ezTime beginTime, ezTime endTime)
+void ezProfilingSystem::AddCPUScope(const char* szName, const char* szFunctionName, ezTime beginTime, ezTime endTime, ezUInt32 uiNumAllocations, ezUInt64 uiAllocationSize)
 {
-  // discard?
-  if (endTime - beginTime < ezTime::Milliseconds(CVarDiscardThresholdMs))
+  // discard? scopes that allocated are always kept, since finding those is the point of counting allocations
+  if (endTime - beginTime < ezTime::Milliseconds(CVarDiscardThresholdMs) && uiNumAllocations == 0)
     return;
 
-  ::CpuScopesBufferBase* pScopes = s_CpuScopes;
-
-  if (pScopes == nullptr)
-  {
-    if (ezThreadUtils::IsMainThread())
-    {
-      pScopes = EZ_DEFAULT_NEW(::CpuScopesBuffer<BUFFER_SIZE_MAIN_THREAD>);
-    }
-    else
-    {
-      pScopes = EZ_DEFAULT_NEW(::CpuScopesBuffer<BUFFER_SIZE_OTHER_THREAD>);
-    }
-
-    pScopes->m_uiThreadId = (ezUInt64)ezThreadUtils::GetCurrentThreadID();
-    s_CpuScopes = pScopes;
-
-    {
-      EZ_LOCK(s_AllCpuScopesMutex);
-      s_AllCpuScopes.PushBack(pScopes);
-    }
-  }
+  ::CpuScopesBufferBase* pScopes = GetOrCreateCurrentThreadBuffer();
 
   CPUScope scope;
   scope.m_szFunctionName = szFunctionName;
@@ -642,6 +1366,229 @@ void ezProfilingSystem::AddCPUScope(const char* szName, const char* szFunctionNa
 
     pOtherThreadBuffer->m_Data.PushBack(scope);
   }
+
+  if (uiNumAllocations > 0)
+  {
+    if (!pScopes->m_ScopeAllocations.CanAppend())
+    {
+      pScopes->m_ScopeAllocations.PopFront();
+    }
+
+    RecordedScopeAllocations allocations;
+    allocations.m_uiScopeSerial = pScopes->m_uiNumAddedScopes;
+    allocations.m_uiNumAllocations = uiNumAllocations;
+    allocations.m_uiAllocationSize = uiAllocationSize;
+    pScopes->m_ScopeAllocations.PushBack(allocations);
+  }
+
+  ++pScopes->m_uiNumAddedScopes;
+
+  if (s_bCaptureStreamActive)
+  {
+    StreamedEventHeader header;
+    header.m_BeginTime = beginTime;
+    header.m_EndTime = endTime;
+    header.m_szFunctionName = szFunctionName;
+    header.m_uiNumAllocations = uiNumAllocations;
+    header.m_uiAllocationSize = uiAllocationSize;
+    header.m_Type = StreamedEventType::Scope;
+    AppendToCaptureStream(pScopes, header, szName);
+  }
+}
+
+// static
+void ezProfilingSystem::AddCounterSample(const char* szName, double fValue)
+{
+  ::CpuScopesBufferBase* pScopes = GetOrCreateCurrentThreadBuffer();
+
+  CounterSample sample;
+  sample.m_Time = ezTime::Now();
+  sample.m_fValue = fValue;
+  ezStringUtils::Copy(sample.m_szName, EZ_ARRAY_SIZE(sample.m_szName), szName);
+
+  if (!pScopes->m_CounterSamples.CanAppend())
+  {
+    pScopes->m_CounterSamples.PopFront();
+  }
+
+  pScopes->m_CounterSamples.PushBack(sample);
+
+  if (s_bCaptureStreamActive)
+  {
+    StreamedEventHeader header;
+    header.m_BeginTime = sample.m_Time;
+    header.m_EndTime = sample.m_Time;
+    header.m_fValue = fValue;
+    header.m_Type = StreamedEventType::CounterSample;
+    AppendToCaptureStream(pScopes, header, szName);
+  }
+}
+
+// static
+void ezProfilingSystem::AddMarker(const char* szName, const char* szFunctionName)
+{
+  ::CpuScopesBufferBase* pScopes = GetOrCreateCurrentThreadBuffer();
+
+  Marker marker;
+  marker.m_szFunctionName = szFunctionName;
+  marker.m_Time = ezTime::Now();
+  ezStringUtils::Copy(marker.m_szName, EZ_ARRAY_SIZE(marker.m_szName), szName);
+
+  if (!pScopes->m_Markers.CanAppend())
+  {
+    pScopes->m_Markers.PopFront();
+  }
+
+  pScopes->m_Markers.PushBack(marker);
+
+  if (s_bCaptureStreamActive)
+  {
+    StreamedEventHeader header;
+    header.m_BeginTime = marker.m_Time;
+    header.m_EndTime = marker.m_Time;
+    header.m_szFunctionName = szFunctionName;
+    header.m_Type = StreamedEventType::Marker;
+    AppendToCaptureStream(pScopes, header, szName);
+  }
+}
+
+// static
+ezResult ezProfilingSystem::StartCaptureStream(const char* szFile, ezTime flushInterval)
+{
+  EZ_LOCK(s_CaptureStreamMutex);
+
+  if (s_pCaptureStream != nullptr)
+  {
+    ezLog::Error("A profiling capture stream is already active.");
+    return EZ_FAILURE;
+  }
+
+  CaptureStreamState* pState = EZ_DEFAULT_NEW(CaptureStreamState);
+
+  if (pState->m_File.Open(szFile).Failed())
+  {
+    ezLog::Error("Failed to open '{0}' for the profiling capture stream.", szFile);
+    EZ_DEFAULT_DELETE(pState);
+    return EZ_FAILURE;
+  }
+
+#  ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  pState->m_Compressor.SetOutputStream(&pState->m_File);
+  ezStreamWriter* pOutputStream = &pState->m_Compressor;
+#  else
+  ezStreamWriter* pOutputStream = &pState->m_File;
+#  endif
+
+  if (BeginCaptureStream(pState, pOutputStream, flushInterval, 0).Failed())
+  {
+    EZ_DEFAULT_DELETE(pState);
+    return EZ_FAILURE;
+  }
+
+  return EZ_SUCCESS;
+}
+
+// static
+ezResult ezProfilingSystem::StartCaptureStream(ezStreamWriter* pOutputStream, ezTime flushInterval, ezUInt32 uiMaxBytesPerSecond)
+{
+  EZ_LOCK(s_CaptureStreamMutex);
+
+  if (s_pCaptureStream != nullptr)
+  {
+    ezLog::Error("A profiling capture stream is already active.");
+    return EZ_FAILURE;
+  }
+
+  CaptureStreamState* pState = EZ_DEFAULT_NEW(CaptureStreamState);
+  pState->m_bFlushAfterEachBatch = true;
+
+  if (BeginCaptureStream(pState, pOutputStream, flushInterval, uiMaxBytesPerSecond).Failed())
+  {
+    EZ_DEFAULT_DELETE(pState);
+    return EZ_FAILURE;
+  }
+
+  return EZ_SUCCESS;
+}
+
+// static
+void ezProfilingSystem::StopCaptureStream()
+{
+  EZ_LOCK(s_CaptureStreamMutex);
+
+  CaptureStreamState* pState = s_pCaptureStream;
+  if (pState == nullptr)
+    return;
+
+  s_bCaptureStreamActive = false;
+
+  pState->m_Thread.m_bStop = true;
+  pState->m_Thread.m_WakeUp.RaiseSignal();
+  pState->m_Thread.Join();
+
+  // everything that was recorded until now
+  FlushCaptureStream(*pState);
+
+#  ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  if (pState->m_pOutputStream == &pState->m_Compressor)
+  {
+    pState->m_Compressor.FinishCompressedStream().IgnoreResult();
+  }
+#  endif
+
+  if (pState->m_File.IsOpen())
+  {
+    pState->m_File.Close();
+  }
+  else
+  {
+    pState->m_pOutputStream->Flush().IgnoreResult();
+  }
+
+  if (pState->m_uiNumDroppedEvents > 0)
+  {
+    ezLog::Info("{0} profiling events were not streamed, to stay within the bandwidth limit.", pState->m_uiNumDroppedEvents);
+  }
+
+  s_pCaptureStream = nullptr;
+  EZ_DEFAULT_DELETE(pState);
+
+  // the flushes swap buffers with the pending data, release whatever ended up there
+  {
+    EZ_LOCK(s_AllCpuScopesMutex);
+
+    for (CpuScopesBufferBase* pScopes : s_AllCpuScopes)
+    {
+      EZ_LOCK(pScopes->m_StreamMutex);
+      pScopes->m_StreamData.Clear();
+      pScopes->m_StreamData.Compact();
+    }
+  }
+
+  {
+    EZ_LOCK(s_CaptureStreamDataMutex);
+    s_StreamedFrameStartTimes.Clear();
+    s_StreamedFrameStartTimes.Compact();
+    s_StreamedGPUScopes.Clear();
+    s_StreamedGPUScopes.Compact();
+  }
+}
+
+// static
+void ezProfilingSystem::StopCaptureStream(const ezStreamWriter* pOutputStream)
+{
+  EZ_LOCK(s_CaptureStreamMutex);
+
+  if (s_pCaptureStream != nullptr && s_pCaptureStream->m_pOutputStream == pOutputStream)
+  {
+    StopCaptureStream();
+  }
+}
+
+// static
+bool ezProfilingSystem::IsCaptureStreamActive()
+{
+  return s_bCaptureStreamActive;
 }
 
 // static
@@ -692,16 +1639,22 @@ void ezProfilingSystem::Reset()
 // static
 void ezProfilingSystem::SetThreadName(const char* szThreadName)
 {
-  EZ_LOCK(s_ThreadInfosMutex);
+  {
+    EZ_LOCK(s_ThreadInfosMutex);
 
-  ThreadInfo& info = s_ThreadInfos.ExpandAndGetRef();
-  info.m_uiThreadId = (ezUInt64)ezThreadUtils::GetCurrentThreadID();
-  info.m_sName = szThreadName;
+    ThreadInfo& info = s_ThreadInfos.ExpandAndGetRef();
+    info.m_uiThreadId = (ezUInt64)ezThreadUtils::GetCurrentThreadID();
+    info.m_sName = szThreadName;
+  }
+
+  AddSampledThread();
 }
 
 // static
 void ezProfilingSystem::RemoveThread()
 {
+  RemoveSampledThread();
+
   EZ_LOCK(s_ThreadInfosMutex);
 
   s_DeadThreadIDs.PushBack((ezUInt64)ezThreadUtils::GetCurrentThreadID());
@@ -733,6 +1686,12 @@ void ezProfilingSystem::AddGPUScope(const char* szName, ezTime beginTime, ezTime
   ezStringUtils::Copy(scope.m_szName, EZ_ARRAY_SIZE(scope.m_szName), szName);
 
   s_GPUScopes->PushBack(scope);
+
+  if (s_bCaptureStreamActive)
+  {
+    EZ_LOCK(s_CaptureStreamDataMutex);
+    s_StreamedGPUScopes.PushBack(scope);
+  }
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -741,12 +1700,33 @@ ezProfilingScope::ezProfilingScope(const char* szName, const char* szFunctionNam
   : m_szName(szName)
   , m_szFunction(szFunctionName)
   , m_BeginTime(ezTime::Now())
+  , m_uiBeginNumAllocations(0)
+  , m_uiBeginAllocationSize(0)
+  , m_bCountAllocations(ezAllocatorBase::IsThreadAllocationCountingEnabled())
 {
+  if (m_bCountAllocations)
+  {
+    const ezAllocatorBase::ThreadAllocationCounter counter = ezAllocatorBase::GetThreadAllocationCounter();
+    m_uiBeginNumAllocations = counter.m_uiNumAllocations;
+    m_uiBeginAllocationSize = counter.m_uiAllocationSize;
+  }
 }
 
 ezProfilingScope::~ezProfilingScope()
 {
-  ezProfilingSystem::AddCPUScope(m_szName, m_szFunction, m_BeginTime, ezTime::Now());
+  const ezTime endTime = ezTime::Now();
+
+  ezUInt32 uiNumAllocations = 0;
+  ezUInt64 uiAllocationSize = 0;
+
+  if (m_bCountAllocations)
+  {
+    const ezAllocatorBase::ThreadAllocationCounter counter = ezAllocatorBase::GetThreadAllocationCounter();
+    uiNumAllocations = static_cast<ezUInt32>(counter.m_uiNumAllocations - m_uiBeginNumAllocations);
+    uiAllocationSize = counter.m_uiAllocationSize - m_uiBeginAllocationSize;
+  }
+
+  ezProfilingSystem::AddCPUScope(m_szName, m_szFunction, m_BeginTime, endTime, uiNumAllocations, uiAllocationSize);
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -798,9 +1778,39 @@ void ezProfilingSystem::Capture(ezProfilingSystem::ProfilingData& out_Capture, b
 
 void ezProfilingSystem::SetDiscardThreshold(ezTime threshold) {}
 
+void ezProfilingSystem::SetAllocationCountingEnabled(bool bEnable) {}
+
+bool ezProfilingSystem::IsAllocationCountingEnabled()
+{
+  return false;
+}
+
 void ezProfilingSystem::StartNewFrame() {}
 
-void ezProfilingSystem::AddCPUScope(const char* szName, const char* szFunctionName, ezTime beginTime, ezTime endTime) {}
+void ezProfilingSystem::AddCPUScope(const char* szName, const char* szFunctionName, ezTime beginTime, ezTime endTime, ezUInt32 uiNumAllocations, ezUInt64 uiAllocationSize) {}
+
+void ezProfilingSystem::AddCounterSample(const char* szName, double fValue) {}
+
+void ezProfilingSystem::AddMarker(const char* szName, const char* szFunctionName) {}
+
+ezResult ezProfilingSystem::StartCaptureStream(const char* szFile, ezTime flushInterval)
+{
+  return EZ_FAILURE;
+}
+
+ezResult ezProfilingSystem::StartCaptureStream(ezStreamWriter* pOutputStream, ezTime flushInterval, ezUInt32 uiMaxBytesPerSecond)
+{
+  return EZ_FAILURE;
+}
+
+void ezProfilingSystem::StopCaptureStream() {}
+
+void ezProfilingSystem::StopCaptureStream(const ezStreamWriter* pOutputStream) {}
+
+bool ezProfilingSystem::IsCaptureStreamActive()
+{
+  return false;
+}
 
 void ezProfilingSystem::Initialize() {}
 
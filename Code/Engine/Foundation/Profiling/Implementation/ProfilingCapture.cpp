@@ -0,0 +1,804 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/IO/Stream.h>
+#include <Foundation/Profiling/ProfilingCapture.h>
+#include <Foundation/Strings/HashedString.h>
+
+namespace
+{
+  void AppendVarUInt(ezDynamicArray<ezUInt8>& inout_Data, ezUInt64 uiValue)
+  {
+    while (uiValue >= 0x80)
+    {
+      inout_Data.PushBack(static_cast<ezUInt8>(uiValue | 0x80));
+      uiValue >>= 7;
+    }
+
+    inout_Data.PushBack(static_cast<ezUInt8>(uiValue));
+  }
+
+  void AppendVarInt(ezDynamicArray<ezUInt8>& inout_Data, ezInt64 iValue)
+  {
+    // zig-zag encoding, so that small negative deltas stay small as well
+    AppendVarUInt(inout_Data, (static_cast<ezUInt64>(iValue) << 1) ^ static_cast<ezUInt64>(iValue >> 63));
+  }
+
+  void AppendUInt64(ezDynamicArray<ezUInt8>& inout_Data, ezUInt64 uiValue)
+  {
+    const ezUInt32 uiOffset = inout_Data.GetCount();
+    inout_Data.SetCountUninitialized(uiOffset + sizeof(ezUInt64));
+    ezMemoryUtils::RawByteCopy(inout_Data.GetData() + uiOffset, &uiValue, sizeof(ezUInt64));
+  }
+
+  ezInt64 ToNanoseconds(ezTime t)
+  {
+    return static_cast<ezInt64>(ezMath::Round(t.GetNanoseconds()));
+  }
+
+  /// \brief Reads the values of one chunk. Reading past the end of the chunk sets m_bError and returns zeros.
+  struct ezProfilingCaptureChunkReader
+  {
+    ezProfilingCaptureChunkReader(ezArrayPtr<const ezUInt8> data)
+      : m_pCur(data.GetPtr())
+      , m_pEnd(data.GetPtr() + data.GetCount())
+    {
+    }
+
+    bool IsAtEnd() const { return m_pCur >= m_pEnd; }
+
+    ezUInt64 ReadVarUInt()
+    {
+      ezUInt64 uiResult = 0;
+
+      for (ezUInt32 uiShift = 0; uiShift < 64; uiShift += 7)
+      {
+        if (m_pCur >= m_pEnd)
+          break;
+
+        const ezUInt8 uiByte = *m_pCur++;
+        uiResult |= static_cast<ezUInt64>(uiByte & 0x7F) << uiShift;
+
+        if ((uiByte & 0x80) == 0)
+          return uiResult;
+      }
+
+      m_bError = true;
+      return 0;
+    }
+
+    ezInt64 ReadVarInt()
+    {
+      const ezUInt64 uiValue = ReadVarUInt();
+      return static_cast<ezInt64>(uiValue >> 1) ^ -static_cast<ezInt64>(uiValue & 1);
+    }
+
+    ezUInt64 ReadUInt64()
+    {
+      ezUInt64 uiValue = 0;
+
+      if (m_pEnd - m_pCur < static_cast<ptrdiff_t>(sizeof(ezUInt64)))
+      {
+        m_bError = true;
+        return 0;
+      }
+
+      ezMemoryUtils::RawByteCopy(&uiValue, m_pCur, sizeof(ezUInt64));
+      m_pCur += sizeof(ezUInt64);
+      return uiValue;
+    }
+
+    ezStringView ReadStringData(ezUInt64 uiLength)
+    {
+      if (static_cast<ezUInt64>(m_pEnd - m_pCur) < uiLength)
+      {
+        m_bError = true;
+        return ezStringView();
+      }
+
+      const char* szStart = reinterpret_cast<const char*>(m_pCur);
+      m_pCur += uiLength;
+      return ezStringView(szStart, szStart + uiLength);
+    }
+
+    const ezUInt8* m_pCur = nullptr;
+    const ezUInt8* m_pEnd = nullptr;
+    bool m_bError = false;
+  };
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+
+ezProfilingCaptureWriter::ezProfilingCaptureWriter() = default;
+ezProfilingCaptureWriter::~ezProfilingCaptureWriter() = default;
+
+ezResult ezProfilingCaptureWriter::Begin(ezStreamWriter* pOutputStream, ezOsProcessID uiProcessID, ezUInt64 uiFramesThreadID, ezUInt64 uiGPUThreadID)
+{
+  m_pOutputStream = pOutputStream;
+  m_uiWrittenBytes = 0;
+  m_StringHashToIndex.Clear();
+  m_FunctionNameToIndex.Clear();
+  m_Strings.Clear();
+  m_uiWrittenStrings = 0;
+  m_bInCPUScopes = false;
+
+  EZ_SUCCEED_OR_RETURN(m_pOutputStream->WriteBytes(ezProfilingCaptureFormat::Magic, sizeof(ezProfilingCaptureFormat::Magic)));
+  EZ_SUCCEED_OR_RETURN(m_pOutputStream->WriteBytes(&ezProfilingCaptureFormat::Version, sizeof(ezUInt8)));
+  m_uiWrittenBytes += sizeof(ezProfilingCaptureFormat::Magic) + sizeof(ezUInt8);
+
+  m_ChunkData.Clear();
+  AppendVarUInt(m_ChunkData, static_cast<ezUInt64>(uiProcessID));
+  AppendVarUInt(m_ChunkData, uiFramesThreadID);
+  AppendVarUInt(m_ChunkData, uiGPUThreadID);
+  return WriteChunk(ezProfilingCaptureFormat::ChunkType::Process, m_ChunkData);
+}
+
+ezResult ezProfilingCaptureWriter::WriteThreadInfos(ezArrayPtr<const ezProfilingSystem::ThreadInfo> threadInfos)
+{
+  EZ_ASSERT_DEV(!m_bInCPUScopes, "Chunks cannot be nested");
+
+  if (threadInfos.IsEmpty())
+    return EZ_SUCCESS;
+
+  m_ChunkData.Clear();
+  for (const ezProfilingSystem::ThreadInfo& info : threadInfos)
+  {
+    AppendUInt64(m_ChunkData, info.m_uiThreadId);
+    AppendVarUInt(m_ChunkData, InternString(info.m_sName));
+  }
+
+  EZ_SUCCEED_OR_RETURN(WritePendingStrings());
+  return WriteChunk(ezProfilingCaptureFormat::ChunkType::Threads, m_ChunkData);
+}
+
+ezResult ezProfilingCaptureWriter::WriteFrames(ezArrayPtr<const ezTime> frameStartTimes, ezUInt64 uiFrameCount)
+{
+  EZ_ASSERT_DEV(!m_bInCPUScopes, "Chunks cannot be nested");
+
+  m_ChunkData.Clear();
+  AppendVarUInt(m_ChunkData, uiFrameCount);
+
+  ezInt64 iPrevTimestamp = 0;
+  for (ezTime startTime : frameStartTimes)
+  {
+    const ezInt64 iTimestamp = ToNanoseconds(startTime);
+    AppendVarInt(m_ChunkData, iTimestamp - iPrevTimestamp);
+    iPrevTimestamp = iTimestamp;
+  }
+
+  return WriteChunk(ezProfilingCaptureFormat::ChunkType::Frames, m_ChunkData);
+}
+
+void ezProfilingCaptureWriter::BeginCPUScopes(ezUInt64 uiThreadID)
+{
+  EZ_ASSERT_DEV(!m_bInCPUScopes, "Chunks cannot be nested");
+  m_bInCPUScopes = true;
+
+  m_ChunkData.Clear();
+  AppendUInt64(m_ChunkData, uiThreadID);
+  m_AllocationChunkData.Clear();
+  m_iPrevTimestamp = 0;
+  m_uiNumScopes = 0;
+  m_uiPrevAllocatingScope = 0;
+}
+
+void ezProfilingCaptureWriter::AddCPUScope(ezStringView sName, const char* szFunctionName, ezTime beginTime, ezTime endTime, ezUInt32 uiNumAllocations, ezUInt64 uiAllocationSize)
+{
+  EZ_ASSERT_DEBUG(m_bInCPUScopes, "BeginCPUScopes() has not been called");
+
+  const ezInt64 iBegin = ToNanoseconds(beginTime);
+
+  AppendVarUInt(m_ChunkData, InternString(sName));
+  AppendVarUInt(m_ChunkData, InternFunctionName(szFunctionName));
+  AppendVarInt(m_ChunkData, iBegin - m_iPrevTimestamp);
+
+  // zero is reserved for scopes that have not ended
+  AppendVarUInt(m_ChunkData, endTime.IsPositive() ? static_cast<ezUInt64>(ezMath::Max<ezInt64>(ToNanoseconds(endTime) - iBegin, 0)) + 1 : 0);
+
+  m_iPrevTimestamp = iBegin;
+
+  // most scopes don't allocate, so the counts are stored separately, referencing the scopes by index
+  if (uiNumAllocations > 0)
+  {
+    AppendVarUInt(m_AllocationChunkData, m_uiNumScopes - m_uiPrevAllocatingScope);
+    AppendVarUInt(m_AllocationChunkData, uiNumAllocations);
+    AppendVarUInt(m_AllocationChunkData, uiAllocationSize);
+    m_uiPrevAllocatingScope = m_uiNumScopes;
+  }
+
+  ++m_uiNumScopes;
+}
+
+ezResult ezProfilingCaptureWriter::EndCPUScopes()
+{
+  EZ_ASSERT_DEV(m_bInCPUScopes, "BeginCPUScopes() has not been called");
+  m_bInCPUScopes = false;
+
+  // only the thread ID
+  if (m_ChunkData.GetCount() == sizeof(ezUInt64))
+    return EZ_SUCCESS;
+
+  EZ_SUCCEED_OR_RETURN(WritePendingStrings());
+  EZ_SUCCEED_OR_RETURN(WriteChunk(ezProfilingCaptureFormat::ChunkType::CPUScopes, m_ChunkData));
+
+  if (m_AllocationChunkData.IsEmpty())
+    return EZ_SUCCESS;
+
+  return WriteChunk(ezProfilingCaptureFormat::ChunkType::ScopeAllocations, m_AllocationChunkData);
+}
+
+ezResult ezProfilingCaptureWriter::WriteGPUScopes(ezArrayPtr<const ezProfilingSystem::GPUScope> scopes)
+{
+  EZ_ASSERT_DEV(!m_bInCPUScopes, "Chunks cannot be nested");
+
+  if (scopes.IsEmpty())
+    return EZ_SUCCESS;
+
+  m_ChunkData.Clear();
+
+  ezInt64 iPrevTimestamp = 0;
+  for (const ezProfilingSystem::GPUScope& scope : scopes)
+  {
+    const ezInt64 iBegin = ToNanoseconds(scope.m_BeginTime);
+
+    AppendVarUInt(m_ChunkData, InternString(scope.m_szName));
+    AppendVarInt(m_ChunkData, iBegin - iPrevTimestamp);
+    AppendVarUInt(m_ChunkData, static_cast<ezUInt64>(ezMath::Max<ezInt64>(ToNanoseconds(scope.m_EndTime) - iBegin, 0)));
+
+    iPrevTimestamp = iBegin;
+  }
+
+  EZ_SUCCEED_OR_RETURN(WritePendingStrings());
+  return WriteChunk(ezProfilingCaptureFormat::ChunkType::GPUScopes, m_ChunkData);
+}
+
+ezResult ezProfilingCaptureWriter::WriteCounterSamples(ezUInt64 uiThreadID, ezArrayPtr<const ezProfilingSystem::CounterSample> samples)
+{
+  EZ_ASSERT_DEV(!m_bInCPUScopes, "Chunks cannot be nested");
+
+  if (samples.IsEmpty())
+    return EZ_SUCCESS;
+
+  m_ChunkData.Clear();
+  AppendUInt64(m_ChunkData, uiThreadID);
+
+  ezInt64 iPrevTimestamp = 0;
+  for (const ezProfilingSystem::CounterSample& sample : samples)
+  {
+    const ezInt64 iTimestamp = ToNanoseconds(sample.m_Time);
+
+    AppendVarUInt(m_ChunkData, InternString(sample.m_szName));
+    AppendVarInt(m_ChunkData, iTimestamp - iPrevTimestamp);
+
+    ezUInt64 uiValueBits = 0;
+    ezMemoryUtils::RawByteCopy(&uiValueBits, &sample.m_fValue, sizeof(double));
+    AppendUInt64(m_ChunkData, uiValueBits);
+
+    iPrevTimestamp = iTimestamp;
+  }
+
+  EZ_SUCCEED_OR_RETURN(WritePendingStrings());
+  return WriteChunk(ezProfilingCaptureFormat::ChunkType::CounterSamples, m_ChunkData);
+}
+
+ezResult ezProfilingCaptureWriter::WriteMarkers(ezUInt64 uiThreadID, ezArrayPtr<const ezProfilingSystem::Marker> markers)
+{
+  EZ_ASSERT_DEV(!m_bInCPUScopes, "Chunks cannot be nested");
+
+  if (markers.IsEmpty())
+    return EZ_SUCCESS;
+
+  m_ChunkData.Clear();
+  AppendUInt64(m_ChunkData, uiThreadID);
+
+  ezInt64 iPrevTimestamp = 0;
+  for (const ezProfilingSystem::Marker& marker : markers)
+  {
+    const ezInt64 iTimestamp = ToNanoseconds(marker.m_Time);
+
+    AppendVarUInt(m_ChunkData, InternString(marker.m_szName));
+    AppendVarUInt(m_ChunkData, InternFunctionName(marker.m_szFunctionName));
+    AppendVarInt(m_ChunkData, iTimestamp - iPrevTimestamp);
+
+    iPrevTimestamp = iTimestamp;
+  }
+
+  EZ_SUCCEED_OR_RETURN(WritePendingStrings());
+  return WriteChunk(ezProfilingCaptureFormat::ChunkType::Markers, m_ChunkData);
+}
+
+ezResult ezProfilingCaptureWriter::WriteStackSamples(ezUInt64 uiThreadID, ezArrayPtr<const ezProfilingSystem::StackSample> samples)
+{
+  EZ_ASSERT_DEV(!m_bInCPUScopes, "Chunks cannot be nested");
+
+  if (samples.IsEmpty())
+    return EZ_SUCCESS;
+
+  m_ChunkData.Clear();
+  AppendUInt64(m_ChunkData, uiThreadID);
+
+  ezInt64 iPrevTimestamp = 0;
+  for (const ezProfilingSystem::StackSample& sample : samples)
+  {
+    const ezInt64 iTimestamp = ToNanoseconds(sample.m_Time);
+
+    AppendVarInt(m_ChunkData, iTimestamp - iPrevTimestamp);
+    AppendVarUInt(m_ChunkData, sample.m_uiNumFrames);
+
+    // the return addresses of one stack are mostly close to each other
+    ezUInt64 uiPrevAddress = 0;
+    for (ezUInt32 i = 0; i < sample.m_uiNumFrames; ++i)
+    {
+      AppendVarInt(m_ChunkData, static_cast<ezInt64>(sample.m_Frames[i] - uiPrevAddress));
+      uiPrevAddress = sample.m_Frames[i];
+    }
+
+    iPrevTimestamp = iTimestamp;
+  }
+
+  return WriteChunk(ezProfilingCaptureFormat::ChunkType::StackSamples, m_ChunkData);
+}
+
+ezResult ezProfilingCaptureWriter::WriteStackFrameSymbols(const ezHashTable<ezUInt64, ezString>& symbols)
+{
+  EZ_ASSERT_DEV(!m_bInCPUScopes, "Chunks cannot be nested");
+
+  if (symbols.IsEmpty())
+    return EZ_SUCCESS;
+
+  m_ChunkData.Clear();
+  for (auto it = symbols.GetIterator(); it.IsValid(); ++it)
+  {
+    AppendVarUInt(m_ChunkData, it.Key());
+    AppendVarUInt(m_ChunkData, InternString(it.Value()));
+  }
+
+  EZ_SUCCEED_OR_RETURN(WritePendingStrings());
+  return WriteChunk(ezProfilingCaptureFormat::ChunkType::StackFrameSymbols, m_ChunkData);
+}
+
+void ezProfilingCaptureWriter::ClearFunctionNameCache()
+{
+  m_FunctionNameToIndex.Clear();
+}
+
+ezUInt32 ezProfilingCaptureWriter::InternString(ezStringView sString)
+{
+  if (sString.IsEmpty())
+    return 0;
+
+  const ezUInt64 uiHash = ezHashingUtils::xxHash64(sString.GetStartPointer(), sString.GetElementCount());
+
+  ezUInt32 uiIndex = 0;
+  if (m_StringHashToIndex.TryGetValue(uiHash, uiIndex) && m_Strings[uiIndex - 1] == sString)
+    return uiIndex;
+
+  m_Strings.PushBack(sString);
+  const ezUInt32 uiNewIndex = m_Strings.GetCount();
+
+  // on a hash collision the first string keeps the entry, the second one is simply stored again every time it is used
+  if (uiIndex == 0)
+  {
+    m_StringHashToIndex.Insert(uiHash, uiNewIndex);
+  }
+
+  return uiNewIndex;
+}
+
+ezUInt32 ezProfilingCaptureWriter::InternFunctionName(const char* szFunctionName)
+{
+  if (szFunctionName == nullptr)
+    return 0;
+
+  ezUInt32 uiIndex = 0;
+  if (m_FunctionNameToIndex.TryGetValue(szFunctionName, uiIndex))
+    return uiIndex;
+
+  uiIndex = InternString(szFunctionName);
+  m_FunctionNameToIndex.Insert(szFunctionName, uiIndex);
+  return uiIndex;
+}
+
+ezResult ezProfilingCaptureWriter::WriteChunk(ezProfilingCaptureFormat::ChunkType type, ezArrayPtr<const ezUInt8> payload)
+{
+  EZ_ASSERT_DEV(m_pOutputStream != nullptr, "Begin() has not been called");
+
+  const ezUInt8 uiType = static_cast<ezUInt8>(type);
+  const ezUInt32 uiSize = payload.GetCount();
+
+  if (uiSize > ezProfilingCaptureFormat::MaxChunkSize)
+  {
+    ezLog::Error("Profiling capture chunk of {0} bytes exceeds the maximum chunk size.", uiSize);
+    return EZ_FAILURE;
+  }
+
+  EZ_SUCCEED_OR_RETURN(m_pOutputStream->WriteBytes(&uiType, sizeof(ezUInt8)));
+  EZ_SUCCEED_OR_RETURN(m_pOutputStream->WriteBytes(&uiSize, sizeof(ezUInt32)));
+  EZ_SUCCEED_OR_RETURN(m_pOutputStream->WriteBytes(payload.GetPtr(), uiSize));
+
+  m_uiWrittenBytes += sizeof(ezUInt8) + sizeof(ezUInt32) + uiSize;
+  return EZ_SUCCESS;
+}
+
+ezResult ezProfilingCaptureWriter::WritePendingStrings()
+{
+  if (m_uiWrittenStrings == m_Strings.GetCount())
+    return EZ_SUCCESS;
+
+  m_StringChunkData.Clear();
+  AppendVarUInt(m_StringChunkData, m_Strings.GetCount() - m_uiWrittenStrings);
+
+  for (ezUInt32 i = m_uiWrittenStrings; i < m_Strings.GetCount(); ++i)
+  {
+    const ezString& sString = m_Strings[i];
+    AppendVarUInt(m_StringChunkData, sString.GetElementCount());
+
+    const ezUInt32 uiOffset = m_StringChunkData.GetCount();
+    m_StringChunkData.SetCountUninitialized(uiOffset + sString.GetElementCount());
+    ezMemoryUtils::RawByteCopy(m_StringChunkData.GetData() + uiOffset, sString.GetData(), sString.GetElementCount());
+  }
+
+  m_uiWrittenStrings = m_Strings.GetCount();
+  return WriteChunk(ezProfilingCaptureFormat::ChunkType::Strings, m_StringChunkData);
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezResult ezProfilingSystem::ProfilingData::WriteBinary(ezStreamWriter& outputStream) const
+{
+  ezProfilingCaptureWriter writer;
+  EZ_SUCCEED_OR_RETURN(writer.Begin(&outputStream, m_uiProcessID, m_uiFramesThreadID, m_uiGPUThreadID));
+  EZ_SUCCEED_OR_RETURN(writer.WriteThreadInfos(m_ThreadInfos));
+
+  for (const CPUScopesBufferFlat& eventBuffer : m_AllEventBuffers)
+  {
+    writer.BeginCPUScopes(eventBuffer.m_uiThreadId);
+
+    ezUInt32 uiNextAllocations = 0;
+    for (ezUInt32 i = 0; i < eventBuffer.m_Data.GetCount(); ++i)
+    {
+      const CPUScope& scope = eventBuffer.m_Data[i];
+
+      ezUInt32 uiNumAllocations = 0;
+      ezUInt64 uiAllocationSize = 0;
+      if (uiNextAllocations < eventBuffer.m_ScopeAllocations.GetCount() && eventBuffer.m_ScopeAllocations[uiNextAllocations].m_uiScopeIndex == i)
+      {
+        uiNumAllocations = eventBuffer.m_ScopeAllocations[uiNextAllocations].m_uiNumAllocations;
+        uiAllocationSize = eventBuffer.m_ScopeAllocations[uiNextAllocations].m_uiAllocationSize;
+        ++uiNextAllocations;
+      }
+
+      writer.AddCPUScope(scope.m_szName, scope.m_szFunctionName, scope.m_BeginTime, scope.m_EndTime, uiNumAllocations, uiAllocationSize);
+    }
+
+    EZ_SUCCEED_OR_RETURN(writer.EndCPUScopes());
+    EZ_SUCCEED_OR_RETURN(writer.WriteCounterSamples(eventBuffer.m_uiThreadId, eventBuffer.m_CounterSamples));
+    EZ_SUCCEED_OR_RETURN(writer.WriteMarkers(eventBuffer.m_uiThreadId, eventBuffer.m_Markers));
+    EZ_SUCCEED_OR_RETURN(writer.WriteStackSamples(eventBuffer.m_uiThreadId, eventBuffer.m_StackSamples));
+  }
+
+  EZ_SUCCEED_OR_RETURN(writer.WriteFrames(m_FrameStartTimes, m_uiFrameCount));
+  EZ_SUCCEED_OR_RETURN(writer.WriteGPUScopes(m_GPUScopes));
+  EZ_SUCCEED_OR_RETURN(writer.WriteStackFrameSymbols(m_StackFrameSymbols));
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezProfilingSystem::ProfilingData::ReadBinary(ezStreamReader& inputStream)
+{
+  Clear();
+
+  char magic[4] = {};
+  ezUInt8 uiVersion = 0;
+  if (inputStream.ReadBytes(magic, sizeof(magic)) != sizeof(magic) || !ezMemoryUtils::IsEqual(magic, ezProfilingCaptureFormat::Magic, sizeof(magic)))
+  {
+    ezLog::Error("The data is not a binary profiling capture.");
+    return EZ_FAILURE;
+  }
+
+  if (inputStream.ReadBytes(&uiVersion, sizeof(ezUInt8)) != sizeof(ezUInt8) || uiVersion > ezProfilingCaptureFormat::Version)
+  {
+    ezLog::Error("Unsupported binary profiling capture version {0}.", uiVersion);
+    return EZ_FAILURE;
+  }
+
+  // index zero is the empty string
+  m_Strings.Clear();
+  m_Strings.PushBack(ezHashedString());
+
+  auto getString = [&](ezProfilingCaptureChunkReader& reader) -> const ezHashedString& {
+    const ezUInt64 uiIndex = reader.ReadVarUInt();
+    if (uiIndex >= m_Strings.GetCount())
+    {
+      reader.m_bError = true;
+      return m_Strings[0];
+    }
+
+    return m_Strings[static_cast<ezUInt32>(uiIndex)];
+  };
+
+  auto getEventBuffer = [&](ezUInt64 uiThreadId) -> CPUScopesBufferFlat* {
+    for (CPUScopesBufferFlat& eventBuffer : m_AllEventBuffers)
+    {
+      if (eventBuffer.m_uiThreadId == uiThreadId)
+        return &eventBuffer;
+    }
+
+    CPUScopesBufferFlat& eventBuffer = m_AllEventBuffers.ExpandAndGetRef();
+    eventBuffer.m_uiThreadId = uiThreadId;
+    return &eventBuffer;
+  };
+
+  // ScopeAllocations chunks refer to the scopes of the CPUScopes chunk that was read last
+  ezUInt32 uiLastScopesBuffer = ezInvalidIndex;
+  ezUInt32 uiLastScopesStart = 0;
+
+  ezDynamicArray<ezUInt8> chunkData;
+
+  while (true)
+  {
+    ezUInt8 uiChunkType = 0;
+    ezUInt32 uiChunkSize = 0;
+
+    // the capture simply ends after the last chunk, streamed captures may also have been cut off
+    if (inputStream.ReadBytes(&uiChunkType, sizeof(ezUInt8)) != sizeof(ezUInt8))
+      break;
+
+    if (inputStream.ReadBytes(&uiChunkSize, sizeof(ezUInt32)) != sizeof(ezUInt32))
+    {
+      ezLog::Warning("Binary profiling capture is truncated.");
+      break;
+    }
+
+    if (uiChunkSize > ezProfilingCaptureFormat::MaxChunkSize)
+    {
+      ezLog::Error("Binary profiling capture is corrupted, chunk size {0} is too large.", uiChunkSize);
+      return EZ_FAILURE;
+    }
+
+    // the size can't be checked against the remaining stream size up front, so the buffer only grows as far as there is data
+    const ezUInt32 uiMaxReadSize = 1024 * 1024;
+    bool bTruncated = false;
+    chunkData.Clear();
+    while (chunkData.GetCount() < uiChunkSize && !bTruncated)
+    {
+      const ezUInt32 uiOffset = chunkData.GetCount();
+      const ezUInt32 uiReadSize = ezMath::Min(uiChunkSize - uiOffset, uiMaxReadSize);
+
+      chunkData.SetCountUninitialized(uiOffset + uiReadSize);
+      bTruncated = inputStream.ReadBytes(chunkData.GetData() + uiOffset, uiReadSize) != uiReadSize;
+    }
+
+    if (bTruncated)
+    {
+      ezLog::Warning("Binary profiling capture is truncated.");
+      break;
+    }
+
+    ezProfilingCaptureChunkReader reader(chunkData);
+
+    switch (static_cast<ezProfilingCaptureFormat::ChunkType>(uiChunkType))
+    {
+      case ezProfilingCaptureFormat::ChunkType::Process:
+        m_uiProcessID = static_cast<ezOsProcessID>(reader.ReadVarUInt());
+        m_uiFramesThreadID = static_cast<ezUInt32>(reader.ReadVarUInt());
+        m_uiGPUThreadID = static_cast<ezUInt32>(reader.ReadVarUInt());
+        break;
+
+      case ezProfilingCaptureFormat::ChunkType::Strings:
+      {
+        const ezUInt64 uiCount = reader.ReadVarUInt();
+        for (ezUInt64 i = 0; i < uiCount && !reader.m_bError; ++i)
+        {
+          const ezStringView sString = reader.ReadStringData(reader.ReadVarUInt());
+
+          ezHashedString& sHashed = m_Strings.ExpandAndGetRef();
+          sHashed.Assign(sString);
+        }
+      }
+      break;
+
+      case ezProfilingCaptureFormat::ChunkType::Threads:
+        while (!reader.IsAtEnd() && !reader.m_bError)
+        {
+          const ezUInt64 uiThreadId = reader.ReadUInt64();
+          const ezHashedString& sName = getString(reader);
+
+          ThreadInfo* pInfo = nullptr;
+          for (ThreadInfo& info : m_ThreadInfos)
+          {
+            if (info.m_uiThreadId == uiThreadId)
+              pInfo = &info;
+          }
+
+          if (pInfo == nullptr)
+          {
+            pInfo = &m_ThreadInfos.ExpandAndGetRef();
+            pInfo->m_uiThreadId = uiThreadId;
+          }
+
+          pInfo->m_sName = sName.GetView();
+        }
+        break;
+
+      case ezProfilingCaptureFormat::ChunkType::CPUScopes:
+      {
+        CPUScopesBufferFlat* pEventBuffer = getEventBuffer(reader.ReadUInt64());
+        uiLastScopesBuffer = static_cast<ezUInt32>(pEventBuffer - m_AllEventBuffers.GetData());
+        uiLastScopesStart = pEventBuffer->m_Data.GetCount();
+
+        ezInt64 iPrevTimestamp = 0;
+        while (!reader.IsAtEnd() && !reader.m_bError)
+        {
+          const ezHashedString& sName = getString(reader);
+          const ezHashedString& sFunctionName = getString(reader);
+          const ezInt64 iBegin = iPrevTimestamp + reader.ReadVarInt();
+          const ezUInt64 uiDuration = reader.ReadVarUInt();
+          iPrevTimestamp = iBegin;
+
+          CPUScope& scope = pEventBuffer->m_Data.ExpandAndGetRef();
+          ezStringUtils::Copy(scope.m_szName, CPUScope::NAME_SIZE, sName.GetData());
+          // the hashed strings are kept alive by m_Strings
+          scope.m_szFunctionName = sFunctionName.IsEmpty() ? nullptr : sFunctionName.GetData();
+          scope.m_BeginTime = ezTime::Nanoseconds(static_cast<double>(iBegin));
+          scope.m_EndTime = uiDuration > 0 ? ezTime::Nanoseconds(static_cast<double>(iBegin + static_cast<ezInt64>(uiDuration - 1))) : ezTime::Zero();
+        }
+      }
+      break;
+
+      case ezProfilingCaptureFormat::ChunkType::ScopeAllocations:
+      {
+        if (uiLastScopesBuffer == ezInvalidIndex)
+        {
+          reader.m_bError = true;
+          break;
+        }
+
+        CPUScopesBufferFlat* pLastScopesBuffer = &m_AllEventBuffers[uiLastScopesBuffer];
+
+        ezUInt64 uiScopeIndex = uiLastScopesStart;
+        while (!reader.IsAtEnd() && !reader.m_bError)
+        {
+          uiScopeIndex += reader.ReadVarUInt();
+          const ezUInt64 uiNumAllocations = reader.ReadVarUInt();
+          const ezUInt64 uiAllocationSize = reader.ReadVarUInt();
+
+          if (uiScopeIndex >= pLastScopesBuffer->m_Data.GetCount())
+          {
+            reader.m_bError = true;
+            break;
+          }
+
+          ScopeAllocations& allocations = pLastScopesBuffer->m_ScopeAllocations.ExpandAndGetRef();
+          allocations.m_uiScopeIndex = static_cast<ezUInt32>(uiScopeIndex);
+          allocations.m_uiNumAllocations = static_cast<ezUInt32>(uiNumAllocations);
+          allocations.m_uiAllocationSize = uiAllocationSize;
+        }
+      }
+      break;
+
+      case ezProfilingCaptureFormat::ChunkType::Frames:
+      {
+        m_uiFrameCount = reader.ReadVarUInt();
+
+        ezInt64 iPrevTimestamp = 0;
+        while (!reader.IsAtEnd() && !reader.m_bError)
+        {
+          iPrevTimestamp += reader.ReadVarInt();
+          m_FrameStartTimes.PushBack(ezTime::Nanoseconds(static_cast<double>(iPrevTimestamp)));
+        }
+      }
+      break;
+
+      case ezProfilingCaptureFormat::ChunkType::GPUScopes:
+      {
+        ezInt64 iPrevTimestamp = 0;
+        while (!reader.IsAtEnd() && !reader.m_bError)
+        {
+          const ezHashedString& sName = getString(reader);
+          const ezInt64 iBegin = iPrevTimestamp + reader.ReadVarInt();
+          const ezUInt64 uiDuration = reader.ReadVarUInt();
+          iPrevTimestamp = iBegin;
+
+          GPUScope& scope = m_GPUScopes.ExpandAndGetRef();
+          ezStringUtils::Copy(scope.m_szName, GPUScope::NAME_SIZE, sName.GetData());
+          scope.m_BeginTime = ezTime::Nanoseconds(static_cast<double>(iBegin));
+          scope.m_EndTime = ezTime::Nanoseconds(static_cast<double>(iBegin + static_cast<ezInt64>(uiDuration)));
+        }
+      }
+      break;
+
+      case ezProfilingCaptureFormat::ChunkType::CounterSamples:
+      {
+        CPUScopesBufferFlat* pEventBuffer = getEventBuffer(reader.ReadUInt64());
+
+        ezInt64 iPrevTimestamp = 0;
+        while (!reader.IsAtEnd() && !reader.m_bError)
+        {
+          const ezHashedString& sName = getString(reader);
+          iPrevTimestamp += reader.ReadVarInt();
+          const ezUInt64 uiValueBits = reader.ReadUInt64();
+
+          CounterSample& sample = pEventBuffer->m_CounterSamples.ExpandAndGetRef();
+          ezStringUtils::Copy(sample.m_szName, CounterSample::NAME_SIZE, sName.GetData());
+          sample.m_Time = ezTime::Nanoseconds(static_cast<double>(iPrevTimestamp));
+          ezMemoryUtils::RawByteCopy(&sample.m_fValue, &uiValueBits, sizeof(double));
+        }
+      }
+      break;
+
+      case ezProfilingCaptureFormat::ChunkType::Markers:
+      {
+        CPUScopesBufferFlat* pEventBuffer = getEventBuffer(reader.ReadUInt64());
+
+        ezInt64 iPrevTimestamp = 0;
+        while (!reader.IsAtEnd() && !reader.m_bError)
+        {
+          const ezHashedString& sName = getString(reader);
+          const ezHashedString& sFunctionName = getString(reader);
+          iPrevTimestamp += reader.ReadVarInt();
+
+          Marker& marker = pEventBuffer->m_Markers.ExpandAndGetRef();
+          ezStringUtils::Copy(marker.m_szName, Marker::NAME_SIZE, sName.GetData());
+          marker.m_szFunctionName = sFunctionName.IsEmpty() ? nullptr : sFunctionName.GetData();
+          marker.m_Time = ezTime::Nanoseconds(static_cast<double>(iPrevTimestamp));
+        }
+      }
+      break;
+
+      case ezProfilingCaptureFormat::ChunkType::StackSamples:
+      {
+        CPUScopesBufferFlat* pEventBuffer = getEventBuffer(reader.ReadUInt64());
+
+        ezInt64 iPrevTimestamp = 0;
+        while (!reader.IsAtEnd() && !reader.m_bError)
+        {
+          iPrevTimestamp += reader.ReadVarInt();
+          const ezUInt64 uiNumFrames = reader.ReadVarUInt();
+
+          if (uiNumFrames > StackSample::MAX_FRAMES)
+          {
+            reader.m_bError = true;
+            break;
+          }
+
+          StackSample& sample = pEventBuffer->m_StackSamples.ExpandAndGetRef();
+          sample.m_Time = ezTime::Nanoseconds(static_cast<double>(iPrevTimestamp));
+          sample.m_uiNumFrames = static_cast<ezUInt32>(uiNumFrames);
+          sample.m_uiReserved = 0;
+
+          ezUInt64 uiPrevAddress = 0;
+          for (ezUInt32 i = 0; i < sample.m_uiNumFrames; ++i)
+          {
+            uiPrevAddress += static_cast<ezUInt64>(reader.ReadVarInt());
+            sample.m_Frames[i] = uiPrevAddress;
+          }
+        }
+      }
+      break;
+
+      case ezProfilingCaptureFormat::ChunkType::StackFrameSymbols:
+        while (!reader.IsAtEnd() && !reader.m_bError)
+        {
+          const ezUInt64 uiAddress = reader.ReadVarUInt();
+          const ezHashedString& sName = getString(reader);
+
+          m_StackFrameSymbols.Insert(uiAddress, sName.GetView());
+        }
+        break;
+
+      default:
+        // unknown chunks are written by newer versions, they are skipped
+        break;
+    }
+
+    if (reader.m_bError)
+    {
+      ezLog::Error("Binary profiling capture contains an invalid chunk of type {0}.", uiChunkType);
+      return EZ_FAILURE;
+    }
+  }
+
+  return EZ_SUCCESS;
+}
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Profiling_Implementation_ProfilingCapture);
@@ -0,0 +1,92 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/Configuration/Startup.h>
+#include <Foundation/Profiling/Profiling.h>
+#include <Foundation/System/StackTracer.h>
+
+// also needed without EZ_USE_PROFILING, for writing captures
+void ezProfilingSystem::ProfilingData::ResolveStackFrameSymbols()
+{
+  ezStringBuilder sSymbol;
+  ezStackTracer::PrintFunc appendSymbol = [&](const char* szText) { sSymbol.Append(szText); };
+
+  for (const CPUScopesBufferFlat& eventBuffer : m_AllEventBuffers)
+  {
+    for (const StackSample& sample : eventBuffer.m_StackSamples)
+    {
+      for (ezUInt32 i = 0; i < sample.m_uiNumFrames; ++i)
+      {
+        const ezUInt64 uiAddress = sample.m_Frames[i];
+        if (m_StackFrameSymbols.Contains(uiAddress))
+          continue;
+
+        void* pAddress = reinterpret_cast<void*>(static_cast<size_t>(uiAddress));
+        ezArrayPtr<void*> trace(&pAddress, 1);
+
+        sSymbol.Clear();
+        ezStackTracer::ResolveStackTrace(trace, appendSymbol);
+        sSymbol.Trim(" \r\n");
+
+        m_StackFrameSymbols.Insert(uiAddress, sSymbol);
+      }
+    }
+  }
+}
+
+// without frame pointers the sampled call stacks would end right after the interrupted function
+#if EZ_ENABLED(EZ_USE_PROFILING) && EZ_ENABLED(EZ_PLATFORM_LINUX) && defined(BUILDSYSTEM_ENABLE_FRAME_POINTERS)
+
+#  include <Foundation/Profiling/Implementation/Linux/ProfilingSampler_linux.h>
+
+// clang-format off
+EZ_BEGIN_SUBSYSTEM_DECLARATION(Foundation, ProfilingSampler)
+
+  BEGIN_SUBSYSTEM_DEPENDENCIES
+    "ProfilingSystem"
+  END_SUBSYSTEM_DEPENDENCIES
+
+  ON_CORESYSTEMS_STARTUP
+  {
+    // the main thread is registered by the profiling system as well, this is for restarting the core systems
+    ezProfilingSystem::AddSampledThread();
+  }
+
+  ON_CORESYSTEMS_SHUTDOWN
+  {
+    ezProfilingSystem::StopSampling();
+    ezProfilingSystem::RemoveSampledThread();
+  }
+
+EZ_END_SUBSYSTEM_DECLARATION;
+// clang-format on
+
+#else
+
+bool ezProfilingSystem::IsSamplingSupported()
+{
+  return false;
+}
+
+ezResult ezProfilingSystem::StartSampling(ezTime samplingInterval)
+{
+  return EZ_FAILURE;
+}
+
+void ezProfilingSystem::StopSampling() {}
+
+bool ezProfilingSystem::IsSamplingActive()
+{
+  return false;
+}
+
+void ezProfilingSystem::AddSampledThread() {}
+
+void ezProfilingSystem::RemoveSampledThread() {}
+
+void ezProfilingSystem::CaptureStackSamples(ProfilingData& out_Capture) {}
+
+void ezProfilingSystem::ClearStackSamples() {}
+
+#endif
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Profiling_Implementation_ProfilingSampler);
@@ -0,0 +1,353 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/Configuration/Startup.h>
+#include <Foundation/IO/CompressedStreamZstd.h>
+#include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <Foundation/Threading/Lock.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Threading/ThreadSignal.h>
+#include <Foundation/Time/Timestamp.h>
+
+// clang-format off
+EZ_BEGIN_SUBSYSTEM_DECLARATION(Foundation, ProfilingSpikeCapture)
+
+  BEGIN_SUBSYSTEM_DEPENDENCIES
+    "FileSystem"
+  END_SUBSYSTEM_DEPENDENCIES
+
+  ON_CORESYSTEMS_SHUTDOWN
+  {
+    // captures are written through the file system, so the writer thread has to finish before the file system shuts down
+    ezProfilingSystem::DisableSpikeCapture();
+  }
+
+EZ_END_SUBSYSTEM_DECLARATION;
+// clang-format on
+
+namespace
+{
+  template <typename T, typename Predicate>
+  void RemoveProfilingEventsIf(ezDynamicArray<T>& inout_Events, Predicate isOutside)
+  {
+    ezUInt32 uiNumKept = 0;
+    for (ezUInt32 i = 0; i < inout_Events.GetCount(); ++i)
+    {
+      if (!isOutside(inout_Events[i]))
+      {
+        inout_Events[uiNumKept++] = inout_Events[i];
+      }
+    }
+
+    inout_Events.SetCount(uiNumKept);
+  }
+} // namespace
+
+void ezProfilingSystem::ProfilingData::RemoveEventsOutsideTimeRange(ezTime beginTime, ezTime endTime)
+{
+  auto isOutside = [&](ezTime time) { return time < beginTime || time > endTime; };
+
+  for (CPUScopesBufferFlat& eventBuffer : m_AllEventBuffers)
+  {
+    // the scope allocations reference the scopes by index, so they are compacted together
+    ezUInt32 uiNumKeptScopes = 0;
+    ezUInt32 uiNumKeptAllocations = 0;
+    ezUInt32 uiNextAllocations = 0;
+
+    for (ezUInt32 i = 0; i < eventBuffer.m_Data.GetCount(); ++i)
+    {
+      const CPUScope& scope = eventBuffer.m_Data[i];
+
+      // scopes that have not ended yet have no end time
+      const bool bKeep = scope.m_BeginTime <= endTime && (scope.m_EndTime >= beginTime || scope.m_EndTime.IsZeroOrNegative());
+
+      while (uiNextAllocations < eventBuffer.m_ScopeAllocations.GetCount() && eventBuffer.m_ScopeAllocations[uiNextAllocations].m_uiScopeIndex < i)
+      {
+        ++uiNextAllocations;
+      }
+
+      if (uiNextAllocations < eventBuffer.m_ScopeAllocations.GetCount() && eventBuffer.m_ScopeAllocations[uiNextAllocations].m_uiScopeIndex == i)
+      {
+        if (bKeep)
+        {
+          ScopeAllocations allocations = eventBuffer.m_ScopeAllocations[uiNextAllocations];
+          allocations.m_uiScopeIndex = uiNumKeptScopes;
+          eventBuffer.m_ScopeAllocations[uiNumKeptAllocations++] = allocations;
+        }
+
+        ++uiNextAllocations;
+      }
+
+      if (bKeep)
+      {
+        eventBuffer.m_Data[uiNumKeptScopes++] = scope;
+      }
+    }
+
+    eventBuffer.m_Data.SetCount(uiNumKeptScopes);
+    eventBuffer.m_ScopeAllocations.SetCount(uiNumKeptAllocations);
+
+    RemoveProfilingEventsIf(eventBuffer.m_CounterSamples, [&](const CounterSample& sample) { return isOutside(sample.m_Time); });
+    RemoveProfilingEventsIf(eventBuffer.m_Markers, [&](const Marker& marker) { return isOutside(marker.m_Time); });
+    RemoveProfilingEventsIf(eventBuffer.m_StackSamples, [&](const StackSample& sample) { return isOutside(sample.m_Time); });
+  }
+
+  // m_uiFrameCount stays the same, it is the number of the last frame, which is only removed if the range ends before it
+  RemoveProfilingEventsIf(m_FrameStartTimes, isOutside);
+  RemoveProfilingEventsIf(m_GPUScopes, [&](const GPUScope& scope) { return scope.m_BeginTime > endTime || scope.m_EndTime < beginTime; });
+}
+
+#if EZ_ENABLED(EZ_USE_PROFILING)
+
+namespace
+{
+  class ezProfilingSpikeCaptureThread : public ezThread
+  {
+  public:
+    ezProfilingSpikeCaptureThread(const ezProfilingSpikeCaptureSettings& settings)
+      : ezThread("Profiling Spike Capture")
+      , m_Settings(settings)
+      , m_EnableTime(ezTime::Now())
+    {
+    }
+
+    const ezProfilingSpikeCaptureSettings m_Settings;
+    const ezTime m_EnableTime;
+
+    ezThreadSignal m_WakeUp;
+    ezAtomicBool m_bStop;
+
+    // only accessed by the main thread, in UpdateSpikeCapture()
+    bool m_bSpikePending = false;
+    ezUInt32 m_uiFramesUntilCapture = 0;
+    ezUInt32 m_uiNumTriggeredCaptures = 0;
+    ezTime m_LastCaptureTime;
+    ezTime m_SpikeFrameStartTime;
+    ezTime m_SpikeDuration;
+
+    // the snapshot that is handed over to the background thread
+    ezMutex m_CaptureMutex;
+    bool m_bCaptureAvailable = false;
+    ezProfilingSystem::ProfilingData m_Capture;
+    ezTime m_CaptureSpikeFrameStartTime;
+    ezTime m_CaptureSpikeDuration;
+    ezTime m_CaptureEndTime;
+
+  private:
+    virtual ezUInt32 Run() override
+    {
+      while (!m_bStop)
+      {
+        m_WakeUp.WaitForSignal();
+        WriteCapture();
+      }
+
+      // a capture that was taken right before the spike capture was disabled
+      WriteCapture();
+      return 0;
+    }
+
+    void WriteCapture();
+  };
+
+  static ezProfilingSpikeCaptureThread* s_pSpikeCapture = nullptr;
+  static ezMutex s_SpikeCaptureMutex;
+  static ezAtomicInteger32 s_iNumWrittenSpikeCaptures;
+
+  void ezProfilingSpikeCaptureThread::WriteCapture()
+  {
+    // the capture is only accessed by the main thread while m_bCaptureAvailable is false
+    {
+      EZ_LOCK(m_CaptureMutex);
+      if (!m_bCaptureAvailable)
+        return;
+    }
+
+    // the ring buffers contain much more than the frames around the spike
+    ezTime beginTime = m_CaptureSpikeFrameStartTime;
+    {
+      const ezArrayPtr<const ezTime> frameStartTimes = m_Capture.m_FrameStartTimes;
+
+      ezUInt32 uiSpikeFrame = 0;
+      while (uiSpikeFrame < frameStartTimes.GetCount() && frameStartTimes[uiSpikeFrame] < m_CaptureSpikeFrameStartTime)
+      {
+        ++uiSpikeFrame;
+      }
+
+      if (uiSpikeFrame < frameStartTimes.GetCount())
+      {
+        beginTime = frameStartTimes[uiSpikeFrame - ezMath::Min(uiSpikeFrame, m_Settings.m_uiFramesBefore)];
+      }
+    }
+
+    m_Capture.RemoveEventsOutsideTimeRange(beginTime, m_CaptureEndTime);
+    m_Capture.ResolveStackFrameSymbols();
+
+    const ezDateTime dt = ezTimestamp::CurrentTimestamp();
+
+    ezStringBuilder sPath = m_Settings.m_sOutputFolder;
+    sPath.AppendFormat("/Spike_{0}-{1}-{2}_{3}-{4}-{5}-{6}_{7}ms.ezProfilingCapture", dt.GetYear(), ezArgU(dt.GetMonth(), 2, true), ezArgU(dt.GetDay(), 2, true), ezArgU(dt.GetHour(), 2, true), ezArgU(dt.GetMinute(), 2, true), ezArgU(dt.GetSecond(), 2, true), ezArgU(dt.GetMicroseconds() / 1000, 3, true), static_cast<ezUInt32>(m_CaptureSpikeDuration.GetMilliseconds()));
+
+    ezResult res = EZ_FAILURE;
+    {
+      ezFileWriter file;
+      if (file.Open(sPath).Succeeded())
+      {
+#  ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+        ezCompressedStreamWriterZstd compressor(&file);
+        res = m_Capture.WriteBinary(compressor);
+
+        if (compressor.FinishCompressedStream().Failed())
+          res = EZ_FAILURE;
+#  else
+        res = m_Capture.WriteBinary(file);
+#  endif
+      }
+    }
+
+    if (res.Succeeded())
+    {
+      s_iNumWrittenSpikeCaptures.Increment();
+      ezLog::Info("Profiling capture of a {0} ms frame saved to '{1}'.", ezArgF(m_CaptureSpikeDuration.GetMilliseconds(), 1), sPath);
+
+      if (m_Settings.m_OnCaptureWritten.IsValid())
+      {
+        m_Settings.m_OnCaptureWritten(sPath);
+      }
+    }
+    else
+    {
+      ezLog::Error("Could not write profiling spike capture to '{0}'.", sPath);
+    }
+
+    EZ_LOCK(m_CaptureMutex);
+    m_Capture.Clear();
+    m_bCaptureAvailable = false;
+  }
+} // namespace
+
+// static
+void ezProfilingSystem::EnableSpikeCapture(const ezProfilingSpikeCaptureSettings& settings)
+{
+  DisableSpikeCapture();
+
+  EZ_LOCK(s_SpikeCaptureMutex);
+
+  s_iNumWrittenSpikeCaptures.Set(0);
+
+  s_pSpikeCapture = EZ_DEFAULT_NEW(ezProfilingSpikeCaptureThread, settings);
+  s_pSpikeCapture->Start();
+}
+
+// static
+void ezProfilingSystem::DisableSpikeCapture()
+{
+  EZ_LOCK(s_SpikeCaptureMutex);
+
+  if (s_pSpikeCapture == nullptr)
+    return;
+
+  s_pSpikeCapture->m_bStop = true;
+  s_pSpikeCapture->m_WakeUp.RaiseSignal();
+  s_pSpikeCapture->Join();
+
+  EZ_DEFAULT_DELETE(s_pSpikeCapture);
+}
+
+// static
+bool ezProfilingSystem::IsSpikeCaptureEnabled()
+{
+  return s_pSpikeCapture != nullptr;
+}
+
+// static
+ezUInt32 ezProfilingSystem::GetNumWrittenSpikeCaptures()
+{
+  return static_cast<ezUInt32>(s_iNumWrittenSpikeCaptures);
+}
+
+// static
+void ezProfilingSystem::UpdateSpikeCapture(ezTime lastFrameStartTime, ezTime frameStartTime)
+{
+  if (s_pSpikeCapture == nullptr)
+    return;
+
+  EZ_LOCK(s_SpikeCaptureMutex);
+
+  ezProfilingSpikeCaptureThread* pSpikeCapture = s_pSpikeCapture;
+  if (pSpikeCapture == nullptr)
+    return;
+
+  const ezProfilingSpikeCaptureSettings& settings = pSpikeCapture->m_Settings;
+
+  if (!pSpikeCapture->m_bSpikePending)
+  {
+    const ezTime frameDuration = frameStartTime - lastFrameStartTime;
+
+    // frames that started before the spike capture was enabled are not fully recorded
+    if (frameDuration <= settings.m_FrameTimeThreshold || lastFrameStartTime < pSpikeCapture->m_EnableTime)
+      return;
+
+    if (pSpikeCapture->m_uiNumTriggeredCaptures >= settings.m_uiMaxCaptures)
+      return;
+
+    if (pSpikeCapture->m_uiNumTriggeredCaptures > 0 && frameStartTime - pSpikeCapture->m_LastCaptureTime < settings.m_MinTimeBetweenCaptures)
+      return;
+
+    pSpikeCapture->m_bSpikePending = true;
+    pSpikeCapture->m_SpikeFrameStartTime = lastFrameStartTime;
+    pSpikeCapture->m_SpikeDuration = frameDuration;
+    pSpikeCapture->m_uiFramesUntilCapture = settings.m_uiFramesAfter;
+  }
+
+  if (pSpikeCapture->m_uiFramesUntilCapture > 0)
+  {
+    --pSpikeCapture->m_uiFramesUntilCapture;
+    return;
+  }
+
+  pSpikeCapture->m_bSpikePending = false;
+
+  {
+    EZ_LOCK(pSpikeCapture->m_CaptureMutex);
+
+    // the previous capture is still being written, this one is dropped to not stall the frame and does not count as a capture
+    if (pSpikeCapture->m_bCaptureAvailable)
+      return;
+
+    pSpikeCapture->m_LastCaptureTime = frameStartTime;
+    ++pSpikeCapture->m_uiNumTriggeredCaptures;
+
+    // copying the ring buffers is the only part that is done on this thread, trimming and writing the capture is done in the background
+    ezProfilingSystem::Capture(pSpikeCapture->m_Capture);
+    pSpikeCapture->m_CaptureSpikeFrameStartTime = pSpikeCapture->m_SpikeFrameStartTime;
+    pSpikeCapture->m_CaptureSpikeDuration = pSpikeCapture->m_SpikeDuration;
+    pSpikeCapture->m_CaptureEndTime = frameStartTime;
+    pSpikeCapture->m_bCaptureAvailable = true;
+  }
+
+  pSpikeCapture->m_WakeUp.RaiseSignal();
+}
+
+#else
+
+void ezProfilingSystem::EnableSpikeCapture(const ezProfilingSpikeCaptureSettings& settings) {}
+
+void ezProfilingSystem::DisableSpikeCapture() {}
+
+bool ezProfilingSystem::IsSpikeCaptureEnabled()
+{
+  return false;
+}
+
+ezUInt32 ezProfilingSystem::GetNumWrittenSpikeCaptures()
+{
+  return 0;
+}
+
+void ezProfilingSystem::UpdateSpikeCapture(ezTime lastFrameStartTime, ezTime frameStartTime) {}
+
+#endif
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Profiling_Implementation_ProfilingSpikeCapture);
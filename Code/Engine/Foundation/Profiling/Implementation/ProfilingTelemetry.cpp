@@ -0,0 +1,249 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/Communication/Telemetry.h>
+#include <Foundation/Configuration/Startup.h>
+#include <Foundation/IO/CompressedStreamZstd.h>
+#include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Threading/Lock.h>
+
+#if EZ_ENABLED(EZ_USE_PROFILING)
+
+namespace
+{
+  /// \brief Collects the payload of the next telemetry message.
+  class ezProfilingTelemetryMessageBuffer : public ezStreamWriter
+  {
+  public:
+    virtual ezResult WriteBytes(const void* pWriteBuffer, ezUInt64 uiBytesToWrite) override
+    {
+      m_Data.PushBackRange(ezArrayPtr<const ezUInt8>(static_cast<const ezUInt8*>(pWriteBuffer), static_cast<ezUInt32>(uiBytesToWrite)));
+      return EZ_SUCCESS;
+    }
+
+    ezDynamicArray<ezUInt8> m_Data;
+  };
+
+  /// \brief The output of the live capture stream. Everything that is written between two flushes is sent as one telemetry message.
+  class ezProfilingTelemetryStreamWriter : public ezStreamWriter
+  {
+  public:
+    ezProfilingTelemetryStreamWriter()
+    {
+#  ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+      m_Compressor.SetOutputStream(&m_Buffer);
+#  endif
+    }
+
+    virtual ezResult WriteBytes(const void* pWriteBuffer, ezUInt64 uiBytesToWrite) override
+    {
+#  ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+      return m_Compressor.WriteBytes(pWriteBuffer, uiBytesToWrite);
+#  else
+      return m_Buffer.WriteBytes(pWriteBuffer, uiBytesToWrite);
+#  endif
+    }
+
+    virtual ezResult Flush() override
+    {
+#  ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+      EZ_SUCCEED_OR_RETURN(m_Compressor.Flush());
+#  endif
+
+      SendBuffer();
+      return EZ_SUCCESS;
+    }
+
+    void Finish()
+    {
+#  ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+      m_Compressor.FinishCompressedStream().IgnoreResult();
+#  endif
+
+      SendBuffer();
+    }
+
+    static constexpr bool IsCompressed()
+    {
+#  ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+      return true;
+#  else
+      return false;
+#  endif
+    }
+
+  private:
+    void SendBuffer()
+    {
+      if (m_Buffer.m_Data.IsEmpty())
+        return;
+
+      ezTelemetry::Broadcast(ezTelemetry::Reliable, 'PROF', 'DATA', m_Buffer.m_Data.GetData(), m_Buffer.m_Data.GetCount());
+      m_Buffer.m_Data.Clear();
+    }
+
+    ezProfilingTelemetryMessageBuffer m_Buffer;
+#  ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+    ezCompressedStreamWriterZstd m_Compressor;
+#  endif
+  };
+
+  enum class ezProfilingTelemetryRequest
+  {
+    None,
+    Start,
+    Stop,
+  };
+
+  // the requests arrive while the telemetry mutex is held, but stopping the stream waits for its thread, which sends telemetry messages,
+  // so they are only handled in StartNewFrame()
+  static ezMutex s_TelemetryRequestMutex;
+  static ezAtomicBool s_bTelemetryRequestPending;
+  static ezProfilingTelemetryRequest s_TelemetryRequest = ezProfilingTelemetryRequest::None;
+  static ezTime s_RequestedFlushInterval;
+  static ezUInt32 s_uiRequestedMaxBytesPerSecond = 0;
+
+  static ezProfilingTelemetryStreamWriter* s_pTelemetryStream = nullptr;
+
+  void RequestTelemetryStream(ezProfilingTelemetryRequest request, ezTime flushInterval = ezTime::Zero(), ezUInt32 uiMaxBytesPerSecond = 0)
+  {
+    EZ_LOCK(s_TelemetryRequestMutex);
+
+    s_TelemetryRequest = request;
+    s_RequestedFlushInterval = flushInterval;
+    s_uiRequestedMaxBytesPerSecond = uiMaxBytesPerSecond;
+    s_bTelemetryRequestPending = true;
+  }
+
+  void ProcessTelemetryMessages(void* pPassThrough)
+  {
+    ezTelemetryMessage msg;
+
+    while (ezTelemetry::RetrieveMessage('PROF', msg) == EZ_SUCCESS)
+    {
+      if (msg.GetMessageID() == ' ON ')
+      {
+        ezTime flushInterval;
+        ezUInt32 uiMaxBytesPerSecond = 0;
+        msg.GetReader() >> flushInterval;
+        msg.GetReader() >> uiMaxBytesPerSecond;
+
+        RequestTelemetryStream(ezProfilingTelemetryRequest::Start, ezMath::Max(flushInterval, ezTime::Milliseconds(10)), uiMaxBytesPerSecond);
+      }
+      else if (msg.GetMessageID() == ' OFF')
+      {
+        RequestTelemetryStream(ezProfilingTelemetryRequest::Stop);
+      }
+    }
+  }
+
+  void TelemetryEventsHandler(const ezTelemetry::TelemetryEventData& e)
+  {
+    if (e.m_EventType == ezTelemetry::TelemetryEventData::DisconnectedFromClient && s_pTelemetryStream != nullptr)
+    {
+      RequestTelemetryStream(ezProfilingTelemetryRequest::Stop);
+    }
+  }
+
+  void StopTelemetryStream()
+  {
+    if (s_pTelemetryStream == nullptr)
+      return;
+
+    // the application may have stopped the telemetry stream and started its own one in the mean time
+    ezProfilingSystem::StopCaptureStream(s_pTelemetryStream);
+    s_pTelemetryStream->Finish();
+
+    ezTelemetry::Broadcast(ezTelemetry::Reliable, 'PROF', ' END', nullptr, 0);
+
+    EZ_DEFAULT_DELETE(s_pTelemetryStream);
+  }
+} // namespace
+
+// clang-format off
+EZ_BEGIN_SUBSYSTEM_DECLARATION(Foundation, ProfilingTelemetry)
+
+  BEGIN_SUBSYSTEM_DEPENDENCIES
+    "ProfilingSystem"
+  END_SUBSYSTEM_DEPENDENCIES
+
+  ON_CORESYSTEMS_STARTUP
+  {
+    ezTelemetry::AddEventHandler(TelemetryEventsHandler);
+    ezTelemetry::AcceptMessagesForSystem('PROF', true, ProcessTelemetryMessages, nullptr);
+  }
+
+  ON_CORESYSTEMS_SHUTDOWN
+  {
+    ezTelemetry::AcceptMessagesForSystem('PROF', false);
+    ezTelemetry::RemoveEventHandler(TelemetryEventsHandler);
+
+    StopTelemetryStream();
+    s_bTelemetryRequestPending = false;
+  }
+
+EZ_END_SUBSYSTEM_DECLARATION;
+// clang-format on
+
+// static
+bool ezProfilingSystem::IsTelemetryStreamActive()
+{
+  return s_pTelemetryStream != nullptr;
+}
+
+// static
+void ezProfilingSystem::UpdateTelemetryStream()
+{
+  if (!s_bTelemetryRequestPending)
+    return;
+
+  ezProfilingTelemetryRequest request;
+  ezTime flushInterval;
+  ezUInt32 uiMaxBytesPerSecond = 0;
+
+  {
+    EZ_LOCK(s_TelemetryRequestMutex);
+
+    request = s_TelemetryRequest;
+    flushInterval = s_RequestedFlushInterval;
+    uiMaxBytesPerSecond = s_uiRequestedMaxBytesPerSecond;
+    s_bTelemetryRequestPending = false;
+  }
+
+  // a new request restarts the stream, so the tool gets a complete capture, starting with the header
+  StopTelemetryStream();
+
+  if (request != ezProfilingTelemetryRequest::Start)
+    return;
+
+  if (IsCaptureStreamActive())
+  {
+    ezLog::Warning("A tool requested a live profiling stream, but a capture stream is already active.");
+    return;
+  }
+
+  ezTelemetryMessage msg;
+  msg.SetMessageID('PROF', ' BGN');
+  msg.GetWriter() << ezProfilingTelemetryStreamWriter::IsCompressed();
+  ezTelemetry::Broadcast(ezTelemetry::Reliable, msg);
+
+  s_pTelemetryStream = EZ_DEFAULT_NEW(ezProfilingTelemetryStreamWriter);
+
+  if (StartCaptureStream(s_pTelemetryStream, flushInterval, uiMaxBytesPerSecond).Failed())
+  {
+    EZ_DEFAULT_DELETE(s_pTelemetryStream);
+    ezTelemetry::Broadcast(ezTelemetry::Reliable, 'PROF', ' END', nullptr, 0);
+  }
+}
+
+#else
+
+bool ezProfilingSystem::IsTelemetryStreamActive()
+{
+  return false;
+}
+
+void ezProfilingSystem::UpdateTelemetryStream() {}
+
+#endif
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Profiling_Implementation_ProfilingTelemetry);
@@ -2,13 +2,43 @@
 
 #include <Foundation/Basics.h>
 #include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Containers/HashTable.h>
 #include <Foundation/Containers/StaticRingBuffer.h>
+#include <Foundation/Strings/HashedString.h>
+#include <Foundation/Strings/String.h>
 #include <Foundation/System/Process.h>
 #include <Foundation/Time/Time.h>
+#include <Foundation/Types/Delegate.h>
 
+class ezStreamReader;
 class ezStreamWriter;
 class ezThread;
 
+/// \brief Configuration for ezProfilingSystem::EnableSpikeCapture().
+struct ezProfilingSpikeCaptureSettings
+{
+  /// \brief Frames that take longer than this trigger a capture.
+  ezTime m_FrameTimeThreshold = ezTime::Milliseconds(50);
+
+  /// \brief How many frames before the spike are included in the capture.
+  ezUInt32 m_uiFramesBefore = 30;
+
+  /// \brief How many frames after the spike are recorded before the capture is taken.
+  ezUInt32 m_uiFramesAfter = 10;
+
+  /// \brief Spikes are ignored for this long after a capture was taken, to prevent a slow phase from flooding the disk.
+  ezTime m_MinTimeBetweenCaptures = ezTime::Seconds(30);
+
+  /// \brief The maximum number of captures that are written until EnableSpikeCapture() is called again.
+  ezUInt32 m_uiMaxCaptures = 10;
+
+  /// \brief The folder into which the captures are written, in the binary capture format.
+  ezString m_sOutputFolder = ":appdata/Profiling/Spikes";
+
+  /// \brief Optional callback that is called with the path of every written capture, e.g. to upload it. Called from a background thread.
+  ezDelegate<void(const char*)> m_OnCaptureWritten;
+};
+
 /// \brief This class encapsulates a profiling scope.
 ///
 /// The constructor creates a new scope in the profiling system and the destructor pops the scope.
@@ -23,6 +53,9 @@ protected:
   const char* m_szName;
   const char* m_szFunction;
   ezTime m_BeginTime;
+  ezUInt64 m_uiBeginNumAllocations;
+  ezUInt64 m_uiBeginAllocationSize;
+  bool m_bCountAllocations;
 };
 
 /// \brief This class implements a profiling scope similar to ezProfilingScope, but with additional sub-scopes which can be added easily without
@@ -76,9 +109,60 @@ public:
     char m_szName[NAME_SIZE];
   };
 
+  /// \brief Allocations that the thread made within a scope, see SetAllocationCountingEnabled().
+  struct ScopeAllocations
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiScopeIndex; ///< Index of the scope in CPUScopesBufferFlat::m_Data.
+    ezUInt32 m_uiNumAllocations;
+    ezUInt64 m_uiAllocationSize;
+  };
+
+  /// \brief A value of a counter track, see EZ_PROFILE_COUNTER.
+  struct CounterSample
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    static constexpr ezUInt32 NAME_SIZE = 48;
+
+    ezTime m_Time;
+    double m_fValue;
+    char m_szName[NAME_SIZE];
+  };
+
+  /// \brief An instant event, see EZ_PROFILE_MARKER.
+  struct Marker
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    static constexpr ezUInt32 NAME_SIZE = 48;
+
+    const char* m_szFunctionName;
+    ezTime m_Time;
+    char m_szName[NAME_SIZE];
+  };
+
+  /// \brief A call stack of a thread that was recorded by the sampling profiler, see StartSampling().
+  struct StackSample
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    static constexpr ezUInt32 MAX_FRAMES = 30;
+
+    ezTime m_Time;
+    ezUInt32 m_uiNumFrames;
+    ezUInt32 m_uiReserved;
+    ezUInt64 m_Frames[MAX_FRAMES]; ///< Return addresses, the innermost function first.
+  };
+
   struct CPUScopesBufferFlat
   {
     ezDynamicArray<CPUScope> m_Data;
+    ezDynamicArray<ScopeAllocations> m_ScopeAllocations; ///< Only for scopes that allocated, sorted by scope index.
+    ezDynamicArray<CounterSample> m_CounterSamples;
+    ezDynamicArray<Marker> m_Markers;
+    ezDynamicArray<StackSample> m_StackSamples;
     ezUInt64 m_uiThreadId = 0;
   };
 
@@ -109,11 +193,37 @@ public:
 
     ezDynamicArray<GPUScope> m_GPUScopes;
 
+    /// \brief Strings of a capture that was read through ReadBinary(). Keeps the function names of the scopes alive.
+    ezDynamicArray<ezHashedString> m_Strings;
+
+    /// \brief Maps the addresses in the stack samples to function names, filled by ResolveStackFrameSymbols().
+    ezHashTable<ezUInt64, ezString> m_StackFrameSymbols;
+
     /// \brief Writes profiling data as JSON to the output stream.
     ezResult Write(ezStreamWriter& outputStream) const;
 
+    /// \brief Writes profiling data in the compact binary capture format to the output stream.
+    ///
+    /// Scope names are only stored once and timestamps are delta encoded, which makes the output a fraction of the size of the JSON output.
+    /// \sa ezProfilingCaptureFormat
+    ezResult WriteBinary(ezStreamWriter& outputStream) const;
+
+    /// \brief Reads a capture in the binary format, which was written either by WriteBinary() or streamed through StartCaptureStream().
+    ///
+    /// All chunks of a streamed capture are merged, so the result can be written as JSON through Write().
+    ezResult ReadBinary(ezStreamReader& inputStream);
+
     void Clear();
 
+    /// \brief Removes all scopes, frames, counter samples, markers and stack samples that lie completely outside of the given time range.
+    void RemoveEventsOutsideTimeRange(ezTime beginTime, ezTime endTime);
+
+    /// \brief Looks up the function names of all addresses in the stack samples through ezStackTracer.
+    ///
+    /// Sampling only records raw addresses, to keep the signal handler cheap. The names have to be resolved by the process that recorded
+    /// the samples, before the capture is written, since the addresses are meaningless in any other process.
+    void ResolveStackFrameSymbols();
+
     /// \brief Concatenates all given ProfilingData instances into one merge struct
     static void Merge(ProfilingData& out_Merged, ezArrayPtr<const ProfilingData*> inputs);
   };
@@ -129,14 +239,102 @@ public:
   /// \brief Should be called once per frame to capture the timestamp of the new frame.
   static void StartNewFrame();
 
+  /// \brief Enables recording the number and size of the allocations that are made inside each ezProfilingScope.
+  ///
+  /// Allocations are counted per thread and include nested scopes. Scopes that allocated memory are kept even if they are shorter than the
+  /// discard threshold, so per-frame allocations in hot paths show up in captures. Disabled by default.
+  /// \sa ezAllocatorBase::SetThreadAllocationCountingEnabled()
+  static void SetAllocationCountingEnabled(bool bEnable);
+
+  /// \brief Returns whether SetAllocationCountingEnabled() has been enabled.
+  static bool IsAllocationCountingEnabled();
+
   /// \brief Adds a new scoped event for the calling thread in the profiling system
-  static void AddCPUScope(const char* szName, const char* szFunctionName, ezTime beginTime, ezTime endTime);
+  static void AddCPUScope(const char* szName, const char* szFunctionName, ezTime beginTime, ezTime endTime, ezUInt32 uiNumAllocations = 0, ezUInt64 uiAllocationSize = 0);
+
+  /// \brief Adds a sample of the named counter track for the calling thread. Use EZ_PROFILE_COUNTER instead of calling this directly.
+  static void AddCounterSample(const char* szName, double fValue);
+
+  /// \brief Adds an instant event for the calling thread. Use EZ_PROFILE_MARKER instead of calling this directly.
+  static void AddMarker(const char* szName, const char* szFunctionName);
+
+  /// \brief Starts streaming all profiling data that is recorded from now on to the given file, in the binary capture format.
+  ///
+  /// The data is written continuously by a background thread, so captures are not limited by the size of the internal ring buffers.
+  /// If zstd support is available, the file is compressed with ezCompressedStreamWriterZstd.
+  /// Use the ProfilingConverter tool to convert the file to the Chrome trace JSON format, which is also understood by Perfetto.
+  static ezResult StartCaptureStream(const char* szFile, ezTime flushInterval = ezTime::Milliseconds(100));
+
+  /// \brief Same as above, but writes into the given stream, which has to stay valid until StopCaptureStream() is called.
+  ///
+  /// The stream is only accessed from the background thread and from StopCaptureStream(). It is flushed after every batch, so it can
+  /// forward the data, e.g. over the network.
+  /// If \a uiMaxBytesPerSecond is not zero, the data of a thread is dropped whenever it would exceed the limit for the last second. Frames are
+  /// still written, so the gaps are visible in the timeline. The limit refers to the uncompressed capture format.
+  static ezResult StartCaptureStream(ezStreamWriter* pOutputStream, ezTime flushInterval = ezTime::Milliseconds(100), ezUInt32 uiMaxBytesPerSecond = 0);
+
+  /// \brief Writes all outstanding data and stops the capture stream.
+  static void StopCaptureStream();
+
+  /// \brief Same as above, but only if the capture stream still writes into \a pOutputStream, so a stream that replaced it keeps running.
+  static void StopCaptureStream(const ezStreamWriter* pOutputStream);
+
+  /// \brief Returns whether a capture stream is currently active.
+  static bool IsCaptureStreamActive();
+
+  /// \brief Returns whether a tool is currently receiving a live capture stream over ezTelemetry.
+  ///
+  /// A connected tool requests the stream with the message 'PROF' / ' ON ', which contains the flush interval (ezTime) and the bandwidth limit
+  /// in bytes per second (ezUInt32, zero means unlimited). The application answers with 'PROF' / ' BGN', which tells whether the stream is
+  /// zstd compressed (bool), followed by 'PROF' / 'DATA' messages, which contain the stream in the binary capture format. Written to a file
+  /// in order, the data is a regular capture file. The stream ends with 'PROF' / ' END', when the tool sends 'PROF' / ' OFF' or disconnects.
+  ///
+  /// Requests are handled in StartNewFrame(). While a tool receives the stream, StartCaptureStream() cannot be used.
+  static bool IsTelemetryStreamActive();
+
+  /// \brief Enables the flight recorder mode, which writes a capture of the last frames whenever a frame takes too long.
+  ///
+  /// The ring buffers record continuously, StartNewFrame() compares each frame's duration against the threshold. When a spike is
+  /// detected, the frames around it are captured and written to disk by a background thread, so collecting hitches does not cause
+  /// new ones. This allows to gather captures of hitches from unattended servers and soak tests.
+  static void EnableSpikeCapture(const ezProfilingSpikeCaptureSettings& settings);
+
+  /// \brief Disables the spike capture. Waits until a capture that is currently being written is finished.
+  static void DisableSpikeCapture();
+
+  /// \brief Returns whether EnableSpikeCapture() was called.
+  static bool IsSpikeCaptureEnabled();
+
+  /// \brief Returns the number of spike captures that were written since EnableSpikeCapture() was called.
+  static ezUInt32 GetNumWrittenSpikeCaptures();
+
+  /// \brief Returns whether StartSampling() is implemented on the current platform. Currently only Linux builds with the CMake option
+  /// EZ_ENABLE_FRAME_POINTERS are supported.
+  static bool IsSamplingSupported();
+
+  /// \brief Starts a statistical profiler, which records the call stacks of all threads known to the profiling system.
+  ///
+  /// Each thread is interrupted after it consumed \a samplingInterval of CPU time and its call stack is stored in a lock-free buffer of
+  /// that thread. The samples are added to Capture() next to the scopes, so hot spots in code without any profiling scopes show up as well.
+  /// Call ProfilingData::ResolveStackFrameSymbols() before writing a capture, to get function names instead of addresses.
+  static ezResult StartSampling(ezTime samplingInterval = ezTime::Milliseconds(1));
+
+  /// \brief Stops the sampling profiler and discards the recorded samples, so call Capture() before.
+  static void StopSampling();
+
+  /// \brief Returns whether StartSampling() is active.
+  static bool IsSamplingActive();
 
 private:
   EZ_MAKE_SUBSYSTEM_STARTUP_FRIEND(Foundation, ProfilingSystem);
+  EZ_MAKE_SUBSYSTEM_STARTUP_FRIEND(Foundation, ProfilingSampler);
   friend ezUInt32 RunThread(ezThread* pThread);
 
   static void Initialize();
+  /// \brief Checks whether the last frame was a spike and triggers a capture if necessary. Called by StartNewFrame().
+  static void UpdateSpikeCapture(ezTime lastFrameStartTime, ezTime frameStartTime);
+  /// \brief Starts or stops the live capture stream, when a tool requested it over ezTelemetry. Called by StartNewFrame().
+  static void UpdateTelemetryStream();
   /// \brief Removes profiling data of dead threads.
   static void Reset();
 
@@ -146,6 +344,15 @@ private:
   ///  Needs to be called before the thread exits to be able to release profiling memory of dead threads on Reset.
   static void RemoveThread();
 
+  /// \brief Allows the sampling profiler to record the current thread. Called by SetThreadName().
+  static void AddSampledThread();
+  /// \brief Called by RemoveThread(), releases the sampling data of the current thread.
+  static void RemoveSampledThread();
+  /// \brief Adds the stack samples of all threads to the capture.
+  static void CaptureStackSamples(ProfilingData& out_Capture);
+  /// \brief Discards all recorded stack samples.
+  static void ClearStackSamples();
+
 public:
   /// \brief Initialized internal data structures for GPU profiling data. Needs to be called before adding any data.
   static void InitializeGPUData();
@@ -187,6 +394,15 @@ public:
 /// \sa EZ_PROFILE_LIST_SCOPE
 #  define EZ_PROFILE_LIST_NEXT_SECTION(szNextSectionName) ezProfilingListScope::StartNextSection(szNextSectionName)
 
+/// \brief Records the current value of a counter, e.g. memory in use or the number of queued tasks.
+///
+/// All samples with the same name form one counter track in the capture, which allows to correlate spikes in the frame time with the
+/// state of the engine. The name is copied, the value is converted to double.
+#  define EZ_PROFILE_COUNTER(szCounterName, value) ezProfilingSystem::AddCounterSample(szCounterName, static_cast<double>(value))
+
+/// \brief Records an instant event with the given name in the timeline of the calling thread, e.g. when a level finished loading.
+#  define EZ_PROFILE_MARKER(szMarkerName) ezProfilingSystem::AddMarker(szMarkerName, EZ_SOURCE_FUNCTION)
+
 #else
 
 #  define EZ_PROFILE_SCOPE(Name) /*empty*/
@@ -195,4 +411,8 @@ public:
 
 #  define EZ_PROFILE_LIST_NEXT_SECTION(szNextSectionName) /*empty*/
 
+#  define EZ_PROFILE_COUNTER(szCounterName, value) /*empty*/
+
+#  define EZ_PROFILE_MARKER(szMarkerName) /*empty*/
+
 #endif
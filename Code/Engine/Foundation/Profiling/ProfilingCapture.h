@@ -0,0 +1,120 @@
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Strings/String.h>
+
+class ezStreamWriter;
+
+/// \brief Constants of the binary profiling capture format.
+///
+/// A capture starts with a small header (magic and version), followed by a sequence of chunks. Every chunk starts with its type (ezUInt8)
+/// and the size of its payload (ezUInt32), so readers can skip chunk types that they don't know.
+///
+/// Scope names are stored only once in String chunks, all other chunks reference them by index (index 0 means 'no string').
+/// Integers are stored as variable length integers, timestamps are stored as nanoseconds, delta encoded against the previous event in the
+/// same chunk. A capture that is streamed to disk simply consists of many chunks, the reader merges them into one ezProfilingSystem::ProfilingData.
+struct ezProfilingCaptureFormat
+{
+  static constexpr char Magic[4] = {'E', 'Z', 'P', 'C'};
+  static constexpr ezUInt8 Version = 1;
+
+  /// \brief Chunks are never larger than this, readers reject captures with larger chunks as corrupted.
+  static constexpr ezUInt32 MaxChunkSize = 256 * 1024 * 1024;
+
+  enum class ChunkType : ezUInt8
+  {
+    Process = 1,            ///< Process ID and the IDs of the virtual frames and GPU threads.
+    Strings = 2,            ///< New entries for the string table.
+    Threads = 3,            ///< Thread IDs and their names.
+    CPUScopes = 4,          ///< Scopes of one thread.
+    Frames = 5,             ///< Frame start times and the total frame count.
+    GPUScopes = 6,          ///< GPU scopes.
+    CounterSamples = 7,     ///< Counter samples of one thread.
+    Markers = 8,            ///< Instant markers of one thread.
+    ScopeAllocations = 9,   ///< Allocation counts of the scopes in the preceding CPU scopes chunk.
+    StackSamples = 10,      ///< Call stacks of one thread, recorded by the sampling profiler.
+    StackFrameSymbols = 11, ///< Function names of stack frame addresses.
+  };
+};
+
+/// \brief Writes profiling data in the binary capture format (see ezProfilingCaptureFormat) into a stream.
+///
+/// The writer keeps the string table across all chunks, so it can be used to stream a capture piece by piece, e.g. every few frames.
+/// Scopes are added between BeginCPUScopes() and EndCPUScopes(), the chunk is only written to the output stream by EndCPUScopes().
+class EZ_FOUNDATION_DLL ezProfilingCaptureWriter
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezProfilingCaptureWriter);
+
+public:
+  ezProfilingCaptureWriter();
+  ~ezProfilingCaptureWriter();
+
+  /// \brief Sets the stream into which all chunks are written and writes the header and the process chunk.
+  ///
+  /// Resets the string table, so the writer can be reused for another capture.
+  ezResult Begin(ezStreamWriter* pOutputStream, ezOsProcessID uiProcessID, ezUInt64 uiFramesThreadID, ezUInt64 uiGPUThreadID);
+
+  /// \brief Writes a chunk with the given thread names.
+  ezResult WriteThreadInfos(ezArrayPtr<const ezProfilingSystem::ThreadInfo> threadInfos);
+
+  /// \brief Writes a chunk with frame start times. \a uiFrameCount is the total number of frames up to the last given start time.
+  ezResult WriteFrames(ezArrayPtr<const ezTime> frameStartTimes, ezUInt64 uiFrameCount);
+
+  /// \brief Starts a chunk of CPU scopes of the given thread.
+  void BeginCPUScopes(ezUInt64 uiThreadID);
+
+  /// \brief Adds a scope to the current CPU scopes chunk. The function name may be nullptr.
+  ///
+  /// Function names are interned by pointer, since they are typically string literals. Call ClearFunctionNameCache() when they may
+  /// become invalid, e.g. when a plugin is unloaded.
+  void AddCPUScope(ezStringView sName, const char* szFunctionName, ezTime beginTime, ezTime endTime, ezUInt32 uiNumAllocations = 0, ezUInt64 uiAllocationSize = 0);
+
+  /// \brief Writes the current CPU scopes chunk, preceded by a chunk with all new strings and followed by a chunk with the allocation counts,
+  /// if any scope allocated memory.
+  ezResult EndCPUScopes();
+
+  /// \brief Writes a chunk with GPU scopes.
+  ezResult WriteGPUScopes(ezArrayPtr<const ezProfilingSystem::GPUScope> scopes);
+
+  /// \brief Writes a chunk with the counter samples of the given thread.
+  ezResult WriteCounterSamples(ezUInt64 uiThreadID, ezArrayPtr<const ezProfilingSystem::CounterSample> samples);
+
+  /// \brief Writes a chunk with the markers of the given thread.
+  ezResult WriteMarkers(ezUInt64 uiThreadID, ezArrayPtr<const ezProfilingSystem::Marker> markers);
+
+  /// \brief Writes a chunk with the stack samples of the given thread.
+  ezResult WriteStackSamples(ezUInt64 uiThreadID, ezArrayPtr<const ezProfilingSystem::StackSample> samples);
+
+  /// \brief Writes a chunk with the function names of stack frame addresses.
+  ezResult WriteStackFrameSymbols(const ezHashTable<ezUInt64, ezString>& symbols);
+
+  /// \brief Forgets the function names that were interned by pointer. Their strings stay in the string table.
+  void ClearFunctionNameCache();
+
+  /// \brief Returns the number of bytes that were written to the output stream since Begin().
+  ezUInt64 GetWrittenBytes() const { return m_uiWrittenBytes; }
+
+private:
+  ezUInt32 InternString(ezStringView sString);
+  ezUInt32 InternFunctionName(const char* szFunctionName);
+  ezResult WriteChunk(ezProfilingCaptureFormat::ChunkType type, ezArrayPtr<const ezUInt8> payload);
+  ezResult WritePendingStrings();
+
+  ezStreamWriter* m_pOutputStream = nullptr;
+  ezUInt64 m_uiWrittenBytes = 0;
+
+  ezHashTable<ezUInt64, ezUInt32> m_StringHashToIndex;
+  ezHashTable<const char*, ezUInt32, ezHashHelper<const void*>> m_FunctionNameToIndex;
+  ezDynamicArray<ezString> m_Strings;
+  ezUInt32 m_uiWrittenStrings = 0;
+
+  ezDynamicArray<ezUInt8> m_ChunkData;
+  ezDynamicArray<ezUInt8> m_StringChunkData;
+  ezDynamicArray<ezUInt8> m_AllocationChunkData;
+  ezInt64 m_iPrevTimestamp = 0;
+  ezUInt32 m_uiNumScopes = 0;
+  ezUInt32 m_uiPrevAllocatingScope = 0;
+  bool m_bInCPUScopes = false;
+};
@@ -267,6 +267,15 @@ public:
   /// \brief Sets the value of pObject to the property in pInstance.
   /// pObject needs to point to an instance of this property's type.
   virtual void SetValuePtr(void* pInstance, const void* pObject) = 0;
+
+  /// \brief Returns the byte offset of the member inside the instance, or ezInvalidIndex if it is not known.
+  ///
+  /// The offset is only known for properties that expose a member variable directly, e.g. through EZ_MEMBER_PROPERTY.
+  /// It is taken from the member pointer when the property is registered, so it is available without an instance.
+  EZ_ALWAYS_INLINE ezUInt32 GetMemberOffset() const { return m_uiMemberOffset; }
+
+protected:
+  ezUInt32 m_uiMemberOffset = ezInvalidIndex;
 };
 
 
@@ -63,7 +63,7 @@ public:
   using PointerFunc = void* (*)(const Class* pInstance);
 
   /// \brief Constructor.
-  ezBitflagsMemberProperty(const char* szPropertyName, GetterFunc getter, SetterFunc setter, PointerFunc pointer)
+  ezBitflagsMemberProperty(const char* szPropertyName, GetterFunc getter, SetterFunc setter, PointerFunc pointer, ezUInt32 uiMemberOffset = ezInvalidIndex)
     : ezTypedEnumProperty<EnumType>(szPropertyName)
   {
     EZ_ASSERT_DEBUG(getter != nullptr, "The getter of a property cannot be nullptr.");
@@ -72,6 +72,7 @@ public:
     m_Getter = getter;
     m_Setter = setter;
     m_Pointer = pointer;
+    ezAbstractMemberProperty::m_uiMemberOffset = uiMemberOffset;
 
     if (m_Setter == nullptr)
       ezAbstractMemberProperty::m_Flags.Add(ezPropertyFlags::ReadOnly);
@@ -115,7 +115,7 @@ public:
   using PointerFunc = void* (*)(const Class* pInstance);
 
   /// \brief Constructor.
-  ezEnumMemberProperty(const char* szPropertyName, GetterFunc getter, SetterFunc setter, PointerFunc pointer)
+  ezEnumMemberProperty(const char* szPropertyName, GetterFunc getter, SetterFunc setter, PointerFunc pointer, ezUInt32 uiMemberOffset = ezInvalidIndex)
     : ezTypedEnumProperty<EnumType>(szPropertyName)
   {
     EZ_ASSERT_DEBUG(getter != nullptr, "The getter of a property cannot be nullptr.");
@@ -124,6 +124,7 @@ public:
     m_Getter = getter;
     m_Setter = setter;
     m_Pointer = pointer;
+    ezAbstractMemberProperty::m_uiMemberOffset = uiMemberOffset;
 
     if (m_Setter == nullptr)
       ezAbstractMemberProperty::m_Flags.Add(ezPropertyFlags::ReadOnly);
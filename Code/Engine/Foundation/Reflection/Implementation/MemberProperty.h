@@ -135,6 +135,29 @@ private:
 // *************************************************************
 // ***** Classes for properties that are accessed directly *****
 
+/// \brief [internal] Returns the byte offset of the member that pMember points to, or ezInvalidIndex if the offset can't be determined.
+///
+/// Pointers to data members are stored as a plain byte offset by all supported compilers, as long as the class has no virtual base
+/// classes. The Itanium C++ ABI always uses a ptrdiff_t for them. MSVC uses a 32 bit integer and larger representations when virtual
+/// inheritance is involved, in which case no offset is returned.
+template <typename Class, typename Type>
+ezUInt32 ezGetMemberOffset(Type Class::*pMember)
+{
+#if EZ_ENABLED(EZ_PLATFORM_WINDOWS)
+  if (sizeof(pMember) != sizeof(ezInt32))
+    return ezInvalidIndex;
+
+  ezInt32 iOffset = 0;
+#else
+  EZ_CHECK_AT_COMPILETIME(sizeof(pMember) == sizeof(ptrdiff_t));
+
+  ptrdiff_t iOffset = 0;
+#endif
+
+  ezMemoryUtils::RawByteCopy(&iOffset, &pMember, sizeof(iOffset));
+  return static_cast<ezUInt32>(iOffset);
+}
+
 /// \brief [internal] Helper class to generate accessor functions for (private) members of another class
 template <typename Class, typename Type, Type Class::*Member>
 struct ezPropertyAccessor
@@ -144,6 +167,8 @@ struct ezPropertyAccessor
   static void SetValue(Class* pInstance, Type value) { (*pInstance).*Member = value; }
 
   static void* GetPropertyPointer(const Class* pInstance) { return (void*)&((*pInstance).*Member); }
+
+  static ezUInt32 GetMemberOffset() { return ezGetMemberOffset(Member); }
 };
 
 
@@ -157,7 +182,7 @@ public:
   using PointerFunc = void* (*)(const Class* pInstance);
 
   /// \brief Constructor.
-  ezMemberProperty(const char* szPropertyName, GetterFunc getter, SetterFunc setter, PointerFunc pointer)
+  ezMemberProperty(const char* szPropertyName, GetterFunc getter, SetterFunc setter, PointerFunc pointer, ezUInt32 uiMemberOffset = ezInvalidIndex)
     : ezTypedMemberProperty<Type>(szPropertyName)
   {
     EZ_ASSERT_DEBUG(getter != nullptr, "The getter of a property cannot be nullptr.");
@@ -165,6 +190,7 @@ public:
     m_Getter = getter;
     m_Setter = setter;
     m_Pointer = pointer;
+    ezAbstractMemberProperty::m_uiMemberOffset = uiMemberOffset;
 
     if (m_Setter == nullptr)
       ezAbstractMemberProperty::m_Flags.Add(ezPropertyFlags::ReadOnly);
@@ -0,0 +1,67 @@
+#include <FoundationPCH.h>
+
+#include <Foundation/Reflection/Implementation/PropertyTable.h>
+#include <Foundation/Reflection/ReflectionUtils.h>
+
+ezRTTIPropertyTable::ezRTTIPropertyTable(const ezRTTI* pType)
+{
+  ezHybridArray<ezAbstractProperty*, 32> properties;
+  pType->GetAllProperties(properties);
+
+  m_Entries.SetCountUninitialized(properties.GetCount());
+  m_NameToEntry.Reserve(properties.GetCount());
+
+  for (ezUInt32 i = 0; i < properties.GetCount(); ++i)
+  {
+    ezAbstractProperty* pProp = properties[i];
+
+    Entry& entry = m_Entries[i];
+    entry.m_pProperty = pProp;
+    entry.m_uiOffset = ezInvalidIndex;
+    entry.m_Type = ezVariantType::Invalid;
+
+    if (pProp->GetCategory() == ezPropertyCategory::Member && !pProp->GetFlags().IsSet(ezPropertyFlags::Pointer))
+    {
+      // the offset was taken from the member pointer when the property was registered
+      const ezUInt32 uiOffset = static_cast<ezAbstractMemberProperty*>(pProp)->GetMemberOffset();
+
+      if (uiOffset != ezInvalidIndex)
+      {
+        entry.m_uiOffset = uiOffset;
+
+        const ezRTTI* pPropType = pProp->GetSpecificType();
+        const ezVariantType::Enum type = pPropType->GetVariantType();
+
+        // only report the variant type if the member really stores that type, e.g. not for 'const char*' or ezUntrackedString
+        if (pProp->GetFlags().IsSet(ezPropertyFlags::StandardType) && type > ezVariantType::FirstStandardType && type < ezVariantType::LastStandardType &&
+            ezReflectionUtils::GetTypeFromVariant(type) == pPropType)
+        {
+          entry.m_Type = type;
+        }
+      }
+    }
+
+    // derived types are added last, so their properties take precedence, same as in ezRTTI::FindPropertyByName
+    m_NameToEntry.Insert(pProp->GetPropertyName(), i);
+  }
+}
+
+const ezRTTIPropertyTable::Entry* ezRTTIPropertyTable::FindEntry(const char* szName) const
+{
+  if (szName == nullptr)
+    return nullptr;
+
+  ezUInt32 uiIndex = 0;
+  if (m_NameToEntry.TryGetValue(szName, uiIndex))
+    return &m_Entries[uiIndex];
+
+  return nullptr;
+}
+
+ezAbstractProperty* ezRTTIPropertyTable::FindProperty(const char* szName) const
+{
+  const Entry* pEntry = FindEntry(szName);
+  return pEntry != nullptr ? pEntry->m_pProperty : nullptr;
+}
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Reflection_Implementation_PropertyTable);
@@ -0,0 +1,82 @@
+#pragma once
+
+/// \file
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/Memory/AllocatorWrapper.h>
+#include <Foundation/Reflection/Implementation/AbstractProperty.h>
+
+/// \brief A flattened table of all properties of a type, including the properties of all its base types.
+///
+/// The table is built on first use by ezRTTI::GetPropertyTable() and stays valid for as long as the type exists. When the properties of
+/// a type change at runtime (phantom types), a new table is built and the old one stays valid until the next plugin is unloaded.
+/// The properties are stored in the same order in which ezRTTI::GetAllProperties() returns them, and they can be looked up by name
+/// through a hash table, instead of searching linearly through the entire type hierarchy.
+///
+/// For member properties that are stored directly inside an object, the table also stores the byte offset of the member and
+/// the variant type of its value. Hot code paths can use this to read and write member values without calling any virtual
+/// functions and without boxing the values in an ezVariant.
+class EZ_FOUNDATION_DLL ezRTTIPropertyTable
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezRTTIPropertyTable);
+
+public:
+  struct Entry
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    /// \brief Returns true if the member is stored directly inside the object and can be accessed through GetMemberPointer().
+    EZ_ALWAYS_INLINE bool HasDirectAccess() const { return m_uiOffset != ezInvalidIndex; }
+
+    /// \brief Returns the address of the member inside pObject. Only valid if HasDirectAccess() returns true.
+    EZ_ALWAYS_INLINE const void* GetMemberPointer(const void* pObject) const
+    {
+      EZ_ASSERT_DEBUG(static_cast<const ezAbstractMemberProperty*>(m_pProperty)->GetPropertyPointer(pObject) == ezMemoryUtils::AddByteOffset(pObject, m_uiOffset),
+        "The offset of property '{0}' is wrong.", m_pProperty->GetPropertyName());
+      return ezMemoryUtils::AddByteOffset(pObject, m_uiOffset);
+    }
+
+    /// \brief Returns the address of the member inside pObject. Only valid if HasDirectAccess() returns true.
+    EZ_ALWAYS_INLINE void* GetMemberPointer(void* pObject) const { return const_cast<void*>(GetMemberPointer(static_cast<const void*>(pObject))); }
+
+    /// \brief Returns the value of a directly accessible member. T has to be the exact type of the member, which is checked in debug builds.
+    template <typename T>
+    EZ_ALWAYS_INLINE const T& GetValue(const void* pObject) const
+    {
+      EZ_ASSERT_DEBUG(HasDirectAccess() && m_pProperty->GetSpecificType() == ezGetStaticRTTI<T>(), "Property '{0}' can't be accessed as the given type.",
+        m_pProperty->GetPropertyName());
+      return *static_cast<const T*>(GetMemberPointer(pObject));
+    }
+
+    /// \brief Sets the value of a directly accessible member. T has to be the exact type of the member, which is checked in debug builds.
+    template <typename T>
+    EZ_ALWAYS_INLINE void SetValue(void* pObject, const T& value) const
+    {
+      EZ_ASSERT_DEBUG(HasDirectAccess() && m_pProperty->GetSpecificType() == ezGetStaticRTTI<T>(), "Property '{0}' can't be accessed as the given type.",
+        m_pProperty->GetPropertyName());
+      EZ_ASSERT_DEBUG(!m_pProperty->GetFlags().IsSet(ezPropertyFlags::ReadOnly), "Property '{0}' is read-only.", m_pProperty->GetPropertyName());
+      *static_cast<T*>(GetMemberPointer(pObject)) = value;
+    }
+
+    ezAbstractProperty* m_pProperty;
+    ezUInt32 m_uiOffset;        ///< The offset of the member inside the object, or ezInvalidIndex if the member can't be accessed directly.
+    ezVariantType::Enum m_Type; ///< For directly accessible members whose type is exactly the type that ezVariant stores, this is the variant type. Invalid otherwise.
+  };
+
+  /// \brief Builds the table for the given type. Use ezRTTI::GetPropertyTable() instead of creating tables yourself.
+  ezRTTIPropertyTable(const ezRTTI* pType);
+
+  /// \brief Returns all properties of the type, starting with the properties of the topmost base type.
+  EZ_ALWAYS_INLINE ezArrayPtr<const Entry> GetEntries() const { return m_Entries; }
+
+  /// \brief Returns the entry for the property with the given name, or nullptr if the type has no such property.
+  const Entry* FindEntry(const char* szName) const;
+
+  /// \brief Returns the property with the given name, or nullptr if the type has no such property.
+  ezAbstractProperty* FindProperty(const char* szName) const;
+
+private:
+  ezDynamicArray<Entry, ezStaticAllocatorWrapper> m_Entries;
+  ezHashTable<const char*, ezUInt32, ezHashHelper<const char*>, ezStaticAllocatorWrapper> m_NameToEntry;
+};
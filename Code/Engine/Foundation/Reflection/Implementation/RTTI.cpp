@@ -2,13 +2,21 @@
 
 #include <Foundation/Reflection/Implementation/AbstractProperty.h>
 #include <Foundation/Reflection/Implementation/MessageHandler.h>
+#include <Foundation/Reflection/Implementation/PropertyTable.h>
 
 #include <Foundation/Communication/Message.h>
 #include <Foundation/Configuration/Startup.h>
 #include <Foundation/Containers/HashTable.h>
+#include <Foundation/Threading/AtomicUtils.h>
+#include <Foundation/Threading/Mutex.h>
 
 typedef ezHashTable<const char*, ezRTTI*, ezHashHelper<const char*>, ezStaticAllocatorWrapper> ezTypeHashTable;
 
+// property tables that were invalidated, but may still be in use by other threads, and the properties that they reference
+static ezMutex s_RetiredPropertyTablesMutex;
+static ezDynamicArray<ezRTTIPropertyTable*, ezStaticAllocatorWrapper> s_RetiredPropertyTables;
+static ezDynamicArray<ezAbstractProperty*, ezStaticAllocatorWrapper> s_RetiredProperties;
+
 EZ_ENUMERABLE_CLASS_IMPLEMENTATION(ezRTTI);
 
 // clang-format off
@@ -27,6 +35,7 @@ EZ_BEGIN_SUBSYSTEM_DECLARATION(Foundation, Reflection)
   ON_CORESYSTEMS_SHUTDOWN
   {
     ezPlugin::s_PluginEvents.RemoveEventHandler(ezRTTI::PluginEventHandler);
+    ezRTTI::FreeRetiredPropertyTables();
   }
 
 EZ_END_SUBSYSTEM_DECLARATION;
@@ -72,6 +81,8 @@ ezRTTI::~ezRTTI()
 {
   if (m_szTypeName)
     UnregisterType(this);
+
+  EZ_DELETE(ezStaticAllocatorWrapper::GetAllocator(), m_pPropertyTable);
 }
 
 void ezRTTI::GatherDynamicMessageHandlers()
@@ -223,6 +234,66 @@ bool ezRTTI::IsDerivedFrom(const ezRTTI* pBaseType) const
   return false;
 }
 
+const ezRTTIPropertyTable& ezRTTI::GetPropertyTable() const
+{
+  while (true)
+  {
+    ezRTTIPropertyTable* pTable = static_cast<ezRTTIPropertyTable*>(ezAtomicUtils::Read(reinterpret_cast<void**>(&m_pPropertyTable)));
+    if (pTable != nullptr)
+      return *pTable;
+
+    pTable = EZ_NEW(ezStaticAllocatorWrapper::GetAllocator(), ezRTTIPropertyTable, this);
+
+    if (ezAtomicUtils::TestAndSet(reinterpret_cast<void**>(&m_pPropertyTable), nullptr, pTable))
+      return *pTable;
+
+    // another thread has built the table in the meantime, that one is used
+    EZ_DELETE(ezStaticAllocatorWrapper::GetAllocator(), pTable);
+  }
+}
+
+void ezRTTI::InvalidatePropertyTables()
+{
+  for (ezRTTI* pRtti = ezRTTI::GetFirstInstance(); pRtti != nullptr; pRtti = pRtti->GetNextInstance())
+  {
+    ezRTTIPropertyTable* pTable = static_cast<ezRTTIPropertyTable*>(ezAtomicUtils::Read(reinterpret_cast<void**>(&pRtti->m_pPropertyTable)));
+
+    if (pTable != nullptr && pRtti->IsDerivedFrom(this) && ezAtomicUtils::TestAndSet(reinterpret_cast<void**>(&pRtti->m_pPropertyTable), pTable, nullptr))
+    {
+      // other threads may still hold a reference to the old table, so it is only deleted at the next safe point
+      EZ_LOCK(s_RetiredPropertyTablesMutex);
+      s_RetiredPropertyTables.PushBack(pTable);
+    }
+  }
+}
+
+void ezRTTI::RetireProperties(ezArrayPtr<ezAbstractProperty*> properties)
+{
+  EZ_LOCK(s_RetiredPropertyTablesMutex);
+  s_RetiredProperties.PushBackRange(properties);
+}
+
+void ezRTTI::FreeRetiredPropertyTables()
+{
+  EZ_LOCK(s_RetiredPropertyTablesMutex);
+
+  for (ezRTTIPropertyTable* pTable : s_RetiredPropertyTables)
+  {
+    EZ_DELETE(ezStaticAllocatorWrapper::GetAllocator(), pTable);
+  }
+
+  s_RetiredPropertyTables.Clear();
+  s_RetiredPropertyTables.Compact();
+
+  for (ezAbstractProperty* pProp : s_RetiredProperties)
+  {
+    EZ_DEFAULT_DELETE(pProp);
+  }
+
+  s_RetiredProperties.Clear();
+  s_RetiredProperties.Compact();
+}
+
 void ezRTTI::GetAllProperties(ezHybridArray<ezAbstractProperty*, 32>& out_Properties) const
 {
   out_Properties.Clear();
@@ -276,6 +347,9 @@ ezRTTI* ezRTTI::FindTypeByNameHash(ezUInt32 uiNameHash)
 
 ezAbstractProperty* ezRTTI::FindPropertyByName(const char* szName, bool bSearchBaseTypes /* = true */) const
 {
+  if (bSearchBaseTypes)
+    return GetPropertyTable().FindProperty(szName);
+
   const ezRTTI* pInstance = this;
 
   do
@@ -507,6 +581,13 @@ void ezRTTI::PluginEventHandler(const ezPluginEvent& EventData)
     }
     break;
 
+    case ezPluginEvent::AfterUnloading:
+    {
+      // no code that was working with the types of the unloaded plugin can still be running at this point
+      FreeRetiredPropertyTables();
+    }
+    break;
+
     default:
       break;
   }
@@ -17,6 +17,7 @@ class ezAbstractFunctionProperty;
 class ezAbstractMessageHandler;
 struct ezMessageSenderInfo;
 class ezPropertyAttribute;
+class ezRTTIPropertyTable;
 class ezMessage;
 typedef ezUInt16 ezMessageId;
 
@@ -86,6 +87,12 @@ public:
   /// \brief Returns the list of properties that this type has, including derived properties from all base classes.
   void GetAllProperties(ezHybridArray<ezAbstractProperty*, 32>& out_Properties) const; // [tested]
 
+  /// \brief Returns a flattened table of all properties of this type, including those of all base classes.
+  ///
+  /// The table is built on first access. It allows to find properties by name through a hash lookup and to access
+  /// member properties directly through their offset. See ezRTTIPropertyTable for details.
+  const ezRTTIPropertyTable& GetPropertyTable() const;
+
   /// \brief Returns the size (in bytes) of an instance of this type.
   EZ_ALWAYS_INLINE ezUInt32 GetTypeSize() const { return m_uiTypeSize; } // [tested]
 
@@ -155,6 +162,18 @@ protected:
   void UnregisterType(ezRTTI* pType);
 
   void GatherDynamicMessageHandlers();
+
+  /// \brief Discards the property tables of this type and all types derived from it. Has to be called whenever the properties of a type change.
+  ///
+  /// The old tables are not deleted right away, since other threads may still use them. They are kept alive until the next plugin
+  /// is unloaded, or until shutdown.
+  void InvalidatePropertyTables();
+
+  /// \brief Has to be used instead of deleting properties that were part of this type, since retired property tables may still reference them.
+  ///
+  /// The properties are deleted together with the retired property tables. They must have been allocated with EZ_DEFAULT_NEW.
+  static void RetireProperties(ezArrayPtr<ezAbstractProperty*> properties);
+
   /// \brief Returns a hash table that accelerates ezRTTI::FindTypeByName.
   ///   The hash table type cannot be put in the header due to circular includes.
   ///   Function is used by RegisterType / UnregisterType to add / remove type from table.
@@ -179,6 +198,8 @@ protected:
 
   ezArrayPtr<ezMessageSenderInfo> m_MessageSenders;
 
+  mutable ezRTTIPropertyTable* m_pPropertyTable = nullptr; // built lazily by GetPropertyTable()
+
 private:
   EZ_MAKE_SUBSYSTEM_STARTUP_FRIEND(Foundation, Reflection);
 
@@ -187,6 +208,9 @@ private:
 
   static void SanityCheckType(ezRTTI* pType);
 
+  /// \brief Deletes the property tables that were discarded by InvalidatePropertyTables() and the properties passed to RetireProperties().
+  static void FreeRetiredPropertyTables();
+
   /// \brief Handles events by ezPlugin, to figure out which types were provided by which plugin
   static void PluginEventHandler(const ezPluginEvent& EventData);
 };
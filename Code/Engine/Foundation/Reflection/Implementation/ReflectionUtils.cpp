@@ -849,7 +849,7 @@ ezAbstractMemberProperty* ezReflectionUtils::GetMemberProperty(const ezRTTI* pRt
   if (pRtti == nullptr)
     return nullptr;
 
-  if (ezAbstractProperty* pProp = pRtti->FindPropertyByName(szPropertyName))
+  if (ezAbstractProperty* pProp = pRtti->GetPropertyTable().FindProperty(szPropertyName))
   {
     if (pProp->GetCategory() == ezPropertyCategory::Member)
       return static_cast<ezAbstractMemberProperty*>(pProp);
@@ -16,6 +16,7 @@
 #include <Foundation/Reflection/Implementation/MemberProperty.h>
 #include <Foundation/Reflection/Implementation/MessageHandler.h>
 #include <Foundation/Reflection/Implementation/PropertyAttributes.h>
+#include <Foundation/Reflection/Implementation/PropertyTable.h>
 #include <Foundation/Reflection/Implementation/RTTI.h>
 #include <Foundation/Reflection/Implementation/SetProperty.h>
 #include <Foundation/Reflection/Implementation/StaticRTTI.h>
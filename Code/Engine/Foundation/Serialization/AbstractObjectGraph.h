@@ -20,6 +20,10 @@ public:
   {
     const char* m_szPropertyName;
     ezVariant m_Value;
+    ezUInt32 m_uiNameHash; ///< Hash of m_szPropertyName, used to speed up FindProperty().
+
+    /// \brief Computes a hash over the name and the value of the property. Equal properties always produce the same hash.
+    ezUInt64 ComputeHash() const;
   };
 
   ezAbstractObjectNode()
@@ -27,6 +31,8 @@ public:
     , m_uiTypeVersion(0)
     , m_szType(nullptr)
     , m_szNodeName(nullptr)
+    , m_uiContentHash(0)
+    , m_bContentHashValid(false)
   {
   }
 
@@ -55,9 +61,19 @@ public:
 
   const char* GetNodeName() const { return m_szNodeName; }
 
+  /// \brief Returns a hash over all properties of the node that does not depend on the order of the properties.
+  ///
+  /// Two nodes with the same properties and values always have the same content hash, which allows to skip unchanged nodes
+  /// when diffing graphs. The hash is computed on first use and afterwards kept up to date by AddProperty(), ChangeProperty(),
+  /// RemoveProperty() and RenameProperty(). Getting a non-const property through FindProperty() discards the cached hash,
+  /// since the value may be modified through the returned pointer.
+  ezUInt64 GetContentHash() const;
+
 private:
   friend class ezAbstractObjectGraph;
 
+  void InvalidateContentHash() { m_bContentHashValid = false; }
+
   ezAbstractObjectGraph* m_pOwner;
 
   ezUuid m_Guid;
@@ -66,6 +82,9 @@ private:
   const char* m_szNodeName;
 
   ezHybridArray<Property, 16> m_Properties;
+
+  mutable ezUInt64 m_uiContentHash;
+  mutable bool m_bContentHashValid;
 };
 EZ_DECLARE_REFLECTABLE_TYPE(EZ_FOUNDATION_DLL, ezAbstractObjectNode);
 
@@ -156,6 +175,10 @@ public:
   /// \brief Allows to copy a node from another graph into this graph.
   ezAbstractObjectNode* CopyNodeIntoGraph(const ezAbstractObjectNode* pNode);
 
+  /// \brief Computes the operations that turn the base graph into this graph.
+  ///
+  /// Nodes that exist in both graphs are first compared through their content hashes, which is done in parallel for large graphs.
+  /// Only the properties of nodes whose hashes differ are compared individually, so the cost mostly depends on the amount of change.
   void CreateDiffWithBaseGraph(const ezAbstractObjectGraph& base, ezDeque<ezAbstractGraphDiffOperation>& out_DiffResult) const;
 
   void ApplyDiff(ezDeque<ezAbstractGraphDiffOperation>& Diff);
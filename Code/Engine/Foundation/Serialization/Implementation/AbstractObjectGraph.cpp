@@ -3,6 +3,7 @@
 #include <Foundation/Logging/Log.h>
 #include <Foundation/Serialization/AbstractObjectGraph.h>
 #include <Foundation/Serialization/RttiConverter.h>
+#include <Foundation/Threading/TaskSystem.h>
 
 // clang-format off
 EZ_BEGIN_STATIC_REFLECTED_ENUM(ezObjectChangeType, 1)
@@ -28,6 +29,50 @@ EZ_BEGIN_STATIC_REFLECTED_TYPE(ezDiffOperation, ezNoBase, 1, ezRTTIDefaultAlloca
 EZ_END_STATIC_REFLECTED_TYPE;
 // clang-format on
 
+namespace
+{
+  ezUInt64 HashGraphValue(const ezVariant& value, ezUInt64 uiSeed)
+  {
+    const ezVariantType::Enum type = value.GetType();
+    uiSeed = ezHashingUtils::xxHash64(&type, sizeof(type), uiSeed);
+
+    switch (type)
+    {
+      case ezVariantType::Invalid:
+        return uiSeed;
+
+      case ezVariantType::VariantArray:
+      {
+        for (const ezVariant& element : value.Get<ezVariantArray>())
+        {
+          uiSeed = HashGraphValue(element, uiSeed);
+        }
+        return uiSeed;
+      }
+
+      case ezVariantType::VariantDictionary:
+      {
+        // the iteration order of a dictionary depends on its history, so the hash must not depend on it
+        ezUInt64 uiSum = 0;
+        for (auto it = value.Get<ezVariantDictionary>().GetIterator(); it.IsValid(); ++it)
+        {
+          uiSum += HashGraphValue(it.Value(), ezHashingUtils::xxHash64String(it.Key()));
+        }
+        return ezHashingUtils::xxHash64(&uiSum, sizeof(uiSum), uiSeed);
+      }
+
+      case ezVariantType::TypedPointer:
+      {
+        const ezTypedPointer ptr = value.Get<ezTypedPointer>();
+        return ezHashingUtils::xxHash64(&ptr, sizeof(ptr), uiSeed);
+      }
+
+      default:
+        return value.ComputeHash(uiSeed);
+    }
+  }
+} // namespace
+
 ezAbstractObjectGraph::~ezAbstractObjectGraph()
 {
   Clear();
@@ -126,22 +171,36 @@ void ezAbstractObjectGraph::RemoveNode(const ezUuid& guid)
   }
 }
 
+ezUInt64 ezAbstractObjectNode::Property::ComputeHash() const
+{
+  return HashGraphValue(m_Value, m_uiNameHash);
+}
+
 void ezAbstractObjectNode::AddProperty(const char* szName, const ezVariant& value)
 {
   auto& prop = m_Properties.ExpandAndGetRef();
   prop.m_szPropertyName = m_pOwner->RegisterString(szName);
+  prop.m_uiNameHash = ezHashingUtils::xxHash32String(prop.m_szPropertyName);
   prop.m_Value = value;
+
+  // the content hash is a sum over all properties, so it can be updated without looking at the other properties
+  if (m_bContentHashValid)
+    m_uiContentHash += prop.ComputeHash();
 }
 
 void ezAbstractObjectNode::ChangeProperty(const char* szName, const ezVariant& value)
 {
-  for (ezUInt32 i = 0; i < m_Properties.GetCount(); ++i)
+  if (Property* pProp = const_cast<Property*>(static_cast<const ezAbstractObjectNode*>(this)->FindProperty(szName)))
   {
-    if (ezStringUtils::IsEqual(m_Properties[i].m_szPropertyName, szName))
-    {
-      m_Properties[i].m_Value = value;
-      return;
-    }
+    if (m_bContentHashValid)
+      m_uiContentHash -= pProp->ComputeHash();
+
+    pProp->m_Value = value;
+
+    if (m_bContentHashValid)
+      m_uiContentHash += pProp->ComputeHash();
+
+    return;
   }
 
   EZ_REPORT_FAILURE("Property '{0}' is unknown", szName);
@@ -149,13 +208,16 @@ void ezAbstractObjectNode::ChangeProperty(const char* szName, const ezVariant& v
 
 void ezAbstractObjectNode::RenameProperty(const char* szOldName, const char* szNewName)
 {
-  for (ezUInt32 i = 0; i < m_Properties.GetCount(); ++i)
+  if (Property* pProp = const_cast<Property*>(static_cast<const ezAbstractObjectNode*>(this)->FindProperty(szOldName)))
   {
-    if (ezStringUtils::IsEqual(m_Properties[i].m_szPropertyName, szOldName))
-    {
-      m_Properties[i].m_szPropertyName = m_pOwner->RegisterString(szNewName);
-      return;
-    }
+    if (m_bContentHashValid)
+      m_uiContentHash -= pProp->ComputeHash();
+
+    pProp->m_szPropertyName = m_pOwner->RegisterString(szNewName);
+    pProp->m_uiNameHash = ezHashingUtils::xxHash32String(pProp->m_szPropertyName);
+
+    if (m_bContentHashValid)
+      m_uiContentHash += pProp->ComputeHash();
   }
 }
 
@@ -191,6 +253,7 @@ ezResult ezAbstractObjectNode::InlineProperty(const char* szName)
         return EZ_FAILURE;
 
       prop.m_Value.MoveTypedObject(pObject, ezRTTI::FindTypeByName(pNode->GetType()));
+      InvalidateContentHash();
 
       // Delete old objects.
       for (ezUuid& uuid : context.m_SubTree)
@@ -205,13 +268,12 @@ ezResult ezAbstractObjectNode::InlineProperty(const char* szName)
 
 void ezAbstractObjectNode::RemoveProperty(const char* szName)
 {
-  for (ezUInt32 i = 0; i < m_Properties.GetCount(); ++i)
+  if (const Property* pProp = static_cast<const ezAbstractObjectNode*>(this)->FindProperty(szName))
   {
-    if (ezStringUtils::IsEqual(m_Properties[i].m_szPropertyName, szName))
-    {
-      m_Properties.RemoveAtAndSwap(i);
-      return;
-    }
+    if (m_bContentHashValid)
+      m_uiContentHash -= pProp->ComputeHash();
+
+    m_Properties.RemoveAtAndSwap(static_cast<ezUInt32>(pProp - m_Properties.GetData()));
   }
 }
 
@@ -222,9 +284,11 @@ void ezAbstractObjectNode::SetType(const char* szType)
 
 const ezAbstractObjectNode::Property* ezAbstractObjectNode::FindProperty(const char* szName) const
 {
+  const ezUInt32 uiNameHash = ezHashingUtils::xxHash32String(szName);
+
   for (ezUInt32 i = 0; i < m_Properties.GetCount(); ++i)
   {
-    if (ezStringUtils::IsEqual(m_Properties[i].m_szPropertyName, szName))
+    if (m_Properties[i].m_uiNameHash == uiNameHash && ezStringUtils::IsEqual(m_Properties[i].m_szPropertyName, szName))
     {
       return &m_Properties[i];
     }
@@ -235,15 +299,27 @@ const ezAbstractObjectNode::Property* ezAbstractObjectNode::FindProperty(const c
 
 ezAbstractObjectNode::Property* ezAbstractObjectNode::FindProperty(const char* szName)
 {
-  for (ezUInt32 i = 0; i < m_Properties.GetCount(); ++i)
+  // the caller may modify the value through the returned pointer
+  InvalidateContentHash();
+
+  return const_cast<Property*>(static_cast<const ezAbstractObjectNode*>(this)->FindProperty(szName));
+}
+
+ezUInt64 ezAbstractObjectNode::GetContentHash() const
+{
+  if (!m_bContentHashValid)
   {
-    if (ezStringUtils::IsEqual(m_Properties[i].m_szPropertyName, szName))
+    ezUInt64 uiHash = 0;
+    for (const Property& prop : m_Properties)
     {
-      return &m_Properties[i];
+      uiHash += prop.ComputeHash();
     }
+
+    m_uiContentHash = uiHash;
+    m_bContentHashValid = true;
   }
 
-  return nullptr;
+  return m_uiContentHash;
 }
 
 void ezAbstractObjectGraph::ReMapNodeGuids(const ezUuid& seedGuid, bool bRemapInverse /*= false*/)
@@ -279,6 +355,7 @@ void ezAbstractObjectGraph::ReMapNodeGuids(const ezUuid& seedGuid, bool bRemapIn
     {
       RemapVariant(prop.m_Value, guidMap);
     }
+    pNode->InvalidateContentHash();
     m_Nodes[pNode->m_Guid] = pNode;
   }
 }
@@ -299,6 +376,7 @@ void ezAbstractObjectGraph::ReMapNodeGuidsToMatchGraph(ezAbstractObjectNode* roo
     {
       RemapVariant(prop.m_Value, guidMap);
     }
+    it.Value()->InvalidateContentHash();
     m_Nodes[it.Value()->m_Guid] = it.Value();
   }
 }
@@ -536,6 +614,18 @@ void ezAbstractObjectGraph::CreateDiffWithBaseGraph(const ezAbstractObjectGraph&
 
   // check whether any properties have been modified
   {
+    struct NodePair
+    {
+      EZ_DECLARE_POD_TYPE();
+
+      const ezAbstractObjectNode* m_pNode;
+      const ezAbstractObjectNode* m_pBaseNode;
+      bool m_bChanged;
+    };
+
+    ezDynamicArray<NodePair> nodePairs;
+    nodePairs.Reserve(GetAllNodes().GetCount());
+
     for (auto itNodeThis = GetAllNodes().GetIterator(); itNodeThis.IsValid(); ++itNodeThis)
     {
       const auto pBaseNode = base.GetNode(itNodeThis.Key());
@@ -543,29 +633,31 @@ void ezAbstractObjectGraph::CreateDiffWithBaseGraph(const ezAbstractObjectGraph&
       if (pBaseNode == nullptr)
         continue;
 
-      for (const ezAbstractObjectNode::Property& prop : itNodeThis.Value()->GetProperties())
-      {
-        bool bDifferent = true;
+      nodePairs.PushBack({itNodeThis.Value(), pBaseNode, true});
+    }
 
-        for (const ezAbstractObjectNode::Property& baseProp : pBaseNode->GetProperties())
-        {
-          if (ezStringUtils::IsEqual(baseProp.m_szPropertyName, prop.m_szPropertyName))
-          {
-            if (baseProp.m_Value == prop.m_Value)
-            {
-              bDifferent = false;
-              break;
-            }
+    // Each node appears in at most one pair, so the cached content hashes can be computed in parallel.
+    // Most nodes are usually unchanged and can be skipped entirely afterwards.
+    ezParallelForParams params;
+    params.uiBinSize = 256;
+    ezTaskSystem::ParallelForSingle(
+      nodePairs.GetArrayPtr(),
+      [](NodePair& pair) { pair.m_bChanged = pair.m_pNode->GetContentHash() != pair.m_pBaseNode->GetContentHash(); },
+      "ezAbstractObjectGraph::CreateDiffWithBaseGraph", params);
 
-            bDifferent = true;
-            break;
-          }
-        }
+    for (const NodePair& pair : nodePairs)
+    {
+      if (!pair.m_bChanged)
+        continue;
+
+      for (const ezAbstractObjectNode::Property& prop : pair.m_pNode->GetProperties())
+      {
+        const ezAbstractObjectNode::Property* pBaseProp = pair.m_pBaseNode->FindProperty(prop.m_szPropertyName);
 
-        if (bDifferent)
+        if (pBaseProp == nullptr || pBaseProp->m_Value != prop.m_Value)
         {
           ezAbstractGraphDiffOperation op;
-          op.m_Node = itNodeThis.Key();
+          op.m_Node = pair.m_pNode->GetGuid();
           op.m_Operation = ezAbstractGraphDiffOperation::Op::PropertyChanged;
           op.m_sProperty = prop.m_szPropertyName;
           op.m_Value = prop.m_Value;
@@ -639,7 +731,40 @@ void ezAbstractObjectGraph::MergeDiffs(const ezDeque<ezAbstractGraphDiffOperatio
     bool operator==(const Prop& rhs) const { return m_Node == rhs.m_Node && m_sProperty == rhs.m_sProperty; }
   };
 
-  ezMap<Prop, ezHybridArray<const ezAbstractGraphDiffOperation*, 2>> propChanges;
+  struct PropHashHelper
+  {
+    static ezUInt32 Hash(const Prop& value) { return ezHashingUtils::xxHash32String(value.m_sProperty, ezHashHelper<ezUuid>::Hash(value.m_Node)); }
+    static bool Equal(const Prop& a, const Prop& b) { return a == b; }
+  };
+
+  struct PropChange
+  {
+    Prop m_Key;
+    ezHybridArray<const ezAbstractGraphDiffOperation*, 2> m_Ops;
+
+    bool operator<(const PropChange& rhs) const { return m_Key < rhs.m_Key; }
+  };
+
+  // Changes are looked up through their hash and only sorted once at the end, which keeps the output in the same
+  // (node, property) order as before without doing string comparisons for every inserted operation.
+  ezDynamicArray<PropChange> propChanges;
+  ezHashTable<Prop, ezUInt32, PropHashHelper> propChangeIndex;
+  propChangeIndex.Reserve(lhs.GetCount() + rhs.GetCount());
+
+  auto AddPropChange = [&](const ezAbstractGraphDiffOperation& op) {
+    const Prop key(op.m_Node, op.m_sProperty);
+
+    ezUInt32 uiIndex = 0;
+    if (!propChangeIndex.TryGetValue(key, uiIndex))
+    {
+      uiIndex = propChanges.GetCount();
+      propChangeIndex.Insert(key, uiIndex);
+      propChanges.ExpandAndGetRef().m_Key = key;
+    }
+
+    propChanges[uiIndex].m_Ops.PushBack(&op);
+  };
+
   ezSet<ezUuid> removed;
   ezMap<ezUuid, ezUInt32> added;
   for (const ezAbstractGraphDiffOperation& op : lhs)
@@ -656,8 +781,7 @@ void ezAbstractObjectGraph::MergeDiffs(const ezDeque<ezAbstractGraphDiffOperatio
     }
     else if (op.m_Operation == ezAbstractGraphDiffOperation::Op::PropertyChanged)
     {
-      auto it = propChanges.FindOrAdd(Prop(op.m_Node, op.m_sProperty));
-      it.Value().PushBack(&op);
+      AddPropChange(op);
     }
   }
   for (const ezAbstractGraphDiffOperation& op : rhs)
@@ -681,15 +805,16 @@ void ezAbstractObjectGraph::MergeDiffs(const ezDeque<ezAbstractGraphDiffOperatio
     }
     else if (op.m_Operation == ezAbstractGraphDiffOperation::Op::PropertyChanged)
     {
-      auto it = propChanges.FindOrAdd(Prop(op.m_Node, op.m_sProperty));
-      it.Value().PushBack(&op);
+      AddPropChange(op);
     }
   }
 
-  for (auto it = propChanges.GetIterator(); it.IsValid(); ++it)
+  propChanges.Sort();
+
+  for (const PropChange& change : propChanges)
   {
-    const Prop& key = it.Key();
-    const ezHybridArray<const ezAbstractGraphDiffOperation*, 2>& value = it.Value();
+    const Prop& key = change.m_Key;
+    const ezHybridArray<const ezAbstractGraphDiffOperation*, 2>& value = change.m_Ops;
 
     if (value.GetCount() == 1)
     {
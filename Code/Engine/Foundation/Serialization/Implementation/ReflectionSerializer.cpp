@@ -1,5 +1,7 @@
 #include <FoundationPCH.h>
 
+#include <Foundation/Configuration/Startup.h>
+#include <Foundation/Containers/HashTable.h>
 #include <Foundation/IO/OpenDdlReader.h>
 #include <Foundation/Logging/Log.h>
 #include <Foundation/Reflection/ReflectionUtils.h>
@@ -7,6 +9,7 @@
 #include <Foundation/Serialization/DdlSerializer.h>
 #include <Foundation/Serialization/ReflectionSerializer.h>
 #include <Foundation/Serialization/RttiConverter.h>
+#include <Foundation/Threading/Mutex.h>
 #include <Foundation/Types/ScopeExit.h>
 #include <Foundation/Types/VariantTypeRegistry.h>
 
@@ -375,18 +378,178 @@ namespace
     }
   }
 
+  /// \brief A flattened list of all steps that are necessary to clone an object of a specific type.
+  ///
+  /// Each step either copies a run of plain data members with one memcpy (m_pProperty is nullptr),
+  /// or clones a single property of the (sub-)object at m_uiOffset through CloneProperty().
+  struct ezCloneLayout
+  {
+    struct Step
+    {
+      EZ_DECLARE_POD_TYPE();
+
+      ezUInt32 m_uiOffset;
+      ezUInt32 m_uiSize;
+      ezAbstractProperty* m_pProperty;
+    };
+
+    ezDynamicArray<Step> m_Steps;
+  };
+
+  typedef ezHashTable<const ezRTTI*, ezUniquePtr<ezCloneLayout>, ezHashHelper<const ezRTTI*>, ezStaticAllocatorWrapper> ezCloneLayoutTable;
+
+  static ezMutex s_CloneLayoutMutex;
+  static ezCloneLayoutTable s_CloneLayouts;
+
+  /// \brief Returns true for members that can be copied bitwise, i.e. standard types that don't own any memory.
+  static bool IsPlainDataMember(const ezAbstractProperty* pProp)
+  {
+    if (pProp->GetFlags().IsAnySet(ezPropertyFlags::Pointer) || !pProp->GetFlags().IsSet(ezPropertyFlags::StandardType))
+      return false;
+
+    const ezVariantType::Enum type = pProp->GetSpecificType()->GetVariantType();
+    if (type <= ezVariantType::FirstStandardType || type >= ezVariantType::LastStandardType)
+      return false;
+
+    return type != ezVariantType::String && type != ezVariantType::StringView && type != ezVariantType::DataBuffer;
+  }
+
+  static void AddCloneStep(ezCloneLayout& layout, ezUInt32 uiOffset, ezUInt32 uiSize, ezAbstractProperty* pProp)
+  {
+    // merge runs of plain data that directly follow each other in memory
+    if (pProp == nullptr && !layout.m_Steps.IsEmpty())
+    {
+      ezCloneLayout::Step& last = layout.m_Steps.PeekBack();
+      if (last.m_pProperty == nullptr && last.m_uiOffset + last.m_uiSize == uiOffset)
+      {
+        last.m_uiSize += uiSize;
+        return;
+      }
+    }
+
+    ezCloneLayout::Step& step = layout.m_Steps.ExpandAndGetRef();
+    step.m_uiOffset = uiOffset;
+    step.m_uiSize = uiSize;
+    step.m_pProperty = pProp;
+  }
+
+  /// \brief Appends the steps for all properties of pType to the layout, for an instance of pType located at uiBaseOffset inside the object
+  /// that is cloned.
+  static void BuildCloneLayout(ezCloneLayout& layout, const ezRTTI* pType, ezUInt32 uiBaseOffset)
+  {
+    for (const ezRTTIPropertyTable::Entry& entry : pType->GetPropertyTable().GetEntries())
+    {
+      ezAbstractProperty* pProp = entry.m_pProperty;
+
+      if (pProp->GetFlags().IsSet(ezPropertyFlags::ReadOnly))
+        continue;
+
+      if (entry.HasDirectAccess())
+      {
+        const ezUInt32 uiOffset = uiBaseOffset + entry.m_uiOffset;
+        const ezRTTI* pPropType = pProp->GetSpecificType();
+
+        if (IsPlainDataMember(pProp))
+        {
+          AddCloneStep(layout, uiOffset, pPropType->GetTypeSize(), nullptr);
+          continue;
+        }
+
+        // embedded structs are flattened into the layout of the outer type
+        if (pProp->GetFlags().IsSet(ezPropertyFlags::Class) && !ezReflectionUtils::IsValueType(pProp) &&
+            !pPropType->GetTypeFlags().IsSet(ezTypeFlags::Phantom))
+        {
+          BuildCloneLayout(layout, pPropType, uiOffset);
+          continue;
+        }
+      }
+
+      AddCloneStep(layout, uiBaseOffset, 0, pProp);
+    }
+  }
+
+  static const ezCloneLayout& GetCloneLayout(const ezRTTI* pType)
+  {
+    EZ_LOCK(s_CloneLayoutMutex);
+
+    ezUniquePtr<ezCloneLayout>* pLayout = nullptr;
+    if (s_CloneLayouts.TryGetValue(pType, pLayout))
+      return **pLayout;
+
+    ezUniquePtr<ezCloneLayout> layout = EZ_DEFAULT_NEW(ezCloneLayout);
+    BuildCloneLayout(*layout, pType, 0);
+    layout->m_Steps.Compact();
+
+    const ezCloneLayout& result = *layout;
+    s_CloneLayouts.Insert(pType, std::move(layout));
+    return result;
+  }
+
   static void CloneProperties(const void* pObject, void* pClone, const ezRTTI* pType)
   {
-    if (pType->GetParentType())
-      CloneProperties(pObject, pClone, pType->GetParentType());
+    // phantom types may be replaced at any time, so they are not cached
+    if (pType->GetTypeFlags().IsSet(ezTypeFlags::Phantom))
+    {
+      if (pType->GetParentType())
+        CloneProperties(pObject, pClone, pType->GetParentType());
+
+      for (auto* pProp : pType->GetProperties())
+      {
+        CloneProperty(pObject, pClone, pProp);
+      }
+      return;
+    }
+
+    const ezCloneLayout& layout = GetCloneLayout(pType);
 
-    for (auto* pProp : pType->GetProperties())
+    const ezUInt8* pSource = static_cast<const ezUInt8*>(pObject);
+    ezUInt8* pTarget = static_cast<ezUInt8*>(pClone);
+
+    for (const ezCloneLayout::Step& step : layout.m_Steps)
     {
-      CloneProperty(pObject, pClone, pProp);
+      if (step.m_pProperty == nullptr)
+        ezMemoryUtils::RawByteCopy(pTarget + step.m_uiOffset, pSource + step.m_uiOffset, step.m_uiSize);
+      else
+        CloneProperty(pSource + step.m_uiOffset, pTarget + step.m_uiOffset, step.m_pProperty);
     }
   }
+
+  static void ClearCloneLayouts()
+  {
+    EZ_LOCK(s_CloneLayoutMutex);
+    s_CloneLayouts.Clear();
+    s_CloneLayouts.Compact();
+  }
+
+  static void CloneLayoutPluginEventHandler(const ezPluginEvent& EventData)
+  {
+    // the cached layouts reference the types and properties of unloaded plugins
+    if (EventData.m_EventType == ezPluginEvent::AfterUnloading)
+      ClearCloneLayouts();
+  }
 } // namespace
 
+// clang-format off
+EZ_BEGIN_SUBSYSTEM_DECLARATION(Foundation, ReflectionSerializer)
+
+  BEGIN_SUBSYSTEM_DEPENDENCIES
+    "Reflection"
+  END_SUBSYSTEM_DEPENDENCIES
+
+  ON_CORESYSTEMS_STARTUP
+  {
+    ezPlugin::s_PluginEvents.AddEventHandler(CloneLayoutPluginEventHandler);
+  }
+
+  ON_CORESYSTEMS_SHUTDOWN
+  {
+    ezPlugin::s_PluginEvents.RemoveEventHandler(CloneLayoutPluginEventHandler);
+    ClearCloneLayouts();
+  }
+
+EZ_END_SUBSYSTEM_DECLARATION;
+// clang-format on
+
 void* ezReflectionSerializer::Clone(const void* pObject, const ezRTTI* pType)
 {
   if (!pObject)
@@ -5,6 +5,18 @@
 #include <Foundation/Serialization/RttiConverter.h>
 #include <Foundation/Types/VariantTypeRegistry.h>
 
+namespace
+{
+  struct SetDirectMemberValueFunc
+  {
+    template <typename T>
+    EZ_ALWAYS_INLINE void operator()(void* pMember, const ezVariant& value)
+    {
+      *static_cast<T*>(pMember) = value.Get<T>();
+    }
+  };
+} // namespace
+
 ezRttiConverterReader::ezRttiConverterReader(const ezAbstractObjectGraph* pGraph, ezRttiConverterContext* pContext)
 {
   m_pGraph = pGraph;
@@ -34,16 +46,25 @@ void ezRttiConverterReader::ApplyPropertiesToObject(const ezAbstractObjectNode*
 {
   EZ_ASSERT_DEBUG(pNode != nullptr, "Invalid node");
 
-  if (pRtti->GetParentType() != nullptr)
-    ApplyPropertiesToObject(pNode, pRtti->GetParentType(), pObject);
-
-  for (auto* prop : pRtti->GetProperties())
+  // the property table lists the properties of all base types first, same as walking the type hierarchy
+  for (const ezRTTIPropertyTable::Entry& entry : pRtti->GetPropertyTable().GetEntries())
   {
-    auto* pOtherProp = pNode->FindProperty(prop->GetPropertyName());
+    auto* pOtherProp = pNode->FindProperty(entry.m_pProperty->GetPropertyName());
     if (pOtherProp == nullptr)
       continue;
 
-    ApplyProperty(pObject, prop, pOtherProp);
+    // values that already have the exact type of the member are written directly, everything else may need a conversion
+    if (entry.m_Type != ezVariantType::Invalid && pOtherProp->m_Value.GetType() == entry.m_Type)
+    {
+      if (!entry.m_pProperty->GetFlags().IsSet(ezPropertyFlags::ReadOnly))
+      {
+        SetDirectMemberValueFunc func;
+        ezVariant::DispatchTo(func, entry.m_Type, entry.GetMemberPointer(pObject), pOtherProp->m_Value);
+      }
+      continue;
+    }
+
+    ApplyProperty(pObject, entry.m_pProperty, pOtherProp);
   }
 }
 
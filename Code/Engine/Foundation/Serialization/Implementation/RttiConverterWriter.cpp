@@ -5,6 +5,18 @@
 #include <Foundation/Types/ScopeExit.h>
 #include <Foundation/Types/VariantTypeRegistry.h>
 
+namespace
+{
+  struct GetDirectMemberValueFunc
+  {
+    template <typename T>
+    EZ_ALWAYS_INLINE void operator()(const void* pMember, ezVariant& value)
+    {
+      value = *static_cast<const T*>(pMember);
+    }
+  };
+} // namespace
+
 void ezRttiConverterContext::Clear()
 {
   m_GuidToObject.Clear();
@@ -410,12 +422,22 @@ void ezRttiConverterWriter::AddProperty(ezAbstractObjectNode* pNode, const ezAbs
 
 void ezRttiConverterWriter::AddProperties(ezAbstractObjectNode* pNode, const ezRTTI* pRtti, const void* pObject)
 {
-  if (pRtti->GetParentType())
-    AddProperties(pNode, pRtti->GetParentType(), pObject);
-
-  for (const auto* pProp : pRtti->GetProperties())
+  // the property table lists the properties of all base types first, so the order of the properties in the node is the same as when
+  // walking the type hierarchy
+  for (const ezRTTIPropertyTable::Entry& entry : pRtti->GetPropertyTable().GetEntries())
   {
-    AddProperty(pNode, pProp, pObject);
+    // members that store exactly the type that ezVariant stores are read directly, instead of through the property
+    if (entry.m_Type != ezVariantType::Invalid && (m_bSerializeReadOnly || !entry.m_pProperty->GetFlags().IsSet(ezPropertyFlags::ReadOnly)))
+    {
+      ezVariant value;
+      GetDirectMemberValueFunc func;
+      ezVariant::DispatchTo(func, entry.m_Type, entry.GetMemberPointer(pObject), value);
+
+      pNode->AddProperty(entry.m_pProperty->GetPropertyName(), value);
+      continue;
+    }
+
+    AddProperty(pNode, entry.m_pProperty, pObject);
   }
 }
 
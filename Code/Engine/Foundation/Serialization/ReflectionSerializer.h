@@ -58,6 +58,10 @@ public:
   /// In case a class derived from ezReflectedClass is passed in the correct derived type
   /// will automatically be determined so it is not necessary to put the exact type into pType,
   /// any derived class type will do.
+  ///
+  /// The first time a type is cloned, a flattened layout of all its properties (including those of base classes and embedded structs)
+  /// is built and cached. Member properties of plain data types (numbers, vectors, colors, etc.) that are stored directly in the object
+  /// are merged into runs of bytes that are copied with a single memcpy, all other properties are cloned through the reflection system.
   static void* Clone(const void* pObject, const ezRTTI* pType); // [tested]
 
   /// \brief Clones pObject of type pType into the already existing pClone.
@@ -26,6 +26,9 @@ public:
   ///
   /// Requires an ezStringBuilder as storage, ie. writes the formatted text into it. Additionally it returns a const char* to that
   /// string builder data for convenience.
+  ///
+  /// Text between placeholders is appended in whole runs, and each argument is only converted to a string the first time a
+  /// placeholder references it. Arguments that are never referenced are never converted.
   virtual const char* GetText(ezStringBuilder& sb) const override
   {
     if (ezStringUtils::IsNullOrEmpty(m_szString))
@@ -34,22 +37,34 @@ public:
     }
 
     ezStringView param[10];
+    ezUInt32 uiBuiltParams = 0;
 
     char tmp[10][TempStringLength];
-    ReplaceString<0>(tmp, param);
 
     const char* szString = m_szString;
+    const char* szRunStart = szString;
 
     int iLastParam = -1;
 
     SBClear(sb);
     while (*szString != '\0')
     {
+      // '%' and '{' are ASCII and can never be part of a multi-byte UTF-8 sequence, so the text can be scanned byte by byte
+      if (*szString != '%' && *szString != '{')
+      {
+        ++szString;
+        continue;
+      }
+
+      int iParam = -1;
+      const char* szRunEnd = szString;
+
       if (*szString == '%')
       {
         if (*(szString + 1) == '%')
         {
-          SBAppendView(sb, "%");
+          // append the first '%' as part of the current run and skip the second one
+          ++szRunEnd;
         }
         else
         {
@@ -57,54 +72,70 @@ public:
                                  "string? Use double percentage signs for the actual character.");
         }
 
-        szString += 2;
+        szString += (*(szString + 1) != '\0') ? 2 : 1;
       }
-      else if (*szString == '{' && *(szString + 1) >= '0' && *(szString + 1) <= '9' && *(szString + 2) == '}')
+      else if (*(szString + 1) >= '0' && *(szString + 1) <= '9' && *(szString + 2) == '}')
       {
-        iLastParam = *(szString + 1) - '0';
-        SBAppendView(sb, param[iLastParam]);
-
+        iParam = *(szString + 1) - '0';
+        iLastParam = iParam;
         szString += 3;
       }
-      else if (*szString == '{' && *(szString + 1) == '}')
+      else if (*(szString + 1) == '}')
       {
         ++iLastParam;
         EZ_ASSERT_DEV(iLastParam < 10, "Too many placeholders in format string");
 
-        if (iLastParam < 10)
-        {
-          SBAppendView(sb, param[iLastParam]);
-        }
-
+        iParam = iLastParam < 10 ? iLastParam : -1;
         szString += 2;
       }
       else
       {
-        const ezUInt32 character = ezUnicodeUtils::DecodeUtf8ToUtf32(szString);
-        SBAppendChar(sb, character);
+        // a '{' that is not a placeholder is regular text
+        ++szString;
+        continue;
+      }
+
+      SBAppendView(sb, ezStringView(szRunStart, szRunEnd));
+      szRunStart = szString;
+
+      if (iParam >= 0)
+      {
+        if ((uiBuiltParams & EZ_BIT(iParam)) == 0)
+        {
+          uiBuiltParams |= EZ_BIT(iParam);
+          param[iParam] = BuildParam<0>(static_cast<ezUInt32>(iParam), tmp[iParam]);
+        }
+
+        SBAppendView(sb, param[iParam]);
       }
     }
 
+    SBAppendView(sb, ezStringView(szRunStart, szString));
+
     return SBReturn(sb);
   }
 
 private:
   template <ezInt32 N>
-  typename std::enable_if<sizeof...(ARGS) != N>::type ReplaceString(char tmp[10][TempStringLength], ezStringView* pViews) const
+  typename std::enable_if<sizeof...(ARGS) != N, ezStringView>::type BuildParam(ezUInt32 uiIndex, char* tmp) const
   {
     EZ_CHECK_AT_COMPILETIME_MSG(N < 10, "Maximum number of format arguments reached");
 
-    // using a free function allows to overload with various different argument types
-    pViews[N] = BuildString(tmp[N], TempStringLength - 1, std::get<N>(m_Arguments));
+    if (uiIndex == N)
+    {
+      // using a free function allows to overload with various different argument types
+      return BuildString(tmp, TempStringLength - 1, std::get<N>(m_Arguments));
+    }
 
     // Recurse, chip off one argument
-    ReplaceString<N + 1>(tmp, pViews);
+    return BuildParam<N + 1>(uiIndex, tmp);
   }
 
-  // Recursion end if we reached the number of arguments.
+  // Recursion end if we reached the number of arguments, placeholders without an argument stay empty.
   template <ezInt32 N>
-  typename std::enable_if<sizeof...(ARGS) == N>::type ReplaceString(char tmp[10][TempStringLength], ezStringView* pViews) const
+  typename std::enable_if<sizeof...(ARGS) == N, ezStringView>::type BuildParam(ezUInt32 uiIndex, char* tmp) const
   {
+    return ezStringView();
   }
 
 
@@ -397,6 +397,44 @@ static void FormatUInt(char* szOutputBuffer, int& iNumDigits, unsigned long long
   if (iPrecision > 64)
     iPrecision = 64;
 
+  if (uiBase == 10)
+  {
+    // decimal numbers are by far the most common case, write them two digits at a time to halve the number of divisions
+    static const char s_szDigitPairs[] = "00010203040506070809"
+                                         "10111213141516171819"
+                                         "20212223242526272829"
+                                         "30313233343536373839"
+                                         "40414243444546474849"
+                                         "50515253545556575859"
+                                         "60616263646566676869"
+                                         "70717273747576777879"
+                                         "80818283848586878889"
+                                         "90919293949596979899";
+
+    while (uiValue >= 100)
+    {
+      const unsigned int uiPair = static_cast<unsigned int>(uiValue % 100) * 2;
+      uiValue /= 100;
+
+      // the digits are written in reverse order
+      szOutputBuffer[iNumDigits++] = s_szDigitPairs[uiPair + 1];
+      szOutputBuffer[iNumDigits++] = s_szDigitPairs[uiPair];
+    }
+
+    if (uiValue >= 10)
+    {
+      const unsigned int uiPair = static_cast<unsigned int>(uiValue) * 2;
+      szOutputBuffer[iNumDigits++] = s_szDigitPairs[uiPair + 1];
+      szOutputBuffer[iNumDigits++] = s_szDigitPairs[uiPair];
+    }
+    else if (uiValue > 0)
+    {
+      szOutputBuffer[iNumDigits++] = static_cast<char>('0' + uiValue);
+    }
+
+    uiValue = 0;
+  }
+
   while (uiValue > 0)
   {
     const unsigned int digit = uiValue % uiBase;
@@ -1080,6 +1118,18 @@ void ezStringUtils::OutputFormattedUInt(
 void ezStringUtils::OutputFormattedFloat(char* szOutputBuffer, ezUInt32 uiBufferSize, ezUInt32& uiWritePos, double value, ezUInt8 uiWidth,
   bool bPadZeros, ezInt8 iPrecision, bool bScientific, bool bRemoveTrailingZeroes)
 {
+  // Without a fixed precision all trailing zeros are removed, so whole numbers are printed exactly like integers.
+  // Below 2^53 every whole number is exactly representable, which allows to take the much cheaper integer path.
+  if (iPrecision < 0 && !bScientific && value > -9007199254740992.0 && value < 9007199254740992.0)
+  {
+    const ezInt64 iWholeValue = static_cast<ezInt64>(value);
+    if (static_cast<double>(iWholeValue) == value)
+    {
+      OutputInt(szOutputBuffer, uiBufferSize, uiWritePos, iWholeValue, uiWidth, -1, bPadZeros ? sprintfFlags::PadZeros : 0, 10);
+      return;
+    }
+  }
+
   OutputFloat(szOutputBuffer, uiBufferSize, uiWritePos, value, uiWidth, ezMath::Max<int>(-1, iPrecision), bPadZeros ? sprintfFlags::PadZeros : 0,
     false, bScientific, bRemoveTrailingZeroes);
 }
@@ -79,6 +79,9 @@ void ezCrashHandler_WriteMiniDump::SetDumpFilePath(const char* szAppName, ezBitf
 
 void ezCrashHandler_WriteMiniDump::HandleCrash(void* pOsSpecificData)
 {
+  // make sure everything that was logged before the crash reaches the log writers, in case writing the dump fails as well
+  ezGlobalLog::FlushAsyncQueue(ezTime::Seconds(2));
+
   bool crashDumpWritten = false;
   if (!m_sDumpFilePath.IsEmpty())
   {
@@ -108,6 +111,8 @@ void ezCrashHandler_WriteMiniDump::HandleCrash(void* pOsSpecificData)
   {
     ezLog::Error("Application crashed. Crash-dump written to '{}'.", m_sDumpFilePath);
   }
+
+  ezGlobalLog::FlushAsyncQueue(ezTime::Seconds(2));
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -9,7 +9,8 @@
 
 EZ_ALWAYS_INLINE ezInt32 ezAtomicUtils::Read(volatile const ezInt32& src)
 {
-  return __sync_fetch_and_or(const_cast<volatile ezInt32*>(&src), 0);
+  // a plain atomic load, unlike a read-modify-write it does not take exclusive ownership of the cache line
+  return __atomic_load_n(&src, __ATOMIC_SEQ_CST);
 }
 
 EZ_ALWAYS_INLINE ezInt64 ezAtomicUtils::Read(volatile const ezInt64& src)
@@ -17,6 +18,11 @@ EZ_ALWAYS_INLINE ezInt64 ezAtomicUtils::Read(volatile const ezInt64& src)
   return __sync_fetch_and_or_8(const_cast<volatile ezInt64*>(&src), 0);
 }
 
+EZ_ALWAYS_INLINE void* ezAtomicUtils::Read(void** volatile src)
+{
+  return __atomic_load_n(src, __ATOMIC_SEQ_CST);
+}
+
 EZ_ALWAYS_INLINE ezInt32 ezAtomicUtils::Increment(volatile ezInt32& dest)
 {
   return __sync_add_and_fetch(&dest, 1);
@@ -376,6 +376,16 @@ void ezTaskSystem::FinishFrameTasks()
     EZ_LOCK(s_TaskSystemMutex);
 
     ReprioritizeFrameTasks();
+
+#if EZ_ENABLED(EZ_USE_PROFILING)
+    ezUInt32 uiQueuedTasks = 0;
+    for (ezUInt32 i = 0; i < ezTaskPriority::ENUM_COUNT; ++i)
+    {
+      uiQueuedTasks += s_State->m_Tasks[i].GetCount();
+    }
+
+    EZ_PROFILE_COUNTER("TaskQueueDepth", uiQueuedTasks);
+#endif
   }
 
   ExecuteSomeFrameTasks(s_State->m_TargetFrameTime);
@@ -25,6 +25,11 @@ EZ_ALWAYS_INLINE ezInt64 ezAtomicUtils::Read(volatile const ezInt64& src)
 #endif
 }
 
+EZ_ALWAYS_INLINE void* ezAtomicUtils::Read(void** volatile src)
+{
+  return _InterlockedCompareExchangePointer(src, nullptr, nullptr);
+}
+
 EZ_ALWAYS_INLINE ezInt32 ezAtomicUtils::Increment(volatile ezInt32& dest)
 {
   return _InterlockedIncrement(reinterpret_cast<volatile long*>(&dest));
@@ -8,6 +8,7 @@
 #include <Foundation/Math/Transform.h>
 #include <Foundation/Strings/String.h>
 #include <Foundation/Time/Time.h>
+#include <Foundation/Types/ArrayPtr.h>
 #include <Foundation/Types/Uuid.h>
 
 // Needed to prevent circular includes
@@ -130,6 +131,34 @@ namespace ezConversionUtils
   EZ_FOUNDATION_DLL ezUInt32 ExtractFloatsFromString(const char* szText, ezUInt32 uiNumFloats, float* out_pFloats,
     const char** out_LastParsePosition = nullptr); // [tested]
 
+  /// \brief Parses a list of floating point values from \a szText and writes them to \a out_Values.
+  ///
+  /// The values may be separated by any number of whitespace characters and commas. Each value is parsed exactly like StringToFloat()
+  /// does it, so the results are identical to calling StringToFloat() for every value. Parsing stops when \a out_Values is full, the end of
+  /// the string is reached or when something is encountered that cannot be parsed as a value.
+  ///
+  /// \param out_LastParsePosition
+  ///   Receives the position directly after the last value that was parsed (or \a szText if no value was parsed).
+  /// \return
+  ///   The number of values that were written to \a out_Values.
+  EZ_FOUNDATION_DLL ezUInt32 StringToFloatArray(const char* szText, ezArrayPtr<double> out_Values,
+    const char** out_LastParsePosition = nullptr); // [tested]
+
+  /// \brief Same as StringToFloatArray() for doubles, but converts all values to float.
+  EZ_FOUNDATION_DLL ezUInt32 StringToFloatArray(const char* szText, ezArrayPtr<float> out_Values,
+    const char** out_LastParsePosition = nullptr); // [tested]
+
+  /// \brief Parses a list of integer values from \a szText and writes them to \a out_Values.
+  ///
+  /// Works like StringToFloatArray(), but each value is parsed like StringToInt() does it. A value that does not fit into the
+  /// 32 bit integer range stops the parsing.
+  EZ_FOUNDATION_DLL ezUInt32 StringToIntArray(const char* szText, ezArrayPtr<ezInt32> out_Values,
+    const char** out_LastParsePosition = nullptr); // [tested]
+
+  /// \brief Same as StringToIntArray() for 32 bit values, but parses each value like StringToInt64() does it.
+  EZ_FOUNDATION_DLL ezUInt32 StringToIntArray(const char* szText, ezArrayPtr<ezInt64> out_Values,
+    const char** out_LastParsePosition = nullptr); // [tested]
+
   /// \brief Converts a hex character ('0', '1', ... '9', 'A'/'a', ... 'F'/'f') to the corresponding int value 0 - 15.
   ///
   /// \note Returns -1 for invalid HEX characters.
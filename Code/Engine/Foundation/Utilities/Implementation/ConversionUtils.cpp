@@ -98,6 +98,69 @@ namespace ezConversionUtils
     return EZ_FAILURE;
   }
 
+  // powers of ten that a double represents exactly, ezMath::Pow() returns the very same values for these
+  static constexpr double s_fPowersOfTen[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+    1e18, 1e19, 1e20, 1e21, 1e22};
+
+  static EZ_ALWAYS_INLINE bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+
+  /// \brief Converts 8 consecutive digit characters to their value with a few 64 bit operations, instead of one multiplication per digit.
+  static EZ_ALWAYS_INLINE ezUInt32 ParseEightDigits(const char* szDigits)
+  {
+#if EZ_ENABLED(EZ_PLATFORM_LITTLE_ENDIAN)
+    ezUInt64 uiChunk;
+    ezMemoryUtils::RawByteCopy(&uiChunk, szDigits, 8);
+
+    uiChunk -= 0x3030303030303030ull;                            // '0' -> 0 in every byte
+    uiChunk = (uiChunk * 10) + (uiChunk >> 8);                   // combine pairs of digits, every second byte holds a value 0 - 99
+    uiChunk = (((uiChunk & 0x000000FF000000FFull) * 0x000F424000000064ull) +        // * 100 and * 1000000
+                (((uiChunk >> 16) & 0x000000FF000000FFull) * 0x0000271000000001ull)) // * 1 and * 10000
+              >> 32;
+
+    return static_cast<ezUInt32>(uiChunk);
+#else
+    ezUInt32 uiValue = 0;
+    for (ezUInt32 i = 0; i < 8; ++i)
+      uiValue = uiValue * 10 + (szDigits[i] - '0');
+    return uiValue;
+#endif
+  }
+
+  /// \brief Appends the run of digits at inout_szString to inout_uiValue (and multiplies inout_uiDivisor by 10 for each digit).
+  ///
+  /// The result is exactly the same as computing 'value = value * 10 + digit' for every single digit, including the wrap-around
+  /// once the value does not fit into 64 bits anymore, but 8 digits are processed at a time.
+  static void AccumulateDigits(const char*& inout_szString, ezUInt64& inout_uiValue, ezUInt64* inout_pDivisor)
+  {
+    const char* szDigits = inout_szString;
+
+    // the string is zero terminated, so we can only look at the next character once we know that the previous one was a digit
+    while (IsDigit(*inout_szString))
+      ++inout_szString;
+
+    ezUInt32 uiNumDigits = static_cast<ezUInt32>(inout_szString - szDigits);
+
+    ezUInt64 uiValue = inout_uiValue;
+    ezUInt64 uiDivisor = inout_pDivisor != nullptr ? *inout_pDivisor : 1;
+
+    for (; uiNumDigits >= 8; uiNumDigits -= 8, szDigits += 8)
+    {
+      uiValue = uiValue * 100000000ull + ParseEightDigits(szDigits);
+      uiDivisor *= 100000000ull;
+    }
+
+    for (; uiNumDigits > 0; --uiNumDigits, ++szDigits)
+    {
+      uiValue = uiValue * 10 + (*szDigits - '0');
+      uiDivisor *= 10;
+    }
+
+    inout_uiValue = uiValue;
+
+    if (inout_pDivisor != nullptr)
+      *inout_pDivisor = uiDivisor;
+  }
+
   ezResult StringToInt64(const char* szString, ezInt64& out_Res, const char** out_LastParsePosition)
   {
     if (ezStringUtils::IsNullOrEmpty(szString))
@@ -108,6 +171,23 @@ namespace ezConversionUtils
     if (FindFirstDigit(szString, bSignIsPos) == EZ_FAILURE)
       return EZ_FAILURE;
 
+    // up to 18 digits always fit into the value range, so there is no need to check every digit for an overflow
+    {
+      const char* szEnd = szString;
+      ezUInt64 uiValue = 0;
+      AccumulateDigits(szEnd, uiValue, nullptr);
+
+      if (szEnd - szString <= 18)
+      {
+        out_Res = bSignIsPos ? static_cast<ezInt64>(uiValue) : -static_cast<ezInt64>(uiValue);
+
+        if (out_LastParsePosition != nullptr)
+          *out_LastParsePosition = szEnd;
+
+        return EZ_SUCCESS;
+      }
+    }
+
     ezInt64 iCurRes = 0;
     ezInt64 iSign = bSignIsPos ? 1 : -1;
     const ezInt64 iMax = 0x7FFFFFFFFFFFFFFF;
@@ -193,9 +273,7 @@ namespace ezConversionUtils
 
         if (c >= '0' && c <= '9')
         {
-          uiIntegerPart *= 10;
-          uiIntegerPart += c - '0';
-          ++szString;
+          AccumulateDigits(szString, uiIntegerPart, nullptr);
           continue;
         }
 
@@ -222,10 +300,7 @@ namespace ezConversionUtils
       {
         if (c >= '0' && c <= '9')
         {
-          uiFractionalPart *= 10;
-          uiFractionalPart += c - '0';
-          uiFractionDivisor *= 10;
-          ++szString;
+          AccumulateDigits(szString, uiFractionalPart, &uiFractionDivisor);
           continue;
         }
 
@@ -252,9 +327,7 @@ namespace ezConversionUtils
       {
         if (c >= '0' && c <= '9')
         {
-          uiExponentPart *= 10;
-          uiExponentPart += c - '0';
-          ++szString;
+          AccumulateDigits(szString, uiExponentPart, nullptr);
           continue;
         }
       }
@@ -274,10 +347,12 @@ namespace ezConversionUtils
 
     if (Part == Exponent)
     {
+      const double fPower = uiExponentPart < EZ_ARRAY_SIZE(s_fPowersOfTen) ? s_fPowersOfTen[uiExponentPart] : ezMath::Pow(10.0, (double)uiExponentPart);
+
       if (bExponentIsPositive)
-        out_Res *= ezMath::Pow(10.0, (double)uiExponentPart);
+        out_Res *= fPower;
       else
-        out_Res /= ezMath::Pow(10.0, (double)uiExponentPart);
+        out_Res /= fPower;
     }
 
     return EZ_SUCCESS;
@@ -425,6 +500,56 @@ namespace ezConversionUtils
     return uiFloatsFound;
   }
 
+  template <typename ParsedType, typename Type, typename ParseFunc>
+  static ezUInt32 ParseValueList(const char* szText, ezArrayPtr<Type> out_Values, const char** out_LastParsePosition, ParseFunc parseFunc)
+  {
+    ezUInt32 uiNumValues = 0;
+    const char* szValueEnd = szText;
+
+    if (szText != nullptr)
+    {
+      while (uiNumValues < out_Values.GetCount())
+      {
+        while (IsWhitespace(*szText) || *szText == ',')
+          ++szText;
+
+        ParsedType value;
+        if (parseFunc(szText, value, &szText).Failed())
+          break;
+
+        out_Values[uiNumValues] = static_cast<Type>(value);
+        ++uiNumValues;
+
+        szValueEnd = szText;
+      }
+    }
+
+    if (out_LastParsePosition != nullptr)
+      *out_LastParsePosition = szValueEnd;
+
+    return uiNumValues;
+  }
+
+  ezUInt32 StringToFloatArray(const char* szText, ezArrayPtr<double> out_Values, const char** out_LastParsePosition)
+  {
+    return ParseValueList<double>(szText, out_Values, out_LastParsePosition, &StringToFloat);
+  }
+
+  ezUInt32 StringToFloatArray(const char* szText, ezArrayPtr<float> out_Values, const char** out_LastParsePosition)
+  {
+    return ParseValueList<double>(szText, out_Values, out_LastParsePosition, &StringToFloat);
+  }
+
+  ezUInt32 StringToIntArray(const char* szText, ezArrayPtr<ezInt32> out_Values, const char** out_LastParsePosition)
+  {
+    return ParseValueList<ezInt32>(szText, out_Values, out_LastParsePosition, &StringToInt);
+  }
+
+  ezUInt32 StringToIntArray(const char* szText, ezArrayPtr<ezInt64> out_Values, const char** out_LastParsePosition)
+  {
+    return ParseValueList<ezInt64>(szText, out_Values, out_LastParsePosition, &StringToInt64);
+  }
+
   ezInt8 HexCharacterToIntValue(ezUInt32 Character)
   {
     if (Character >= '0' && Character <= '9')
@@ -526,63 +651,72 @@ namespace ezConversionUtils
     }
   }
 
+  // The number conversions write directly into a stack buffer, which produces the same text as formatting them with "{0}",
+  // but skips parsing a format string.
+
   const ezStringBuilder& ToString(ezInt8 value, ezStringBuilder& out_Result)
   {
-    out_Result.Format("{0}", (ezInt32)value);
-    return out_Result;
+    return ToString(static_cast<ezInt64>(value), out_Result);
   }
 
   const ezStringBuilder& ToString(ezUInt8 value, ezStringBuilder& out_Result)
   {
-    out_Result.Format("{0}", (ezUInt32)value);
-    return out_Result;
+    return ToString(static_cast<ezUInt64>(value), out_Result);
   }
 
   const ezStringBuilder& ToString(ezInt16 value, ezStringBuilder& out_Result)
   {
-    out_Result.Format("{0}", (ezInt32)value);
-    return out_Result;
+    return ToString(static_cast<ezInt64>(value), out_Result);
   }
 
   const ezStringBuilder& ToString(ezUInt16 value, ezStringBuilder& out_Result)
   {
-    out_Result.Format("{0}", (ezUInt32)value);
-    return out_Result;
+    return ToString(static_cast<ezUInt64>(value), out_Result);
   }
 
   const ezStringBuilder& ToString(ezInt32 value, ezStringBuilder& out_Result)
   {
-    out_Result.Format("{0}", value);
-    return out_Result;
+    return ToString(static_cast<ezInt64>(value), out_Result);
   }
 
   const ezStringBuilder& ToString(ezUInt32 value, ezStringBuilder& out_Result)
   {
-    out_Result.Format("{0}", value);
-    return out_Result;
+    return ToString(static_cast<ezUInt64>(value), out_Result);
   }
 
   const ezStringBuilder& ToString(ezInt64 value, ezStringBuilder& out_Result)
   {
-    out_Result.Format("{0}", value);
+    char szBuffer[32];
+    ezUInt32 uiWritePos = 0;
+    ezStringUtils::OutputFormattedInt(szBuffer, EZ_ARRAY_SIZE(szBuffer), uiWritePos, value, 1, false, 10);
+
+    out_Result = ezStringView(szBuffer, szBuffer + uiWritePos);
     return out_Result;
   }
 
   const ezStringBuilder& ToString(ezUInt64 value, ezStringBuilder& out_Result)
   {
-    out_Result.Format("{0}", value);
+    char szBuffer[32];
+    ezUInt32 uiWritePos = 0;
+    ezStringUtils::OutputFormattedUInt(szBuffer, EZ_ARRAY_SIZE(szBuffer), uiWritePos, value, 1, false, 10, false);
+
+    out_Result = ezStringView(szBuffer, szBuffer + uiWritePos);
     return out_Result;
   }
 
   const ezStringBuilder& ToString(float value, ezStringBuilder& out_Result)
   {
-    out_Result.Format("{0}", value);
-    return out_Result;
+    return ToString(static_cast<double>(value), out_Result);
   }
 
   const ezStringBuilder& ToString(double value, ezStringBuilder& out_Result)
   {
-    out_Result.Format("{0}", value);
+    // same buffer size as ezFormatString uses for its arguments
+    char szBuffer[64];
+    ezUInt32 uiWritePos = 0;
+    ezStringUtils::OutputFormattedFloat(szBuffer, EZ_ARRAY_SIZE(szBuffer) - 1, uiWritePos, value, 1, false, -1, false);
+
+    out_Result = ezStringView(szBuffer, szBuffer + uiWritePos);
     return out_Result;
   }
 
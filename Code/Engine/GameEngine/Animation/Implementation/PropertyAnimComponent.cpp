@@ -196,7 +196,7 @@ void ezPropertyAnimComponent::CreateGameObjectBinding(const ezFloatPropertyAnimE
   if (pAnim->m_Target < ezPropertyAnimTarget::Number || pAnim->m_Target > ezPropertyAnimTarget::RotationZ)
     return;
 
-  ezAbstractProperty* pAbstract = pOwnerRtti->FindPropertyByName(pAnim->m_sPropertyPath);
+  ezAbstractProperty* pAbstract = pOwnerRtti->GetPropertyTable().FindProperty(pAnim->m_sPropertyPath);
 
   // we only support direct member properties at this time, so no arrays or other complex structures
   if (pAbstract == nullptr || pAbstract->GetCategory() != ezPropertyCategory::Member)
@@ -270,7 +270,7 @@ void ezPropertyAnimComponent::CreateFloatPropertyBinding(const ezFloatPropertyAn
   if (pAnim->m_Target < ezPropertyAnimTarget::Number || pAnim->m_Target > ezPropertyAnimTarget::VectorW)
     return;
 
-  ezAbstractProperty* pAbstract = pOwnerRtti->FindPropertyByName(pAnim->m_sPropertyPath);
+  ezAbstractProperty* pAbstract = pOwnerRtti->GetPropertyTable().FindProperty(pAnim->m_sPropertyPath);
 
   // we only support direct member properties at this time, so no arrays or other complex structures
   if (pAbstract == nullptr || pAbstract->GetCategory() != ezPropertyCategory::Member)
@@ -343,7 +343,7 @@ void ezPropertyAnimComponent::CreateColorPropertyBinding(const ezColorPropertyAn
   if (pAnim->m_Target != ezPropertyAnimTarget::Color)
     return;
 
-  ezAbstractProperty* pAbstract = pOwnerRtti->FindPropertyByName(pAnim->m_sPropertyPath);
+  ezAbstractProperty* pAbstract = pOwnerRtti->GetPropertyTable().FindProperty(pAnim->m_sPropertyPath);
 
   // we only support direct member properties at this time, so no arrays or other complex structures
   if (pAbstract == nullptr || pAbstract->GetCategory() != ezPropertyCategory::Member)
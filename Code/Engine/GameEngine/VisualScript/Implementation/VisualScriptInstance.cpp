@@ -242,7 +242,7 @@ void ezVisualScriptInstance::CreateVisualScriptNode(ezUInt32 uiNodeIdx, const ez
     const ezUInt32 uiProp = node.m_uiFirstProperty + i;
     const auto& prop = resource.m_Properties[uiProp];
 
-    ezAbstractProperty* pAbstract = pNode->GetDynamicRTTI()->FindPropertyByName(prop.m_sName);
+    ezAbstractProperty* pAbstract = pNode->GetDynamicRTTI()->GetPropertyTable().FindProperty(prop.m_sName);
     if (pAbstract->GetCategory() != ezPropertyCategory::Member)
       continue;
 
@@ -272,7 +272,7 @@ void ezVisualScriptInstance::CreateFunctionMessageNode(ezUInt32 uiNodeIdx, const
       const ezUInt32 uiProp = node.m_uiFirstProperty + i;
       const auto& prop = resource.m_Properties[uiProp];
 
-      ezAbstractProperty* pAbstract = pNode->m_pMessageToSend->GetDynamicRTTI()->FindPropertyByName(prop.m_sName);
+      ezAbstractProperty* pAbstract = pNode->m_pMessageToSend->GetDynamicRTTI()->GetPropertyTable().FindProperty(prop.m_sName);
       if (pAbstract == nullptr)
       {
         if (prop.m_sName == "Delay" && prop.m_Value.CanConvertTo<ezTime>())
@@ -37,7 +37,7 @@ void ezVisualScriptNode_GetNumberProperty::Execute(ezVisualScriptInstance* pInst
   ezComponent* pComponent = nullptr;
   if (pInstance->GetWorld()->TryGetComponent(m_hComponent, pComponent))
   {
-    ezAbstractProperty* pAbsProp = pComponent->GetDynamicRTTI()->FindPropertyByName(m_sVariable);
+    ezAbstractProperty* pAbsProp = pComponent->GetDynamicRTTI()->GetPropertyTable().FindProperty(m_sVariable);
 
     if (pAbsProp && pAbsProp->GetCategory() == ezPropertyCategory::Member)
     {
@@ -96,7 +96,7 @@ void ezVisualScriptNode_SetNumberProperty::Execute(ezVisualScriptInstance* pInst
   ezComponent* pComponent = nullptr;
   if (pInstance->GetWorld()->TryGetComponent(m_hComponent, pComponent))
   {
-    ezAbstractProperty* pAbsProp = pComponent->GetDynamicRTTI()->FindPropertyByName(m_sVariable);
+    ezAbstractProperty* pAbsProp = pComponent->GetDynamicRTTI()->GetPropertyTable().FindProperty(m_sVariable);
 
     if (pAbsProp && pAbsProp->GetCategory() == ezPropertyCategory::Member)
     {
@@ -154,7 +154,7 @@ void ezVisualScriptNode_GetBoolProperty::Execute(ezVisualScriptInstance* pInstan
   ezComponent* pComponent = nullptr;
   if (pInstance->GetWorld()->TryGetComponent(m_hComponent, pComponent))
   {
-    ezAbstractProperty* pAbsProp = pComponent->GetDynamicRTTI()->FindPropertyByName(m_sVariable);
+    ezAbstractProperty* pAbsProp = pComponent->GetDynamicRTTI()->GetPropertyTable().FindProperty(m_sVariable);
 
     if (pAbsProp && pAbsProp->GetCategory() == ezPropertyCategory::Member)
     {
@@ -212,7 +212,7 @@ void ezVisualScriptNode_SetBoolProperty::Execute(ezVisualScriptInstance* pInstan
   ezComponent* pComponent = nullptr;
   if (pInstance->GetWorld()->TryGetComponent(m_hComponent, pComponent))
   {
-    ezAbstractProperty* pAbsProp = pComponent->GetDynamicRTTI()->FindPropertyByName(m_sVariable);
+    ezAbstractProperty* pAbsProp = pComponent->GetDynamicRTTI()->GetPropertyTable().FindProperty(m_sVariable);
 
     if (pAbsProp && pAbsProp->GetCategory() == ezPropertyCategory::Member)
     {
@@ -4,8 +4,10 @@
 #include <FileservePlugin/Fileserver/ClientContext.h>
 #include <Foundation/Communication/GlobalEvent.h>
 #include <Foundation/Communication/RemoteInterfaceEnet.h>
+#include <Foundation/Containers/HashSet.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
 #include <Foundation/IO/FileSystem/Implementation/DataDirType.h>
+#include <Foundation/IO/OSFile.h>
 #include <Foundation/Logging/Log.h>
 #include <Foundation/Types/ScopeExit.h>
 #include <Foundation/Utilities/CommandLineUtils.h>
@@ -53,6 +55,12 @@ ezFileserveClient::ezFileserveClient()
 
 ezFileserveClient::~ezFileserveClient()
 {
+  for (auto& dd : m_MountedDataDirs)
+  {
+    if (dd.m_bMounted)
+      WriteCachedFileList(dd);
+  }
+
   ShutdownConnection();
 }
 
@@ -71,9 +79,15 @@ void ezFileserveClient::ClearState()
 {
   m_bDownloading = false;
   m_bWaitingForUploadFinished = false;
-  m_CurFileRequestGuid = ezUuid();
-  m_sCurFileRequest.Clear();
-  m_Download.Clear();
+  m_FileRequests.Clear();
+  m_PendingFileRequests.Clear();
+
+  // the server may not know anything about this client, so it has to be told about the cached content again
+  m_bPrefetchCachedFiles = !m_MountedDataDirs.IsEmpty();
+  for (auto& dd : m_MountedDataDirs)
+  {
+    dd.m_bCachedContentSent = false;
+  }
 }
 
 ezResult ezFileserveClient::EnsureConnected(ezTime timeout)
@@ -85,6 +99,7 @@ ezResult ezFileserveClient::EnsureConnected(ezTime timeout)
   if (m_Network == nullptr)
   {
     m_Network = ezRemoteInterfaceEnet::Make(); /// \todo Somehow abstract this away ?
+    m_Network->SetCompressionThreshold(1024);
 
     m_sFileserveCacheFolder = ezOSFile::GetUserDataFolder("ezFileserve/Cache");
     m_sFileserveCacheMetaFolder = ezOSFile::GetUserDataFolder("ezFileserve/Meta");
@@ -126,7 +141,32 @@ ezResult ezFileserveClient::EnsureConnected(ezTime timeout)
       ezLog::Success("Connected to ezFileserver '{0}", m_sServerConnectionAddress);
       m_Network->SetMessageHandler('FSRV', ezMakeDelegate(&ezFileserveClient::NetworkMsgHandler, this));
 
-      m_Network->Send('FSRV', 'HELO'); // be friendly
+      // be friendly, and make sure that we speak the same language
+      m_uiServerProtocolVersion = 0;
+
+      ezRemoteMessage msg('FSRV', 'HELO');
+      msg.GetWriter() << ezFileserveProtocolVersion;
+      m_Network->Send(ezRemoteTransmitMode::Reliable, msg);
+
+      const ezTime tStart = ezTime::Now();
+      while (m_uiServerProtocolVersion == 0 && ezTime::Now() - tStart < timeout)
+      {
+        ezThreadUtils::Sleep(ezTime::Milliseconds(10));
+
+        m_Network->UpdateRemoteInterface();
+        m_Network->ExecuteAllMessageHandlers();
+      }
+
+      if (m_uiServerProtocolVersion != ezFileserveProtocolVersion)
+      {
+        if (m_uiServerProtocolVersion == 0)
+          ezLog::Error("ezFileserver did not report its protocol version, it is probably outdated (client version is {0})", ezFileserveProtocolVersion);
+        else
+          ezLog::Error("ezFileserver uses protocol version {0}, but the client uses version {1}", m_uiServerProtocolVersion, ezFileserveProtocolVersion);
+
+        m_Network->ShutdownConnection();
+        return EZ_FAILURE;
+      }
     }
 
     m_bFailedToConnect = false;
@@ -192,6 +232,7 @@ void ezFileserveClient::UploadFile(ezUInt16 uiDataDirID, const char* szFile, con
     }
 
     WriteMetaFile(sCachedMetaFile, 0, uiHash);
+    AddCachedContent(uiHash, sMountPoint, szFile);
 
     InvalidateFileCache(uiDataDirID, szFile, uiHash);
   }
@@ -213,12 +254,12 @@ void ezFileserveClient::UploadFile(ezUInt16 uiDataDirID, const char* szFile, con
 
   ezUInt32 uiNextByte = 0;
 
-  // send the file over in multiple packages of 1KB each
+  // send the file over in multiple packages of 64KB each
   // send at least one package, even for empty files
 
   while (uiNextByte < fileContent.GetCount())
   {
-    const ezUInt16 uiChunkSize = (ezUInt16)ezMath::Min<ezUInt32>(1024, fileContent.GetCount() - uiNextByte);
+    const ezUInt32 uiChunkSize = ezMath::Min<ezUInt32>(64 * 1024, fileContent.GetCount() - uiNextByte);
 
     ezRemoteMessage msg;
     msg.GetWriter() << uploadGuid;
@@ -371,6 +412,12 @@ void ezFileserveClient::NetworkMsgHandler(ezRemoteMessage& msg)
     return;
   }
 
+  if (msg.GetMessageID() == 'HELO')
+  {
+    msg.GetReader() >> m_uiServerProtocolVersion;
+    return;
+  }
+
   ezLog::Error("Unknown FSRV message: '{0}' - {1} bytes", msg.GetMessageID(), msg.GetMessageSize());
 }
 
@@ -401,6 +448,12 @@ ezUInt16 ezFileserveClient::MountDataDirectory(const char* szDataDirectory, cons
   // dd.m_sRootName = sRoot;
   dd.m_sMountPoint = sMountPoint;
   dd.m_bMounted = true;
+  ReadCachedFileList(dd);
+
+  // the best match for a file may be in the new data directory
+  // all files in its cache are validated with the next request
+  InvalidateDataDirs();
+  m_bPrefetchCachedFiles = true;
 
   return uiDataDirID;
 }
@@ -409,6 +462,9 @@ ezUInt16 ezFileserveClient::MountDataDirectory(const char* szDataDirectory, cons
 void ezFileserveClient::UnmountDataDirectory(ezUInt16 uiDataDir)
 {
   EZ_LOCK(m_Mutex);
+  auto& dd = m_MountedDataDirs[uiDataDir];
+  WriteCachedFileList(dd);
+
   if (!m_Network->IsConnectedToServer())
     return;
 
@@ -417,8 +473,19 @@ void ezFileserveClient::UnmountDataDirectory(ezUInt16 uiDataDir)
 
   m_Network->Send(ezRemoteTransmitMode::Reliable, msg);
 
-  auto& dd = m_MountedDataDirs[uiDataDir];
   dd.m_bMounted = false;
+
+  InvalidateDataDirs();
+}
+
+void ezFileserveClient::InvalidateDataDirs()
+{
+  EZ_LOCK(m_Mutex);
+
+  // answers to requests that are still pending refer to the previous set of data directories
+  ++m_uiMountGeneration;
+  m_FileDataDir.Clear();
+  m_PendingFileRequests.Clear();
 }
 
 void ezFileserveClient::DeleteFile(ezUInt16 uiDataDir, const char* szFile)
@@ -439,31 +506,33 @@ void ezFileserveClient::DeleteFile(ezUInt16 uiDataDir, const char* szFile)
 void ezFileserveClient::HandleFileTransferMsg(ezRemoteMessage& msg)
 {
   EZ_LOCK(m_Mutex);
-  {
-    ezUuid fileRequestGuid;
-    msg.GetReader() >> fileRequestGuid;
 
-    if (fileRequestGuid != m_CurFileRequestGuid)
-    {
-      // ezLog::Debug("Fileserver is answering someone else");
-      return;
-    }
+  ezUuid fileRequestGuid;
+  msg.GetReader() >> fileRequestGuid;
+
+  auto itRequest = m_FileRequests.Find(fileRequestGuid);
+  if (!itRequest.IsValid())
+  {
+    // ezLog::Debug("Fileserver is answering someone else");
+    return;
   }
 
-  ezUInt16 uiChunkSize = 0;
+  ezDynamicArray<ezUInt8>& download = itRequest.Value().m_Download;
+
+  ezUInt32 uiChunkSize = 0;
   msg.GetReader() >> uiChunkSize;
 
   ezUInt32 uiFileSize = 0;
   msg.GetReader() >> uiFileSize;
 
   // make sure we don't need to reallocate
-  m_Download.Reserve(uiFileSize);
+  download.Reserve(uiFileSize);
 
   if (uiChunkSize > 0)
   {
-    const ezUInt32 uiStartPos = m_Download.GetCount();
-    m_Download.SetCountUninitialized(uiStartPos + uiChunkSize);
-    msg.GetReader().ReadBytes(&m_Download[uiStartPos], uiChunkSize);
+    const ezUInt32 uiStartPos = download.GetCount();
+    download.SetCountUninitialized(uiStartPos + uiChunkSize);
+    msg.GetReader().ReadBytes(&download[uiStartPos], uiChunkSize);
   }
 }
 
@@ -471,19 +540,19 @@ void ezFileserveClient::HandleFileTransferMsg(ezRemoteMessage& msg)
 void ezFileserveClient::HandleFileTransferFinishedMsg(ezRemoteMessage& msg)
 {
   EZ_LOCK(m_Mutex);
-  EZ_SCOPE_EXIT(m_bDownloading = false);
 
-  {
-    ezUuid fileRequestGuid;
-    msg.GetReader() >> fileRequestGuid;
+  ezUuid fileRequestGuid;
+  msg.GetReader() >> fileRequestGuid;
 
-    if (fileRequestGuid != m_CurFileRequestGuid)
-    {
-      // ezLog::Debug("Fileserver is answering someone else");
-      return;
-    }
+  auto itRequest = m_FileRequests.Find(fileRequestGuid);
+  if (!itRequest.IsValid())
+  {
+    // ezLog::Debug("Fileserver is answering someone else");
+    return;
   }
 
+  const FileRequest& request = itRequest.Value();
+
   ezFileserveFileState fileState;
   {
     ezInt8 iFileStatus = 0;
@@ -500,28 +569,59 @@ void ezFileserveClient::HandleFileTransferFinishedMsg(ezRemoteMessage& msg)
   ezUInt16 uiFoundInDataDir = 0;
   msg.GetReader() >> uiFoundInDataDir;
 
+  if (!request.m_bForceThisDataDir && request.m_uiMountGeneration != m_uiMountGeneration)
+  {
+    // the server searched for the best match in a different set of data directories, the answer is outdated
+    FinishFileRequest(fileRequestGuid);
+    return;
+  }
+
+  if (fileState == ezFileserveFileState::CachedContent)
+  {
+    ezStringBuilder sCachedFile;
+    BuildPathInCache(request.m_sFile, m_MountedDataDirs[uiFoundInDataDir].m_sMountPoint, &sCachedFile, nullptr);
+
+    if (CopyCachedContent(uiFileHash, sCachedFile).Failed())
+    {
+      // the content is not in the cache anymore, so the file has to be downloaded after all
+      const ezStringBuilder sFile = request.m_sFile;
+      SendFileRequest(fileRequestGuid, request.m_uiDataDir, request.m_bForceThisDataDir, sFile, false);
+      return;
+    }
+  }
+
+  EZ_SCOPE_EXIT(FinishFileRequest(fileRequestGuid));
+
   if (uiFoundInDataDir == 0xffff) // file does not exist on server in any data dir
   {
-    m_FileDataDir[m_sCurFileRequest] = 0; // placeholder
+    m_FileDataDir[request.m_sFile] = 0; // placeholder
 
     for (ezUInt32 i = 0; i < m_MountedDataDirs.GetCount(); ++i)
     {
-      auto& ref = m_MountedDataDirs[i].m_CacheStatus[m_sCurFileRequest];
+      auto& ref = m_MountedDataDirs[i].m_CacheStatus[request.m_sFile];
       ref.m_FileHash = 0;
       ref.m_TimeStamp = 0;
       ref.m_LastCheck = m_CurrentTime;
+
+      m_MountedDataDirs[i].m_bCachedFilesModified |= m_MountedDataDirs[i].m_CachedFiles.Remove(request.m_sFile);
     }
 
     return;
   }
   else
   {
-    m_FileDataDir[m_sCurFileRequest] = uiFoundInDataDir;
+    m_FileDataDir[request.m_sFile] = uiFoundInDataDir;
 
-    auto& ref = m_MountedDataDirs[uiFoundInDataDir].m_CacheStatus[m_sCurFileRequest];
+    auto& ref = m_MountedDataDirs[uiFoundInDataDir].m_CacheStatus[request.m_sFile];
     ref.m_FileHash = uiFileHash;
     ref.m_TimeStamp = iFileTimeStamp;
     ref.m_LastCheck = m_CurrentTime;
+
+    DataDir& dd = m_MountedDataDirs[uiFoundInDataDir];
+    if (fileState == ezFileserveFileState::NonExistant || fileState == ezFileserveFileState::NonExistantEither)
+      dd.m_bCachedFilesModified |= dd.m_CachedFiles.Remove(request.m_sFile);
+    else
+      dd.m_bCachedFilesModified |= !dd.m_CachedFiles.Insert(request.m_sFile);
   }
 
   // nothing changed
@@ -530,7 +630,7 @@ void ezFileserveClient::HandleFileTransferFinishedMsg(ezRemoteMessage& msg)
 
   const ezString& sMountPoint = m_MountedDataDirs[uiFoundInDataDir].m_sMountPoint;
   ezStringBuilder sCachedFile, sCachedMetaFile;
-  BuildPathInCache(m_sCurFileRequest, sMountPoint, &sCachedFile, &sCachedMetaFile);
+  BuildPathInCache(request.m_sFile, sMountPoint, &sCachedFile, &sCachedMetaFile);
 
   if (fileState == ezFileserveFileState::NonExistant)
   {
@@ -540,17 +640,82 @@ void ezFileserveClient::HandleFileTransferFinishedMsg(ezRemoteMessage& msg)
     return;
   }
 
-  // timestamp changed, but hash is still the same -> update timestamp
-  if (fileState == ezFileserveFileState::SameHash)
+  if (fileState == ezFileserveFileState::Different)
   {
-    WriteMetaFile(sCachedMetaFile, iFileTimeStamp, uiFileHash);
+    WriteDownloadToDisk(sCachedFile, request.m_Download);
   }
 
-  if (fileState == ezFileserveFileState::Different)
+  // for SameHash only the timestamp changed, for CachedContent the file was already copied
+  WriteMetaFile(sCachedMetaFile, iFileTimeStamp, uiFileHash);
+  AddCachedContent(uiFileHash, sMountPoint, request.m_sFile);
+}
+
+void ezFileserveClient::FinishFileRequest(const ezUuid& requestGuid)
+{
+  EZ_LOCK(m_Mutex);
+  auto itRequest = m_FileRequests.Find(requestGuid);
+  if (!itRequest.IsValid())
+    return;
+
+  auto itPending = m_PendingFileRequests.Find(itRequest.Value().m_sFile);
+  if (itPending.IsValid() && itPending.Value() == requestGuid)
   {
-    WriteDownloadToDisk(sCachedFile);
-    WriteMetaFile(sCachedMetaFile, iFileTimeStamp, uiFileHash);
+    m_PendingFileRequests.Remove(itPending);
   }
+
+  m_FileRequests.Remove(itRequest);
+}
+
+void ezFileserveClient::AddCachedContent(ezUInt64 uiFileHash, const char* szMountPoint, const char* szFile)
+{
+  EZ_LOCK(m_Mutex);
+  ezStringBuilder sPath = szMountPoint;
+  sPath.AppendPath(szFile);
+  sPath.MakeCleanPath();
+
+  m_CachedContent[uiFileHash] = sPath;
+}
+
+ezResult ezFileserveClient::CopyCachedContent(ezUInt64 uiFileHash, const char* szCachedFile)
+{
+  EZ_LOCK(m_Mutex);
+  const ezString* pContentPath = nullptr;
+  if (!m_CachedContent.TryGetValue(uiFileHash, pContentPath))
+    return EZ_FAILURE;
+
+  ezStringBuilder sContentFile = m_sFileserveCacheFolder;
+  sContentFile.AppendPath(*pContentPath);
+  sContentFile.MakeCleanPath();
+
+  ezStringBuilder sContentMetaFile = m_sFileserveCacheMetaFolder;
+  sContentMetaFile.AppendPath(*pContentPath);
+
+  // the file may have been changed or deleted since its content was added
+  ezInt64 iContentTimeStamp = 0;
+  ezUInt64 uiContentHash = 0;
+  if (ReadMetaFile(sContentMetaFile, iContentTimeStamp, uiContentHash).Failed() || uiContentHash != uiFileHash)
+  {
+    m_CachedContent.Remove(uiFileHash);
+    return EZ_FAILURE;
+  }
+
+  if (sContentFile == szCachedFile)
+    return EZ_SUCCESS;
+
+  ezDynamicArray<ezUInt8> content;
+  {
+    ezOSFile file;
+    if (file.Open(sContentFile, ezFileOpenMode::Read).Failed())
+    {
+      m_CachedContent.Remove(uiFileHash);
+      return EZ_FAILURE;
+    }
+
+    file.ReadAll(content);
+  }
+
+  WriteDownloadToDisk(szCachedFile, content);
+  return EZ_SUCCESS;
 }
 
 
@@ -570,14 +735,86 @@ void ezFileserveClient::WriteMetaFile(ezStringBuilder sCachedMetaFile, ezInt64 i
   }
 }
 
-void ezFileserveClient::WriteDownloadToDisk(ezStringBuilder sCachedFile)
+ezResult ezFileserveClient::ReadMetaFile(const char* szCachedMetaFile, ezInt64& out_iFileTimeStamp, ezUInt64& out_uiFileHash)
+{
+  ezOSFile meta;
+  EZ_SUCCEED_OR_RETURN(meta.Open(szCachedMetaFile, ezFileOpenMode::Read));
+
+  ezInt64 iFileTimeStamp = 0;
+  ezUInt64 uiFileHash = 0;
+  if (meta.Read(&iFileTimeStamp, sizeof(ezInt64)) != sizeof(ezInt64) || meta.Read(&uiFileHash, sizeof(ezUInt64)) != sizeof(ezUInt64))
+    return EZ_FAILURE;
+
+  out_iFileTimeStamp = iFileTimeStamp;
+  out_uiFileHash = uiFileHash;
+  return EZ_SUCCESS;
+}
+
+void ezFileserveClient::ReadCachedFileList(DataDir& dd) const
+{
+  EZ_LOCK(m_Mutex);
+  dd.m_CachedFiles.Clear();
+  dd.m_bCachedFilesModified = false;
+
+  ezStringBuilder sListFile = m_sFileserveCacheMetaFolder;
+  sListFile.AppendPath(dd.m_sMountPoint);
+  sListFile.Append(".files");
+
+  ezOSFile file;
+  if (file.Open(sListFile, ezFileOpenMode::Read).Failed())
+    return;
+
+  ezDynamicArray<ezUInt8> content;
+  file.ReadAll(content);
+  content.PushBack(0);
+
+  ezStringBuilder sContent = reinterpret_cast<const char*>(content.GetData());
+  ezHybridArray<ezStringView, 32> files;
+  sContent.Split(false, files, "\n");
+
+  for (const ezStringView& sFile : files)
+  {
+    dd.m_CachedFiles.Insert(sFile);
+  }
+}
+
+void ezFileserveClient::WriteCachedFileList(DataDir& dd) const
 {
   EZ_LOCK(m_Mutex);
+  if (!dd.m_bCachedFilesModified)
+    return;
+
+  dd.m_bCachedFilesModified = false;
+
+  ezStringBuilder sListFile = m_sFileserveCacheMetaFolder;
+  sListFile.AppendPath(dd.m_sMountPoint);
+  sListFile.Append(".files");
+
+  ezStringBuilder sContent;
+  for (const ezString& sFile : dd.m_CachedFiles)
+  {
+    sContent.Append(sFile, "\n");
+  }
+
+  ezOSFile file;
+  if (file.Open(sListFile, ezFileOpenMode::Write).Succeeded())
+  {
+    file.Write(sContent.GetData(), sContent.GetElementCount()).IgnoreResult();
+    file.Close();
+  }
+  else
+  {
+    ezLog::Error("Failed to write the list of cached files to '{0}'", sListFile);
+  }
+}
+
+void ezFileserveClient::WriteDownloadToDisk(ezStringBuilder sCachedFile, const ezDynamicArray<ezUInt8>& download)
+{
   ezOSFile file;
   if (file.Open(sCachedFile, ezFileOpenMode::Write).Succeeded())
   {
-    if (!m_Download.IsEmpty())
-      file.Write(m_Download.GetData(), m_Download.GetCount()).IgnoreResult();
+    if (!download.IsEmpty())
+      file.Write(download.GetData(), download.GetCount()).IgnoreResult();
 
     file.Close();
   }
@@ -625,30 +862,38 @@ ezResult ezFileserveClient::DownloadFile(ezUInt16 uiDataDirID, const char* szFil
     return EZ_SUCCESS;
   }
 
-  m_Download.Clear();
-  m_sCurFileRequest = szFile;
-  m_CurFileRequestGuid.CreateNewUuid();
-  m_bDownloading = true;
+  ezUuid requestGuid;
 
-  ezRemoteMessage msg('FSRV', 'READ');
-  msg.GetWriter() << uiUseDataDirCache;
-  msg.GetWriter() << bForceThisDataDir;
-  msg.GetWriter() << szFile;
-  msg.GetWriter() << m_CurFileRequestGuid;
-  msg.GetWriter() << CacheStatus.m_TimeStamp;
-  msg.GetWriter() << CacheStatus.m_FileHash;
+  // the file may have been requested already by PrefetchCachedFiles(), then only the answer needs to arrive
+  auto itPending = m_PendingFileRequests.Find(szFile);
+  if (!bForceThisDataDir && itPending.IsValid())
+  {
+    requestGuid = itPending.Value();
+  }
+  else
+  {
+    requestGuid.CreateNewUuid();
+    SendFileRequest(requestGuid, uiUseDataDirCache, bForceThisDataDir, szFile, true);
+  }
 
-  m_Network->Send(ezRemoteTransmitMode::Reliable, msg);
+  if (m_bPrefetchCachedFiles && !bForceThisDataDir)
+  {
+    PrefetchCachedFiles();
+  }
 
-  while (m_bDownloading)
+  m_bDownloading = true;
+
+  while (m_FileRequests.Contains(requestGuid))
   {
     m_Network->UpdateRemoteInterface();
     m_Network->ExecuteAllMessageHandlers();
   }
 
+  m_bDownloading = false;
+
   if (bForceThisDataDir)
   {
-    if (m_MountedDataDirs[uiDataDirID].m_CacheStatus[m_sCurFileRequest].m_FileHash == 0)
+    if (m_MountedDataDirs[uiDataDirID].m_CacheStatus[szFile].m_FileHash == 0)
       return EZ_FAILURE;
 
     if (out_pFullPath)
@@ -662,7 +907,7 @@ ezResult ezFileserveClient::DownloadFile(ezUInt16 uiDataDirID, const char* szFil
     if (uiBestDir == uiDataDirID) // best match is still this? -> success
     {
       // file does not exist
-      if (m_MountedDataDirs[uiBestDir].m_CacheStatus[m_sCurFileRequest].m_FileHash == 0)
+      if (m_MountedDataDirs[uiBestDir].m_CacheStatus[szFile].m_FileHash == 0)
         return EZ_FAILURE;
 
       if (out_pFullPath)
@@ -675,6 +920,107 @@ ezResult ezFileserveClient::DownloadFile(ezUInt16 uiDataDirID, const char* szFil
   }
 }
 
+void ezFileserveClient::SendFileRequest(const ezUuid& requestGuid, ezUInt16 uiDataDirID, bool bForceThisDataDir, const char* szFile, bool bAllowCachedContent)
+{
+  EZ_LOCK(m_Mutex);
+  const FileCacheStatus& CacheStatus = m_MountedDataDirs[uiDataDirID].m_CacheStatus[szFile];
+
+  ezRemoteMessage msg('FSRV', 'READ');
+  msg.GetWriter() << uiDataDirID;
+  msg.GetWriter() << bForceThisDataDir;
+  msg.GetWriter() << szFile;
+  msg.GetWriter() << requestGuid;
+  msg.GetWriter() << CacheStatus.m_TimeStamp;
+  msg.GetWriter() << CacheStatus.m_FileHash;
+  msg.GetWriter() << bAllowCachedContent;
+
+  m_Network->Send(ezRemoteTransmitMode::Reliable, msg);
+
+  FileRequest& request = m_FileRequests[requestGuid];
+  request.m_sFile = szFile;
+  request.m_uiDataDir = uiDataDirID;
+  request.m_bForceThisDataDir = bForceThisDataDir;
+  request.m_uiMountGeneration = m_uiMountGeneration;
+  request.m_Download.Clear();
+
+  if (!bForceThisDataDir)
+  {
+    m_PendingFileRequests[szFile] = requestGuid;
+  }
+}
+
+void ezFileserveClient::PrefetchCachedFiles()
+{
+  EZ_LOCK(m_Mutex);
+  m_bPrefetchCachedFiles = false;
+
+  ezHashSet<ezString> cachedFiles;
+  ezDynamicArray<ezUInt64> newContent;
+  ezStringBuilder sMetaFile;
+
+  for (auto& dd : m_MountedDataDirs)
+  {
+    if (!dd.m_bMounted)
+      continue;
+
+    for (const ezString& sFile : dd.m_CachedFiles)
+    {
+      cachedFiles.Insert(sFile);
+
+      if (dd.m_bCachedContentSent)
+        continue;
+
+      BuildPathInCache(sFile, dd.m_sMountPoint, nullptr, &sMetaFile);
+
+      ezInt64 iFileTimeStamp = 0;
+      ezUInt64 uiFileHash = 0;
+      if (ReadMetaFile(sMetaFile, iFileTimeStamp, uiFileHash).Succeeded() && uiFileHash != 0)
+      {
+        AddCachedContent(uiFileHash, dd.m_sMountPoint, sFile);
+        newContent.PushBack(uiFileHash);
+      }
+    }
+
+    dd.m_bCachedContentSent = true;
+  }
+
+  // tell the server which content the client has, before it answers the requests below
+  if (!newContent.IsEmpty())
+  {
+    ezRemoteMessage msg('FSRV', 'HAVE');
+    msg.GetWriter() << newContent.GetCount();
+
+    for (ezUInt64 uiHash : newContent)
+    {
+      msg.GetWriter() << uiHash;
+    }
+
+    m_Network->Send(ezRemoteTransmitMode::Reliable, msg);
+  }
+
+  // send the requests for all cached files at once, the answers are handled whenever the network is updated
+  ezUuid requestGuid;
+  for (const ezString& sCachedFile : cachedFiles)
+  {
+    if (m_PendingFileRequests.Contains(sCachedFile))
+      continue;
+
+    bool bCachedYet = false;
+    auto itFileDataDir = m_FileDataDir.FindOrAdd(sCachedFile, &bCachedYet);
+    if (!bCachedYet)
+    {
+      FillFileStatusCache(sCachedFile);
+    }
+
+    const ezUInt16 uiUseDataDirCache = itFileDataDir.Value();
+    if (m_CurrentTime - m_MountedDataDirs[uiUseDataDirCache].m_CacheStatus[sCachedFile].m_LastCheck < ezTime::Seconds(5.0f))
+      continue;
+
+    requestGuid.CreateNewUuid();
+    SendFileRequest(requestGuid, uiUseDataDirCache, false, sCachedFile, true);
+  }
+}
+
 void ezFileserveClient::DetermineCacheStatus(ezUInt16 uiDataDirID, const char* szFile, FileCacheStatus& out_Status) const
 {
   EZ_LOCK(m_Mutex);
@@ -687,16 +1033,12 @@ void ezFileserveClient::DetermineCacheStatus(ezUInt16 uiDataDirID, const char* s
 
   if (ezOSFile::ExistsFile(sAbsPathFile))
   {
-    ezOSFile meta;
-    if (meta.Open(sAbsPathMeta, ezFileOpenMode::Read).Failed())
+    if (ReadMetaFile(sAbsPathMeta, out_Status.m_TimeStamp, out_Status.m_FileHash).Failed())
     {
       // cleanup, when the meta file does not exist, the data file is useless
       ezOSFile::DeleteFile(sAbsPathFile).IgnoreResult();
       return;
     }
-
-    meta.Read(&out_Status.m_TimeStamp, sizeof(ezInt64));
-    meta.Read(&out_Status.m_FileHash, sizeof(ezUInt64));
   }
 }
 
@@ -4,6 +4,8 @@
 
 #include <Foundation/Communication/RemoteInterface.h>
 #include <Foundation/Configuration/Singleton.h>
+#include <Foundation/Containers/HashSet.h>
+#include <Foundation/Containers/HashTable.h>
 #include <Foundation/Types/UniquePtr.h>
 #include <Foundation/Types/Uuid.h>
 
@@ -24,6 +26,11 @@ namespace ezDataDirectory
 /// The timeout for connecting to the server can be configured through the command line option "-fs_timeout seconds"
 /// The server to connect to can be configured through command line option "-fs_server address".
 /// The default address is "localhost:1042".
+///
+/// Downloaded files are kept in a cache in the user data folder, together with their timestamp and content hash.
+/// For every data directory the cache also stores the list of files that it contains. When the first file is requested after data directories were mounted, all files that are in the cache for these data directories
+/// are validated in one go, instead of asking the server for one file at a time. The hashes of the cached content are sent to the server as well,
+/// so that a file whose content the client already has in its cache (e.g. under another name) is copied locally instead of downloaded again.
 class EZ_FILESERVEPLUGIN_DLL ezFileserveClient
 {
   EZ_DECLARE_SINGLETON(ezFileserveClient);
@@ -60,6 +67,11 @@ public:
   /// Also achieved through the command line argument "-fs_off"
   static void DisabledFileserveClient() { s_bEnableFileserve = false; }
 
+  /// \brief Enables the file serving functionality again, after it was switched off through DisabledFileserveClient().
+  ///
+  /// Creating an ezFileserver switches the client off. This allows to run both in the same process, e.g. for testing.
+  static void EnableFileserveClient() { s_bEnableFileserve = true; }
+
   /// \brief Returns the address through which the Fileserve client tried to connect with the server last.
   const char* GetServerConnectionAddress() { return m_sServerConnectionAddress; }
 
@@ -98,13 +110,26 @@ private:
     // ezString m_sPathOnClient;
     ezString m_sMountPoint;
     bool m_bMounted = false;
+    bool m_bCachedContentSent = false;
+    bool m_bCachedFilesModified = false;
 
     ezMap<ezString, FileCacheStatus> m_CacheStatus;
+    ezHashSet<ezString> m_CachedFiles; // all files of this data directory that are in the cache
+  };
+
+  struct FileRequest
+  {
+    ezString m_sFile;
+    ezUInt16 m_uiDataDir = 0;
+    bool m_bForceThisDataDir = false;
+    ezUInt32 m_uiMountGeneration = 0;
+    ezDynamicArray<ezUInt8> m_Download;
   };
 
   void DeleteFile(ezUInt16 uiDataDir, const char* szFile);
   ezUInt16 MountDataDirectory(const char* szDataDir, const char* szRootName);
   void UnmountDataDirectory(ezUInt16 uiDataDir);
+  void InvalidateDataDirs();
   static void ComputeDataDirMountPoint(const char* szDataDir, ezStringBuilder& out_sMountPoint);
   void BuildPathInCache(const char* szFile, const char* szMountPoint, ezStringBuilder* out_pAbsPath, ezStringBuilder* out_pFullPathMeta) const;
   void GetFullDataDirCachePath(const char* szDataDir, ezStringBuilder& out_sFullPath, ezStringBuilder& out_sFullPathMeta) const;
@@ -112,8 +137,16 @@ private:
   void HandleFileTransferMsg(ezRemoteMessage& msg);
   void HandleFileTransferFinishedMsg(ezRemoteMessage& msg);
   static void WriteMetaFile(ezStringBuilder sCachedMetaFile, ezInt64 iFileTimeStamp, ezUInt64 uiFileHash);
-  void WriteDownloadToDisk(ezStringBuilder sCachedFile);
+  static ezResult ReadMetaFile(const char* szCachedMetaFile, ezInt64& out_iFileTimeStamp, ezUInt64& out_uiFileHash);
+  static void WriteDownloadToDisk(ezStringBuilder sCachedFile, const ezDynamicArray<ezUInt8>& download);
+  void ReadCachedFileList(DataDir& dd) const;
+  void WriteCachedFileList(DataDir& dd) const;
+  void AddCachedContent(ezUInt64 uiFileHash, const char* szMountPoint, const char* szFile);
+  ezResult CopyCachedContent(ezUInt64 uiFileHash, const char* szCachedFile);
   ezResult DownloadFile(ezUInt16 uiDataDirID, const char* szFile, bool bForceThisDataDir, ezStringBuilder* out_pFullPath);
+  void SendFileRequest(const ezUuid& requestGuid, ezUInt16 uiDataDirID, bool bForceThisDataDir, const char* szFile, bool bAllowCachedContent);
+  void FinishFileRequest(const ezUuid& requestGuid);
+  void PrefetchCachedFiles();
   void DetermineCacheStatus(ezUInt16 uiDataDirID, const char* szFile, FileCacheStatus& out_Status) const;
   void UploadFile(ezUInt16 uiDataDirID, const char* szFile, const ezDynamicArray<ezUInt8>& fileContent);
   void InvalidateFileCache(ezUInt16 uiDataDirID, const char* szFile, ezUInt64 uiHash);
@@ -130,13 +163,16 @@ private:
   bool m_bDownloading = false;
   bool m_bFailedToConnect = false;
   bool m_bWaitingForUploadFinished = false;
-  ezUuid m_CurFileRequestGuid;
-  ezStringBuilder m_sCurFileRequest;
+  bool m_bPrefetchCachedFiles = false;
+  ezUInt32 m_uiMountGeneration = 0;
+  ezUInt32 m_uiServerProtocolVersion = 0; ///< Sent by the server in reply to 'HELO', 0 until then
   ezUniquePtr<ezRemoteInterface> m_Network;
-  ezDynamicArray<ezUInt8> m_Download;
   ezTime m_CurrentTime;
   ezHybridArray<ezString, 4> m_TryServerAddresses;
 
   ezMap<ezString, ezUInt16> m_FileDataDir;
+  ezMap<ezUuid, FileRequest> m_FileRequests;    // all requests that the server did not answer yet
+  ezMap<ezString, ezUuid> m_PendingFileRequests; // the outstanding request for a file, if it is not restricted to one data directory
+  ezHashTable<ezUInt64, ezString> m_CachedContent; // content hash -> path of a file in the cache (relative to the cache folder) with that content
   ezHybridArray<DataDir, 8> m_MountedDataDirs;
 };
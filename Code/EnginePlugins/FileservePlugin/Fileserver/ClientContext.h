@@ -1,9 +1,16 @@
 #pragma once
 
 #include <FileservePlugin/FileservePluginDLL.h>
+#include <Foundation/Containers/HashSet.h>
 #include <Foundation/Containers/HybridArray.h>
 #include <Foundation/Strings/String.h>
 
+/// \brief Version of the messages that the fileserver and its clients exchange. Has to be increased whenever a message changes.
+///
+/// The client sends its version with the 'HELO' message and the server answers with its own. Both sides refuse to talk to the other
+/// side, if the versions differ.
+constexpr ezUInt32 ezFileserveProtocolVersion = 2;
+
 enum class ezFileserveFileState
 {
   None = 0,
@@ -12,6 +19,7 @@ enum class ezFileserveFileState
   SameTimestamp = 3,
   SameHash = 4,
   Different = 5,
+  CachedContent = 6, ///< The file is different, but the client already has a file with the same content in its cache
 };
 
 class EZ_FILESERVEPLUGIN_DLL ezFileserveClientContext
@@ -37,6 +45,10 @@ public:
     ezDynamicArray<ezUInt8>& out_FileContent, bool bForceThisDataDir) const;
 
   bool m_bLostConnection = false;
+  bool m_bProtocolMismatch = false; ///< The client uses a different protocol version, all its messages are ignored
   ezUInt32 m_uiApplicationID = 0;
   ezHybridArray<DataDir, 8> m_MountedDataDirs;
+
+  /// \brief Hashes of all file contents that the client has in its cache, either announced by the client or sent to it.
+  ezHashSet<ezUInt64> m_CachedContent;
 };
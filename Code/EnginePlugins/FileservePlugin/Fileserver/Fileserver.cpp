@@ -27,6 +27,7 @@ void ezFileserver::StartServer()
   ezStringBuilder tmp;
 
   m_Network = ezRemoteInterfaceEnet::Make();
+  m_Network->SetCompressionThreshold(1024); // file transfers are bandwidth bound, zstd costs less than sending uncompressed data
   m_Network->StartServer('EZFS', ezConversionUtils::ToString(m_uiPort, tmp), false).IgnoreResult();
   m_Network->SetMessageHandler('FSRV', ezMakeDelegate(&ezFileserver::NetworkMsgHandler, this));
   m_Network->m_RemoteEvents.AddEventHandler(ezMakeDelegate(&ezFileserver::NetworkEventHandler, this));
@@ -83,7 +84,31 @@ void ezFileserver::NetworkMsgHandler(ezRemoteMessage& msg)
   auto& client = DetermineClient(msg);
 
   if (msg.GetMessageID() == 'HELO')
+  {
+    // a new connection, the client mounts its data directories and announces its cached content again
+    // the application ID of a client that restarts quickly may be the same as before
+    client.m_MountedDataDirs.Clear();
+    client.m_CachedContent.Clear();
+
+    // clients before version 2 did not send a protocol version
+    ezUInt32 uiClientVersion = 1;
+    if (msg.GetMessageSize() >= sizeof(ezUInt32))
+    {
+      msg.GetReader() >> uiClientVersion;
+    }
+
+    client.m_bProtocolMismatch = (uiClientVersion != ezFileserveProtocolVersion);
+    if (client.m_bProtocolMismatch)
+    {
+      ezLog::Error("Client {0} uses fileserve protocol version {1}, but the server uses version {2}. The client is ignored.", client.m_uiApplicationID,
+        uiClientVersion, ezFileserveProtocolVersion);
+    }
+
+    ezRemoteMessage ret('FSRV', 'HELO');
+    ret.GetWriter() << ezFileserveProtocolVersion;
+    m_Network->Send(ezRemoteTransmitMode::Reliable, ret);
     return;
+  }
 
   if (msg.GetMessageID() == 'RUTR')
   {
@@ -96,12 +121,21 @@ void ezFileserver::NetworkMsgHandler(ezRemoteMessage& msg)
     return;
   }
 
+  if (client.m_bProtocolMismatch)
+    return;
+
   if (msg.GetMessageID() == 'READ')
   {
     HandleFileRequest(client, msg);
     return;
   }
 
+  if (msg.GetMessageID() == 'HAVE')
+  {
+    HandleCachedContentInfo(client, msg);
+    return;
+  }
+
   if (msg.GetMessageID() == 'UPLH')
   {
     HandleUploadFileHeader(client, msg);
@@ -268,12 +302,21 @@ void ezFileserver::HandleFileRequest(ezFileserveClientContext& client, ezRemoteM
   msg.GetReader() >> status.m_iTimestamp;
   msg.GetReader() >> status.m_uiHash;
 
+  bool bAllowCachedContent = false;
+  msg.GetReader() >> bAllowCachedContent;
+
   ezFileserverEvent e;
   e.m_uiClientID = client.m_uiApplicationID;
   e.m_szPath = sRequestedFile;
   e.m_uiSentTotal = 0;
 
-  const ezFileserveFileState filestate = client.GetFileStatus(uiDataDirID, sRequestedFile, status, m_SendToClient, bForceThisDataDir);
+  ezFileserveFileState filestate = client.GetFileStatus(uiDataDirID, sRequestedFile, status, m_SendToClient, bForceThisDataDir);
+
+  // the client can copy the content from another file in its cache, instead of downloading it again
+  if (filestate == ezFileserveFileState::Different && bAllowCachedContent && client.m_CachedContent.Contains(status.m_uiHash))
+  {
+    filestate = ezFileserveFileState::CachedContent;
+  }
 
   {
     e.m_Type = ezFileserverEvent::Type::FileDownloadRequest;
@@ -287,11 +330,11 @@ void ezFileserver::HandleFileRequest(ezFileserveClientContext& client, ezRemoteM
     ezUInt32 uiNextByte = 0;
     const ezUInt32 uiFileSize = m_SendToClient.GetCount();
 
-    // send the file over in multiple packages of 1KB each
+    // send the file over in multiple packages of 64KB each, which are large enough to be compressed well
     // send at least one package, even for empty files
     do
     {
-      const ezUInt16 uiChunkSize = (ezUInt16)ezMath::Min<ezUInt32>(1024, m_SendToClient.GetCount() - uiNextByte);
+      const ezUInt32 uiChunkSize = ezMath::Min<ezUInt32>(64 * 1024, m_SendToClient.GetCount() - uiNextByte);
 
       ezRemoteMessage ret;
       ret.GetWriter() << downloadGuid;
@@ -313,6 +356,8 @@ void ezFileserver::HandleFileRequest(ezFileserveClientContext& client, ezRemoteM
         m_Events.Broadcast(e);
       }
     } while (uiNextByte < m_SendToClient.GetCount());
+
+    client.m_CachedContent.Insert(status.m_uiHash);
   }
 
   // final answer to client
@@ -334,6 +379,30 @@ void ezFileserver::HandleFileRequest(ezFileserveClientContext& client, ezRemoteM
   }
 }
 
+void ezFileserver::HandleCachedContentInfo(ezFileserveClientContext& client, ezRemoteMessage& msg)
+{
+  ezUInt32 uiNumHashes = 0;
+  msg.GetReader() >> uiNumHashes;
+
+  // the count comes from the client, it must not reserve more than the message can contain
+  const ezUInt32 uiRemainingSize = msg.GetMessageSize() > sizeof(ezUInt32) ? msg.GetMessageSize() - sizeof(ezUInt32) : 0;
+  if (uiNumHashes > uiRemainingSize / sizeof(ezUInt64))
+  {
+    ezLog::Error("Received an invalid cached content info from client {0}.", client.m_uiApplicationID);
+    return;
+  }
+
+  client.m_CachedContent.Reserve(client.m_CachedContent.GetCount() + uiNumHashes);
+
+  for (ezUInt32 i = 0; i < uiNumHashes; ++i)
+  {
+    ezUInt64 uiHash = 0;
+    msg.GetReader() >> uiHash;
+
+    client.m_CachedContent.Insert(uiHash);
+  }
+}
+
 void ezFileserver::HandleDeleteFileRequest(ezFileserveClientContext& client, ezRemoteMessage& msg)
 {
   ezUInt16 uiDataDirID = 0xffff;
@@ -389,7 +458,7 @@ void ezFileserver::HandleUploadFileTransfer(ezFileserveClientContext& client, ez
   if (transferGuid != m_FileUploadGuid)
     return;
 
-  ezUInt16 uiChunkSize = 0;
+  ezUInt32 uiChunkSize = 0;
   msg.GetReader() >> uiChunkSize;
 
   const ezUInt32 uiStartPos = m_SentFromClient.GetCount();
@@ -96,6 +96,7 @@ private:
   void HandleMountRequest(ezFileserveClientContext& client, ezRemoteMessage& msg);
   void HandleUnmountRequest(ezFileserveClientContext& client, ezRemoteMessage& msg);
   void HandleFileRequest(ezFileserveClientContext& client, ezRemoteMessage& msg);
+  void HandleCachedContentInfo(ezFileserveClientContext& client, ezRemoteMessage& msg);
   void HandleDeleteFileRequest(ezFileserveClientContext& client, ezRemoteMessage& msg);
   void HandleUploadFileHeader(ezFileserveClientContext& client, ezRemoteMessage& msg);
   void HandleUploadFileTransfer(ezFileserveClientContext& client, ezRemoteMessage& msg);
@@ -4,3 +4,8 @@ if (EZ_CMAKE_PLATFORM_WINDOWS_UWP AND TARGET TestFramework AND TARGET FileserveP
     target_link_libraries(TestFramework PRIVATE FileservePlugin)
     target_compile_definitions (TestFramework PRIVATE EZ_TESTFRAMEWORK_USE_FILESERVE)
 endif()
+
+if (TARGET PerformanceTest AND TARGET FileservePlugin)
+    target_link_libraries(PerformanceTest PRIVATE FileservePlugin)
+    target_compile_definitions (PerformanceTest PRIVATE EZ_PERFORMANCETEST_USE_FILESERVE)
+endif()
@@ -18,6 +18,7 @@ Options to be specific:
 -pack "path/to/folder" "path/to/another/folder" ...
 -unpack "path/to/file.ezArchive" "another/file.ezArchive"
 -out "path/to/file/or/folder"
+-dict
 
 -pack and -unpack can take multiple inputs to either aggregate multiple folders into one archive (pack)
 or to unpack multiple archives at the same time.
@@ -28,6 +29,9 @@ For unpacking the target should be a folder (may or may not exist) into which th
 
 If no -out is specified, it is determined to be where the input file is located.
 
+-dict enables compression dictionaries when packing. For every file type with many small files a dictionary is trained
+and stored in the archive, which considerably improves the compression of such files.
+
 If neither -pack nor -unpack is specified, the mode is detected automatically from the list of inputs.
 If all inputs are folders, mode is going to be 'pack'.
 If all inputs are files, mode is going to be 'unpack'.
@@ -100,6 +104,7 @@ public:
 
   ezDynamicArray<ezString> m_sInputs;
   ezString m_sOutput;
+  bool m_bTrainDictionaries = false;
 
   ezArchiveTool()
     : ezApplication("ArchiveTool")
@@ -117,6 +122,7 @@ public:
     ezCommandLineUtils& cmd = *ezCommandLineUtils::GetGlobalInstance();
 
     m_sOutput = cmd.GetStringOption("-out");
+    m_bTrainDictionaries = cmd.GetOptionIndex("-dict") >= 0;
 
     ezStringBuilder path;
 
@@ -176,6 +182,9 @@ public:
         if (ezStringUtils::IsEqual_NoCase(szArg, "-out"))
           break;
 
+        if (ezStringUtils::IsEqual_NoCase(szArg, "-dict"))
+          continue;
+
         m_sInputs.PushBack(ezOSFile::MakePathAbsoluteWithCWD(szArg));
 
         if (!ezOSFile::ExistsDirectory(m_sInputs.PeekBack()))
@@ -250,6 +259,7 @@ public:
   ezResult Pack()
   {
     ezArchiveBuilderImpl archive;
+    archive.m_bTrainDictionaries = m_bTrainDictionaries;
 
     for (const auto& folder : m_sInputs)
     {
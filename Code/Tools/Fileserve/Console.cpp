@@ -55,6 +55,9 @@ void ezFileserverApp::FileserverEventHandlerConsole(const ezFileserverEvent& e)
       if (e.m_FileState == ezFileserveFileState::NonExistantEither)
         ezLog::Dev("Request: (N/AE) '{0}'", e.m_szPath);
 
+      if (e.m_FileState == ezFileserveFileState::CachedContent)
+        ezLog::Dev("Request: (CACHE) '{0}'", e.m_szPath);
+
       if (e.m_FileState == ezFileserveFileState::Different)
         ezLog::Info("Request: '{0}' ({1} bytes)", e.m_szPath, e.m_uiSizeTotal);
     }
@@ -40,10 +40,8 @@ ezPhantomRTTI::~ezPhantomRTTI()
 
 void ezPhantomRTTI::SetProperties(ezDynamicArray<ezReflectedPropertyDescriptor>& properties)
 {
-  for (auto pProp : m_PropertiesStorage)
-  {
-    EZ_DEFAULT_DELETE(pProp);
-  }
+  // property tables that other threads may still use reference the old properties
+  RetireProperties(m_PropertiesStorage);
   m_PropertiesStorage.Clear();
 
   const ezUInt32 iCount = properties.GetCount();
@@ -128,6 +126,8 @@ void ezPhantomRTTI::UpdateType(ezReflectedTypeDescriptor& desc)
   SetProperties(desc.m_Properties);
   SetFunctions(desc.m_Functions);
   SetAttributes(desc.m_Attributes);
+
+  InvalidatePropertyTables();
 }
 
 bool ezPhantomRTTI::IsEqualToDescriptor(const ezReflectedTypeDescriptor& desc)
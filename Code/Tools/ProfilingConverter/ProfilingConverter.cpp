@@ -0,0 +1,165 @@
+#include <Foundation/Application/Application.h>
+#include <Foundation/IO/CompressedStreamZstd.h>
+#include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
+#include <Foundation/IO/FileSystem/FileReader.h>
+#include <Foundation/IO/FileSystem/FileSystem.h>
+#include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/Logging/ConsoleWriter.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Logging/VisualStudioWriter.h>
+#include <Foundation/Profiling/ProfilingCapture.h>
+#include <Foundation/Strings/StringBuilder.h>
+
+/* ezProfilingConverter command line options:
+
+-in "path/to/capture.ezProfilingCapture"
+-out "path/to/capture.json"
+
+Converts a binary profiling capture, as written by ezProfilingSystem::StartCaptureStream() or ProfilingData::WriteBinary(),
+into the Chrome trace JSON format. The JSON file can be opened in chrome://tracing or in the Perfetto UI (ui.perfetto.dev).
+
+Captures that were compressed with zstd are detected automatically.
+If no -out is specified, the output file is written next to the input file, with the extension 'json'.
+
+*/
+
+class ezProfilingConverter : public ezApplication
+{
+  ezStringBuilder m_sInputFile;
+  ezStringBuilder m_sOutputFile;
+
+public:
+  typedef ezApplication SUPER;
+
+  ezProfilingConverter()
+    : ezApplication("ProfilingConverter")
+  {
+  }
+
+  ezResult ParseArguments()
+  {
+    ezCommandLineUtils* cmd = ezCommandLineUtils::GetGlobalInstance();
+
+    m_sInputFile = cmd->GetStringOption("-in");
+    m_sInputFile.MakeCleanPath();
+
+    if (m_sInputFile.IsEmpty())
+    {
+      ezLog::Error("Missing '-in' argument");
+      return EZ_FAILURE;
+    }
+
+    m_sOutputFile = cmd->GetStringOption("-out");
+    m_sOutputFile.MakeCleanPath();
+
+    if (m_sOutputFile.IsEmpty())
+    {
+      m_sOutputFile = m_sInputFile;
+      m_sOutputFile.ChangeFileExtension("json");
+    }
+
+    return EZ_SUCCESS;
+  }
+
+  virtual void AfterCoreSystemsStartup() override
+  {
+    // Add the empty data directory to access files via absolute paths
+    ezFileSystem::AddDataDirectory("", "App", ":", ezFileSystem::AllowWrites).IgnoreResult();
+
+    ezGlobalLog::AddLogWriter(ezLogWriter::Console::LogMessageHandler);
+    ezGlobalLog::AddLogWriter(ezLogWriter::VisualStudio::LogMessageHandler);
+  }
+
+  virtual void BeforeCoreSystemsShutdown() override
+  {
+    // prevent further output during shutdown
+    ezGlobalLog::RemoveLogWriter(ezLogWriter::Console::LogMessageHandler);
+    ezGlobalLog::RemoveLogWriter(ezLogWriter::VisualStudio::LogMessageHandler);
+
+    SUPER::BeforeCoreSystemsShutdown();
+  }
+
+  ezResult ReadCapture(ezProfilingSystem::ProfilingData& out_Data)
+  {
+    bool bIsCompressed = false;
+
+    // uncompressed captures start with the magic, anything else is assumed to be compressed
+    {
+      ezFileReader file;
+      if (file.Open(m_sInputFile).Failed())
+      {
+        ezLog::Error("Could not open '{0}' for reading.", m_sInputFile);
+        return EZ_FAILURE;
+      }
+
+      char magic[4] = {};
+      file.ReadBytes(magic, sizeof(magic));
+      bIsCompressed = !ezMemoryUtils::IsEqual(magic, ezProfilingCaptureFormat::Magic, sizeof(magic));
+    }
+
+    ezFileReader file;
+    if (file.Open(m_sInputFile).Failed())
+    {
+      ezLog::Error("Could not open '{0}' for reading.", m_sInputFile);
+      return EZ_FAILURE;
+    }
+
+    if (!bIsCompressed)
+    {
+      return out_Data.ReadBinary(file);
+    }
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+    ezCompressedStreamReaderZstd decompressor(&file);
+    return out_Data.ReadBinary(decompressor);
+#else
+    ezLog::Error("'{0}' is compressed, but this build has no zstd support.", m_sInputFile);
+    return EZ_FAILURE;
+#endif
+  }
+
+  virtual ApplicationExecution Run() override
+  {
+    if (ParseArguments().Failed())
+    {
+      SetReturnCode(1);
+      return ezApplication::Quit;
+    }
+
+    ezProfilingSystem::ProfilingData data;
+    if (ReadCapture(data).Failed())
+    {
+      ezLog::Error("Failed to read the profiling capture '{0}'.", m_sInputFile);
+      SetReturnCode(2);
+      return ezApplication::Quit;
+    }
+
+    ezUInt64 uiNumScopes = 0;
+    for (const auto& eventBuffer : data.m_AllEventBuffers)
+    {
+      uiNumScopes += eventBuffer.m_Data.GetCount();
+    }
+
+    ezLog::Info("Read {0} scopes of {1} threads, {2} frames and {3} GPU scopes.", uiNumScopes, data.m_AllEventBuffers.GetCount(), data.m_FrameStartTimes.GetCount(), data.m_GPUScopes.GetCount());
+
+    ezFileWriter file;
+    if (file.Open(m_sOutputFile).Failed())
+    {
+      ezLog::Error("Could not open '{0}' for writing.", m_sOutputFile);
+      SetReturnCode(3);
+      return ezApplication::Quit;
+    }
+
+    if (data.Write(file).Failed())
+    {
+      ezLog::Error("Failed to write '{0}'.", m_sOutputFile);
+      SetReturnCode(3);
+      return ezApplication::Quit;
+    }
+
+    ezLog::Success("Converted '{0}' to '{1}'.", m_sInputFile, m_sOutputFile);
+    return ezApplication::Quit;
+  }
+};
+
+EZ_CONSOLEAPP_ENTRY_POINT(ezProfilingConverter);
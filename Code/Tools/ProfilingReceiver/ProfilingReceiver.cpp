@@ -0,0 +1,201 @@
+#include <Foundation/Application/Application.h>
+#include <Foundation/Communication/Telemetry.h>
+#include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
+#include <Foundation/IO/FileSystem/FileSystem.h>
+#include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/Logging/ConsoleWriter.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Logging/VisualStudioWriter.h>
+#include <Foundation/Strings/StringBuilder.h>
+#include <Foundation/Threading/ThreadUtils.h>
+#include <Foundation/Time/Time.h>
+
+/* ezProfilingReceiver command line options:
+
+-server "localhost:1040"
+-out "path/to/capture.ezProfilingCapture"
+-duration 10
+-interval 0.1
+-bandwidth 0
+
+Connects to a running application and records its live profiling stream (see ezProfilingSystem::IsTelemetryStreamActive()) into a
+binary profiling capture. The capture can be converted to JSON with the ProfilingConverter.
+
+-duration is the number of seconds to record, 0 records until the application disconnects.
+-interval is the number of seconds between two batches of profiling data.
+-bandwidth limits the stream to the given number of KB per second, 0 means no limit.
+
+*/
+
+class ezProfilingReceiver : public ezApplication
+{
+  ezStringBuilder m_sServer;
+  ezStringBuilder m_sOutputFile;
+  ezTime m_Duration;
+  ezTime m_FlushInterval;
+  ezUInt32 m_uiMaxBytesPerSecond = 0;
+
+public:
+  typedef ezApplication SUPER;
+
+  ezProfilingReceiver()
+    : ezApplication("ProfilingReceiver")
+  {
+  }
+
+  ezResult ParseArguments()
+  {
+    ezCommandLineUtils* cmd = ezCommandLineUtils::GetGlobalInstance();
+
+    m_sServer = cmd->GetStringOption("-server", 0, "localhost");
+
+    m_sOutputFile = cmd->GetStringOption("-out");
+    m_sOutputFile.MakeCleanPath();
+
+    if (m_sOutputFile.IsEmpty())
+    {
+      ezLog::Error("Missing '-out' argument");
+      return EZ_FAILURE;
+    }
+
+    m_Duration = ezTime::Seconds(cmd->GetFloatOption("-duration", 10.0));
+    m_FlushInterval = ezTime::Seconds(cmd->GetFloatOption("-interval", 0.1));
+    m_uiMaxBytesPerSecond = static_cast<ezUInt32>(ezMath::Max(cmd->GetFloatOption("-bandwidth", 0.0), 0.0) * 1024.0);
+
+    return EZ_SUCCESS;
+  }
+
+  virtual void AfterCoreSystemsStartup() override
+  {
+    // Add the empty data directory to access files via absolute paths
+    ezFileSystem::AddDataDirectory("", "App", ":", ezFileSystem::AllowWrites).IgnoreResult();
+
+    ezGlobalLog::AddLogWriter(ezLogWriter::Console::LogMessageHandler);
+    ezGlobalLog::AddLogWriter(ezLogWriter::VisualStudio::LogMessageHandler);
+  }
+
+  virtual void BeforeCoreSystemsShutdown() override
+  {
+    // prevent further output during shutdown
+    ezGlobalLog::RemoveLogWriter(ezLogWriter::Console::LogMessageHandler);
+    ezGlobalLog::RemoveLogWriter(ezLogWriter::VisualStudio::LogMessageHandler);
+
+    SUPER::BeforeCoreSystemsShutdown();
+  }
+
+  virtual ApplicationExecution Run() override
+  {
+    if (ParseArguments().Failed())
+    {
+      SetReturnCode(1);
+      return ezApplication::Quit;
+    }
+
+    ezFileWriter file;
+    if (file.Open(m_sOutputFile).Failed())
+    {
+      ezLog::Error("Could not open '{0}' for writing.", m_sOutputFile);
+      SetReturnCode(3);
+      return ezApplication::Quit;
+    }
+
+    ezTelemetry::AcceptMessagesForSystem('PROF', true);
+
+    if (ezTelemetry::ConnectToServer(m_sServer.GetData()).Failed())
+    {
+      ezLog::Error("Could not connect to '{0}'.", m_sServer);
+      SetReturnCode(2);
+      return ezApplication::Quit;
+    }
+
+    ezLog::Info("Connecting to '{0}'...", m_sServer);
+
+    bool bRequested = false;
+    bool bStreaming = false;
+    bool bStopRequested = false;
+    bool bFinished = false;
+    ezTime startTime;
+    ezTime lastReportTime;
+    ezUInt64 uiReceivedBytes = 0;
+    ezUInt64 uiReportedBytes = 0;
+
+    while (!bFinished)
+    {
+      ezTelemetry::UpdateNetwork();
+      ezTelemetry::PerFrameUpdate();
+
+      const ezTime now = ezTime::Now();
+
+      if (!bRequested && ezTelemetry::IsConnectedToServer())
+      {
+        ezTelemetryMessage msg;
+        msg.SetMessageID('PROF', ' ON ');
+        msg.GetWriter() << m_FlushInterval;
+        msg.GetWriter() << m_uiMaxBytesPerSecond;
+        ezTelemetry::SendToServer(msg);
+
+        bRequested = true;
+        startTime = now;
+        lastReportTime = now;
+      }
+
+      ezTelemetryMessage msg;
+      while (ezTelemetry::RetrieveMessage('PROF', msg).Succeeded())
+      {
+        if (msg.GetMessageID() == ' BGN')
+        {
+          bool bCompressed = false;
+          msg.GetReader() >> bCompressed;
+          ezLog::Info("Receiving the {0} profiling stream.", bCompressed ? "compressed" : "uncompressed");
+
+          bStreaming = true;
+        }
+        else if (msg.GetMessageID() == 'DATA' && bStreaming)
+        {
+          ezUInt8 temp[4096];
+          while (const ezUInt64 uiRead = msg.GetReader().ReadBytes(temp, sizeof(temp)))
+          {
+            file.WriteBytes(temp, uiRead).IgnoreResult();
+            uiReceivedBytes += uiRead;
+          }
+        }
+        else if (msg.GetMessageID() == ' END' && bStreaming)
+        {
+          bFinished = true;
+        }
+      }
+
+      if (bRequested)
+      {
+        if (!ezTelemetry::IsConnectedToServer())
+        {
+          ezLog::Warning("The connection was closed, the capture may be incomplete.");
+          bFinished = true;
+        }
+        else if (!bStopRequested && m_Duration.IsPositive() && now - startTime >= m_Duration)
+        {
+          // the application finishes the stream with its next frame and answers with ' END'
+          ezTelemetry::SendToServer('PROF', ' OFF');
+          bStopRequested = true;
+        }
+
+        if (now - lastReportTime >= ezTime::Seconds(1))
+        {
+          ezLog::Info("{0} KB/s", ezArgF((uiReceivedBytes - uiReportedBytes) / 1024.0 / (now - lastReportTime).GetSeconds(), 1));
+          uiReportedBytes = uiReceivedBytes;
+          lastReportTime = now;
+        }
+      }
+
+      ezThreadUtils::Sleep(ezTime::Milliseconds(10));
+    }
+
+    ezTelemetry::CloseConnection();
+    ezTelemetry::AcceptMessagesForSystem('PROF', false);
+
+    ezLog::Success("Received {0} KB in total, written to '{1}'.", uiReceivedBytes / 1024, m_sOutputFile);
+    return ezApplication::Quit;
+  }
+};
+
+EZ_CONSOLEAPP_ENTRY_POINT(ezProfilingReceiver);
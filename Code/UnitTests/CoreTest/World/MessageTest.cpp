@@ -2,6 +2,7 @@
 
 #include <Core/World/World.h>
 #include <Foundation/Memory/FrameAllocator.h>
+#include <Foundation/Threading/Thread.h>
 #include <Foundation/Time/Clock.h>
 
 namespace
@@ -82,6 +83,26 @@ namespace
   EZ_END_COMPONENT_TYPE;
   // clang-format on
 
+  class PostMessageThread : public ezThread
+  {
+  public:
+    ezGameObject* m_pReceiver = nullptr;
+    ezInt32 m_iFirstValue = 0;
+
+  private:
+    virtual ezUInt32 Run() override
+    {
+      for (ezInt32 i = 0; i < 100; ++i)
+      {
+        TestMessage1 msg;
+        msg.m_iValue = m_iFirstValue + i;
+        m_pReceiver->PostMessage(msg, ezTime::Zero(), ezObjectMsgQueueType::NextFrame);
+      }
+
+      return 0;
+    }
+  };
+
   void ResetComponents(ezGameObject& object)
   {
     TestComponentMsg* pComponent = nullptr;
@@ -200,6 +221,68 @@ EZ_CREATE_SIMPLE_TEST(World, Messaging)
     ezFrameAllocator::Reset();
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Queuing from multiple threads")
+  {
+    ResetComponents(*pRoot);
+
+    PostMessageThread threads[4];
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(threads); ++i)
+    {
+      threads[i].m_pReceiver = pRoot;
+      threads[i].m_iFirstValue = i * 100;
+      threads[i].Start();
+    }
+
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(threads); ++i)
+    {
+      threads[i].Join();
+    }
+
+    world.Update();
+
+    // 1 + sum of 0..399
+    TestComponentMsg* pComponent2 = nullptr;
+    pRoot->TryGetComponentOfBaseType(pComponent2);
+    EZ_TEST_INT(pComponent2->m_iSomeData, 79801);
+    EZ_TEST_INT(pComponent2->m_iSomeData2, 2);
+
+    ezFrameAllocator::Reset();
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Queuing from multiple threads while updating")
+  {
+    ResetComponents(*pRoot);
+
+    PostMessageThread threads[4];
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(threads); ++i)
+    {
+      threads[i].m_pReceiver = pRoot;
+      threads[i].m_iFirstValue = i * 100;
+      threads[i].Start();
+    }
+
+    while (threads[0].IsRunning() || threads[1].IsRunning() || threads[2].IsRunning() || threads[3].IsRunning())
+    {
+      world.Update();
+    }
+
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(threads); ++i)
+    {
+      threads[i].Join();
+    }
+
+    // messages posted during the last update are processed in the next one
+    world.Update();
+
+    // 1 + sum of 0..399
+    TestComponentMsg* pComponent2 = nullptr;
+    pRoot->TryGetComponentOfBaseType(pComponent2);
+    EZ_TEST_INT(pComponent2->m_iSomeData, 79801);
+    EZ_TEST_INT(pComponent2->m_iSomeData2, 2);
+
+    ezFrameAllocator::Reset();
+  }
+
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "Queuing with delay")
   {
     ResetComponents(*pRoot);
@@ -3,6 +3,7 @@
 #include <Foundation/Algorithm/HashHelperString.h>
 #include <Foundation/Algorithm/HashStream.h>
 #include <Foundation/Algorithm/HashableStruct.h>
+#include <Foundation/Math/Random.h>
 #include <Foundation/Strings/HashedString.h>
 
 EZ_CREATE_SIMPLE_TEST_GROUP(Algorithm);
@@ -114,6 +115,114 @@ EZ_CREATE_SIMPLE_TEST(Algorithm, Hashing)
     EZ_TEST_INT(uiHash1_64, uiHash2_64);
     EZ_TEST_INT(uiHash1_64, uiHash3_64);
     EZ_TEST_INT(uiHash1_64, uiHash4_64);
+
+    // XXH3 at compile time, covering the short, mid size and long (> 240 bytes) code paths
+    static_assert(ezHashingUtils::xxHash3_64String("") == 0x2d06800538d394c2ULL);
+    static_assert(ezHashingUtils::xxHash3_64String("Test string") == 0xb79e57a9f5acb608ULL);
+    static_assert(ezHashingUtils::xxHash3_64String("Test string", 42) == 0x3527bf976328c09fULL);
+    static_assert(ezHashingUtils::xxHash3_64String("This is a longer test string for 64-bit. 123456") == 0xa672f005daaefde4ULL);
+    static_assert(ezHashingUtils::xxHash3_64String("The quick brown fox jumps over the lazy dog. The quick brown fox jumps over the lazy dog. The quick brown fox "
+                                                   "jumps over the lazy dog. The quick brown fox jumps over the lazy dog!") == 0xde3e218a3c0d3f8cULL);
+    constexpr ezUInt64 uiXXH3CTLong =
+      ezHashingUtils::xxHash3_64String("The quick brown fox jumps over the lazy dog. The quick brown fox jumps over the lazy dog. The quick brown fox "
+                                       "jumps over the lazy dog. The quick brown fox jumps over the lazy dog. The quick brown fox jumps over the lazy "
+                                       "dog. The quick brown fox jumps over the lazy dog.",
+        42);
+    static_assert(uiXXH3CTLong == 0x1a82a0829944052cULL);
+
+    const ezStringView sLong = "The quick brown fox jumps over the lazy dog. The quick brown fox jumps over the lazy dog. The quick brown fox jumps over "
+                               "the lazy dog. The quick brown fox jumps over the lazy dog. The quick brown fox jumps over the lazy dog. The quick brown "
+                               "fox jumps over the lazy dog.";
+    EZ_TEST_INT(ezHashingUtils::xxHash3_64String(sLong, 42), uiXXH3CTLong);
+    EZ_TEST_INT(ezHashingUtils::xxHash3_64String(sLong), 0x3ae45314ce9c766eULL);
+    EZ_TEST_INT(ezHashingUtils::xxHash3_64(sb.GetData(), sb.GetElementCount()), 0x3075d155d9912961ULL);
+
+    // Check XXH3 for unaligned inputs
+    uiHash1_64 = ezHashingUtils::xxHash3_64(alignmentTestString, 8);
+    uiHash2_64 = ezHashingUtils::xxHash3_64(alignmentTestString + 9, 8);
+    uiHash3_64 = ezHashingUtils::xxHash3_64(alignmentTestString + 19, 8);
+    uiHash4_64 = ezHashingUtils::xxHash3_64(alignmentTestString + 30, 8);
+    EZ_TEST_INT(uiHash1_64, uiHash2_64);
+    EZ_TEST_INT(uiHash1_64, uiHash3_64);
+    EZ_TEST_INT(uiHash1_64, uiHash4_64);
+
+    const ezHash128 xxh3_128 = ezHashingUtils::xxHash3_128(sb.GetData(), sb.GetElementCount());
+    EZ_TEST_INT(xxh3_128.m_uiLow, 0x6c7495112652a1c2ULL);
+    EZ_TEST_INT(xxh3_128.m_uiHigh, 0x1cc922c641a39cb3ULL);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "xxHash3")
+  {
+    // reference values of XXH3 0.8 for a pseudo random input, chosen to hit every length dependent code path
+    struct XXH3TestVector
+    {
+      ezUInt32 m_uiLength;
+      ezUInt64 m_uiHash64;
+      ezHash128 m_Hash128;
+    };
+
+    // clang-format off
+    const XXH3TestVector unseeded[] = {
+      {0, 0x2d06800538d394c2ULL, {0x6001c324468d497fULL, 0x99aa06d3014798d8ULL}},
+      {1, 0xc44bdff4074eecdbULL, {0xc44bdff4074eecdbULL, 0xa6cd5e9392000f6aULL}},
+      {3, 0xe14090f554a5ea90ULL, {0xe14090f554a5ea90ULL, 0x977fcbc0448b49f6ULL}},
+      {4, 0x2e8d078a566e9749ULL, {0x4ee6926f0426173eULL, 0x4e82b36688c5328fULL}},
+      {8, 0xcd1c7f88482fcaefULL, {0x79d85adaeefd615eULL, 0x7b4966a681f18d57ULL}},
+      {9, 0xbfe43def699fa9e3ULL, {0xee5940d4df4715aeULL, 0x200d098a7113e15fULL}},
+      {16, 0x81e9eb8634460bb9ULL, {0x37286a19cf622308ULL, 0x78e8ab538d3acaabULL}},
+      {17, 0x9998430fd0a655beULL, {0x33bed349ec1c0ce7ULL, 0x1ea709ada2b9c32eULL}},
+      {64, 0x22a06b30c4c72936ULL, {0xa6e3ffeedc6985ddULL, 0x5834551911de3391ULL}},
+      {128, 0x75eca5c5d5594884ULL, {0xe1f0636051ccd2beULL, 0x5ac741c59c95d36aULL}},
+      {129, 0xa05da42e7a4e4667ULL, {0xcfb3fed667226458ULL, 0x1240f4d960139642ULL}},
+      {200, 0xe07bfbc15015bf69ULL, {0x3572cb319f206ea7ULL, 0xddc90e87387183a2ULL}},
+      {240, 0x5eb2467c8c9e3969ULL, {0xb2e6947c477a4ab0ULL, 0x640a6149838a7599ULL}},
+      {241, 0x2d431e984c441f15ULL, {0x2d431e984c441f15ULL, 0xe817e20e53e42a8cULL}},
+      {1024, 0xe99def1145f12936ULL, {0xe99def1145f12936ULL, 0xdf4c8b9ff9715101ULL}},
+      {1025, 0x83cba9b371e4e7f4ULL, {0x83cba9b371e4e7f4ULL, 0x63e845aab7eb695fULL}},
+      {2049, 0x3cd32460d504d215ULL, {0x3cd32460d504d215ULL, 0xe8a3f6e37b449e74ULL}},
+      {5000, 0xb9daede5f99f736eULL, {0xb9daede5f99f736eULL, 0xdf8bd4ddb16d1d1cULL}},
+    };
+
+    const XXH3TestVector seeded[] = {
+      {0, 0xa8a6b918b2f0364aULL, {0xa986dfc5d7605bfeULL, 0x00feaa732a3ce25eULL}},
+      {1, 0x032be332dd766ef8ULL, {0x032be332dd766ef8ULL, 0x20e49abcc53b3842ULL}},
+      {4, 0xc78fc70884112819ULL, {0x70630e5888b5ccdcULL, 0x47a13b3cf1b82b2dULL}},
+      {9, 0x7f17f269596b1a97ULL, {0xfefb4fb03e25f899ULL, 0x605cc98c4e74956dULL}},
+      {17, 0x2645c71c33424f39ULL, {0xc96ae6415a980126ULL, 0x27c1cac6a19b66bdULL}},
+      {129, 0xfa404b1cfb446afcULL, {0x69f15a40d8bd17f0ULL, 0x218306135924ff4cULL}},
+      {240, 0xee3c616df5bb8fe1ULL, {0x752ff291dc4021c1ULL, 0xc30d2b0f4065734eULL}},
+      {241, 0x81aadbeff92a6c78ULL, {0x81aadbeff92a6c78ULL, 0x0522d4b6ae996eb4ULL}},
+      {1024, 0xcb6920288f6922a8ULL, {0xcb6920288f6922a8ULL, 0x164d219b3391f153ULL}},
+      {2049, 0xcb818d415eb86c2bULL, {0xcb818d415eb86c2bULL, 0x1e0b77b022bb9819ULL}},
+      {5000, 0xc0236e379e79ae6fULL, {0xc0236e379e79ae6fULL, 0x8e7c90e297e9a726ULL}},
+    };
+    // clang-format on
+
+    ezDynamicArray<ezUInt8> data;
+    data.SetCountUninitialized(5000);
+    for (ezUInt32 i = 0; i < data.GetCount(); ++i)
+    {
+      data[i] = static_cast<ezUInt8>((i * 2654435761u) >> 24);
+    }
+
+    for (const XXH3TestVector& v : unseeded)
+    {
+      EZ_TEST_INT(ezHashingUtils::xxHash3_64(data.GetData(), v.m_uiLength), v.m_uiHash64);
+      EZ_TEST_BOOL_MSG(ezHashingUtils::xxHash3_128(data.GetData(), v.m_uiLength) == v.m_Hash128, "128 bit hash mismatch for length %u", v.m_uiLength);
+    }
+
+    const ezUInt64 uiSeed = 0x9E3779B185EBCA8DULL;
+    for (const XXH3TestVector& v : seeded)
+    {
+      EZ_TEST_INT(ezHashingUtils::xxHash3_64(data.GetData(), v.m_uiLength, uiSeed), v.m_uiHash64);
+      EZ_TEST_BOOL_MSG(ezHashingUtils::xxHash3_128(data.GetData(), v.m_uiLength, uiSeed) == v.m_Hash128, "128 bit hash mismatch for length %u", v.m_uiLength);
+    }
+
+    // unaligned input must not make a difference for the vectorized long input path
+    ezDynamicArray<ezUInt8> shifted;
+    shifted.SetCountUninitialized(2049 + 3);
+    ezMemoryUtils::Copy(shifted.GetData() + 3, data.GetData(), 2049);
+    EZ_TEST_INT(ezHashingUtils::xxHash3_64(shifted.GetData() + 3, 2049), 0x3cd32460d504d215ULL);
   }
 
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "HashHelper")
@@ -278,6 +387,72 @@ EZ_CREATE_SIMPLE_TEST(Algorithm, Hashing)
     const ezUInt64 uiHash3 = ezHashingUtils::xxHash64(szTest, std::strlen(szTest));
     EZ_TEST_INT(uiHash1, uiHash3);
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "HashStreamXxHash3")
+  {
+    ezDynamicArray<ezUInt8> data;
+    data.SetCountUninitialized(5000);
+    for (ezUInt32 i = 0; i < data.GetCount(); ++i)
+    {
+      data[i] = static_cast<ezUInt8>((i * 2654435761u) >> 24);
+    }
+
+    ezRandom rng;
+    rng.Initialize(42);
+
+    // lengths around the mid size limit, the internal buffer size and block boundaries
+    const ezUInt32 lengths[] = {0, 1, 15, 64, 200, 240, 241, 255, 256, 257, 300, 1023, 1024, 1025, 2048, 2049, 5000};
+    const ezUInt64 seeds[] = {0, 0x9E3779B185EBCA8DULL};
+
+    for (ezUInt64 uiSeed : seeds)
+    {
+      for (ezUInt32 uiLength : lengths)
+      {
+        const ezUInt64 uiExpected64 = ezHashingUtils::xxHash3_64(data.GetData(), uiLength, uiSeed);
+        const ezHash128 expected128 = ezHashingUtils::xxHash3_128(data.GetData(), uiLength, uiSeed);
+
+        // everything at once
+        {
+          ezHashStreamWriterXxHash3_64 writer64(uiSeed);
+          ezHashStreamWriterXxHash3_128 writer128(uiSeed);
+          EZ_TEST_BOOL(writer64.WriteBytes(data.GetData(), uiLength).Succeeded());
+          EZ_TEST_BOOL(writer128.WriteBytes(data.GetData(), uiLength).Succeeded());
+          EZ_TEST_INT(writer64.GetHashValue(), uiExpected64);
+          EZ_TEST_BOOL_MSG(writer128.GetHashValue() == expected128, "128 bit stream hash mismatch for length %u", uiLength);
+        }
+
+        // in random pieces, reading the intermediate hash in between must not change the result
+        {
+          ezHashStreamWriterXxHash3_64 writer64(uiSeed);
+          ezHashStreamWriterXxHash3_128 writer128(uiSeed);
+
+          ezUInt32 uiOffset = 0;
+          while (uiOffset < uiLength)
+          {
+            const ezUInt32 uiChunk = ezMath::Min(uiLength - uiOffset, rng.UIntInRange(600) + 1);
+            EZ_TEST_BOOL(writer64.WriteBytes(data.GetData() + uiOffset, uiChunk).Succeeded());
+            EZ_TEST_BOOL(writer128.WriteBytes(data.GetData() + uiOffset, uiChunk).Succeeded());
+            uiOffset += uiChunk;
+
+            EZ_TEST_INT(writer64.GetHashValue(), ezHashingUtils::xxHash3_64(data.GetData(), uiOffset, uiSeed));
+          }
+
+          EZ_TEST_INT(writer64.GetHashValue(), uiExpected64);
+          EZ_TEST_BOOL_MSG(writer128.GetHashValue() == expected128, "128 bit stream hash mismatch for length %u", uiLength);
+        }
+      }
+    }
+
+    // byte by byte
+    {
+      ezHashStreamWriterXxHash3_64 writer64;
+      for (ezUInt32 i = 0; i < 2049; ++i)
+      {
+        writer64.WriteBytes(data.GetData() + i, 1).IgnoreResult();
+      }
+      EZ_TEST_INT(writer64.GetHashValue(), 0x3cd32460d504d215ULL);
+    }
+  }
 }
 
 struct SimpleHashableStruct : public ezHashableStruct<SimpleHashableStruct>
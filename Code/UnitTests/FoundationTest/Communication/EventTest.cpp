@@ -1,6 +1,8 @@
 #include <FoundationTestPCH.h>
 
 #include <Foundation/Communication/Event.h>
+#include <Foundation/Memory/CommonAllocators.h>
+#include <Foundation/Threading/Thread.h>
 
 EZ_CREATE_SIMPLE_TEST_GROUP(Communication);
 
@@ -29,6 +31,27 @@ namespace
     Event m_Event;
     ezUInt32 m_uiRecursionCount;
   };
+
+  typedef ezCopyOnWriteEvent<ezInt32, ezMutex> ConcurrentEvent;
+
+  class BroadcastThread : public ezThread
+  {
+  public:
+    ConcurrentEvent* m_pEvent = nullptr;
+    ezUInt32 m_uiNumBroadcasts = 0;
+    ezAtomicBool m_bStop;
+
+  private:
+    virtual ezUInt32 Run() override
+    {
+      for (ezUInt32 i = 0; i < m_uiNumBroadcasts && !m_bStop; ++i)
+      {
+        m_pEvent->Broadcast(1);
+      }
+
+      return 0;
+    }
+  };
 } // namespace
 
 EZ_CREATE_SIMPLE_TEST(Communication, Event)
@@ -173,4 +196,119 @@ EZ_CREATE_SIMPLE_TEST(Communication, Event)
 
     e.RemoveEventHandler(subscriptions[0]);
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Copy on write: Size")
+  {
+    // only copy on write events pay for the snapshot state
+    EZ_TEST_BOOL(sizeof(ezEvent<int, ezMutex>) == sizeof(ezCopyOnBroadcastEvent<int, ezMutex>));
+    EZ_TEST_BOOL(sizeof(ezEvent<int, ezMutex>) < sizeof(ezCopyOnWriteEvent<int, ezMutex>));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Copy on write: Remove while iterate")
+  {
+    typedef ezCopyOnWriteEvent<int, ezMutex> TestEvent;
+    TestEvent e;
+
+    ezUInt32 callMap = 0;
+
+    ezEventSubscriptionID subscriptions[3] = {};
+
+    subscriptions[0] = e.AddEventHandler(TestEvent::Handler([&](int i) { callMap |= EZ_BIT(0); }));
+
+    subscriptions[1] = e.AddEventHandler(TestEvent::Handler([&](int i) {
+      callMap |= EZ_BIT(1);
+      e.RemoveEventHandler(subscriptions[1]);
+      e.RemoveEventHandler(subscriptions[2]);
+    }));
+
+    subscriptions[2] = e.AddEventHandler(TestEvent::Handler([&](int i) { callMap |= EZ_BIT(2); }));
+
+    // the broadcast uses the handlers that were registered when it started
+    e.Broadcast(0);
+    EZ_TEST_BOOL(callMap == (EZ_BIT(0) | EZ_BIT(1) | EZ_BIT(2)));
+
+    callMap = 0;
+    e.Broadcast(0);
+    EZ_TEST_BOOL(callMap == EZ_BIT(0));
+
+    e.Clear();
+
+    callMap = 0;
+    e.Broadcast(0);
+    EZ_TEST_BOOL(callMap == 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Copy on write: Concurrent broadcasts")
+  {
+    ConcurrentEvent e;
+
+    ezAtomicInteger32 iPermanentSum;
+    ezAtomicInteger32 iTemporarySum;
+
+    e.AddEventHandler(ConcurrentEvent::Handler([&](ezInt32 i) { iPermanentSum.Add(i); }));
+
+    const ezUInt32 uiNumThreads = 4;
+    const ezUInt32 uiNumBroadcasts = 10000;
+
+    BroadcastThread threads[uiNumThreads];
+    for (ezUInt32 t = 0; t < uiNumThreads; ++t)
+    {
+      threads[t].m_pEvent = &e;
+      threads[t].m_uiNumBroadcasts = uiNumBroadcasts;
+      threads[t].Start();
+    }
+
+    // (un)registering handlers does not interfere with the running broadcasts
+    for (ezUInt32 i = 0; i < 1000; ++i)
+    {
+      ezEventSubscriptionID id = e.AddEventHandler(ConcurrentEvent::Handler([&](ezInt32 iValue) { iTemporarySum.Add(iValue); }));
+      e.RemoveEventHandler(id);
+    }
+
+    for (ezUInt32 t = 0; t < uiNumThreads; ++t)
+    {
+      threads[t].Join();
+    }
+
+    EZ_TEST_INT(iPermanentSum, uiNumThreads * uiNumBroadcasts);
+    EZ_TEST_BOOL(iTemporarySum <= (ezInt32)(uiNumThreads * uiNumBroadcasts));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Copy on write: Reclaim during broadcasts")
+  {
+    ezHeapAllocator allocator("copy on write event allocator");
+
+    {
+      ConcurrentEvent e(&allocator);
+      e.AddEventHandler(ConcurrentEvent::Handler([](ezInt32 i) {}));
+
+      const ezUInt32 uiNumThreads = 4;
+
+      BroadcastThread threads[uiNumThreads];
+      for (ezUInt32 t = 0; t < uiNumThreads; ++t)
+      {
+        threads[t].m_pEvent = &e;
+        threads[t].m_uiNumBroadcasts = 0xFFFFFFFF;
+        threads[t].Start();
+      }
+
+      for (ezUInt32 i = 0; i < 1000; ++i)
+      {
+        ezEventSubscriptionID id = e.AddEventHandler(ConcurrentEvent::Handler([](ezInt32 iValue) {}));
+        e.RemoveEventHandler(id);
+      }
+
+      // the broadcasts overlap all the time, still the replaced snapshots must not pile up
+      const ezAllocatorBase::Stats stats = allocator.GetStats();
+      EZ_TEST_BOOL(stats.m_uiNumAllocations - stats.m_uiNumDeallocations < 100);
+
+      for (ezUInt32 t = 0; t < uiNumThreads; ++t)
+      {
+        threads[t].m_bStop = true;
+        threads[t].Join();
+      }
+    }
+
+    EZ_TEST_INT(allocator.GetStats().m_uiNumAllocations, allocator.GetStats().m_uiNumDeallocations);
+  }
 }
@@ -0,0 +1,173 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Communication/IpcChannel.h>
+#include <Foundation/Communication/RemoteMessage.h>
+#include <Foundation/Reflection/Reflection.h>
+#include <Foundation/Types/Uuid.h>
+#include <Foundation/Utilities/ConversionUtils.h>
+
+#if EZ_ENABLED(EZ_PLATFORM_LINUX)
+
+namespace
+{
+  class ezIpcChannelTestMsg : public ezProcessMessage
+  {
+    EZ_ADD_DYNAMIC_REFLECTION(ezIpcChannelTestMsg, ezProcessMessage);
+
+  public:
+    ezUInt32 m_uiIndex = 0;
+    ezDataBuffer m_Data;
+  };
+
+  // clang-format off
+  EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezIpcChannelTestMsg, 1, ezRTTIDefaultAllocator<ezIpcChannelTestMsg>)
+  {
+    EZ_BEGIN_PROPERTIES
+    {
+      EZ_MEMBER_PROPERTY("Index", m_uiIndex),
+      EZ_MEMBER_PROPERTY("Data", m_Data),
+    }
+    EZ_END_PROPERTIES;
+  }
+  EZ_END_DYNAMIC_REFLECTED_TYPE;
+  // clang-format on
+
+  struct ReceivedMessages
+  {
+    ezDynamicArray<ezUInt32> m_Indices;
+    ezUInt32 m_uiNumCorruptMessages = 0;
+
+    void OnMessage(const ezProcessMessage* pMsg)
+    {
+      const ezIpcChannelTestMsg* pTestMsg = ezDynamicCast<const ezIpcChannelTestMsg*>(pMsg);
+      if (pTestMsg == nullptr)
+      {
+        ++m_uiNumCorruptMessages;
+        return;
+      }
+
+      for (ezUInt32 i = 0; i < pTestMsg->m_Data.GetCount(); ++i)
+      {
+        if (pTestMsg->m_Data[i] != static_cast<ezUInt8>(pTestMsg->m_uiIndex + i))
+        {
+          ++m_uiNumCorruptMessages;
+          break;
+        }
+      }
+
+      m_Indices.PushBack(pTestMsg->m_uiIndex);
+    }
+  };
+
+  void SendTestMessage(ezIpcChannel* pChannel, ezUInt32 uiIndex, ezUInt32 uiDataSize)
+  {
+    ezIpcChannelTestMsg msg;
+    msg.m_uiIndex = uiIndex;
+    msg.m_Data.SetCountUninitialized(uiDataSize);
+
+    for (ezUInt32 i = 0; i < uiDataSize; ++i)
+    {
+      msg.m_Data[i] = static_cast<ezUInt8>(uiIndex + i);
+    }
+
+    pChannel->Send(&msg);
+  }
+
+  template <typename Condition>
+  bool WaitForCondition(ezIpcChannel* pChannel, Condition condition)
+  {
+    const ezTime tTimeout = ezTime::Now() + ezTime::Seconds(30);
+
+    while (!condition())
+    {
+      if (ezTime::Now() > tTimeout)
+        return false;
+
+      if (pChannel == nullptr || !pChannel->ProcessMessages())
+      {
+        ezThreadUtils::Sleep(ezTime::Milliseconds(1));
+      }
+    }
+
+    return true;
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Communication, IpcChannel)
+{
+  ezUuid guid;
+  guid.CreateNewUuid();
+
+  ezStringBuilder sAddress, sGuid;
+  sAddress.Format("ezIpcChannelTest-{0}", ezConversionUtils::ToString(guid, sGuid));
+
+  ezIpcChannel* pServer = ezIpcChannel::CreatePipeChannel(sAddress, ezIpcChannel::Mode::Server);
+  ezIpcChannel* pClient = ezIpcChannel::CreatePipeChannel(sAddress, ezIpcChannel::Mode::Client);
+
+  ReceivedMessages serverReceived;
+  ReceivedMessages clientReceived;
+  pServer->m_MessageEvent.AddEventHandler(ezMakeDelegate(&ReceivedMessages::OnMessage, &serverReceived));
+  pClient->m_MessageEvent.AddEventHandler(ezMakeDelegate(&ReceivedMessages::OnMessage, &clientReceived));
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Connect")
+  {
+    // messages sent before the connection is established are queued
+    SendTestMessage(pClient, 0, 16);
+
+    pServer->Connect();
+    pClient->Connect();
+
+    EZ_TEST_BOOL(WaitForCondition(nullptr, [&]() { return pServer->IsConnected() && pClient->IsConnected(); }));
+    EZ_TEST_BOOL(WaitForCondition(pServer, [&]() { return serverReceived.m_Indices.GetCount() == 1; }));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Small Messages")
+  {
+    for (ezUInt32 i = 1; i <= 1000; ++i)
+    {
+      SendTestMessage(pClient, i, i % 64);
+      SendTestMessage(pServer, i, i % 32);
+    }
+
+    EZ_TEST_BOOL(WaitForCondition(pServer, [&]() { return serverReceived.m_Indices.GetCount() == 1001; }));
+    EZ_TEST_BOOL(WaitForCondition(pClient, [&]() { return clientReceived.m_Indices.GetCount() == 1000; }));
+
+    for (ezUInt32 i = 0; i < serverReceived.m_Indices.GetCount(); ++i)
+    {
+      EZ_TEST_INT(serverReceived.m_Indices[i], i);
+    }
+
+    for (ezUInt32 i = 0; i < clientReceived.m_Indices.GetCount(); ++i)
+    {
+      EZ_TEST_INT(clientReceived.m_Indices[i], i + 1);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Large Messages")
+  {
+    serverReceived.m_Indices.Clear();
+
+    // larger than the buffers that are used internally, so the messages have to be streamed in multiple parts
+    for (ezUInt32 i = 0; i < 3; ++i)
+    {
+      SendTestMessage(pClient, i, 6 * 1024 * 1024 + i);
+    }
+
+    EZ_TEST_BOOL(WaitForCondition(pServer, [&]() { return serverReceived.m_Indices.GetCount() == 3; }));
+  }
+
+  EZ_TEST_INT(serverReceived.m_uiNumCorruptMessages, 0);
+  EZ_TEST_INT(clientReceived.m_uiNumCorruptMessages, 0);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Disconnect")
+  {
+    pClient->Disconnect();
+
+    EZ_TEST_BOOL(WaitForCondition(nullptr, [&]() { return !pServer->IsConnected() && !pClient->IsConnected(); }));
+  }
+
+  EZ_DEFAULT_DELETE(pClient);
+  EZ_DEFAULT_DELETE(pServer);
+}
+
+#endif
@@ -0,0 +1,275 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Communication/RemoteInterfaceEnet.h>
+#include <Foundation/Types/UniquePtr.h>
+#include <TestFramework/Framework/Benchmark.h>
+
+#ifdef BUILDSYSTEM_ENABLE_ENET_SUPPORT
+
+namespace
+{
+  constexpr ezUInt32 s_uiRemoteTestToken = 'EZRT';
+  constexpr ezUInt32 s_uiRemoteTestSystem = 'TEST';
+  constexpr ezUInt32 s_uiRemoteTestMessage = 'DATA';
+
+  // The message data is the index of the message, followed by bytes that are derived from the index
+  void FillRemoteTestData(ezArrayPtr<ezUInt8> data, ezUInt32 uiIndex)
+  {
+    ezMemoryUtils::Copy(data.GetPtr(), reinterpret_cast<const ezUInt8*>(&uiIndex), sizeof(ezUInt32));
+
+    for (ezUInt32 i = sizeof(ezUInt32); i < data.GetCount(); ++i)
+    {
+      data[i] = static_cast<ezUInt8>((uiIndex + i / 64) & 0xFF);
+    }
+  }
+
+  struct ezRemoteTestReceiver
+  {
+    ezDynamicArray<ezUInt32> m_Indices;
+    ezDynamicArray<ezUInt32> m_Sizes;
+    ezUInt32 m_uiNumCorruptMessages = 0;
+
+    void OnMessage(ezRemoteMessage& msg)
+    {
+      const ezUInt8* pData = msg.GetMessageData();
+      const ezUInt32 uiSize = msg.GetMessageSize();
+
+      if (msg.GetMessageID() != s_uiRemoteTestMessage || uiSize < sizeof(ezUInt32))
+      {
+        ++m_uiNumCorruptMessages;
+        return;
+      }
+
+      ezUInt32 uiIndex = 0;
+      ezMemoryUtils::Copy(reinterpret_cast<ezUInt8*>(&uiIndex), pData, sizeof(ezUInt32));
+
+      for (ezUInt32 i = sizeof(ezUInt32); i < uiSize; ++i)
+      {
+        if (pData[i] != static_cast<ezUInt8>((uiIndex + i / 64) & 0xFF))
+        {
+          ++m_uiNumCorruptMessages;
+          break;
+        }
+      }
+
+      m_Indices.PushBack(uiIndex);
+      m_Sizes.PushBack(uiSize);
+    }
+  };
+
+  void SendRemoteTestMessage(ezRemoteInterface* pRemote, ezRemoteTransmitMode tm, ezUInt32 uiIndex, ezUInt32 uiDataSize)
+  {
+    ezDynamicArray<ezUInt8> data;
+    data.SetCountUninitialized(uiDataSize);
+    FillRemoteTestData(data, uiIndex);
+
+    pRemote->Send(tm, s_uiRemoteTestSystem, s_uiRemoteTestMessage, data);
+  }
+
+  template <typename Condition>
+  bool UpdateRemoteInterfacesUntil(ezRemoteInterface* pServer, ezRemoteInterface* pClient, Condition condition)
+  {
+    const ezTime tTimeout = ezTime::Now() + ezTime::Seconds(10);
+
+    while (!condition())
+    {
+      if (ezTime::Now() > tTimeout)
+        return false;
+
+      pClient->UpdateRemoteInterface();
+      pServer->UpdateRemoteInterface();
+      pClient->ExecuteAllMessageHandlers();
+      pServer->ExecuteAllMessageHandlers();
+    }
+
+    return true;
+  }
+
+  bool ConnectRemoteInterfaces(ezRemoteInterface* pServer, ezRemoteInterface* pClient, const char* szPort)
+  {
+    ezStringBuilder sServerAddress, sClientAddress;
+    sServerAddress.Format(":{0}", szPort);
+    sClientAddress.Format("localhost:{0}", szPort);
+
+    if (pServer->StartServer(s_uiRemoteTestToken, sServerAddress, false).Failed())
+      return false;
+
+    if (pClient->ConnectToServer(s_uiRemoteTestToken, sClientAddress, false).Failed())
+      return false;
+
+    return UpdateRemoteInterfacesUntil(pServer, pClient, [&]() { return pClient->IsConnectedToServer() && pServer->IsConnectedToClients(); });
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Communication, RemoteInterface)
+{
+  ezUniquePtr<ezRemoteInterfaceEnet> pServer = ezRemoteInterfaceEnet::Make();
+  ezUniquePtr<ezRemoteInterfaceEnet> pClient = ezRemoteInterfaceEnet::Make();
+
+  ezRemoteTestReceiver serverReceived;
+  ezRemoteTestReceiver clientReceived;
+  pServer->SetMessageHandler(s_uiRemoteTestSystem, ezMakeDelegate(&ezRemoteTestReceiver::OnMessage, &serverReceived));
+  pClient->SetMessageHandler(s_uiRemoteTestSystem, ezMakeDelegate(&ezRemoteTestReceiver::OnMessage, &clientReceived));
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Connect")
+  {
+    EZ_TEST_BOOL(ConnectRemoteInterfaces(pServer.Borrow(), pClient.Borrow(), "4571"));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Batched Messages")
+  {
+    // many more messages than fit into one packet
+    for (ezUInt32 i = 0; i < 5000; ++i)
+    {
+      SendRemoteTestMessage(pClient.Borrow(), ezRemoteTransmitMode::Reliable, i, 4 + i % 100);
+    }
+
+    EZ_TEST_BOOL(UpdateRemoteInterfacesUntil(pServer.Borrow(), pClient.Borrow(), [&]() { return serverReceived.m_Indices.GetCount() == 5000; }));
+
+    for (ezUInt32 i = 0; i < serverReceived.m_Indices.GetCount(); ++i)
+    {
+      EZ_TEST_INT(serverReceived.m_Indices[i], i);
+      EZ_TEST_INT(serverReceived.m_Sizes[i], 4 + i % 100);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Large Messages")
+  {
+    clientReceived.m_Indices.Clear();
+    clientReceived.m_Sizes.Clear();
+
+    // mixed with small messages, to make sure the order is kept
+    for (ezUInt32 i = 0; i < 6; ++i)
+    {
+      SendRemoteTestMessage(pServer.Borrow(), ezRemoteTransmitMode::Reliable, i, (i % 2 == 0) ? 16 : 300 * 1024);
+    }
+
+    EZ_TEST_BOOL(UpdateRemoteInterfacesUntil(pServer.Borrow(), pClient.Borrow(), [&]() { return clientReceived.m_Indices.GetCount() == 6; }));
+
+    for (ezUInt32 i = 0; i < clientReceived.m_Indices.GetCount(); ++i)
+    {
+      EZ_TEST_INT(clientReceived.m_Indices[i], i);
+      EZ_TEST_INT(clientReceived.m_Sizes[i], (i % 2 == 0) ? 16 : 300 * 1024);
+    }
+  }
+
+#  ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Compressed Messages")
+  {
+    serverReceived.m_Indices.Clear();
+    serverReceived.m_Sizes.Clear();
+
+    pClient->SetCompressionThreshold(1024);
+
+    for (ezUInt32 i = 0; i < 10; ++i)
+    {
+      SendRemoteTestMessage(pClient.Borrow(), ezRemoteTransmitMode::Reliable, i, 500 + i * 20000);
+    }
+
+    EZ_TEST_BOOL(UpdateRemoteInterfacesUntil(pServer.Borrow(), pClient.Borrow(), [&]() { return serverReceived.m_Indices.GetCount() == 10; }));
+
+    for (ezUInt32 i = 0; i < serverReceived.m_Indices.GetCount(); ++i)
+    {
+      EZ_TEST_INT(serverReceived.m_Indices[i], i);
+      EZ_TEST_INT(serverReceived.m_Sizes[i], 500 + i * 20000);
+    }
+
+    pClient->SetCompressionThreshold(0);
+  }
+#  endif
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "External Buffers")
+  {
+    serverReceived.m_Indices.Clear();
+    serverReceived.m_Sizes.Clear();
+
+    ezDynamicArray<ezUInt8> buffers[8];
+    ezUInt32 uiNumReleased = 0;
+
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(buffers); ++i)
+    {
+      const ezUInt32 uiDataSize = (i % 2 == 0) ? 32 : 100 * 1024;
+      buffers[i].SetCountUninitialized(ezRemoteInterface::ExternalBufferHeaderSize + uiDataSize);
+      FillRemoteTestData(buffers[i].GetArrayPtr().GetSubArray(ezRemoteInterface::ExternalBufferHeaderSize), i);
+
+      // regular messages in between have to arrive in order
+      SendRemoteTestMessage(pClient.Borrow(), ezRemoteTransmitMode::Reliable, 100 + i, 8);
+
+      pClient->SendExternal(ezRemoteTransmitMode::Reliable, s_uiRemoteTestSystem, s_uiRemoteTestMessage, buffers[i].GetArrayPtr(),
+        [&uiNumReleased](ezArrayPtr<ezUInt8>) { ++uiNumReleased; });
+    }
+
+    EZ_TEST_BOOL(UpdateRemoteInterfacesUntil(pServer.Borrow(), pClient.Borrow(),
+      [&]() { return serverReceived.m_Indices.GetCount() == 2 * EZ_ARRAY_SIZE(buffers) && uiNumReleased == EZ_ARRAY_SIZE(buffers); }));
+
+    for (ezUInt32 i = 0; i < serverReceived.m_Indices.GetCount(); ++i)
+    {
+      EZ_TEST_INT(serverReceived.m_Indices[i], (i % 2 == 0) ? 100 + i / 2 : i / 2);
+    }
+
+    EZ_TEST_INT(uiNumReleased, EZ_ARRAY_SIZE(buffers));
+  }
+
+  EZ_TEST_INT(serverReceived.m_uiNumCorruptMessages, 0);
+  EZ_TEST_INT(clientReceived.m_uiNumCorruptMessages, 0);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Shutdown")
+  {
+    pClient->ShutdownConnection();
+    pServer->ShutdownConnection();
+
+    // without a connection, external buffers are released right away
+    ezUInt8 buffer[ezRemoteInterface::ExternalBufferHeaderSize + 4] = {};
+    bool bReleased = false;
+    pClient->SendExternal(ezRemoteTransmitMode::Reliable, s_uiRemoteTestSystem, s_uiRemoteTestMessage, ezArrayPtr<ezUInt8>(buffer),
+      [&bReleased](ezArrayPtr<ezUInt8>) { bReleased = true; });
+
+    EZ_TEST_BOOL(bReleased);
+  }
+}
+
+EZ_CREATE_BENCHMARK(Communication, RemoteInterfaceMessagesPerSecond)
+{
+  constexpr ezUInt32 uiMessagesPerIteration = 1000;
+
+  ezUniquePtr<ezRemoteInterfaceEnet> pServer = ezRemoteInterfaceEnet::Make();
+  ezUniquePtr<ezRemoteInterfaceEnet> pClient = ezRemoteInterfaceEnet::Make();
+
+  ezRemoteTestReceiver serverReceived;
+  pServer->SetMessageHandler(s_uiRemoteTestSystem, ezMakeDelegate(&ezRemoteTestReceiver::OnMessage, &serverReceived));
+
+  if (!ConnectRemoteInterfaces(pServer.Borrow(), pClient.Borrow(), "4572"))
+  {
+    EZ_TEST_FAILURE("Connection failed", "The remote interfaces could not connect over localhost.");
+    pClient->ShutdownConnection();
+    pServer->ShutdownConnection();
+    return;
+  }
+
+  ezUInt8 data[32];
+  FillRemoteTestData(ezArrayPtr<ezUInt8>(data), 0);
+
+  benchmark.SetItemsPerIteration(uiMessagesPerIteration);
+
+  while (benchmark.KeepRunning())
+  {
+    serverReceived.m_Indices.Clear();
+    serverReceived.m_Sizes.Clear();
+
+    for (ezUInt32 i = 0; i < uiMessagesPerIteration; ++i)
+    {
+      pClient->Send(ezRemoteTransmitMode::Reliable, s_uiRemoteTestSystem, s_uiRemoteTestMessage, data, sizeof(data));
+    }
+
+    if (!UpdateRemoteInterfacesUntil(pServer.Borrow(), pClient.Borrow(), [&]() { return serverReceived.m_Indices.GetCount() == uiMessagesPerIteration; }))
+    {
+      EZ_TEST_FAILURE("Timeout", "Not all messages arrived.");
+      break;
+    }
+  }
+
+  pClient->ShutdownConnection();
+  pServer->ShutdownConnection();
+}
+
+#endif
@@ -1,6 +1,8 @@
 #include <FoundationTestPCH.h>
 
 #include <Foundation/IO/Archive/Archive.h>
+#include <Foundation/IO/Archive/ArchiveBuilder.h>
+#include <Foundation/IO/Archive/ArchiveReader.h>
 #include <Foundation/IO/Archive/DataDirTypeArchive.h>
 #include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
 #include <Foundation/IO/FileSystem/FileReader.h>
@@ -157,3 +159,93 @@ EZ_CREATE_SIMPLE_TEST(IO, Archive)
 }
 
 #endif
+
+#if EZ_ENABLED(EZ_SUPPORTS_MEMORY_MAPPED_FILE) && defined(BUILDSYSTEM_ENABLE_ZSTD_SUPPORT)
+
+EZ_CREATE_SIMPLE_TEST(IO, ArchiveDictionary)
+{
+  ezStringBuilder sOutputFolder = ezTestFramework::GetInstance()->GetAbsOutputPath();
+  sOutputFolder.AppendPath("ArchiveDictionaryTest");
+  sOutputFolder.MakeCleanPath();
+
+  ezOSFile::CreateDirectoryStructure(sOutputFolder).IgnoreResult();
+
+  if (!EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sOutputFolder, "ArchiveDictionary", "output", ezFileSystem::AllowWrites).Succeeded()))
+    return;
+
+  const ezUInt32 uiNumFiles = 16;
+  const ezStringBuilder sArchiveFile(sOutputFolder, "/Materials.ezArchive");
+
+  ezDynamicArray<ezString> FileContent;
+  ezArchiveBuilder builder;
+  builder.m_bTrainDictionaries = true;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Generate Data")
+  {
+    // small files of one type that share most of their content
+    ezStringBuilder sText, sFile, sTarget;
+
+    for (ezUInt32 i = 0; i < uiNumFiles; ++i)
+    {
+      sText.Format("Material ( Shader = \"Shaders/Materials/DefaultMaterial.ezShader\" BaseColor = ( {0}, {1}, {2}, 1 ) "
+                   "BaseTexture = \"Textures/Texture{3}.ezTexture2D\" NormalTexture = \"Textures/Texture{3}_n.ezTexture2D\" )",
+        i % 3, i % 5, i % 7, i);
+      FileContent.PushBack(sText);
+
+      sTarget.Format("Material{0}.ezMaterial", i);
+      sFile.Format(":output/Data/{0}", sTarget);
+
+      ezFileWriter file;
+      if (!EZ_TEST_BOOL(file.Open(sFile).Succeeded()))
+        return;
+
+      EZ_TEST_BOOL(file.WriteBytes(sText.GetData(), sText.GetElementCount()).Succeeded());
+
+      auto& entry = builder.m_Entries.ExpandAndGetRef();
+      sFile.Format("{0}/Data/{1}", sOutputFolder, sTarget);
+      entry.m_sAbsSourcePath = sFile;
+      entry.m_sRelTargetPath = sTarget;
+      entry.m_CompressionMode = ezArchiveCompressionMode::Compressed_zstd;
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Write Archive")
+  {
+    EZ_TEST_BOOL(builder.WriteArchive(":output/Materials.ezArchive").Succeeded());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Read Archive")
+  {
+    ezArchiveReader reader;
+    if (!EZ_TEST_BOOL(reader.OpenArchive(sArchiveFile).Succeeded()))
+      return;
+
+    const ezArchiveTOC& toc = reader.GetArchiveTOC();
+    EZ_TEST_INT(toc.m_Entries.GetCount(), uiNumFiles);
+    EZ_TEST_INT(toc.m_Dictionaries.GetCount(), 1);
+
+    ezStringBuilder sPath;
+    ezDynamicArray<char> content;
+
+    for (ezUInt32 i = 0; i < uiNumFiles; ++i)
+    {
+      sPath.Format("Material{0}.ezMaterial", i);
+
+      const ezUInt32 uiEntry = toc.FindEntry(sPath);
+      if (!EZ_TEST_BOOL(uiEntry != ezInvalidIndex))
+        continue;
+
+      EZ_TEST_BOOL(toc.m_Entries[uiEntry].m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd_dict);
+      EZ_TEST_BOOL(reader.GetEntryDictionary(uiEntry) != nullptr);
+
+      ezUniquePtr<ezStreamReader> pEntryReader = reader.CreateEntryReader(uiEntry);
+      content.SetCount(FileContent[i].GetElementCount() + 1);
+      EZ_TEST_INT(pEntryReader->ReadBytes(content.GetData(), content.GetCount()), FileContent[i].GetElementCount());
+      EZ_TEST_BOOL(ezStringView(content.GetData(), FileContent[i].GetElementCount()) == FileContent[i]);
+    }
+  }
+
+  ezFileSystem::RemoveDataDirectoryGroup("ArchiveDictionary");
+}
+
+#endif
@@ -1,8 +1,10 @@
 #include <FoundationTestPCH.h>
 
+#include <Foundation/IO/Archive/ArchiveUtils.h>
 #include <Foundation/IO/CompressedStreamZstd.h>
 #include <Foundation/IO/MemoryStream.h>
 #include <Foundation/IO/Stream.h>
+#include <TestFramework/Utilities/TestLogInterface.h>
 
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
 
@@ -136,4 +138,267 @@ EZ_CREATE_SIMPLE_TEST(IO, CompressedStreamZstd)
   }
 }
 
+EZ_CREATE_SIMPLE_TEST(IO, CompressedStreamZstdDictionary)
+{
+  // many small 'files' that share most of their content, similar to small asset files
+  ezDynamicArray<ezDynamicArray<ezUInt8>> Samples;
+  ezDynamicArray<ezArrayPtr<const ezUInt8>> SampleViews;
+
+  {
+    ezStringBuilder sText;
+
+    for (ezUInt32 i = 0; i < 64; ++i)
+    {
+      sText.Format("Material ( BaseMaterial = \"Materials/BaseMaterials/Lit.ezMaterialAsset\" Shader = \"Shaders/Materials/DefaultMaterial.ezShader\" "
+                   "Permutations ( BLEND_MODE = BLEND_MODE_OPAQUE TWO_SIDED = FALSE ) BaseColor = ( {0}, {1}, {2}, 1 ) "
+                   "BaseTexture = \"Textures/Texture{3}.ezTexture2D\" NormalTexture = \"Textures/Texture{3}_n.ezTexture2D\" "
+                   "RoughnessValue = 0.{4} MetallicValue = 0.{5} )",
+        i % 3, i % 5, i % 7, i, i % 10, (i * 7) % 10);
+
+      Samples.ExpandAndGetRef().PushBackRange(ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(sText.GetData()), sText.GetElementCount()));
+      SampleViews.PushBack(Samples.PeekBack());
+    }
+  }
+
+  ezCompressedStreamZstdDictionary Dictionary;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Train Dictionary")
+  {
+    ezDynamicArray<ezUInt8> DictionaryData;
+    ezArchiveUtils::TrainDictionary(SampleViews, 16 * 1024, DictionaryData);
+
+    EZ_TEST_BOOL(!DictionaryData.IsEmpty());
+    EZ_TEST_BOOL(DictionaryData.GetCount() <= 16 * 1024);
+
+    Dictionary.SetData(DictionaryData);
+    EZ_TEST_BOOL(!Dictionary.IsEmpty());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Compress and Uncompress")
+  {
+    for (const auto& sample : Samples)
+    {
+      ezMemoryStreamStorage StorageNoDict;
+      ezMemoryStreamStorage StorageDict;
+
+      {
+        ezMemoryStreamWriter MemoryWriter(&StorageNoDict);
+        ezCompressedStreamWriterZstd CompressedWriter(&MemoryWriter);
+        EZ_TEST_BOOL(CompressedWriter.WriteBytes(sample.GetData(), sample.GetCount()).Succeeded());
+        EZ_TEST_BOOL(CompressedWriter.FinishCompressedStream().Succeeded());
+      }
+
+      {
+        ezMemoryStreamWriter MemoryWriter(&StorageDict);
+        ezCompressedStreamWriterZstd CompressedWriter;
+        CompressedWriter.SetOutputStream(&MemoryWriter, ezCompressedStreamWriterZstd::Compression::Default, 4, &Dictionary);
+        EZ_TEST_BOOL(CompressedWriter.WriteBytes(sample.GetData(), sample.GetCount()).Succeeded());
+        EZ_TEST_BOOL(CompressedWriter.FinishCompressedStream().Succeeded());
+      }
+
+      EZ_TEST_BOOL(StorageDict.GetStorageSize() < StorageNoDict.GetStorageSize());
+
+      ezMemoryStreamReader MemoryReader(&StorageDict);
+      ezCompressedStreamReaderZstd CompressedReader;
+      CompressedReader.SetInputStream(&MemoryReader, &Dictionary);
+
+      ezDynamicArray<ezUInt8> Uncompressed;
+      Uncompressed.SetCount(sample.GetCount());
+      EZ_TEST_INT(CompressedReader.ReadBytes(Uncompressed.GetData(), Uncompressed.GetCount()), sample.GetCount());
+      EZ_TEST_BOOL(Uncompressed == sample);
+
+      ezUInt8 uiTemp = 0;
+      EZ_TEST_INT(CompressedReader.ReadBytes(&uiTemp, 1), 0);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Set Dictionary on same Stream")
+  {
+    const auto& sample = Samples[0];
+
+    ezUInt64 uiCompressedSizeWithDict = 0;
+
+    {
+      ezMemoryStreamStorage Storage;
+      ezMemoryStreamWriter MemoryWriter(&Storage);
+      ezCompressedStreamWriterZstd CompressedWriter;
+      CompressedWriter.SetOutputStream(&MemoryWriter, ezCompressedStreamWriterZstd::Compression::Default, 4, &Dictionary);
+      EZ_TEST_BOOL(CompressedWriter.WriteBytes(sample.GetData(), sample.GetCount()).Succeeded());
+      EZ_TEST_BOOL(CompressedWriter.FinishCompressedStream().Succeeded());
+
+      uiCompressedSizeWithDict = CompressedWriter.GetCompressedSize();
+    }
+
+    // setting the same output stream again must not ignore the new dictionary
+    ezMemoryStreamStorage Storage;
+    ezMemoryStreamWriter MemoryWriter(&Storage);
+    ezCompressedStreamWriterZstd CompressedWriter;
+    CompressedWriter.SetOutputStream(&MemoryWriter);
+    CompressedWriter.SetOutputStream(&MemoryWriter, ezCompressedStreamWriterZstd::Compression::Default, 4, &Dictionary);
+    EZ_TEST_BOOL(CompressedWriter.WriteBytes(sample.GetData(), sample.GetCount()).Succeeded());
+    EZ_TEST_BOOL(CompressedWriter.FinishCompressedStream().Succeeded());
+
+    EZ_TEST_INT(CompressedWriter.GetCompressedSize(), uiCompressedSizeWithDict);
+  }
+}
+
+EZ_CREATE_SIMPLE_TEST(IO, CompressedStreamZstdMultithreaded)
+{
+  ezDynamicArray<ezUInt32> TestData;
+  TestData.SetCountUninitialized(1024 * 512);
+
+  for (ezUInt32 i = 0; i < TestData.GetCount(); ++i)
+  {
+    TestData[i] = (i * 7) % 1023 + (i / 4096);
+  }
+
+  const ezUInt32 uiEndMarker = 0xABCD1234;
+
+  ezMemoryStreamStorage StreamStorage;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Compress Data")
+  {
+    ezMemoryStreamWriter MemoryWriter(&StreamStorage);
+
+    ezCompressedStreamWriterZstd CompressedWriter;
+    CompressedWriter.SetMultithreadedBlockSize(64);
+    CompressedWriter.SetOutputStream(&MemoryWriter);
+    EZ_TEST_INT(CompressedWriter.GetMultithreadedBlockSize(), 64);
+
+    ezUInt32 uiWrite = 1;
+    for (ezUInt32 i = 0; i < TestData.GetCount();)
+    {
+      uiWrite = ezMath::Min<ezUInt32>(uiWrite, TestData.GetCount() - i);
+
+      EZ_TEST_BOOL(CompressedWriter.WriteBytes(&TestData[i], sizeof(ezUInt32) * uiWrite).Succeeded());
+
+      // a flush in the middle produces one partially filled block
+      if (i < TestData.GetCount() / 2 && i + uiWrite >= TestData.GetCount() / 2)
+      {
+        EZ_TEST_BOOL(CompressedWriter.Flush().Succeeded());
+      }
+
+      i += uiWrite;
+      uiWrite += 1013;
+    }
+
+    EZ_TEST_BOOL(CompressedWriter.FinishCompressedStream().Succeeded());
+
+    EZ_TEST_INT(CompressedWriter.GetUncompressedSize(), TestData.GetCount() * sizeof(ezUInt32));
+    EZ_TEST_BOOL(CompressedWriter.GetWrittenBytes() > CompressedWriter.GetCompressedSize());
+    EZ_TEST_BOOL(CompressedWriter.GetCompressedSize() < CompressedWriter.GetUncompressedSize() / 4);
+
+    // data after the compressed stream
+    MemoryWriter << uiEndMarker;
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Uncompress Data")
+  {
+    ezMemoryStreamReader MemoryReader(&StreamStorage);
+    ezCompressedStreamReaderZstd CompressedReader(&MemoryReader);
+
+    ezDynamicArray<ezUInt32> TestDataRead = TestData;
+
+    bool bSkip = false;
+    ezUInt32 uiRead = 1;
+    for (ezUInt32 i = 0; i < TestData.GetCount();)
+    {
+      uiRead = ezMath::Min<ezUInt32>(uiRead, TestData.GetCount() - i);
+
+      if (bSkip)
+      {
+        EZ_TEST_INT(CompressedReader.SkipBytes(sizeof(ezUInt32) * uiRead), sizeof(ezUInt32) * uiRead);
+      }
+      else
+      {
+        ezMemoryUtils::ZeroFill(&TestDataRead[i], uiRead);
+        EZ_TEST_INT(CompressedReader.ReadBytes(&TestDataRead[i], sizeof(ezUInt32) * uiRead), sizeof(ezUInt32) * uiRead);
+      }
+
+      bSkip = !bSkip;
+      i += uiRead;
+      uiRead += 5003;
+    }
+
+    EZ_TEST_BOOL(TestData == TestDataRead);
+
+    ezUInt32 uiTemp = 0;
+    EZ_TEST_INT(CompressedReader.ReadBytes(&uiTemp, sizeof(ezUInt32)), 0);
+
+    // the zero-terminator has been consumed, the following data is readable
+    MemoryReader >> uiTemp;
+    EZ_TEST_INT(uiTemp, uiEndMarker);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Reuse Writer")
+  {
+    ezDynamicArray<ezUInt8> DictionaryData;
+    DictionaryData.PushBackRange(ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(TestData.GetData()), 8 * 1024));
+
+    ezCompressedStreamZstdDictionary Dictionary;
+    Dictionary.SetData(DictionaryData);
+
+    ezCompressedStreamWriterZstd CompressedWriter;
+    CompressedWriter.SetMultithreadedBlockSize(16);
+
+    for (ezUInt32 uiRun = 0; uiRun < 2; ++uiRun)
+    {
+      ezMemoryStreamStorage Storage;
+      ezMemoryStreamWriter MemoryWriter(&Storage);
+      CompressedWriter.SetOutputStream(&MemoryWriter, ezCompressedStreamWriterZstd::Compression::Fast, 4, &Dictionary);
+      EZ_TEST_BOOL(CompressedWriter.WriteBytes(TestData.GetData(), TestData.GetCount() * sizeof(ezUInt32)).Succeeded());
+      EZ_TEST_BOOL(CompressedWriter.FinishCompressedStream().Succeeded());
+
+      ezMemoryStreamReader MemoryReader(&Storage);
+      ezCompressedStreamReaderZstd CompressedReader;
+      CompressedReader.SetInputStream(&MemoryReader, &Dictionary);
+
+      ezDynamicArray<ezUInt32> TestDataRead;
+      TestDataRead.SetCount(TestData.GetCount());
+      EZ_TEST_INT(CompressedReader.ReadBytes(TestDataRead.GetData(), TestDataRead.GetCount() * sizeof(ezUInt32)), TestData.GetCount() * sizeof(ezUInt32));
+      EZ_TEST_BOOL(TestData == TestDataRead);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Corrupt Data")
+  {
+    ezTestLogInterface log;
+    ezTestLogSystemScope logSystemScope(&log);
+    log.ExpectMessage("Decompressing the stream failed", ezLogMsgType::ErrorMsg);
+    log.ExpectMessage("Decompressing a block of the zstd stream failed.", ezLogMsgType::ErrorMsg);
+    log.ExpectMessage("from the input stream failed.", ezLogMsgType::ErrorMsg, 2);
+
+    for (ezUInt32 uiBlockSizeKB : {0U, 64U})
+    {
+      ezMemoryStreamStorage Storage;
+      ezMemoryStreamWriter MemoryWriter(&Storage);
+
+      ezCompressedStreamWriterZstd CompressedWriter;
+      CompressedWriter.SetMultithreadedBlockSize(uiBlockSizeKB);
+      CompressedWriter.SetOutputStream(&MemoryWriter);
+      EZ_TEST_BOOL(CompressedWriter.WriteBytes(TestData.GetData(), TestData.GetCount() * sizeof(ezUInt32)).Succeeded());
+      EZ_TEST_BOOL(CompressedWriter.FinishCompressedStream().Succeeded());
+
+      // overwrite the magic number of the first zstd frame, which follows the chunk size and the block header
+      ezDynamicArray<ezUInt8> Corrupted;
+      Corrupted.PushBackRange(ezArrayPtr<const ezUInt8>(Storage.GetData(), Storage.GetStorageSize()));
+      ezMemoryUtils::ZeroFill(&Corrupted[sizeof(ezUInt16) + (uiBlockSizeKB > 0 ? 5 * sizeof(ezUInt32) : 0)], 4);
+
+      ezRawMemoryStreamReader MemoryReader(Corrupted);
+      ezCompressedStreamReaderZstd CompressedReader(&MemoryReader);
+
+      // the read fails instead of asserting
+      ezDynamicArray<ezUInt32> TestDataRead;
+      TestDataRead.SetCount(TestData.GetCount());
+      EZ_TEST_BOOL(CompressedReader.ReadBytes(TestDataRead.GetData(), TestDataRead.GetCount() * sizeof(ezUInt32)) < TestData.GetCount() * sizeof(ezUInt32));
+      EZ_TEST_INT(CompressedReader.ReadBytes(TestDataRead.GetData(), sizeof(ezUInt32)), 0);
+
+      // a truncated stream fails the read as well
+      ezRawMemoryStreamReader TruncatedReader(Storage.GetData(), Storage.GetStorageSize() / 2);
+      CompressedReader.SetInputStream(&TruncatedReader);
+      EZ_TEST_BOOL(CompressedReader.ReadBytes(TestDataRead.GetData(), TestDataRead.GetCount() * sizeof(ezUInt32)) < TestData.GetCount() * sizeof(ezUInt32));
+    }
+  }
+}
+
 #endif
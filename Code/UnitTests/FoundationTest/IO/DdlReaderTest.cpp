@@ -136,6 +136,33 @@ static void WriteToDDL(const ezOpenDdlReader& doc, ezStreamWriter& output)
   }
 }
 
+static void WriteToBinary(const ezOpenDdlReader& doc, ezStreamWriter& output)
+{
+  ezOpenDdlWriter writer;
+  writer.SetOutputStream(&output);
+  writer.SetBinaryMode(true);
+
+  for (auto pChild = doc.GetRootElement()->GetFirstChild(); pChild != nullptr; pChild = pChild->GetSibling())
+  {
+    WriteObjectToDDL(pChild, writer);
+  }
+}
+
+// hides that the wrapped stream can be rewound, so the parser can't read ahead
+class ForwardingStreamReader : public ezStreamReader
+{
+public:
+  ForwardingStreamReader(ezStreamReader& inner)
+    : m_Inner(inner)
+  {
+  }
+
+  virtual ezUInt64 ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead) override { return m_Inner.ReadBytes(pReadBuffer, uiBytesToRead); }
+
+private:
+  ezStreamReader& m_Inner;
+};
+
 static void WriteToString(const ezOpenDdlReader& doc, ezStringBuilder& string)
 {
   ezMemoryStreamStorage storage;
@@ -294,6 +321,135 @@ unsigned_int64{0,100002111,300040222,560000003333,70000844444,1000009555555,1000
     EZ_TEST_BOOL(!doc.HadFatalParsingError());
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Binary")
+  {
+    const char* szTestData = "\
+bool{true,false,true,true,false}\n\
+string{\"s1\",\"\\n\\t\\r\",\"\"}\n\
+float{0,1.1,-3,23.42}\n\
+double{0,1.1,-3,23.42}\n\
+int8{0,12,34,56,78,109,127,-14,-56,-127}\n\
+int16{0,102,3040,5600,7008,109,10207,-1004,-5060,-10207}\n\
+int64{0,100002111,300040222,560000003333,70000844444,1000009555555,100000207666666,-1000000047777777,-50600000008888888,-102070000099999}\n\
+unsigned_int32{0,100002,300040,56000000,700008,1000009,100000207,100000004,2000001000,1020700000}\n\
+Node\n\
+{\n\
+	Empty{}\n\
+	float %MyFloats{1.2,3,40,0.5,60}\n\
+	double $MyDoubles{1.2,3,40,0.5,60}\n\
+	Properties\n\
+	{\n\
+		Property $MyProperty\n\
+		{\n\
+			string{\"Color\"}\n\
+		}\n\
+	}\n\
+}\n\
+";
+
+    ezMemoryStreamStorage storage;
+
+    {
+      StringStream stream(szTestData);
+
+      ezOpenDdlReader doc;
+      EZ_TEST_BOOL(doc.ParseDocument(stream).Succeeded());
+
+      ezMemoryStreamWriter output(&storage);
+      WriteToBinary(doc, output);
+    }
+
+    EZ_TEST_BOOL(storage.GetStorageSize() > sizeof(ezOpenDdlBinary::s_Header));
+    EZ_TEST_BOOL(ezMemoryUtils::IsEqual(storage.GetData(), ezOpenDdlBinary::s_Header, sizeof(ezOpenDdlBinary::s_Header)));
+
+    {
+      ezMemoryStreamReader stream(&storage);
+
+      ezOpenDdlReader doc;
+      EZ_TEST_BOOL(doc.ParseDocument(stream).Succeeded());
+      EZ_TEST_BOOL(!doc.HadFatalParsingError());
+
+      EZ_TEST_BOOL(doc.FindElement("MyDoubles") != nullptr);
+      EZ_TEST_BOOL(doc.FindElement("MyProperty") != nullptr);
+      EZ_TEST_BOOL(doc.FindElement("MyFloats") == nullptr);
+
+      TestDoc(doc, szTestData);
+    }
+
+    // truncated documents must fail gracefully
+    {
+      ezMemoryStreamStorage truncated;
+      ezMemoryStreamWriter writer(&truncated);
+      writer.WriteBytes(storage.GetData(), storage.GetStorageSize() - 4).IgnoreResult();
+
+      ezMemoryStreamReader stream(&truncated);
+
+      ezTestLogInterface log;
+      ezTestLogSystemScope logSystemScope(&log);
+      log.ExpectMessage("End of the document reached without closing all objects.", ezLogMsgType::ErrorMsg);
+
+      ezOpenDdlReader doc;
+      EZ_TEST_BOOL(doc.ParseDocument(stream).Failed());
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Embedded Documents")
+  {
+    const char* szTestData = "\
+Node $MyNode\n\
+{\n\
+	float{1.2,3,40}\n\
+	string{\"text\"}\n\
+}\n\
+";
+
+    StringStream sourceStream(szTestData);
+    ezOpenDdlReader source;
+    EZ_TEST_BOOL(source.ParseDocument(sourceStream).Succeeded());
+
+    const ezUInt32 uiTrailer = 0x12345678;
+
+    for (ezUInt32 uiBinary = 0; uiBinary < 2; ++uiBinary)
+    {
+      // the document is followed by a terminating zero byte and more data that must not be consumed by the parser
+      ezMemoryStreamStorage storage;
+      ezMemoryStreamWriter output(&storage);
+
+      if (uiBinary == 1)
+        WriteToBinary(source, output);
+      else
+        WriteToDDL(source, output);
+
+      output << static_cast<ezUInt8>(0);
+      output << uiTrailer;
+
+      {
+        ezMemoryStreamReader stream(&storage);
+
+        ezOpenDdlReader doc;
+        EZ_TEST_BOOL(doc.ParseDocument(stream).Succeeded());
+        EZ_TEST_BOOL(doc.FindElement("MyNode") != nullptr);
+
+        ezUInt32 uiRead = 0;
+        stream >> uiRead;
+        EZ_TEST_INT(uiRead, uiTrailer);
+      }
+
+      {
+        ezMemoryStreamReader memoryStream(&storage);
+        ForwardingStreamReader stream(memoryStream);
+
+        ezOpenDdlReader doc;
+        EZ_TEST_BOOL(doc.ParseDocument(stream).Succeeded());
+        EZ_TEST_BOOL(doc.FindElement("MyNode") != nullptr);
+
+        ezUInt32 uiRead = 0;
+        stream >> uiRead;
+        EZ_TEST_INT(uiRead, uiTrailer);
+      }
+    }
+  }
+
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "Errors")
   {
     const char* szTestData = "\
@@ -291,6 +291,60 @@ Only concrete and clocks.\n\
     ezFileSystem::DeleteFile(":output2/FileSystemTest2.txt");
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "File Index")
+  {
+    ezDataDirectory::FolderType::s_bUseFileIndex = true;
+    EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sOutputFolder2, "Index", "index", ezFileSystem::AllowWrites) == EZ_SUCCESS);
+    ezDataDirectory::FolderType::s_bUseFileIndex = false;
+
+    // a second data directory for the same folder, writes through it have to update the first one as well
+    EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sOutputFolder2, "Index", "index2", ezFileSystem::AllowWrites) == EZ_SUCCESS);
+
+    ezDataDirectory::FolderType* pDataDir = static_cast<ezDataDirectory::FolderType*>(ezFileSystem::FindDataDirectoryWithRoot("index"));
+    EZ_TEST_BOOL(pDataDir != nullptr);
+    EZ_TEST_BOOL(pDataDir->HasFileIndex() != pDataDir->HasMissingFileCache());
+    pDataDir->ResetLookupStats();
+
+    EZ_TEST_BOOL(!ezFileSystem::ExistsFile(":index/FileIndexTest.txt"));
+    EZ_TEST_BOOL(!ezFileSystem::ExistsFile(":index/FileIndexTest.txt"));
+
+    {
+      ezFileWriter FileOut;
+      EZ_TEST_BOOL(FileOut.Open(":index/FileIndexTest.txt") == EZ_SUCCESS);
+    }
+
+    EZ_TEST_BOOL(ezFileSystem::ExistsFile(":index/FileIndexTest.txt"));
+    ezFileSystem::DeleteFile(":index/FileIndexTest.txt");
+    EZ_TEST_BOOL(!ezFileSystem::ExistsFile(":index/FileIndexTest.txt"));
+    EZ_TEST_BOOL(!ezFileSystem::ExistsFile(":index/FileIndexTest.txt"));
+
+    {
+      ezFileWriter FileOut;
+      EZ_TEST_BOOL(FileOut.Open(":index2/FileIndexTest.txt") == EZ_SUCCESS);
+    }
+
+    EZ_TEST_BOOL(ezFileSystem::ExistsFile(":index/FileIndexTest.txt"));
+    ezFileSystem::DeleteFile(":index2/FileIndexTest.txt");
+
+    const ezDataDirectoryType::LookupStats& stats = pDataDir->GetLookupStats();
+
+    if (pDataDir->HasFileIndex())
+    {
+      EZ_TEST_INT(stats.m_uiFound, 2);
+      EZ_TEST_INT(stats.m_uiNotFound, 4);
+      EZ_TEST_INT(stats.m_uiUncached, 0);
+    }
+    else
+    {
+      // only the repeated lookups of the missing file are answered from the cache
+      EZ_TEST_INT(stats.m_uiFound, 0);
+      EZ_TEST_INT(stats.m_uiNotFound, 2);
+      EZ_TEST_INT(stats.m_uiUncached, 4);
+    }
+
+    EZ_TEST_INT(ezFileSystem::RemoveDataDirectoryGroup("Index"), 2);
+  }
+
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindFolderWithSubPath")
   {
     EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(szOutputFolder, "remove", "toplevel", ezFileSystem::AllowWrites) == EZ_SUCCESS);
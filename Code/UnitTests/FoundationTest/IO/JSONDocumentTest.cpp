@@ -0,0 +1,227 @@
+#include <FoundationTestPCH.h>
+
+// NOTE: always save as Unicode UTF-8 with signature
+
+#include <Foundation/IO/JSONDocument.h>
+#include <Foundation/IO/MemoryStream.h>
+#include <TestFramework/Utilities/TestLogInterface.h>
+
+namespace JSONDocumentTestDetail
+{
+  class SaxRecorder : public ezJSONSaxHandler
+  {
+  public:
+    virtual void OnBeginObject(const ezStringView& sName) override { Add(sName, "{"); }
+    virtual void OnEndObject() override { m_sResult.Append("} "); }
+    virtual void OnBeginArray(const ezStringView& sName) override { Add(sName, "["); }
+    virtual void OnEndArray() override { m_sResult.Append("] "); }
+    virtual void OnString(const ezStringView& sName, const ezStringView& sValue) override
+    {
+      ezStringBuilder sTemp;
+      sTemp.Append("'", sValue.GetStartPointer(), "'");
+      Add(sName, sTemp.GetData());
+    }
+    virtual void OnNumber(const ezStringView& sName, double fValue) override
+    {
+      ezStringBuilder sTemp;
+      sTemp.Format("{0}", (ezInt32)fValue);
+      Add(sName, sTemp.GetData());
+    }
+    virtual void OnBool(const ezStringView& sName, bool bValue) override { Add(sName, bValue ? "true" : "false"); }
+    virtual void OnNull(const ezStringView& sName) override { Add(sName, "null"); }
+
+    void Add(const ezStringView& sName, const char* szValue)
+    {
+      if (sName.GetElementCount() > 0)
+      {
+        m_sResult.Append(sName);
+        m_sResult.Append("=");
+      }
+
+      m_sResult.Append(szValue, " ");
+    }
+
+    ezStringBuilder m_sResult;
+  };
+
+  static ezDynamicArray<char> ToBuffer(const char* szText)
+  {
+    ezDynamicArray<char> text;
+    text.PushBackRange(ezArrayPtr<const char>(szText, ezStringUtils::GetStringElementCount(szText)));
+    return text;
+  }
+} // namespace JSONDocumentTestDetail
+
+EZ_CREATE_SIMPLE_TEST(IO, JSONDocument)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "DOM")
+  {
+    const char* szTestData = "{\n\
+  \"name\" : \"test\", // comment\n\
+  \"number\" : -1.5e2,\n\
+  /* block\n comment */\n\
+  \"array\" : [ 1, true, false, null, [], {} ],\n\
+  \"object\" : { \"inner\" : { \"a\" : 1 }, \"b\" : 2 },\n\
+  \"last\" : 3\n\
+}";
+
+    ezMemoryStreamStorage storage;
+    ezMemoryStreamWriter writer(&storage);
+    writer.WriteBytes(szTestData, ezStringUtils::GetStringElementCount(szTestData)).IgnoreResult();
+    ezMemoryStreamReader reader(&storage);
+
+    ezJSONDocument doc;
+    EZ_TEST_BOOL(doc.Parse(reader).Succeeded());
+    EZ_TEST_INT(doc.GetNumValues(), 15);
+
+    const ezJSONDocument::Value root = doc.GetRoot();
+    EZ_TEST_BOOL(root.IsValid());
+    EZ_TEST_BOOL(root.GetType() == ezJSONDocument::Type::Object);
+    EZ_TEST_INT(root.GetCount(), 5);
+    EZ_TEST_BOOL(!root.GetNextSibling().IsValid());
+
+    EZ_TEST_BOOL(root.FindMember("name").GetString().IsEqual("test"));
+    EZ_TEST_STRING(root.FindMember("name").GetString().GetStartPointer(), "test");
+    EZ_TEST_DOUBLE(root.FindMember("number").GetNumber(), -150.0, 0.0);
+    EZ_TEST_DOUBLE(root.FindMember("last").GetNumber(), 3.0, 0.0);
+    EZ_TEST_BOOL(!root.FindMember("missing").IsValid());
+
+    const ezJSONDocument::Value array = root.FindMember("array");
+    EZ_TEST_BOOL(array.GetType() == ezJSONDocument::Type::Array);
+    EZ_TEST_INT(array.GetCount(), 6);
+    EZ_TEST_DOUBLE(array[0].GetNumber(), 1.0, 0.0);
+    EZ_TEST_BOOL(array[1].GetBool());
+    EZ_TEST_BOOL(!array[2].GetBool());
+    EZ_TEST_BOOL(array[3].GetType() == ezJSONDocument::Type::Null);
+    EZ_TEST_BOOL(array[4].GetType() == ezJSONDocument::Type::Array);
+    EZ_TEST_INT(array[4].GetCount(), 0);
+    EZ_TEST_BOOL(!array[4].GetFirstChild().IsValid());
+    EZ_TEST_BOOL(array[5].GetType() == ezJSONDocument::Type::Object);
+    EZ_TEST_BOOL(!array[5].GetNextSibling().IsValid());
+
+    // siblings skip over nested values and end at the end of the parent
+    const ezJSONDocument::Value object = root.FindMember("object");
+    ezJSONDocument::Value child = object.GetFirstChild();
+    EZ_TEST_BOOL(child.GetName().IsEqual("inner"));
+    child = child.GetNextSibling();
+    EZ_TEST_BOOL(child.GetName().IsEqual("b"));
+    EZ_TEST_BOOL(!child.GetNextSibling().IsValid());
+    EZ_TEST_DOUBLE(object.FindMember("inner").FindMember("a").GetNumber(), 1.0, 0.0);
+
+    ezUInt32 uiNumMembers = 0;
+    for (ezJSONDocument::Value member = root.GetFirstChild(); member.IsValid(); member = member.GetNextSibling())
+      ++uiNumMembers;
+    EZ_TEST_INT(uiNumMembers, 5);
+
+    ezVariant var;
+    root.ToVariant(var);
+    const ezVariantDictionary& dict = var.Get<ezVariantDictionary>();
+    EZ_TEST_INT(dict.GetCount(), 5);
+    EZ_TEST_STRING(dict.GetValue("name")->Get<ezString>().GetData(), "test");
+    EZ_TEST_INT(dict.GetValue("array")->Get<ezVariantArray>().GetCount(), 6);
+    EZ_TEST_BOOL(!dict.GetValue("array")->Get<ezVariantArray>()[3].IsValid());
+    EZ_TEST_DOUBLE(dict.GetValue("object")->Get<ezVariantDictionary>().GetValue("b")->Get<double>(), 2.0, 0.0);
+
+    doc.Clear();
+    EZ_TEST_BOOL(!doc.GetRoot().IsValid());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Top-Level Values")
+  {
+    ezJSONDocument doc;
+
+    auto text = JSONDocumentTestDetail::ToBuffer("");
+    EZ_TEST_BOOL(doc.ParseInSitu(text).Succeeded());
+    EZ_TEST_BOOL(!doc.GetRoot().IsValid());
+
+    text = JSONDocumentTestDetail::ToBuffer(" [1,2,3] ");
+    EZ_TEST_BOOL(doc.ParseInSitu(text).Succeeded());
+    EZ_TEST_INT(doc.GetRoot().GetCount(), 3);
+
+    text = JSONDocumentTestDetail::ToBuffer("42");
+    EZ_TEST_BOOL(doc.ParseInSitu(text).Succeeded());
+    EZ_TEST_DOUBLE(doc.GetRoot().GetNumber(), 42.0, 0.0);
+
+    text = JSONDocumentTestDetail::ToBuffer("\"str\"");
+    EZ_TEST_BOOL(doc.ParseInSitu(text).Succeeded());
+    EZ_TEST_BOOL(doc.GetRoot().GetString().IsEqual("str"));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Escape Sequences")
+  {
+    ezJSONDocument doc;
+
+    auto text = JSONDocumentTestDetail::ToBuffer("[\"a\\\"b\\\\c\\/d\", \"\\r\\f\\n\\b\\t\", \"\\u00e4\\u20AC\", \"\\ud83d\\ude00\", \"plain\"]");
+    EZ_TEST_BOOL(doc.ParseInSitu(text).Succeeded());
+
+    const ezJSONDocument::Value root = doc.GetRoot();
+    EZ_TEST_STRING(root[0].GetString().GetStartPointer(), "a\"b\\c/d");
+    EZ_TEST_STRING(root[1].GetString().GetStartPointer(), "\r\f\n\b\t");
+    EZ_TEST_STRING(root[2].GetString().GetStartPointer(), ezStringUtf8(L"ä€").GetData());
+    EZ_TEST_STRING(root[3].GetString().GetStartPointer(), "\xF0\x9F\x98\x80");
+    EZ_TEST_STRING(root[4].GetString().GetStartPointer(), "plain");
+
+    // strings point into the parsed text
+    EZ_TEST_BOOL(root[4].GetString().GetStartPointer() >= text.GetData());
+    EZ_TEST_BOOL(root[4].GetString().GetEndPointer() <= text.GetData() + text.GetCount());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "SAX")
+  {
+    auto text = JSONDocumentTestDetail::ToBuffer("{ \"a\" : [1, \"x\", null], \"b\" : { \"c\" : true }, \"d\" : false }");
+
+    JSONDocumentTestDetail::SaxRecorder recorder;
+
+    ezJSONDocument doc;
+    EZ_TEST_BOOL(doc.ParseSax(text, recorder).Succeeded());
+    EZ_TEST_STRING(recorder.m_sResult.GetData(), "{ a=[ 1 'x' null ] b={ c=true } d=false } ");
+    EZ_TEST_BOOL(!doc.GetRoot().IsValid());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Errors")
+  {
+    ezTestLogInterface log;
+
+    log.ExpectMessage("Line 3 (4): Expected ':' to separate the member name and value.", ezLogMsgType::ErrorMsg);
+    log.ExpectMessage("Line 12 (0): Expected ',' or '}' after an object member.", ezLogMsgType::ErrorMsg);
+    log.ExpectMessage("Line 1 (1): Reached the end of the document before the end of a string.", ezLogMsgType::ErrorMsg);
+    log.ExpectMessage("Line 1 (4): Reached the end of the document before the end of a comment.", ezLogMsgType::ErrorMsg);
+    log.ExpectMessage("Line 1 (1): Expected 'true', 'false' or 'null'.", ezLogMsgType::ErrorMsg);
+    log.ExpectMessage("Line 1 (1): Invalid number.", ezLogMsgType::ErrorMsg);
+    log.ExpectMessage("Line 1 (3): Unexpected content after the end of the document.", ezLogMsgType::ErrorMsg);
+    log.ExpectMessage("Line 1 (1): Unknown escape sequence.", ezLogMsgType::ErrorMsg);
+    log.ExpectMessage("Line 1 (6): Expected a value, but reached the end of the document.", ezLogMsgType::ErrorMsg);
+
+    ezJSONDocument doc;
+    doc.SetLogInterface(&log);
+
+    auto text = JSONDocumentTestDetail::ToBuffer("{\n\"a\" : 1,\n\"b\" 2 }");
+    EZ_TEST_BOOL(doc.ParseInSitu(text).Failed());
+    EZ_TEST_BOOL(!doc.GetRoot().IsValid());
+
+    // the line offset is added to all line numbers
+    text = JSONDocumentTestDetail::ToBuffer("{\n\"a\" : 1\n\"b\" : 2 }");
+    EZ_TEST_BOOL(doc.ParseInSitu(text, 9).Failed());
+
+    text = JSONDocumentTestDetail::ToBuffer("[\"abc]");
+    EZ_TEST_BOOL(doc.ParseInSitu(text).Failed());
+
+    text = JSONDocumentTestDetail::ToBuffer("[1, /* 2]");
+    EZ_TEST_BOOL(doc.ParseInSitu(text).Failed());
+
+    text = JSONDocumentTestDetail::ToBuffer("[trueish]");
+    EZ_TEST_BOOL(doc.ParseInSitu(text).Failed());
+
+    text = JSONDocumentTestDetail::ToBuffer("[1.2.3]");
+    EZ_TEST_BOOL(doc.ParseInSitu(text).Failed());
+
+    text = JSONDocumentTestDetail::ToBuffer("{} {}");
+    EZ_TEST_BOOL(doc.ParseInSitu(text).Failed());
+
+    text = JSONDocumentTestDetail::ToBuffer("[\"\\q\"]");
+    EZ_TEST_BOOL(doc.ParseInSitu(text).Failed());
+
+    text = JSONDocumentTestDetail::ToBuffer("[1, 2,");
+    EZ_TEST_BOOL(doc.ParseInSitu(text).Failed());
+  }
+}
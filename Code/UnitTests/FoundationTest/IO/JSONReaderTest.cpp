@@ -4,6 +4,7 @@
 
 #include <Foundation/Containers/Deque.h>
 #include <Foundation/IO/JSONReader.h>
+#include <TestFramework/Utilities/TestLogInterface.h>
 
 namespace JSONReaderTestDetail
 {
@@ -466,4 +467,59 @@ EZ_CREATE_SIMPLE_TEST(IO, JSONReader)
 
     EZ_TEST_BOOL(sCompare.IsEmpty());
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Document Parser")
+  {
+    ezStringUtf8 sTD(L"{\n\
+\"myarray\" : [1, 2.2, 3.3, false, \"ende\", null, [] ],\n\
+\"String\"/**/ : \"testvälue\",\n\
+\"double\"/***/ : -43.56e2,//comment\n\
+\"bool\" : true,\n\
+\"MyNüll\" : null,\n\
+\"object\" : /* comment */\n\
+{\n\
+  \"variable in object\" : \"bla\\\\\\\"\\/\\u00e4\",\n\
+  \"Subobject\" : { \"array in sub\" : [ { \"obj var\" : 234 }, {}, true, 4, false ] }\n\
+}\n\
+}");
+
+    ezJSONReader reader;
+    {
+      JSONReaderTestDetail::StringStream stream(sTD.GetData());
+      EZ_TEST_BOOL(reader.Parse(stream).Succeeded());
+    }
+
+    ezJSONReader docReader;
+    docReader.SetUseDocumentParser(true);
+    {
+      JSONReaderTestDetail::StringStream stream(sTD.GetData());
+      EZ_TEST_BOOL(docReader.Parse(stream).Succeeded());
+    }
+
+    EZ_TEST_INT(docReader.GetTopLevelObject().GetCount(), 6);
+    EZ_TEST_BOOL(reader.GetTopLevelObject() == docReader.GetTopLevelObject());
+
+    {
+      JSONReaderTestDetail::StringStream stream("");
+      EZ_TEST_BOOL(docReader.Parse(stream).Succeeded());
+      EZ_TEST_BOOL(docReader.GetTopLevelObject().IsEmpty());
+    }
+
+    ezTestLogInterface log;
+    docReader.SetLogInterface(&log);
+
+    log.ExpectMessage("Line 1 (14): Expected ',' or ']' after an array element.", ezLogMsgType::ErrorMsg);
+    log.ExpectMessage("Line 1 (0): The top-level value of the document must be an object.", ezLogMsgType::ErrorMsg);
+
+    {
+      JSONReaderTestDetail::StringStream stream("{ \"a\" : [1, 2 }");
+      EZ_TEST_BOOL(docReader.Parse(stream).Failed());
+      EZ_TEST_BOOL(docReader.GetTopLevelObject().IsEmpty());
+    }
+
+    {
+      JSONReaderTestDetail::StringStream stream("[1, 2]");
+      EZ_TEST_BOOL(docReader.Parse(stream).Failed());
+    }
+  }
 }
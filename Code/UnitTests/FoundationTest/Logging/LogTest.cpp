@@ -7,6 +7,7 @@
 #include <Foundation/Logging/Log.h>
 #include <Foundation/Logging/VisualStudioWriter.h>
 #include <Foundation/Threading/Thread.h>
+#include <Foundation/Threading/ThreadSignal.h>
 #include <TestFramework/Utilities/TestLogInterface.h>
 
 EZ_CREATE_SIMPLE_TEST_GROUP(Logging);
@@ -254,3 +255,188 @@ EZ_CREATE_SIMPLE_TEST(Logging, GlobalTestLog)
     }
   }
 }
+
+EZ_CREATE_SIMPLE_TEST(Logging, AsyncLog)
+{
+  struct AsyncLogReceiver
+  {
+    void LogEventHandler(const ezLoggingEventData& le)
+    {
+      if (le.m_EventType == ezLogMsgType::Flush)
+        return;
+
+      if (ezStringUtils::IsEqual(le.m_szTag, "AsyncLog"))
+      {
+        m_uiDropReports++;
+        return;
+      }
+
+      if (!ezStringUtils::IsEqual(le.m_szTag, "AsyncTest"))
+        return;
+
+      if (m_bBlock)
+      {
+        m_bBlock = false;
+        m_Unblock.WaitForSignal();
+      }
+
+      EZ_LOCK(m_Mutex);
+      m_Messages.PushBack(le.m_szText);
+      m_uiGroupEvents += (le.m_EventType == ezLogMsgType::BeginGroup || le.m_EventType == ezLogMsgType::EndGroup) ? 1 : 0;
+      m_uiWarnings += (le.m_EventType == ezLogMsgType::WarningMsg) ? 1 : 0;
+    }
+
+    ezMutex m_Mutex;
+    ezDynamicArray<ezString> m_Messages;
+    ezUInt32 m_uiGroupEvents = 0;
+    ezUInt32 m_uiWarnings = 0;
+    ezUInt32 m_uiDropReports = 0;
+    volatile bool m_bBlock = false;
+    ezThreadSignal m_Unblock;
+  };
+
+  ezLog::GetThreadLocalLogSystem()->SetLogLevel(ezLogMsgType::All);
+
+  // the test framework may already use the async mode, start with a fresh queue
+  const bool bWasAsync = ezGlobalLog::IsAsyncModeEnabled();
+  ezGlobalLog::DisableAsyncMode();
+
+  AsyncLogReceiver receiver;
+  ezEventSubscriptionID writerID = ezGlobalLog::AddLogWriter(ezMakeDelegate(&AsyncLogReceiver::LogEventHandler, &receiver));
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Order and completeness")
+  {
+    ezAsyncLogSettings settings;
+    settings.m_uiQueueCapacity = 64;
+    ezGlobalLog::EnableAsyncMode(settings);
+    EZ_TEST_BOOL(ezGlobalLog::IsAsyncModeEnabled());
+
+    constexpr ezUInt32 uiNumThreads = 4;
+    constexpr ezUInt32 uiNumMessages = 25;
+
+    class AsyncLogThread : public ezThread
+    {
+    public:
+      virtual ezUInt32 Run() override
+      {
+        for (ezUInt32 i = 0; i < uiNumMessages; ++i)
+        {
+          // the text is formatted from temporaries, which must not be referenced anymore when the writer thread handles the event
+          ezStringBuilder sTemp;
+          sTemp.Format("{0}:{1}", m_uiIndex, i);
+          ezLog::Info("[AsyncTest]{0}", sTemp);
+        }
+        return 0;
+      }
+
+      ezUInt32 m_uiIndex = 0;
+    };
+
+    AsyncLogThread threads[uiNumThreads];
+    for (ezUInt32 t = 0; t < uiNumThreads; ++t)
+    {
+      threads[t].m_uiIndex = t;
+      threads[t].Start();
+    }
+
+    for (ezUInt32 t = 0; t < uiNumThreads; ++t)
+    {
+      threads[t].Join();
+    }
+
+    EZ_TEST_BOOL(ezGlobalLog::FlushAsyncQueue());
+
+    {
+      EZ_LOCK(receiver.m_Mutex);
+      EZ_TEST_INT(receiver.m_Messages.GetCount(), uiNumThreads * uiNumMessages);
+
+      // the messages of each thread must arrive in the order in which they were logged
+      ezUInt32 uiNextMessage[uiNumThreads] = {};
+      for (const ezString& sMsg : receiver.m_Messages)
+      {
+        ezUInt32 uiThread = 0, uiMessage = 0;
+        ezStringBuilder sParse = sMsg;
+        const char* szColon = sParse.FindSubString(":");
+        if (!EZ_TEST_BOOL(szColon != nullptr))
+          break;
+
+        EZ_TEST_BOOL(ezConversionUtils::StringToUInt(sParse.GetData(), uiThread).Succeeded());
+        EZ_TEST_BOOL(ezConversionUtils::StringToUInt(szColon + 1, uiMessage).Succeeded());
+        if (!EZ_TEST_BOOL(uiThread < uiNumThreads))
+          break;
+
+        EZ_TEST_INT(uiMessage, uiNextMessage[uiThread]);
+        uiNextMessage[uiThread] = uiMessage + 1;
+      }
+
+      receiver.m_Messages.Clear();
+    }
+
+    ezGlobalLog::DisableAsyncMode();
+    EZ_TEST_BOOL(!ezGlobalLog::IsAsyncModeEnabled());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "DropLowPriority")
+  {
+    ezAsyncLogSettings settings;
+    settings.m_uiQueueCapacity = 8;
+    settings.m_OverflowPolicy = ezAsyncLogOverflowPolicy::DropLowPriority;
+    ezGlobalLog::EnableAsyncMode(settings);
+
+    // stall the writer thread on the first message, so that the queue fills up
+    receiver.m_bBlock = true;
+    ezLog::Info("[AsyncTest]block");
+
+    for (ezUInt32 i = 0; i < 100; ++i)
+    {
+      ezLog::Warning("[AsyncTest]warning {0}", i);
+    }
+
+    EZ_TEST_BOOL(ezGlobalLog::GetDroppedAsyncMessageCount() > 0);
+
+    receiver.m_Unblock.RaiseSignal();
+
+    // errors, serious warnings and group events are never dropped, they wait for space in the queue instead
+    // (errors and serious warnings would fail the test, so check this with groups)
+    for (ezUInt32 i = 0; i < 10; ++i)
+    {
+      ezLog::BroadcastLoggingEvent(ezLog::GetThreadLocalLogSystem(), ezLogMsgType::BeginGroup, "[AsyncTest]group");
+      ezLog::BroadcastLoggingEvent(ezLog::GetThreadLocalLogSystem(), ezLogMsgType::EndGroup, "[AsyncTest]group");
+    }
+
+    EZ_TEST_BOOL(ezGlobalLog::FlushAsyncQueue());
+
+    {
+      EZ_LOCK(receiver.m_Mutex);
+
+      EZ_TEST_INT(receiver.m_uiGroupEvents, 20);
+      EZ_TEST_INT(receiver.m_uiWarnings + ezGlobalLog::GetDroppedAsyncMessageCount(), 100);
+      EZ_TEST_BOOL(receiver.m_uiDropReports >= 1);
+    }
+
+    ezGlobalLog::DisableAsyncMode();
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "DisableAsyncMode delivers everything")
+  {
+    receiver.m_Messages.Clear();
+
+    ezGlobalLog::EnableAsyncMode();
+
+    for (ezUInt32 i = 0; i < 10; ++i)
+    {
+      ezLog::Info("[AsyncTest]{0}", i);
+    }
+
+    ezGlobalLog::DisableAsyncMode();
+
+    EZ_TEST_INT(receiver.m_Messages.GetCount(), 10);
+  }
+
+  ezGlobalLog::RemoveLogWriter(writerID);
+
+  if (bWasAsync)
+  {
+    ezGlobalLog::EnableAsyncMode();
+  }
+}
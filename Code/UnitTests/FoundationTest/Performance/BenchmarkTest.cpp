@@ -0,0 +1,95 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/Strings/StringBuilder.h>
+
+EZ_CREATE_SIMPLE_TEST(Performance, BenchmarkHarness)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ComputeStatistics")
+  {
+    std::vector<double> samples = {9.0, 2.0, 4.0, 4.0, 4.0, 5.0, 5.0, 7.0};
+
+    ezBenchmarkResult result;
+    result.ComputeStatistics(samples);
+
+    EZ_TEST_INT(result.m_uiNumSamples, 8);
+    EZ_TEST_DOUBLE(result.m_fMinNs, 2.0, 0.0);
+    EZ_TEST_DOUBLE(result.m_fMedianNs, 4.5, 0.0);
+    EZ_TEST_DOUBLE(result.m_fPercentile95Ns, 9.0, 0.0);
+    EZ_TEST_DOUBLE(result.m_fMeanNs, 5.0, 0.0);
+    EZ_TEST_DOUBLE(result.m_fStdDevNs, ezMath::Sqrt(32.0 / 7.0), 0.0001);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Measure")
+  {
+    static ezUInt64 s_uiNumIterations = 0;
+    s_uiNumIterations = 0;
+
+    ezBenchmarkResult result = ezBenchmark::Measure(
+      "AllocatingBenchmark",
+      [](ezBenchmark& benchmark) {
+        while (benchmark.KeepRunning())
+        {
+          ezDynamicArray<ezUInt32> values;
+          values.PushBack(static_cast<ezUInt32>(s_uiNumIterations));
+          ++s_uiNumIterations;
+        }
+      },
+      5, ezTime::Milliseconds(1), ezTime::Milliseconds(0.1));
+
+    EZ_TEST_STRING(result.m_sName.c_str(), "AllocatingBenchmark");
+    EZ_TEST_INT(result.m_uiNumSamples, 5);
+    EZ_TEST_BOOL(result.m_uiIterationsPerSample > 1);
+    EZ_TEST_BOOL(s_uiNumIterations >= 6 * result.m_uiIterationsPerSample);
+    EZ_TEST_BOOL(result.m_fMinNs > 0.0);
+    EZ_TEST_BOOL(result.m_fMinNs <= result.m_fMedianNs);
+    EZ_TEST_BOOL(result.m_fMedianNs <= result.m_fPercentile95Ns);
+    EZ_TEST_DOUBLE(result.m_fAllocationsPerIteration, 1.0, 0.0);
+    EZ_TEST_BOOL(result.m_fAllocatedBytesPerIteration >= sizeof(ezUInt32));
+
+    EZ_TEST_BOOL(!ezAllocatorBase::IsThreadAllocationCountingEnabled());
+  }
+}
+
+EZ_CREATE_BENCHMARK(Performance, DynamicArrayPushBack)
+{
+  ezDynamicArray<ezUInt32> values;
+  ezUInt32 uiValue = 0;
+
+  while (benchmark.KeepRunning())
+  {
+    values.PushBack(uiValue++);
+
+    if (values.GetCount() == 1024)
+      values.Clear();
+  }
+}
+
+EZ_CREATE_BENCHMARK(Performance, HashTableInsert)
+{
+  ezHashTable<ezUInt32, ezUInt32> table;
+  ezUInt32 uiKey = 0;
+
+  while (benchmark.KeepRunning())
+  {
+    table.Insert(uiKey * 2654435761u, uiKey);
+
+    if (++uiKey == 1024)
+    {
+      table.Clear();
+      uiKey = 0;
+    }
+  }
+}
+
+EZ_CREATE_BENCHMARK(Performance, StringBuilderFormat)
+{
+  ezStringBuilder sText;
+  ezUInt32 uiValue = 0;
+
+  while (benchmark.KeepRunning())
+  {
+    sText.Format("Value {0} of {1}", uiValue++, 1.5f);
+  }
+}
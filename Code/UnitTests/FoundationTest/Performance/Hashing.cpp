@@ -0,0 +1,115 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Algorithm/HashStream.h>
+#include <Foundation/Algorithm/HashingUtils.h>
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Time/Time.h>
+
+namespace
+{
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+  constexpr ezUInt32 s_uiHashedBytesPerSize = 1024 * 1024 * 4;
+#else
+  constexpr ezUInt32 s_uiHashedBytesPerSize = 1024 * 1024 * 64;
+#endif
+
+  template <typename HashFunc>
+  void MeasureHashThroughput(const char* szName, const ezDynamicArray<ezUInt8>& data, ezUInt32 uiSize, HashFunc func)
+  {
+    const ezUInt32 uiIterations = ezMath::Max<ezUInt32>(1, s_uiHashedBytesPerSize / uiSize);
+
+    ezUInt64 uiResult = 0;
+
+    // warm up
+    for (ezUInt32 i = 0; i < 16; ++i)
+      uiResult += func(data.GetData(), uiSize);
+
+    ezTime t0 = ezTime::Now();
+
+    for (ezUInt32 i = 0; i < uiIterations; ++i)
+    {
+      // vary the start position a bit to include unaligned reads, data has 8 bytes of padding at the end
+      uiResult += func(data.GetData() + (i % 8), uiSize);
+    }
+
+    ezTime t1 = ezTime::Now();
+
+    const double fSeconds = (t1 - t0).GetSeconds();
+    const double fGBPerSec = fSeconds > 0 ? (static_cast<double>(uiIterations) * uiSize) / (fSeconds * 1024.0 * 1024.0 * 1024.0) : 0.0;
+    const double fNsPerHash = (t1 - t0).GetNanoseconds() / uiIterations;
+
+    ezLog::Info("[test]{0} ({1} bytes): {2} GB/s, {3}ns per hash (result {4})", szName, uiSize, ezArgF(fGBPerSec, 2), ezArgF(fNsPerHash, 1), uiResult);
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Performance, Hashing)
+{
+  ezDynamicArray<ezUInt8> data;
+  data.SetCountUninitialized(1024 * 1024 + 8);
+  for (ezUInt32 i = 0; i < data.GetCount(); ++i)
+  {
+    data[i] = static_cast<ezUInt8>((i * 2654435761u) >> 24);
+  }
+
+  const ezUInt32 sizes[] = {8, 32, 200, 1024, 64 * 1024, 1024 * 1024};
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "CRC32")
+  {
+    for (ezUInt32 uiSize : sizes)
+      MeasureHashThroughput("CRC32", data, uiSize, [](const void* p, size_t n) -> ezUInt64 { return ezHashingUtils::CRC32Hash(p, n); });
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "MurmurHash64")
+  {
+    for (ezUInt32 uiSize : sizes)
+      MeasureHashThroughput("MurmurHash64", data, uiSize, [](const void* p, size_t n) -> ezUInt64 { return ezHashingUtils::MurmurHash64(p, n); });
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "xxHash32")
+  {
+    for (ezUInt32 uiSize : sizes)
+      MeasureHashThroughput("xxHash32", data, uiSize, [](const void* p, size_t n) -> ezUInt64 { return ezHashingUtils::xxHash32(p, n); });
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "xxHash64")
+  {
+    for (ezUInt32 uiSize : sizes)
+      MeasureHashThroughput("xxHash64", data, uiSize, [](const void* p, size_t n) -> ezUInt64 { return ezHashingUtils::xxHash64(p, n); });
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "xxHash3_64")
+  {
+    for (ezUInt32 uiSize : sizes)
+      MeasureHashThroughput("xxHash3_64", data, uiSize, [](const void* p, size_t n) -> ezUInt64 { return ezHashingUtils::xxHash3_64(p, n); });
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "xxHash3_128")
+  {
+    for (ezUInt32 uiSize : sizes)
+      MeasureHashThroughput("xxHash3_128", data, uiSize, [](const void* p, size_t n) -> ezUInt64 { return ezHashingUtils::xxHash3_128(p, n).m_uiLow; });
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "HashStream")
+  {
+    // the asset curator hashes files through a stream writer in chunks of 10 KB
+    const ezUInt32 uiChunkSize = 10 * 1024;
+
+    auto hashStream64 = [&](const void* p, size_t n) -> ezUInt64 {
+      ezHashStreamWriter64 writer;
+      for (size_t i = 0; i < n; i += uiChunkSize)
+        writer.WriteBytes(static_cast<const ezUInt8*>(p) + i, ezMath::Min<size_t>(uiChunkSize, n - i)).IgnoreResult();
+      return writer.GetHashValue();
+    };
+
+    auto hashStreamXxHash3 = [&](const void* p, size_t n) -> ezUInt64 {
+      ezHashStreamWriterXxHash3_64 writer;
+      for (size_t i = 0; i < n; i += uiChunkSize)
+        writer.WriteBytes(static_cast<const ezUInt8*>(p) + i, ezMath::Min<size_t>(uiChunkSize, n - i)).IgnoreResult();
+      return writer.GetHashValue();
+    };
+
+    MeasureHashThroughput("ezHashStreamWriter64", data, 1024 * 1024, hashStream64);
+    MeasureHashThroughput("ezHashStreamWriterXxHash3_64", data, 1024 * 1024, hashStreamXxHash3);
+  }
+}
@@ -0,0 +1,122 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Reflection/ReflectionUtils.h>
+#include <Foundation/Time/Time.h>
+#include <FoundationTest/Reflection/ReflectionTestClasses.h>
+
+namespace
+{
+  // the linear search through the type hierarchy that ezRTTI::FindPropertyByName used before the property table existed
+  ezAbstractProperty* FindPropertyLinear(const ezRTTI* pRtti, const char* szName)
+  {
+    for (; pRtti != nullptr; pRtti = pRtti->GetParentType())
+    {
+      for (ezAbstractProperty* pProp : pRtti->GetProperties())
+      {
+        if (ezStringUtils::IsEqual(pProp->GetPropertyName(), szName))
+          return pProp;
+      }
+    }
+
+    return nullptr;
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Performance, PropertyAccess)
+{
+  const ezUInt32 uiNumIterations = 1000000;
+
+  const ezRTTI* pRtti = ezGetStaticRTTI<ezTestClass2>();
+  const char* szNames[] = {"SubStruct", "Color", "Time", "Variant"};
+
+  ezTestClass2 Instance;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Find Property Linear")
+  {
+    ezUInt32 uiFound = 0;
+
+    ezTime t0 = ezTime::Now();
+
+    for (ezUInt32 i = 0; i < uiNumIterations; ++i)
+      uiFound += FindPropertyLinear(pRtti, szNames[i % EZ_ARRAY_SIZE(szNames)]) != nullptr ? 1 : 0;
+
+    ezTime t1 = ezTime::Now();
+
+    EZ_TEST_INT(uiFound, uiNumIterations);
+    ezLog::Info("[test]Find Property Linear: {0}ns", ezArgF((t1 - t0).GetNanoseconds() / (double)uiNumIterations, 2));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Find Property Table")
+  {
+    ezUInt32 uiFound = 0;
+
+    ezTime t0 = ezTime::Now();
+
+    for (ezUInt32 i = 0; i < uiNumIterations; ++i)
+      uiFound += pRtti->FindPropertyByName(szNames[i % EZ_ARRAY_SIZE(szNames)]) != nullptr ? 1 : 0;
+
+    ezTime t1 = ezTime::Now();
+
+    EZ_TEST_INT(uiFound, uiNumIterations);
+    ezLog::Info("[test]Find Property Table: {0}ns", ezArgF((t1 - t0).GetNanoseconds() / (double)uiNumIterations, 2));
+  }
+
+  ezAbstractMemberProperty* pTimeProp = static_cast<ezAbstractMemberProperty*>(pRtti->FindPropertyByName("Time"));
+  const ezRTTIPropertyTable::Entry* pTimeEntry = pRtti->GetPropertyTable().FindEntry("Time");
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Member Access ezVariant")
+  {
+    double fSum = 0;
+
+    ezTime t0 = ezTime::Now();
+
+    for (ezUInt32 i = 0; i < uiNumIterations; ++i)
+    {
+      ezReflectionUtils::SetMemberPropertyValue(pTimeProp, &Instance, ezTime::Seconds(i));
+      fSum += ezReflectionUtils::GetMemberPropertyValue(pTimeProp, &Instance).Get<ezTime>().GetSeconds();
+    }
+
+    ezTime t1 = ezTime::Now();
+
+    EZ_TEST_BOOL(fSum > 0);
+    ezLog::Info("[test]Member Access ezVariant: {0}ns", ezArgF((t1 - t0).GetNanoseconds() / (double)uiNumIterations, 2));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Member Access Virtual")
+  {
+    ezTypedMemberProperty<ezTime>* pTyped = static_cast<ezTypedMemberProperty<ezTime>*>(pTimeProp);
+    double fSum = 0;
+
+    ezTime t0 = ezTime::Now();
+
+    for (ezUInt32 i = 0; i < uiNumIterations; ++i)
+    {
+      pTyped->SetValue(&Instance, ezTime::Seconds(i));
+      fSum += pTyped->GetValue(&Instance).GetSeconds();
+    }
+
+    ezTime t1 = ezTime::Now();
+
+    EZ_TEST_BOOL(fSum > 0);
+    ezLog::Info("[test]Member Access Virtual: {0}ns", ezArgF((t1 - t0).GetNanoseconds() / (double)uiNumIterations, 2));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Member Access Table")
+  {
+    double fSum = 0;
+
+    ezTime t0 = ezTime::Now();
+
+    for (ezUInt32 i = 0; i < uiNumIterations; ++i)
+    {
+      pTimeEntry->SetValue(&Instance, ezTime::Seconds(i));
+      fSum += pTimeEntry->GetValue<ezTime>(&Instance).GetSeconds();
+    }
+
+    ezTime t1 = ezTime::Now();
+
+    EZ_TEST_BOOL(fSum > 0);
+    ezLog::Info("[test]Member Access Table: {0}ns", ezArgF((t1 - t0).GetNanoseconds() / (double)uiNumIterations, 2));
+  }
+}
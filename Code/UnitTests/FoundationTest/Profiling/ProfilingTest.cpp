@@ -1,9 +1,15 @@
 #include <FoundationTestPCH.h>
 
+#include <Foundation/IO/CompressedStreamZstd.h>
+#include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/IO/MemoryStream.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Profiling/ProfilingCapture.h>
+#include <Foundation/Threading/Thread.h>
 #include <Foundation/Threading/ThreadUtils.h>
+#include <TestFramework/Utilities/TestLogInterface.h>
 
 namespace
 {
@@ -21,6 +27,20 @@ namespace
       ezLog::Info("Profiling capture saved to '{0}'.", fileWriter.GetFilePathAbsolute().GetData());
     }
   }
+
+  ezUInt32 CountScopes(const ezProfilingSystem::ProfilingData& data, const char* szName, const char* szFunctionName = nullptr)
+  {
+    ezUInt32 uiCount = 0;
+    for (const auto& eventBuffer : data.m_AllEventBuffers)
+    {
+      for (const auto& scope : eventBuffer.m_Data)
+      {
+        if (ezStringUtils::IsEqual(scope.m_szName, szName) && (szFunctionName == nullptr || ezStringUtils::IsEqual(scope.m_szFunctionName, szFunctionName)))
+          ++uiCount;
+      }
+    }
+    return uiCount;
+  }
 } // namespace
 
 EZ_CREATE_SIMPLE_TEST_GROUP(Profiling);
@@ -53,3 +73,808 @@ EZ_CREATE_SIMPLE_TEST(Profiling, Profiling)
     WriteOutProfilingCapture(":output/profilingScopes.json");
   }
 }
+
+EZ_CREATE_SIMPLE_TEST(Profiling, BinaryCapture)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "WriteBinary / ReadBinary")
+  {
+    const ezTime startTime = ezTime::Seconds(12345.678);
+
+    ezProfilingSystem::ProfilingData data;
+    data.m_uiProcessID = 42;
+    data.m_uiFramesThreadID = 1;
+    data.m_uiGPUThreadID = 0;
+    data.m_uiFrameCount = 10;
+
+    auto& threadInfo = data.m_ThreadInfos.ExpandAndGetRef();
+    threadInfo.m_uiThreadId = 7;
+    threadInfo.m_sName = "Worker";
+
+    auto& eventBuffer = data.m_AllEventBuffers.ExpandAndGetRef();
+    eventBuffer.m_uiThreadId = 7;
+
+    for (ezUInt32 i = 0; i < 100; ++i)
+    {
+      auto& scope = eventBuffer.m_Data.ExpandAndGetRef();
+      ezStringUtils::Copy(scope.m_szName, ezProfilingSystem::CPUScope::NAME_SIZE, (i % 2) == 0 ? "Even" : "Odd");
+      scope.m_szFunctionName = (i % 3) == 0 ? "SomeFunction" : nullptr;
+      // nested scopes end before their parent, so the begin times are not sorted
+      scope.m_BeginTime = startTime + ezTime::Microseconds((i % 2) == 0 ? i * 10.0 + 5.0 : i * 10.0);
+      scope.m_EndTime = scope.m_BeginTime + ezTime::Microseconds(3.5);
+    }
+
+    for (ezUInt32 i = 0; i < 3; ++i)
+    {
+      data.m_FrameStartTimes.PushBack(startTime + ezTime::Milliseconds(i * 16.6));
+    }
+
+    auto& gpuScope = data.m_GPUScopes.ExpandAndGetRef();
+    ezStringUtils::Copy(gpuScope.m_szName, ezProfilingSystem::GPUScope::NAME_SIZE, "GPU Pass");
+    gpuScope.m_BeginTime = startTime;
+    gpuScope.m_EndTime = startTime + ezTime::Milliseconds(2);
+
+    ezMemoryStreamStorage binaryStorage;
+    ezMemoryStreamWriter binaryWriter(&binaryStorage);
+    EZ_TEST_BOOL(data.WriteBinary(binaryWriter).Succeeded());
+
+    ezMemoryStreamStorage jsonStorage;
+    ezMemoryStreamWriter jsonWriter(&jsonStorage);
+    EZ_TEST_BOOL(data.Write(jsonWriter).Succeeded());
+
+    EZ_TEST_BOOL(binaryStorage.GetStorageSize() * 10 < jsonStorage.GetStorageSize());
+
+    ezProfilingSystem::ProfilingData readData;
+    ezMemoryStreamReader binaryReader(&binaryStorage);
+    EZ_TEST_BOOL(readData.ReadBinary(binaryReader).Succeeded());
+
+    EZ_TEST_INT(readData.m_uiProcessID, 42);
+    EZ_TEST_INT(readData.m_uiFramesThreadID, 1);
+    EZ_TEST_INT(readData.m_uiGPUThreadID, 0);
+    EZ_TEST_INT(readData.m_uiFrameCount, 10);
+
+    if (EZ_TEST_INT(readData.m_ThreadInfos.GetCount(), 1))
+    {
+      EZ_TEST_INT(readData.m_ThreadInfos[0].m_uiThreadId, 7);
+      EZ_TEST_STRING(readData.m_ThreadInfos[0].m_sName, "Worker");
+    }
+
+    if (EZ_TEST_INT(readData.m_AllEventBuffers.GetCount(), 1) && EZ_TEST_INT(readData.m_AllEventBuffers[0].m_Data.GetCount(), 100))
+    {
+      for (ezUInt32 i = 0; i < 100; ++i)
+      {
+        const auto& expected = eventBuffer.m_Data[i];
+        const auto& scope = readData.m_AllEventBuffers[0].m_Data[i];
+
+        EZ_TEST_STRING(scope.m_szName, expected.m_szName);
+        EZ_TEST_BOOL(ezStringUtils::IsEqual(scope.m_szFunctionName, expected.m_szFunctionName));
+        EZ_TEST_DOUBLE(scope.m_BeginTime.GetNanoseconds(), expected.m_BeginTime.GetNanoseconds(), 2.0);
+        EZ_TEST_DOUBLE(scope.m_EndTime.GetNanoseconds(), expected.m_EndTime.GetNanoseconds(), 2.0);
+      }
+    }
+
+    if (EZ_TEST_INT(readData.m_FrameStartTimes.GetCount(), 3))
+    {
+      EZ_TEST_DOUBLE(readData.m_FrameStartTimes[2].GetNanoseconds(), data.m_FrameStartTimes[2].GetNanoseconds(), 2.0);
+    }
+
+    if (EZ_TEST_INT(readData.m_GPUScopes.GetCount(), 1))
+    {
+      EZ_TEST_STRING(readData.m_GPUScopes[0].m_szName, "GPU Pass");
+      EZ_TEST_DOUBLE(readData.m_GPUScopes[0].m_EndTime.GetNanoseconds(), gpuScope.m_EndTime.GetNanoseconds(), 2.0);
+    }
+
+    // truncated data must not crash the reader
+    {
+      ezMemoryStreamStorage truncatedStorage;
+      ezMemoryStreamWriter truncatedWriter(&truncatedStorage);
+      ezMemoryStreamReader fullReader(&binaryStorage);
+      ezDynamicArray<ezUInt8> bytes;
+      bytes.SetCountUninitialized(binaryStorage.GetStorageSize() / 2);
+      fullReader.ReadBytes(bytes.GetData(), bytes.GetCount());
+      truncatedWriter.WriteBytes(bytes.GetData(), bytes.GetCount()).IgnoreResult();
+
+      ezMemoryStreamReader truncatedReader(&truncatedStorage);
+      readData.ReadBinary(truncatedReader).IgnoreResult();
+    }
+
+    // a corrupted chunk size must be rejected before anything is allocated for it
+    {
+      ezMemoryStreamStorage corruptedStorage;
+      ezMemoryStreamWriter corruptedWriter(&corruptedStorage);
+      corruptedWriter.WriteBytes(ezProfilingCaptureFormat::Magic, sizeof(ezProfilingCaptureFormat::Magic)).IgnoreResult();
+      corruptedWriter << ezProfilingCaptureFormat::Version;
+      corruptedWriter << static_cast<ezUInt8>(ezProfilingCaptureFormat::ChunkType::Strings);
+      corruptedWriter << static_cast<ezUInt32>(0xFFFFFFF0u);
+
+      ezTestLogInterface log;
+      ezTestLogSystemScope logSystemScope(&log);
+      log.ExpectMessage("chunk size 4294967280 is too large", ezLogMsgType::ErrorMsg);
+
+      ezMemoryStreamReader corruptedReader(&corruptedStorage);
+      EZ_TEST_BOOL(readData.ReadBinary(corruptedReader).Failed());
+    }
+  }
+
+#if EZ_ENABLED(EZ_USE_PROFILING)
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Capture stream")
+  {
+    ezProfilingSystem::SetDiscardThreshold(ezTime::Zero());
+
+    class ProfilingStreamThread : public ezThread
+    {
+    public:
+      virtual ezUInt32 Run() override
+      {
+        for (ezUInt32 i = 0; i < 500; ++i)
+        {
+          EZ_PROFILE_SCOPE("Streamed worker scope");
+        }
+        return 0;
+      }
+    };
+
+    ezMemoryStreamStorage storage;
+    ezMemoryStreamWriter writer(&storage);
+
+    EZ_TEST_BOOL(ezProfilingSystem::StartCaptureStream(&writer, ezTime::Milliseconds(5)).Succeeded());
+    EZ_TEST_BOOL(ezProfilingSystem::IsCaptureStreamActive());
+
+    ProfilingStreamThread thread;
+    thread.Start();
+
+    for (ezUInt32 i = 0; i < 20; ++i)
+    {
+      ezProfilingSystem::StartNewFrame();
+
+      for (ezUInt32 j = 0; j < 100; ++j)
+      {
+        EZ_PROFILE_SCOPE("Streamed main scope");
+      }
+
+      ezThreadUtils::Sleep(ezTime::Milliseconds(1));
+    }
+
+    thread.Join();
+
+    // only the stream that writes into the given writer is stopped
+    ezMemoryStreamStorage otherStorage;
+    ezMemoryStreamWriter otherWriter(&otherStorage);
+    ezProfilingSystem::StopCaptureStream(&otherWriter);
+    EZ_TEST_BOOL(ezProfilingSystem::IsCaptureStreamActive());
+
+    ezProfilingSystem::StopCaptureStream(&writer);
+    EZ_TEST_BOOL(!ezProfilingSystem::IsCaptureStreamActive());
+
+    ezProfilingSystem::SetDiscardThreshold(ezTime::Milliseconds(0.1));
+
+    ezProfilingSystem::ProfilingData readData;
+    ezMemoryStreamReader reader(&storage);
+    EZ_TEST_BOOL(readData.ReadBinary(reader).Succeeded());
+
+    EZ_TEST_INT(CountScopes(readData, "Streamed main scope", EZ_SOURCE_FUNCTION), 2000);
+    EZ_TEST_INT(CountScopes(readData, "Streamed worker scope"), 500);
+    EZ_TEST_INT(readData.m_FrameStartTimes.GetCount(), 20);
+
+    EZ_TEST_BOOL(!readData.m_ThreadInfos.IsEmpty());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Capture stream with bandwidth limit")
+  {
+    ezProfilingSystem::SetDiscardThreshold(ezTime::Zero());
+
+    ezMemoryStreamStorage storage;
+    ezMemoryStreamWriter writer(&storage);
+
+    // no batch fits into the budget, so only the frames are kept
+    EZ_TEST_BOOL(ezProfilingSystem::StartCaptureStream(&writer, ezTime::Milliseconds(5), 1).Succeeded());
+
+    for (ezUInt32 i = 0; i < 2; ++i)
+    {
+      for (ezUInt32 j = 0; j < 5; ++j)
+      {
+        ezProfilingSystem::StartNewFrame();
+
+        for (ezUInt32 k = 0; k < 200; ++k)
+        {
+          EZ_PROFILE_SCOPE("Throttled scope");
+        }
+      }
+
+      ezThreadUtils::Sleep(ezTime::Milliseconds(50));
+    }
+
+    ezProfilingSystem::StopCaptureStream();
+    ezProfilingSystem::SetDiscardThreshold(ezTime::Milliseconds(0.1));
+
+    ezProfilingSystem::ProfilingData readData;
+    ezMemoryStreamReader reader(&storage);
+    EZ_TEST_BOOL(readData.ReadBinary(reader).Succeeded());
+
+    EZ_TEST_INT(CountScopes(readData, "Throttled scope"), 0);
+    EZ_TEST_INT(readData.m_FrameStartTimes.GetCount(), 10);
+  }
+
+#  ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Compressed capture stream file")
+  {
+    ezStringBuilder outputPath = ezTestFramework::GetInstance()->GetAbsOutputPath();
+    EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(outputPath.GetData(), "test", "output", ezFileSystem::AllowWrites) == EZ_SUCCESS);
+
+    ezProfilingSystem::SetDiscardThreshold(ezTime::Zero());
+
+    EZ_TEST_BOOL(ezProfilingSystem::StartCaptureStream(":output/profilingStream.ezProfilingCapture").Succeeded());
+
+    for (ezUInt32 i = 0; i < 1000; ++i)
+    {
+      EZ_PROFILE_SCOPE("Streamed file scope");
+    }
+
+    ezProfilingSystem::StopCaptureStream();
+    ezProfilingSystem::SetDiscardThreshold(ezTime::Milliseconds(0.1));
+
+    {
+      ezFileReader fileReader;
+      if (EZ_TEST_BOOL(fileReader.Open(":output/profilingStream.ezProfilingCapture").Succeeded()))
+      {
+        ezCompressedStreamReaderZstd decompressor(&fileReader);
+
+        ezProfilingSystem::ProfilingData readData;
+        EZ_TEST_BOOL(readData.ReadBinary(decompressor).Succeeded());
+        EZ_TEST_INT(CountScopes(readData, "Streamed file scope"), 1000);
+      }
+    }
+
+    ezFileSystem::RemoveDataDirectoryGroup("test");
+  }
+#  endif
+#endif
+}
+
+EZ_CREATE_SIMPLE_TEST(Profiling, CountersAndMarkers)
+{
+#if EZ_ENABLED(EZ_USE_PROFILING)
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Capture")
+  {
+    ezProfilingSystem::Clear();
+
+    for (ezUInt32 i = 0; i < 10; ++i)
+    {
+      EZ_PROFILE_COUNTER("Test Counter", i * 1.5f);
+    }
+
+    EZ_PROFILE_MARKER("Test Marker");
+
+    ezProfilingSystem::ProfilingData data;
+    ezProfilingSystem::Capture(data);
+
+    const ezUInt64 uiThreadId = (ezUInt64)ezThreadUtils::GetCurrentThreadID();
+
+    const ezProfilingSystem::CPUScopesBufferFlat* pEventBuffer = nullptr;
+    for (const auto& eventBuffer : data.m_AllEventBuffers)
+    {
+      if (eventBuffer.m_uiThreadId == uiThreadId)
+        pEventBuffer = &eventBuffer;
+    }
+
+    if (EZ_TEST_BOOL(pEventBuffer != nullptr))
+    {
+      if (EZ_TEST_INT(pEventBuffer->m_CounterSamples.GetCount(), 10))
+      {
+        EZ_TEST_STRING(pEventBuffer->m_CounterSamples[3].m_szName, "Test Counter");
+        EZ_TEST_DOUBLE(pEventBuffer->m_CounterSamples[3].m_fValue, 4.5, 0.0);
+        EZ_TEST_BOOL(pEventBuffer->m_CounterSamples[3].m_Time <= pEventBuffer->m_CounterSamples[4].m_Time);
+      }
+
+      if (EZ_TEST_INT(pEventBuffer->m_Markers.GetCount(), 1))
+      {
+        EZ_TEST_STRING(pEventBuffer->m_Markers[0].m_szName, "Test Marker");
+        EZ_TEST_STRING(pEventBuffer->m_Markers[0].m_szFunctionName, EZ_SOURCE_FUNCTION);
+      }
+    }
+
+    // counter tracks and instant events in the JSON output
+    ezMemoryStreamStorage jsonStorage;
+    ezMemoryStreamWriter jsonWriter(&jsonStorage);
+    EZ_TEST_BOOL(data.Write(jsonWriter).Succeeded());
+    jsonWriter.WriteBytes("", 1).IgnoreResult();
+
+    ezDynamicArray<char> json;
+    json.SetCountUninitialized(jsonStorage.GetStorageSize());
+    ezMemoryStreamReader jsonReader(&jsonStorage);
+    jsonReader.ReadBytes(json.GetData(), json.GetCount());
+
+    EZ_TEST_BOOL(ezStringUtils::FindSubString(json.GetData(), "\"ph\":\"C\"") != nullptr);
+    EZ_TEST_BOOL(ezStringUtils::FindSubString(json.GetData(), "\"ph\":\"i\"") != nullptr);
+
+    ezProfilingSystem::Clear();
+  }
+#endif
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "WriteBinary / ReadBinary")
+  {
+    const ezTime startTime = ezTime::Seconds(100.0);
+
+    ezProfilingSystem::ProfilingData data;
+    auto& eventBuffer = data.m_AllEventBuffers.ExpandAndGetRef();
+    eventBuffer.m_uiThreadId = 3;
+
+    for (ezUInt32 i = 0; i < 50; ++i)
+    {
+      auto& sample = eventBuffer.m_CounterSamples.ExpandAndGetRef();
+      ezStringUtils::Copy(sample.m_szName, ezProfilingSystem::CounterSample::NAME_SIZE, (i % 2) == 0 ? "Memory" : "Objects");
+      sample.m_Time = startTime + ezTime::Microseconds(i * 20.0);
+      sample.m_fValue = i * 0.25 - 3.0;
+    }
+
+    auto& marker = eventBuffer.m_Markers.ExpandAndGetRef();
+    ezStringUtils::Copy(marker.m_szName, ezProfilingSystem::Marker::NAME_SIZE, "Level Loaded");
+    marker.m_szFunctionName = "LoadLevel";
+    marker.m_Time = startTime + ezTime::Milliseconds(1);
+
+    ezMemoryStreamStorage binaryStorage;
+    ezMemoryStreamWriter binaryWriter(&binaryStorage);
+    EZ_TEST_BOOL(data.WriteBinary(binaryWriter).Succeeded());
+
+    ezProfilingSystem::ProfilingData readData;
+    ezMemoryStreamReader binaryReader(&binaryStorage);
+    EZ_TEST_BOOL(readData.ReadBinary(binaryReader).Succeeded());
+
+    if (EZ_TEST_INT(readData.m_AllEventBuffers.GetCount(), 1))
+    {
+      const auto& readBuffer = readData.m_AllEventBuffers[0];
+      EZ_TEST_INT(readBuffer.m_uiThreadId, 3);
+      EZ_TEST_BOOL(readBuffer.m_Data.IsEmpty());
+
+      if (EZ_TEST_INT(readBuffer.m_CounterSamples.GetCount(), 50))
+      {
+        for (ezUInt32 i = 0; i < 50; ++i)
+        {
+          EZ_TEST_STRING(readBuffer.m_CounterSamples[i].m_szName, eventBuffer.m_CounterSamples[i].m_szName);
+          EZ_TEST_DOUBLE(readBuffer.m_CounterSamples[i].m_fValue, eventBuffer.m_CounterSamples[i].m_fValue, 0.0);
+          EZ_TEST_DOUBLE(readBuffer.m_CounterSamples[i].m_Time.GetNanoseconds(), eventBuffer.m_CounterSamples[i].m_Time.GetNanoseconds(), 2.0);
+        }
+      }
+
+      if (EZ_TEST_INT(readBuffer.m_Markers.GetCount(), 1))
+      {
+        EZ_TEST_STRING(readBuffer.m_Markers[0].m_szName, "Level Loaded");
+        EZ_TEST_STRING(readBuffer.m_Markers[0].m_szFunctionName, "LoadLevel");
+        EZ_TEST_DOUBLE(readBuffer.m_Markers[0].m_Time.GetNanoseconds(), marker.m_Time.GetNanoseconds(), 2.0);
+      }
+    }
+  }
+
+#if EZ_ENABLED(EZ_USE_PROFILING)
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Capture stream")
+  {
+    ezMemoryStreamStorage storage;
+    ezMemoryStreamWriter writer(&storage);
+
+    EZ_TEST_BOOL(ezProfilingSystem::StartCaptureStream(&writer, ezTime::Milliseconds(5)).Succeeded());
+
+    for (ezUInt32 i = 0; i < 20; ++i)
+    {
+      ezProfilingSystem::StartNewFrame();
+      EZ_PROFILE_COUNTER("Streamed Counter", i);
+      ezThreadUtils::Sleep(ezTime::Milliseconds(1));
+    }
+
+    EZ_PROFILE_MARKER("Streamed Marker");
+
+    ezProfilingSystem::StopCaptureStream();
+
+    ezProfilingSystem::ProfilingData readData;
+    ezMemoryStreamReader reader(&storage);
+    EZ_TEST_BOOL(readData.ReadBinary(reader).Succeeded());
+
+    ezUInt32 uiNumSamples = 0;
+    ezUInt32 uiNumMarkers = 0;
+    double fLastValue = -1.0;
+    for (const auto& eventBuffer : readData.m_AllEventBuffers)
+    {
+      for (const auto& sample : eventBuffer.m_CounterSamples)
+      {
+        if (ezStringUtils::IsEqual(sample.m_szName, "Streamed Counter"))
+        {
+          ++uiNumSamples;
+          fLastValue = sample.m_fValue;
+        }
+      }
+
+      for (const auto& marker : eventBuffer.m_Markers)
+      {
+        if (ezStringUtils::IsEqual(marker.m_szName, "Streamed Marker"))
+          ++uiNumMarkers;
+      }
+    }
+
+    EZ_TEST_INT(uiNumSamples, 20);
+    EZ_TEST_DOUBLE(fLastValue, 19.0, 0.0);
+    EZ_TEST_INT(uiNumMarkers, 1);
+  }
+#endif
+}
+
+EZ_CREATE_SIMPLE_TEST(Profiling, AllocationCounting)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Thread allocation counter")
+  {
+    ezAllocatorBase::SetThreadAllocationCountingEnabled(true);
+
+    const ezAllocatorBase::ThreadAllocationCounter before = ezAllocatorBase::GetThreadAllocationCounter();
+
+    ezUInt8* pBuffer = EZ_DEFAULT_NEW_RAW_BUFFER(ezUInt8, 100);
+    EZ_DEFAULT_DELETE_RAW_BUFFER(pBuffer);
+
+    const ezAllocatorBase::ThreadAllocationCounter after = ezAllocatorBase::GetThreadAllocationCounter();
+
+    ezAllocatorBase::SetThreadAllocationCountingEnabled(false);
+
+    EZ_TEST_INT(after.m_uiNumAllocations - before.m_uiNumAllocations, 1);
+    EZ_TEST_INT(after.m_uiAllocationSize - before.m_uiAllocationSize, 100);
+
+    // nothing is counted while disabled
+    pBuffer = EZ_DEFAULT_NEW_RAW_BUFFER(ezUInt8, 100);
+    EZ_DEFAULT_DELETE_RAW_BUFFER(pBuffer);
+
+    EZ_TEST_INT(ezAllocatorBase::GetThreadAllocationCounter().m_uiNumAllocations, after.m_uiNumAllocations);
+  }
+
+#if EZ_ENABLED(EZ_USE_PROFILING)
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Scopes")
+  {
+    ezProfilingSystem::Clear();
+    ezProfilingSystem::SetAllocationCountingEnabled(true);
+    EZ_TEST_BOOL(ezProfilingSystem::IsAllocationCountingEnabled());
+
+    {
+      EZ_PROFILE_SCOPE("Allocating scope");
+
+      {
+        EZ_PROFILE_SCOPE("Not allocating scope");
+      }
+
+      for (ezUInt32 i = 0; i < 3; ++i)
+      {
+        ezUInt32* pBuffer = EZ_DEFAULT_NEW_RAW_BUFFER(ezUInt32, 64);
+        EZ_DEFAULT_DELETE_RAW_BUFFER(pBuffer);
+      }
+    }
+
+    ezProfilingSystem::SetAllocationCountingEnabled(false);
+
+    ezProfilingSystem::ProfilingData data;
+    ezProfilingSystem::Capture(data);
+    ezProfilingSystem::Clear();
+
+    // the allocating scope is kept although it is shorter than the discard threshold, the other one is not
+    EZ_TEST_INT(CountScopes(data, "Not allocating scope"), 0);
+
+    const ezProfilingSystem::ScopeAllocations* pAllocations = nullptr;
+    for (const auto& eventBuffer : data.m_AllEventBuffers)
+    {
+      for (const auto& allocations : eventBuffer.m_ScopeAllocations)
+      {
+        if (ezStringUtils::IsEqual(eventBuffer.m_Data[allocations.m_uiScopeIndex].m_szName, "Allocating scope"))
+          pAllocations = &allocations;
+      }
+    }
+
+    if (EZ_TEST_BOOL(pAllocations != nullptr))
+    {
+      EZ_TEST_INT(pAllocations->m_uiNumAllocations, 3);
+      EZ_TEST_INT(pAllocations->m_uiAllocationSize, 3 * 64 * sizeof(ezUInt32));
+    }
+
+    ezMemoryStreamStorage jsonStorage;
+    ezMemoryStreamWriter jsonWriter(&jsonStorage);
+    EZ_TEST_BOOL(data.Write(jsonWriter).Succeeded());
+    jsonWriter.WriteBytes("", 1).IgnoreResult();
+
+    ezDynamicArray<char> json;
+    json.SetCountUninitialized(jsonStorage.GetStorageSize());
+    ezMemoryStreamReader jsonReader(&jsonStorage);
+    jsonReader.ReadBytes(json.GetData(), json.GetCount());
+
+    EZ_TEST_BOOL(ezStringUtils::FindSubString(json.GetData(), "\"allocations\":3") != nullptr);
+  }
+#endif
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "WriteBinary / ReadBinary")
+  {
+    ezProfilingSystem::ProfilingData data;
+    auto& eventBuffer = data.m_AllEventBuffers.ExpandAndGetRef();
+    eventBuffer.m_uiThreadId = 5;
+
+    for (ezUInt32 i = 0; i < 20; ++i)
+    {
+      auto& scope = eventBuffer.m_Data.ExpandAndGetRef();
+      ezStringUtils::Copy(scope.m_szName, ezProfilingSystem::CPUScope::NAME_SIZE, "Scope");
+      scope.m_szFunctionName = nullptr;
+      scope.m_BeginTime = ezTime::Milliseconds(i);
+      scope.m_EndTime = ezTime::Milliseconds(i + 0.5);
+
+      if ((i % 7) == 0)
+      {
+        auto& allocations = eventBuffer.m_ScopeAllocations.ExpandAndGetRef();
+        allocations.m_uiScopeIndex = i;
+        allocations.m_uiNumAllocations = i + 1;
+        allocations.m_uiAllocationSize = (i + 1) * 1000ull;
+      }
+    }
+
+    ezMemoryStreamStorage binaryStorage;
+    ezMemoryStreamWriter binaryWriter(&binaryStorage);
+    EZ_TEST_BOOL(data.WriteBinary(binaryWriter).Succeeded());
+
+    ezProfilingSystem::ProfilingData readData;
+    ezMemoryStreamReader binaryReader(&binaryStorage);
+    EZ_TEST_BOOL(readData.ReadBinary(binaryReader).Succeeded());
+
+    if (EZ_TEST_INT(readData.m_AllEventBuffers.GetCount(), 1) && EZ_TEST_INT(readData.m_AllEventBuffers[0].m_ScopeAllocations.GetCount(), 3))
+    {
+      for (ezUInt32 i = 0; i < 3; ++i)
+      {
+        const auto& expected = eventBuffer.m_ScopeAllocations[i];
+        const auto& allocations = readData.m_AllEventBuffers[0].m_ScopeAllocations[i];
+        EZ_TEST_INT(allocations.m_uiScopeIndex, expected.m_uiScopeIndex);
+        EZ_TEST_INT(allocations.m_uiNumAllocations, expected.m_uiNumAllocations);
+        EZ_TEST_INT(allocations.m_uiAllocationSize, expected.m_uiAllocationSize);
+      }
+    }
+
+    // merging offsets the scope indices
+    ezProfilingSystem::ProfilingData merged;
+    const ezProfilingSystem::ProfilingData* inputs[] = {&data, &readData};
+    ezProfilingSystem::ProfilingData::Merge(merged, ezMakeArrayPtr(inputs));
+
+    if (EZ_TEST_INT(merged.m_AllEventBuffers.GetCount(), 1) && EZ_TEST_INT(merged.m_AllEventBuffers[0].m_ScopeAllocations.GetCount(), 6))
+    {
+      EZ_TEST_INT(merged.m_AllEventBuffers[0].m_ScopeAllocations[4].m_uiScopeIndex, 27);
+    }
+  }
+}
+
+EZ_CREATE_SIMPLE_TEST(Profiling, SpikeCapture)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "RemoveEventsOutsideTimeRange")
+  {
+    ezProfilingSystem::ProfilingData data;
+    data.m_uiFrameCount = 10;
+
+    auto& eventBuffer = data.m_AllEventBuffers.ExpandAndGetRef();
+    eventBuffer.m_uiThreadId = 5;
+
+    for (ezUInt32 i = 0; i < 10; ++i)
+    {
+      data.m_FrameStartTimes.PushBack(ezTime::Milliseconds(i * 10));
+
+      auto& scope = eventBuffer.m_Data.ExpandAndGetRef();
+      ezStringUtils::Copy(scope.m_szName, ezProfilingSystem::CPUScope::NAME_SIZE, "Scope");
+      scope.m_szFunctionName = nullptr;
+      scope.m_BeginTime = ezTime::Milliseconds(i * 10 + 1);
+      scope.m_EndTime = ezTime::Milliseconds(i * 10 + 5);
+
+      auto& allocations = eventBuffer.m_ScopeAllocations.ExpandAndGetRef();
+      allocations.m_uiScopeIndex = i;
+      allocations.m_uiNumAllocations = i + 1;
+      allocations.m_uiAllocationSize = 100;
+
+      auto& sample = eventBuffer.m_CounterSamples.ExpandAndGetRef();
+      ezStringUtils::Copy(sample.m_szName, ezProfilingSystem::CounterSample::NAME_SIZE, "Counter");
+      sample.m_Time = ezTime::Milliseconds(i * 10 + 2);
+      sample.m_fValue = i;
+    }
+
+    // keeps the scopes of frame 2 to 6, the scope of frame 2 ends at 25 ms and is partially inside the range
+    data.RemoveEventsOutsideTimeRange(ezTime::Milliseconds(24), ezTime::Milliseconds(61));
+
+    EZ_TEST_INT(data.m_uiFrameCount, 10);
+    if (EZ_TEST_INT(data.m_FrameStartTimes.GetCount(), 4))
+    {
+      EZ_TEST_DOUBLE(data.m_FrameStartTimes[0].GetMilliseconds(), 30.0, 0.001);
+    }
+
+    if (EZ_TEST_INT(eventBuffer.m_Data.GetCount(), 5) && EZ_TEST_INT(eventBuffer.m_ScopeAllocations.GetCount(), 5))
+    {
+      for (ezUInt32 i = 0; i < 5; ++i)
+      {
+        EZ_TEST_DOUBLE(eventBuffer.m_Data[i].m_BeginTime.GetMilliseconds(), (i + 2) * 10.0 + 1.0, 0.001);
+        EZ_TEST_INT(eventBuffer.m_ScopeAllocations[i].m_uiScopeIndex, i);
+        EZ_TEST_INT(eventBuffer.m_ScopeAllocations[i].m_uiNumAllocations, i + 3);
+      }
+    }
+
+    EZ_TEST_INT(eventBuffer.m_CounterSamples.GetCount(), 3);
+  }
+
+#if EZ_ENABLED(EZ_USE_PROFILING)
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Flight recorder")
+  {
+    ezStringBuilder outputPath = ezTestFramework::GetInstance()->GetAbsOutputPath();
+    EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(outputPath.GetData(), "test", "output", ezFileSystem::AllowWrites) == EZ_SUCCESS);
+
+    ezStringBuilder sWrittenCapture;
+
+    ezProfilingSpikeCaptureSettings settings;
+    settings.m_FrameTimeThreshold = ezTime::Milliseconds(20);
+    settings.m_uiFramesBefore = 2;
+    settings.m_uiFramesAfter = 1;
+    settings.m_MinTimeBetweenCaptures = ezTime::Hours(1);
+    settings.m_sOutputFolder = ":output/Spikes";
+    settings.m_OnCaptureWritten = [&](const char* szPath) { sWrittenCapture = szPath; };
+
+    ezProfilingSystem::EnableSpikeCapture(settings);
+    EZ_TEST_BOOL(ezProfilingSystem::IsSpikeCaptureEnabled());
+
+    auto spike = [](const char* szName) {
+      ezProfilingSystem::StartNewFrame();
+      {
+        EZ_PROFILE_SCOPE(szName);
+        ezThreadUtils::Sleep(ezTime::Milliseconds(40));
+      }
+      ezProfilingSystem::StartNewFrame();
+    };
+
+    for (ezUInt32 i = 0; i < 5; ++i)
+    {
+      ezProfilingSystem::StartNewFrame();
+    }
+
+    spike("Spike scope");
+
+    for (ezUInt32 i = 0; i < 2; ++i)
+    {
+      ezProfilingSystem::StartNewFrame();
+    }
+
+    // rate limited
+    spike("Second spike scope");
+
+    ezProfilingSystem::DisableSpikeCapture();
+    EZ_TEST_BOOL(!ezProfilingSystem::IsSpikeCaptureEnabled());
+    EZ_TEST_INT(ezProfilingSystem::GetNumWrittenSpikeCaptures(), 1);
+
+    ezFileReader fileReader;
+    if (EZ_TEST_BOOL(fileReader.Open(sWrittenCapture).Succeeded()))
+    {
+      ezProfilingSystem::ProfilingData readData;
+
+#  ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+      ezCompressedStreamReaderZstd decompressor(&fileReader);
+      EZ_TEST_BOOL(readData.ReadBinary(decompressor).Succeeded());
+#  else
+      EZ_TEST_BOOL(readData.ReadBinary(fileReader).Succeeded());
+#  endif
+
+      EZ_TEST_INT(CountScopes(readData, "Spike scope"), 1);
+      EZ_TEST_INT(CountScopes(readData, "Second spike scope"), 0);
+
+      // the spike frame, the frames before and after it and the frame in which the capture was taken
+      EZ_TEST_INT(readData.m_FrameStartTimes.GetCount(), 5);
+    }
+
+    fileReader.Close();
+    ezFileSystem::RemoveDataDirectoryGroup("test");
+  }
+#endif
+}
+
+EZ_CREATE_SIMPLE_TEST(Profiling, Sampling)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "WriteBinary / ReadBinary")
+  {
+    ezProfilingSystem::ProfilingData data;
+    auto& eventBuffer = data.m_AllEventBuffers.ExpandAndGetRef();
+    eventBuffer.m_uiThreadId = 5;
+
+    for (ezUInt32 i = 0; i < 10; ++i)
+    {
+      auto& sample = eventBuffer.m_StackSamples.ExpandAndGetRef();
+      sample.m_Time = ezTime::Milliseconds(i);
+      sample.m_uiNumFrames = 3;
+      sample.m_uiReserved = 0;
+      sample.m_Frames[0] = 0x7f0000001000ull + i;
+      sample.m_Frames[1] = 0x7f0000000800ull;
+      sample.m_Frames[2] = 0x400000ull;
+    }
+
+    data.m_StackFrameSymbols.Insert(0x400000ull, "main");
+
+    ezMemoryStreamStorage binaryStorage;
+    ezMemoryStreamWriter binaryWriter(&binaryStorage);
+    EZ_TEST_BOOL(data.WriteBinary(binaryWriter).Succeeded());
+
+    ezProfilingSystem::ProfilingData readData;
+    ezMemoryStreamReader binaryReader(&binaryStorage);
+    EZ_TEST_BOOL(readData.ReadBinary(binaryReader).Succeeded());
+
+    if (EZ_TEST_INT(readData.m_AllEventBuffers.GetCount(), 1) && EZ_TEST_INT(readData.m_AllEventBuffers[0].m_StackSamples.GetCount(), 10))
+    {
+      for (ezUInt32 i = 0; i < 10; ++i)
+      {
+        const auto& expected = eventBuffer.m_StackSamples[i];
+        const auto& sample = readData.m_AllEventBuffers[0].m_StackSamples[i];
+        EZ_TEST_DOUBLE(sample.m_Time.GetMilliseconds(), expected.m_Time.GetMilliseconds(), 0.001);
+        EZ_TEST_INT(sample.m_uiNumFrames, 3);
+        EZ_TEST_BOOL(ezMemoryUtils::IsEqual(sample.m_Frames, expected.m_Frames, 3));
+      }
+    }
+
+    if (EZ_TEST_INT(readData.m_StackFrameSymbols.GetCount(), 1))
+    {
+      EZ_TEST_STRING(readData.m_StackFrameSymbols[0x400000ull], "main");
+    }
+
+    // all samples share the two outer frames
+    ezMemoryStreamStorage jsonStorage;
+    ezMemoryStreamWriter jsonWriter(&jsonStorage);
+    EZ_TEST_BOOL(readData.Write(jsonWriter).Succeeded());
+
+    ezDynamicArray<char> json;
+    json.SetCountUninitialized(jsonStorage.GetStorageSize() + 1);
+    ezMemoryStreamReader jsonReader(&jsonStorage);
+    json[jsonReader.ReadBytes(json.GetData(), jsonStorage.GetStorageSize())] = '\0';
+
+    EZ_TEST_BOOL(ezStringUtils::FindSubString(json.GetData(), "\"samples\"") != nullptr);
+    EZ_TEST_BOOL(ezStringUtils::FindSubString(json.GetData(), "\"12\":{") != nullptr);
+    EZ_TEST_BOOL(ezStringUtils::FindSubString(json.GetData(), "\"13\":{") == nullptr);
+    EZ_TEST_BOOL(ezStringUtils::FindSubString(json.GetData(), "\"name\":\"main\"") != nullptr);
+  }
+
+#if EZ_ENABLED(EZ_USE_PROFILING)
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Sample the main thread")
+  {
+    if (!ezProfilingSystem::IsSamplingSupported())
+      return;
+
+    EZ_TEST_BOOL(ezProfilingSystem::StartSampling(ezTime::Microseconds(500)).Succeeded());
+    EZ_TEST_BOOL(ezProfilingSystem::IsSamplingActive());
+
+    // the samples are taken based on the CPU time of the thread, so it has to be busy
+    volatile ezUInt64 uiSum = 0;
+    const ezTime endTime = ezTime::Now() + ezTime::Milliseconds(50);
+    while (ezTime::Now() < endTime)
+    {
+      for (ezUInt32 i = 0; i < 1000; ++i)
+      {
+        uiSum = uiSum + i;
+      }
+    }
+
+    ezProfilingSystem::ProfilingData data;
+    ezProfilingSystem::Capture(data);
+
+    ezProfilingSystem::StopSampling();
+    EZ_TEST_BOOL(!ezProfilingSystem::IsSamplingActive());
+
+    const ezUInt64 uiMainThreadId = (ezUInt64)ezThreadUtils::GetCurrentThreadID();
+
+    ezUInt32 uiNumSamples = 0;
+    ezUInt32 uiNumCallStacks = 0;
+    for (const auto& eventBuffer : data.m_AllEventBuffers)
+    {
+      if (eventBuffer.m_uiThreadId != uiMainThreadId)
+        continue;
+
+      uiNumSamples += eventBuffer.m_StackSamples.GetCount();
+
+      for (const auto& sample : eventBuffer.m_StackSamples)
+      {
+        EZ_TEST_BOOL(sample.m_uiNumFrames > 0);
+
+        if (sample.m_uiNumFrames > 1)
+          ++uiNumCallStacks;
+      }
+    }
+
+    EZ_TEST_BOOL(uiNumSamples > 0);
+
+    // the callers are found through the frame pointers
+    EZ_TEST_BOOL(uiNumCallStacks > 0);
+
+    data.ResolveStackFrameSymbols();
+    EZ_TEST_BOOL(!data.m_StackFrameSymbols.IsEmpty());
+  }
+#endif
+}
@@ -540,6 +540,186 @@ EZ_CREATE_SIMPLE_TEST(Reflection, MemberProperties)
 }
 
 
+EZ_CREATE_SIMPLE_TEST(Reflection, PropertyTable)
+{
+  const ezRTTI* pRtti = ezGetStaticRTTI<ezTestClass2>();
+  const ezRTTIPropertyTable& table = pRtti->GetPropertyTable();
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "GetEntries")
+  {
+    EZ_TEST_BOOL(&pRtti->GetPropertyTable() == &table);
+
+    ezHybridArray<ezAbstractProperty*, 32> AllProps;
+    pRtti->GetAllProperties(AllProps);
+
+    EZ_TEST_INT(table.GetEntries().GetCount(), AllProps.GetCount());
+    for (ezUInt32 i = 0; i < AllProps.GetCount(); ++i)
+    {
+      EZ_TEST_BOOL(table.GetEntries()[i].m_pProperty == AllProps[i]);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindEntry")
+  {
+    EZ_TEST_BOOL(table.FindProperty("Color") == pRtti->GetParentType()->FindPropertyByName("Color", false));
+    EZ_TEST_BOOL(table.FindProperty("Time") == pRtti->FindPropertyByName("Time", false));
+    EZ_TEST_BOOL(table.FindProperty("SubStruct") == pRtti->FindPropertyByName("SubStruct"));
+    EZ_TEST_BOOL(table.FindEntry("MyVector") == nullptr);
+    EZ_TEST_BOOL(table.FindEntry(nullptr) == nullptr);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Direct Access")
+  {
+    ezTestClass2 Instance;
+
+    const ezRTTIPropertyTable::Entry* pColor = table.FindEntry("Color");
+    EZ_TEST_BOOL(pColor->HasDirectAccess());
+    EZ_TEST_BOOL(pColor->m_Type == ezVariantType::Color);
+    EZ_TEST_BOOL(pColor->GetMemberPointer(&Instance) == &Instance.m_Color);
+    EZ_TEST_BOOL(pColor->GetValue<ezColor>(&Instance) == ezColor::CornflowerBlue);
+    pColor->SetValue<ezColor>(&Instance, ezColor::Red);
+    EZ_TEST_BOOL(Instance.m_Color == ezColor::Red);
+
+    const ezRTTIPropertyTable::Entry* pTime = table.FindEntry("Time");
+    EZ_TEST_BOOL(pTime->HasDirectAccess());
+    EZ_TEST_BOOL(pTime->m_Type == ezVariantType::Time);
+    pTime->SetValue(&Instance, ezTime::Seconds(2.0));
+    EZ_TEST_BOOL(Instance.m_Time == ezTime::Seconds(2.0));
+    EZ_TEST_BOOL(pTime->GetValue<ezTime>(&Instance) == ezTime::Seconds(2.0));
+
+    const ezRTTIPropertyTable::Entry* pEnum = table.FindEntry("Enum");
+    EZ_TEST_BOOL(pEnum->HasDirectAccess());
+    EZ_TEST_BOOL(pEnum->m_Type == ezVariantType::Invalid);
+    EZ_TEST_BOOL(pEnum->GetMemberPointer(&Instance) == &Instance.m_enumClass);
+
+    const ezRTTIPropertyTable::Entry* pSubStruct = table.FindEntry("SubStruct");
+    EZ_TEST_BOOL(pSubStruct->HasDirectAccess());
+    EZ_TEST_BOOL(pSubStruct->m_Type == ezVariantType::Invalid);
+    EZ_TEST_BOOL(pSubStruct->GetMemberPointer(&Instance) == &Instance.m_Struct);
+
+    // accessor properties and containers can't be accessed directly
+    EZ_TEST_BOOL(!table.FindEntry("Text")->HasDirectAccess());
+    EZ_TEST_BOOL(!table.FindEntry("SubVector")->HasDirectAccess());
+    EZ_TEST_BOOL(!table.FindEntry("Array")->HasDirectAccess());
+  }
+}
+
+
+EZ_CREATE_SIMPLE_TEST(Reflection, CachedLayouts)
+{
+  // ezTestClass2 embeds ezTestStruct through its base class ezTestClass1
+  ezTestClass2 source;
+  source.m_Color = ezColor::Chartreuse;
+  source.m_Struct.m_fFloat1 = 7.5f;
+  source.m_Struct.m_UInt8 = 21;
+  source.m_Struct.m_Angle = ezAngle::Degree(45.0f);
+  source.m_Struct.m_vVec3I.Set(7, 8, 9);
+  source.m_Time = ezTime::Seconds(12.0);
+  source.m_enumClass = ezExampleEnum::Value3;
+  source.SetText("Dary");
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Member Offsets")
+  {
+    const ezRTTIPropertyTable& table = ezGetStaticRTTI<ezTestClass2>()->GetPropertyTable();
+    for (const ezRTTIPropertyTable::Entry& entry : table.GetEntries())
+    {
+      if (!entry.HasDirectAccess())
+        continue;
+
+      const ezAbstractMemberProperty* pMember = static_cast<const ezAbstractMemberProperty*>(entry.m_pProperty);
+      EZ_TEST_BOOL(entry.GetMemberPointer(&source) == pMember->GetPropertyPointer(&source));
+    }
+  }
+
+  // the first iteration builds the cached layouts, the second one uses them
+  for (ezUInt32 i = 0; i < 2; ++i)
+  {
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "Embedded Struct")
+    {
+      ezMemoryStreamStorage storage;
+      ezMemoryStreamWriter writer(&storage);
+      ezReflectionSerializer::WriteObjectToBinary(writer, ezGetStaticRTTI<ezTestClass2>(), &source);
+
+      ezMemoryStreamReader reader(&storage);
+      ezTestClass2 data;
+      ezReflectionSerializer::ReadObjectPropertiesFromBinary(reader, *ezGetStaticRTTI<ezTestClass2>(), &data);
+      EZ_TEST_BOOL(data.m_Struct == source.m_Struct);
+
+      ezTestClass2 clone;
+      ezReflectionSerializer::Clone(&source, &clone, ezGetStaticRTTI<ezTestClass2>());
+      EZ_TEST_BOOL(clone.m_Struct == source.m_Struct);
+    }
+
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "Base Class Property")
+    {
+      ezMemoryStreamStorage storage;
+      ezMemoryStreamWriter writer(&storage);
+      ezReflectionSerializer::WriteObjectToBinary(writer, ezGetStaticRTTI<ezTestClass2>(), &source);
+
+      ezMemoryStreamReader reader(&storage);
+      const ezRTTI* pRtti = nullptr;
+      ezTestClass2* pData = static_cast<ezTestClass2*>(ezReflectionSerializer::ReadObjectFromBinary(reader, pRtti));
+      EZ_TEST_BOOL(pRtti == ezGetStaticRTTI<ezTestClass2>());
+      EZ_TEST_BOOL(pData->m_Color == ezColor::Chartreuse);
+      EZ_TEST_BOOL(static_cast<const ezTestClass1&>(*pData) == source);
+      EZ_TEST_BOOL(*pData == source);
+      pRtti->GetAllocator()->Deallocate(pData);
+
+      ezTestClass2* pClone = ezReflectionSerializer::Clone(&source);
+      EZ_TEST_BOOL(pClone->m_Color == ezColor::Chartreuse);
+      EZ_TEST_BOOL(static_cast<const ezTestClass1&>(*pClone) == source);
+      EZ_TEST_BOOL(*pClone == source);
+      ezGetStaticRTTI<ezTestClass2>()->GetAllocator()->Deallocate(pClone);
+    }
+  }
+
+#if EZ_ENABLED(EZ_SUPPORTS_DYNAMIC_PLUGINS)
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Plugin Reload")
+  {
+    // every load registers new type and property objects, so nothing may be cached across an unload
+    for (ezUInt32 i = 0; i < 2; ++i)
+    {
+      ezResult loadPlugin = ezPlugin::LoadPlugin(ezFoundationTest_Plugin1);
+      EZ_TEST_BOOL(loadPlugin == EZ_SUCCESS);
+
+      if (loadPlugin.Failed())
+        return;
+
+      const ezRTTI* pRtti = ezRTTI::FindTypeByName("ezTestStruct2");
+      EZ_TEST_BOOL(pRtti != nullptr);
+
+      if (pRtti != nullptr)
+      {
+        auto* pFloat2 = static_cast<ezAbstractMemberProperty*>(pRtti->FindPropertyByName("Float2"));
+
+        void* pInstance = pRtti->GetAllocator()->Allocate<void>();
+        ezReflectionUtils::SetMemberPropertyValue(pFloat2, pInstance, 43.0f + i);
+
+        ezMemoryStreamStorage storage;
+        ezMemoryStreamWriter writer(&storage);
+        ezReflectionSerializer::WriteObjectToBinary(writer, pRtti, pInstance);
+
+        ezMemoryStreamReader reader(&storage);
+        const ezRTTI* pReadRtti = nullptr;
+        void* pRead = ezReflectionSerializer::ReadObjectFromBinary(reader, pReadRtti);
+        EZ_TEST_BOOL(pReadRtti == pRtti);
+        EZ_TEST_FLOAT(ezReflectionUtils::GetMemberPropertyValue(pFloat2, pRead).Get<float>(), 43.0f + i, 0);
+
+        void* pClone = ezReflectionSerializer::Clone(pInstance, pRtti);
+        EZ_TEST_FLOAT(ezReflectionUtils::GetMemberPropertyValue(pFloat2, pClone).Get<float>(), 43.0f + i, 0);
+
+        pRtti->GetAllocator()->Deallocate(pClone);
+        pRtti->GetAllocator()->Deallocate(pRead);
+        pRtti->GetAllocator()->Deallocate(pInstance);
+      }
+
+      EZ_TEST_BOOL(ezPlugin::UnloadPlugin(ezFoundationTest_Plugin1).Succeeded());
+    }
+  }
+#endif
+}
+
 EZ_CREATE_SIMPLE_TEST(Reflection, Enum)
 {
   const ezRTTI* pEnumRTTI = ezGetStaticRTTI<ezExampleEnum>();
@@ -0,0 +1,231 @@
+#include <FoundationTestPCH.h>
+
+#include <Foundation/Serialization/AbstractObjectGraph.h>
+
+namespace
+{
+  ezUuid MakeGraphTestGuid(ezUInt32 uiIndex)
+  {
+    ezUuid guid;
+    guid.CreateNewUuid();
+    guid.CombineWithSeed(ezUuid(uiIndex + 1, 0));
+    return guid;
+  }
+
+  ezVariantArray MakeGraphTestArray(ezInt32 iStart, ezUInt32 uiCount)
+  {
+    ezVariantArray values;
+    for (ezUInt32 i = 0; i < uiCount; ++i)
+      values.PushBack(iStart + (ezInt32)i);
+    return values;
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Serialization, AbstractObjectGraph)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindProperty")
+  {
+    ezAbstractObjectGraph graph;
+    ezAbstractObjectNode* pNode = graph.AddNode(MakeGraphTestGuid(0), "TestType", 1);
+    pNode->AddProperty("Position", ezVec3(1, 2, 3));
+    pNode->AddProperty("Name", "Node");
+    pNode->AddProperty("Count", 5);
+
+    const ezAbstractObjectNode* pConstNode = pNode;
+    EZ_TEST_BOOL(pConstNode->FindProperty("Position")->m_Value == ezVec3(1, 2, 3));
+    EZ_TEST_BOOL(pConstNode->FindProperty("Count")->m_Value == 5);
+    EZ_TEST_BOOL(pConstNode->FindProperty("Pos") == nullptr);
+
+    pNode->RenameProperty("Count", "Amount");
+    EZ_TEST_BOOL(pConstNode->FindProperty("Count") == nullptr);
+    EZ_TEST_BOOL(pConstNode->FindProperty("Amount")->m_Value == 5);
+
+    pNode->RemoveProperty("Position");
+    EZ_TEST_BOOL(pConstNode->FindProperty("Position") == nullptr);
+    EZ_TEST_BOOL(pConstNode->FindProperty("Name")->m_Value == "Node");
+    EZ_TEST_INT(pConstNode->GetProperties().GetCount(), 2);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "GetContentHash")
+  {
+    ezVariantDictionary dict1;
+    dict1.Insert("a", 1);
+    dict1.Insert("b", ezVec2(1, 2));
+    ezVariantDictionary dict2;
+    dict2.Insert("b", ezVec2(1, 2));
+    dict2.Insert("a", 1);
+
+    ezAbstractObjectGraph graph;
+    ezAbstractObjectNode* pNode1 = graph.AddNode(MakeGraphTestGuid(0), "TestType", 1);
+    pNode1->AddProperty("Array", MakeGraphTestArray(0, 4));
+    pNode1->AddProperty("Dict", dict1);
+    pNode1->AddProperty("Color", ezColor::Red);
+
+    // same properties in a different order
+    ezAbstractObjectNode* pNode2 = graph.AddNode(MakeGraphTestGuid(1), "TestType", 1);
+    pNode2->AddProperty("Color", ezColor::Red);
+    pNode2->AddProperty("Dict", dict2);
+    pNode2->AddProperty("Array", MakeGraphTestArray(0, 4));
+
+    const ezUInt64 uiHash = pNode1->GetContentHash();
+    EZ_TEST_BOOL(uiHash == pNode2->GetContentHash());
+
+    // incremental updates
+    pNode2->ChangeProperty("Array", MakeGraphTestArray(1, 4));
+    EZ_TEST_BOOL(uiHash != pNode2->GetContentHash());
+    pNode2->ChangeProperty("Array", MakeGraphTestArray(0, 4));
+    EZ_TEST_BOOL(uiHash == pNode2->GetContentHash());
+
+    pNode2->RenameProperty("Color", "Tint");
+    EZ_TEST_BOOL(uiHash != pNode2->GetContentHash());
+    pNode2->RenameProperty("Tint", "Color");
+    EZ_TEST_BOOL(uiHash == pNode2->GetContentHash());
+
+    pNode2->AddProperty("Extra", ezVariant());
+    EZ_TEST_BOOL(uiHash != pNode2->GetContentHash());
+    pNode2->RemoveProperty("Extra");
+    EZ_TEST_BOOL(uiHash == pNode2->GetContentHash());
+
+    // modifications through the returned pointer discard the cached hash
+    pNode2->FindProperty("Color")->m_Value = ezColor::Blue;
+    EZ_TEST_BOOL(uiHash != pNode2->GetContentHash());
+    pNode2->FindProperty("Color")->m_Value = ezColor::Red;
+    EZ_TEST_BOOL(uiHash == pNode2->GetContentHash());
+
+    // the value type is part of the hash
+    pNode2->ChangeProperty("Color", ezColorGammaUB(255, 0, 0));
+    EZ_TEST_BOOL(uiHash != pNode2->GetContentHash());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "CreateDiffWithBaseGraph")
+  {
+    // enough nodes to hash them in parallel
+    const ezUInt32 uiNumNodes = 2000;
+
+    ezDynamicArray<ezUuid> guids;
+    ezAbstractObjectGraph base;
+    for (ezUInt32 i = 0; i < uiNumNodes; ++i)
+    {
+      guids.PushBack(MakeGraphTestGuid(i));
+
+      ezAbstractObjectNode* pNode = base.AddNode(guids[i], "TestType", 1);
+      pNode->AddProperty("Index", i);
+      pNode->AddProperty("Values", MakeGraphTestArray((ezInt32)i, 3));
+      pNode->AddProperty("Parent", i > 0 ? guids[i - 1] : ezUuid());
+    }
+
+    ezAbstractObjectGraph graph;
+    base.Clone(graph);
+
+    ezDeque<ezAbstractGraphDiffOperation> diff;
+    graph.CreateDiffWithBaseGraph(base, diff);
+    EZ_TEST_BOOL(diff.IsEmpty());
+
+    graph.GetNode(guids[10])->ChangeProperty("Index", 1234u);
+    graph.GetNode(guids[20])->ChangeProperty("Values", MakeGraphTestArray(0, 1));
+    graph.GetNode(guids[20])->AddProperty("Name", "Twenty");
+    graph.RemoveNode(guids[30]);
+    ezUuid addedGuid = MakeGraphTestGuid(uiNumNodes);
+    graph.AddNode(addedGuid, "OtherType", 2)->AddProperty("Index", 5);
+
+    graph.CreateDiffWithBaseGraph(base, diff);
+
+    ezUInt32 uiAdded = 0;
+    ezUInt32 uiRemoved = 0;
+    ezUInt32 uiChanged = 0;
+    for (const ezAbstractGraphDiffOperation& op : diff)
+    {
+      switch (op.m_Operation)
+      {
+        case ezAbstractGraphDiffOperation::Op::NodeAdded:
+          EZ_TEST_BOOL(op.m_Node == addedGuid);
+          EZ_TEST_STRING(op.m_sProperty, "OtherType");
+          ++uiAdded;
+          break;
+        case ezAbstractGraphDiffOperation::Op::NodeRemoved:
+          EZ_TEST_BOOL(op.m_Node == guids[30]);
+          ++uiRemoved;
+          break;
+        case ezAbstractGraphDiffOperation::Op::PropertyChanged:
+          EZ_TEST_BOOL(op.m_Node == guids[10] || op.m_Node == guids[20] || op.m_Node == addedGuid);
+          ++uiChanged;
+          break;
+      }
+    }
+
+    EZ_TEST_INT(uiAdded, 1);
+    EZ_TEST_INT(uiRemoved, 1);
+    EZ_TEST_INT(uiChanged, 4);
+
+    // applying the diff to the base graph has to reproduce the modified graph
+    for (ezAbstractGraphDiffOperation& op : diff)
+    {
+      if (op.m_Operation == ezAbstractGraphDiffOperation::Op::NodeAdded)
+        op.m_uiTypeVersion = 2;
+    }
+
+    base.ApplyDiff(diff);
+    EZ_TEST_INT(base.GetAllNodes().GetCount(), graph.GetAllNodes().GetCount());
+
+    for (auto it = graph.GetAllNodes().GetIterator(); it.IsValid(); ++it)
+    {
+      const ezAbstractObjectNode* pBaseNode = base.GetNode(it.Key());
+      if (EZ_TEST_BOOL(pBaseNode != nullptr))
+      {
+        EZ_TEST_BOOL(pBaseNode->GetContentHash() == it.Value()->GetContentHash());
+      }
+    }
+
+    graph.CreateDiffWithBaseGraph(base, diff);
+    EZ_TEST_BOOL(diff.IsEmpty());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "MergeDiffs")
+  {
+    ezUuid guids[2] = {MakeGraphTestGuid(0), MakeGraphTestGuid(1)};
+    if (guids[1] < guids[0])
+      ezMath::Swap(guids[0], guids[1]);
+
+    ezAbstractObjectGraph base;
+    for (const ezUuid& guid : guids)
+    {
+      ezAbstractObjectNode* pNode = base.AddNode(guid, "TestType", 1);
+      pNode->AddProperty("A", 1);
+      pNode->AddProperty("B", 2);
+    }
+
+    ezAbstractObjectGraph left;
+    base.Clone(left);
+    left.GetNode(guids[1])->ChangeProperty("B", 20);
+    left.GetNode(guids[0])->ChangeProperty("A", 10);
+
+    ezAbstractObjectGraph right;
+    base.Clone(right);
+    right.GetNode(guids[0])->ChangeProperty("A", 100);
+    right.GetNode(guids[0])->ChangeProperty("B", 200);
+
+    ezDeque<ezAbstractGraphDiffOperation> leftDiff;
+    left.CreateDiffWithBaseGraph(base, leftDiff);
+    ezDeque<ezAbstractGraphDiffOperation> rightDiff;
+    right.CreateDiffWithBaseGraph(base, rightDiff);
+
+    ezDeque<ezAbstractGraphDiffOperation> merged;
+    base.MergeDiffs(leftDiff, rightDiff, merged);
+
+    // property changes are sorted by node and property, conflicting changes are resolved in favor of the right side
+    if (EZ_TEST_INT(merged.GetCount(), 3))
+    {
+      EZ_TEST_BOOL(merged[0].m_Node == guids[0]);
+      EZ_TEST_STRING(merged[0].m_sProperty, "A");
+      EZ_TEST_BOOL(merged[0].m_Value == 100);
+
+      EZ_TEST_BOOL(merged[1].m_Node == guids[0]);
+      EZ_TEST_STRING(merged[1].m_sProperty, "B");
+      EZ_TEST_BOOL(merged[1].m_Value == 200);
+
+      EZ_TEST_BOOL(merged[2].m_Node == guids[1]);
+      EZ_TEST_STRING(merged[2].m_sProperty, "B");
+      EZ_TEST_BOOL(merged[2].m_Value == 20);
+    }
+  }
+}
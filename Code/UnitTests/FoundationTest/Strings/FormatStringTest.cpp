@@ -81,6 +81,17 @@ void CompareSnprintf(ezStringBuilder& log, const ezFormatString& str, const char
   va_end(args);
 }
 
+struct ezFormatStringTestCounted
+{
+  ezUInt32* m_pNumBuilds;
+};
+
+ezStringView BuildString(char* tmp, ezUInt32 uiLength, const ezFormatStringTestCounted& arg)
+{
+  ++(*arg.m_pNumBuilds);
+  return "counted";
+}
+
 EZ_CREATE_SIMPLE_TEST(Strings, FormatString)
 {
   ezStringBuilder perfLog;
@@ -233,6 +244,45 @@ EZ_CREATE_SIMPLE_TEST(Strings, FormatString)
     }
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Text Runs")
+  {
+    TestFormat(ezFmt("No placeholders at all"), "No placeholders at all");
+    TestFormat(ezFmt("100%% {0}%%", 42), "100% 42%");
+    TestFormat(ezFmt("{ {x} {0}} {", 1), "{ {x} 1} {");
+    TestFormat(ezFmt(u8"\u00C4{0}\u00D6{1}\u00DC", u8"\u00E4", 2), u8"\u00C4\u00E4\u00D62\u00DC");
+    TestFormat(ezFmt("{0}{0}{1}{0}", "a", "b"), "aaba");
+    TestFormat(ezFmt("{0} {3}", 1, 2), "1 ");
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Deferred Arguments")
+  {
+    ezUInt32 uiNumBuilds = 0;
+    ezFormatStringTestCounted counted = {&uiNumBuilds};
+
+    // nothing is converted before the text is requested
+    auto fmt = ezFmt("{0}, {0}, {2}", counted, counted, 3);
+    EZ_TEST_INT(uiNumBuilds, 0);
+
+    // every referenced argument is converted once, unreferenced arguments are never converted
+    TestFormat(fmt, "counted, counted, 3");
+    EZ_TEST_INT(uiNumBuilds, 1);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Numbers")
+  {
+    TestFormat(ezFmt("{0} {1} {2} {3}", 0, 9, 10, 99), "0 9 10 99");
+    TestFormat(ezFmt("{0} {1} {2}", 100, -1234567, 9876543210ll), "100 -1234567 9876543210");
+    TestFormat(ezFmt("{0} {1}", ezMath::MaxValue<ezInt64>(), ezMath::MaxValue<ezUInt64>()), "9223372036854775807 18446744073709551615");
+    TestFormat(ezFmt("{0}", ezArgI(42, 6, true)), "000042");
+    TestFormat(ezFmt("{0}", ezArgI(-42, 6, false)), "   -42");
+
+    TestFormat(ezFmt("{0} {1} {2} {3}", 0.0, -0.0, 5.0, -12.0), "0 0 5 -12");
+    TestFormat(ezFmt("{0} {1}", 9007199254740991.0, 9007199254740992.0), "9007199254740991 9007199254740992");
+    TestFormat(ezFmt("{0} {1} {2}", 0.5, -1.25, 3.0f), "0.5 -1.25 3");
+    TestFormat(ezFmt("{0}", ezArgF(2.0, 2)), "2.00");
+    TestFormat(ezFmt("{0}", ezArgF(-7.0, -1, false, 5, true)), "-0007");
+  }
+
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "Sensitive Info")
   {
     auto prev = ezArgSensitive::s_BuildStringCB;
@@ -281,6 +281,7 @@ EZ_CREATE_SIMPLE_TEST(Threading, Atomics)
 
     EZ_TEST_BOOL(g_pTestAndSetPointer != nullptr);
     EZ_TEST_INT(g_iTestAndSetPointerCounter, 1); // only one thread should have set the variable
+    EZ_TEST_BOOL(ezAtomicUtils::Read(&g_pTestAndSetPointer) == g_pTestAndSetPointer);
 
     EZ_TEST_BOOL(g_iCompareAndSwapVariable32 > 0);
     EZ_TEST_INT(g_iCompareAndSwapCounter32, 1); // only one thread should have set the variable
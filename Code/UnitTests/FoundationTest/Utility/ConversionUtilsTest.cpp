@@ -5,6 +5,100 @@
 
 EZ_CREATE_SIMPLE_TEST_GROUP(Utility);
 
+namespace
+{
+  // the digit by digit conversion that ezConversionUtils::StringToFloat used before digits were processed in blocks,
+  // only handles a single leading minus sign
+  double StringToFloatReference(const char* szString, const char*& out_szEnd)
+  {
+    const bool bNegative = (*szString == '-');
+    if (bNegative)
+      ++szString;
+
+    ezUInt64 uiIntegerPart = 0;
+    ezUInt64 uiFractionalPart = 0;
+    ezUInt64 uiFractionDivisor = 1;
+    ezUInt64 uiExponentPart = 0;
+    bool bExponentIsPositive = true;
+    ezInt32 iPart = 0;
+
+    for (;; ++szString)
+    {
+      const char c = *szString;
+
+      if (c == '_')
+        continue;
+
+      if (c >= '0' && c <= '9')
+      {
+        if (iPart == 0)
+          uiIntegerPart = uiIntegerPart * 10 + (c - '0');
+        else if (iPart == 1)
+        {
+          uiFractionalPart = uiFractionalPart * 10 + (c - '0');
+          uiFractionDivisor *= 10;
+        }
+        else
+          uiExponentPart = uiExponentPart * 10 + (c - '0');
+
+        continue;
+      }
+
+      if (c == '.' && iPart == 0)
+      {
+        iPart = 1;
+        continue;
+      }
+
+      if ((c == 'e' || c == 'E') && iPart < 2)
+      {
+        iPart = 2;
+
+        if (szString[1] == '-')
+        {
+          bExponentIsPositive = false;
+          ++szString;
+        }
+        else if (szString[1] == '+')
+          ++szString;
+
+        continue;
+      }
+
+      break;
+    }
+
+    out_szEnd = szString;
+
+    double fRes = (double)uiIntegerPart + (double)uiFractionalPart / (double)uiFractionDivisor;
+
+    if (bNegative)
+      fRes = -fRes;
+
+    if (iPart == 2)
+    {
+      if (bExponentIsPositive)
+        fRes *= ezMath::Pow(10.0, (double)uiExponentPart);
+      else
+        fRes /= ezMath::Pow(10.0, (double)uiExponentPart);
+    }
+
+    return fRes;
+  }
+
+  void AppendRandomDigits(ezRandom& ref_rnd, ezStringBuilder& ref_sText, ezUInt32 uiMaxDigits, bool bAllowUnderscores)
+  {
+    const ezUInt32 uiNumDigits = 1 + ref_rnd.UIntInRange(uiMaxDigits);
+    for (ezUInt32 i = 0; i < uiNumDigits; ++i)
+    {
+      if (bAllowUnderscores && i > 0 && ref_rnd.UIntInRange(10) == 0)
+        ref_sText.Append("_");
+
+      ref_sText.AppendFormat("{}", ref_rnd.UIntInRange(10));
+    }
+  }
+} // namespace
+
 EZ_CREATE_SIMPLE_TEST(Utility, ConversionUtils)
 {
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "StringToInt")
@@ -416,6 +510,108 @@ EZ_CREATE_SIMPLE_TEST(Utility, ConversionUtils)
     EZ_TEST_BOOL(szResultPos == szString + 25);
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "StringToFloat (bit exact)")
+  {
+    ezRandom rnd;
+    rnd.Initialize(42);
+
+    ezStringBuilder sText;
+    for (ezUInt32 i = 0; i < 20000; ++i)
+    {
+      sText.Clear();
+
+      if (rnd.UIntInRange(2) == 0)
+        sText.Append("-");
+
+      const bool bUnderscores = rnd.UIntInRange(8) == 0;
+      AppendRandomDigits(rnd, sText, 24, bUnderscores);
+
+      if (rnd.UIntInRange(4) != 0)
+      {
+        sText.Append(".");
+        AppendRandomDigits(rnd, sText, 24, bUnderscores);
+      }
+
+      if (rnd.UIntInRange(3) == 0)
+      {
+        sText.Append(rnd.UIntInRange(2) == 0 ? "e" : "E");
+        sText.Append(rnd.UIntInRange(2) == 0 ? "-" : "+");
+        AppendRandomDigits(rnd, sText, 3, false);
+      }
+
+      sText.Append(", 1");
+
+      const char* szExpectedEnd = nullptr;
+      const double fExpected = StringToFloatReference(sText, szExpectedEnd);
+
+      const char* szEnd = nullptr;
+      double fRes = 0;
+      EZ_TEST_BOOL(ezConversionUtils::StringToFloat(sText, fRes, &szEnd).Succeeded());
+      EZ_TEST_BOOL(szEnd == szExpectedEnd);
+
+      if (!EZ_TEST_BOOL_MSG(ezMemoryUtils::IsEqual(&fRes, &fExpected), "'%s' parsed differently", sText.GetData()))
+        break;
+    }
+
+    // all exponents that are looked up in a table
+    for (ezUInt32 uiExp = 0; uiExp < 30; ++uiExp)
+    {
+      sText.Format("1.2345e{}", uiExp);
+
+      const char* szExpectedEnd = nullptr;
+      const double fExpected = StringToFloatReference(sText, szExpectedEnd);
+
+      double fRes = 0;
+      EZ_TEST_BOOL(ezConversionUtils::StringToFloat(sText, fRes).Succeeded());
+      EZ_TEST_BOOL(ezMemoryUtils::IsEqual(&fRes, &fExpected));
+
+      sText.Format("1.2345e-{}", uiExp);
+      const double fExpectedNeg = StringToFloatReference(sText, szExpectedEnd);
+      EZ_TEST_BOOL(ezConversionUtils::StringToFloat(sText, fRes).Succeeded());
+      EZ_TEST_BOOL(ezMemoryUtils::IsEqual(&fRes, &fExpectedNeg));
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "StringToInt64 (long digit runs)")
+  {
+    ezInt64 iRes = 42;
+    const char* szResultPos = nullptr;
+
+    const char* szString = "123456789012345678+1"; // 18 digits
+    EZ_TEST_BOOL(ezConversionUtils::StringToInt64(szString, iRes, &szResultPos) == EZ_SUCCESS);
+    EZ_TEST_INT(iRes, 123456789012345678);
+    EZ_TEST_BOOL(szResultPos == szString + 18);
+
+    szString = "-999999999999999999"; // 18 digits
+    EZ_TEST_BOOL(ezConversionUtils::StringToInt64(szString, iRes, &szResultPos) == EZ_SUCCESS);
+    EZ_TEST_INT(iRes, -999999999999999999);
+    EZ_TEST_BOOL(szResultPos == szString + 19);
+
+    szString = "1234567890123456789"; // 19 digits
+    EZ_TEST_BOOL(ezConversionUtils::StringToInt64(szString, iRes, &szResultPos) == EZ_SUCCESS);
+    EZ_TEST_INT(iRes, 1234567890123456789);
+    EZ_TEST_BOOL(szResultPos == szString + 19);
+
+    iRes = 42;
+    szString = "123456789012345678901234567890"; // overflows
+    EZ_TEST_BOOL(ezConversionUtils::StringToInt64(szString, iRes, &szResultPos) == EZ_FAILURE);
+    EZ_TEST_INT(iRes, 42);
+
+    ezRandom rnd;
+    rnd.Initialize(17);
+
+    ezStringBuilder sText;
+    for (ezUInt32 i = 0; i < 1000; ++i)
+    {
+      const ezInt64 iValue = ((ezInt64)rnd.UInt() << 31) ^ (ezInt64)rnd.UInt();
+      const ezInt64 iSignedValue = (i % 2) == 0 ? iValue : -iValue;
+      sText.Format("{}", iSignedValue);
+
+      EZ_TEST_BOOL(ezConversionUtils::StringToInt64(sText, iRes).Succeeded());
+      EZ_TEST_INT(iRes, iSignedValue);
+    }
+  }
+
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "StringToBool")
   {
     const char* szString = "";
@@ -535,6 +731,86 @@ EZ_CREATE_SIMPLE_TEST(Utility, ConversionUtils)
     EZ_TEST_BOOL(szResultPos == nullptr);
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "StringToFloatArray")
+  {
+    const char* szText = " 1.5, -2,3e2\n\t4_000 ,, 0.25f";
+    const char* szEnd = nullptr;
+
+    double fValues[8] = {};
+    EZ_TEST_INT(ezConversionUtils::StringToFloatArray(szText, ezMakeArrayPtr(fValues), &szEnd), 5);
+    EZ_TEST_DOUBLE(fValues[0], 1.5, 0.0);
+    EZ_TEST_DOUBLE(fValues[1], -2.0, 0.0);
+    EZ_TEST_DOUBLE(fValues[2], 300.0, 0.0);
+    EZ_TEST_DOUBLE(fValues[3], 4000.0, 0.0);
+    EZ_TEST_DOUBLE(fValues[4], 0.25, 0.0);
+    EZ_TEST_STRING(szEnd, "f");
+
+    // stops when the array is full
+    float fFloats[2] = {};
+    EZ_TEST_INT(ezConversionUtils::StringToFloatArray(szText, ezMakeArrayPtr(fFloats), &szEnd), 2);
+    EZ_TEST_FLOAT(fFloats[0], 1.5f, 0.0f);
+    EZ_TEST_FLOAT(fFloats[1], -2.0f, 0.0f);
+    EZ_TEST_STRING(szEnd, ",3e2\n\t4_000 ,, 0.25f");
+
+    // stops at the first value that cannot be parsed
+    szText = "1 2 x 3";
+    EZ_TEST_INT(ezConversionUtils::StringToFloatArray(szText, ezMakeArrayPtr(fValues), &szEnd), 2);
+    EZ_TEST_BOOL(szEnd == szText + 3);
+
+    EZ_TEST_INT(ezConversionUtils::StringToFloatArray("", ezMakeArrayPtr(fValues), &szEnd), 0);
+    EZ_TEST_INT(ezConversionUtils::StringToFloatArray(nullptr, ezMakeArrayPtr(fValues)), 0);
+
+    // identical to parsing every value individually
+    ezRandom rnd;
+    rnd.Initialize(3);
+
+    ezStringBuilder sText;
+    for (ezUInt32 i = 0; i < 100; ++i)
+    {
+      AppendRandomDigits(rnd, sText, 12, false);
+      sText.Append(".");
+      AppendRandomDigits(rnd, sText, 12, false);
+      sText.Append(" ");
+    }
+
+    ezDynamicArray<double> values;
+    values.SetCount(100);
+    EZ_TEST_INT(ezConversionUtils::StringToFloatArray(sText, values, &szEnd), 100);
+    EZ_TEST_STRING(szEnd, " ");
+
+    szText = sText;
+    for (ezUInt32 i = 0; i < 100; ++i)
+    {
+      double fRes = 0;
+      EZ_TEST_BOOL(ezConversionUtils::StringToFloat(szText, fRes, &szText).Succeeded());
+      EZ_TEST_BOOL(ezMemoryUtils::IsEqual(&fRes, &values[i]));
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "StringToIntArray")
+  {
+    const char* szText = "1, -2 ,3\n0004 5000000000";
+    const char* szEnd = nullptr;
+
+    ezInt32 iValues[8] = {};
+    EZ_TEST_INT(ezConversionUtils::StringToIntArray(szText, ezMakeArrayPtr(iValues), &szEnd), 4);
+    EZ_TEST_INT(iValues[0], 1);
+    EZ_TEST_INT(iValues[1], -2);
+    EZ_TEST_INT(iValues[2], 3);
+    EZ_TEST_INT(iValues[3], 4);
+    EZ_TEST_STRING(szEnd, " 5000000000");
+
+    ezInt64 iValues64[8] = {};
+    EZ_TEST_INT(ezConversionUtils::StringToIntArray(szText, ezMakeArrayPtr(iValues64), &szEnd), 5);
+    EZ_TEST_INT(iValues64[3], 4);
+    EZ_TEST_INT(iValues64[4], 5000000000);
+    EZ_TEST_STRING(szEnd, "");
+
+    EZ_TEST_INT(ezConversionUtils::StringToIntArray("1.5", ezMakeArrayPtr(iValues), &szEnd), 1);
+    EZ_TEST_INT(iValues[0], 1);
+    EZ_TEST_STRING(szEnd, ".5");
+  }
+
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "HexCharacterToIntValue")
   {
     EZ_TEST_INT(ezConversionUtils::HexCharacterToIntValue('0'), 0);
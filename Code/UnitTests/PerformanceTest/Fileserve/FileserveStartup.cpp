@@ -0,0 +1,233 @@
+#include <PerformanceTestPCH.h>
+
+#ifdef EZ_PERFORMANCETEST_USE_FILESERVE
+
+#  include <FileservePlugin/Client/FileserveClient.h>
+#  include <FileservePlugin/Client/FileserveDataDir.h>
+#  include <FileservePlugin/Fileserver/Fileserver.h>
+#  include <Foundation/IO/FileSystem/FileReader.h>
+#  include <Foundation/IO/FileSystem/FileSystem.h>
+#  include <Foundation/IO/OSFile.h>
+#  include <Foundation/Threading/AtomicInteger.h>
+#  include <Foundation/Threading/Thread.h>
+#  include <Foundation/Types/ScopeExit.h>
+
+EZ_CREATE_SIMPLE_TEST_GROUP(Fileserve);
+
+namespace
+{
+  enum constants
+  {
+#  if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+    NUM_FILES = 200,
+#  else
+    NUM_FILES = 1000,
+#  endif
+    FILE_SIZE = 16 * 1024,
+    SERVER_PORT = 1043,
+  };
+
+  /// \brief Keeps the server responsive, while the client waits for the answers to its requests.
+  class ezFileserverThread : public ezThread
+  {
+  public:
+    ezFileserverThread()
+      : ezThread("Fileserver")
+    {
+    }
+
+    ezAtomicBool m_bKeepRunning;
+
+  private:
+    virtual ezUInt32 Run() override
+    {
+      while (m_bKeepRunning)
+      {
+        if (!ezFileserver::GetSingleton()->UpdateServer())
+        {
+          ezThreadUtils::YieldTimeSlice();
+        }
+      }
+
+      return 0;
+    }
+  };
+
+  /// \brief Serves a project with NUM_FILES files from a server in this process to a client in this process.
+  ///
+  /// Both communicate through the loopback device, so this measures the protocol overhead and not the bandwidth of a real network.
+  class ezFileserveLoopback
+  {
+  public:
+    ezFileserveLoopback()
+    {
+      m_sProjectDir = ezTestFramework::GetInstance()->GetAbsOutputPath();
+      m_sProjectDir.AppendPath("FileserveProject");
+
+      // compressible content, comparable to typical asset data
+      ezDynamicArray<ezUInt8> content;
+      content.SetCountUninitialized(FILE_SIZE);
+
+      ezStringBuilder sFile;
+      for (ezUInt32 i = 0; i < NUM_FILES; ++i)
+      {
+        for (ezUInt32 b = 0; b < FILE_SIZE; ++b)
+        {
+          content[b] = static_cast<ezUInt8>((b / 16) * 7 + i);
+        }
+
+        sFile.Format("{}/Data/File-{}.bin", m_sProjectDir, i);
+
+        ezOSFile file;
+        if (file.Open(sFile, ezFileOpenMode::Write).Succeeded())
+        {
+          file.Write(content.GetData(), content.GetCount()).IgnoreResult();
+        }
+      }
+
+      ezFileSystem::SetSpecialDirectory("fileservebenchmark", m_sProjectDir);
+
+      static bool s_bFactoryRegistered = false;
+      if (!s_bFactoryRegistered)
+      {
+        s_bFactoryRegistered = true;
+        ezFileSystem::RegisterDataDirectoryFactory(ezDataDirectory::FileserveType::Factory, 100.0f);
+      }
+
+      m_Server.SetPort(SERVER_PORT);
+      m_Server.StartServer();
+
+      // creating the server switches the client off
+      ezFileserveClient::EnableFileserveClient();
+
+      m_ServerThread.m_bKeepRunning = true;
+      m_ServerThread.Start();
+    }
+
+    ~ezFileserveLoopback()
+    {
+      m_ServerThread.m_bKeepRunning = false;
+      m_ServerThread.Join();
+
+      m_Server.StopServer();
+
+      ClearCache();
+      DeleteFiles(m_sProjectDir);
+    }
+
+    /// \brief Does what an application does at startup: connects to the server, mounts the data directory and reads all files.
+    ezUInt32 RunStartup(bool bClearCache)
+    {
+      ezFileserveClient* pClient = EZ_DEFAULT_NEW(ezFileserveClient);
+      EZ_SCOPE_EXIT(EZ_DEFAULT_DELETE(pClient));
+
+      ezStringBuilder sServer;
+      sServer.Format("localhost:{}", SERVER_PORT);
+      pClient->AddServerAddressToTry(sServer);
+
+      // the client reads the list of cached files when the data directory is mounted
+      if (bClearCache)
+      {
+        ClearCache();
+      }
+
+      if (ezFileSystem::AddDataDirectory(">fileservebenchmark/", "FileserveBenchmark", "fsbench").Failed())
+        return 0;
+
+      EZ_SCOPE_EXIT(ezFileSystem::RemoveDataDirectoryGroup("FileserveBenchmark"));
+
+      if (m_sCacheFolder.IsEmpty())
+      {
+        // the cache folder is named after the mount point, the same is used for the meta data
+        m_sCacheFolder = ezFileSystem::FindDataDirectoryWithRoot("fsbench")->GetRedirectedDataDirectoryPath();
+        ezStringBuilder sMountPoint = m_sCacheFolder.GetFileName();
+        m_sMetaFolder = ezOSFile::GetUserDataFolder("ezFileserve/Meta");
+        m_sMetaFolder.AppendPath(sMountPoint);
+
+        if (bClearCache)
+        {
+          ClearCache();
+        }
+      }
+
+      ezUInt32 uiBytesRead = 0;
+      ezUInt8 buffer[4096];
+
+      ezStringBuilder sFile;
+      for (ezUInt32 i = 0; i < NUM_FILES; ++i)
+      {
+        sFile.Format("Data/File-{}.bin", i);
+
+        ezFileReader file;
+        if (file.Open(sFile).Failed())
+          continue;
+
+        while (const ezUInt64 uiRead = file.ReadBytes(buffer, EZ_ARRAY_SIZE(buffer)))
+        {
+          uiBytesRead += static_cast<ezUInt32>(uiRead);
+        }
+      }
+
+      return uiBytesRead;
+    }
+
+  private:
+    void ClearCache()
+    {
+      if (m_sCacheFolder.IsEmpty())
+        return;
+
+      DeleteFiles(m_sCacheFolder);
+      DeleteFiles(m_sMetaFolder);
+
+      ezStringBuilder sFileList = m_sMetaFolder;
+      sFileList.Append(".files");
+      ezOSFile::DeleteFile(sFileList).IgnoreResult();
+    }
+
+    void DeleteFiles(const char* szFolder)
+    {
+      ezStringBuilder sFile;
+      for (ezUInt32 i = 0; i < NUM_FILES; ++i)
+      {
+        sFile.Format("{}/Data/File-{}.bin", szFolder, i);
+        ezOSFile::DeleteFile(sFile).IgnoreResult();
+      }
+    }
+
+    ezStringBuilder m_sProjectDir;
+    ezStringBuilder m_sCacheFolder;
+    ezStringBuilder m_sMetaFolder;
+    ezFileserver m_Server;
+    ezFileserverThread m_ServerThread;
+  };
+} // namespace
+
+EZ_CREATE_BENCHMARK(Fileserve, StartupWithEmptyCache)
+{
+  ezFileserveLoopback loopback;
+
+  benchmark.SetItemsPerIteration(NUM_FILES);
+
+  while (benchmark.KeepRunning())
+  {
+    EZ_TEST_INT(loopback.RunStartup(true), NUM_FILES * FILE_SIZE);
+  }
+}
+
+EZ_CREATE_BENCHMARK(Fileserve, StartupWithCache)
+{
+  ezFileserveLoopback loopback;
+
+  // fill the cache once, every following startup only has to validate it
+  EZ_TEST_INT(loopback.RunStartup(true), NUM_FILES * FILE_SIZE);
+
+  benchmark.SetItemsPerIteration(NUM_FILES);
+
+  while (benchmark.KeepRunning())
+  {
+    EZ_TEST_INT(loopback.RunStartup(false), NUM_FILES * FILE_SIZE);
+  }
+}
+
+#endif
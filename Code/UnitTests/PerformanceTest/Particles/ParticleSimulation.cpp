@@ -0,0 +1,151 @@
+#include <PerformanceTestPCH.h>
+
+#include <Foundation/DataProcessing/Stream/ProcessingStreamGroup.h>
+#include <Foundation/DataProcessing/Stream/ProcessingStreamIterator.h>
+#include <Foundation/DataProcessing/Stream/ProcessingStreamProcessor.h>
+#include <Foundation/Reflection/Reflection.h>
+
+EZ_CREATE_SIMPLE_TEST_GROUP(Particles);
+
+namespace
+{
+  enum constants
+  {
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+    NUM_PARTICLES = 10000,
+#else
+    NUM_PARTICLES = 100000,
+#endif
+  };
+
+  /// \brief Gives new particles a start position, a velocity and a lifetime, similar to the emitter and initializers of a particle effect.
+  class ezPerfParticleSpawner : public ezProcessingStreamProcessor
+  {
+    EZ_ADD_DYNAMIC_REFLECTION(ezPerfParticleSpawner, ezProcessingStreamProcessor);
+
+  protected:
+    virtual ezResult UpdateStreamBindings() override
+    {
+      m_pPosition = m_pStreamGroup->GetStreamByName("Position");
+      m_pVelocity = m_pStreamGroup->GetStreamByName("Velocity");
+      m_pLifeTime = m_pStreamGroup->GetStreamByName("LifeTime");
+
+      return (m_pPosition && m_pVelocity && m_pLifeTime) ? EZ_SUCCESS : EZ_FAILURE;
+    }
+
+    virtual void InitializeElements(ezUInt64 uiStartIndex, ezUInt64 uiNumElements) override
+    {
+      ezProcessingStreamIterator<ezVec3> itPosition(m_pPosition, uiNumElements, uiStartIndex);
+      ezProcessingStreamIterator<ezVec3> itVelocity(m_pVelocity, uiNumElements, uiStartIndex);
+      ezProcessingStreamIterator<float> itLifeTime(m_pLifeTime, uiNumElements, uiStartIndex);
+
+      while (!itPosition.HasReachedEnd())
+      {
+        // a cheap pseudo-random sequence, to spread the velocities and life times
+        m_uiSeed = m_uiSeed * 1664525u + 1013904223u;
+        const float fRandom = static_cast<float>(m_uiSeed >> 8) / static_cast<float>(1 << 24);
+
+        itPosition.Current().SetZero();
+        itVelocity.Current().Set(fRandom * 2.0f - 1.0f, 1.0f - fRandom, 5.0f + fRandom * 5.0f);
+        itLifeTime.Current() = 0.5f + fRandom;
+
+        itPosition.Advance();
+        itVelocity.Advance();
+        itLifeTime.Advance();
+      }
+    }
+
+    virtual void Process(ezUInt64 uiNumElements) override {}
+
+    ezProcessingStream* m_pPosition = nullptr;
+    ezProcessingStream* m_pVelocity = nullptr;
+    ezProcessingStream* m_pLifeTime = nullptr;
+    ezUInt32 m_uiSeed = 0;
+  };
+
+  // clang-format off
+  EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezPerfParticleSpawner, 1, ezRTTIDefaultAllocator<ezPerfParticleSpawner>)
+  EZ_END_DYNAMIC_REFLECTED_TYPE;
+  // clang-format on
+
+  /// \brief Applies gravity and velocity to all particles and removes the particles whose life time ran out.
+  class ezPerfParticleIntegrator : public ezProcessingStreamProcessor
+  {
+    EZ_ADD_DYNAMIC_REFLECTION(ezPerfParticleIntegrator, ezProcessingStreamProcessor);
+
+  public:
+    float m_fTimeStep = 1.0f / 60.0f;
+
+  protected:
+    virtual ezResult UpdateStreamBindings() override
+    {
+      m_pPosition = m_pStreamGroup->GetStreamByName("Position");
+      m_pVelocity = m_pStreamGroup->GetStreamByName("Velocity");
+      m_pLifeTime = m_pStreamGroup->GetStreamByName("LifeTime");
+
+      return (m_pPosition && m_pVelocity && m_pLifeTime) ? EZ_SUCCESS : EZ_FAILURE;
+    }
+
+    virtual void InitializeElements(ezUInt64 uiStartIndex, ezUInt64 uiNumElements) override {}
+
+    virtual void Process(ezUInt64 uiNumElements) override
+    {
+      const ezVec3 vGravityStep = ezVec3(0.0f, 0.0f, -9.81f) * m_fTimeStep;
+
+      ezProcessingStreamIterator<ezVec3> itPosition(m_pPosition, uiNumElements, 0);
+      ezProcessingStreamIterator<ezVec3> itVelocity(m_pVelocity, uiNumElements, 0);
+      ezProcessingStreamIterator<float> itLifeTime(m_pLifeTime, uiNumElements, 0);
+
+      for (ezUInt64 i = 0; i < uiNumElements; ++i)
+      {
+        itVelocity.Current() += vGravityStep;
+        itPosition.Current() += itVelocity.Current() * m_fTimeStep;
+        itLifeTime.Current() -= m_fTimeStep;
+
+        if (itLifeTime.Current() <= 0.0f)
+        {
+          m_pStreamGroup->RemoveElement(i);
+        }
+
+        itPosition.Advance();
+        itVelocity.Advance();
+        itLifeTime.Advance();
+      }
+    }
+
+    ezProcessingStream* m_pPosition = nullptr;
+    ezProcessingStream* m_pVelocity = nullptr;
+    ezProcessingStream* m_pLifeTime = nullptr;
+  };
+
+  // clang-format off
+  EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezPerfParticleIntegrator, 1, ezRTTIDefaultAllocator<ezPerfParticleIntegrator>)
+  EZ_END_DYNAMIC_REFLECTED_TYPE;
+  // clang-format on
+} // namespace
+
+EZ_CREATE_BENCHMARK(Particles, SimulateParticles)
+{
+  ezProcessingStreamGroup group;
+  group.AddStream("Position", ezProcessingStream::DataType::Float3);
+  group.AddStream("Velocity", ezProcessingStream::DataType::Float3);
+  group.AddStream("LifeTime", ezProcessingStream::DataType::Float);
+
+  group.AddProcessor(EZ_DEFAULT_NEW(ezPerfParticleSpawner));
+  group.AddProcessor(EZ_DEFAULT_NEW(ezPerfParticleIntegrator));
+
+  group.SetSize(NUM_PARTICLES);
+  group.InitializeElements(NUM_PARTICLES);
+  group.Process();
+
+  EZ_TEST_INT(group.GetNumActiveElements(), NUM_PARTICLES);
+
+  benchmark.SetItemsPerIteration(NUM_PARTICLES);
+
+  while (benchmark.KeepRunning())
+  {
+    // like a continuous emitter, replace every particle that died in the last frame
+    group.InitializeElements(NUM_PARTICLES - group.GetNumActiveElements());
+    group.Process();
+  }
+}
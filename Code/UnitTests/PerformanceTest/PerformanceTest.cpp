@@ -0,0 +1,13 @@
+#include <PerformanceTestPCH.h>
+
+#include <TestFramework/Framework/TestFramework.h>
+#include <TestFramework/Utilities/TestSetup.h>
+
+/* The PerformanceTest runs reproducible end-to-end workloads of the engine as benchmarks (see EZ_CREATE_BENCHMARK).
+
+Run it headless with '-nogui -all -close -benchmarkJson <file>' to get machine-readable results, and add '-benchmarkBaseline <file>'
+to compare them against an earlier run.
+
+*/
+
+EZ_TESTFRAMEWORK_ENTRY_POINT("PerformanceTest", "Performance Tests")
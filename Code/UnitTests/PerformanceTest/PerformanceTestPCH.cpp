@@ -0,0 +1 @@
+#include <PerformanceTestPCH.h>
@@ -0,0 +1,7 @@
+#pragma once
+
+#include <TestFramework/Framework/TestFramework.h>
+
+#include <Foundation/Basics.h>
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Strings/StringBuilder.h>
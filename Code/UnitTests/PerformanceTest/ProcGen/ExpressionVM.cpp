@@ -0,0 +1,125 @@
+#include <PerformanceTestPCH.h>
+
+#include <ProcGenPlugin/VM/ExpressionAST.h>
+#include <ProcGenPlugin/VM/ExpressionByteCode.h>
+#include <ProcGenPlugin/VM/ExpressionCompiler.h>
+#include <ProcGenPlugin/VM/ExpressionVM.h>
+
+EZ_CREATE_SIMPLE_TEST_GROUP(ProcGen);
+
+namespace
+{
+  enum constants
+  {
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+    NUM_INSTANCES = 10000,
+#else
+    NUM_INSTANCES = 100000,
+#endif
+  };
+
+  struct ezPerfPlacementPoint
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezVec3 m_vPosition;
+    ezVec3 m_vNormal;
+  };
+
+  struct ezPerfPlacementResult
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    float m_fDensity;
+    float m_fScale;
+  };
+
+  /// \brief Builds an expression that resembles a typical placement graph: a density pattern that is masked by the slope of the surface.
+  void BuildPlacementExpression(ezExpressionAST& ast)
+  {
+    typedef ezExpressionAST::NodeType NodeType;
+
+    auto pPosX = ast.CreateInput(ezMakeHashedString("PositionX"));
+    auto pPosY = ast.CreateInput(ezMakeHashedString("PositionY"));
+    auto pPosZ = ast.CreateInput(ezMakeHashedString("PositionZ"));
+    auto pNormalZ = ast.CreateInput(ezMakeHashedString("NormalZ"));
+
+    auto pFrequency = ast.CreateConstant(0.1f);
+    auto pHalf = ast.CreateConstant(0.5f);
+
+    auto pWaveX = ast.CreateUnaryOperator(NodeType::Sin, ast.CreateBinaryOperator(NodeType::Multiply, pPosX, pFrequency));
+    auto pWaveY = ast.CreateUnaryOperator(NodeType::Cos, ast.CreateBinaryOperator(NodeType::Multiply, pPosY, pFrequency));
+    auto pPattern = ast.CreateBinaryOperator(NodeType::Add, ast.CreateBinaryOperator(NodeType::Multiply, pWaveX, pWaveY), pHalf);
+
+    auto pSlope = ast.CreateBinaryOperator(NodeType::Max, pNormalZ, ast.CreateConstant(0.0f));
+    auto pDensity = ast.CreateBinaryOperator(NodeType::Min, ast.CreateBinaryOperator(NodeType::Multiply, pPattern, pSlope), ast.CreateConstant(1.0f));
+
+    auto pScale = ast.CreateBinaryOperator(NodeType::Add, ast.CreateUnaryOperator(NodeType::Sqrt, ast.CreateUnaryOperator(NodeType::Absolute, pPosZ)), pHalf);
+
+    ast.m_OutputNodes.PushBack(ast.CreateOutput(ezMakeHashedString("Density"), pDensity));
+    ast.m_OutputNodes.PushBack(ast.CreateOutput(ezMakeHashedString("Scale"), pScale));
+  }
+} // namespace
+
+EZ_CREATE_BENCHMARK(ProcGen, CompileExpression)
+{
+  ezExpressionCompiler compiler;
+  ezExpressionByteCode byteCode;
+
+  while (benchmark.KeepRunning())
+  {
+    ezExpressionAST ast;
+    BuildPlacementExpression(ast);
+
+    compiler.Compile(ast, byteCode).IgnoreResult();
+  }
+}
+
+EZ_CREATE_BENCHMARK(ProcGen, ExecuteExpression)
+{
+  ezExpressionByteCode byteCode;
+  {
+    ezExpressionAST ast;
+    BuildPlacementExpression(ast);
+
+    ezExpressionCompiler compiler;
+    EZ_TEST_BOOL(compiler.Compile(ast, byteCode).Succeeded());
+  }
+
+  ezDynamicArray<ezPerfPlacementPoint> points;
+  points.SetCountUninitialized(NUM_INSTANCES);
+
+  for (ezUInt32 i = 0; i < NUM_INSTANCES; ++i)
+  {
+    const float f = static_cast<float>(i);
+    points[i].m_vPosition.Set(ezMath::Mod(f, 512.0f), f / 512.0f, ezMath::Sin(ezAngle::Radian(f * 0.01f)) * 10.0f);
+    points[i].m_vNormal.Set(0.0f, 0.0f, 1.0f);
+  }
+
+  ezDynamicArray<ezPerfPlacementResult> results;
+  results.SetCountUninitialized(NUM_INSTANCES);
+
+  ezHybridArray<ezExpression::Stream, 4> inputs;
+  inputs.PushBack(ezExpression::MakeStream(points.GetArrayPtr(), offsetof(ezPerfPlacementPoint, m_vPosition.x), ezMakeHashedString("PositionX")));
+  inputs.PushBack(ezExpression::MakeStream(points.GetArrayPtr(), offsetof(ezPerfPlacementPoint, m_vPosition.y), ezMakeHashedString("PositionY")));
+  inputs.PushBack(ezExpression::MakeStream(points.GetArrayPtr(), offsetof(ezPerfPlacementPoint, m_vPosition.z), ezMakeHashedString("PositionZ")));
+  inputs.PushBack(ezExpression::MakeStream(points.GetArrayPtr(), offsetof(ezPerfPlacementPoint, m_vNormal.z), ezMakeHashedString("NormalZ")));
+
+  ezHybridArray<ezExpression::Stream, 2> outputs;
+  outputs.PushBack(ezExpression::MakeStream(results.GetArrayPtr(), offsetof(ezPerfPlacementResult, m_fDensity), ezMakeHashedString("Density")));
+  outputs.PushBack(ezExpression::MakeStream(results.GetArrayPtr(), offsetof(ezPerfPlacementResult, m_fScale), ezMakeHashedString("Scale")));
+
+  ezExpressionVM vm;
+  vm.RegisterDefaultFunctions();
+
+  EZ_TEST_BOOL(vm.Execute(byteCode, inputs, outputs, NUM_INSTANCES).Succeeded());
+  EZ_TEST_FLOAT(results[0].m_fDensity, 0.5f, 0.0001f);
+  EZ_TEST_FLOAT(results[0].m_fScale, 0.5f, 0.0001f);
+
+  benchmark.SetItemsPerIteration(NUM_INSTANCES);
+
+  while (benchmark.KeepRunning())
+  {
+    vm.Execute(byteCode, inputs, outputs, NUM_INSTANCES).IgnoreResult();
+  }
+}
@@ -0,0 +1,168 @@
+#include <PerformanceTestPCH.h>
+
+#include <Core/ResourceManager/ResourceManager.h>
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/Threading/ThreadUtils.h>
+#include <Foundation/Types/ScopeExit.h>
+
+EZ_CREATE_SIMPLE_TEST_GROUP(ResourceManager);
+
+namespace
+{
+  enum constants
+  {
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+    NUM_RESOURCES = 1000,
+#else
+    NUM_RESOURCES = 10000,
+#endif
+    NUM_RESOURCE_ELEMENTS = 256,
+  };
+
+  typedef ezTypedResourceHandle<class ezPerfResource> ezPerfResourceHandle;
+
+  /// \brief A resource that only stores an array of integers, such that the benchmark measures the overhead of the resource manager.
+  class ezPerfResource : public ezResource
+  {
+    EZ_ADD_DYNAMIC_REFLECTION(ezPerfResource, ezResource);
+    EZ_RESOURCE_DECLARE_COMMON_CODE(ezPerfResource);
+
+  public:
+    ezPerfResource()
+      : ezResource(ezResource::DoUpdate::OnAnyThread, 1)
+    {
+    }
+
+    ezUInt32 GetNumElements() const { return m_Data.GetCount(); }
+
+  protected:
+    virtual ezResourceLoadDesc UnloadData(Unload WhatToUnload) override
+    {
+      m_Data.Clear();
+      m_Data.Compact();
+
+      ezResourceLoadDesc ld;
+      ld.m_State = ezResourceState::Unloaded;
+      ld.m_uiQualityLevelsDiscardable = 0;
+      ld.m_uiQualityLevelsLoadable = 0;
+
+      return ld;
+    }
+
+    virtual ezResourceLoadDesc UpdateContent(ezStreamReader* Stream) override
+    {
+      ezUInt32 uiNumElements = 0;
+      *Stream >> uiNumElements;
+
+      m_Data.SetCountUninitialized(uiNumElements);
+      Stream->ReadBytes(m_Data.GetData(), uiNumElements * sizeof(ezUInt32));
+
+      ezResourceLoadDesc ld;
+      ld.m_State = ezResourceState::Loaded;
+      ld.m_uiQualityLevelsDiscardable = 0;
+      ld.m_uiQualityLevelsLoadable = 0;
+
+      return ld;
+    }
+
+    virtual void UpdateMemoryUsage(MemoryUsage& out_NewMemoryUsage) override
+    {
+      out_NewMemoryUsage.m_uiMemoryCPU = sizeof(ezPerfResource) + m_Data.GetHeapMemoryUsage();
+      out_NewMemoryUsage.m_uiMemoryGPU = 0;
+    }
+
+  private:
+    ezDynamicArray<ezUInt32> m_Data;
+  };
+
+  /// \brief Stands in for an asset archive: all resources are served from one prepared block of memory.
+  class ezPerfResourceTypeLoader : public ezResourceTypeLoader
+  {
+  public:
+    ezPerfResourceTypeLoader()
+    {
+      ezMemoryStreamWriter writer(&m_Archive);
+
+      writer << static_cast<ezUInt32>(NUM_RESOURCE_ELEMENTS);
+
+      for (ezUInt32 i = 0; i < NUM_RESOURCE_ELEMENTS; ++i)
+      {
+        writer << i;
+      }
+    }
+
+    virtual ezResourceLoadData OpenDataStream(const ezResource* pResource) override
+    {
+      ezMemoryStreamReader* pReader = EZ_DEFAULT_NEW(ezMemoryStreamReader, &m_Archive);
+
+      ezResourceLoadData ld;
+      ld.m_pCustomLoaderData = pReader;
+      ld.m_pDataStream = pReader;
+      ld.m_sResourceDescription = pResource->GetResourceID();
+
+      return ld;
+    }
+
+    virtual void CloseDataStream(const ezResource* pResource, const ezResourceLoadData& LoaderData) override
+    {
+      ezMemoryStreamReader* pReader = static_cast<ezMemoryStreamReader*>(LoaderData.m_pCustomLoaderData);
+      EZ_DEFAULT_DELETE(pReader);
+    }
+
+  private:
+    ezMemoryStreamStorage m_Archive;
+  };
+
+  EZ_RESOURCE_IMPLEMENT_COMMON_CODE(ezPerfResource);
+  EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezPerfResource, 1, ezRTTIDefaultAllocator<ezPerfResource>)
+  EZ_END_DYNAMIC_REFLECTED_TYPE;
+
+} // namespace
+
+EZ_CREATE_BENCHMARK(ResourceManager, LoadAndUnload)
+{
+  ezPerfResourceTypeLoader TypeLoader;
+  ezResourceManager::SetResourceTypeLoader<ezPerfResource>(&TypeLoader);
+  EZ_SCOPE_EXIT(ezResourceManager::SetResourceTypeLoader<ezPerfResource>(nullptr));
+
+  ezDynamicArray<ezString> resourceIDs;
+  resourceIDs.SetCount(NUM_RESOURCES);
+
+  ezStringBuilder sResourceID;
+  for (ezUInt32 i = 0; i < NUM_RESOURCES; ++i)
+  {
+    sResourceID.Format("PerfResource-{}", i);
+    resourceIDs[i] = sResourceID;
+  }
+
+  ezDynamicArray<ezPerfResourceHandle> hResources;
+  hResources.Reserve(NUM_RESOURCES);
+
+  benchmark.SetItemsPerIteration(NUM_RESOURCES);
+
+  while (benchmark.KeepRunning())
+  {
+    for (ezUInt32 i = 0; i < NUM_RESOURCES; ++i)
+    {
+      hResources.PushBack(ezResourceManager::LoadResource<ezPerfResource>(resourceIDs[i]));
+      ezResourceManager::PreloadResource(hResources[i]);
+    }
+
+    for (ezUInt32 i = 0; i < NUM_RESOURCES; ++i)
+    {
+      ezResourceLock<ezPerfResource> pResource(hResources[i], ezResourceAcquireMode::BlockTillLoaded_NeverFail);
+      EZ_ASSERT_DEBUG(pResource->GetNumElements() == NUM_RESOURCE_ELEMENTS, "Resource was not loaded correctly");
+    }
+
+    hResources.Clear();
+
+    // if a resource is still in a loading queue, unloading it can 'fail' for a short time
+    while (ezResourceManager::GetAllResourcesOfType<ezPerfResource>()->GetCount() > 0)
+    {
+      if (ezResourceManager::FreeAllUnusedResources() == 0)
+      {
+        ezThreadUtils::YieldTimeSlice();
+      }
+    }
+  }
+}
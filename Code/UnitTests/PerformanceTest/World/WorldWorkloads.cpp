@@ -0,0 +1,212 @@
+#include <PerformanceTestPCH.h>
+
+#include <Core/Messages/UpdateLocalBoundsMessage.h>
+#include <Core/World/World.h>
+#include <Foundation/Math/Frustum.h>
+
+EZ_CREATE_SIMPLE_TEST_GROUP(World);
+
+namespace
+{
+  enum constants
+  {
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+    NUM_CREATED_OBJECTS = 100000,
+    NUM_UPDATED_COMPONENTS = 10000,
+    NUM_CULLED_OBJECTS = 10000,
+#else
+    NUM_CREATED_OBJECTS = 1000000,
+    NUM_UPDATED_COMPONENTS = 100000,
+    NUM_CULLED_OBJECTS = 100000,
+#endif
+  };
+
+  class ezPerfRotatingComponentManager;
+
+  /// \brief Rotates its owner a bit every update, which also forces the transform and bounds of the owner to be updated.
+  class ezPerfRotatingComponent : public ezComponent
+  {
+    EZ_DECLARE_COMPONENT_TYPE(ezPerfRotatingComponent, ezComponent, ezPerfRotatingComponentManager);
+
+  public:
+    ezAngle m_Speed = ezAngle::Degree(2.0f);
+  };
+
+  class ezPerfRotatingComponentManager : public ezComponentManager<ezPerfRotatingComponent, ezBlockStorageType::FreeList>
+  {
+  public:
+    ezPerfRotatingComponentManager(ezWorld* pWorld)
+      : ezComponentManager<ezPerfRotatingComponent, ezBlockStorageType::FreeList>(pWorld)
+    {
+    }
+
+    virtual void Initialize() override
+    {
+      auto desc = ezWorldModule::UpdateFunctionDesc(ezWorldModule::UpdateFunction(&ezPerfRotatingComponentManager::Update, this), "Update");
+      desc.m_bOnlyUpdateWhenSimulating = false;
+
+      RegisterUpdateFunction(desc);
+    }
+
+    void Update(const ezWorldModule::UpdateContext& context)
+    {
+      for (auto it = this->m_ComponentStorage.GetIterator(context.m_uiFirstComponentIndex, context.m_uiComponentCount); it.IsValid(); ++it)
+      {
+        ComponentType* pComponent = it;
+        if (pComponent->IsActiveAndInitialized())
+        {
+          ezQuat qRot;
+          qRot.SetFromAxisAndAngle(ezVec3(0, 0, 1), pComponent->m_Speed);
+
+          ezGameObject* pOwner = pComponent->GetOwner();
+          pOwner->SetLocalRotation(qRot * pOwner->GetLocalRotation());
+        }
+      }
+    }
+  };
+
+  // clang-format off
+  EZ_BEGIN_COMPONENT_TYPE(ezPerfRotatingComponent, 1, ezComponentMode::Dynamic);
+  EZ_END_COMPONENT_TYPE;
+  // clang-format on
+
+  typedef ezComponentManager<class ezPerfBoundsComponent, ezBlockStorageType::Compact> ezPerfBoundsComponentManager;
+
+  /// \brief Gives its owner fixed bounds, like a mesh would.
+  class ezPerfBoundsComponent : public ezComponent
+  {
+    EZ_DECLARE_COMPONENT_TYPE(ezPerfBoundsComponent, ezComponent, ezPerfBoundsComponentManager);
+
+  public:
+    virtual void Initialize() override { GetOwner()->UpdateLocalBounds(); }
+
+    void OnUpdateLocalBounds(ezMsgUpdateLocalBounds& msg)
+    {
+      ezBoundingBox bounds;
+      bounds.SetCenterAndHalfExtents(ezVec3::ZeroVector(), ezVec3(1.0f));
+
+      msg.AddBounds(bounds, GetOwner()->IsDynamic() ? ezDefaultSpatialDataCategories::RenderDynamic : ezDefaultSpatialDataCategories::RenderStatic);
+    }
+  };
+
+  // clang-format off
+  EZ_BEGIN_COMPONENT_TYPE(ezPerfBoundsComponent, 1, ezComponentMode::Static)
+  {
+    EZ_BEGIN_MESSAGEHANDLERS
+    {
+      EZ_MESSAGE_HANDLER(ezMsgUpdateLocalBounds, OnUpdateLocalBounds)
+    }
+    EZ_END_MESSAGEHANDLERS;
+  }
+  EZ_END_COMPONENT_TYPE;
+  // clang-format on
+
+  /// \brief Places the objects on a square grid in the XY plane, with 4 units between them.
+  ezVec3 GetGridPosition(ezUInt32 uiIndex, ezUInt32 uiNumObjects)
+  {
+    const ezUInt32 uiGridSize = static_cast<ezUInt32>(ezMath::Ceil(ezMath::Sqrt(static_cast<double>(uiNumObjects))));
+    return ezVec3(static_cast<float>(uiIndex % uiGridSize) * 4.0f, static_cast<float>(uiIndex / uiGridSize) * 4.0f, 0.0f);
+  }
+} // namespace
+
+EZ_CREATE_BENCHMARK(World, CreateAndDestroyObjects)
+{
+  ezWorldDesc worldDesc("Performance");
+  ezWorld world(worldDesc);
+  EZ_LOCK(world.GetWriteMarker());
+
+  benchmark.SetItemsPerIteration(NUM_CREATED_OBJECTS);
+
+  ezGameObjectDesc desc;
+  desc.m_bDynamic = true;
+
+  while (benchmark.KeepRunning())
+  {
+    for (ezUInt32 i = 0; i < NUM_CREATED_OBJECTS; ++i)
+    {
+      desc.m_LocalPosition = GetGridPosition(i, NUM_CREATED_OBJECTS);
+      world.CreateObject(desc);
+    }
+
+    // the objects are deleted during the update
+    world.Clear();
+    world.Update();
+  }
+}
+
+EZ_CREATE_BENCHMARK(World, UpdateComponents)
+{
+  ezWorldDesc worldDesc("Performance");
+  ezWorld world(worldDesc);
+  EZ_LOCK(world.GetWriteMarker());
+
+  for (ezUInt32 i = 0; i < NUM_UPDATED_COMPONENTS; ++i)
+  {
+    ezGameObjectDesc desc;
+    desc.m_bDynamic = true;
+    desc.m_LocalPosition = GetGridPosition(i, NUM_UPDATED_COMPONENTS);
+
+    ezGameObject* pObject = nullptr;
+    world.CreateObject(desc, pObject);
+
+    ezPerfRotatingComponent* pComponent = nullptr;
+    ezPerfRotatingComponent::CreateComponent(pObject, pComponent);
+    ezPerfBoundsComponent* pBounds = nullptr;
+    ezPerfBoundsComponent::CreateComponent(pObject, pBounds);
+  }
+
+  // the first update initializes the components
+  world.Update();
+
+  benchmark.SetItemsPerIteration(NUM_UPDATED_COMPONENTS);
+
+  while (benchmark.KeepRunning())
+  {
+    world.Update();
+  }
+}
+
+EZ_CREATE_BENCHMARK(World, FindVisibleObjects)
+{
+  ezWorldDesc worldDesc("Performance");
+  ezWorld world(worldDesc);
+  EZ_LOCK(world.GetWriteMarker());
+
+  for (ezUInt32 i = 0; i < NUM_CULLED_OBJECTS; ++i)
+  {
+    ezGameObjectDesc desc;
+    desc.m_bDynamic = (i % 4) == 0;
+    desc.m_LocalPosition = GetGridPosition(i, NUM_CULLED_OBJECTS);
+
+    ezGameObject* pObject = nullptr;
+    world.CreateObject(desc, pObject);
+
+    ezPerfBoundsComponent* pComponent = nullptr;
+    ezPerfBoundsComponent::CreateComponent(pObject, pComponent);
+  }
+
+  world.Update();
+
+  // a camera above one corner of the grid, looking at its center, only sees a part of the objects
+  const ezVec3 vGridCenter = GetGridPosition(NUM_CULLED_OBJECTS - 1, NUM_CULLED_OBJECTS) * 0.5f;
+  const ezVec3 vCameraPos(0.0f, 0.0f, 100.0f);
+
+  ezFrustum frustum;
+  frustum.SetFrustum(vCameraPos, (vGridCenter - vCameraPos).GetNormalized(), ezVec3(0, 0, 1), ezAngle::Degree(90.0f), ezAngle::Degree(60.0f), 0.1f, 5000.0f);
+
+  const ezUInt32 uiCategoryBitmask = ezDefaultSpatialDataCategories::RenderStatic.GetBitmask() | ezDefaultSpatialDataCategories::RenderDynamic.GetBitmask();
+
+  ezDynamicArray<const ezGameObject*> visibleObjects;
+  world.GetSpatialSystem()->FindVisibleObjects(frustum, uiCategoryBitmask, visibleObjects);
+
+  EZ_TEST_BOOL(!visibleObjects.IsEmpty());
+  EZ_TEST_BOOL(visibleObjects.GetCount() < NUM_CULLED_OBJECTS);
+
+  benchmark.SetItemsPerIteration(NUM_CULLED_OBJECTS);
+
+  while (benchmark.KeepRunning())
+  {
+    visibleObjects.Clear();
+    world.GetSpatialSystem()->FindVisibleObjects(frustum, uiCategoryBitmask, visibleObjects);
+  }
+}
@@ -0,0 +1,404 @@
+#include <TestFrameworkPCH.h>
+
+#include <Foundation/IO/FileSystem/FileReader.h>
+#include <Foundation/IO/JSONReader.h>
+#include <Foundation/Memory/AllocatorBase.h>
+#include <Foundation/Types/ScopeExit.h>
+#include <TestFramework/Framework/Benchmark.h>
+#include <TestFramework/Framework/TestFramework.h>
+
+#if EZ_ENABLED(EZ_PLATFORM_WINDOWS)
+#  include <Foundation/Basics/Platform/Win/IncludeWindows.h>
+#elif EZ_ENABLED(EZ_PLATFORM_LINUX)
+#  include <pthread.h>
+#  include <sched.h>
+#endif
+
+namespace
+{
+  // the results are kept across sub-tests, so they must not use the ez allocators, which are checked for leaks after every sub-test
+  static std::vector<ezBenchmarkResult> s_BenchmarkResults;
+  static std::vector<ezBenchmarkResult> s_BenchmarkBaseline;
+  static std::string s_sBenchmarkBaselineFile;
+
+  /// \brief Pins the calling thread to one CPU core, for as long as the object exists.
+  class ezBenchmarkCpuPinning
+  {
+  public:
+    ezBenchmarkCpuPinning(ezInt32 iCpu)
+    {
+      if (iCpu < 0)
+        return;
+
+#if EZ_ENABLED(EZ_PLATFORM_WINDOWS_DESKTOP)
+      m_PreviousMask = SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(1) << iCpu);
+      m_bPinned = m_PreviousMask != 0;
+#elif EZ_ENABLED(EZ_PLATFORM_LINUX)
+      if (pthread_getaffinity_np(pthread_self(), sizeof(m_PreviousSet), &m_PreviousSet) == 0)
+      {
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        CPU_SET(iCpu, &cpuSet);
+        m_bPinned = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0;
+      }
+#endif
+
+      if (!m_bPinned)
+      {
+        ezLog::Warning("Benchmarks could not be pinned to CPU {0}.", iCpu);
+      }
+    }
+
+    ~ezBenchmarkCpuPinning()
+    {
+      if (!m_bPinned)
+        return;
+
+#if EZ_ENABLED(EZ_PLATFORM_WINDOWS_DESKTOP)
+      SetThreadAffinityMask(GetCurrentThread(), m_PreviousMask);
+#elif EZ_ENABLED(EZ_PLATFORM_LINUX)
+      pthread_setaffinity_np(pthread_self(), sizeof(m_PreviousSet), &m_PreviousSet);
+#endif
+    }
+
+  private:
+    bool m_bPinned = false;
+#if EZ_ENABLED(EZ_PLATFORM_WINDOWS_DESKTOP)
+    DWORD_PTR m_PreviousMask = 0;
+#elif EZ_ENABLED(EZ_PLATFORM_LINUX)
+    cpu_set_t m_PreviousSet;
+#endif
+  };
+
+  /// \brief Makes the benchmark file accessible through the file system, like ezTestFrameworkResult::WriteJsonToFile() does.
+  ezResult MountBenchmarkFile(const char* szFileName, ezStringBuilder& out_sPath)
+  {
+    if (ezPathUtils::IsAbsolutePath(szFileName))
+    {
+      EZ_SUCCEED_OR_RETURN(ezFileSystem::AddDataDirectory("", "benchmarkfiles", ":", ezFileSystem::AllowWrites));
+      out_sPath = szFileName;
+    }
+    else
+    {
+      EZ_SUCCEED_OR_RETURN(ezFileSystem::AddDataDirectory(">eztest/", "benchmarkfiles", ":", ezFileSystem::AllowWrites));
+      out_sPath = ":";
+      out_sPath.AppendPath(szFileName);
+    }
+
+    return EZ_SUCCESS;
+  }
+
+  ezResult LoadBenchmarkBaseline(const char* szFileName)
+  {
+    s_BenchmarkBaseline.clear();
+
+    ezStringBuilder sPath;
+    EZ_SCOPE_EXIT(ezFileSystem::RemoveDataDirectoryGroup("benchmarkfiles"));
+    EZ_SUCCEED_OR_RETURN(MountBenchmarkFile(szFileName, sPath));
+
+    ezFileReader file;
+    EZ_SUCCEED_OR_RETURN(file.Open(sPath));
+
+    ezJSONReader json;
+    EZ_SUCCEED_OR_RETURN(json.Parse(file));
+
+    ezVariant benchmarks;
+    if (!json.GetTopLevelObject().TryGetValue("benchmarks", benchmarks) || !benchmarks.IsA<ezVariantArray>())
+      return EZ_FAILURE;
+
+    for (const ezVariant& benchmark : benchmarks.Get<ezVariantArray>())
+    {
+      if (!benchmark.IsA<ezVariantDictionary>())
+        continue;
+
+      const ezVariantDictionary& values = benchmark.Get<ezVariantDictionary>();
+
+      ezVariant name, median, allocations;
+      if (!values.TryGetValue("name", name) || !values.TryGetValue("median_ns", median))
+        continue;
+
+      ezBenchmarkResult& result = s_BenchmarkBaseline.emplace_back();
+      result.m_sName = name.ConvertTo<ezString>().GetData();
+      result.m_fMedianNs = median.ConvertTo<double>();
+
+      if (values.TryGetValue("allocations_per_iteration", allocations))
+      {
+        result.m_fAllocationsPerIteration = allocations.ConvertTo<double>();
+      }
+    }
+
+    return EZ_SUCCESS;
+  }
+
+  const ezBenchmarkResult* FindBenchmarkBaseline(const char* szBaselineFile, const std::string& sName)
+  {
+    if (s_sBenchmarkBaselineFile != szBaselineFile)
+    {
+      s_sBenchmarkBaselineFile = szBaselineFile;
+
+      if (LoadBenchmarkBaseline(szBaselineFile).Failed())
+      {
+        ezLog::Error("Failed to load the benchmark baseline '{0}'.", szBaselineFile);
+      }
+    }
+
+    for (const ezBenchmarkResult& baseline : s_BenchmarkBaseline)
+    {
+      if (baseline.m_sName == sName)
+        return &baseline;
+    }
+
+    return nullptr;
+  }
+} // namespace
+
+void ezBenchmarkResult::ComputeStatistics(std::vector<double>& samples)
+{
+  m_uiNumSamples = static_cast<ezUInt32>(samples.size());
+
+  if (samples.empty())
+    return;
+
+  std::sort(samples.begin(), samples.end());
+
+  const size_t uiNumSamples = samples.size();
+  const size_t uiMid = uiNumSamples / 2;
+
+  m_fMinNs = samples[0];
+  m_fMedianNs = (uiNumSamples % 2) != 0 ? samples[uiMid] : (samples[uiMid - 1] + samples[uiMid]) * 0.5;
+
+  // nearest rank
+  const size_t uiRank95 = static_cast<size_t>(ezMath::Ceil(0.95 * uiNumSamples));
+  m_fPercentile95Ns = samples[ezMath::Clamp<size_t>(uiRank95, 1, uiNumSamples) - 1];
+
+  double fSum = 0.0;
+  for (double fSample : samples)
+  {
+    fSum += fSample;
+  }
+
+  m_fMeanNs = fSum / uiNumSamples;
+
+  double fSquaredDeviations = 0.0;
+  for (double fSample : samples)
+  {
+    fSquaredDeviations += (fSample - m_fMeanNs) * (fSample - m_fMeanNs);
+  }
+
+  m_fStdDevNs = uiNumSamples > 1 ? ezMath::Sqrt(fSquaredDeviations / (uiNumSamples - 1)) : 0.0;
+}
+
+bool ezBenchmark::StartBatch()
+{
+  m_uiIterationsLeft = m_uiIterationsPerBatch - 1;
+  m_BatchStartTime = ezTime::Now();
+  return true;
+}
+
+bool ezBenchmark::FinishBatch()
+{
+  const ezTime elapsed = ezTime::Now() - m_BatchStartTime;
+
+  switch (m_Phase)
+  {
+    case Phase::NotStarted:
+      m_Phase = Phase::Warmup;
+      return StartBatch();
+
+    case Phase::Warmup:
+      m_ElapsedWarmupTime += elapsed;
+
+      if (elapsed < m_MinSampleTime)
+      {
+        // grow at most tenfold, the first batches tend to be slowed down by cache misses
+        const double fFactor = elapsed.IsPositive() ? ezMath::Clamp(m_MinSampleTime.GetSeconds() / elapsed.GetSeconds() * 1.2, 1.0, 10.0) : 10.0;
+        m_uiIterationsPerBatch = ezMath::Max(m_uiIterationsPerBatch + 1, static_cast<ezUInt64>(m_uiIterationsPerBatch * fFactor));
+      }
+      else if (m_ElapsedWarmupTime >= m_WarmupTime)
+      {
+        m_Phase = Phase::Measure;
+      }
+
+      return StartBatch();
+
+    case Phase::Measure:
+      m_Samples.push_back(elapsed.GetNanoseconds() / m_uiIterationsPerBatch);
+
+      if (m_Samples.size() >= m_uiNumSamples)
+      {
+        // the allocations are counted in a separate batch, so that counting them doesn't affect the timings
+        m_Phase = Phase::CountAllocations;
+
+        m_bCountedAllocationsBefore = ezAllocatorBase::IsThreadAllocationCountingEnabled();
+        ezAllocatorBase::SetThreadAllocationCountingEnabled(true);
+
+        const ezAllocatorBase::ThreadAllocationCounter counter = ezAllocatorBase::GetThreadAllocationCounter();
+        m_uiNumAllocationsBefore = counter.m_uiNumAllocations;
+        m_uiAllocationSizeBefore = counter.m_uiAllocationSize;
+      }
+
+      return StartBatch();
+
+    case Phase::CountAllocations:
+    {
+      const ezAllocatorBase::ThreadAllocationCounter counter = ezAllocatorBase::GetThreadAllocationCounter();
+      ezAllocatorBase::SetThreadAllocationCountingEnabled(m_bCountedAllocationsBefore);
+
+      m_Result.m_fAllocationsPerIteration = static_cast<double>(counter.m_uiNumAllocations - m_uiNumAllocationsBefore) / m_uiIterationsPerBatch;
+      m_Result.m_fAllocatedBytesPerIteration = static_cast<double>(counter.m_uiAllocationSize - m_uiAllocationSizeBefore) / m_uiIterationsPerBatch;
+      m_Result.m_uiIterationsPerSample = m_uiIterationsPerBatch;
+      m_Result.ComputeStatistics(m_Samples);
+
+      if (m_uiItemsPerIteration > 0 && m_Result.m_fMedianNs > 0.0)
+      {
+        m_Result.m_fItemsPerSecond = m_uiItemsPerIteration * 1000000000.0 / m_Result.m_fMedianNs;
+      }
+
+      m_Phase = Phase::Done;
+      return false;
+    }
+
+    case Phase::Done:
+      return false;
+  }
+
+  return false;
+}
+
+// static
+ezBenchmarkResult ezBenchmark::Measure(const char* szName, BenchmarkFunc func, ezUInt32 uiNumSamples, ezTime warmupTime, ezTime minSampleTime)
+{
+  ezBenchmark benchmark;
+  benchmark.m_WarmupTime = warmupTime;
+  benchmark.m_MinSampleTime = minSampleTime;
+  benchmark.m_uiNumSamples = ezMath::Max(uiNumSamples, 1u);
+  benchmark.m_Samples.reserve(benchmark.m_uiNumSamples);
+  benchmark.m_Result.m_sName = szName;
+
+  func(benchmark);
+
+  if (benchmark.m_Phase != Phase::Done)
+  {
+    if (benchmark.m_Phase == Phase::CountAllocations)
+    {
+      ezAllocatorBase::SetThreadAllocationCountingEnabled(benchmark.m_bCountedAllocationsBefore);
+    }
+
+    ezLog::Error("Benchmark '{0}' stopped before KeepRunning() returned false.", szName);
+  }
+
+  return benchmark.m_Result;
+}
+
+// static
+void ezBenchmark::Run(const char* szName, BenchmarkFunc func)
+{
+  const TestSettings settings = ezTestFramework::GetInstance()->GetSettings();
+
+  ezBenchmarkResult result;
+  {
+    ezBenchmarkCpuPinning pinning(settings.m_iBenchmarkCpu);
+    result = Measure(szName, func, settings.m_uiBenchmarkSamples);
+  }
+
+  ezLog::Info("[test]{0}: median {1}ns, p95 {2}ns, stddev {3}ns, {4} allocations/iteration ({5} samples of {6} iterations)", szName,
+    ezArgF(result.m_fMedianNs, 1), ezArgF(result.m_fPercentile95Ns, 1), ezArgF(result.m_fStdDevNs, 1), ezArgF(result.m_fAllocationsPerIteration, 2),
+    result.m_uiNumSamples, result.m_uiIterationsPerSample);
+
+  ezTestFramework::CaptureRegressionStat(szName, "Median", "ns", static_cast<float>(result.m_fMedianNs)).IgnoreResult();
+
+  if (result.m_fItemsPerSecond > 0.0)
+  {
+    ezLog::Info("[test]{0}: {1} items/s", szName, ezArgF(result.m_fItemsPerSecond, 0));
+    ezTestFramework::CaptureRegressionStat(szName, "Throughput", "items/s", static_cast<float>(result.m_fItemsPerSecond)).IgnoreResult();
+  }
+
+  if (!settings.m_sBenchmarkBaseline.empty())
+  {
+    if (const ezBenchmarkResult* pBaseline = FindBenchmarkBaseline(settings.m_sBenchmarkBaseline.c_str(), result.m_sName))
+    {
+      const double fTolerance = settings.m_fBenchmarkTolerance;
+
+      if (result.m_fMedianNs > pBaseline->m_fMedianNs * (1.0 + fTolerance))
+      {
+        ezStringBuilder sMsg;
+        sMsg.Format("Median of {0}ns is {1} times the baseline of {2}ns.", ezArgF(result.m_fMedianNs, 1),
+          ezArgF(result.m_fMedianNs / pBaseline->m_fMedianNs, 2), ezArgF(pBaseline->m_fMedianNs, 1));
+        EZ_TEST_FAILURE("Benchmark regression", "%s", sMsg.GetData());
+      }
+
+      // growing containers allocate a fraction of an allocation per iteration, which depends on the iterations per sample
+      if (result.m_fAllocationsPerIteration > pBaseline->m_fAllocationsPerIteration + ezMath::Max(pBaseline->m_fAllocationsPerIteration * fTolerance, 0.5))
+      {
+        ezStringBuilder sMsg;
+        sMsg.Format("{0} allocations per iteration, the baseline has {1}.", ezArgF(result.m_fAllocationsPerIteration, 2),
+          ezArgF(pBaseline->m_fAllocationsPerIteration, 2));
+        EZ_TEST_FAILURE("Benchmark regression", "%s", sMsg.GetData());
+      }
+    }
+  }
+
+  s_BenchmarkResults.push_back(result);
+}
+
+// static
+const std::vector<ezBenchmarkResult>& ezBenchmark::GetResults()
+{
+  return s_BenchmarkResults;
+}
+
+// static
+void ezBenchmark::ClearResults()
+{
+  s_BenchmarkResults.clear();
+}
+
+// static
+bool ezBenchmark::WriteJsonToFile(const char* szFileName)
+{
+  ezStartup::StartupCoreSystems();
+  EZ_SCOPE_EXIT(ezStartup::ShutdownCoreSystems());
+
+  ezStringBuilder sPath;
+  if (MountBenchmarkFile(szFileName, sPath).Failed())
+    return false;
+
+  ezFileWriter file;
+  if (file.Open(sPath).Failed())
+    return false;
+
+  ezStandardJSONWriter js;
+  js.SetOutputStream(&file);
+
+  js.BeginObject();
+  {
+    js.AddVariableInt32("revision", ezTestFramework::GetInstance()->GetSettings().m_iRevision);
+
+    js.BeginArray("benchmarks");
+    for (const ezBenchmarkResult& result : s_BenchmarkResults)
+    {
+      js.BeginObject();
+      js.AddVariableString("name", result.m_sName.c_str());
+      js.AddVariableUInt64("iterations_per_sample", result.m_uiIterationsPerSample);
+      js.AddVariableUInt32("samples", result.m_uiNumSamples);
+      js.AddVariableDouble("min_ns", result.m_fMinNs);
+      js.AddVariableDouble("median_ns", result.m_fMedianNs);
+      js.AddVariableDouble("p95_ns", result.m_fPercentile95Ns);
+      js.AddVariableDouble("mean_ns", result.m_fMeanNs);
+      js.AddVariableDouble("stddev_ns", result.m_fStdDevNs);
+
+      if (result.m_fItemsPerSecond > 0.0)
+        js.AddVariableDouble("items_per_second", result.m_fItemsPerSecond);
+
+      js.AddVariableDouble("allocations_per_iteration", result.m_fAllocationsPerIteration);
+      js.AddVariableDouble("allocated_bytes_per_iteration", result.m_fAllocatedBytesPerIteration);
+      js.EndObject();
+    }
+    js.EndArray();
+  }
+  js.EndObject();
+
+  return true;
+}
+
+EZ_STATICLINK_FILE(TestFramework, TestFramework_Framework_Benchmark);
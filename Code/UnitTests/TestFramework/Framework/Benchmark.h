@@ -0,0 +1,128 @@
+#pragma once
+
+#include <Foundation/Basics.h>
+#include <Foundation/Time/Time.h>
+#include <TestFramework/Framework/SimpleTest.h>
+#include <TestFramework/TestFrameworkDLL.h>
+
+#include <string>
+#include <vector>
+
+/// \brief The statistics of one benchmark run. All times are per iteration.
+struct EZ_TEST_DLL ezBenchmarkResult
+{
+  std::string m_sName;
+  ezUInt64 m_uiIterationsPerSample = 0;
+  ezUInt32 m_uiNumSamples = 0;
+
+  double m_fMinNs = 0.0;
+  double m_fMedianNs = 0.0;
+  double m_fPercentile95Ns = 0.0;
+  double m_fMeanNs = 0.0;
+  double m_fStdDevNs = 0.0;
+
+  double m_fItemsPerSecond = 0.0; ///< Only set when the benchmark called ezBenchmark::SetItemsPerIteration().
+
+  double m_fAllocationsPerIteration = 0.0;
+  double m_fAllocatedBytesPerIteration = 0.0;
+
+  /// \brief Fills out the time statistics from the given samples, in nanoseconds per iteration. The samples get sorted.
+  void ComputeStatistics(std::vector<double>& samples);
+};
+
+/// \brief Measures the code inside of a benchmark, see EZ_CREATE_BENCHMARK.
+///
+/// The benchmark body runs its workload in a 'while (benchmark.KeepRunning())' loop. The loop first runs for a warmup period, during which
+/// the number of iterations per sample is adjusted, such that one sample takes long enough to be measured reliably. Then a fixed number of
+/// samples is timed, and finally one more sample counts the allocations of the thread.
+///
+/// The results are written to the file passed with '-benchmarkJson'. If a baseline file is passed with '-benchmarkBaseline', every benchmark
+/// fails, whose median time or allocation count exceeds the baseline by more than '-benchmarkTolerance' (default 0.1, ie. 10%).
+/// '-benchmarkSamples' sets the number of timed samples and '-benchmarkCpu' pins the benchmark thread to the given CPU core.
+class EZ_TEST_DLL ezBenchmark
+{
+public:
+  typedef void (*BenchmarkFunc)(ezBenchmark& benchmark);
+
+  /// \brief Returns true as long as the workload should be executed once more.
+  EZ_ALWAYS_INLINE bool KeepRunning()
+  {
+    if (m_uiIterationsLeft > 0)
+    {
+      --m_uiIterationsLeft;
+      return true;
+    }
+
+    return FinishBatch();
+  }
+
+  /// \brief Sets how many items, e.g. objects or particles, one iteration processes. The throughput is then reported as items per second.
+  void SetItemsPerIteration(ezUInt64 uiNumItems) { m_uiItemsPerIteration = uiNumItems; }
+
+  /// \brief Runs the benchmark function with the settings of the test framework, reports the results and compares them to the baseline.
+  static void Run(const char* szName, BenchmarkFunc func);
+
+  /// \brief Runs the benchmark function and returns its results, without reporting them.
+  static ezBenchmarkResult Measure(const char* szName, BenchmarkFunc func, ezUInt32 uiNumSamples, ezTime warmupTime = ezTime::Milliseconds(20),
+    ezTime minSampleTime = ezTime::Milliseconds(2));
+
+  /// \brief Returns the results of all benchmarks that were run since the last call to ClearResults().
+  static const std::vector<ezBenchmarkResult>& GetResults();
+
+  static void ClearResults();
+
+  /// \brief Writes all results to the given file. Relative paths are written to the test output folder.
+  static bool WriteJsonToFile(const char* szFileName);
+
+private:
+  enum class Phase
+  {
+    NotStarted,
+    Warmup,
+    Measure,
+    CountAllocations,
+    Done,
+  };
+
+  ezBenchmark() = default;
+
+  bool FinishBatch();
+  bool StartBatch();
+
+  Phase m_Phase = Phase::NotStarted;
+  ezUInt64 m_uiIterationsLeft = 0;
+  ezUInt64 m_uiIterationsPerBatch = 1;
+  ezTime m_BatchStartTime;
+  ezTime m_WarmupTime;
+  ezTime m_MinSampleTime;
+  ezTime m_ElapsedWarmupTime;
+  ezUInt32 m_uiNumSamples = 0;
+  ezUInt64 m_uiItemsPerIteration = 0;
+  std::vector<double> m_Samples;
+
+  bool m_bCountedAllocationsBefore = false;
+  ezUInt64 m_uiNumAllocationsBefore = 0;
+  ezUInt64 m_uiAllocationSizeBefore = 0;
+
+  ezBenchmarkResult m_Result;
+};
+
+/// \brief Creates a benchmark in the given test group. The benchmark body gets an ezBenchmark& named 'benchmark'.
+///
+/// \code{.cpp}
+///   EZ_CREATE_BENCHMARK(Performance, DynamicArrayPushBack)
+///   {
+///     ezDynamicArray<ezUInt32> values;
+///     while (benchmark.KeepRunning())
+///     {
+///       values.PushBack(42);
+///     }
+///   }
+/// \endcode
+#define EZ_CREATE_BENCHMARK(GroupName, BenchmarkName)                                                                                                \
+  static void ezBenchmarkFunction__##GroupName##_##BenchmarkName(ezBenchmark& benchmark);                                                            \
+  EZ_CREATE_SIMPLE_TEST(GroupName, BenchmarkName)                                                                                                    \
+  {                                                                                                                                                  \
+    ezBenchmark::Run(EZ_STRINGIZE(GroupName) "." EZ_STRINGIZE(BenchmarkName), ezBenchmarkFunction__##GroupName##_##BenchmarkName);                  \
+  }                                                                                                                                                  \
+  static void ezBenchmarkFunction__##GroupName##_##BenchmarkName(ezBenchmark& benchmark)
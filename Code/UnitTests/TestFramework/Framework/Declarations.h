@@ -57,13 +57,18 @@ struct TestSettings
   bool m_bAutoDisableSuccessfulTests = false;
 
   // The following settings are only set via command-line.
-  bool m_bRunTests = false;          /// Only needed for GUI applications, in console mode tests are always run automatically.
-  bool m_bNoAutomaticSaving = false; /// Allows to run the test with settings through the command line without saving those settings for later.
-  bool m_bCloseOnSuccess = false;    /// Closes the application upon success immediately.
-  bool m_bNoGUI = false;             /// Starts the tests in console mode, test are started automatically.
-  int m_iRevision = -1;              /// Revision in the RCS of this test run. Will be written into the test results json file for later reference.
-  std::string m_sJsonOutput;         /// Absolute path to the json file the results should be written to.
-  bool m_bEnableAllTests = false;    /// Enables all test.
-  std::string m_sTestFilter;         /// Filter that does a 'contains' test on each test name.
-  ezUInt8 m_uiFullPasses = 1;        /// All tests are done this often, to check whether some tests fail only when executed multiple times.
+  bool m_bRunTests = false;           /// Only needed for GUI applications, in console mode tests are always run automatically.
+  bool m_bNoAutomaticSaving = false;  /// Allows to run the test with settings through the command line without saving those settings for later.
+  bool m_bCloseOnSuccess = false;     /// Closes the application upon success immediately.
+  bool m_bNoGUI = false;              /// Starts the tests in console mode, test are started automatically.
+  int m_iRevision = -1;               /// Revision in the RCS of this test run. Will be written into the test results json file for later reference.
+  std::string m_sJsonOutput;          /// Absolute path to the json file the results should be written to.
+  bool m_bEnableAllTests = false;     /// Enables all test.
+  std::string m_sTestFilter;          /// Filter that does a 'contains' test on each test name.
+  ezUInt8 m_uiFullPasses = 1;         /// All tests are done this often, to check whether some tests fail only when executed multiple times.
+  std::string m_sBenchmarkJsonOutput; /// Path to the json file the benchmark results should be written to.
+  std::string m_sBenchmarkBaseline;   /// Path to benchmark results from an earlier run, benchmarks that got slower than those fail.
+  double m_fBenchmarkTolerance = 0.1; /// How much slower than the baseline a benchmark may get, 0.1 means 10%.
+  ezInt32 m_iBenchmarkCpu = -1;       /// The CPU core that benchmarks are pinned to, -1 disables pinning.
+  ezUInt32 m_uiBenchmarkSamples = 15; /// The number of timed samples that each benchmark records.
 };
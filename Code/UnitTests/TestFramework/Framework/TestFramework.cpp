@@ -303,6 +303,16 @@ void ezTestFramework::GetTestSettingsFromCommandLine(const ezCommandLineUtils& c
   if (cmd.GetStringOptionArguments("-json") == 1)
     m_Settings.m_sJsonOutput = cmd.GetStringOption("-json", 0, "");
 
+  if (cmd.GetStringOptionArguments("-benchmarkJson") == 1)
+    m_Settings.m_sBenchmarkJsonOutput = cmd.GetStringOption("-benchmarkJson", 0, "");
+
+  if (cmd.GetStringOptionArguments("-benchmarkBaseline") == 1)
+    m_Settings.m_sBenchmarkBaseline = cmd.GetStringOption("-benchmarkBaseline", 0, "");
+
+  m_Settings.m_fBenchmarkTolerance = cmd.GetFloatOption("-benchmarkTolerance", m_Settings.m_fBenchmarkTolerance);
+  m_Settings.m_iBenchmarkCpu = cmd.GetIntOption("-benchmarkCpu", m_Settings.m_iBenchmarkCpu);
+  m_Settings.m_uiBenchmarkSamples = cmd.GetIntOption("-benchmarkSamples", m_Settings.m_uiBenchmarkSamples);
+
   if (cmd.GetStringOptionArguments("-outputDir") == 1)
   {
     m_sAbsTestOutputDir = cmd.GetStringOption("-outputDir", 0, "");
@@ -500,6 +510,7 @@ void ezTestFramework::ResetTests()
   m_bAbortTests = false;
 
   m_Result.Reset();
+  ezBenchmark::ClearResults();
 }
 
 ezTestAppRun ezTestFramework::RunTestExecutionLoop()
@@ -787,6 +798,9 @@ void ezTestFramework::EndTests()
   if (!m_Settings.m_sJsonOutput.empty())
     m_Result.WriteJsonToFile(m_Settings.m_sJsonOutput.c_str());
 
+  if (!m_Settings.m_sBenchmarkJsonOutput.empty())
+    ezBenchmark::WriteJsonToFile(m_Settings.m_sBenchmarkJsonOutput.c_str());
+
   m_iExecutingTest = -1;
   m_iExecutingSubTest = -1;
   m_bAbortTests = false;
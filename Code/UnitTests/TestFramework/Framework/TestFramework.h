@@ -1,5 +1,6 @@
 #pragma once
 
+#include <TestFramework/Framework/Benchmark.h>
 #include <TestFramework/Framework/Declarations.h>
 #include <TestFramework/Framework/SimpleTest.h>
 #include <TestFramework/Framework/TestBaseClass.h>